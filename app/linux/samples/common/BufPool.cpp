@@ -0,0 +1,531 @@
+/************************************************************************/
+/*                                                                      */
+/*  BufPool.cpp  --  Pinned transfer buffer pool                        */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a pool of fixed size transfer buffers that   */
+/*  are preallocated from a single page aligned slab. The slab is       */
+/*  prefaulted when the pool is initialized so that no page faults      */
+/*  occur while buffers are in use, and it may optionally be backed by  */
+/*  huge pages and locked into memory.                                  */
+/*                                                                      */
+/*  Free buffers are kept on a lock-free stack. Any number of threads   */
+/*  may call PbAlloc and FreeBuf concurrently.                          */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <sys/mman.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "BufPool.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Index used to mark the end of the free list.
+*/
+const UINT32    ibufNil = 0xFFFFFFFF;
+
+/* Size of a huge page. The slab size is rounded up to a multiple of
+** this when huge pages are requested.
+*/
+const size_t    cbHugePage = 2 * 1024 * 1024;
+
+#define IbufFromHead(head)          ((UINT32)((head) & 0xFFFFFFFF))
+#define TagFromHead(head)           ((UINT32)((head) >> 32))
+#define HeadFromTagIbuf(tag, ibuf)  (((UINT64)(tag) << 32) | (UINT64)(ibuf))
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    BufPool::BufPool
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an empty pool. FInit must be called before any buffers
+**      can be allocated.
+*/
+BufPool::BufPool() : headFree(HeadFromTagIbuf(0, ibufNil)) {
+
+    pbSlab = NULL;
+    cbSlab = 0;
+    cbBuf = 0;
+    cbufTotal = 0;
+    fHugePages = fFalse;
+    fLocked = fFalse;
+    rgibufNext = NULL;
+
+    cbufFree.store(0);
+    cbufFreeMin.store(0);
+    ResetStats();
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::~BufPool
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the slab.
+*/
+BufPool::~BufPool() {
+
+    Term();
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::FInit
+**
+**  Parameters:
+**      cbBufReq    - requested size of each buffer in bytes
+**      cbufReq     - number of buffers to preallocate
+**      fbp         - combination of fbpHugePages and fbpLock
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the slab can't be mapped. Failure to obtain huge pages or
+**      to lock the slab is not an error; GetStats reports which of the
+**      requested features are in effect.
+**
+**  Description:
+**      Allocate the slab and place every buffer on the free list. The
+**      buffer size is rounded up to a multiple of cbBufAlign.
+*/
+BOOL
+BufPool::FInit( DWORD cbBufReq, DWORD cbufReq, DWORD fbp ) {
+
+    size_t  cbMap;
+    void *  pv;
+    UINT32  ibuf;
+
+    if (( 0 == cbBufReq ) || ( 0 == cbufReq ) || ( ibufNil == cbufReq )) {
+
+        return fFalse;
+    }
+
+    Term();
+
+    cbBuf = (cbBufReq + cbBufAlign - 1) & ~(cbBufAlign - 1);
+    cbMap = (size_t)cbBuf * cbufReq;
+    pv = MAP_FAILED;
+
+    /* Try to get explicit huge pages first. These are only available if
+    ** the administrator has reserved them (vm.nr_hugepages), so fall back
+    ** to normal pages and ask for transparent huge pages instead.
+    */
+    if ( fbp & fbpHugePages ) {
+
+        cbSlab = (cbMap + cbHugePage - 1) & ~(cbHugePage - 1);
+        pv = mmap(NULL, cbSlab, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if ( MAP_FAILED != pv ) {
+
+            fHugePages = fTrue;
+        }
+    }
+
+    if ( MAP_FAILED == pv ) {
+
+        cbSlab = cbMap;
+        pv = mmap(NULL, cbSlab, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if ( MAP_FAILED == pv ) {
+
+            cbSlab = 0;
+            return fFalse;
+        }
+
+        if ( fbp & fbpHugePages ) {
+
+            madvise(pv, cbSlab, MADV_HUGEPAGE);
+        }
+    }
+
+    pbSlab = (BYTE *)pv;
+
+    /* Touch every page so that the first transfer into a buffer doesn't
+    ** take a page fault. Locking the slab keeps it resident afterwards.
+    ** mlock fails if RLIMIT_MEMLOCK is too small, in which case we carry
+    ** on with an unlocked slab.
+    */
+    memset(pbSlab, 0, cbSlab);
+
+    if ( fbp & fbpLock ) {
+
+        if ( 0 == mlock(pbSlab, cbSlab) ) {
+
+            fLocked = fTrue;
+        }
+    }
+
+    rgibufNext = new std::atomic<UINT32>[cbufReq];
+    cbufTotal = cbufReq;
+
+    /* Build the free list so that the buffers are handed out in address
+    ** order.
+    */
+    for ( ibuf = 0; ibuf < cbufTotal; ibuf++ ) {
+
+        rgibufNext[ibuf].store(( ibuf + 1 < cbufTotal ) ? ibuf + 1 : ibufNil);
+    }
+
+    headFree.store(HeadFromTagIbuf(0, 0));
+    cbufFree.store(cbufTotal);
+    cbufFreeMin.store(cbufTotal);
+    ResetStats();
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::Term
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Unmap the slab. All buffers obtained from the pool become invalid.
+*/
+void
+BufPool::Term() {
+
+    if ( NULL != pbSlab ) {
+
+        if ( fLocked ) {
+
+            munlock(pbSlab, cbSlab);
+        }
+
+        munmap(pbSlab, cbSlab);
+    }
+
+    delete [] rgibufNext;
+
+    pbSlab = NULL;
+    cbSlab = 0;
+    cbBuf = 0;
+    cbufTotal = 0;
+    fHugePages = fFalse;
+    fLocked = fFalse;
+    rgibufNext = NULL;
+
+    headFree.store(HeadFromTagIbuf(0, ibufNil));
+    cbufFree.store(0);
+    cbufFreeMin.store(0);
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::PushFree
+**
+**  Parameters:
+**      ibuf    - index of the buffer to place on the free list
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Push a buffer onto the lock-free free list.
+*/
+void
+BufPool::PushFree( UINT32 ibuf ) {
+
+    UINT64  headCur;
+    UINT64  headNew;
+
+    headCur = headFree.load(std::memory_order_relaxed);
+    do {
+
+        rgibufNext[ibuf].store(IbufFromHead(headCur), std::memory_order_relaxed);
+        headNew = HeadFromTagIbuf(TagFromHead(headCur) + 1, ibuf);
+
+    } while ( ! headFree.compare_exchange_weak(headCur, headNew,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed) );
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::FPopFree
+**
+**  Parameters:
+**      pibuf   - receives the index of the buffer removed from the list
+**
+**  Return Values:
+**      fTrue if a buffer was removed, fFalse if the free list is empty
+**
+**  Errors:
+**
+**  Description:
+**      Pop a buffer from the lock-free free list. The next link that is
+**      read may be stale if another thread pops the same buffer first,
+**      but in that case the tag in the head will have changed and the
+**      compare and swap will fail.
+*/
+BOOL
+BufPool::FPopFree( UINT32 * pibuf ) {
+
+    UINT64  headCur;
+    UINT64  headNew;
+    UINT32  ibuf;
+
+    headCur = headFree.load(std::memory_order_acquire);
+    do {
+
+        ibuf = IbufFromHead(headCur);
+        if ( ibufNil == ibuf ) {
+
+            return fFalse;
+        }
+
+        headNew = HeadFromTagIbuf(TagFromHead(headCur) + 1,
+                                  rgibufNext[ibuf].load(std::memory_order_relaxed));
+
+    } while ( ! headFree.compare_exchange_weak(headCur, headNew,
+                                               std::memory_order_acquire,
+                                               std::memory_order_acquire) );
+
+    *pibuf = ibuf;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::PbAlloc
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      pointer to a buffer of CbBuf() bytes, or NULL if the pool is empty
+**
+**  Errors:
+**      Returns NULL when no buffer is free. The failure is counted in
+**      the cAllocFail statistic.
+**
+**  Description:
+**      Take a buffer from the pool. This function never blocks.
+*/
+BYTE *
+BufPool::PbAlloc() {
+
+    UINT32  ibuf;
+    INT32   cbufFreeCur;
+    INT32   cbufMinCur;
+
+    if ( ! FPopFree(&ibuf) ) {
+
+        cAllocFail.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    cAlloc.fetch_add(1, std::memory_order_relaxed);
+
+    /* Track the low water mark of free buffers.
+    */
+    cbufFreeCur = cbufFree.fetch_sub(1, std::memory_order_relaxed) - 1;
+    cbufMinCur = cbufFreeMin.load(std::memory_order_relaxed);
+    while (( cbufFreeCur < cbufMinCur ) &&
+           ( ! cbufFreeMin.compare_exchange_weak(cbufMinCur, cbufFreeCur,
+                                                 std::memory_order_relaxed) )) {
+    }
+
+    return pbSlab + (size_t)ibuf * cbBuf;
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::FreeBuf
+**
+**  Parameters:
+**      pb      - buffer previously returned by PbAlloc
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      Pointers that don't belong to the pool are ignored.
+**
+**  Description:
+**      Return a buffer to the pool. This function never blocks.
+*/
+void
+BufPool::FreeBuf( BYTE * pb ) {
+
+    if ( ! FOwns(pb) ) {
+
+        return;
+    }
+
+    cFree.fetch_add(1, std::memory_order_relaxed);
+    cbufFree.fetch_add(1, std::memory_order_relaxed);
+
+    PushFree((UINT32)((size_t)(pb - pbSlab) / cbBuf));
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::FOwns
+**
+**  Parameters:
+**      pb      - pointer to check
+**
+**  Return Values:
+**      fTrue if pb is the start of a buffer belonging to the pool
+**
+**  Errors:
+**
+**  Description:
+**      Determine whether or not a pointer was handed out by this pool.
+*/
+BOOL
+BufPool::FOwns( const BYTE * pb ) const {
+
+    size_t  ib;
+
+    if (( NULL == pbSlab ) || ( pb < pbSlab )) {
+
+        return fFalse;
+    }
+
+    ib = (size_t)(pb - pbSlab);
+
+    return ( ib < (size_t)cbBuf * cbufTotal ) && ( 0 == (ib % cbBuf) );
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::GetStats
+**
+**  Parameters:
+**      pbps    - receives the pool statistics
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Take a snapshot of the pool statistics. The counters are read
+**      individually, so the snapshot is only approximate while other
+**      threads are using the pool.
+*/
+void
+BufPool::GetStats( BPSTATS * pbps ) const {
+
+    INT32   cbuf;
+
+    pbps->cbBuf = cbBuf;
+    pbps->cbufTotal = cbufTotal;
+
+    cbuf = cbufFree.load(std::memory_order_relaxed);
+    pbps->cbufFree = ( 0 < cbuf ) ? cbuf : 0;
+    cbuf = cbufFreeMin.load(std::memory_order_relaxed);
+    pbps->cbufFreeMin = ( 0 < cbuf ) ? cbuf : 0;
+
+    pbps->cAlloc = cAlloc.load(std::memory_order_relaxed);
+    pbps->cAllocFail = cAllocFail.load(std::memory_order_relaxed);
+    pbps->cFree = cFree.load(std::memory_order_relaxed);
+    pbps->fHugePages = fHugePages;
+    pbps->fLocked = fLocked;
+}
+
+/* ------------------------------------------------------------ */
+/***    BufPool::ResetStats
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Clear the event counters and restart low water mark tracking from
+**      the current number of free buffers.
+*/
+void
+BufPool::ResetStats() {
+
+    cAlloc.store(0);
+    cAllocFail.store(0);
+    cFree.store(0);
+    cbufFreeMin.store(cbufFree.load());
+}
+
+/* ------------------------------------------------------------ */
+/***    CbBestTransfer
+**
+**  Parameters:
+**      hif     - open handle for the device
+**
+**  Return Values:
+**      preferred bulk transfer size in bytes for the device's transport
+**
+**  Errors:
+**      If the transport can't be determined the smallest size is returned.
+**
+**  Description:
+**      Return a buffer size suited to the transport used to communicate
+**      with the device. This is intended to be passed to BufPool::FInit.
+*/
+DWORD
+CbBestTransfer( HIF hif ) {
+
+    DVC     dvc;
+
+    if ( ! DmgrGetDvcFromHif(hif, &dvc) ) {
+
+        return cbXferOther;
+    }
+
+    switch ( TptFromDtp(dvc.dtp) ) {
+
+        case tptUSB:
+            return cbXferUSB;
+
+        case tptEthernet:
+            return cbXferEthernet;
+
+        default:
+            return cbXferOther;
+    }
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
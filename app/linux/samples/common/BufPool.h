@@ -0,0 +1,145 @@
+/************************************************************************/
+/*                                                                      */
+/*    BufPool.h  --    Interface Declarations for BufPool.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a pool  */
+/*    of preallocated transfer buffers. The buffers are intended to be  */
+/*    passed to the bulk transfer functions of the Adept APIs           */
+/*    (DstmIO, DeppGetRegRepeat, DspiGet, DjtgGetTdoBits, ...) in place */
+/*    of buffers that are allocated and freed for every call.           */
+/*                                                                      */
+/*    All of the buffers are carved out of a single slab that is        */
+/*    page aligned, prefaulted, optionally backed by huge pages and     */
+/*    optionally locked into memory with mlock. Buffers are handed out  */
+/*    and returned using a lock-free stack, which makes it safe for a   */
+/*    producer thread and a consumer thread to allocate and free        */
+/*    buffers concurrently without taking a lock.                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(BUFPOOL_INCLUDED)
+#define      BUFPOOL_INCLUDED
+
+#include <stddef.h>
+
+#include <atomic>
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Flags passed to BufPool::FInit.
+*/
+const DWORD fbpHugePages    = 0x00000001; // back the slab with huge pages if possible
+const DWORD fbpLock         = 0x00000002; // lock the slab into memory using mlock
+const DWORD fbpDefault      = fbpHugePages | fbpLock;
+
+/* Alignment of every buffer handed out by the pool. This is large
+** enough for O_DIRECT file I/O as well as for any SIMD load/store.
+*/
+const DWORD cbBufAlign      = 4096;
+
+/* Transfer sizes returned by CbBestTransfer for each transport type.
+** USB transfers should be a multiple of the 512 byte high speed bulk
+** packet size and large enough to amortize the per call overhead.
+*/
+const DWORD cbXferUSB       = 65536;
+const DWORD cbXferEthernet  = 16384;
+const DWORD cbXferOther     = 4096;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Buffer pool statistics. The cbufFreeMin field is the low water mark
+** of free buffers and cAllocFail counts allocation requests made while
+** the pool was empty. Together they indicate the pool pressure.
+*/
+typedef struct {
+    DWORD   cbBuf;          // size of each buffer in bytes
+    DWORD   cbufTotal;      // number of buffers in the pool
+    DWORD   cbufFree;       // number of buffers currently free
+    DWORD   cbufFreeMin;    // fewest free buffers observed
+    UINT64  cAlloc;         // successful allocations
+    UINT64  cAllocFail;     // allocations that failed because the pool was empty
+    UINT64  cFree;          // buffers returned to the pool
+    BOOL    fHugePages;     // slab is backed by huge pages
+    BOOL    fLocked;        // slab is locked into memory
+} BPSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class BufPool {
+
+private:
+    BYTE *                  pbSlab;
+    size_t                  cbSlab;
+    DWORD                   cbBuf;
+    DWORD                   cbufTotal;
+    BOOL                    fHugePages;
+    BOOL                    fLocked;
+
+    /* The free list is a stack of buffer indices. The head packs a
+    ** 32-bit modification tag in the upper half and the index of the
+    ** top buffer in the lower half so that compare and swap operations
+    ** are not subject to the ABA problem.
+    */
+    std::atomic<UINT64>     headFree;
+    std::atomic<UINT32> *   rgibufNext;
+
+    std::atomic<INT32>      cbufFree;
+    std::atomic<INT32>      cbufFreeMin;
+    std::atomic<UINT64>     cAlloc;
+    std::atomic<UINT64>     cAllocFail;
+    std::atomic<UINT64>     cFree;
+
+    void    PushFree(UINT32 ibuf);
+    BOOL    FPopFree(UINT32 * pibuf);
+
+    BufPool(const BufPool &);
+    BufPool & operator=(const BufPool &);
+
+public:
+    BufPool();
+    ~BufPool();
+
+    BOOL    FInit(DWORD cbBufReq, DWORD cbufReq, DWORD fbp);
+    void    Term();
+
+    BYTE *  PbAlloc();
+    void    FreeBuf(BYTE * pb);
+
+    DWORD   CbBuf() const { return cbBuf; }
+    DWORD   CbufTotal() const { return cbufTotal; }
+    BOOL    FOwns(const BYTE * pb) const;
+
+    void    GetStats(BPSTATS * pbps) const;
+    void    ResetStats();
+};
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+DWORD   CbBestTransfer(HIF hif);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // BUFPOOL_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,703 @@
+/************************************************************************/
+/*                                                                      */
+/*  DeltaRle.cpp  --  Delta plus run-length decoder and encoder         */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module decodes the data produced by the DeltaRle upload stage  */
+/*  of the StreamIO FPGA design. Decoding is done in two passes over    */
+/*  each piece of input:                                                */
+/*                                                                      */
+/*    1. The run escapes are expanded, producing one delta per output   */
+/*       sample. Blocks of input that contain no escape are copied a    */
+/*       vector at a time.                                              */
+/*    2. The deltas are turned back into samples in place by a byte     */
+/*       wise prefix sum. This is done a vector at a time using the     */
+/*       log-step shift and add method, with the last sample of each    */
+/*       vector carried into the next one.                              */
+/*                                                                      */
+/*  AVX2 and SSE2 versions of both passes are compiled using function   */
+/*  target attributes so that the module itself doesn't need to be      */
+/*  built with -mavx2. The fastest version that the processor supports  */
+/*  is selected at run time.                                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DR_X86
+#include <immintrin.h>
+#endif
+
+#include "dpcdecl.h"
+#include "DeltaRle.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Run escape byte.
+*/
+const BYTE  bDrEscape = 0x00;
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+static DWORD    drimplCached = drimplBest;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static DWORD    CbCopyLiteralScalar(BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax);
+static BYTE     BPrefixSumScalar(BYTE * rgb, DWORD cb, BYTE bPrev);
+
+#if defined(DR_X86)
+static DWORD    CbCopyLiteralSse2(BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax);
+static BYTE     BPrefixSumSse2(BYTE * rgb, DWORD cb, BYTE bPrev);
+static DWORD    CbCopyLiteralAvx2(BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax);
+static BYTE     BPrefixSumAvx2(BYTE * rgb, DWORD cb, BYTE bPrev);
+#endif
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    DrInit
+**
+**  Parameters:
+**      pdrs    - decoder state to initialize
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Prepare a decoder for the start of a stream. The FPGA encoder
+**      starts each stream with a previous sample of 0.
+*/
+void
+DrInit( DRSTATE * pdrs ) {
+
+    pdrs->bPrev = 0;
+    pdrs->fEscape = fFalse;
+    pdrs->crunPending = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    CbDrDecode
+**
+**  Parameters:
+**      pdrs        - decoder state
+**      rgbIn       - encoded input
+**      cbIn        - number of bytes in rgbIn
+**      rgbOut      - buffer that receives the decoded samples
+**      cbOutMax    - size of rgbOut
+**      pcbInUsed   - receives the number of input bytes consumed
+**
+**  Return Values:
+**      number of samples written to rgbOut
+**
+**  Errors:
+**
+**  Description:
+**      Decode as much of the input as fits in the output buffer using
+**      the fastest implementation supported by the processor. Input
+**      that isn't consumed must be passed in again on the next call.
+**      A run escape at the end of the input is remembered in the state,
+**      so the input may be split at any byte.
+*/
+DWORD
+CbDrDecode( DRSTATE * pdrs, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut, DWORD cbOutMax, DWORD * pcbInUsed ) {
+
+    return CbDrDecodeImpl(drimplBest, pdrs, rgbIn, cbIn, rgbOut, cbOutMax, pcbInUsed);
+}
+
+/* ------------------------------------------------------------ */
+/***    CbDrDecodeImpl
+**
+**  Parameters:
+**      drimpl      - implementation to use (drimplScalar, drimplSse2,
+**                    drimplAvx2 or drimplBest)
+**      pdrs        - decoder state
+**      rgbIn       - encoded input
+**      cbIn        - number of bytes in rgbIn
+**      rgbOut      - buffer that receives the decoded samples
+**      cbOutMax    - size of rgbOut
+**      pcbInUsed   - receives the number of input bytes consumed
+**
+**  Return Values:
+**      number of samples written to rgbOut
+**
+**  Errors:
+**      An implementation that isn't supported by the processor is
+**      replaced by the best one that is.
+**
+**  Description:
+**      Same as CbDrDecode but with an explicit choice of implementation.
+**      This is used to compare the implementations against each other.
+*/
+DWORD
+CbDrDecodeImpl( DWORD drimpl, DRSTATE * pdrs, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut, DWORD cbOutMax, DWORD * pcbInUsed ) {
+
+    DWORD   (* pfnCopy)(BYTE *, const BYTE *, DWORD);
+    BYTE    (* pfnSum)(BYTE *, DWORD, BYTE);
+    DWORD   ibIn;
+    DWORD   ibOut;
+    DWORD   cb;
+    DWORD   cbMax;
+
+    if ( ! FDrImplSupported(drimpl) ) {
+
+        drimpl = DrimplBest();
+    }
+
+    switch ( drimpl ) {
+#if defined(DR_X86)
+        case drimplAvx2:
+            pfnCopy = CbCopyLiteralAvx2;
+            pfnSum = BPrefixSumAvx2;
+            break;
+
+        case drimplSse2:
+            pfnCopy = CbCopyLiteralSse2;
+            pfnSum = BPrefixSumSse2;
+            break;
+#endif
+        default:
+            pfnCopy = CbCopyLiteralScalar;
+            pfnSum = BPrefixSumScalar;
+            break;
+    }
+
+    /* Pass 1: expand the run escapes into zero deltas.
+    */
+    ibIn = 0;
+    ibOut = 0;
+    while ( ibOut < cbOutMax ) {
+
+        if ( 0 != pdrs->crunPending ) {
+
+            cb = cbOutMax - ibOut;
+            if ( cb > pdrs->crunPending ) {
+                cb = pdrs->crunPending;
+            }
+
+            memset(&rgbOut[ibOut], 0, cb);
+            ibOut += cb;
+            pdrs->crunPending -= cb;
+            continue;
+        }
+
+        if ( ibIn == cbIn ) {
+            break;
+        }
+
+        if ( pdrs->fEscape ) {
+
+            pdrs->crunPending = (DWORD)rgbIn[ibIn] + 1;
+            pdrs->fEscape = fFalse;
+            ibIn++;
+            continue;
+        }
+
+        if ( bDrEscape == rgbIn[ibIn] ) {
+
+            pdrs->fEscape = fTrue;
+            ibIn++;
+            continue;
+        }
+
+        cbMax = cbIn - ibIn;
+        if ( cbMax > cbOutMax - ibOut ) {
+            cbMax = cbOutMax - ibOut;
+        }
+
+        cb = pfnCopy(&rgbOut[ibOut], &rgbIn[ibIn], cbMax);
+        ibIn += cb;
+        ibOut += cb;
+    }
+
+    /* Pass 2: turn the deltas back into samples.
+    */
+    if ( 0 != ibOut ) {
+
+        pdrs->bPrev = pfnSum(rgbOut, ibOut, pdrs->bPrev);
+    }
+
+    if ( NULL != pcbInUsed ) {
+        *pcbInUsed = ibIn;
+    }
+
+    return ibOut;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDrImplSupported
+**
+**  Parameters:
+**      drimpl  - decoder implementation
+**
+**  Return Values:
+**      fTrue if the processor can run the implementation
+**
+**  Errors:
+**
+**  Description:
+**      Check whether a decoder implementation may be used.
+*/
+BOOL
+FDrImplSupported( DWORD drimpl ) {
+
+    switch ( drimpl ) {
+        case drimplScalar:
+            return fTrue;
+
+#if defined(DR_X86)
+        case drimplSse2:
+            return __builtin_cpu_supports("sse2") ? fTrue : fFalse;
+
+        case drimplAvx2:
+            return __builtin_cpu_supports("avx2") ? fTrue : fFalse;
+#endif
+        default:
+            return fFalse;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    DrimplBest
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fastest decoder implementation supported by the processor
+**
+**  Errors:
+**
+**  Description:
+**      Determine the decoder implementation used by CbDrDecode. The
+**      result is computed once and cached.
+*/
+DWORD
+DrimplBest() {
+
+    if ( drimplBest == drimplCached ) {
+
+        if ( FDrImplSupported(drimplAvx2) ) {
+            drimplCached = drimplAvx2;
+        }
+        else if ( FDrImplSupported(drimplSse2) ) {
+            drimplCached = drimplSse2;
+        }
+        else {
+            drimplCached = drimplScalar;
+        }
+    }
+
+    return drimplCached;
+}
+
+/* ------------------------------------------------------------ */
+/***    SzDrImpl
+**
+**  Parameters:
+**      drimpl  - decoder implementation
+**
+**  Return Values:
+**      name of the implementation
+**
+**  Errors:
+**
+**  Description:
+**      Return a printable name for a decoder implementation.
+*/
+const char *
+SzDrImpl( DWORD drimpl ) {
+
+    switch ( drimpl ) {
+        case drimplScalar:
+            return "scalar";
+        case drimplSse2:
+            return "SSE2";
+        case drimplAvx2:
+            return "AVX2";
+        default:
+            return "best";
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    DrEncInit
+**
+**  Parameters:
+**      pdres   - encoder state to initialize
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Prepare an encoder for the start of a stream.
+*/
+void
+DrEncInit( DRENCSTATE * pdres ) {
+
+    pdres->bPrev = 0;
+    pdres->crun = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    CbDrEncode
+**
+**  Parameters:
+**      pdres   - encoder state
+**      rgbIn   - samples to encode
+**      cbIn    - number of samples in rgbIn
+**      rgbOut  - buffer that receives the encoded data, must be at least
+**                CbDrEncodeMax(cbIn) bytes
+**
+**  Return Values:
+**      number of bytes written to rgbOut
+**
+**  Errors:
+**
+**  Description:
+**      Encode samples exactly the way the FPGA encoder does. A run of
+**      zero deltas is only emitted once a non-zero delta follows it or
+**      the run reaches its maximum length, so the end of the data may
+**      be held back in the state until CbDrEncodeFlush is called. The
+**      FPGA encoder holds back the same bytes.
+*/
+DWORD
+CbDrEncode( DRENCSTATE * pdres, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut ) {
+
+    DWORD   ib;
+    DWORD   cbOut;
+    BYTE    bDelta;
+
+    cbOut = 0;
+    for ( ib = 0; ib < cbIn; ib++ ) {
+
+        bDelta = (BYTE)(rgbIn[ib] - pdres->bPrev);
+        pdres->bPrev = rgbIn[ib];
+
+        if ( 0 == bDelta ) {
+
+            pdres->crun++;
+            if ( crunDrMax == pdres->crun ) {
+
+                rgbOut[cbOut++] = bDrEscape;
+                rgbOut[cbOut++] = (BYTE)(crunDrMax - 1);
+                pdres->crun = 0;
+            }
+        }
+        else {
+
+            if ( 0 != pdres->crun ) {
+
+                rgbOut[cbOut++] = bDrEscape;
+                rgbOut[cbOut++] = (BYTE)(pdres->crun - 1);
+                pdres->crun = 0;
+            }
+
+            rgbOut[cbOut++] = bDelta;
+        }
+    }
+
+    return cbOut;
+}
+
+/* ------------------------------------------------------------ */
+/***    CbDrEncodeFlush
+**
+**  Parameters:
+**      pdres   - encoder state
+**      rgbOut  - buffer that receives at most two bytes
+**
+**  Return Values:
+**      number of bytes written to rgbOut
+**
+**  Errors:
+**
+**  Description:
+**      Emit the run of zero deltas that is pending at the end of the
+**      data.
+*/
+DWORD
+CbDrEncodeFlush( DRENCSTATE * pdres, BYTE * rgbOut ) {
+
+    if ( 0 == pdres->crun ) {
+        return 0;
+    }
+
+    rgbOut[0] = bDrEscape;
+    rgbOut[1] = (BYTE)(pdres->crun - 1);
+    pdres->crun = 0;
+
+    return 2;
+}
+
+/* ------------------------------------------------------------ */
+/***    CbCopyLiteralScalar
+**
+**  Parameters:
+**      pbDst   - destination
+**      pbSrc   - encoded input
+**      cbMax   - maximum number of bytes to copy
+**
+**  Return Values:
+**      number of bytes copied
+**
+**  Errors:
+**
+**  Description:
+**      Copy literal deltas up to the next run escape.
+*/
+static DWORD
+CbCopyLiteralScalar( BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax ) {
+
+    DWORD   ib;
+
+    for ( ib = 0; ( ib < cbMax ) && ( bDrEscape != pbSrc[ib] ); ib++ ) {
+        pbDst[ib] = pbSrc[ib];
+    }
+
+    return ib;
+}
+
+/* ------------------------------------------------------------ */
+/***    BPrefixSumScalar
+**
+**  Parameters:
+**      rgb     - deltas, replaced by the samples
+**      cb      - number of bytes in rgb
+**      bPrev   - sample preceding rgb[0]
+**
+**  Return Values:
+**      last sample
+**
+**  Errors:
+**
+**  Description:
+**      Compute the running sum of the deltas modulo 256.
+*/
+static BYTE
+BPrefixSumScalar( BYTE * rgb, DWORD cb, BYTE bPrev ) {
+
+    DWORD   ib;
+
+    for ( ib = 0; ib < cb; ib++ ) {
+
+        bPrev = (BYTE)(bPrev + rgb[ib]);
+        rgb[ib] = bPrev;
+    }
+
+    return bPrev;
+}
+
+#if defined(DR_X86)
+
+/* ------------------------------------------------------------ */
+/***    CbCopyLiteralSse2
+**
+**  Parameters:
+**      pbDst   - destination
+**      pbSrc   - encoded input
+**      cbMax   - maximum number of bytes to copy
+**
+**  Return Values:
+**      number of bytes copied
+**
+**  Errors:
+**
+**  Description:
+**      Copy literal deltas up to the next run escape 16 bytes at a time.
+**      Each vector is stored whole before it is checked for an escape.
+**      This is safe because the vector lies within cbMax; the bytes past
+**      the escape are overwritten by the next step of the decoder.
+*/
+__attribute__((target("sse2")))
+static DWORD
+CbCopyLiteralSse2( BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax ) {
+
+    __m128i vZero = _mm_setzero_si128();
+    __m128i v;
+    DWORD   ib;
+    int     msk;
+
+    for ( ib = 0; ib + 16 <= cbMax; ib += 16 ) {
+
+        v = _mm_loadu_si128((const __m128i *)&pbSrc[ib]);
+        _mm_storeu_si128((__m128i *)&pbDst[ib], v);
+
+        msk = _mm_movemask_epi8(_mm_cmpeq_epi8(v, vZero));
+        if ( 0 != msk ) {
+            return ib + __builtin_ctz(msk);
+        }
+    }
+
+    return ib + CbCopyLiteralScalar(&pbDst[ib], &pbSrc[ib], cbMax - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    BPrefixSumSse2
+**
+**  Parameters:
+**      rgb     - deltas, replaced by the samples
+**      cb      - number of bytes in rgb
+**      bPrev   - sample preceding rgb[0]
+**
+**  Return Values:
+**      last sample
+**
+**  Errors:
+**
+**  Description:
+**      Compute the running sum of the deltas 16 bytes at a time. Four
+**      shift and add steps produce the prefix sum within a vector, and
+**      the last sample of the previous vector is added to every byte.
+*/
+__attribute__((target("sse2")))
+static BYTE
+BPrefixSumSse2( BYTE * rgb, DWORD cb, BYTE bPrev ) {
+
+    __m128i vCarry = _mm_set1_epi8((char)bPrev);
+    __m128i v;
+    DWORD   ib;
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        v = _mm_loadu_si128((const __m128i *)&rgb[ib]);
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 1));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 2));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi8(v, vCarry);
+        _mm_storeu_si128((__m128i *)&rgb[ib], v);
+
+        /* Broadcast byte 15 for the next vector. SSE2 has no byte
+        ** shuffle, so go through 16-bit lanes.
+        */
+        v = _mm_srli_epi16(v, 8);
+        v = _mm_shufflehi_epi16(v, 0xFF);
+        v = _mm_unpackhi_epi64(v, v);
+        vCarry = _mm_or_si128(v, _mm_slli_epi16(v, 8));
+    }
+
+    bPrev = (BYTE)_mm_cvtsi128_si32(vCarry);
+
+    return BPrefixSumScalar(&rgb[ib], cb - ib, bPrev);
+}
+
+/* ------------------------------------------------------------ */
+/***    CbCopyLiteralAvx2
+**
+**  Parameters:
+**      pbDst   - destination
+**      pbSrc   - encoded input
+**      cbMax   - maximum number of bytes to copy
+**
+**  Return Values:
+**      number of bytes copied
+**
+**  Errors:
+**
+**  Description:
+**      Same as CbCopyLiteralSse2 using 32 byte vectors.
+*/
+__attribute__((target("avx2")))
+static DWORD
+CbCopyLiteralAvx2( BYTE * pbDst, const BYTE * pbSrc, DWORD cbMax ) {
+
+    __m256i vZero = _mm256_setzero_si256();
+    __m256i v;
+    DWORD   ib;
+    UINT32  msk;
+
+    for ( ib = 0; ib + 32 <= cbMax; ib += 32 ) {
+
+        v = _mm256_loadu_si256((const __m256i *)&pbSrc[ib]);
+        _mm256_storeu_si256((__m256i *)&pbDst[ib], v);
+
+        msk = (UINT32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vZero));
+        if ( 0 != msk ) {
+            return ib + __builtin_ctz(msk);
+        }
+    }
+
+    return ib + CbCopyLiteralSse2(&pbDst[ib], &pbSrc[ib], cbMax - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    BPrefixSumAvx2
+**
+**  Parameters:
+**      rgb     - deltas, replaced by the samples
+**      cb      - number of bytes in rgb
+**      bPrev   - sample preceding rgb[0]
+**
+**  Return Values:
+**      last sample
+**
+**  Errors:
+**
+**  Description:
+**      Compute the running sum of the deltas 32 bytes at a time. The
+**      AVX2 byte shifts operate on each 128-bit lane separately, so
+**      after the in-lane prefix sum the last byte of the low lane is
+**      broadcast and added to the high lane.
+*/
+__attribute__((target("avx2")))
+static BYTE
+BPrefixSumAvx2( BYTE * rgb, DWORD cb, BYTE bPrev ) {
+
+    const __m256i   vIdx15 = _mm256_set1_epi8(15);
+    __m256i         vCarry = _mm256_set1_epi8((char)bPrev);
+    __m256i         v;
+    __m256i         vLast;
+    DWORD           ib;
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        v = _mm256_loadu_si256((const __m256i *)&rgb[ib]);
+        v = _mm256_add_epi8(v, _mm256_slli_si256(v, 1));
+        v = _mm256_add_epi8(v, _mm256_slli_si256(v, 2));
+        v = _mm256_add_epi8(v, _mm256_slli_si256(v, 4));
+        v = _mm256_add_epi8(v, _mm256_slli_si256(v, 8));
+
+        /* Carry the low lane into the high lane. vLast holds byte 15 of
+        ** each lane broadcast across that lane.
+        */
+        vLast = _mm256_shuffle_epi8(v, vIdx15);
+        v = _mm256_add_epi8(v, _mm256_permute2x128_si256(vLast, vLast, 0x08));
+
+        v = _mm256_add_epi8(v, vCarry);
+        _mm256_storeu_si256((__m256i *)&rgb[ib], v);
+
+        vLast = _mm256_shuffle_epi8(v, vIdx15);
+        vCarry = _mm256_permute2x128_si256(vLast, vLast, 0x11);
+    }
+
+    bPrev = (BYTE)_mm256_cvtsi256_si32(vCarry);
+
+    return BPrefixSumSse2(&rgb[ib], cb - ib, bPrev);
+}
+
+#endif
+
+/************************************************************************/
@@ -0,0 +1,97 @@
+/************************************************************************/
+/*                                                                      */
+/*    DeltaRle.h  --    Interface Declarations for DeltaRle.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the      */
+/*    host side of the delta plus run-length encoding used by the       */
+/*    DeltaRle upload stage of the StreamIO FPGA design.                */
+/*                                                                      */
+/*    Each sample x(i) is replaced by d(i) = x(i) - x(i-1) (modulo 256, */
+/*    x(-1) = 0). A non-zero delta is sent as a single byte. A run of   */
+/*    k zero deltas (1 <= k <= 256) is sent as the two bytes 0x00, k-1. */
+/*                                                                      */
+/*    The decoder is vectorized using AVX2 or SSE2, selected at run     */
+/*    time based on the capabilities of the processor. The encoder is   */
+/*    a plain C implementation of the FPGA encoder and is used to       */
+/*    produce reference data.                                           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(DELTARLE_INCLUDED)
+#define      DELTARLE_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Decoder implementations. drimplBest selects the fastest one that is
+** supported by the processor.
+*/
+const DWORD drimplScalar    = 0;
+const DWORD drimplSse2      = 1;
+const DWORD drimplAvx2      = 2;
+const DWORD drimplBest      = 0xFFFFFFFF;
+
+/* Longest run of zero deltas that can be encoded by one escape.
+*/
+const DWORD crunDrMax       = 256;
+
+/* Worst case size of the encoded data for cb input bytes. A zero delta
+** followed by a non-zero delta produces three bytes from two inputs
+** and a flush may add one run escape.
+*/
+#define CbDrEncodeMax(cb)   ((((cb) * 3) + 1) / 2 + 2)
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Decoder state. This is carried from one call of CbDrDecode to the
+** next so that a stream may be decoded in arbitrarily sized pieces.
+*/
+typedef struct {
+    BYTE    bPrev;          // last decoded sample
+    BOOL    fEscape;        // last input byte was a run escape (0x00)
+    DWORD   crunPending;    // repeats of bPrev that didn't fit in the output
+} DRSTATE;
+
+/* Encoder state.
+*/
+typedef struct {
+    BYTE    bPrev;          // last input sample
+    DWORD   crun;           // zero deltas that haven't been emitted yet
+} DRENCSTATE;
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+void    DrInit(DRSTATE * pdrs);
+DWORD   CbDrDecode(DRSTATE * pdrs, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut, DWORD cbOutMax, DWORD * pcbInUsed);
+DWORD   CbDrDecodeImpl(DWORD drimpl, DRSTATE * pdrs, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut, DWORD cbOutMax, DWORD * pcbInUsed);
+BOOL    FDrImplSupported(DWORD drimpl);
+DWORD   DrimplBest();
+const char * SzDrImpl(DWORD drimpl);
+
+void    DrEncInit(DRENCSTATE * pdres);
+DWORD   CbDrEncode(DRENCSTATE * pdres, const BYTE * rgbIn, DWORD cbIn, BYTE * rgbOut);
+DWORD   CbDrEncodeFlush(DRENCSTATE * pdres, BYTE * rgbOut);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // DELTARLE_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,768 @@
+/************************************************************************/
+/*                                                                      */
+/*  DeppI2c.cpp  --  Host side of the FIFO-fed I2C master               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module drives the I2C master of fpga/spi_top.vhd through its   */
+/*  DEPP registers. A transaction costs the same number of DEPP calls   */
+/*  however many bytes it moves: one DeppPutRegSet that holds the       */
+/*  master, empties the FIFOs, writes the bytes to send and the         */
+/*  commands and releases the hold, the status reads that wait for the  */
+/*  transaction to end and, for a read, one DeppGetRegRepeat that       */
+/*  empties the RX FIFO.                                                */
+/*                                                                      */
+/*  The commands are written while the master is held so that a write   */
+/*  chained to a read is always followed by a repeated start, whatever  */
+/*  the timing of the DEPP writes.                                      */
+/*                                                                      */
+/*  Each slave may have its own SCL clock divider. FFindFastest tries   */
+/*  the rates in rgfrqDiRate from the fastest down, checking each one   */
+/*  against reads made at the slowest rate, and keeps the fastest rate  */
+/*  at which the slave and every slower rate passed.                    */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the clock divider, the stretch count and the      */
+/*              search for the fastest rate of a slave                  */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "depp.h"
+#include "DeppI2c.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Largest number of status reads while waiting for a transaction to
+** end.
+*/
+const DWORD     cpollDiMax = 100000;
+
+/* System clock frequency, and the SCL rates tried by FFindFastest. The
+** last rate is the reference that the others are checked against.
+*/
+const DWORD     frqDiSystem = 50000000;
+
+static const DWORD  rgfrqDiRate[crateDi] = {
+    1000000, 800000, 600000, 400000, 250000, 100000, 50000, 10000
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    DeppI2c::DeppI2c
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Constructor.
+*/
+DeppI2c::DeppI2c() {
+
+    hif = hifInvalid;
+    regBase = regDiBaseDefault;
+    bStatLast = 0;
+    cpollLast = 0;
+    clkDivDefault = 0;
+    clkDivCur = clkDiDivMax + 1;
+    memset(rgclkDivSlave, 0, sizeof(rgclkDivSlave));
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::Init
+**
+**  Parameters:
+**      hifReq      - device with DEPP enabled
+**      regBaseReq  - address of the first I2C register
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Select the I2C master to use.
+*/
+void
+DeppI2c::Init( HIF hifReq, BYTE regBaseReq ) {
+
+    hif = hifReq;
+    regBase = regBaseReq;
+    clkDivCur = clkDiDivMax + 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FFlush
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Empty the FIFOs and clear the error flags. The master must not be
+**      busy.
+*/
+BOOL
+DeppI2c::FFlush() {
+
+    return DeppPutReg(hif, regBase + regDiStat, 0, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FGetStatus
+**
+**  Parameters:
+**      pbStat  - receives the status register
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the status register.
+*/
+BOOL
+DeppI2c::FGetStatus( BYTE * pbStat ) {
+
+    return DeppGetReg(hif, regBase + regDiStat, pbStat, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FGetLevels
+**
+**  Parameters:
+**      pcbTx   - receives the number of bytes in the TX FIFO
+**      pcbRx   - receives the number of bytes in the RX FIFO
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the fill levels of the data FIFOs. The four level registers
+**      are read with one call.
+*/
+BOOL
+DeppI2c::FGetLevels( DWORD * pcbTx, DWORD * pcbRx ) {
+
+    BYTE    rgbAdr[4];
+    BYTE    rgbLvl[4];
+
+    rgbAdr[0] = regBase + regDiTxLevelL;
+    rgbAdr[1] = regBase + regDiTxLevelH;
+    rgbAdr[2] = regBase + regDiRxLevelL;
+    rgbAdr[3] = regBase + regDiRxLevelH;
+
+    if ( ! DeppGetRegSet(hif, rgbAdr, rgbLvl, 4, fFalse) ) {
+        return fFalse;
+    }
+
+    *pcbTx = ((DWORD)rgbLvl[1] << 8) | rgbLvl[0];
+    *pcbRx = ((DWORD)rgbLvl[3] << 8) | rgbLvl[2];
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FWrite
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**      rgbSnd  - bytes to write
+**      cbSnd   - number of bytes, 1 to cbDiFifo
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      See FRun.
+**
+**  Description:
+**      Write bytes to a slave in one transaction.
+*/
+BOOL
+DeppI2c::FWrite( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd ) {
+
+    if ( 0 == cbSnd ) {
+        return fFalse;
+    }
+
+    return FRun(dadr, rgbSnd, cbSnd, NULL, 0);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FRead
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**      rgbRcv  - receives the bytes read
+**      cbRcv   - number of bytes, 1 to cbDiFifo
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      See FRun.
+**
+**  Description:
+**      Read bytes from a slave in one transaction.
+*/
+BOOL
+DeppI2c::FRead( BYTE dadr, BYTE * rgbRcv, DWORD cbRcv ) {
+
+    if ( 0 == cbRcv ) {
+        return fFalse;
+    }
+
+    return FRun(dadr, NULL, 0, rgbRcv, cbRcv);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FWriteRead
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**      rgbSnd  - bytes to write, such as a register number
+**      cbSnd   - number of bytes to write, 1 to cbDiFifo
+**      rgbRcv  - receives the bytes read
+**      cbRcv   - number of bytes to read, 1 to cbDiFifo
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      See FRun.
+**
+**  Description:
+**      Write bytes to a slave and read from it after a repeated start,
+**      which is how the registers of most sensors are read.
+*/
+BOOL
+DeppI2c::FWriteRead( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, BYTE * rgbRcv, DWORD cbRcv ) {
+
+    if (( 0 == cbSnd ) || ( 0 == cbRcv )) {
+        return fFalse;
+    }
+
+    return FRun(dadr, rgbSnd, cbSnd, rgbRcv, cbRcv);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FRun
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**      rgbSnd  - bytes to write
+**      cbSnd   - number of bytes to write, 0 to cbDiFifo
+**      rgbRcv  - receives the bytes read
+**      cbRcv   - number of bytes to read, 0 to cbDiFifo
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a DEPP call fails, the transaction doesn't end in time
+**      or the status register shows an error. The status read last is
+**      kept for BStatLast, so that a slave that didn't acknowledge can
+**      be told from other errors.
+**
+**  Description:
+**      Run a write, a read, or a write chained to a read, as one
+**      transaction.
+*/
+BOOL
+DeppI2c::FRun( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, BYTE * rgbRcv, DWORD cbRcv ) {
+
+    DWORD   cpair;
+    DWORD   ib;
+    DWORD   clkDiv;
+
+    if (( 0x7F < dadr ) || ( cbDiFifo < cbSnd ) || ( cbDiFifo < cbRcv )) {
+        return fFalse;
+    }
+
+    cpair = 0;
+    bStatLast = 0;
+    clkDiv = ( 0 != rgclkDivSlave[dadr] ) ? rgclkDivSlave[dadr] : clkDivDefault;
+
+    /* Hold the master and empty the FIFOs, so that no stale bytes are
+    ** read and the commands are all in place before the first one is
+    ** started.
+    */
+    rgbSet[2 * cpair] = regBase + regDiCfg;
+    rgbSet[2 * cpair + 1] = bDiHold;
+    cpair++;
+    rgbSet[2 * cpair] = regBase + regDiStat;
+    rgbSet[2 * cpair + 1] = 0;
+    cpair++;
+
+    /* The master takes a new divider while it is idle, so the divider of
+    ** this slave is in use before the hold is released.
+    */
+    if ( clkDiv != clkDivCur ) {
+        rgbSet[2 * cpair] = regBase + regDiDivL;
+        rgbSet[2 * cpair + 1] = (BYTE)(clkDiv & 0xFF);
+        cpair++;
+        rgbSet[2 * cpair] = regBase + regDiDivH;
+        rgbSet[2 * cpair + 1] = (BYTE)(clkDiv >> 8);
+        cpair++;
+    }
+
+    for ( ib = 0; ib < cbSnd; ib++ ) {
+        rgbSet[2 * cpair] = regBase + regDiData;
+        rgbSet[2 * cpair + 1] = rgbSnd[ib];
+        cpair++;
+    }
+
+    if ( 0 < cbSnd ) {
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)(dadr << 1);
+        cpair++;
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)(cbSnd & 0xFF);
+        cpair++;
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)(cbSnd >> 8) | (( 0 < cbRcv ) ? bDiChain : 0);
+        cpair++;
+    }
+
+    if ( 0 < cbRcv ) {
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)((dadr << 1) | 1);
+        cpair++;
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)(cbRcv & 0xFF);
+        cpair++;
+        rgbSet[2 * cpair] = regBase + regDiCmd;
+        rgbSet[2 * cpair + 1] = (BYTE)(cbRcv >> 8);
+        cpair++;
+    }
+
+    rgbSet[2 * cpair] = regBase + regDiCfg;
+    rgbSet[2 * cpair + 1] = 0;
+    cpair++;
+
+    if ( ! DeppPutRegSet(hif, rgbSet, cpair, fFalse) ) {
+        clkDivCur = clkDiDivMax + 1;
+        return fFalse;
+    }
+
+    clkDivCur = clkDiv;
+
+    if ( ! FWaitIdle() ) {
+        return fFalse;
+    }
+
+    if ( 0 != ( bStatLast & ( bDiNak | bDiCmdErr | bDiRxOvf ))) {
+        return fFalse;
+    }
+
+    if ( 0 == cbRcv ) {
+        return fTrue;
+    }
+
+    return DeppGetRegRepeat(hif, regBase + regDiData, rgbRcv, cbRcv, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FSetDivider
+**
+**  Parameters:
+**      clkDiv  - system clock cycles per quarter period of SCL, or 0
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock divider used for slaves that don't have their own.
+**      A divider of 0 selects the rate the design was built for.
+*/
+BOOL
+DeppI2c::FSetDivider( DWORD clkDiv ) {
+
+    BYTE    rgbDiv[4];
+
+    if (( 0 != clkDiv ) && (( clkDiDivMin > clkDiv ) || ( clkDiDivMax < clkDiv ))) {
+        return fFalse;
+    }
+
+    rgbDiv[0] = regBase + regDiDivL;
+    rgbDiv[1] = (BYTE)(clkDiv & 0xFF);
+    rgbDiv[2] = regBase + regDiDivH;
+    rgbDiv[3] = (BYTE)(clkDiv >> 8);
+
+    if ( ! DeppPutRegSet(hif, rgbDiv, 2, fFalse) ) {
+        clkDivCur = clkDiDivMax + 1;
+        return fFalse;
+    }
+
+    clkDivDefault = clkDiv;
+    clkDivCur = clkDiv;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FSetFrequency
+**
+**  Parameters:
+**      frqReq  - requested SCL frequency in Hz
+**      pfrqSet - receives the frequency set, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock divider used for slaves that don't have their own
+**      for the fastest SCL frequency that isn't above the frequency
+**      requested.
+*/
+BOOL
+DeppI2c::FSetFrequency( DWORD frqReq, DWORD * pfrqSet ) {
+
+    DWORD   clkDiv;
+
+    if ( 0 == frqReq ) {
+        return fFalse;
+    }
+
+    clkDiv = ClkDiFrequency(frqReq);
+
+    if ( ! FSetDivider(clkDiv) ) {
+        return fFalse;
+    }
+
+    if ( NULL != pfrqSet ) {
+        *pfrqSet = FrqDiDivider(clkDiv);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::SetSlaveDivider
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**      clkDiv  - clock divider for the slave, or 0
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock divider used for the transactions with a slave. A
+**      divider of 0 makes the slave use the divider set by FSetDivider.
+**      Invalid addresses and dividers are ignored.
+*/
+void
+DeppI2c::SetSlaveDivider( BYTE dadr, DWORD clkDiv ) {
+
+    if (( 0x7F < dadr ) ||
+        (( 0 != clkDiv ) && (( clkDiDivMin > clkDiv ) || ( clkDiDivMax < clkDiv )))) {
+        return;
+    }
+
+    rgclkDivSlave[dadr] = clkDiv;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::ClkSlaveDivider
+**
+**  Parameters:
+**      dadr    - 7 bit address of the slave
+**
+**  Return Values:
+**      clock divider of the slave, or 0 if it uses the default
+**
+**  Errors:
+**
+**  Description:
+**      Get the clock divider set for a slave.
+*/
+DWORD
+DeppI2c::ClkSlaveDivider( BYTE dadr ) const {
+
+    return ( 0x7F < dadr ) ? 0 : rgclkDivSlave[dadr];
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FGetStretch
+**
+**  Parameters:
+**      pcstretch   - receives the number of SCL periods stretched
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the number of SCL periods that slaves stretched during the
+**      last transaction, up to 0xFFFF.
+*/
+BOOL
+DeppI2c::FGetStretch( DWORD * pcstretch ) {
+
+    BYTE    rgbAdr[2];
+    BYTE    rgbCnt[2];
+
+    rgbAdr[0] = regBase + regDiStretchL;
+    rgbAdr[1] = regBase + regDiStretchH;
+
+    if ( ! DeppGetRegSet(hif, rgbAdr, rgbCnt, 2, fFalse) ) {
+        return fFalse;
+    }
+
+    *pcstretch = ((DWORD)rgbCnt[1] << 8) | rgbCnt[0];
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FFindFastest
+**
+**  Parameters:
+**      dadr        - 7 bit address of the slave
+**      rgbSnd      - bytes to write before each read, may be NULL
+**      cbSnd       - number of bytes to write, 0 to cbDiFifo
+**      cbRcv       - number of bytes to read, 1 to cbDiFifo
+**      cpass       - transactions run at each rate
+**      pfrqBest    - receives the rate chosen, may be NULL
+**      rgrate      - receives the outcome of each of the crateDi
+**                    rates, fastest first, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a DEPP call fails, a transaction doesn't end in time
+**      or the slave can't be read at the slowest rate. The divider of
+**      the slave is then left as it was.
+**
+**  Description:
+**      Find the fastest rate a slave tolerates and make it the rate of
+**      the slave. The slave is read at the slowest rate, then cpass
+**      times at each rate. A rate passes when every transaction is
+**      acknowledged and reads what was read at the slowest rate, so the
+**      registers read must not change on their own: an identification
+**      register is a good choice. The rate chosen is the fastest one
+**      that passed along with every slower rate.
+*/
+BOOL
+DeppI2c::FFindFastest( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, DWORD cbRcv,
+                       DWORD cpass, DWORD * pfrqBest, DIRATE * rgrate ) {
+
+    BYTE    rgbRef[cbDiFifo];
+    BYTE    rgbRcv[cbDiFifo];
+    DIRATE  rgrateTry[crateDi];
+    DWORD   clkDivSave;
+    DWORD   irate;
+    DWORD   irateBest;
+    DWORD   ipass;
+    DWORD   cstretch;
+
+    if (( 0x7F < dadr ) || ( 0 == cbRcv ) || ( cbDiFifo < cbRcv ) ||
+        ( cbDiFifo < cbSnd ) || ( 0 == cpass )) {
+        return fFalse;
+    }
+
+    clkDivSave = rgclkDivSlave[dadr];
+
+    rgclkDivSlave[dadr] = ClkDiFrequency(rgfrqDiRate[crateDi - 1]);
+
+    if ( ! FRun(dadr, rgbSnd, cbSnd, rgbRef, cbRcv) ) {
+        rgclkDivSlave[dadr] = clkDivSave;
+        return fFalse;
+    }
+
+    for ( irate = 0; irate < crateDi; irate++ ) {
+
+        rgrateTry[irate].clkDiv = ClkDiFrequency(rgfrqDiRate[irate]);
+        rgrateTry[irate].frq = FrqDiDivider(rgrateTry[irate].clkDiv);
+        rgrateTry[irate].fPass = fTrue;
+        rgrateTry[irate].cstretch = 0;
+
+        rgclkDivSlave[dadr] = rgrateTry[irate].clkDiv;
+
+        for ( ipass = 0; ipass < cpass; ipass++ ) {
+
+            if ( ! FRun(dadr, rgbSnd, cbSnd, rgbRcv, cbRcv) ) {
+
+                /* A status error is the slave failing at this rate, any
+                ** other failure ends the search.
+                */
+                if ( 0 == ( bStatLast & ( bDiNak | bDiCmdErr | bDiRxOvf ))) {
+                    rgclkDivSlave[dadr] = clkDivSave;
+                    return fFalse;
+                }
+
+                rgrateTry[irate].fPass = fFalse;
+            }
+            else if ( 0 != memcmp(rgbRcv, rgbRef, cbRcv) ) {
+                rgrateTry[irate].fPass = fFalse;
+            }
+
+            if ( ! FGetStretch(&cstretch) ) {
+                rgclkDivSlave[dadr] = clkDivSave;
+                return fFalse;
+            }
+
+            rgrateTry[irate].cstretch += cstretch;
+
+            if ( ! rgrateTry[irate].fPass ) {
+                break;
+            }
+        }
+    }
+
+    /* Take the fastest rate with only passes below it.
+    */
+    irateBest = crateDi - 1;
+    while (( 0 < irateBest ) && rgrateTry[irateBest - 1].fPass ) {
+        irateBest--;
+    }
+
+    if ( ! rgrateTry[irateBest].fPass ) {
+        irateBest = crateDi - 1;
+    }
+
+    rgclkDivSlave[dadr] = rgrateTry[irateBest].clkDiv;
+
+    if ( NULL != pfrqBest ) {
+        *pfrqBest = rgrateTry[irateBest].frq;
+    }
+
+    if ( NULL != rgrate ) {
+        memcpy(rgrate, rgrateTry, sizeof(rgrateTry));
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppI2c::FWaitIdle
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the master is still busy after cpollDiMax reads.
+**
+**  Description:
+**      Wait for the master to run every command in the command FIFO.
+*/
+BOOL
+DeppI2c::FWaitIdle() {
+
+    for ( cpollLast = 1; cpollLast <= cpollDiMax; cpollLast++ ) {
+
+        if ( ! DeppGetReg(hif, regBase + regDiStat, &bStatLast, fFalse) ) {
+            return fFalse;
+        }
+
+        if ( 0 == ( bStatLast & bDiBusy )) {
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    ClkDiFrequency
+**
+**  Parameters:
+**      frqReq  - requested SCL frequency in Hz
+**
+**  Return Values:
+**      clock divider of the fastest SCL frequency that isn't above the
+**      frequency requested, within the range of the divider
+**
+**  Errors:
+**
+**  Description:
+**      Get the clock divider for an SCL frequency.
+*/
+DWORD
+ClkDiFrequency( DWORD frqReq ) {
+
+    DWORD   clkDiv;
+
+    if ( 0 == frqReq ) {
+        return clkDiDivMax;
+    }
+
+    clkDiv = (frqDiSystem + 4 * frqReq - 1) / (4 * frqReq);
+
+    if ( clkDiDivMin > clkDiv ) {
+        clkDiv = clkDiDivMin;
+    }
+
+    if ( clkDiDivMax < clkDiv ) {
+        clkDiv = clkDiDivMax;
+    }
+
+    return clkDiv;
+}
+
+/* ------------------------------------------------------------ */
+/***    FrqDiDivider
+**
+**  Parameters:
+**      clkDiv  - clock divider
+**
+**  Return Values:
+**      SCL frequency in Hz, or 0 for an invalid divider
+**
+**  Errors:
+**
+**  Description:
+**      Get the SCL frequency of a clock divider.
+*/
+DWORD
+FrqDiDivider( DWORD clkDiv ) {
+
+    if (( clkDiDivMin > clkDiv ) || ( clkDiDivMax < clkDiv )) {
+        return 0;
+    }
+
+    return frqDiSystem / (4 * clkDiv);
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,169 @@
+/************************************************************************/
+/*                                                                      */
+/*    DeppI2c.h  --    Interface Declarations for DeppI2c.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the host */
+/*    side of the FIFO-fed I2C master in fpga/spi_top.vhd. The I2C      */
+/*    registers are reached through DEPP. The bytes to write and the    */
+/*    commands of a whole transaction are written with one              */
+/*    DeppPutRegSet call, the FPGA runs the transaction on its own, and */
+/*    the bytes read are taken from the RX FIFO with one                */
+/*    DeppGetRegRepeat call.                                            */
+/*                                                                      */
+/*    The SCL clock divider can be set for each slave, so that slaves   */
+/*    on the same bus each run at the fastest rate they tolerate. The   */
+/*    divider of a slave is written in the same DeppPutRegSet call as   */
+/*    the transaction, when it differs from the one set last, and       */
+/*    FFindFastest finds it by trying the rates from the fastest down.  */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the clock divider, the stretch count and the      */
+/*              search for the fastest rate of a slave                  */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(DEPPI2C_INCLUDED)
+#define      DEPPI2C_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Register offsets from the base address of the I2C registers. The
+** block follows the blocks of the SPI slaves, so it is at 0x60 in the
+** default spi_top design with four slaves.
+*/
+const BYTE  regDiBaseDefault    = 0x60;
+const BYTE  regDiCfg            = 0;
+const BYTE  regDiStat           = 1;
+const BYTE  regDiData           = 2;
+const BYTE  regDiTxLevelL       = 3;
+const BYTE  regDiTxLevelH       = 4;
+const BYTE  regDiRxLevelL       = 5;
+const BYTE  regDiRxLevelH       = 6;
+const BYTE  regDiDivL           = 7;
+const BYTE  regDiDivH           = 8;
+const BYTE  regDiCmd            = 9;
+const BYTE  regDiStretchL       = 10;
+const BYTE  regDiStretchH       = 11;
+
+/* Configuration register bits.
+*/
+const BYTE  bDiHold             = 0x40;
+
+/* Status register bits.
+*/
+const BYTE  bDiBusy             = 0x01;
+const BYTE  bDiTxFull           = 0x02;
+const BYTE  bDiTxEmpty          = 0x04;
+const BYTE  bDiRxFull           = 0x08;
+const BYTE  bDiRxEmpty          = 0x10;
+const BYTE  bDiRxOvf            = 0x20;
+const BYTE  bDiNak              = 0x40;
+const BYTE  bDiCmdErr           = 0x80;
+
+/* A command is the address byte, then the byte count, low byte first.
+** The chain bit in the high byte makes the next command follow with a
+** repeated start.
+*/
+const DWORD cbDiCmd             = 3;
+const BYTE  bDiChain            = 0x80;
+
+/* Size of each data FIFO, which is the longest write and, since the RX
+** FIFO isn't emptied until the transaction ends, the longest read. The
+** command FIFO holds ccmdDiFifo commands.
+*/
+const DWORD cbDiFifo            = 512;
+const DWORD ccmdDiFifo          = 16;
+
+/* Range of the clock divider, in system clock cycles per quarter period
+** of SCL. A divider of 0 selects the rate the design was built for.
+*/
+const DWORD clkDiDivMin         = 2;
+const DWORD clkDiDivMax         = 0xFFFF;
+
+/* Rates tried by FFindFastest, from Fast-mode Plus down.
+*/
+const DWORD crateDi             = 8;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Outcome of one rate tried by FFindFastest. A rate passes when every
+** transaction is acknowledged and reads the same bytes as at the
+** slowest rate. cstretch counts the SCL periods the slave stretched,
+** which includes periods in which SCL rose too slowly to be high when
+** the master looked.
+*/
+typedef struct {
+    DWORD   frq;
+    DWORD   clkDiv;
+    BOOL    fPass;
+    DWORD   cstretch;
+} DIRATE;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class DeppI2c {
+
+private:
+    HIF     hif;
+    BYTE    regBase;
+    BYTE    bStatLast;
+    DWORD   cpollLast;
+    DWORD   clkDivDefault;
+    DWORD   clkDivCur;              // divider in the registers, or > clkDiDivMax if unknown
+    DWORD   rgclkDivSlave[128];     // 0 to use clkDivDefault
+    BYTE    rgbSet[2 * (cbDiFifo + 2 * cbDiCmd + 5)];
+
+    BOOL    FRun(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, BYTE * rgbRcv, DWORD cbRcv);
+    BOOL    FWaitIdle();
+
+    DeppI2c(const DeppI2c &);
+    DeppI2c & operator=(const DeppI2c &);
+
+public:
+    DeppI2c();
+
+    void    Init(HIF hifReq, BYTE regBaseReq);
+
+    BOOL    FFlush();
+    BOOL    FGetStatus(BYTE * pbStat);
+    BOOL    FGetLevels(DWORD * pcbTx, DWORD * pcbRx);
+    BOOL    FWrite(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd);
+    BOOL    FRead(BYTE dadr, BYTE * rgbRcv, DWORD cbRcv);
+    BOOL    FWriteRead(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, BYTE * rgbRcv, DWORD cbRcv);
+
+    BOOL    FSetDivider(DWORD clkDiv);
+    BOOL    FSetFrequency(DWORD frqReq, DWORD * pfrqSet);
+    void    SetSlaveDivider(BYTE dadr, DWORD clkDiv);
+    DWORD   ClkSlaveDivider(BYTE dadr) const;
+    BOOL    FGetStretch(DWORD * pcstretch);
+    BOOL    FFindFastest(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, DWORD cbRcv,
+                         DWORD cpass, DWORD * pfrqBest, DIRATE * rgrate);
+
+    BYTE    BStatLast() const { return bStatLast; }
+    DWORD   CpollLast() const { return cpollLast; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+DWORD   ClkDiFrequency(DWORD frqReq);
+DWORD   FrqDiDivider(DWORD clkDiv);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // DEPPI2C_INCLUDED
+
+/************************************************************************/
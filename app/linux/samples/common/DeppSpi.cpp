@@ -0,0 +1,552 @@
+/************************************************************************/
+/*                                                                      */
+/*  DeppSpi.cpp  --  Host side of the FIFO-fed SPI master               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module drives the SPI master of fpga/spi_top.vhd through its   */
+/*  DEPP registers. Each frame costs five DEPP calls however long it    */
+/*  is: one DeppPutRegSet that holds the master and empties the FIFOs,  */
+/*  one DeppPutRegRepeat that fills the TX FIFO, one DeppPutReg that    */
+/*  releases the hold, the status reads that wait for the frame to be   */
+/*  sent and one DeppGetRegRepeat that empties the RX FIFO.             */
+/*                                                                      */
+/*  A frame may also be sent in two halves, FStartFrame and FEndFrame,  */
+/*  so that a program can start frames on several slaves before it      */
+/*  waits for any of them. The slaves then shift at the same time, each */
+/*  at its own clock.                                                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the clock divider and split frames                */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "depp.h"
+#include "DeppSpi.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Clock divider of each speed setting, in system clock cycles per half
+** period of SCLK, and the system clock frequency.
+*/
+static const DWORD  rgclkDsDiv[ispeedDsMax + 1] = {
+    25000, 2500, 500, 250, 50, 25, 12, 6
+};
+
+const DWORD     frqDsSystem = 50000000;
+
+/* Largest number of status reads while waiting for a frame to be sent.
+*/
+const DWORD     cpollDsMax = 100000;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    DeppSpi::DeppSpi
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Constructor.
+*/
+DeppSpi::DeppSpi() {
+
+    hif = hifInvalid;
+    regBase = regDsBaseDefault;
+    bCfg = 0;
+    cpollLast = 0;
+    cbFrame = 0;
+    fRcvFrame = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::Init
+**
+**  Parameters:
+**      hifReq      - device with DEPP enabled
+**      regBaseReq  - address of the first SPI register
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Select the SPI master to use.
+*/
+void
+DeppSpi::Init( HIF hifReq, BYTE regBaseReq ) {
+
+    hif = hifReq;
+    regBase = regBaseReq;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FConfigure
+**
+**  Parameters:
+**      idMode  - SPI mode, 0 to 3
+**      ispeed  - speed setting, 0 to ispeedDsMax
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock polarity, phase and speed, and enable the master.
+**      The clock divider is cleared, so that the speed setting is used.
+*/
+BOOL
+DeppSpi::FConfigure( int idMode, int ispeed ) {
+
+    BYTE    rgbSet[6];
+
+    if (( 0 > idMode ) || ( 3 < idMode ) || ( 0 > ispeed ) || ( ispeedDsMax < ispeed )) {
+        return fFalse;
+    }
+
+    bCfg = bDsEnable | (BYTE)(ispeed << shfDsSpeed);
+
+    if ( idMode & 2 ) {
+        bCfg |= bDsCpol;
+    }
+
+    if ( idMode & 1 ) {
+        bCfg |= bDsCpha;
+    }
+
+    rgbSet[0] = regBase + regDsCfg;
+    rgbSet[1] = bCfg;
+    rgbSet[2] = regBase + regDsDivL;
+    rgbSet[3] = 0;
+    rgbSet[4] = regBase + regDsDivH;
+    rgbSet[5] = 0;
+
+    return DeppPutRegSet(hif, rgbSet, 3, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FSetDivider
+**
+**  Parameters:
+**      clkDiv  - system clock cycles per half period of SCLK, or 0
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock divider of the master. A divider of 0 selects the
+**      speed setting given to FConfigure.
+*/
+BOOL
+DeppSpi::FSetDivider( DWORD clkDiv ) {
+
+    BYTE    rgbSet[4];
+
+    if ( clkDsDivMax < clkDiv ) {
+        return fFalse;
+    }
+
+    rgbSet[0] = regBase + regDsDivL;
+    rgbSet[1] = (BYTE)(clkDiv & 0xFF);
+    rgbSet[2] = regBase + regDsDivH;
+    rgbSet[3] = (BYTE)(clkDiv >> 8);
+
+    return DeppPutRegSet(hif, rgbSet, 2, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FSetFrequency
+**
+**  Parameters:
+**      frqReq  - requested SCLK frequency in Hz
+**      pfrqSet - receives the frequency set, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock divider for the fastest SCLK frequency that isn't
+**      above the frequency requested, or for the slowest frequency if
+**      every frequency is above it.
+*/
+BOOL
+DeppSpi::FSetFrequency( DWORD frqReq, DWORD * pfrqSet ) {
+
+    DWORD   clkDiv;
+
+    if ( 0 == frqReq ) {
+        return fFalse;
+    }
+
+    clkDiv = (frqDsSystem + 2 * frqReq - 1) / (2 * frqReq);
+
+    if ( clkDsDivMin > clkDiv ) {
+        clkDiv = clkDsDivMin;
+    }
+
+    if ( clkDsDivMax < clkDiv ) {
+        clkDiv = clkDsDivMax;
+    }
+
+    if ( ! FSetDivider(clkDiv) ) {
+        return fFalse;
+    }
+
+    if ( NULL != pfrqSet ) {
+        *pfrqSet = FrqDsDivider(clkDiv);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FFlush
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Empty both FIFOs and clear the RX overflow flag.
+*/
+BOOL
+DeppSpi::FFlush() {
+
+    return DeppPutReg(hif, regBase + regDsStat, 0, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FGetStatus
+**
+**  Parameters:
+**      pbStat  - receives the status register
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the status register.
+*/
+BOOL
+DeppSpi::FGetStatus( BYTE * pbStat ) {
+
+    return DeppGetReg(hif, regBase + regDsStat, pbStat, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FGetLevels
+**
+**  Parameters:
+**      pcbTx   - receives the number of bytes in the TX FIFO
+**      pcbRx   - receives the number of bytes in the RX FIFO
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the fill levels of the FIFOs. The four level registers are
+**      read with one call.
+*/
+BOOL
+DeppSpi::FGetLevels( DWORD * pcbTx, DWORD * pcbRx ) {
+
+    BYTE    rgbAdr[4];
+    BYTE    rgbLvl[4];
+
+    rgbAdr[0] = regBase + regDsTxLevelL;
+    rgbAdr[1] = regBase + regDsTxLevelH;
+    rgbAdr[2] = regBase + regDsRxLevelL;
+    rgbAdr[3] = regBase + regDsRxLevelH;
+
+    if ( ! DeppGetRegSet(hif, rgbAdr, rgbLvl, 4, fFalse) ) {
+        return fFalse;
+    }
+
+    *pcbTx = ((DWORD)rgbLvl[1] << 8) | rgbLvl[0];
+    *pcbRx = ((DWORD)rgbLvl[3] << 8) | rgbLvl[2];
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FTransfer
+**
+**  Parameters:
+**      rgbSnd  - bytes to send
+**      rgbRcv  - receives the bytes received, may be NULL
+**      cb      - number of bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a DEPP call fails or a frame isn't sent in time.
+**
+**  Description:
+**      Send bytes and receive the bytes shifted in at the same time. Up
+**      to cbDsFifo bytes are sent as one frame with the slave selected
+**      throughout. Longer transfers are sent as several frames. When
+**      rgbRcv is NULL the master discards the bytes received.
+*/
+BOOL
+DeppSpi::FTransfer( const BYTE * rgbSnd, BYTE * rgbRcv, DWORD cb ) {
+
+    DWORD   cbSend;
+
+    while ( 0 < cb ) {
+
+        cbSend = ( cbDsFifo < cb ) ? cbDsFifo : cb;
+
+        if ( ! FStartFrame(rgbSnd, cbSend, NULL != rgbRcv) ) {
+            return fFalse;
+        }
+
+        if ( ! FEndFrame(rgbRcv) ) {
+            return fFalse;
+        }
+
+        rgbSnd += cbSend;
+        if ( NULL != rgbRcv ) {
+            rgbRcv += cbSend;
+        }
+        cb -= cbSend;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FStartFrame
+**
+**  Parameters:
+**      rgbSnd  - bytes to send
+**      cb      - number of bytes, 1 to cbDsFifo
+**      fRcv    - fTrue to keep the bytes received
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write one frame to the TX FIFO and start sending it. The frame
+**      must be finished with FEndFrame before another one is started.
+*/
+BOOL
+DeppSpi::FStartFrame( const BYTE * rgbSnd, DWORD cb, BOOL fRcv ) {
+
+    BYTE    rgbSet[4];
+    BYTE    bCfgFrame;
+
+    if (( 0 == cb ) || ( cbDsFifo < cb )) {
+        return fFalse;
+    }
+
+    bCfgFrame = fRcv ? bCfg : (bCfg | bDsRxOff);
+
+    /* Hold the master and empty both FIFOs, so that the frame isn't
+    ** started before it has been written and no stale bytes are read.
+    */
+    rgbSet[0] = regBase + regDsCfg;
+    rgbSet[1] = bCfgFrame | bDsHold;
+    rgbSet[2] = regBase + regDsStat;
+    rgbSet[3] = 0;
+
+    if ( ! DeppPutRegSet(hif, rgbSet, 2, fFalse) ) {
+        return fFalse;
+    }
+
+    if ( ! DeppPutRegRepeat(hif, regBase + regDsData, (BYTE *)rgbSnd, cb, fFalse) ) {
+        return fFalse;
+    }
+
+    if ( ! DeppPutReg(hif, regBase + regDsCfg, bCfgFrame, fFalse) ) {
+        return fFalse;
+    }
+
+    cbFrame = cb;
+    fRcvFrame = fRcv;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FEndFrame
+**
+**  Parameters:
+**      rgbRcv  - receives the bytes received, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no frame was started or the frame isn't sent in time.
+**
+**  Description:
+**      Wait for the frame started by FStartFrame to be sent and read the
+**      bytes received. When the frame was started without keeping the
+**      bytes received, rgbRcv is ignored.
+*/
+BOOL
+DeppSpi::FEndFrame( BYTE * rgbRcv ) {
+
+    DWORD   cb;
+
+    if ( 0 == cbFrame ) {
+        return fFalse;
+    }
+
+    cb = cbFrame;
+    cbFrame = 0;
+
+    if ( ! FWaitIdle() ) {
+        return fFalse;
+    }
+
+    if (( ! fRcvFrame ) || ( NULL == rgbRcv )) {
+        return fTrue;
+    }
+
+    return DeppGetRegRepeat(hif, regBase + regDsData, rgbRcv, cb, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeppSpi::FWaitIdle
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the master is still busy after cpollDsMax reads.
+**
+**  Description:
+**      Wait for the master to send everything in the TX FIFO.
+*/
+BOOL
+DeppSpi::FWaitIdle() {
+
+    BYTE    bStat;
+
+    for ( cpollLast = 1; cpollLast <= cpollDsMax; cpollLast++ ) {
+
+        if ( ! DeppGetReg(hif, regBase + regDsStat, &bStat, fFalse) ) {
+            return fFalse;
+        }
+
+        if ( 0 == ( bStat & bDsBusy )) {
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    RegDsSlave
+**
+**  Parameters:
+**      islave  - slave number
+**
+**  Return Values:
+**      address of the first register of the slave
+**
+**  Errors:
+**
+**  Description:
+**      Get the register base to pass to DeppSpi::Init for a slave of the
+**      spi_top design.
+*/
+BYTE
+RegDsSlave( int islave ) {
+
+    return (BYTE)(regDsBaseDefault + islave * cregDsSlave);
+}
+
+/* ------------------------------------------------------------ */
+/***    FrqDsSpeed
+**
+**  Parameters:
+**      ispeed  - speed setting
+**
+**  Return Values:
+**      SCLK frequency in Hz, or 0 for an invalid setting
+**
+**  Errors:
+**
+**  Description:
+**      Get the SCLK frequency of a speed setting.
+*/
+DWORD
+FrqDsSpeed( int ispeed ) {
+
+    if (( 0 > ispeed ) || ( ispeedDsMax < ispeed )) {
+        return 0;
+    }
+
+    return frqDsSystem / (2 * rgclkDsDiv[ispeed]);
+}
+
+/* ------------------------------------------------------------ */
+/***    FrqDsDivider
+**
+**  Parameters:
+**      clkDiv  - clock divider
+**
+**  Return Values:
+**      SCLK frequency in Hz, or 0 for an invalid divider
+**
+**  Errors:
+**
+**  Description:
+**      Get the SCLK frequency of a clock divider.
+*/
+DWORD
+FrqDsDivider( DWORD clkDiv ) {
+
+    if (( clkDsDivMin > clkDiv ) || ( clkDsDivMax < clkDiv )) {
+        return 0;
+    }
+
+    return frqDsSystem / (2 * clkDiv);
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
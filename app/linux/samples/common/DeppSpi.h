@@ -0,0 +1,135 @@
+/************************************************************************/
+/*                                                                      */
+/*    DeppSpi.h  --    Interface Declarations for DeppSpi.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the host */
+/*    side of the FIFO-fed SPI master in fpga/spi_top.vhd. The SPI      */
+/*    registers are reached through DEPP. A frame is written to the TX  */
+/*    FIFO with one DeppPutRegRepeat call while the master is held, is  */
+/*    sent without gaps once the hold is released, and the bytes        */
+/*    received are read back from the RX FIFO with one DeppGetRegRepeat */
+/*    call.                                                             */
+/*                                                                      */
+/*    Each slave has its own block of registers, SPI master and bus, so */
+/*    a DeppSpi object is bound to one slave and frames to different    */
+/*    slaves may be in flight at the same time.                         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the slave register blocks, the clock divider and  */
+/*              split frames                                            */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(DEPPSPI_INCLUDED)
+#define      DEPPSPI_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Register offsets from the base address of the registers of a slave.
+** The block of slave n starts cregDsSlave * n registers after the block
+** of slave 0.
+*/
+const BYTE  regDsBaseDefault    = 0x20;
+const BYTE  cregDsSlave         = 16;
+const int   cdsSlaveDefault     = 4;
+const BYTE  regDsCfg            = 0;
+const BYTE  regDsStat           = 1;
+const BYTE  regDsData           = 2;
+const BYTE  regDsTxLevelL       = 3;
+const BYTE  regDsTxLevelH       = 4;
+const BYTE  regDsRxLevelL       = 5;
+const BYTE  regDsRxLevelH       = 6;
+const BYTE  regDsDivL           = 7;
+const BYTE  regDsDivH           = 8;
+
+/* Configuration register bits.
+*/
+const BYTE  bDsCpol             = 0x01;
+const BYTE  bDsCpha             = 0x02;
+const BYTE  bDsEnable           = 0x04;
+const BYTE  bDsSpeedMask        = 0x38;
+const BYTE  bDsHold             = 0x40;
+const BYTE  bDsRxOff            = 0x80;
+
+const int   shfDsSpeed          = 3;
+const int   ispeedDsMax         = 7;
+
+/* Range of the clock divider, in system clock cycles per half period of
+** SCLK. A divider of 0 selects the speed setting of the configuration
+** register.
+*/
+const DWORD clkDsDivMin         = 1;
+const DWORD clkDsDivMax         = 0xFFFF;
+
+/* Status register bits.
+*/
+const BYTE  bDsBusy             = 0x01;
+const BYTE  bDsTxFull           = 0x02;
+const BYTE  bDsTxEmpty          = 0x04;
+const BYTE  bDsRxFull           = 0x08;
+const BYTE  bDsRxEmpty          = 0x10;
+const BYTE  bDsRxOvf            = 0x20;
+
+/* Size of each FIFO, and so the largest frame that is sent with the
+** slave selected throughout.
+*/
+const DWORD cbDsFifo            = 512;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class DeppSpi {
+
+private:
+    HIF     hif;
+    BYTE    regBase;
+    BYTE    bCfg;
+    DWORD   cpollLast;
+    DWORD   cbFrame;
+    BOOL    fRcvFrame;
+
+    BOOL    FWaitIdle();
+
+    DeppSpi(const DeppSpi &);
+    DeppSpi & operator=(const DeppSpi &);
+
+public:
+    DeppSpi();
+
+    void    Init(HIF hifReq, BYTE regBaseReq);
+
+    BOOL    FConfigure(int idMode, int ispeed);
+    BOOL    FSetDivider(DWORD clkDiv);
+    BOOL    FSetFrequency(DWORD frqReq, DWORD * pfrqSet);
+    BOOL    FFlush();
+    BOOL    FGetStatus(BYTE * pbStat);
+    BOOL    FGetLevels(DWORD * pcbTx, DWORD * pcbRx);
+    BOOL    FTransfer(const BYTE * rgbSnd, BYTE * rgbRcv, DWORD cb);
+    BOOL    FStartFrame(const BYTE * rgbSnd, DWORD cb, BOOL fRcv);
+    BOOL    FEndFrame(BYTE * rgbRcv);
+
+    DWORD   CpollLast() const { return cpollLast; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BYTE    RegDsSlave(int islave);
+DWORD   FrqDsSpeed(int ispeed);
+DWORD   FrqDsDivider(DWORD clkDiv);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // DEPPSPI_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,1713 @@
+/************************************************************************/
+/*                                                                      */
+/*  DspiSim.cpp  --  Stand-in for the DSPI and DMGR libraries           */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the functions of dspi.h, and the functions   */
+/*  of dmgr.h used by the DSPI programs, on top of the SPI slave models */
+/*  derived from SpiDev. Each handle opened with DmgrOpen owns a model  */
+/*  and the state a DSPI port keeps: select, mode, clock divider and    */
+/*  delays. Every byte sent is exchanged with the model, one byte at a  */
+/*  time, and the model's clock is advanced by the time the byte takes  */
+/*  on the bus, the delays and the overhead of each call.               */
+/*                                                                      */
+/*  Overlapped calls are carried out at once. Their results are queued  */
+/*  and returned by DmgrGetTransResult, which in real time mode waits   */
+/*  until the model's clock says the call would have completed. Real    */
+/*  time spent by the program between calls, such as sleeps, is added   */
+/*  to the model's clock in real time mode, so that a flash model sees  */
+/*  the same busy times that the real part would.                       */
+/*                                                                      */
+/*  The library keeps its handles in a fixed table and isn't thread     */
+/*  safe; a handle must only be used by one thread at a time and only   */
+/*  one thread may open or close handles.                               */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dspi.h"
+#include "DspiSim.h"
+#include "SpiDev.h"
+#include "SpiFlashSim.h"
+#include "SpiEepromSim.h"
+#include "SpiAdcSim.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Most overlapped calls whose results haven't been collected.
+*/
+const DWORD ctransDssMax = 64;
+
+/* Range of the clock divider.
+*/
+const DWORD clkDssDivMin = 1;
+const DWORD clkDssDivMax = 0xFFFF;
+
+/* Properties of the simulated port.
+*/
+const DPRP dprpDssPort = dprpSpiSetSpeed | dprpSpiShiftLeft | dprpSpiShiftRight |
+                         dprpSpiDelay | dprpSpiMode0 | dprpSpiMode1 | dprpSpiMode2 |
+                         dprpSpiMode3 | dprpSpiStartEndDelay;
+
+/* Result of an overlapped call.
+*/
+typedef struct {
+    DWORD   cbOut;
+    DWORD   cbIn;
+    UINT64  tnsDone;
+} DSSTRANS;
+
+/* State of an open handle.
+*/
+typedef struct {
+    BOOL        fOpen;
+    char        szName[cchDvcNameMax];
+    char        szModel[cchDvcNameMax];
+    SpiDev *    pdev;
+    BOOL        fOwned;
+
+    BOOL        fEnabled;
+    BOOL        fSel;
+    DWORD       idMod;
+    BOOL        fShRight;
+    DWORD       clkDiv;
+    DWORD       tusDelay;
+    DWORD       tusStart;
+    DWORD       tusEnd;
+
+    DWORD       tusCall;
+    BOOL        fRealTime;
+    BOOL        fStats;
+    UINT64      tnsDev0;
+    UINT64      tnsWall0;
+
+    DSSTRANS    rgtrans[ctransDssMax];
+    DWORD       itransFirst;
+    DWORD       ctrans;
+
+    DSSSTATS    dsss;
+} DSSHIF;
+
+/* A model that can be named in DmgrOpen.
+*/
+typedef struct {
+    char            szModel[cchDvcNameMax];
+    PFNDSSCREATE    pfnCreate;
+} DSSMDL;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static SpiDev * PdevCreateLoop(const char * szArg);
+static SpiDev * PdevCreateFlash(const char * szArg);
+static SpiDev * PdevCreateEeprom(const char * szArg);
+static SpiDev * PdevCreateAdc(const char * szArg);
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+static DSSHIF   rghifDss[chifDssMax];
+
+static DSSMDL   rgmdlDss[cmdlDssMax] = {
+    {"loop",    PdevCreateLoop},
+    {"flash",   PdevCreateFlash},
+    {"eeprom",  PdevCreateEeprom},
+    {"adc",     PdevCreateAdc}
+};
+
+static DWORD    cmdlDss = 4;
+
+static ERC      ercDssLast = ercNoErc;
+
+/* ------------------------------------------------------------ */
+/*                  Local Procedures                            */
+/* ------------------------------------------------------------ */
+/***    FDssFail
+**
+**  Parameters:
+**      erc         - error code
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record the error returned by DmgrGetLastError.
+*/
+static BOOL
+FDssFail( ERC erc ) {
+
+    ercDssLast = erc;
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    PhifDss
+**
+**  Parameters:
+**      hif         - handle
+**      fEnabled    - fTrue if DSPI must be enabled
+**
+**  Return Values:
+**      state of the handle, or NULL
+**
+**  Errors:
+**      Sets ercInvalidHif for a handle that isn't open, and
+**      ercCapabilityNotEnabled if DSPI must be enabled but isn't.
+**
+**  Description:
+**      Look up an open handle.
+*/
+static DSSHIF *
+PhifDss( HIF hif, BOOL fEnabled ) {
+
+    DSSHIF *    phif;
+
+    if (( hifInvalid == hif ) || ( chifDssMax < hif ) || ( ! rghifDss[hif - 1].fOpen )) {
+
+        FDssFail(ercInvalidHif);
+        return NULL;
+    }
+
+    phif = &rghifDss[hif - 1];
+
+    if ( fEnabled && ( ! phif->fEnabled )) {
+
+        FDssFail(ercCapabilityNotEnabled);
+        return NULL;
+    }
+
+    return phif;
+}
+
+/* ------------------------------------------------------------ */
+/***    DssReset
+**
+**  Parameters:
+**      phif        - handle
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Start the model's clock and the real time clock of the handle
+**      from the current time, and clear the statistics.
+*/
+static void
+DssReset( DSSHIF * phif ) {
+
+    phif->tnsDev0 = phif->pdev->TnsNow();
+    phif->tnsWall0 = TnsNow();
+    phif->itransFirst = 0;
+    phif->ctrans = 0;
+    memset(&phif->dsss, 0, sizeof(phif->dsss));
+}
+
+/* ------------------------------------------------------------ */
+/***    DssBeginCall
+**
+**  Parameters:
+**      phif        - handle
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Account for the start of a call that talks to the port. In real
+**      time mode the model's clock is first moved up to the real time
+**      that has passed, since the bus was idle in the meantime.
+*/
+static void
+DssBeginCall( DSSHIF * phif ) {
+
+    UINT64  tnsWall;
+    UINT64  tnsDev;
+
+    if ( phif->fRealTime ) {
+
+        tnsWall = TnsNow() - phif->tnsWall0;
+        tnsDev = phif->pdev->TnsNow() - phif->tnsDev0;
+
+        if ( tnsDev < tnsWall ) {
+            phif->pdev->Wait((DWORD)((tnsWall - tnsDev) / 1000));
+        }
+    }
+
+    phif->pdev->Wait(phif->tusCall);
+    phif->dsss.tnsCall += (UINT64)phif->tusCall * 1000;
+}
+
+/* ------------------------------------------------------------ */
+/***    DssPace
+**
+**  Parameters:
+**      phif        - handle
+**      tnsDone     - time on the model's clock that a call completed
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      In real time mode, sleep until the call would have completed.
+*/
+static void
+DssPace( DSSHIF * phif, UINT64 tnsDone ) {
+
+    UINT64          tnsTarget;
+    UINT64          tnsWall;
+    struct timespec ts;
+
+    if ( ! phif->fRealTime ) {
+        return;
+    }
+
+    tnsTarget = phif->tnsWall0 + (tnsDone - phif->tnsDev0);
+    tnsWall = TnsNow();
+
+    if ( tnsWall < tnsTarget ) {
+
+        ts.tv_sec = (time_t)((tnsTarget - tnsWall) / 1000000000ULL);
+        ts.tv_nsec = (long)((tnsTarget - tnsWall) % 1000000000ULL);
+        nanosleep(&ts, NULL);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FDssEndCall
+**
+**  Parameters:
+**      phif        - handle
+**      cbOut       - bytes sent by the call
+**      cbIn        - bytes returned by the call
+**      fOverlap    - fTrue for an overlapped call
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails with ercTransferPending if too many overlapped results are
+**      waiting to be collected.
+**
+**  Description:
+**      Complete a call. The result of an overlapped call is queued for
+**      DmgrGetTransResult, other calls wait for the transfer in real
+**      time mode.
+*/
+static BOOL
+FDssEndCall( DSSHIF * phif, DWORD cbOut, DWORD cbIn, BOOL fOverlap ) {
+
+    DSSTRANS *  ptrans;
+
+    phif->dsss.tnsTotal = phif->pdev->TnsNow() - phif->tnsDev0;
+
+    if ( ! fOverlap ) {
+
+        DssPace(phif, phif->pdev->TnsNow());
+        return fTrue;
+    }
+
+    if ( ctransDssMax == phif->ctrans ) {
+        return FDssFail(ercTransferPending);
+    }
+
+    ptrans = &phif->rgtrans[(phif->itransFirst + phif->ctrans) % ctransDssMax];
+    ptrans->cbOut = cbOut;
+    ptrans->cbIn = cbIn;
+    ptrans->tnsDone = phif->pdev->TnsNow();
+    phif->ctrans++;
+    phif->dsss.ccallOverlap++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DssSetSelect
+**
+**  Parameters:
+**      phif        - handle
+**      fSel        - new state of the select line
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Drive the select line of the model.
+*/
+static void
+DssSetSelect( DSSHIF * phif, BOOL fSel ) {
+
+    if ( fSel == phif->fSel ) {
+        return;
+    }
+
+    phif->fSel = fSel;
+    phif->pdev->Select(fSel);
+    phif->dsss.csel++;
+}
+
+/* ------------------------------------------------------------ */
+/***    DssDelay
+**
+**  Parameters:
+**      phif        - handle
+**      tus         - delay in microseconds
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Let a delay of the port pass on the model's clock.
+*/
+static void
+DssDelay( DSSHIF * phif, DWORD tus ) {
+
+    if ( 0 != tus ) {
+
+        phif->pdev->Wait(tus);
+        phif->dsss.tnsDelay += (UINT64)tus * 1000;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    BDssReverse
+**
+**  Parameters:
+**      b           - byte
+**
+**  Return Values:
+**      the byte with its bit order reversed
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the bits of a byte, for ports that shift LSB first.
+*/
+static BYTE
+BDssReverse( BYTE b ) {
+
+    b = (BYTE)(((b & 0xF0) >> 4) | ((b & 0x0F) << 4));
+    b = (BYTE)(((b & 0xCC) >> 2) | ((b & 0x33) << 2));
+    b = (BYTE)(((b & 0xAA) >> 1) | ((b & 0x55) << 1));
+
+    return b;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDssTransfer
+**
+**  Parameters:
+**      hif         - handle
+**      fSelStart   - fTrue to select the slave first
+**      fSelEnd     - fTrue to deselect the slave afterwards
+**      rgbSnd      - bytes to send, or NULL to send bFill
+**      bFill       - byte sent when rgbSnd is NULL
+**      rgbRcv      - receives the bytes received, may be NULL
+**      cb          - number of bytes
+**      fOverlap    - fTrue for an overlapped call
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Carry out DspiPut, DspiGet and DspiPutByte.
+*/
+static BOOL
+FDssTransfer( HIF hif, BOOL fSelStart, BOOL fSelEnd, const BYTE * rgbSnd, BYTE bFill,
+              BYTE * rgbRcv, DWORD cb, BOOL fOverlap ) {
+
+    DSSHIF *    phif;
+    DWORD       ib;
+    BYTE        bSnd;
+    BYTE        bRcv;
+    UINT64      tnsStart;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    DssBeginCall(phif);
+
+    if ( fSelStart ) {
+
+        DssSetSelect(phif, fTrue);
+        DssDelay(phif, phif->tusStart);
+    }
+
+    for ( ib = 0; ib < cb; ib++ ) {
+
+        if ( 0 != ib ) {
+            DssDelay(phif, phif->tusDelay);
+        }
+
+        bSnd = ( NULL != rgbSnd ) ? rgbSnd[ib] : bFill;
+
+        tnsStart = phif->pdev->TnsNow();
+
+        if ( phif->fShRight ) {
+            bRcv = BDssReverse(phif->pdev->BExchange(BDssReverse(bSnd)));
+        }
+        else {
+            bRcv = phif->pdev->BExchange(bSnd);
+        }
+
+        phif->dsss.tnsBus += phif->pdev->TnsNow() - tnsStart;
+
+        if ( NULL != rgbRcv ) {
+            rgbRcv[ib] = bRcv;
+        }
+    }
+
+    if ( fSelEnd ) {
+
+        DssDelay(phif, phif->tusEnd);
+        DssSetSelect(phif, fFalse);
+    }
+
+    phif->dsss.ccall++;
+    phif->dsss.cbOut += cb;
+    phif->dsss.cbIn += ( NULL != rgbRcv ) ? cb : 0;
+
+    return FDssEndCall(phif, cb, ( NULL != rgbRcv ) ? cb : 0, fOverlap);
+}
+
+/* ------------------------------------------------------------ */
+/***    PdevCreateLoop
+**
+**  Parameters:
+**      szArg       - arguments, must be empty
+**
+**  Return Values:
+**      new model, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Create a loopback, as if MOSI were connected to MISO.
+*/
+static SpiDev *
+PdevCreateLoop( const char * szArg ) {
+
+    if ( '\0' != szArg[0] ) {
+        return NULL;
+    }
+
+    return new SpiLoopback();
+}
+
+/* ------------------------------------------------------------ */
+/***    PdevCreateFlash
+**
+**  Parameters:
+**      szArg       - JEDEC ID as six hexadecimal digits, or empty for
+**                    the default part
+**
+**  Return Values:
+**      new model, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Create a serial NOR flash, e.g. "flash:EF4018".
+*/
+static SpiDev *
+PdevCreateFlash( const char * szArg ) {
+
+    SpiFlashSim *   pfls;
+    DWORD           idJedec;
+    char *          pchEnd;
+
+    idJedec = ((DWORD)idSfsMfgDefault << 16) | ((DWORD)idSfsTypeDefault << 8) | idSfsCapDefault;
+
+    if ( '\0' != szArg[0] ) {
+
+        idJedec = strtoul(szArg, &pchEnd, 16);
+        if (( 6 != strlen(szArg) ) || ( '\0' != *pchEnd )) {
+            return NULL;
+        }
+    }
+
+    pfls = new SpiFlashSim();
+
+    if ( ! pfls->FInit((BYTE)(idJedec >> 16), (BYTE)(idJedec >> 8), (BYTE)idJedec) ) {
+
+        delete pfls;
+        return NULL;
+    }
+
+    return pfls;
+}
+
+/* ------------------------------------------------------------ */
+/***    PdevCreateEeprom
+**
+**  Parameters:
+**      szArg       - "size[,page]" in bytes, or empty for the default
+**                    part
+**
+**  Return Values:
+**      new model, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Create a 25xx series serial EEPROM, e.g. "eeprom:65536,128".
+*/
+static SpiDev *
+PdevCreateEeprom( const char * szArg ) {
+
+    SpiEepromSim *  pees;
+    DWORD           cbMem;
+    DWORD           cbPage;
+    char *          pchEnd;
+
+    cbMem = cbSesDefault;
+    cbPage = cbSesPageDefault;
+
+    if ( '\0' != szArg[0] ) {
+
+        cbMem = strtoul(szArg, &pchEnd, 0);
+        if ( ',' == *pchEnd ) {
+            cbPage = strtoul(pchEnd + 1, &pchEnd, 0);
+        }
+        if ( '\0' != *pchEnd ) {
+            return NULL;
+        }
+    }
+
+    pees = new SpiEepromSim();
+
+    if ( ! pees->FInit(cbMem, cbPage) ) {
+
+        delete pees;
+        return NULL;
+    }
+
+    return pees;
+}
+
+/* ------------------------------------------------------------ */
+/***    PdevCreateAdc
+**
+**  Parameters:
+**      szArg       - "wave[,frq[,ampl[,offs[,noise[,bits]]]]]", or
+**                    empty for a 1 kHz sine
+**
+**  Return Values:
+**      new model, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Create a serial ADC, e.g. "adc:triangle,50,1000,2048,4". The
+**      wave is one of dc, sine, square, triangle and sawtooth. The
+**      amplitude, offset and noise are in codes and default to 90% of
+**      full scale, mid scale and no noise. bits defaults to 12.
+*/
+static SpiDev *
+PdevCreateAdc( const char * szArg ) {
+
+    static const char * rgszWave[] = {"dc", "sine", "square", "triangle", "sawtooth"};
+
+    SpiAdcSim * pads;
+    char        szWave[16];
+    double      rgdbl[5];
+    int         cdbl;
+    int         wf;
+    int         cbit;
+    size_t      cch;
+    char *      pchEnd;
+    const char * pch;
+
+    cch = strcspn(szArg, ",");
+    if ( sizeof(szWave) <= cch ) {
+        return NULL;
+    }
+
+    memcpy(szWave, szArg, cch);
+    szWave[cch] = '\0';
+
+    wf = wfAdcSine;
+    if ( 0 != cch ) {
+
+        for ( wf = wfAdcDc; wf <= wfAdcSawtooth; wf++ ) {
+            if ( 0 == strcasecmp(szWave, rgszWave[wf]) ) {
+                break;
+            }
+        }
+
+        if ( wfAdcSawtooth < wf ) {
+            return NULL;
+        }
+    }
+
+    /* Parse the numbers that follow the wave.
+    */
+    cdbl = 0;
+    pch = szArg + cch;
+    while (( ',' == *pch ) && ( cdbl < 5 )) {
+
+        rgdbl[cdbl++] = strtod(pch + 1, &pchEnd);
+        if ( pchEnd == pch + 1 ) {
+            return NULL;
+        }
+        pch = pchEnd;
+    }
+
+    if ( '\0' != *pch ) {
+        return NULL;
+    }
+
+    cbit = ( 4 < cdbl ) ? (int)rgdbl[4] : cbitAdcDefault;
+
+    pads = new SpiAdcSim();
+
+    if (( ! pads->FSetResolution(cbit) ) ||
+        ( ! pads->FSetWaveform(wf,
+                               ( 0 < cdbl ) ? rgdbl[0] : 1000.0,
+                               ( 1 < cdbl ) ? rgdbl[1] : 0.45 * (double)(1 << cbit),
+                               ( 2 < cdbl ) ? rgdbl[2] : 0.5 * (double)(1 << cbit)) )) {
+
+        delete pads;
+        return NULL;
+    }
+
+    pads->SetNoise(( 3 < cdbl ) ? rgdbl[3] : 0.0);
+
+    return pads;
+}
+
+/* ------------------------------------------------------------ */
+/*                  DMGR Procedures                             */
+/* ------------------------------------------------------------ */
+/***    DmgrOpen
+**
+**  Parameters:
+**      phif        - receives the handle
+**      szSel       - "model[:arguments]"
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails with ercDeviceNotConnected if the model isn't known or the
+**      arguments aren't valid.
+**
+**  Description:
+**      Open a handle to a new instance of a model.
+*/
+DPCAPI BOOL
+DmgrOpen( HIF * phif, char * szSel ) {
+
+    DSSHIF *    phifNew;
+    char        szModel[cchDvcNameMax];
+    const char * szArg;
+    size_t      cch;
+    DWORD       ihif;
+    DWORD       imdl;
+    SpiDev *    pdev;
+    const char * szEnv;
+
+    cch = strcspn(szSel, ":");
+    if ( cchDvcNameMax <= strlen(szSel) ) {
+        return FDssFail(ercDeviceNotConnected);
+    }
+
+    memcpy(szModel, szSel, cch);
+    szModel[cch] = '\0';
+    szArg = ( ':' == szSel[cch] ) ? &szSel[cch + 1] : "";
+
+    for ( ihif = 0; ihif < chifDssMax; ihif++ ) {
+        if ( ! rghifDss[ihif].fOpen ) {
+            break;
+        }
+    }
+
+    if ( chifDssMax == ihif ) {
+        return FDssFail(ercTooManyOpenedDevices);
+    }
+
+    pdev = NULL;
+    for ( imdl = 0; imdl < cmdlDss; imdl++ ) {
+
+        if ( 0 == strcasecmp(szModel, rgmdlDss[imdl].szModel) ) {
+
+            pdev = rgmdlDss[imdl].pfnCreate(szArg);
+            break;
+        }
+    }
+
+    if ( NULL == pdev ) {
+        return FDssFail(ercDeviceNotConnected);
+    }
+
+    phifNew = &rghifDss[ihif];
+    memset(phifNew, 0, sizeof(DSSHIF));
+
+    strcpy(phifNew->szName, szSel);
+    strcpy(phifNew->szModel, rgmdlDss[imdl].szModel);
+    phifNew->pdev = pdev;
+    phifNew->fOwned = fTrue;
+    phifNew->clkDiv = (frqDssBase + 2 * frqDssDefault - 1) / (2 * frqDssDefault);
+    phifNew->pdev->SetSpeed(frqDssBase / (2 * phifNew->clkDiv));
+
+    szEnv = getenv(szDssEnvTusCall);
+    phifNew->tusCall = ( NULL != szEnv ) ? strtoul(szEnv, NULL, 0) : 0;
+
+    szEnv = getenv(szDssEnvRealTime);
+    phifNew->fRealTime = ( NULL != szEnv ) && ( 0 != atoi(szEnv) );
+
+    szEnv = getenv(szDssEnvStats);
+    phifNew->fStats = ( NULL != szEnv ) && ( 0 != atoi(szEnv) );
+
+    DssReset(phifNew);
+    phifNew->fOpen = fTrue;
+
+    *phif = ihif + 1;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrClose
+**
+**  Parameters:
+**      hif         - handle
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Close a handle, writing its statistics to stderr if asked to,
+**      and delete the model if the handle owns it.
+*/
+DPCAPI BOOL
+DmgrClose( HIF hif ) {
+
+    DSSHIF *    phif;
+    DSSSTATS *  pdsss;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    if ( phif->fStats ) {
+
+        pdsss = &phif->dsss;
+        fprintf(stderr, "DspiSim %s: %u calls, %u overlapped, %u select changes\n",
+                phif->szName, pdsss->ccall, pdsss->ccallOverlap, pdsss->csel);
+        fprintf(stderr, "DspiSim %s: %llu bytes out, %llu bytes in\n", phif->szName,
+                (unsigned long long)pdsss->cbOut, (unsigned long long)pdsss->cbIn);
+        fprintf(stderr, "DspiSim %s: %.3f ms total, %.3f ms bus, %.3f ms delays, %.3f ms calls\n",
+                phif->szName, pdsss->tnsTotal / 1000000.0, pdsss->tnsBus / 1000000.0,
+                pdsss->tnsDelay / 1000000.0, pdsss->tnsCall / 1000000.0);
+    }
+
+    if ( phif->fOwned ) {
+        delete phif->pdev;
+    }
+
+    phif->pdev = NULL;
+    phif->fOpen = fFalse;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrGetLastError
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      code of the last error
+**
+**  Errors:
+**
+**  Description:
+**      Return the error recorded by the last call that failed.
+*/
+DPCAPI ERC
+DmgrGetLastError() {
+
+    return ercDssLast;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrGetTransResult
+**
+**  Parameters:
+**      hif         - handle
+**      pdwDataOut  - receives the number of bytes sent
+**      pdwDataIn   - receives the number of bytes received
+**      tmsWait     - ignored, results are always ready
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails with ercTransferCancelled if no call is outstanding.
+**
+**  Description:
+**      Collect the result of the oldest overlapped call, waiting in
+**      real time mode until it would have completed.
+*/
+DPCAPI BOOL
+DmgrGetTransResult( HIF hif, DWORD * pdwDataOut, DWORD * pdwDataIn, DWORD tmsWait ) {
+
+    DSSHIF *    phif;
+    DSSTRANS *  ptrans;
+
+    (void)tmsWait;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    if ( 0 == phif->ctrans ) {
+        return FDssFail(ercTransferCancelled);
+    }
+
+    ptrans = &phif->rgtrans[phif->itransFirst];
+    phif->itransFirst = (phif->itransFirst + 1) % ctransDssMax;
+    phif->ctrans--;
+
+    DssPace(phif, ptrans->tnsDone);
+
+    if ( NULL != pdwDataOut ) {
+        *pdwDataOut = ptrans->cbOut;
+    }
+
+    if ( NULL != pdwDataIn ) {
+        *pdwDataIn = ptrans->cbIn;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrCancelTrans
+**
+**  Parameters:
+**      hif         - handle
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Discard the results of the overlapped calls not yet collected.
+*/
+DPCAPI BOOL
+DmgrCancelTrans( HIF hif ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    phif->itransFirst = 0;
+    phif->ctrans = 0;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrGetDvcFromHif
+**
+**  Parameters:
+**      hif         - handle
+**      pdvc        - receives the device description
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Describe the device a handle was opened on. The connection
+**      string is "SIM:" followed by the name given to DmgrOpen.
+*/
+DPCAPI BOOL
+DmgrGetDvcFromHif( HIF hif, DVC * pdvc ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    memset(pdvc, 0, sizeof(DVC));
+    strcpy(pdvc->szName, phif->szName);
+    snprintf(pdvc->szConn, sizeof(pdvc->szConn), "SIM:%s", phif->szName);
+    pdvc->dtp = dtpNone;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DmgrGetInfo
+**
+**  Parameters:
+**      pdvc        - device description from DmgrGetDvcFromHif
+**      dinfo       - item to get
+**      pvInfoGet   - receives the item
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails with ercNotSupported for items other than the names and
+**      the serial number.
+**
+**  Description:
+**      Get information about a simulated device. The serial number is
+**      "SIM-" followed by the model name, so that settings stored by
+**      serial number are kept apart from those of real devices.
+*/
+DPCAPI BOOL
+DmgrGetInfo( DVC * pdvc, DINFO dinfo, void * pvInfoGet ) {
+
+    char *  sz;
+    size_t  cch;
+
+    sz = (char *)pvInfoGet;
+
+    switch ( dinfo ) {
+
+        case dinfoAlias:
+        case dinfoUsrName:
+            strncpy(sz, pdvc->szName, cchUsrNameMax);
+            sz[cchUsrNameMax] = '\0';
+            return fTrue;
+
+        case dinfoProdName:
+            strcpy(sz, "DspiSim");
+            return fTrue;
+
+        case dinfoSN:
+            cch = strcspn(pdvc->szName, ":");
+            if ( cchSnMax - 4 < cch ) {
+                cch = cchSnMax - 4;
+            }
+            strcpy(sz, "SIM-");
+            memcpy(sz + 4, pdvc->szName, cch);
+            sz[4 + cch] = '\0';
+            return fTrue;
+    }
+
+    return FDssFail(ercNotSupported);
+}
+
+/* ------------------------------------------------------------ */
+/*                  DSPI Procedures                             */
+/* ------------------------------------------------------------ */
+/***    DspiGetVersion
+**
+**  Parameters:
+**      szVersion   - receives the version string
+**
+**  Return Values:
+**      fTrue
+**
+**  Errors:
+**
+**  Description:
+**      Return the version of the stand-in library.
+*/
+DPCAPI BOOL
+DspiGetVersion( char * szVersion ) {
+
+    strcpy(szVersion, "DspiSim 1.0");
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGetPortCount
+**
+**  Parameters:
+**      hif         - handle
+**      pcprt       - receives the number of ports
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Every simulated device has one DSPI port.
+*/
+DPCAPI BOOL
+DspiGetPortCount( HIF hif, INT32 * pcprt ) {
+
+    if ( NULL == PhifDss(hif, fFalse) ) {
+        return fFalse;
+    }
+
+    *pcprt = 1;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGetPortProperties
+**
+**  Parameters:
+**      hif         - handle
+**      prtReq      - port, must be 0
+**      pdprp       - receives the port properties
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      The simulated port supports every property.
+*/
+DPCAPI BOOL
+DspiGetPortProperties( HIF hif, INT32 prtReq, DWORD * pdprp ) {
+
+    if ( NULL == PhifDss(hif, fFalse) ) {
+        return fFalse;
+    }
+
+    if ( 0 != prtReq ) {
+        return FDssFail(ercInvalidPort);
+    }
+
+    *pdprp = dprpDssPort;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiEnable
+**
+**  Parameters:
+**      hif         - handle
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Enable the default port.
+*/
+DPCAPI BOOL
+DspiEnable( HIF hif ) {
+
+    return DspiEnableEx(hif, 0);
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiEnableEx
+**
+**  Parameters:
+**      hif         - handle
+**      prtReq      - port, must be 0
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Enable the port and start the statistics and the clocks from
+**      the current time.
+*/
+DPCAPI BOOL
+DspiEnableEx( HIF hif, INT32 prtReq ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    if ( 0 != prtReq ) {
+        return FDssFail(ercInvalidPort);
+    }
+
+    phif->fEnabled = fTrue;
+    DssReset(phif);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiDisable
+**
+**  Parameters:
+**      hif         - handle
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Deselect the slave and disable the port.
+*/
+DPCAPI BOOL
+DspiDisable( HIF hif ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    DssSetSelect(phif, fFalse);
+    phif->fEnabled = fFalse;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSetSelect
+**
+**  Parameters:
+**      hif         - handle
+**      fSel        - fTrue to select the slave
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Drive the select line.
+*/
+DPCAPI BOOL
+DspiSetSelect( HIF hif, BOOL fSel ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    DssBeginCall(phif);
+    DssSetSelect(phif, fSel);
+
+    return FDssEndCall(phif, 0, 0, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSetSpiMode
+**
+**  Parameters:
+**      hif         - handle
+**      idMod       - SPI mode, 0 to 3
+**      fShRight    - fTrue to shift LSB first
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the SPI mode and shift direction. The models work in any
+**      mode, the direction changes the order of the bits they see.
+*/
+DPCAPI BOOL
+DspiSetSpiMode( HIF hif, DWORD idMod, BOOL fShRight ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    if ( 3 < idMod ) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    phif->idMod = idMod;
+    phif->fShRight = fShRight;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGetSpeed
+**
+**  Parameters:
+**      hif         - handle
+**      pfrqCur     - receives the SPI clock frequency in Hz
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the SPI clock frequency.
+*/
+DPCAPI BOOL
+DspiGetSpeed( HIF hif, DWORD * pfrqCur ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    *pfrqCur = frqDssBase / (2 * phif->clkDiv);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSetSpeed
+**
+**  Parameters:
+**      hif         - handle
+**      frqReq      - requested SPI clock frequency in Hz
+**      pfrqSet     - receives the frequency set
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the divider for the fastest frequency that isn't above the
+**      one requested, or the slowest frequency if all are above it.
+*/
+DPCAPI BOOL
+DspiSetSpeed( HIF hif, DWORD frqReq, DWORD * pfrqSet ) {
+
+    DSSHIF *    phif;
+    DWORD       clkDiv;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    if ( 0 == frqReq ) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    clkDiv = (DWORD)(((UINT64)frqDssBase + 2ULL * frqReq - 1) / (2ULL * frqReq));
+
+    if ( clkDssDivMin > clkDiv ) {
+        clkDiv = clkDssDivMin;
+    }
+
+    if ( clkDssDivMax < clkDiv ) {
+        clkDiv = clkDssDivMax;
+    }
+
+    phif->clkDiv = clkDiv;
+    phif->pdev->SetSpeed(frqDssBase / (2 * clkDiv));
+
+    if ( NULL != pfrqSet ) {
+        *pfrqSet = frqDssBase / (2 * clkDiv);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSetDelay
+**
+**  Parameters:
+**      hif         - handle
+**      tusDelay    - delay between bytes in microseconds
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the inter-byte delay.
+*/
+DPCAPI BOOL
+DspiSetDelay( HIF hif, DWORD tusDelay ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    phif->tusDelay = tusDelay;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGetDelay
+**
+**  Parameters:
+**      hif         - handle
+**      ptusDelay   - receives the inter-byte delay
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the inter-byte delay.
+*/
+DPCAPI BOOL
+DspiGetDelay( HIF hif, DWORD * ptusDelay ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    *ptusDelay = phif->tusDelay;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSetStartEndDelay
+**
+**  Parameters:
+**      hif         - handle
+**      tusStart    - delay from select to the first byte
+**      tusEnd      - delay from the last byte to deselect
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the start and end delays.
+*/
+DPCAPI BOOL
+DspiSetStartEndDelay( HIF hif, DWORD tusStart, DWORD tusEnd ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    phif->tusStart = tusStart;
+    phif->tusEnd = tusEnd;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGetStartEndDelay
+**
+**  Parameters:
+**      hif         - handle
+**      ptusStart   - receives the start delay
+**      ptusEnd     - receives the end delay
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the start and end delays.
+*/
+DPCAPI BOOL
+DspiGetStartEndDelay( HIF hif, DWORD * ptusStart, DWORD * ptusEnd ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fTrue)) ) {
+        return fFalse;
+    }
+
+    *ptusStart = phif->tusStart;
+    *ptusEnd = phif->tusEnd;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiPutByte
+**
+**  Parameters:
+**      hif         - handle
+**      fSelStart   - fTrue to select the slave first
+**      fSelEnd     - fTrue to deselect the slave afterwards
+**      bSnd        - byte to send
+**      pbRcv       - receives the byte received, may be NULL
+**      fOverlap    - fTrue for an overlapped call
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Exchange one byte with the model.
+*/
+DPCAPI BOOL
+DspiPutByte( HIF hif, BOOL fSelStart, BOOL fSelEnd, BYTE bSnd, BYTE * pbRcv, BOOL fOverlap ) {
+
+    return FDssTransfer(hif, fSelStart, fSelEnd, &bSnd, 0, pbRcv, 1, fOverlap);
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiPut
+**
+**  Parameters:
+**      hif         - handle
+**      fSelStart   - fTrue to select the slave first
+**      fSelEnd     - fTrue to deselect the slave afterwards
+**      rgbSnd      - bytes to send
+**      rgbRcv      - receives the bytes received, may be NULL
+**      cbSnd       - number of bytes
+**      fOverlap    - fTrue for an overlapped call
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Send bytes to the model and receive the bytes it returns.
+*/
+DPCAPI BOOL
+DspiPut( HIF hif, BOOL fSelStart, BOOL fSelEnd, BYTE * rgbSnd, BYTE * rgbRcv, DWORD cbSnd, BOOL fOverlap ) {
+
+    if ( NULL == rgbSnd ) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    return FDssTransfer(hif, fSelStart, fSelEnd, rgbSnd, 0, rgbRcv, cbSnd, fOverlap);
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiGet
+**
+**  Parameters:
+**      hif         - handle
+**      fSelStart   - fTrue to select the slave first
+**      fSelEnd     - fTrue to deselect the slave afterwards
+**      bFill       - byte sent for each byte received
+**      rgbRcv      - receives the bytes received
+**      cbRcv       - number of bytes
+**      fOverlap    - fTrue for an overlapped call
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Receive bytes from the model, sending a fill byte.
+*/
+DPCAPI BOOL
+DspiGet( HIF hif, BOOL fSelStart, BOOL fSelEnd, BYTE bFill, BYTE * rgbRcv, DWORD cbRcv, BOOL fOverlap ) {
+
+    if ( NULL == rgbRcv ) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    return FDssTransfer(hif, fSelStart, fSelEnd, NULL, bFill, rgbRcv, cbRcv, fOverlap);
+}
+
+/* ------------------------------------------------------------ */
+/*                  Extension Procedures                        */
+/* ------------------------------------------------------------ */
+/***    DspiSimRegister
+**
+**  Parameters:
+**      szModel     - name used in DmgrOpen
+**      pfnCreate   - creates an instance of the model
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the name is too long or the table of models is full.
+**
+**  Description:
+**      Add a model, or replace the model registered under a name.
+*/
+DPCAPI BOOL
+DspiSimRegister( const char * szModel, PFNDSSCREATE pfnCreate ) {
+
+    DWORD   imdl;
+
+    if (( NULL == pfnCreate ) || ( '\0' == szModel[0] ) ||
+        ( cchDvcNameMax <= strlen(szModel) ) || ( NULL != strchr(szModel, ':') )) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    for ( imdl = 0; imdl < cmdlDss; imdl++ ) {
+        if ( 0 == strcasecmp(szModel, rgmdlDss[imdl].szModel) ) {
+            break;
+        }
+    }
+
+    if ( cmdlDssMax == imdl ) {
+        return FDssFail(ercInsufficientResources);
+    }
+
+    strcpy(rgmdlDss[imdl].szModel, szModel);
+    rgmdlDss[imdl].pfnCreate = pfnCreate;
+
+    if ( cmdlDss == imdl ) {
+        cmdlDss++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSimAttach
+**
+**  Parameters:
+**      hif         - handle
+**      pdev        - model to use from now on, owned by the caller
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Replace the model of an open handle. The model the handle was
+**      opened with is deleted. The caller keeps ownership of pdev and
+**      must not delete it before the handle is closed. The statistics
+**      and the clocks are started again from the current time.
+*/
+DPCAPI BOOL
+DspiSimAttach( HIF hif, SpiDev * pdev ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    if ( NULL == pdev ) {
+        return FDssFail(ercInvalidParameter);
+    }
+
+    DssSetSelect(phif, fFalse);
+
+    if ( phif->fOwned ) {
+        delete phif->pdev;
+    }
+
+    phif->pdev = pdev;
+    phif->fOwned = fFalse;
+    phif->fSel = fFalse;
+    phif->pdev->SetSpeed(frqDssBase / (2 * phif->clkDiv));
+
+    DssReset(phif);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSimGetDevice
+**
+**  Parameters:
+**      hif         - handle
+**
+**  Return Values:
+**      model of the handle, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Get the model of a handle, e.g. to inspect the memory of a flash
+**      model after a program has written to it.
+*/
+DPCAPI SpiDev *
+DspiSimGetDevice( HIF hif ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return NULL;
+    }
+
+    return phif->pdev;
+}
+
+/* ------------------------------------------------------------ */
+/***    DspiSimGetStats
+**
+**  Parameters:
+**      hif         - handle
+**      pdsss       - receives the statistics
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the counts and times of the work done since DspiEnable.
+*/
+DPCAPI BOOL
+DspiSimGetStats( HIF hif, DSSSTATS * pdsss ) {
+
+    DSSHIF *    phif;
+
+    if ( NULL == (phif = PhifDss(hif, fFalse)) ) {
+        return fFalse;
+    }
+
+    *pdsss = phif->dsss;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,103 @@
+/************************************************************************/
+/*                                                                      */
+/*    DspiSim.h  --    Interface Declarations for DspiSim.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a        */
+/*    stand-in for the DSPI and DMGR libraries. DspiSim.cpp implements  */
+/*    every function of dspi.h and the functions of dmgr.h that the     */
+/*    DSPI programs use, and routes the bytes sent to a software model  */
+/*    of a SPI slave (see SpiDev.h) instead of a device. Programs run   */
+/*    unchanged against it, either linked with it in place of -ldspi    */
+/*    and -ldmgr or with it loaded through LD_PRELOAD.                  */
+/*                                                                      */
+/*    The device name given to DmgrOpen selects the model, as           */
+/*    "model[:arguments]". The models built in are "loop", "flash",     */
+/*    "eeprom" and "adc". Others may be added with DspiSimRegister, or  */
+/*    a model may be attached to an open handle with DspiSimAttach.     */
+/*                                                                      */
+/*    Each call advances the model's clock by the time the transfer     */
+/*    would take on the bus at the speed and delays set, plus a fixed   */
+/*    overhead per call. The time is reported by DspiSimGetStats and,   */
+/*    if asked for, the library sleeps so that the calls take that long */
+/*    in real time as well.                                             */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(DSPISIM_INCLUDED)
+#define      DSPISIM_INCLUDED
+
+class SpiDev;
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Environment variables read when a handle is opened. DSPISIM_TUSCALL
+** gives the overhead of each call in microseconds, the default is 0.
+** When DSPISIM_REALTIME is set to a value other than 0, calls take as
+** long in real time as they do on the model's clock. When DSPISIM_STATS
+** is set to a value other than 0, the statistics of each handle are
+** written to stderr when it is closed.
+*/
+#define szDssEnvTusCall     "DSPISIM_TUSCALL"
+#define szDssEnvRealTime    "DSPISIM_REALTIME"
+#define szDssEnvStats       "DSPISIM_STATS"
+
+/* The SPI clock is derived from a 60 MHz base clock with a 16 bit
+** divider, as on a typical port: 30 MHz down to about 458 Hz.
+*/
+const DWORD frqDssBase      = 60000000;
+const DWORD frqDssDefault   = 1000000;
+
+/* Most handles open and models registered at once.
+*/
+const DWORD chifDssMax      = 16;
+const DWORD cmdlDssMax      = 16;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Create a model from the arguments that followed the model name in the
+** device name, an empty string if there were none. Return NULL if the
+** arguments aren't valid. The model is deleted when the handle is
+** closed.
+*/
+typedef SpiDev * (* PFNDSSCREATE)(const char * szArg);
+
+/* Counts and times of the work done through a handle.
+*/
+typedef struct {
+    DWORD   ccall;          // DspiPut, DspiGet and DspiPutByte calls
+    DWORD   ccallOverlap;   // of those, overlapped calls
+    DWORD   csel;           // select and deselect changes
+    UINT64  cbOut;          // bytes sent
+    UINT64  cbIn;           // bytes received and returned to the caller
+    UINT64  tnsBus;         // time spent shifting bytes
+    UINT64  tnsDelay;       // time spent in inter-byte, start and end delays
+    UINT64  tnsCall;        // time spent in call overhead
+    UINT64  tnsTotal;       // time on the model's clock since DspiEnable
+} DSSSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+DPCAPI  BOOL    DspiSimRegister(const char * szModel, PFNDSSCREATE pfnCreate);
+DPCAPI  BOOL    DspiSimAttach(HIF hif, SpiDev * pdev);
+DPCAPI  SpiDev* DspiSimGetDevice(HIF hif);
+DPCAPI  BOOL    DspiSimGetStats(HIF hif, DSSSTATS * pdsss);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // DSPISIM_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,149 @@
+/************************************************************************/
+/*                                                                      */
+/*  DstmPkt.cpp  --  DSTM upload packet commit policy                   */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module writes the upload packet commit policy to the EPP       */
+/*  registers of the StreamIO reference design. StmCtrl samples the     */
+/*  registers while stream mode is disabled, so the policy must be set  */
+/*  before DstmEnable is called. The EPP port is enabled just long      */
+/*  enough to write the registers.                                      */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "depp.h"
+#include "DstmPkt.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    FDstmSetPktPolicy
+**
+**  Parameters:
+**      hif         - open handle to the device
+**      pktmode     - packet commit mode (pktmodeFull, pktmodeImmediate,
+**                    pktmodeCount or pktmodeIdle)
+**      cbCommit    - number of bytes after which a packet is committed,
+**                    used with pktmodeCount (1 - cbPktCommitMax)
+**      cclkIdle    - number of idle IFCLK cycles after which a packet is
+**                    committed, used with pktmodeIdle (1 - cclkPktIdleMax)
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a parameter is out of range or the EPP port can't be
+**      used. DmgrGetLastError returns the error from the Adept Runtime
+**      in the latter case.
+**
+**  Description:
+**      Set the upload packet commit policy of the StreamIO design. DSTM
+**      must not be enabled when this function is called.
+*/
+BOOL
+FDstmSetPktPolicy( HIF hif, BYTE pktmode, DWORD cbCommit, DWORD cclkIdle ) {
+
+    BYTE    rgbAddrData[10];
+    BOOL    fSuccess;
+
+    if ( pktmodeIdle < pktmode ) {
+        return fFalse;
+    }
+
+    if (( pktmodeCount == pktmode ) &&
+        (( 0 == cbCommit ) || ( cbPktCommitMax < cbCommit ))) {
+        return fFalse;
+    }
+
+    if (( pktmodeIdle == pktmode ) &&
+        (( 0 == cclkIdle ) || ( cclkPktIdleMax < cclkIdle ))) {
+        return fFalse;
+    }
+
+    /* Parameters of the other modes are ignored by the FPGA. Write
+    ** them as zero so that a read back shows which mode is active.
+    */
+    if ( pktmodeCount != pktmode ) {
+        cbCommit = 0;
+    }
+
+    if ( pktmodeIdle != pktmode ) {
+        cclkIdle = 0;
+    }
+
+    rgbAddrData[0] = regPktMode;
+    rgbAddrData[1] = pktmode;
+    rgbAddrData[2] = regPktCntLo;
+    rgbAddrData[3] = (BYTE)(cbCommit & 0xFF);
+    rgbAddrData[4] = regPktCntHi;
+    rgbAddrData[5] = (BYTE)((cbCommit >> 8) & 0x01);
+    rgbAddrData[6] = regPktIdleLo;
+    rgbAddrData[7] = (BYTE)(cclkIdle & 0xFF);
+    rgbAddrData[8] = regPktIdleHi;
+    rgbAddrData[9] = (BYTE)((cclkIdle >> 8) & 0xFF);
+
+    if ( ! DeppEnable(hif) ) {
+        return fFalse;
+    }
+
+    fSuccess = DeppPutRegSet(hif, rgbAddrData, sizeof(rgbAddrData) / 2, fFalse);
+
+    DeppDisable(hif);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    CclkFromUs
+**
+**  Parameters:
+**      us      - time in microseconds
+**
+**  Return Values:
+**      number of IFCLK cycles, limited to cclkPktIdleMax
+**
+**  Errors:
+**
+**  Description:
+**      Convert an idle time to the cclkIdle parameter of
+**      FDstmSetPktPolicy.
+*/
+DWORD
+CclkFromUs( DWORD us ) {
+
+    UINT64  cclk;
+
+    cclk = ((UINT64)us * freqDstmIfclk) / 1000000;
+
+    if ( 0 == cclk ) {
+        cclk = 1;
+    }
+
+    if ( cclkPktIdleMax < cclk ) {
+        cclk = cclkPktIdleMax;
+    }
+
+    return (DWORD)cclk;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,86 @@
+/************************************************************************/
+/*                                                                      */
+/*    DstmPkt.h  --    Interface Declarations for DstmPkt.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for setting  */
+/*    the upload packet commit policy of the StreamIO reference design. */
+/*    The policy determines when StmCtrl asserts PKTEND to send a       */
+/*    partially filled USB packet to the host:                          */
+/*                                                                      */
+/*      pktmodeFull      - never, only full packets are sent. This      */
+/*                         gives the best throughput for bulk capture.  */
+/*      pktmodeImmediate - as soon as the FPGA stops supplying data.    */
+/*                         This gives the lowest latency for short      */
+/*                         request/response transfers.                  */
+/*      pktmodeCount     - after a given number of bytes.               */
+/*      pktmodeIdle      - after a given number of IFCLK cycles without */
+/*                         upload data.                                 */
+/*                                                                      */
+/*    The policy is held in EPP registers of the StreamIO design and    */
+/*    can only be changed while DSTM is disabled.                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(DSTMPKT_INCLUDED)
+#define      DSTMPKT_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Packet commit modes.
+*/
+const BYTE  pktmodeFull         = 0;
+const BYTE  pktmodeImmediate    = 1;
+const BYTE  pktmodeCount        = 2;
+const BYTE  pktmodeIdle         = 3;
+
+/* EPP register addresses of the policy in the StreamIO design.
+*/
+const BYTE  regPktMode          = 0;
+const BYTE  regPktCntLo         = 1;
+const BYTE  regPktCntHi         = 2;
+const BYTE  regPktIdleLo        = 3;
+const BYTE  regPktIdleHi        = 4;
+
+/* Limits of the policy parameters. Counts must be less than the 512
+** byte high speed packet size, larger counts are the same as full
+** packets.
+*/
+const DWORD cbPktCommitMax      = 511;
+const DWORD cclkPktIdleMax      = 65535;
+
+/* Frequency of IFCLK, used to convert idle times to clock cycles.
+*/
+const DWORD freqDstmIfclk       = 48000000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BOOL    FDstmSetPktPolicy(HIF hif, BYTE pktmode, DWORD cbCommit, DWORD cclkIdle);
+DWORD   CclkFromUs(DWORD us);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // DSTMPKT_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,916 @@
+/************************************************************************/
+/*                                                                      */
+/*  Jtg7Cfg.cpp  --  IEEE 1149.7 scan format setup and scan format file */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module configures an IEEE 1149.7-2009 TAP.7 controller and the */
+/*  DJTG port in front of it for a scan format, RDY bit count and DLY   */
+/*  bit count. The target is first returned to its reset configuration  */
+/*  with a reset escape, so that any setup can be tried after any       */
+/*  other, and then written in control level 2 with two part commands.  */
+/*  Every command is followed by a check packet, and a failure of any   */
+/*  DJTG call is reported as a failure of the setup.                    */
+/*                                                                      */
+/*  The TMS moves come from a JtgTap model and are sent with JtgBatch,  */
+/*  as in DjtgTwoWireDemo. The file functions keep one setup for each   */
+/*  device serial number, as "serial format rdy dly bps" lines.         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgBatch.h"
+#include "Jtg7Cfg.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Operator and operands of the two part commands used. STMC operands
+** are bbbxy, where bbb selects the control and xy is its value.
+*/
+const BYTE      cmdT7Stmc       = 0;
+const BYTE      cmdT7Stfmt      = 3;
+const BYTE      opT7Ecl         = 0x01;
+const BYTE      opT7Cgm         = 0x07;
+const BYTE      opT7RdyCtl      = 0x08;
+const BYTE      opT7DlyCtl      = 0x0C;
+const BYTE      opT7None        = 0xFF;
+
+/* Number of zero bit scans that select control level 2.
+*/
+const BYTE      czbsT7Cl2       = 2;
+
+/* Longest line of a scan format file.
+*/
+const DWORD     cchT7LineMax    = 96;
+
+/* Scan formats of the advanced protocol that the DJTG port can use,
+** with the port property that says it does and the STFMT operand from
+** Table 23-2 of the IEEE 1149.7-2009 specification.
+*/
+typedef struct {
+    BYTE            jtgsf;
+    DPRP            dprp;
+    BYTE            op;
+    const char *    sz;
+} T7FMT;
+
+const T7FMT     rgt7f[] = {
+    { jtgsfMScan,   dprpJtgMScan,   16, "MScan"  },
+    { jtgsfOScan0,  dprpJtgOScan0,   8, "OScan0" },
+    { jtgsfOScan1,  dprpJtgOScan1,   9, "OScan1" },
+    { jtgsfOScan2,  dprpJtgOScan2,  10, "OScan2" },
+    { jtgsfOScan3,  dprpJtgOScan3,  11, "OScan3" },
+    { jtgsfOScan4,  dprpJtgOScan4,  12, "OScan4" },
+    { jtgsfOScan5,  dprpJtgOScan5,  13, "OScan5" },
+    { jtgsfOScan6,  dprpJtgOScan6,  14, "OScan6" },
+    { jtgsfOScan7,  dprpJtgOScan7,  15, "OScan7" },
+    { jtgsfNone,    0,               0, NULL     }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static const T7FMT *    Pt7fFind(BYTE jtgsf);
+static BOOL             FParseLine(const char * sz, char * szSn, T7CFG * pcfg);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::Jtg7Cfg
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a configurator that isn't attached to a port.
+*/
+Jtg7Cfg::Jtg7Cfg() {
+
+    hif = hifInvalid;
+    dprp = 0;
+    fAdvanced = fFalse;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FInit
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      The port must support DjtgEscape and DjtgCheckPacket.
+**
+**  Description:
+**      Attach the configurator to JTAG port 0 of a device.
+*/
+BOOL
+Jtg7Cfg::FInit( HIF hifReq ) {
+
+    szError[0] = '\0';
+    hif = hifReq;
+    fAdvanced = fFalse;
+
+    if ( ! DjtgGetPortProperties(hif, 0, &dprp) ) {
+        return FFail("DjtgGetPortProperties failed, erc = %d", DmgrGetLastError());
+    }
+
+    if (( 0 == (dprpJtgEscape & dprp) ) || ( 0 == (dprpJtgCheckPacket & dprp) )) {
+        return FFail("port doesn't support DjtgEscape and DjtgCheckPacket");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FReset
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Return the target to its reset configuration with a reset escape
+**      and the port to JScan0 with one RDY bit and no delay. The TAP
+**      controller is left in Test-Logic-Reset.
+*/
+BOOL
+Jtg7Cfg::FReset() {
+
+    DWORD   cretOutSet;
+    DWORD   cbitDlySet;
+
+    szError[0] = '\0';
+    jb.Reset();
+    tap.Clear();
+    fAdvanced = fFalse;
+
+    if ( ! DjtgEscape(hif, cedgeJtgReset, fFalse) ) {
+        return FFail("DjtgEscape failed to perform a reset escape, erc = %d", DmgrGetLastError());
+    }
+
+    if ( ! DjtgSetScanFormat(hif, jtgsfJScan0, fFalse) ) {
+        return FFail("DjtgSetScanFormat(JScan0) failed, erc = %d", DmgrGetLastError());
+    }
+
+    if (( FReadyCnt() ) && ( ! DjtgSetReadyCnt(hif, cbitT7RdyMin, NULL, &cretOutSet) )) {
+        return FFail("DjtgSetReadyCnt(%u) failed, erc = %d", cbitT7RdyMin, DmgrGetLastError());
+    }
+
+    if (( FDelayCnt() ) && ( ! DjtgSetDelayCnt(hif, 0, &cbitDlySet, fFalse) )) {
+        return FFail("DjtgSetDelayCnt(0) failed, erc = %d", DmgrGetLastError());
+    }
+
+    /* The reset escape leaves the TAP controller in Test-Logic-Reset,
+    ** and so does this TMS move for a target that ignored it.
+    */
+    tap.FReset();
+    if (( ! FPutMoves() ) || ( ! jb.FExecute(hif) )) {
+
+        jb.Reset();
+        return FFail("DjtgBatch for the TAP reset failed, erc = %d", DmgrGetLastError());
+    }
+
+    jb.Reset();
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FConfigure
+**
+**  Parameters:
+**      pcfg        - setup to use, bps is ignored
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      The scan format, RDY count or DLY count isn't supported by the
+**      port, or a command or check packet failed.
+**
+**  Description:
+**      Reset the target and the port and configure both for a setup:
+**      control level 2 is entered by locking a ZBS count of 2, the CGM
+**      bit is set, the RDY and DLY counts and then the scan format are
+**      stored, and control level 2 is left with the ECL bit. The port
+**      follows each setting as soon as the target has it. The TAP
+**      controller is left in Run-Test/Idle.
+*/
+BOOL
+Jtg7Cfg::FConfigure( const T7CFG * pcfg ) {
+
+    const T7FMT *   pt7f;
+    DWORD           cretOutSet;
+    DWORD           cbitDlySet;
+    BYTE            izbs;
+
+    szError[0] = '\0';
+
+    pt7f = Pt7fFind(pcfg->jtgsf);
+    if (( NULL == pt7f ) || ( 0 == (pt7f->dprp & dprp) )) {
+        return FFail("scan format %u isn't supported by the port", pcfg->jtgsf);
+    }
+
+    if (( cbitT7RdyMin > pcfg->cbitRdy ) || ( cbitT7RdyMax < pcfg->cbitRdy ) ||
+        (( cbitT7RdyMin != pcfg->cbitRdy ) && ( ! FReadyCnt() ))) {
+        return FFail("RDY bit count %u isn't supported by the port", pcfg->cbitRdy);
+    }
+
+    if (( cbitT7DlyMax < pcfg->cbitDly ) || (( 0 != pcfg->cbitDly ) && ( ! FDelayCnt() ))) {
+        return FFail("DLY bit count %u isn't supported by the port", pcfg->cbitDly);
+    }
+
+    if ( ! FReset() ) {
+        return fFalse;
+    }
+
+    /* Enter control level 2 with the moves RTI->(CDR->UDR) x 2->RTI,
+    ** and lock the count by passing through Shift-DR.
+    */
+    tap.FMoveTo(tpsRTI);
+    for ( izbs = 0; izbs < czbsT7Cl2; izbs++ ) {
+        tap.FMoveTo(tpsCapDR);
+        tap.FMoveTo(tpsUpdDR);
+    }
+    tap.FMoveTo(tpsRTI);
+    tap.FMoveTo(tpsShDR);
+    tap.FMoveTo(tpsRTI);
+
+    if ( ! FSendCmd(cmdT7Stmc, opT7Cgm) ) {
+        return fFalse;
+    }
+
+    if ( cbitT7RdyMin != pcfg->cbitRdy ) {
+
+        if ( ! FSendCmd(cmdT7Stmc, opT7RdyCtl | (BYTE)(pcfg->cbitRdy - 1)) ) {
+            return fFalse;
+        }
+
+        if ( ! DjtgSetReadyCnt(hif, pcfg->cbitRdy, NULL, &cretOutSet) ) {
+            return FFail("DjtgSetReadyCnt(%u) failed, erc = %d", pcfg->cbitRdy, DmgrGetLastError());
+        }
+    }
+
+    if ( 0 != pcfg->cbitDly ) {
+
+        if ( ! FSendCmd(cmdT7Stmc, opT7DlyCtl | (BYTE)pcfg->cbitDly) ) {
+            return fFalse;
+        }
+
+        if (( ! DjtgSetDelayCnt(hif, pcfg->cbitDly, &cbitDlySet, fFalse) ) ||
+            ( pcfg->cbitDly != cbitDlySet )) {
+            return FFail("DjtgSetDelayCnt(%u) failed, erc = %d", pcfg->cbitDly, DmgrGetLastError());
+        }
+    }
+
+    if ( ! FSendCmd(cmdT7Stfmt, pt7f->op) ) {
+        return fFalse;
+    }
+
+    if ( ! DjtgSetScanFormat(hif, pt7f->jtgsf, fFalse) ) {
+        return FFail("DjtgSetScanFormat(%s) failed, erc = %d", pt7f->sz, DmgrGetLastError());
+    }
+
+    /* From here on every command needs a dummy scan packet before its
+    ** check packet.
+    */
+    fAdvanced = fTrue;
+
+    return FSendCmd(cmdT7Stmc, opT7Ecl);
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FReadIdcodes
+**
+**  Parameters:
+**      rgid        - receives the IDCODEs, cidT7Max entries
+**      pcid        - receives the number of IDCODEs read
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the IDCODEs of the chain with one DR scan from Run-Test/
+**      Idle or Test-Logic-Reset. Zeros are shifted in, and the list ends
+**      at the first IDCODE of all zeros or all ones. The TAP controller
+**      is left in Run-Test/Idle.
+*/
+BOOL
+Jtg7Cfg::FReadIdcodes( DWORD * rgid, DWORD * pcid ) {
+
+    BYTE    rgbTdo[4 * cidT7Max];
+    DWORD   id;
+
+    *pcid = 0;
+
+    if ( ! FScanDr(NULL, 32 * cidT7Max, rgbTdo) ) {
+        return fFalse;
+    }
+
+    while ( cidT7Max > *pcid ) {
+
+        id = (rgbTdo[4 * *pcid + 3] << 24) | (rgbTdo[4 * *pcid + 2] << 16) |
+             (rgbTdo[4 * *pcid + 1] << 8) | rgbTdo[4 * *pcid];
+
+        if (( 0 == id ) || ( 0xFFFFFFFF == id )) {
+            break;
+        }
+
+        rgid[(*pcid)++] = id;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FScanDr
+**
+**  Parameters:
+**      rgbTdi      - TDI bits, NULL for zeros
+**      cbit        - length of the scan
+**      rgbTdo      - receives the TDO bits, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Make a DR scan that ends in Run-Test/Idle with one DjtgBatch
+**      transaction. A move from Test-Logic-Reset to Run-Test/Idle is
+**      sent before it when needed.
+*/
+BOOL
+Jtg7Cfg::FScanDr( const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo ) {
+
+    szError[0] = '\0';
+
+    tap.FMoveTo(tpsRTI);
+
+    if (( ! FPutMoves() ) || ( ! jb.FScanDr(rgbTdi, cbit, rgbTdo) ) || ( ! jb.FExecute(hif) )) {
+
+        jb.Reset();
+        return FFail("DjtgBatch for the DR scan failed, erc = %d", DmgrGetLastError());
+    }
+
+    jb.Reset();
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FFormatSupported
+**
+**  Parameters:
+**      jtgsf       - scan format
+**
+**  Return Values:
+**      fTrue if the port can use the scan format, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check that a scan format is one of the advanced protocol and is
+**      supported by the port.
+*/
+BOOL
+Jtg7Cfg::FFormatSupported( BYTE jtgsf ) const {
+
+    const T7FMT *   pt7f;
+
+    pt7f = Pt7fFind(jtgsf);
+
+    return (( NULL != pt7f ) && ( 0 != (pt7f->dprp & dprp) ));
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FPutMoves
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add the TMS moves pending in the TAP model to the batch as a
+**      single TMS sequence and clear them from the model.
+*/
+BOOL
+Jtg7Cfg::FPutMoves() {
+
+    BOOL    fOk;
+
+    if ( 0 == tap.CbitSeq() ) {
+        return fTrue;
+    }
+
+    fOk = jb.FPutTms(tap.RgbSeq(), tap.CbitSeq(), fFalse, NULL);
+    tap.Clear();
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FCmdPart
+**
+**  Parameters:
+**      csdr        - number of times (0-31) to pass through Shift-DR
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add the TMS moves of one part of a two part command to the TAP
+**      model, from Run-Test/Idle back to Run-Test/Idle.
+*/
+BOOL
+Jtg7Cfg::FCmdPart( BYTE csdr ) {
+
+    if ( 0 == csdr ) {
+        return tap.FMoveTo(tpsUpdDR) && tap.FMoveTo(tpsRTI);
+    }
+
+    return tap.FMoveTo(tpsShDR) && tap.FHold(csdr - 1) && tap.FMoveTo(tpsRTI);
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FSendCmd
+**
+**  Parameters:
+**      cmd         - command part 1 (operator)
+**      op          - command part 2 (operand)
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Send a two part command with the TMS moves pending before it in
+**      one DjtgBatch transaction, followed by its check packet. With
+**      the advanced protocol a one bit dummy scan packet without delay
+**      elements precedes the check packet, as in Figure 21-9 and
+**      Section 24.3.2 of the IEEE 1149.7-2009 specification.
+*/
+BOOL
+Jtg7Cfg::FSendCmd( BYTE cmd, BYTE op ) {
+
+    BYTE    bTms;
+    DWORD   cbitDly;
+    DWORD   cbitDlySet;
+
+    if (( ! FCmdPart(cmd) ) || ( ! FCmdPart(op) ) ||
+        ( ! FPutMoves() ) || ( ! jb.FExecute(hif) )) {
+
+        jb.Reset();
+        return FFail("DjtgBatch for command %u, %u failed, erc = %d", cmd, op, DmgrGetLastError());
+    }
+
+    jb.Reset();
+
+    if ( fAdvanced ) {
+
+        cbitDly = 0;
+        if (( FDelayCnt() ) && ( ! DjtgGetDelayCnt(hif, &cbitDly, NULL) )) {
+            return FFail("DjtgGetDelayCnt failed, erc = %d", DmgrGetLastError());
+        }
+
+        if (( 0 != cbitDly ) && ( ! DjtgSetDelayCnt(hif, 0, &cbitDlySet, fFalse) )) {
+            return FFail("DjtgSetDelayCnt(0) failed, erc = %d", DmgrGetLastError());
+        }
+
+        bTms = 0x00;
+        if ( ! DjtgPutTmsBits(hif, fFalse, &bTms, NULL, 1, fFalse) ) {
+            return FFail("DjtgPutTmsBits failed to put the dummy packet, erc = %d", DmgrGetLastError());
+        }
+
+        if (( 0 != cbitDly ) && ( ! DjtgSetDelayCnt(hif, cbitDly, &cbitDlySet, fFalse) )) {
+            return FFail("DjtgSetDelayCnt(%u) failed, erc = %d", cbitDly, DmgrGetLastError());
+        }
+    }
+
+    if ( ! DjtgCheckPacket(hif, 0, fFalse, fFalse) ) {
+        return FFail("check packet after command %u, %u failed, erc = %d", cmd, op, DmgrGetLastError());
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Jtg7Cfg::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message. The first message is kept.
+*/
+BOOL
+Jtg7Cfg::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    va_start(ap, szFmt);
+    vsnprintf(szError, sizeof(szError), szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    OpT7Format
+**
+**  Parameters:
+**      jtgsf       - scan format
+**
+**  Return Values:
+**      STFMT operand of the scan format, 0xFF if it isn't one of the
+**      advanced protocol
+**
+**  Errors:
+**
+**  Description:
+**      Get the operand of the STFMT command that selects a scan format.
+*/
+BYTE
+OpT7Format( BYTE jtgsf ) {
+
+    const T7FMT *   pt7f;
+
+    pt7f = Pt7fFind(jtgsf);
+
+    return ( NULL != pt7f ) ? pt7f->op : opT7None;
+}
+
+/* ------------------------------------------------------------ */
+/***    SzT7Format
+**
+**  Parameters:
+**      jtgsf       - scan format
+**
+**  Return Values:
+**      name of the scan format, "?" if it isn't one of the advanced
+**      protocol
+**
+**  Errors:
+**
+**  Description:
+**      Get the name of a scan format.
+*/
+const char *
+SzT7Format( BYTE jtgsf ) {
+
+    const T7FMT *   pt7f;
+
+    pt7f = Pt7fFind(jtgsf);
+
+    return ( NULL != pt7f ) ? pt7f->sz : "?";
+}
+
+/* ------------------------------------------------------------ */
+/***    FT7ParseFormat
+**
+**  Parameters:
+**      sz          - name of a scan format
+**      pjtgsf      - receives the scan format
+**
+**  Return Values:
+**      fTrue if the name is one of the advanced protocol, fFalse
+**      otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Look up a scan format by the name used by SzT7Format.
+*/
+BOOL
+FT7ParseFormat( const char * sz, BYTE * pjtgsf ) {
+
+    const T7FMT *   pt7f;
+
+    for ( pt7f = rgt7f; NULL != pt7f->sz; pt7f++ ) {
+
+        if ( 0 == strcmp(sz, pt7f->sz) ) {
+
+            *pjtgsf = pt7f->jtgsf;
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    FT7GetSerial
+**
+**  Parameters:
+**      hif     - open device
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the serial number that setups are stored under.
+*/
+BOOL
+FT7GetSerial( HIF hif, char * szSn ) {
+
+    DVC     dvc;
+    char    szTmp[cchDvcNameMax + 1];
+
+    if ( ! DmgrGetDvcFromHif(hif, &dvc) ) {
+        return fFalse;
+    }
+
+    if ( ! DmgrGetInfo(&dvc, dinfoSN, szTmp) ) {
+        return fFalse;
+    }
+
+    szTmp[cchSnMax] = '\0';
+    strcpy(szSn, szTmp);
+
+    return ( '\0' != szSn[0] );
+}
+
+/* ------------------------------------------------------------ */
+/***    FT7Path
+**
+**  Parameters:
+**      szPath  - receives the path of the scan format file
+**      cchMax  - size of szPath
+**
+**  Return Values:
+**      fTrue for success, fFalse if the path doesn't fit
+**
+**  Errors:
+**
+**  Description:
+**      Get the path of the default scan format file, in the home
+**      directory if there is one and the current directory otherwise.
+*/
+BOOL
+FT7Path( char * szPath, DWORD cchMax ) {
+
+    const char *    szHome;
+    int             cch;
+
+    szHome = getenv("HOME");
+
+    if (( NULL == szHome ) || ( '\0' == szHome[0] )) {
+        cch = snprintf(szPath, cchMax, "%s", szT7FileDefault);
+    }
+    else {
+        cch = snprintf(szPath, cchMax, "%s/%s", szHome, szT7FileDefault);
+    }
+
+    return (( 0 <= cch ) && ( (DWORD)cch < cchMax ));
+}
+
+/* ------------------------------------------------------------ */
+/***    FT7Load
+**
+**  Parameters:
+**      szPath  - scan format file
+**      szSn    - serial number of the device
+**      pcfg    - receives the stored setup
+**
+**  Return Values:
+**      fTrue if a setup was found, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Look up the setup stored for a device.
+*/
+BOOL
+FT7Load( const char * szPath, const char * szSn, T7CFG * pcfg ) {
+
+    FILE *  pfile;
+    char    szLine[cchT7LineMax];
+    char    szSnLine[cchSnMax + 1];
+    BOOL    fFound;
+
+    pfile = fopen(szPath, "r");
+    if ( NULL == pfile ) {
+        return fFalse;
+    }
+
+    fFound = fFalse;
+
+    while (( ! fFound ) && ( NULL != fgets(szLine, sizeof(szLine), pfile) )) {
+
+        if (( FParseLine(szLine, szSnLine, pcfg) ) && ( 0 == strcmp(szSn, szSnLine) )) {
+            fFound = fTrue;
+        }
+    }
+
+    fclose(pfile);
+
+    return fFound;
+}
+
+/* ------------------------------------------------------------ */
+/***    FT7Save
+**
+**  Parameters:
+**      szPath  - scan format file
+**      szSn    - serial number of the device
+**      pcfg    - setup to store
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Store the setup of a device, replacing any stored before. The
+**      file is rewritten under a temporary name and then renamed, so
+**      it is never left half written.
+*/
+BOOL
+FT7Save( const char * szPath, const char * szSn, const T7CFG * pcfg ) {
+
+    FILE *      pfileOld;
+    FILE *      pfileNew;
+    char        szTmp[FILENAME_MAX + 8];
+    char        szLine[cchT7LineMax];
+    char        szSnLine[cchSnMax + 1];
+    T7CFG       cfgLine;
+    BOOL        fSuccess;
+
+    if ( sizeof(szTmp) <= (size_t)snprintf(szTmp, sizeof(szTmp), "%s.tmp", szPath) ) {
+        return fFalse;
+    }
+
+    pfileNew = fopen(szTmp, "w");
+    if ( NULL == pfileNew ) {
+        return fFalse;
+    }
+
+    fprintf(pfileNew, "# serial format rdy-bits dly-bits bits-per-second\n");
+
+    /* Copy the setups of every other device.
+    */
+    pfileOld = fopen(szPath, "r");
+    if ( NULL != pfileOld ) {
+
+        while ( NULL != fgets(szLine, sizeof(szLine), pfileOld) ) {
+
+            if (( FParseLine(szLine, szSnLine, &cfgLine) ) && ( 0 != strcmp(szSn, szSnLine) )) {
+                fputs(szLine, pfileNew);
+            }
+        }
+
+        fclose(pfileOld);
+    }
+
+    fprintf(pfileNew, "%s %s %u %u %u\n", szSn, SzT7Format(pcfg->jtgsf),
+            pcfg->cbitRdy, pcfg->cbitDly, pcfg->bps);
+
+    fSuccess = ( 0 == ferror(pfileNew) );
+
+    if ( 0 != fclose(pfileNew) ) {
+        fSuccess = fFalse;
+    }
+
+    if (( ! fSuccess ) || ( 0 != rename(szTmp, szPath) )) {
+
+        remove(szTmp);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    Pt7fFind
+**
+**  Parameters:
+**      jtgsf       - scan format
+**
+**  Return Values:
+**      entry of the scan format, NULL if it isn't one of the advanced
+**      protocol
+**
+**  Errors:
+**
+**  Description:
+**      Look up a scan format in rgt7f.
+*/
+static const T7FMT *
+Pt7fFind( BYTE jtgsf ) {
+
+    const T7FMT *   pt7f;
+
+    for ( pt7f = rgt7f; NULL != pt7f->sz; pt7f++ ) {
+
+        if ( jtgsf == pt7f->jtgsf ) {
+            return pt7f;
+        }
+    }
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseLine
+**
+**  Parameters:
+**      sz      - line of a scan format file
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**      pcfg    - receives the setup
+**
+**  Return Values:
+**      fTrue if the line holds a setup, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a line of a scan format file. Comments and lines that
+**      don't describe a valid setup are skipped.
+*/
+static BOOL
+FParseLine( const char * sz, char * szSn, T7CFG * pcfg ) {
+
+    char    szFmtLine[32];
+    char    szFmt[16];
+
+    if ( '#' == sz[0] ) {
+        return fFalse;
+    }
+
+    snprintf(szFmtLine, sizeof(szFmtLine), "%%%us %%15s %%u %%u %%u", cchSnMax);
+
+    if ( 5 > sscanf(sz, szFmtLine, szSn, szFmt, &pcfg->cbitRdy, &pcfg->cbitDly, &pcfg->bps) ) {
+        return fFalse;
+    }
+
+    return ( FT7ParseFormat(szFmt, &pcfg->jtgsf) ) &&
+           ( cbitT7RdyMin <= pcfg->cbitRdy ) && ( cbitT7RdyMax >= pcfg->cbitRdy ) &&
+           ( cbitT7DlyMax >= pcfg->cbitDly );
+}
+
+/************************************************************************/
@@ -0,0 +1,113 @@
+/************************************************************************/
+/*                                                                      */
+/*    Jtg7Cfg.h  --    Interface Declarations for Jtg7Cfg.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the      */
+/*    configuration of an IEEE 1149.7-2009 target and the DJTG port     */
+/*    that drives it: the scan format, the RDY bit count and the DLY    */
+/*    bit count are set on both sides with the sequence used by         */
+/*    DjtgTwoWireDemo. It also declares the file that keeps the fastest */
+/*    reliable setup found by DjtgScanProbe for each device serial      */
+/*    number. JtgTap.h and JtgBatch.h must be included before this      */
+/*    header.                                                           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTG7CFG_INCLUDED)
+#define      JTG7CFG_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Range of the RDY and DLY bit counts. A DLY count of 3 selects a
+** variable delay and isn't used here.
+*/
+const DWORD cbitT7RdyMin    = 1;
+const DWORD cbitT7RdyMax    = 4;
+const DWORD cbitT7DlyMax    = 2;
+
+/* Largest number of IDCODEs read by FReadIdcodes.
+*/
+const DWORD cidT7Max        = 32;
+
+/* Name of the scan format file in the user's home directory.
+*/
+#define szT7FileDefault     ".djtgscan"
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* A two-wire setup, and the rate measured with it in bits per second
+** of scan data.
+*/
+typedef struct {
+    BYTE    jtgsf;
+    DWORD   cbitRdy;
+    DWORD   cbitDly;
+    DWORD   bps;
+} T7CFG;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class Jtg7Cfg {
+
+private:
+    HIF         hif;
+    DPRP        dprp;
+    JtgTap      tap;
+    JtgBatch    jb;
+    BOOL        fAdvanced;      // the target uses the advanced protocol
+    char        szError[256];
+
+    BOOL    FFail(const char * szFmt, ...);
+    BOOL    FPutMoves();
+    BOOL    FCmdPart(BYTE csdr);
+    BOOL    FSendCmd(BYTE cmd, BYTE op);
+
+    Jtg7Cfg(const Jtg7Cfg &);
+    Jtg7Cfg & operator=(const Jtg7Cfg &);
+
+public:
+    Jtg7Cfg();
+
+    BOOL    FInit(HIF hifReq);
+    BOOL    FReset();
+    BOOL    FConfigure(const T7CFG * pcfg);
+    BOOL    FReadIdcodes(DWORD * rgid, DWORD * pcid);
+    BOOL    FScanDr(const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo);
+
+    BOOL            FFormatSupported(BYTE jtgsf) const;
+    BOOL            FReadyCnt() const { return ( 0 != (dprpJtgReadyCnt & dprp) ); }
+    BOOL            FDelayCnt() const { return ( 0 != (dprpJtgDelayCnt & dprp) ); }
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BYTE            OpT7Format(BYTE jtgsf);
+const char *    SzT7Format(BYTE jtgsf);
+BOOL            FT7ParseFormat(const char * sz, BYTE * pjtgsf);
+BOOL            FT7GetSerial(HIF hif, char * szSn);
+BOOL            FT7Path(char * szPath, DWORD cchMax);
+BOOL            FT7Load(const char * szPath, const char * szSn, T7CFG * pcfg);
+BOOL            FT7Save(const char * szPath, const char * szSn, const T7CFG * pcfg);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTG7CFG_INCLUDED
+
+/************************************************************************/
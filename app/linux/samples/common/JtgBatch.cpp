@@ -0,0 +1,966 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgBatch.cpp  --  Compiled JTAG programs for DjtgBatch              */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a builder that serializes a sequence of      */
+/*  JTAG steps into DjtgBatch command buffers.                          */
+/*                                                                      */
+/*  Every command is appended to a single send buffer as it is          */
+/*  recorded, so executing the program only has to pass ranges of that  */
+/*  buffer to DjtgBatch. The TDO bits of all commands land in a single  */
+/*  receive buffer, and the captures are copied from there to the       */
+/*  caller's buffers after the last call has completed.                 */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBatch.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* TMS sequences used by FScanIr and FScanDr, sent LSB first.
+*/
+const BYTE      bTmsRTISIR  = 0x03;     // RTI->SELDR->SELIR->CIR->SIR
+const DWORD     cbitRTISIR  = 4;
+const BYTE      bTmsRTISDR  = 0x01;     // RTI->SELDR->CDR->SDR
+const DWORD     cbitRTISDR  = 3;
+const BYTE      bTmsE1RTI   = 0x01;     // E1xR->UxR->RTI
+const DWORD     cbitE1RTI   = 2;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static void     ShiftCmd(BOOL fSnd, BOOL fRcv, BOOL fTms, BYTE * pjcb, BYTE * pbArg1, BYTE * pbArg2);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgBatch::JtgBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an empty program.
+*/
+JtgBatch::JtgBatch() {
+
+    rgbSnd = NULL;
+    rgbRcv = NULL;
+    cbSndMax = 0;
+    cbRcvMax = 0;
+    rgcmd = NULL;
+    ccmdMax = 0;
+    rgcap = NULL;
+    ccapMax = 0;
+
+    hifProps = hifInvalid;
+    prtProps = 0;
+    fBatch = fFalse;
+    djbp = 0;
+
+    Reset();
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::~JtgBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory used by the program.
+*/
+JtgBatch::~JtgBatch() {
+
+    free(rgbSnd);
+    free(rgbRcv);
+    free(rgcmd);
+    free(rgcap);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::Reset
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Remove every step from the program. The memory is kept so that
+**      the program can be rebuilt without allocating.
+*/
+void
+JtgBatch::Reset() {
+
+    cbSnd = 0;
+    cbRcv = 0;
+    ccmd = 0;
+    ccap = 0;
+    fError = fFalse;
+    ccallLast = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FPutTms
+**
+**  Parameters:
+**      rgbTms      - TMS bits to send, LSB first
+**      cbit        - number of bits
+**      fTdi        - value held on TDI
+**      rgbTdo      - receives the TDO bits, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a TMS move, as DjtgPutTmsBits.
+*/
+BOOL
+JtgBatch::FPutTms( const BYTE * rgbTms, DWORD cbit, BOOL fTdi, BYTE * rgbTdo ) {
+
+    if ( NULL == rgbTms ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    return FAddBits(( NULL != rgbTdo ) ? jcbPutTmsGetTdo : jcbPutTms, fTdi ? 1 : 0, 0,
+                    rgbTms, cbit, rgbTdo, 0, (cbit + 7) / 8);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FShift
+**
+**  Parameters:
+**      rgbTdi      - TDI bits to send LSB first, or NULL to send 0's
+**      cbit        - number of bits
+**      fExit       - raise TMS on the last bit
+**      rgbTdo      - receives the TDO bits, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a shift from the Shift-IR or Shift-DR state. TMS is held low
+**      so the TAP stays in the shift state, except for the last bit
+**      when fExit is set, which moves the TAP to Exit1.
+*/
+BOOL
+JtgBatch::FShift( const BYTE * rgbTdi, DWORD cbit, BOOL fExit, BYTE * rgbTdo ) {
+
+    DWORD   cbitBody;
+    DWORD   cbClear;
+    BYTE    jcb;
+    BYTE    bArg1;
+    BYTE    bArg2;
+    BYTE    bTdi;
+
+    if ( 0 == cbit ) {
+        return ! fError;
+    }
+
+    cbitBody = fExit ? cbit - 1 : cbit;
+    cbClear = (cbit + 7) / 8;
+
+    ShiftCmd(NULL != rgbTdi, NULL != rgbTdo, fFalse, &jcb, &bArg1, &bArg2);
+    if ( ! FAddBits(jcb, bArg1, bArg2, rgbTdi, cbitBody, rgbTdo, 0, cbClear) ) {
+        return fFalse;
+    }
+
+    if ( ! fExit ) {
+        return fTrue;
+    }
+
+    /* The last bit needs TMS high, so it is a command of its own. Its
+    ** TDO bit is captured right after those of the body.
+    */
+    bTdi = 0;
+    if ( NULL != rgbTdi ) {
+        bTdi = (rgbTdi[cbitBody / 8] >> (cbitBody % 8)) & 1;
+    }
+
+    ShiftCmd(NULL != rgbTdi, NULL != rgbTdo, fTrue, &jcb, &bArg1, &bArg2);
+
+    return FAddBits(jcb, bArg1, bArg2, ( NULL != rgbTdi ) ? &bTdi : NULL, 1,
+                    rgbTdo, cbitBody, ( 0 == cbitBody ) ? 1 : 0);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FScanIr
+**
+**  Parameters:
+**      rgbTdi      - instruction bits to send, or NULL to send 0's
+**      cbit        - length of the instruction register chain
+**      rgbTdo      - receives the bits shifted out, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a complete IR scan that starts and ends in Run-Test/Idle.
+*/
+BOOL
+JtgBatch::FScanIr( const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo ) {
+
+    return FPutTms(&bTmsRTISIR, cbitRTISIR, fFalse, NULL) &&
+           FShift(rgbTdi, cbit, fTrue, rgbTdo) &&
+           FPutTms(&bTmsE1RTI, cbitE1RTI, fFalse, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FScanDr
+**
+**  Parameters:
+**      rgbTdi      - data bits to send, or NULL to send 0's
+**      cbit        - length of the data register chain
+**      rgbTdo      - receives the bits shifted out, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a complete DR scan that starts and ends in Run-Test/Idle.
+*/
+BOOL
+JtgBatch::FScanDr( const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo ) {
+
+    return FPutTms(&bTmsRTISDR, cbitRTISDR, fFalse, NULL) &&
+           FShift(rgbTdi, cbit, fTrue, rgbTdo) &&
+           FPutTms(&bTmsE1RTI, cbitE1RTI, fFalse, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FClockTck
+**
+**  Parameters:
+**      fTms        - value held on TMS
+**      fTdi        - value held on TDI
+**      cclk        - number of TCK cycles
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add TCK cycles, as DjtgClockTck. This is how run-test cycles are
+**      made in Run-Test/Idle.
+*/
+BOOL
+JtgBatch::FClockTck( BOOL fTms, BOOL fTdi, DWORD cclk ) {
+
+    return FAddBits(jcbClockTck, fTms ? 1 : 0, fTdi ? 1 : 0, NULL, cclk, NULL, 0, 0);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FWait
+**
+**  Parameters:
+**      tus         - time to wait in microseconds
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a wait, as DjtgWait. The wait is made by the port when it
+**      supports djbpWaitUs, and by the host between two batches
+**      otherwise.
+*/
+BOOL
+JtgBatch::FWait( DWORD tus ) {
+
+    return ( NULL != PcmdNew(jcbWaitUs, 0, 0, tus, 0, fFalse) );
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FSetAuxReset
+**
+**  Parameters:
+**      fReset      - drive the aux reset line active
+**      fEnOutput   - enable the aux reset output
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a change of the aux reset line, as DjtgSetAuxReset. The
+**      change is made by the port when it supports djbpSetAuxReset, and
+**      by the host between two batches otherwise.
+*/
+BOOL
+JtgBatch::FSetAuxReset( BOOL fReset, BOOL fEnOutput ) {
+
+    return ( NULL != PcmdNew(jcbSetAuxReset, fReset ? 1 : 0, fEnOutput ? 1 : 0, 0, 0, fFalse) );
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FExecute
+**
+**  Parameters:
+**      hif         - open handle with DJTG enabled
+**      prt         - DJTG port that was enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if any step failed to be recorded or any call fails.
+**
+**  Description:
+**      Run the program. Consecutive commands are packed into DjtgBatch
+**      calls of up to cbJbSndMax and cbJbRcvMax bytes, which are issued
+**      as overlapped calls with up to ccallJbInFlightMax in flight. A
+**      step the port can't run in a batch waits for every call in
+**      flight to complete and is then made by the host. The captured
+**      TDO bits are copied to the caller's buffers at the end.
+*/
+BOOL
+JtgBatch::FExecute( HIF hif, INT32 prt ) {
+
+    JBCMD *     pcmd;
+    JBCAP *     pcap;
+    DWORD       icmd;
+    DWORD       icmdFirst;
+    DWORD       icap;
+    DWORD       ibit;
+    DWORD       ibitSrc;
+    DWORD       ibitDst;
+    DWORD       cbSndCall;
+    DWORD       cbRcvCall;
+    DWORD       ccallInFlight;
+    DWORD       tusWaited;
+    BOOL        fOk;
+
+    ccallLast = 0;
+
+    if (( fError ) || ( ! FGetProps(hif, prt) )) {
+        return fFalse;
+    }
+
+    if ( ! FGrowArray((void **)&rgbRcv, &cbRcvMax, ( 0 != cbRcv ) ? cbRcv : 1, 1) ) {
+        return fFalse;
+    }
+
+    ccallInFlight = 0;
+    icmdFirst = 0;
+    cbSndCall = 0;
+    cbRcvCall = 0;
+
+    for ( icmd = 0; icmd < ccmd; icmd++ ) {
+
+        pcmd = &rgcmd[icmd];
+
+        if ( FHostCmd(pcmd) ) {
+
+            if (( ! FIssue(hif, icmdFirst, icmd, &ccallInFlight) ) ||
+                ( ! FWaitCalls(hif, &ccallInFlight, 0) )) {
+
+                return fFalse;
+            }
+
+            if ( jcbWaitUs == pcmd->jcb ) {
+                fOk = DjtgWait(hif, pcmd->cbit, &tusWaited);
+            }
+            else {
+                fOk = DjtgSetAuxReset(hif, pcmd->bArg1, pcmd->bArg2);
+            }
+
+            if ( ! fOk ) {
+                return fFalse;
+            }
+
+            ccallLast++;
+            icmdFirst = icmd + 1;
+            cbSndCall = 0;
+            cbRcvCall = 0;
+        }
+        else if ( ! fBatch ) {
+
+            if ( ! FIssue(hif, icmd, icmd + 1, &ccallInFlight) ) {
+                return fFalse;
+            }
+
+            icmdFirst = icmd + 1;
+        }
+        else {
+
+            /* Start a new call when this command doesn't fit.
+            */
+            if (( cbJbSndMax < cbSndCall + pcmd->cbSnd ) ||
+                ( cbJbRcvMax < cbRcvCall + pcmd->cbRcv )) {
+
+                if ( ! FIssue(hif, icmdFirst, icmd, &ccallInFlight) ) {
+                    return fFalse;
+                }
+
+                icmdFirst = icmd;
+                cbSndCall = 0;
+                cbRcvCall = 0;
+            }
+
+            cbSndCall += pcmd->cbSnd;
+            cbRcvCall += pcmd->cbRcv;
+        }
+    }
+
+    if (( ! FIssue(hif, icmdFirst, ccmd, &ccallInFlight) ) ||
+        ( ! FWaitCalls(hif, &ccallInFlight, 0) )) {
+
+        return fFalse;
+    }
+
+    for ( icap = 0; icap < ccap; icap++ ) {
+
+        pcap = &rgcap[icap];
+
+        if ( 0 != pcap->cbClear ) {
+            memset(pcap->pbDst, 0, pcap->cbClear);
+        }
+
+        ibit = 0;
+
+        /* Whole bytes are copied directly when both ends are aligned,
+        ** which is the case for every capture but the exit bit of a
+        ** shift.
+        */
+        if (( 0 == pcap->ibitSrc % 8 ) && ( 0 == pcap->ibitDst % 8 )) {
+
+            ibit = pcap->cbit & ~7;
+            memcpy(&pcap->pbDst[pcap->ibitDst / 8], &rgbRcv[pcap->ibitSrc / 8], ibit / 8);
+        }
+
+        for ( ; ibit < pcap->cbit; ibit++ ) {
+
+            ibitSrc = pcap->ibitSrc + ibit;
+            ibitDst = pcap->ibitDst + ibit;
+
+            if ( rgbRcv[ibitSrc / 8] & (1 << (ibitSrc % 8)) ) {
+                pcap->pbDst[ibitDst / 8] |= (1 << (ibitDst % 8));
+            }
+            else {
+                pcap->pbDst[ibitDst / 8] &= ~(1 << (ibitDst % 8));
+            }
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::PcmdNew
+**
+**  Parameters:
+**      jcb         - command code
+**      bArg1       - first BOOL argument, if the command has one
+**      bArg2       - second BOOL argument, if the command has one
+**      cbit        - bit, clock or microsecond count
+**      cbData      - bytes of TMS or TDI bits that follow
+**      fRcv        - the command returns its TDO bits
+**
+**  Return Values:
+**      pointer to the new command, or NULL on failure
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a command to the send buffer. The header is written here
+**      and the caller copies the data to ibData.
+*/
+JBCMD *
+JtgBatch::PcmdNew( BYTE jcb, BYTE bArg1, BYTE bArg2, DWORD cbit, DWORD cbData, BOOL fRcv ) {
+
+    JBCMD * pcmd;
+    DWORD   carg;
+    BOOL    fCount;
+    DWORD   cbCmd;
+    BYTE *  pb;
+
+    if ( fError ) {
+        return NULL;
+    }
+
+    switch ( jcb ) {
+
+        case jcbPutTms:
+        case jcbPutTmsGetTdo:
+        case jcbPutTdi:
+        case jcbPutTdiGetTdo:
+            carg = 1;
+            fCount = fTrue;
+            break;
+
+        case jcbGetTdo:
+        case jcbClockTck:
+            carg = 2;
+            fCount = fTrue;
+            break;
+
+        case jcbWaitUs:
+            carg = 0;
+            fCount = fTrue;
+            break;
+
+        case jcbSetAuxReset:
+            carg = 2;
+            fCount = fFalse;
+            break;
+
+        default:
+            fError = fTrue;
+            return NULL;
+    }
+
+    cbCmd = 1 + carg + (fCount ? 4 : 0) + cbData;
+
+    if (( ! FGrowArray((void **)&rgbSnd, &cbSndMax, cbSnd + cbCmd, 1) ) ||
+        ( ! FGrowArray((void **)&rgcmd, &ccmdMax, ccmd + 1, sizeof(JBCMD)) )) {
+
+        fError = fTrue;
+        return NULL;
+    }
+
+    pcmd = &rgcmd[ccmd++];
+    pcmd->jcb = jcb;
+    pcmd->bArg1 = bArg1;
+    pcmd->bArg2 = bArg2;
+    pcmd->cbit = cbit;
+    pcmd->ibSnd = cbSnd;
+    pcmd->cbSnd = cbCmd;
+    pcmd->ibData = cbSnd + cbCmd - cbData;
+    pcmd->ibRcv = cbRcv;
+    pcmd->cbRcv = fRcv ? (cbit + 7) / 8 : 0;
+
+    pb = &rgbSnd[cbSnd];
+    *pb++ = jcb;
+
+    if ( 0 < carg ) {
+        *pb++ = bArg1;
+    }
+    if ( 1 < carg ) {
+        *pb++ = bArg2;
+    }
+
+    if ( fCount ) {
+        *pb++ = (BYTE)(cbit & 0xFF);
+        *pb++ = (BYTE)((cbit >> 8) & 0xFF);
+        *pb++ = (BYTE)((cbit >> 16) & 0xFF);
+        *pb++ = (BYTE)((cbit >> 24) & 0xFF);
+    }
+
+    cbSnd += cbCmd;
+    cbRcv += pcmd->cbRcv;
+
+    return pcmd;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FAddBits
+**
+**  Parameters:
+**      jcb         - command code
+**      bArg1       - first BOOL argument
+**      bArg2       - second BOOL argument
+**      rgbData     - TMS or TDI bits, or NULL if the command has none
+**      cbit        - number of bits or clocks
+**      rgbTdo      - receives the TDO bits, may be NULL
+**      ibitDst     - position in rgbTdo of the first bit
+**      cbClear     - bytes of rgbTdo to clear before the bits are copied
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a step as one command, or as several commands of up to
+**      cbitJbCmdMax bits each if it is longer than that.
+*/
+BOOL
+JtgBatch::FAddBits( BYTE jcb, BYTE bArg1, BYTE bArg2, const BYTE * rgbData,
+                    DWORD cbit, BYTE * rgbTdo, DWORD ibitDst, DWORD cbClear ) {
+
+    JBCMD * pcmd;
+    DWORD   ibit;
+    DWORD   cbitCmd;
+    DWORD   cbData;
+
+    for ( ibit = 0; ibit < cbit; ibit += cbitCmd ) {
+
+        cbitCmd = cbit - ibit;
+        if ( cbitJbCmdMax < cbitCmd ) {
+            cbitCmd = cbitJbCmdMax;
+        }
+
+        cbData = ( NULL != rgbData ) ? (cbitCmd + 7) / 8 : 0;
+
+        pcmd = PcmdNew(jcb, bArg1, bArg2, cbitCmd, cbData, NULL != rgbTdo);
+        if ( NULL == pcmd ) {
+            return fFalse;
+        }
+
+        if ( NULL != rgbData ) {
+            memcpy(&rgbSnd[pcmd->ibData], &rgbData[ibit / 8], cbData);
+        }
+
+        if (( NULL != rgbTdo ) &&
+            ( ! FAddCap(8 * pcmd->ibRcv, cbitCmd, rgbTdo, ibitDst + ibit,
+                        ( 0 == ibit ) ? cbClear : 0) )) {
+
+            return fFalse;
+        }
+    }
+
+    return ! fError;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FAddCap
+**
+**  Parameters:
+**      ibitSrc     - first bit in the receive buffer
+**      cbit        - number of bits
+**      pbDst       - destination buffer
+**      ibitDst     - first bit in the destination
+**      cbClear     - bytes of the destination to clear first
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a capture.
+*/
+BOOL
+JtgBatch::FAddCap( DWORD ibitSrc, DWORD cbit, BYTE * pbDst, DWORD ibitDst, DWORD cbClear ) {
+
+    JBCAP * pcap;
+
+    if ( ! FGrowArray((void **)&rgcap, &ccapMax, ccap + 1, sizeof(JBCAP)) ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    pcap = &rgcap[ccap++];
+    pcap->ibitSrc = ibitSrc;
+    pcap->cbit = cbit;
+    pcap->pbDst = pbDst;
+    pcap->ibitDst = ibitDst;
+    pcap->cbClear = cbClear;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FGetProps
+**
+**  Parameters:
+**      hif         - open handle with DJTG enabled
+**      prt         - DJTG port that was enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Find out whether the port supports DjtgBatch and which of the
+**      optional batch commands it runs. The answer is kept for the
+**      next execution on the same port.
+*/
+BOOL
+JtgBatch::FGetProps( HIF hif, INT32 prt ) {
+
+    DPRP    dprp;
+
+    if (( hif == hifProps ) && ( prt == prtProps )) {
+        return fTrue;
+    }
+
+    hifProps = hifInvalid;
+
+    if ( ! DjtgGetPortProperties(hif, prt, &dprp) ) {
+        return fFalse;
+    }
+
+    fBatch = ( 0 != (dprp & dprpJtgBatch) );
+    djbp = 0;
+
+    if (( fBatch ) && ( ! DjtgGetBatchProperties(hif, prt, &djbp) )) {
+        return fFalse;
+    }
+
+    hifProps = hif;
+    prtProps = prt;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FHostCmd
+**
+**  Parameters:
+**      pcmd        - command
+**
+**  Return Values:
+**      fTrue if the host must make the step, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Wait and aux reset commands are only sent to the port in a
+**      batch when the port says it supports them.
+*/
+BOOL
+JtgBatch::FHostCmd( const JBCMD * pcmd ) const {
+
+    if ( jcbWaitUs == pcmd->jcb ) {
+        return ( ! fBatch ) || ( 0 == (djbp & djbpWaitUs) );
+    }
+
+    if ( jcbSetAuxReset == pcmd->jcb ) {
+        return ( ! fBatch ) || ( 0 == (djbp & djbpSetAuxReset) );
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FIssue
+**
+**  Parameters:
+**      hif             - open handle with DJTG enabled
+**      icmdFirst       - first command to send
+**      icmdLim         - command after the last one to send
+**      pccallInFlight  - number of overlapped calls in flight
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call can't be started. The calls in flight are
+**      cancelled.
+**
+**  Description:
+**      Start an overlapped call for a range of commands. The range is
+**      sent with DjtgBatch when the port supports it, and is a single
+**      command sent with its own DJTG function otherwise.
+*/
+BOOL
+JtgBatch::FIssue( HIF hif, DWORD icmdFirst, DWORD icmdLim, DWORD * pccallInFlight ) {
+
+    JBCMD * pcmdFirst;
+    JBCMD * pcmdLast;
+    BYTE *  pbData;
+    BYTE *  pbRcv;
+    DWORD   cbSndCall;
+    DWORD   cbRcvCall;
+    BOOL    fOk;
+
+    if ( icmdFirst >= icmdLim ) {
+        return fTrue;
+    }
+
+    if ( ! FWaitCalls(hif, pccallInFlight, ccallJbInFlightMax - 1) ) {
+        return fFalse;
+    }
+
+    pcmdFirst = &rgcmd[icmdFirst];
+    pcmdLast = &rgcmd[icmdLim - 1];
+
+    if ( fBatch ) {
+
+        cbSndCall = pcmdLast->ibSnd + pcmdLast->cbSnd - pcmdFirst->ibSnd;
+        cbRcvCall = pcmdLast->ibRcv + pcmdLast->cbRcv - pcmdFirst->ibRcv;
+
+        fOk = DjtgBatch(hif, cbSndCall, &rgbSnd[pcmdFirst->ibSnd], cbRcvCall,
+                        ( 0 != cbRcvCall ) ? &rgbRcv[pcmdFirst->ibRcv] : NULL, fTrue);
+    }
+    else {
+
+        pbData = &rgbSnd[pcmdFirst->ibData];
+        pbRcv = ( 0 != pcmdFirst->cbRcv ) ? &rgbRcv[pcmdFirst->ibRcv] : NULL;
+
+        switch ( pcmdFirst->jcb ) {
+
+            case jcbPutTms:
+            case jcbPutTmsGetTdo:
+                fOk = DjtgPutTmsBits(hif, pcmdFirst->bArg1, pbData, pbRcv, pcmdFirst->cbit, fTrue);
+                break;
+
+            case jcbPutTdi:
+            case jcbPutTdiGetTdo:
+                fOk = DjtgPutTdiBits(hif, pcmdFirst->bArg1, pbData, pbRcv, pcmdFirst->cbit, fTrue);
+                break;
+
+            case jcbGetTdo:
+                fOk = DjtgGetTdoBits(hif, pcmdFirst->bArg1, pcmdFirst->bArg2, pbRcv,
+                                     pcmdFirst->cbit, fTrue);
+                break;
+
+            case jcbClockTck:
+                fOk = DjtgClockTck(hif, pcmdFirst->bArg1, pcmdFirst->bArg2, pcmdFirst->cbit, fTrue);
+                break;
+
+            default:
+                fOk = fFalse;
+                break;
+        }
+    }
+
+    if ( ! fOk ) {
+
+        if ( 0 != *pccallInFlight ) {
+            DmgrCancelTrans(hif);
+            *pccallInFlight = 0;
+        }
+        return fFalse;
+    }
+
+    (*pccallInFlight)++;
+    ccallLast++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBatch::FWaitCalls
+**
+**  Parameters:
+**      hif             - open handle with DJTG enabled
+**      pccallInFlight  - number of overlapped calls in flight
+**      ccallLeave      - number of calls that may remain in flight
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call doesn't complete. The remaining calls are
+**      cancelled.
+**
+**  Description:
+**      Wait for the oldest calls in flight to complete.
+*/
+BOOL
+JtgBatch::FWaitCalls( HIF hif, DWORD * pccallInFlight, DWORD ccallLeave ) {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+
+    while ( *pccallInFlight > ccallLeave ) {
+
+        if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsJbCallWait) ) {
+
+            DmgrCancelTrans(hif);
+            *pccallInFlight = 0;
+            return fFalse;
+        }
+
+        (*pccallInFlight)--;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    ShiftCmd
+**
+**  Parameters:
+**      fSnd        - TDI bits are sent
+**      fRcv        - TDO bits are wanted
+**      fTms        - value held on TMS
+**      pjcb        - receives the command code
+**      pbArg1      - receives the first BOOL argument
+**      pbArg2      - receives the second BOOL argument
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Pick the cheapest command for a shift. A shift that neither
+**      sends nor receives bits only clocks TCK.
+*/
+static void
+ShiftCmd( BOOL fSnd, BOOL fRcv, BOOL fTms, BYTE * pjcb, BYTE * pbArg1, BYTE * pbArg2 ) {
+
+    BYTE    bTms;
+
+    bTms = fTms ? 1 : 0;
+
+    if ( fSnd ) {
+
+        *pjcb = fRcv ? jcbPutTdiGetTdo : jcbPutTdi;
+        *pbArg1 = bTms;
+        *pbArg2 = 0;
+    }
+    else if ( fRcv ) {
+
+        *pjcb = jcbGetTdo;
+        *pbArg1 = 0;
+        *pbArg2 = bTms;
+    }
+    else {
+
+        *pjcb = jcbClockTck;
+        *pbArg1 = bTms;
+        *pbArg2 = 0;
+    }
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
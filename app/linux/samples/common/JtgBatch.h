@@ -0,0 +1,183 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgBatch.h  --    Interface Declarations for JtgBatch.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a JTAG   */
+/*    program builder. A batch records TMS moves, IR and DR shifts,     */
+/*    TCK clocks, waits and aux reset changes, and executes them with   */
+/*    as few DjtgBatch calls as possible instead of one DJTG call per   */
+/*    step.                                                             */
+/*                                                                      */
+/*    Steps are serialized into the DjtgBatch command buffer as they    */
+/*    are recorded. Each command is the jcb code from djtg.h followed   */
+/*    by the arguments of the matching DJTG function, in the same       */
+/*    order: one byte for each BOOL, four bytes little endian for the   */
+/*    bit, clock or microsecond count, and then the TMS or TDI bits     */
+/*    packed LSB first. The TDO bits of the commands that return data   */
+/*    are appended to the receive buffer in the same order, each        */
+/*    command starting on a byte boundary.                              */
+/*                                                                      */
+/*    A program is only split where it has to be: when a buffer would   */
+/*    exceed the limits below, or at a wait or aux reset change that    */
+/*    DjtgGetBatchProperties reports the port can't run in a batch.     */
+/*    Those steps are made by the host between two batches. The caller  */
+/*    decides where a result is needed by calling FExecute, so a whole  */
+/*    chain operation normally costs a single transaction. If the port  */
+/*    doesn't support DjtgBatch at all, the steps are issued as         */
+/*    individual overlapped calls instead.                              */
+/*                                                                      */
+/*    The TDO bits captured by each step are copied to the caller's     */
+/*    buffers, LSB first, once the batch has been executed. A shift     */
+/*    that exits the shift state on its last bit is captured as one     */
+/*    contiguous bit string even though it is sent as two commands.     */
+/*                                                                      */
+/*    A batch may be executed any number of times. The bits sent are    */
+/*    copied when a step is recorded, but the capture buffers must      */
+/*    remain valid until the batch is reset.                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGBATCH_INCLUDED)
+#define      JTGBATCH_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Largest send and receive buffers passed to a single DjtgBatch call.
+** These are kept well below what the DJTG firmware buffers so that a
+** long program is pipelined as several overlapped calls.
+*/
+const DWORD cbJbSndMax = 4096;
+const DWORD cbJbRcvMax = 4096;
+
+/* Largest number of bits moved by one command. Longer steps are
+** recorded as several commands.
+*/
+const DWORD cbitJbCmdMax = 8 * 1024;
+
+/* Largest number of overlapped calls that FExecute keeps in flight,
+** and the time allowed for each one to complete.
+*/
+const DWORD ccallJbInFlightMax = 8;
+const DWORD tmsJbCallWait = 5000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* A command is one entry of the DjtgBatch command buffer, or one DJTG
+** call when the port can't run batches.
+*/
+typedef struct {
+    BYTE    jcb;            // jcb command code
+    BYTE    bArg1;          // first BOOL argument
+    BYTE    bArg2;          // second BOOL argument
+    DWORD   cbit;           // number of bits, clocks or microseconds
+    DWORD   ibSnd;          // offset of the command in the send buffer
+    DWORD   cbSnd;          // size of the command in the send buffer
+    DWORD   ibData;         // offset of the TMS or TDI bits
+    DWORD   ibRcv;          // offset of the TDO bits in the receive buffer
+    DWORD   cbRcv;          // number of TDO bytes returned
+} JBCMD;
+
+/* A capture copies TDO bits from the receive buffer to a caller's
+** buffer.
+*/
+typedef struct {
+    DWORD   ibitSrc;        // first bit in the receive buffer
+    DWORD   cbit;           // number of bits
+    BYTE *  pbDst;          // destination
+    DWORD   ibitDst;        // first bit in the destination
+    DWORD   cbClear;        // bytes of the destination cleared first
+} JBCAP;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgBatch {
+
+private:
+    BYTE *      rgbSnd;
+    BYTE *      rgbRcv;
+    DWORD       cbSnd;
+    DWORD       cbSndMax;
+    DWORD       cbRcv;
+    DWORD       cbRcvMax;
+
+    JBCMD *     rgcmd;
+    DWORD       ccmd;
+    DWORD       ccmdMax;
+
+    JBCAP *     rgcap;
+    DWORD       ccap;
+    DWORD       ccapMax;
+
+    BOOL        fError;         // a step failed to be recorded
+    DWORD       ccallLast;      // calls made by the last FExecute
+
+    /* Capabilities of the port the last batch was executed on.
+    */
+    HIF         hifProps;
+    INT32       prtProps;
+    BOOL        fBatch;
+    UINT32      djbp;
+
+    JBCMD * PcmdNew(BYTE jcb, BYTE bArg1, BYTE bArg2, DWORD cbit, DWORD cbData, BOOL fRcv);
+    BOOL    FAddBits(BYTE jcb, BYTE bArg1, BYTE bArg2, const BYTE * rgbData,
+                     DWORD cbit, BYTE * rgbTdo, DWORD ibitDst, DWORD cbClear);
+    BOOL    FAddCap(DWORD ibitSrc, DWORD cbit, BYTE * pbDst, DWORD ibitDst, DWORD cbClear);
+    BOOL    FGetProps(HIF hif, INT32 prt);
+    BOOL    FHostCmd(const JBCMD * pcmd) const;
+    BOOL    FIssue(HIF hif, DWORD icmdFirst, DWORD icmdLim, DWORD * pccallInFlight);
+    BOOL    FWaitCalls(HIF hif, DWORD * pccallInFlight, DWORD ccallLeave);
+
+    JtgBatch(const JtgBatch &);
+    JtgBatch & operator=(const JtgBatch &);
+
+public:
+    JtgBatch();
+    ~JtgBatch();
+
+    void    Reset();
+
+    BOOL    FPutTms(const BYTE * rgbTms, DWORD cbit, BOOL fTdi, BYTE * rgbTdo);
+    BOOL    FShift(const BYTE * rgbTdi, DWORD cbit, BOOL fExit, BYTE * rgbTdo);
+    BOOL    FScanIr(const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo);
+    BOOL    FScanDr(const BYTE * rgbTdi, DWORD cbit, BYTE * rgbTdo);
+    BOOL    FClockTck(BOOL fTms, BOOL fTdi, DWORD cclk);
+    BOOL    FWait(DWORD tus);
+    BOOL    FSetAuxReset(BOOL fReset, BOOL fEnOutput);
+
+    BOOL    FExecute(HIF hif, INT32 prt = 0);
+
+    DWORD   CcmdCompiled() const { return ccmd; }
+    DWORD   CbSend() const { return cbSnd; }
+    DWORD   CbReceive() const { return cbRcv; }
+    DWORD   CcallLast() const { return ccallLast; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGBATCH_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,1316 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgBits.cpp  --  Bit vector kernels for JTAG scans                  */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module holds the bit vector kernels used to prepare and check  */
+/*  JTAG scans:                                                         */
+/*                                                                      */
+/*    1. Interleaving TMS and TDI into the pairs of DjtgPutTmsTdiBits,  */
+/*       TDI in the even bits and TMS in the odd bits, and splitting    */
+/*       pairs back into TMS and TDI.                                   */
+/*    2. Reversing the order of the bits of each byte, as needed for    */
+/*       FPGA bitstreams.                                               */
+/*    3. Comparing two vectors under a mask, as for the TDO checks of   */
+/*       SVF files.                                                     */
+/*                                                                      */
+/*  The scalar versions use 64 bit words with shift and mask steps.     */
+/*  The SSSE3 and AVX2 versions spread and reverse bits a nibble at a   */
+/*  time with byte shuffles, and split pairs with shift and mask steps  */
+/*  followed by a pack. The BMI2 version builds and splits the pairs    */
+/*  with PDEP and PEXT. As in DeltaRle, the vector versions are built   */
+/*  with function target attributes and the fastest one the processor   */
+/*  supports is selected at run time. Every version gives the same      */
+/*  result, bits past the end of a vector are never read as data and    */
+/*  bytes past the end of the output are never written.                 */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define JB_X86
+#include <immintrin.h>
+#endif
+
+#include "dpcdecl.h"
+#include "JtgBits.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Kernels of one implementation. They work on whole bytes: cb bytes
+** of TMS and TDI make 2 * cb bytes of pairs. A NULL TMS or TDI vector
+** is read as zeros, and a NULL output isn't written.
+*/
+typedef struct {
+    void    (* pfnInterleave)(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb);
+    void    (* pfnDeinterleave)(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb);
+    void    (* pfnReverse)(BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+    BOOL    (* pfnMaskedEqual)(const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb);
+} JBFNS;
+
+/* Even and odd bits of a 64 bit word.
+*/
+const UINT64    qwJbEven    = 0x5555555555555555ULL;
+const UINT64    qwJbOdd     = 0xAAAAAAAAAAAAAAAAULL;
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+static DWORD    jbimplCached = jbimplBest;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static const JBFNS *    PjbfnsGet(DWORD jbimpl);
+static UINT64   QwSpread(DWORD dw);
+static DWORD    DwCompact(UINT64 qw);
+
+static void     InterleaveScalar(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb);
+static void     DeinterleaveScalar(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb);
+static void     ReverseScalar(BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+static BOOL     FMaskedEqualScalar(const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb);
+
+#if defined(JB_X86)
+#if defined(__x86_64__)
+static void     InterleaveBmi2(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb);
+static void     DeinterleaveBmi2(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb);
+#endif
+static void     InterleaveSsse3(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb);
+static void     DeinterleaveSsse3(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb);
+static void     ReverseSsse3(BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+static BOOL     FMaskedEqualSsse3(const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb);
+static void     InterleaveAvx2(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb);
+static void     DeinterleaveAvx2(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb);
+static void     ReverseAvx2(BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+static BOOL     FMaskedEqualAvx2(const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb);
+#endif
+
+/* ------------------------------------------------------------ */
+/*                  Kernel Tables                               */
+/* ------------------------------------------------------------ */
+
+static const JBFNS  jbfnsScalar = {
+    InterleaveScalar, DeinterleaveScalar, ReverseScalar, FMaskedEqualScalar
+};
+
+#if defined(JB_X86)
+#if defined(__x86_64__)
+static const JBFNS  jbfnsBmi2 = {
+    InterleaveBmi2, DeinterleaveBmi2, ReverseScalar, FMaskedEqualScalar
+};
+#endif
+
+static const JBFNS  jbfnsSsse3 = {
+    InterleaveSsse3, DeinterleaveSsse3, ReverseSsse3, FMaskedEqualSsse3
+};
+
+static const JBFNS  jbfnsAvx2 = {
+    InterleaveAvx2, DeinterleaveAvx2, ReverseAvx2, FMaskedEqualAvx2
+};
+#endif
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JbInterleave
+**
+**  Parameters:
+**      rgbTms      - TMS bits, or NULL for zeros
+**      rgbTdi      - TDI bits, or NULL for zeros
+**      rgbPairs    - receives the pairs, (2 * cbit + 7) / 8 bytes
+**      cbit        - number of pairs
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Build the TMS/TDI pairs of DjtgPutTmsTdiBits with the fastest
+**      implementation supported by the processor. The bits past the
+**      last pair in the last byte are cleared.
+*/
+void
+JbInterleave( const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cbit ) {
+
+    JbInterleaveImpl(jbimplBest, rgbTms, rgbTdi, rgbPairs, cbit);
+}
+
+/* ------------------------------------------------------------ */
+/***    JbDeinterleave
+**
+**  Parameters:
+**      rgbPairs    - TMS/TDI pairs
+**      rgbTms      - receives the TMS bits, may be NULL
+**      rgbTdi      - receives the TDI bits, may be NULL
+**      cbit        - number of pairs
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Split TMS/TDI pairs into TMS and TDI with the fastest
+**      implementation supported by the processor. The bits past the
+**      last one in the last byte of each output are cleared.
+*/
+void
+JbDeinterleave( const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cbit ) {
+
+    JbDeinterleaveImpl(jbimplBest, rgbPairs, rgbTms, rgbTdi, cbit);
+}
+
+/* ------------------------------------------------------------ */
+/***    JbReverse
+**
+**  Parameters:
+**      rgbDst      - receives the reversed bytes
+**      rgbSrc      - bytes to reverse, may be rgbDst
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the order of the bits of each byte with the fastest
+**      implementation supported by the processor.
+*/
+void
+JbReverse( BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb ) {
+
+    JbReverseImpl(jbimplBest, rgbDst, rgbSrc, cb);
+}
+
+/* ------------------------------------------------------------ */
+/***    FJbMaskedEqual
+**
+**  Parameters:
+**      rgbA        - first vector
+**      rgbB        - second vector
+**      rgbMask     - bits that are compared, or NULL for all of them
+**      cbit        - length of the vectors in bits
+**
+**  Return Values:
+**      fTrue if the masked bits are equal, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare two vectors under a mask with the fastest implementation
+**      supported by the processor. The bits past cbit are ignored.
+*/
+BOOL
+FJbMaskedEqual( const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cbit ) {
+
+    return FJbMaskedEqualImpl(jbimplBest, rgbA, rgbB, rgbMask, cbit);
+}
+
+/* ------------------------------------------------------------ */
+/***    JbInterleaveImpl
+**
+**  Parameters:
+**      jbimpl      - implementation to use
+**      rgbTms      - TMS bits, or NULL for zeros
+**      rgbTdi      - TDI bits, or NULL for zeros
+**      rgbPairs    - receives the pairs, (2 * cbit + 7) / 8 bytes
+**      cbit        - number of pairs
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      An implementation that isn't supported by the processor is
+**      replaced by the best one that is.
+**
+**  Description:
+**      Same as JbInterleave but with an explicit choice of
+**      implementation. The whole bytes go through the kernel and the
+**      last partial byte of TMS and TDI is spread here.
+*/
+void
+JbInterleaveImpl( DWORD jbimpl, const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cbit ) {
+
+    DWORD   cb;
+    DWORD   cbitRem;
+    DWORD   msk;
+    UINT64  qw;
+
+    cb = cbit / 8;
+    cbitRem = cbit % 8;
+
+    PjbfnsGet(jbimpl)->pfnInterleave(rgbTms, rgbTdi, rgbPairs, cb);
+
+    if ( 0 != cbitRem ) {
+
+        msk = (1 << cbitRem) - 1;
+        qw = 0;
+
+        if ( NULL != rgbTdi ) {
+            qw |= QwSpread(rgbTdi[cb] & msk);
+        }
+        if ( NULL != rgbTms ) {
+            qw |= QwSpread(rgbTms[cb] & msk) << 1;
+        }
+
+        rgbPairs[2 * cb] = (BYTE)qw;
+        if ( 4 < cbitRem ) {
+            rgbPairs[2 * cb + 1] = (BYTE)(qw >> 8);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JbDeinterleaveImpl
+**
+**  Parameters:
+**      jbimpl      - implementation to use
+**      rgbPairs    - TMS/TDI pairs
+**      rgbTms      - receives the TMS bits, may be NULL
+**      rgbTdi      - receives the TDI bits, may be NULL
+**      cbit        - number of pairs
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      An implementation that isn't supported by the processor is
+**      replaced by the best one that is.
+**
+**  Description:
+**      Same as JbDeinterleave but with an explicit choice of
+**      implementation.
+*/
+void
+JbDeinterleaveImpl( DWORD jbimpl, const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cbit ) {
+
+    DWORD   cb;
+    DWORD   cbitRem;
+    DWORD   msk;
+    UINT64  qw;
+
+    cb = cbit / 8;
+    cbitRem = cbit % 8;
+
+    PjbfnsGet(jbimpl)->pfnDeinterleave(rgbPairs, rgbTms, rgbTdi, cb);
+
+    if ( 0 != cbitRem ) {
+
+        msk = (1 << cbitRem) - 1;
+        qw = rgbPairs[2 * cb];
+        if ( 4 < cbitRem ) {
+            qw |= (UINT64)rgbPairs[2 * cb + 1] << 8;
+        }
+
+        if ( NULL != rgbTdi ) {
+            rgbTdi[cb] = (BYTE)(DwCompact(qw) & msk);
+        }
+        if ( NULL != rgbTms ) {
+            rgbTms[cb] = (BYTE)(DwCompact(qw >> 1) & msk);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JbReverseImpl
+**
+**  Parameters:
+**      jbimpl      - implementation to use
+**      rgbDst      - receives the reversed bytes
+**      rgbSrc      - bytes to reverse, may be rgbDst
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      An implementation that isn't supported by the processor is
+**      replaced by the best one that is.
+**
+**  Description:
+**      Same as JbReverse but with an explicit choice of implementation.
+*/
+void
+JbReverseImpl( DWORD jbimpl, BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb ) {
+
+    PjbfnsGet(jbimpl)->pfnReverse(rgbDst, rgbSrc, cb);
+}
+
+/* ------------------------------------------------------------ */
+/***    FJbMaskedEqualImpl
+**
+**  Parameters:
+**      jbimpl      - implementation to use
+**      rgbA        - first vector
+**      rgbB        - second vector
+**      rgbMask     - bits that are compared, or NULL for all of them
+**      cbit        - length of the vectors in bits
+**
+**  Return Values:
+**      fTrue if the masked bits are equal, fFalse otherwise
+**
+**  Errors:
+**      An implementation that isn't supported by the processor is
+**      replaced by the best one that is.
+**
+**  Description:
+**      Same as FJbMaskedEqual but with an explicit choice of
+**      implementation.
+*/
+BOOL
+FJbMaskedEqualImpl( DWORD jbimpl, const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cbit ) {
+
+    DWORD   cb;
+    BYTE    msk;
+
+    cb = cbit / 8;
+
+    if ( ! PjbfnsGet(jbimpl)->pfnMaskedEqual(rgbA, rgbB, rgbMask, cb) ) {
+        return fFalse;
+    }
+
+    if ( 0 == cbit % 8 ) {
+        return fTrue;
+    }
+
+    msk = (BYTE)((1 << (cbit % 8)) - 1);
+    if ( NULL != rgbMask ) {
+        msk &= rgbMask[cb];
+    }
+
+    return ( 0 == ((rgbA[cb] ^ rgbB[cb]) & msk) );
+}
+
+/* ------------------------------------------------------------ */
+/***    FJbImplSupported
+**
+**  Parameters:
+**      jbimpl  - kernel implementation
+**
+**  Return Values:
+**      fTrue if the processor can run the implementation
+**
+**  Errors:
+**
+**  Description:
+**      Check whether a kernel implementation may be used.
+*/
+BOOL
+FJbImplSupported( DWORD jbimpl ) {
+
+    switch ( jbimpl ) {
+        case jbimplScalar:
+            return fTrue;
+
+#if defined(JB_X86)
+#if defined(__x86_64__)
+        case jbimplBmi2:
+            return __builtin_cpu_supports("bmi2") ? fTrue : fFalse;
+#endif
+        case jbimplSsse3:
+            return __builtin_cpu_supports("ssse3") ? fTrue : fFalse;
+
+        case jbimplAvx2:
+            return __builtin_cpu_supports("avx2") ? fTrue : fFalse;
+#endif
+        default:
+            return fFalse;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JbimplBest
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fastest kernel implementation supported by the processor
+**
+**  Errors:
+**
+**  Description:
+**      Determine the implementation used by the kernels when none is
+**      given. The result is computed once and cached.
+*/
+DWORD
+JbimplBest() {
+
+    if ( jbimplBest == jbimplCached ) {
+
+        if ( FJbImplSupported(jbimplAvx2) ) {
+            jbimplCached = jbimplAvx2;
+        }
+        else if ( FJbImplSupported(jbimplSsse3) ) {
+            jbimplCached = jbimplSsse3;
+        }
+        else {
+            jbimplCached = jbimplScalar;
+        }
+    }
+
+    return jbimplCached;
+}
+
+/* ------------------------------------------------------------ */
+/***    SzJbImpl
+**
+**  Parameters:
+**      jbimpl  - kernel implementation
+**
+**  Return Values:
+**      name of the implementation
+**
+**  Errors:
+**
+**  Description:
+**      Return a printable name for a kernel implementation.
+*/
+const char *
+SzJbImpl( DWORD jbimpl ) {
+
+    switch ( jbimpl ) {
+        case jbimplScalar:
+            return "scalar";
+        case jbimplBmi2:
+            return "BMI2";
+        case jbimplSsse3:
+            return "SSSE3";
+        case jbimplAvx2:
+            return "AVX2";
+        default:
+            return "best";
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    PjbfnsGet
+**
+**  Parameters:
+**      jbimpl  - kernel implementation
+**
+**  Return Values:
+**      kernels of the implementation
+**
+**  Errors:
+**
+**  Description:
+**      Look up the kernels of an implementation, using the best one
+**      when it isn't supported.
+*/
+static const JBFNS *
+PjbfnsGet( DWORD jbimpl ) {
+
+    if ( ! FJbImplSupported(jbimpl) ) {
+        jbimpl = JbimplBest();
+    }
+
+    switch ( jbimpl ) {
+#if defined(JB_X86)
+#if defined(__x86_64__)
+        case jbimplBmi2:
+            return &jbfnsBmi2;
+#endif
+        case jbimplSsse3:
+            return &jbfnsSsse3;
+
+        case jbimplAvx2:
+            return &jbfnsAvx2;
+#endif
+        default:
+            return &jbfnsScalar;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    QwSpread
+**
+**  Parameters:
+**      dw      - 32 bits to spread
+**
+**  Return Values:
+**      the bits of dw moved to the even bits of a 64 bit word
+**
+**  Errors:
+**
+**  Description:
+**      Move bit i of dw to bit 2 * i, halving the distance between the
+**      bits at each step.
+*/
+static UINT64
+QwSpread( DWORD dw ) {
+
+    UINT64  qw;
+
+    qw = dw;
+    qw = (qw | (qw << 16)) & 0x0000FFFF0000FFFFULL;
+    qw = (qw | (qw << 8)) & 0x00FF00FF00FF00FFULL;
+    qw = (qw | (qw << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    qw = (qw | (qw << 2)) & 0x3333333333333333ULL;
+    qw = (qw | (qw << 1)) & qwJbEven;
+
+    return qw;
+}
+
+/* ------------------------------------------------------------ */
+/***    DwCompact
+**
+**  Parameters:
+**      qw      - 64 bit word
+**
+**  Return Values:
+**      the even bits of qw, packed together
+**
+**  Errors:
+**
+**  Description:
+**      Move bit 2 * i of qw to bit i. This is the inverse of QwSpread.
+*/
+static DWORD
+DwCompact( UINT64 qw ) {
+
+    qw &= qwJbEven;
+    qw = (qw | (qw >> 1)) & 0x3333333333333333ULL;
+    qw = (qw | (qw >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    qw = (qw | (qw >> 4)) & 0x00FF00FF00FF00FFULL;
+    qw = (qw | (qw >> 8)) & 0x0000FFFF0000FFFFULL;
+    qw = (qw | (qw >> 16)) & 0x00000000FFFFFFFFULL;
+
+    return (DWORD)qw;
+}
+
+/* ------------------------------------------------------------ */
+/***    InterleaveScalar
+**
+**  Parameters:
+**      rgbTms      - TMS bytes, or NULL for zeros
+**      rgbTdi      - TDI bytes, or NULL for zeros
+**      rgbPairs    - receives 2 * cb bytes of pairs
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Build pairs four bytes at a time with QwSpread. The bytes are
+**      assembled explicitly so that the order of the bits doesn't
+**      depend on the byte order of the processor.
+*/
+static void
+InterleaveScalar( const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb ) {
+
+    DWORD   ib;
+    DWORD   cbStep;
+    DWORD   ibStep;
+    DWORD   dwTms;
+    DWORD   dwTdi;
+    UINT64  qw;
+
+    for ( ib = 0; ib < cb; ib += cbStep ) {
+
+        cbStep = ( 4 < cb - ib ) ? 4 : cb - ib;
+        dwTms = 0;
+        dwTdi = 0;
+
+        for ( ibStep = 0; ibStep < cbStep; ibStep++ ) {
+
+            if ( NULL != rgbTms ) {
+                dwTms |= (DWORD)rgbTms[ib + ibStep] << (8 * ibStep);
+            }
+            if ( NULL != rgbTdi ) {
+                dwTdi |= (DWORD)rgbTdi[ib + ibStep] << (8 * ibStep);
+            }
+        }
+
+        qw = QwSpread(dwTdi) | (QwSpread(dwTms) << 1);
+
+        for ( ibStep = 0; ibStep < 2 * cbStep; ibStep++ ) {
+            rgbPairs[2 * ib + ibStep] = (BYTE)(qw >> (8 * ibStep));
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    DeinterleaveScalar
+**
+**  Parameters:
+**      rgbPairs    - 2 * cb bytes of pairs
+**      rgbTms      - receives cb bytes of TMS, may be NULL
+**      rgbTdi      - receives cb bytes of TDI, may be NULL
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Split pairs eight bytes at a time with DwCompact.
+*/
+static void
+DeinterleaveScalar( const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb ) {
+
+    DWORD   ib;
+    DWORD   cbStep;
+    DWORD   ibStep;
+    DWORD   dwTms;
+    DWORD   dwTdi;
+    UINT64  qw;
+
+    for ( ib = 0; ib < cb; ib += cbStep ) {
+
+        cbStep = ( 4 < cb - ib ) ? 4 : cb - ib;
+        qw = 0;
+
+        for ( ibStep = 0; ibStep < 2 * cbStep; ibStep++ ) {
+            qw |= (UINT64)rgbPairs[2 * ib + ibStep] << (8 * ibStep);
+        }
+
+        dwTdi = DwCompact(qw);
+        dwTms = DwCompact(qw >> 1);
+
+        for ( ibStep = 0; ibStep < cbStep; ibStep++ ) {
+
+            if ( NULL != rgbTms ) {
+                rgbTms[ib + ibStep] = (BYTE)(dwTms >> (8 * ibStep));
+            }
+            if ( NULL != rgbTdi ) {
+                rgbTdi[ib + ibStep] = (BYTE)(dwTdi >> (8 * ibStep));
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    ReverseScalar
+**
+**  Parameters:
+**      rgbDst      - receives the reversed bytes
+**      rgbSrc      - bytes to reverse, may be rgbDst
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the bits of each byte eight bytes at a time by swapping
+**      the bits, then the pairs and then the nibbles of a 64 bit word.
+*/
+static void
+ReverseScalar( BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb ) {
+
+    UINT64  w;
+    BYTE    b;
+    DWORD   ib;
+
+    for ( ib = 0; ib + 8 <= cb; ib += 8 ) {
+
+        memcpy(&w, &rgbSrc[ib], 8);
+        w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+        w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+        w = ((w >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        memcpy(&rgbDst[ib], &w, 8);
+    }
+
+    for ( ; ib < cb; ib++ ) {
+
+        b = rgbSrc[ib];
+        b = ((b >> 1) & 0x55) | ((b & 0x55) << 1);
+        b = ((b >> 2) & 0x33) | ((b & 0x33) << 2);
+        rgbDst[ib] = (b >> 4) | (b << 4);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FMaskedEqualScalar
+**
+**  Parameters:
+**      rgbA        - first vector
+**      rgbB        - second vector
+**      rgbMask     - bits that are compared, or NULL for all of them
+**      cb          - length of the vectors in bytes
+**
+**  Return Values:
+**      fTrue if the masked bits are equal, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare two vectors under a mask, 64 bits at a time.
+*/
+static BOOL
+FMaskedEqualScalar( const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb ) {
+
+    UINT64  qwA;
+    UINT64  qwB;
+    UINT64  qwMask;
+    UINT64  qwDiff;
+    DWORD   ib;
+
+    qwDiff = 0;
+    qwMask = ~0ULL;
+
+    for ( ib = 0; ib + 8 <= cb; ib += 8 ) {
+
+        memcpy(&qwA, &rgbA[ib], 8);
+        memcpy(&qwB, &rgbB[ib], 8);
+        if ( NULL != rgbMask ) {
+            memcpy(&qwMask, &rgbMask[ib], 8);
+        }
+        qwDiff |= (qwA ^ qwB) & qwMask;
+    }
+
+    for ( ; ib < cb; ib++ ) {
+        qwDiff |= (rgbA[ib] ^ rgbB[ib]) & (( NULL != rgbMask ) ? rgbMask[ib] : 0xFF);
+    }
+
+    return 0 == qwDiff;
+}
+
+#if defined(JB_X86)
+
+#if defined(__x86_64__)
+
+/* ------------------------------------------------------------ */
+/***    InterleaveBmi2
+**
+**  Parameters:
+**      rgbTms      - TMS bytes, or NULL for zeros
+**      rgbTdi      - TDI bytes, or NULL for zeros
+**      rgbPairs    - receives 2 * cb bytes of pairs
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Build pairs eight bytes at a time: PDEP puts each half of the
+**      TDI and TMS words into the even and odd bits of a 64 bit word.
+*/
+__attribute__((target("bmi2")))
+static void
+InterleaveBmi2( const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb ) {
+
+    UINT64  qwTms;
+    UINT64  qwTdi;
+    UINT64  rgqw[2];
+    DWORD   ib;
+
+    qwTms = 0;
+    qwTdi = 0;
+
+    for ( ib = 0; ib + 8 <= cb; ib += 8 ) {
+
+        if ( NULL != rgbTms ) {
+            memcpy(&qwTms, &rgbTms[ib], 8);
+        }
+        if ( NULL != rgbTdi ) {
+            memcpy(&qwTdi, &rgbTdi[ib], 8);
+        }
+
+        rgqw[0] = _pdep_u64(qwTdi, qwJbEven) | _pdep_u64(qwTms, qwJbOdd);
+        rgqw[1] = _pdep_u64(qwTdi >> 32, qwJbEven) | _pdep_u64(qwTms >> 32, qwJbOdd);
+        memcpy(&rgbPairs[2 * ib], rgqw, 16);
+    }
+
+    InterleaveScalar(( NULL != rgbTms ) ? &rgbTms[ib] : NULL, ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL,
+                     &rgbPairs[2 * ib], cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeinterleaveBmi2
+**
+**  Parameters:
+**      rgbPairs    - 2 * cb bytes of pairs
+**      rgbTms      - receives cb bytes of TMS, may be NULL
+**      rgbTdi      - receives cb bytes of TDI, may be NULL
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Split pairs sixteen bytes at a time: PEXT gathers the even and
+**      odd bits of each 64 bit word.
+*/
+__attribute__((target("bmi2")))
+static void
+DeinterleaveBmi2( const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb ) {
+
+    UINT64  rgqw[2];
+    UINT64  qw;
+    DWORD   ib;
+
+    for ( ib = 0; ib + 8 <= cb; ib += 8 ) {
+
+        memcpy(rgqw, &rgbPairs[2 * ib], 16);
+
+        if ( NULL != rgbTdi ) {
+            qw = _pext_u64(rgqw[0], qwJbEven) | (_pext_u64(rgqw[1], qwJbEven) << 32);
+            memcpy(&rgbTdi[ib], &qw, 8);
+        }
+        if ( NULL != rgbTms ) {
+            qw = _pext_u64(rgqw[0], qwJbOdd) | (_pext_u64(rgqw[1], qwJbOdd) << 32);
+            memcpy(&rgbTms[ib], &qw, 8);
+        }
+    }
+
+    DeinterleaveScalar(&rgbPairs[2 * ib], ( NULL != rgbTms ) ? &rgbTms[ib] : NULL,
+                       ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL, cb - ib);
+}
+
+#endif
+
+/* ------------------------------------------------------------ */
+/***    InterleaveSsse3
+**
+**  Parameters:
+**      rgbTms      - TMS bytes, or NULL for zeros
+**      rgbTdi      - TDI bytes, or NULL for zeros
+**      rgbPairs    - receives 2 * cb bytes of pairs
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Build pairs sixteen input bytes at a time. Each nibble is spread
+**      to the even bits of a byte with a shuffle, TMS is shifted into
+**      the odd bits, and the low and high nibbles of each input byte
+**      are unpacked into two consecutive output bytes.
+*/
+__attribute__((target("ssse3")))
+static void
+InterleaveSsse3( const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb ) {
+
+    const __m128i   vSpread = _mm_setr_epi8(0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
+                                            0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55);
+    const __m128i   vNibble = _mm_set1_epi8(0x0F);
+    __m128i         vTms;
+    __m128i         vTdi;
+    __m128i         vLo;
+    __m128i         vHi;
+    DWORD           ib;
+
+    vTms = _mm_setzero_si128();
+    vTdi = _mm_setzero_si128();
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        if ( NULL != rgbTms ) {
+            vTms = _mm_loadu_si128((const __m128i *)&rgbTms[ib]);
+        }
+        if ( NULL != rgbTdi ) {
+            vTdi = _mm_loadu_si128((const __m128i *)&rgbTdi[ib]);
+        }
+
+        vLo = _mm_or_si128(_mm_shuffle_epi8(vSpread, _mm_and_si128(vTdi, vNibble)),
+                           _mm_slli_epi16(_mm_shuffle_epi8(vSpread, _mm_and_si128(vTms, vNibble)), 1));
+        vHi = _mm_or_si128(_mm_shuffle_epi8(vSpread, _mm_and_si128(_mm_srli_epi16(vTdi, 4), vNibble)),
+                           _mm_slli_epi16(_mm_shuffle_epi8(vSpread, _mm_and_si128(_mm_srli_epi16(vTms, 4), vNibble)), 1));
+
+        _mm_storeu_si128((__m128i *)&rgbPairs[2 * ib], _mm_unpacklo_epi8(vLo, vHi));
+        _mm_storeu_si128((__m128i *)&rgbPairs[2 * ib + 16], _mm_unpackhi_epi8(vLo, vHi));
+    }
+
+    InterleaveScalar(( NULL != rgbTms ) ? &rgbTms[ib] : NULL, ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL,
+                     &rgbPairs[2 * ib], cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeinterleaveSsse3
+**
+**  Parameters:
+**      rgbPairs    - 2 * cb bytes of pairs
+**      rgbTms      - receives cb bytes of TMS, may be NULL
+**      rgbTdi      - receives cb bytes of TDI, may be NULL
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Split pairs sixteen output bytes at a time. The even bits of
+**      each byte are compacted into its low nibble with shift and mask
+**      steps, the nibbles of two bytes are joined in a 16 bit lane, and
+**      the lanes are packed into bytes. The masks clear the bits that
+**      the 16 bit shifts carry over from the next byte.
+*/
+__attribute__((target("ssse3")))
+static void
+DeinterleaveSsse3( const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb ) {
+
+    const __m128i   v55 = _mm_set1_epi8(0x55);
+    const __m128i   v33 = _mm_set1_epi8(0x33);
+    const __m128i   v0F = _mm_set1_epi8(0x0F);
+    const __m128i   v00FF = _mm_set1_epi16(0x00FF);
+    __m128i         rgv[2];
+    __m128i         rgvOut[2];
+    __m128i         v;
+    DWORD           ib;
+    DWORD           iv;
+    DWORD           ifTms;
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        rgv[0] = _mm_loadu_si128((const __m128i *)&rgbPairs[2 * ib]);
+        rgv[1] = _mm_loadu_si128((const __m128i *)&rgbPairs[2 * ib + 16]);
+
+        for ( ifTms = 0; ifTms < 2; ifTms++ ) {
+
+            if ( NULL == (( 0 != ifTms ) ? rgbTms : rgbTdi) ) {
+                continue;
+            }
+
+            for ( iv = 0; iv < 2; iv++ ) {
+
+                v = ( 0 != ifTms ) ? _mm_srli_epi16(rgv[iv], 1) : rgv[iv];
+                v = _mm_and_si128(v, v55);
+                v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi16(v, 1)), v33);
+                v = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi16(v, 2)), v0F);
+                rgvOut[iv] = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi16(v, 4)), v00FF);
+            }
+
+            _mm_storeu_si128((__m128i *)&(( 0 != ifTms ) ? rgbTms : rgbTdi)[ib],
+                             _mm_packus_epi16(rgvOut[0], rgvOut[1]));
+        }
+    }
+
+    DeinterleaveScalar(&rgbPairs[2 * ib], ( NULL != rgbTms ) ? &rgbTms[ib] : NULL,
+                       ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL, cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    ReverseSsse3
+**
+**  Parameters:
+**      rgbDst      - receives the reversed bytes
+**      rgbSrc      - bytes to reverse, may be rgbDst
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the bits of sixteen bytes at a time by looking up the
+**      reversed low nibble, which becomes the high one, and the
+**      reversed high nibble, which becomes the low one.
+*/
+__attribute__((target("ssse3")))
+static void
+ReverseSsse3( BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb ) {
+
+    const __m128i   vRevLo = _mm_setr_epi8(0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
+                                           0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0);
+    const __m128i   vRevHi = _mm_setr_epi8(0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E,
+                                           0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F);
+    const __m128i   vNibble = _mm_set1_epi8(0x0F);
+    __m128i         v;
+    DWORD           ib;
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        v = _mm_loadu_si128((const __m128i *)&rgbSrc[ib]);
+        v = _mm_or_si128(_mm_shuffle_epi8(vRevLo, _mm_and_si128(v, vNibble)),
+                         _mm_shuffle_epi8(vRevHi, _mm_and_si128(_mm_srli_epi16(v, 4), vNibble)));
+        _mm_storeu_si128((__m128i *)&rgbDst[ib], v);
+    }
+
+    ReverseScalar(&rgbDst[ib], &rgbSrc[ib], cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    FMaskedEqualSsse3
+**
+**  Parameters:
+**      rgbA        - first vector
+**      rgbB        - second vector
+**      rgbMask     - bits that are compared, or NULL for all of them
+**      cb          - length of the vectors in bytes
+**
+**  Return Values:
+**      fTrue if the masked bits are equal, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare two vectors under a mask, 128 bits at a time.
+*/
+__attribute__((target("ssse3")))
+static BOOL
+FMaskedEqualSsse3( const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb ) {
+
+    __m128i vDiff;
+    __m128i vMask;
+    DWORD   ib;
+
+    vDiff = _mm_setzero_si128();
+    vMask = _mm_set1_epi8(-1);
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        if ( NULL != rgbMask ) {
+            vMask = _mm_loadu_si128((const __m128i *)&rgbMask[ib]);
+        }
+        vDiff = _mm_or_si128(vDiff, _mm_and_si128(vMask,
+                    _mm_xor_si128(_mm_loadu_si128((const __m128i *)&rgbA[ib]),
+                                  _mm_loadu_si128((const __m128i *)&rgbB[ib]))));
+    }
+
+    if ( 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(vDiff, _mm_setzero_si128())) ) {
+        return fFalse;
+    }
+
+    return FMaskedEqualScalar(&rgbA[ib], &rgbB[ib], ( NULL != rgbMask ) ? &rgbMask[ib] : NULL, cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    InterleaveAvx2
+**
+**  Parameters:
+**      rgbTms      - TMS bytes, or NULL for zeros
+**      rgbTdi      - TDI bytes, or NULL for zeros
+**      rgbPairs    - receives 2 * cb bytes of pairs
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Build pairs 32 input bytes at a time, as InterleaveSsse3. The
+**      unpacks work within each 128 bit lane, so the lanes are put back
+**      in order before they are stored.
+*/
+__attribute__((target("avx2")))
+static void
+InterleaveAvx2( const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cb ) {
+
+    const __m256i   vSpread = _mm256_setr_epi8(0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
+                                               0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55,
+                                               0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
+                                               0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55);
+    const __m256i   vNibble = _mm256_set1_epi8(0x0F);
+    __m256i         vTms;
+    __m256i         vTdi;
+    __m256i         vLo;
+    __m256i         vHi;
+    __m256i         vOut0;
+    __m256i         vOut1;
+    DWORD           ib;
+
+    vTms = _mm256_setzero_si256();
+    vTdi = _mm256_setzero_si256();
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        if ( NULL != rgbTms ) {
+            vTms = _mm256_loadu_si256((const __m256i *)&rgbTms[ib]);
+        }
+        if ( NULL != rgbTdi ) {
+            vTdi = _mm256_loadu_si256((const __m256i *)&rgbTdi[ib]);
+        }
+
+        vLo = _mm256_or_si256(_mm256_shuffle_epi8(vSpread, _mm256_and_si256(vTdi, vNibble)),
+                              _mm256_slli_epi16(_mm256_shuffle_epi8(vSpread, _mm256_and_si256(vTms, vNibble)), 1));
+        vHi = _mm256_or_si256(_mm256_shuffle_epi8(vSpread, _mm256_and_si256(_mm256_srli_epi16(vTdi, 4), vNibble)),
+                              _mm256_slli_epi16(_mm256_shuffle_epi8(vSpread, _mm256_and_si256(_mm256_srli_epi16(vTms, 4), vNibble)), 1));
+
+        vOut0 = _mm256_unpacklo_epi8(vLo, vHi);
+        vOut1 = _mm256_unpackhi_epi8(vLo, vHi);
+
+        _mm256_storeu_si256((__m256i *)&rgbPairs[2 * ib], _mm256_permute2x128_si256(vOut0, vOut1, 0x20));
+        _mm256_storeu_si256((__m256i *)&rgbPairs[2 * ib + 32], _mm256_permute2x128_si256(vOut0, vOut1, 0x31));
+    }
+
+    InterleaveSsse3(( NULL != rgbTms ) ? &rgbTms[ib] : NULL, ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL,
+                    &rgbPairs[2 * ib], cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    DeinterleaveAvx2
+**
+**  Parameters:
+**      rgbPairs    - 2 * cb bytes of pairs
+**      rgbTms      - receives cb bytes of TMS, may be NULL
+**      rgbTdi      - receives cb bytes of TDI, may be NULL
+**      cb          - number of TMS and TDI bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Split pairs 32 output bytes at a time, as DeinterleaveSsse3. The
+**      pack works within each 128 bit lane, so its 64 bit quarters are
+**      put back in order before the result is stored.
+*/
+__attribute__((target("avx2")))
+static void
+DeinterleaveAvx2( const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cb ) {
+
+    const __m256i   v55 = _mm256_set1_epi8(0x55);
+    const __m256i   v33 = _mm256_set1_epi8(0x33);
+    const __m256i   v0F = _mm256_set1_epi8(0x0F);
+    const __m256i   v00FF = _mm256_set1_epi16(0x00FF);
+    __m256i         rgv[2];
+    __m256i         rgvOut[2];
+    __m256i         v;
+    DWORD           ib;
+    DWORD           iv;
+    DWORD           ifTms;
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        rgv[0] = _mm256_loadu_si256((const __m256i *)&rgbPairs[2 * ib]);
+        rgv[1] = _mm256_loadu_si256((const __m256i *)&rgbPairs[2 * ib + 32]);
+
+        for ( ifTms = 0; ifTms < 2; ifTms++ ) {
+
+            if ( NULL == (( 0 != ifTms ) ? rgbTms : rgbTdi) ) {
+                continue;
+            }
+
+            for ( iv = 0; iv < 2; iv++ ) {
+
+                v = ( 0 != ifTms ) ? _mm256_srli_epi16(rgv[iv], 1) : rgv[iv];
+                v = _mm256_and_si256(v, v55);
+                v = _mm256_and_si256(_mm256_or_si256(v, _mm256_srli_epi16(v, 1)), v33);
+                v = _mm256_and_si256(_mm256_or_si256(v, _mm256_srli_epi16(v, 2)), v0F);
+                rgvOut[iv] = _mm256_and_si256(_mm256_or_si256(v, _mm256_srli_epi16(v, 4)), v00FF);
+            }
+
+            _mm256_storeu_si256((__m256i *)&(( 0 != ifTms ) ? rgbTms : rgbTdi)[ib],
+                                _mm256_permute4x64_epi64(_mm256_packus_epi16(rgvOut[0], rgvOut[1]), 0xD8));
+        }
+    }
+
+    DeinterleaveSsse3(&rgbPairs[2 * ib], ( NULL != rgbTms ) ? &rgbTms[ib] : NULL,
+                      ( NULL != rgbTdi ) ? &rgbTdi[ib] : NULL, cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    ReverseAvx2
+**
+**  Parameters:
+**      rgbDst      - receives the reversed bytes
+**      rgbSrc      - bytes to reverse, may be rgbDst
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the bits of 32 bytes at a time, as ReverseSsse3.
+*/
+__attribute__((target("avx2")))
+static void
+ReverseAvx2( BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb ) {
+
+    const __m256i   vRevLo = _mm256_setr_epi8(0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
+                                              0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+                                              0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
+                                              0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0);
+    const __m256i   vRevHi = _mm256_setr_epi8(0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E,
+                                              0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F,
+                                              0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E,
+                                              0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F);
+    const __m256i   vNibble = _mm256_set1_epi8(0x0F);
+    __m256i         v;
+    DWORD           ib;
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        v = _mm256_loadu_si256((const __m256i *)&rgbSrc[ib]);
+        v = _mm256_or_si256(_mm256_shuffle_epi8(vRevLo, _mm256_and_si256(v, vNibble)),
+                            _mm256_shuffle_epi8(vRevHi, _mm256_and_si256(_mm256_srli_epi16(v, 4), vNibble)));
+        _mm256_storeu_si256((__m256i *)&rgbDst[ib], v);
+    }
+
+    ReverseSsse3(&rgbDst[ib], &rgbSrc[ib], cb - ib);
+}
+
+/* ------------------------------------------------------------ */
+/***    FMaskedEqualAvx2
+**
+**  Parameters:
+**      rgbA        - first vector
+**      rgbB        - second vector
+**      rgbMask     - bits that are compared, or NULL for all of them
+**      cb          - length of the vectors in bytes
+**
+**  Return Values:
+**      fTrue if the masked bits are equal, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare two vectors under a mask, 256 bits at a time.
+*/
+__attribute__((target("avx2")))
+static BOOL
+FMaskedEqualAvx2( const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cb ) {
+
+    __m256i vDiff;
+    __m256i vMask;
+    DWORD   ib;
+
+    vDiff = _mm256_setzero_si256();
+    vMask = _mm256_set1_epi8(-1);
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        if ( NULL != rgbMask ) {
+            vMask = _mm256_loadu_si256((const __m256i *)&rgbMask[ib]);
+        }
+        vDiff = _mm256_or_si256(vDiff, _mm256_and_si256(vMask,
+                    _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&rgbA[ib]),
+                                     _mm256_loadu_si256((const __m256i *)&rgbB[ib]))));
+    }
+
+    if ( ! _mm256_testz_si256(vDiff, vDiff) ) {
+        return fFalse;
+    }
+
+    return FMaskedEqualSsse3(&rgbA[ib], &rgbB[ib], ( NULL != rgbMask ) ? &rgbMask[ib] : NULL, cb - ib);
+}
+
+#endif
+
+/************************************************************************/
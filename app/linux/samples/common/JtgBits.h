@@ -0,0 +1,63 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgBits.h  --    Interface Declarations for JtgBits.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the bit  */
+/*    vector kernels used by the JTAG modules: packing TMS and TDI into */
+/*    the pairs taken by DjtgPutTmsTdiBits and splitting them again,    */
+/*    reversing the bits of each byte, and comparing TDO with expected  */
+/*    values under a mask. Vectors are LSB first, as in the DJTG calls. */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGBITS_INCLUDED)
+#define      JTGBITS_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Kernel implementations. jbimplBest selects the fastest one that is
+** supported by the processor. jbimplBmi2 uses PDEP and PEXT for the
+** pairs and the scalar code for the other kernels; it is never chosen
+** as the best one because PDEP and PEXT are microcoded on some
+** processors.
+*/
+const DWORD jbimplScalar    = 0;
+const DWORD jbimplBmi2      = 1;
+const DWORD jbimplSsse3     = 2;
+const DWORD jbimplAvx2      = 3;
+const DWORD jbimplMax       = 4;
+const DWORD jbimplBest      = 0xFFFFFFFF;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+void    JbInterleave(const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cbit);
+void    JbDeinterleave(const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cbit);
+void    JbReverse(BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+BOOL    FJbMaskedEqual(const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cbit);
+
+void    JbInterleaveImpl(DWORD jbimpl, const BYTE * rgbTms, const BYTE * rgbTdi, BYTE * rgbPairs, DWORD cbit);
+void    JbDeinterleaveImpl(DWORD jbimpl, const BYTE * rgbPairs, BYTE * rgbTms, BYTE * rgbTdi, DWORD cbit);
+void    JbReverseImpl(DWORD jbimpl, BYTE * rgbDst, const BYTE * rgbSrc, DWORD cb);
+BOOL    FJbMaskedEqualImpl(DWORD jbimpl, const BYTE * rgbA, const BYTE * rgbB, const BYTE * rgbMask, DWORD cbit);
+
+BOOL    FJbImplSupported(DWORD jbimpl);
+DWORD   JbimplBest();
+const char * SzJbImpl(DWORD jbimpl);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGBITS_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,1310 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgBscan.cpp  --  Pin monitor using the boundary scan register      */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the pin monitor declared in JtgBscan.h.      */
+/*                                                                      */
+/*  Only the parts of a BSDL file that the monitor needs are parsed:    */
+/*  the entity name and the INSTRUCTION_LENGTH, INSTRUCTION_OPCODE,     */
+/*  BOUNDARY_LENGTH and BOUNDARY_REGISTER attributes. The string of an  */
+/*  attribute may be split into several literals joined with "&". A     */
+/*  pin is named after the port of the first input, clock, bidir or     */
+/*  observe_only cell that names it.                                    */
+/*                                                                      */
+/*  A frame shifts out the bypass bits between the device and TDO and   */
+/*  the boundary register; the bits between TDI and the device aren't   */
+/*  needed since the register is captured again anyway. A frame is      */
+/*  compared with the one before it under a mask of the watched pins    */
+/*  with FJbMaskedEqual, and only the words that differ are walked to   */
+/*  find the pins that changed.                                         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBits.h"
+#include "JtgTap.h"
+#include "JtgBscan.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Entry of the pin table for a bit of a frame that isn't a pin.
+*/
+const DWORD ipinBsNone      = 0xFFFFFFFF;
+
+/* Calls that make up a frame.
+*/
+const DWORD ccallBsFrame    = 2;
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static char *       SzBsReadFile(const char * szPath);
+static void         StripComments(char * sz);
+static BOOL         FIdentChar(char ch);
+static const char * PchFindWord(const char * sz, const char * szWord);
+static BOOL         FFindAttr(const char * szText, const char * szAttr,
+                              const char ** ppchVal, const char ** ppchEnd);
+static char *       SzJoinStrings(const char * pchVal, const char * pchEnd);
+static BOOL         FParseOpcode(const char * szOpcodes, const char * szInstr,
+                                 DWORD cbitIr, DWORD * pir);
+static const char * PchSkipSpace(const char * pch);
+static BOOL         FEqualNoCase(const char * sz1, const char * sz2);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgBscan::JtgBscan
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a monitor without a device description.
+*/
+JtgBscan::JtgBscan() : tap(fTrue) {
+
+    DWORD   iframe;
+
+    hif = hifInvalid;
+    memset(&chn, 0, sizeof(BSCHAIN));
+    szEntity[0] = '\0';
+    cbitIr = 0;
+    irSample = 0;
+    cbitBsr = 0;
+    rgpin = NULL;
+    cpin = 0;
+    rgipinBit = NULL;
+    rgbWatch = NULL;
+    rgbLast = NULL;
+    for ( iframe = 0; iframe < cbsFrameInFlight; iframe++ ) {
+        rgrgbFrame[iframe] = NULL;
+    }
+    cbitFrame = 0;
+    bTmsRecapture = 0;
+    cbitRecapture = 0;
+    iframeNext = 0;
+    cframePending = 0;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::~JtgBscan
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the pin table and the frame buffers. FEnd should have
+**      been called if the monitor was started.
+*/
+JtgBscan::~JtgBscan() {
+
+    FreeFrames();
+    free(rgpin);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FLoadBsdl
+**
+**  Parameters:
+**      szPath      - BSDL file of the device
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file can't be read, an attribute is missing or
+**      can't be parsed, or no cell observes a pin.
+**
+**  Description:
+**      Read the IR length, the SAMPLE opcode and the boundary register
+**      of a device from its BSDL file. Every pin found is watched.
+*/
+BOOL
+JtgBscan::FLoadBsdl( const char * szPath ) {
+
+    char *          szText;
+    char *          szStr;
+    const char *    pchVal;
+    const char *    pchEnd;
+    const char *    pch;
+    DWORD           cch;
+    BOOL            fOk;
+
+    szError[0] = '\0';
+    cbitBsr = 0;
+    cpin = 0;
+
+    szText = SzBsReadFile(szPath);
+    if ( NULL == szText ) {
+        return FFail("unable to read %s", szPath);
+    }
+
+    StripComments(szText);
+
+    fOk = fFalse;
+    szStr = NULL;
+
+    /* The entity name is only used in messages.
+    */
+    szEntity[0] = '\0';
+    pch = PchFindWord(szText, "entity");
+    if ( NULL != pch ) {
+
+        pch = PchSkipSpace(pch + 6);
+        for ( cch = 0; ( cch < cchBsPinMax ) && FIdentChar(pch[cch]); cch++ ) {
+            szEntity[cch] = pch[cch];
+        }
+        szEntity[cch] = '\0';
+    }
+
+    if ( ! FFindAttr(szText, "INSTRUCTION_LENGTH", &pchVal, &pchEnd) ) {
+        FFail("no INSTRUCTION_LENGTH in %s", szPath);
+        goto lExit;
+    }
+
+    cbitIr = strtoul(PchSkipSpace(pchVal), NULL, 10);
+    if (( 2 > cbitIr ) || ( cbitBsIrMax < cbitIr )) {
+        FFail("unsupported instruction length %u", cbitIr);
+        goto lExit;
+    }
+
+    if ( ! FFindAttr(szText, "INSTRUCTION_OPCODE", &pchVal, &pchEnd) ) {
+        FFail("no INSTRUCTION_OPCODE in %s", szPath);
+        goto lExit;
+    }
+
+    szStr = SzJoinStrings(pchVal, pchEnd);
+    if ( NULL == szStr ) {
+        FFail("out of memory");
+        goto lExit;
+    }
+
+    if (( ! FParseOpcode(szStr, "SAMPLE", cbitIr, &irSample) ) &&
+        ( ! FParseOpcode(szStr, "SAMPLE/PRELOAD", cbitIr, &irSample) )) {
+        FFail("no SAMPLE opcode of %u bits in %s", cbitIr, szPath);
+        goto lExit;
+    }
+
+    free(szStr);
+    szStr = NULL;
+
+    if ( ! FFindAttr(szText, "BOUNDARY_LENGTH", &pchVal, &pchEnd) ) {
+        FFail("no BOUNDARY_LENGTH in %s", szPath);
+        goto lExit;
+    }
+
+    cbitBsr = strtoul(PchSkipSpace(pchVal), NULL, 10);
+    if (( 0 == cbitBsr ) || ( cbitBsrMax < cbitBsr )) {
+        FFail("unsupported boundary length %u", cbitBsr);
+        cbitBsr = 0;
+        goto lExit;
+    }
+
+    if ( ! FFindAttr(szText, "BOUNDARY_REGISTER", &pchVal, &pchEnd) ) {
+        FFail("no BOUNDARY_REGISTER in %s", szPath);
+        cbitBsr = 0;
+        goto lExit;
+    }
+
+    szStr = SzJoinStrings(pchVal, pchEnd);
+    if ( NULL == szStr ) {
+        FFail("out of memory");
+        cbitBsr = 0;
+        goto lExit;
+    }
+
+    if ( ! FParseBoundary(szStr) ) {
+        cbitBsr = 0;
+        cpin = 0;
+        goto lExit;
+    }
+
+    fOk = fTrue;
+
+lExit:
+
+    free(szStr);
+    free(szText);
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FWatch
+**
+**  Parameters:
+**      szPins      - port names separated by commas, or NULL for all
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a name isn't a pin of the device. The pins watched are
+**      left unchanged.
+**
+**  Description:
+**      Choose the pins that FPoll reports. Names are compared without
+**      regard to case, as in VHDL. This takes effect at the next FInit.
+*/
+BOOL
+JtgBscan::FWatch( const char * szPins ) {
+
+    char            szName[cchBsPinMax + 1];
+    const char *    pch;
+    DWORD           cch;
+    DWORD           ipin;
+    DWORD           ipass;
+
+    szError[0] = '\0';
+
+    if (( NULL == szPins ) || ( '\0' == szPins[0] )) {
+
+        for ( ipin = 0; ipin < cpin; ipin++ ) {
+            rgpin[ipin].fWatch = fTrue;
+        }
+        return fTrue;
+    }
+
+    /* The list is checked on the first pass and applied on the second.
+    */
+    for ( ipass = 0; ipass < 2; ipass++ ) {
+
+        if ( 1 == ipass ) {
+            for ( ipin = 0; ipin < cpin; ipin++ ) {
+                rgpin[ipin].fWatch = fFalse;
+            }
+        }
+
+        for ( pch = szPins; '\0' != *pch; ) {
+
+            pch = PchSkipSpace(pch);
+            for ( cch = 0; ( '\0' != *pch ) && ( ',' != *pch ) && ( ! isspace((unsigned char)*pch) ); pch++ ) {
+                if ( cch < cchBsPinMax ) {
+                    szName[cch++] = *pch;
+                }
+            }
+            szName[cch] = '\0';
+
+            pch = PchSkipSpace(pch);
+            if ( ',' == *pch ) {
+                pch++;
+            }
+
+            if ( 0 == cch ) {
+                continue;
+            }
+
+            for ( ipin = 0; ipin < cpin; ipin++ ) {
+                if ( FEqualNoCase(szName, rgpin[ipin].szName) ) {
+                    break;
+                }
+            }
+
+            if ( cpin == ipin ) {
+                return FFail("no pin named %s", szName);
+            }
+
+            rgpin[ipin].fWatch = fTrue;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FInit
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**      pchnReq     - position of the device in the scan chain
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no BSDL file was loaded, the chain is too long, memory
+**      can't be allocated, a DJTG call fails or the device isn't found
+**      at the given position.
+**
+**  Description:
+**      Reset the chain, load SAMPLE into the device and BYPASS into the
+**      others, and go to Shift-DR, which captures the pins for the
+**      first frame. The TMS bits that capture the pins again at the end
+**      of each frame are taken from the TAP path tables.
+*/
+BOOL
+JtgBscan::FInit( HIF hifReq, const BSCHAIN * pchnReq ) {
+
+    BYTE    rgbIr[cbitBsChainIrMax / 8];
+    BYTE *  rgbSeqTdo;
+    DWORD   cbitIrChain;
+    DWORD   cbFrame;
+    DWORD   ibitIr;
+    DWORD   ibit;
+    DWORD   ipin;
+    DWORD   iframe;
+    DWORD   bCapture;
+
+    hif = hifReq;
+    chn = *pchnReq;
+    szError[0] = '\0';
+
+    if ( 0 == cbitBsr ) {
+        return FFail("no BSDL file loaded");
+    }
+
+    cbitIrChain = chn.cbitHir + cbitIr + chn.cbitTir;
+    if ( cbitBsChainIrMax < cbitIrChain ) {
+        return FFail("unsupported IR lengths");
+    }
+
+    /* Frames are kept in whole 64 bit words, with the padding left at
+    ** zero and unwatched, so that they can be compared a word at a time.
+    */
+    FreeFrames();
+
+    cbitFrame = chn.cbitHdr + cbitBsr;
+    cbFrame = 8 * ((cbitFrame + 63) / 64);
+
+    rgipinBit = (DWORD *)malloc(cbitFrame * sizeof(DWORD));
+    rgbWatch = (BYTE *)calloc(cbFrame, 1);
+    rgbLast = (BYTE *)calloc(cbFrame, 1);
+    if (( NULL == rgipinBit ) || ( NULL == rgbWatch ) || ( NULL == rgbLast )) {
+        return FFail("out of memory");
+    }
+
+    for ( iframe = 0; iframe < cbsFrameInFlight; iframe++ ) {
+
+        rgrgbFrame[iframe] = (BYTE *)calloc(cbFrame, 1);
+        if ( NULL == rgrgbFrame[iframe] ) {
+            return FFail("out of memory");
+        }
+    }
+
+    for ( ibit = 0; ibit < cbitFrame; ibit++ ) {
+        rgipinBit[ibit] = ipinBsNone;
+    }
+
+    for ( ipin = 0; ipin < cpin; ipin++ ) {
+
+        ibit = chn.cbitHdr + rgpin[ipin].icell;
+        rgipinBit[ibit] = ipin;
+        if ( rgpin[ipin].fWatch ) {
+            rgbWatch[ibit / 8] |= 1 << (ibit % 8);
+        }
+    }
+
+    bTmsRecapture = BTapPath(tpsShDR, tpsUpdDR) |
+                    (BTapPath(tpsUpdDR, tpsShDR) << CbitTapPath(tpsShDR, tpsUpdDR));
+    cbitRecapture = CbitTapPath(tpsShDR, tpsUpdDR) + CbitTapPath(tpsUpdDR, tpsShDR);
+
+    /* Load SAMPLE, with ones for BYPASS in the other devices.
+    */
+    memset(rgbIr, 0xFF, sizeof(rgbIr));
+    for ( ibit = 0; ibit < cbitIr; ibit++ ) {
+
+        ibitIr = chn.cbitHir + ibit;
+        if ( 0 == ((irSample >> ibit) & 1) ) {
+            rgbIr[ibitIr / 8] &= ~(1 << (ibitIr % 8));
+        }
+    }
+
+    tap.Clear();
+
+    if (( ! tap.FReset() ) || ( ! tap.FMoveTo(tpsShIR) )) {
+        return FFail("out of memory");
+    }
+
+    ibitIr = tap.CbitSeq();
+
+    if (( ! tap.FShift(rgbIr, cbitIrChain, fTrue) ) || ( ! tap.FMoveTo(tpsShDR) )) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    rgbSeqTdo = (BYTE *)calloc((tap.CbitSeq() + 7) / 8, 1);
+    if ( NULL == rgbSeqTdo ) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    if ( ! tap.FFlush(hif, fFalse, rgbSeqTdo) ) {
+        free(rgbSeqTdo);
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    ibit = ibitIr + chn.cbitHir;
+    bCapture = ((rgbSeqTdo[ibit / 8] >> (ibit % 8)) & 1) |
+               (((rgbSeqTdo[(ibit + 1) / 8] >> ((ibit + 1) % 8)) & 1) << 1);
+
+    free(rgbSeqTdo);
+
+    if ( 0x01 != bCapture ) {
+        return FFail("no IR capture value at the position given");
+    }
+
+    iframeNext = 0;
+    cframePending = 0;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FPoll
+**
+**  Parameters:
+**      rgevt       - receives the changes, room for Cpin() of them
+**      pcevt       - receives the number of changes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if FInit hasn't succeeded or a call fails. The frames in
+**      flight are then cancelled.
+**
+**  Description:
+**      Wait for the oldest frame in flight and report the watched pins
+**      whose value differs from the previous frame. Every watched pin
+**      is reported for the first frame. The frames in flight are topped
+**      up before returning, so the port keeps shifting while the caller
+**      handles the changes.
+*/
+BOOL
+JtgBscan::FPoll( BSEVT * rgevt, DWORD * pcevt ) {
+
+    BYTE *  pbFrame;
+    UINT64  qwNew;
+    UINT64  qwLast;
+    UINT64  qwWatch;
+    UINT64  qwDiff;
+    DWORD   cqw;
+    DWORD   iqw;
+    DWORD   ibit;
+    DWORD   ipin;
+    double  sec;
+
+    *pcevt = 0;
+    szError[0] = '\0';
+
+    if (( NULL == rgbLast ) || ( tpsShDR != tap.Tps() )) {
+        return FFail("the monitor isn't started");
+    }
+
+    while ( cframePending < cbsFrameInFlight ) {
+        if ( ! FQueueFrame(iframeNext + cframePending) ) {
+            return fFalse;
+        }
+    }
+
+    if ( ! FCompleteFrame() ) {
+        return fFalse;
+    }
+
+    sec = SecNow();
+    pbFrame = rgrgbFrame[iframeNext % cbsFrameInFlight];
+
+    if ( 0 == iframeNext ) {
+
+        for ( ipin = 0; ipin < cpin; ipin++ ) {
+
+            if ( rgpin[ipin].fWatch ) {
+
+                ibit = chn.cbitHdr + rgpin[ipin].icell;
+                rgevt[*pcevt].ipin = ipin;
+                rgevt[*pcevt].fValue = ( pbFrame[ibit / 8] >> (ibit % 8) ) & 1;
+                rgevt[*pcevt].iframe = iframeNext;
+                rgevt[*pcevt].sec = sec;
+                (*pcevt)++;
+            }
+        }
+    }
+    else if ( ! FJbMaskedEqual(pbFrame, rgbLast, rgbWatch, cbitFrame) ) {
+
+        cqw = (cbitFrame + 63) / 64;
+
+        for ( iqw = 0; iqw < cqw; iqw++ ) {
+
+            memcpy(&qwNew, &pbFrame[8 * iqw], 8);
+            memcpy(&qwLast, &rgbLast[8 * iqw], 8);
+            memcpy(&qwWatch, &rgbWatch[8 * iqw], 8);
+
+            for ( qwDiff = (qwNew ^ qwLast) & qwWatch; 0 != qwDiff; qwDiff &= qwDiff - 1 ) {
+
+                ibit = __builtin_ctzll(qwDiff);
+                ipin = rgipinBit[64 * iqw + ibit];
+
+                rgevt[*pcevt].ipin = ipin;
+                rgevt[*pcevt].fValue = ( qwNew >> ibit ) & 1;
+                rgevt[*pcevt].iframe = iframeNext;
+                rgevt[*pcevt].sec = sec;
+                (*pcevt)++;
+            }
+        }
+    }
+
+    /* The completed frame becomes the previous one, and the buffer of
+    ** the previous one takes the next frame.
+    */
+    rgrgbFrame[iframeNext % cbsFrameInFlight] = rgbLast;
+    rgbLast = pbFrame;
+    iframeNext++;
+
+    while ( cframePending < cbsFrameInFlight ) {
+        if ( ! FQueueFrame(iframeNext + cframePending) ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FEnd
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a frame in flight or the last move fails.
+**
+**  Description:
+**      Wait for the frames in flight and leave Shift-DR for Run-Test/
+**      Idle, so that the port can be used for other scans. SAMPLE is
+**      left in the IR, which doesn't affect the device.
+*/
+BOOL
+JtgBscan::FEnd() {
+
+    while ( 0 < cframePending ) {
+        if ( ! FCompleteFrame() ) {
+            break;
+        }
+    }
+
+    if (( tpsShDR == tap.Tps() ) && ( ! tap.FMoveTo(tpsRTI) )) {
+        return FFail("out of memory");
+    }
+
+    if ( ! tap.FFlush(hif, fFalse) ) {
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    return ( '\0' == szError[0] );
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FParseBoundary
+**
+**  Parameters:
+**      szCells     - string of the BOUNDARY_REGISTER attribute
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if an entry can't be parsed, a cell is past the end of the
+**      register or no cell observes a pin.
+**
+**  Description:
+**      Build the pin table from the cells of the boundary register.
+**      Each entry is "num (cell, port, function, safe [, ccell, disval,
+**      rslt])", and a port may carry an index in parentheses.
+*/
+BOOL
+JtgBscan::FParseBoundary( const char * szCells ) {
+
+    char            rgszField[3][cchBsPinMax + 1];
+    const char *    pch;
+    const char *    pchStart;
+    DWORD           icell;
+    DWORD           ifield;
+    DWORD           cch;
+    DWORD           ipin;
+    DWORD           cdepth;
+
+    free(rgpin);
+    rgpin = (BSPIN *)malloc(cbitBsr * sizeof(BSPIN));
+    cpin = 0;
+
+    if ( NULL == rgpin ) {
+        return FFail("out of memory");
+    }
+
+    pch = szCells;
+
+    for ( ;; ) {
+
+        while (( ',' == *pch ) || isspace((unsigned char)*pch) ) {
+            pch++;
+        }
+
+        if ( '\0' == *pch ) {
+            break;
+        }
+
+        pchStart = pch;
+
+        if ( ! isdigit((unsigned char)*pch) ) {
+            return FFail("bad boundary register entry near \"%.24s\"", pchStart);
+        }
+
+        icell = strtoul(pch, (char **)&pch, 10);
+        pch = PchSkipSpace(pch);
+
+        if ( '(' != *pch ) {
+            return FFail("bad boundary register entry near \"%.24s\"", pchStart);
+        }
+
+        /* Split the fields at the commas outside of any index, keeping
+        ** the first three.
+        */
+        pch++;
+        ifield = 0;
+        cch = 0;
+        cdepth = 1;
+        memset(rgszField, 0, sizeof(rgszField));
+
+        for ( ; ( '\0' != *pch ) && ( 0 < cdepth ); pch++ ) {
+
+            if ( '(' == *pch ) {
+                cdepth++;
+            }
+            else if ( ')' == *pch ) {
+                cdepth--;
+            }
+
+            if (( 0 == cdepth ) || (( 1 == cdepth ) && ( ',' == *pch ))) {
+                ifield++;
+                cch = 0;
+            }
+            else if (( ifield < 3 ) && ( cch < cchBsPinMax ) && ( ! isspace((unsigned char)*pch) )) {
+                rgszField[ifield][cch++] = *pch;
+            }
+        }
+
+        if (( 0 < cdepth ) || ( 4 > ifield )) {
+            return FFail("bad boundary register entry near \"%.24s\"", pchStart);
+        }
+
+        if ( cbitBsr <= icell ) {
+            return FFail("cell %u is past the end of the boundary register", icell);
+        }
+
+        if (( 0 == strcmp(rgszField[1], "*") ) ||
+            (( ! FEqualNoCase(rgszField[2], "input") ) && ( ! FEqualNoCase(rgszField[2], "clock") ) &&
+             ( ! FEqualNoCase(rgszField[2], "bidir") ) && ( ! FEqualNoCase(rgszField[2], "observe_only") ))) {
+            continue;
+        }
+
+        for ( ipin = 0; ipin < cpin; ipin++ ) {
+            if ( FEqualNoCase(rgpin[ipin].szName, rgszField[1]) ) {
+                break;
+            }
+        }
+
+        if (( ipin == cpin ) && ( cpin < cbitBsr )) {
+
+            strcpy(rgpin[cpin].szName, rgszField[1]);
+            rgpin[cpin].icell = icell;
+            rgpin[cpin].fWatch = fTrue;
+            cpin++;
+        }
+    }
+
+    if ( 0 == cpin ) {
+        return FFail("no boundary cell observes a pin");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FQueueFrame
+**
+**  Parameters:
+**      iframe      - number of the frame
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call can't be started. The frames in flight are
+**      cancelled.
+**
+**  Description:
+**      Start the calls of a frame: shift the captured bits out with TMS
+**      and TDI low, then capture the pins again and return to Shift-DR.
+*/
+BOOL
+JtgBscan::FQueueFrame( DWORD iframe ) {
+
+    if ( ! DjtgGetTdoBits(hif, fFalse, fFalse, rgrgbFrame[iframe % cbsFrameInFlight], cbitFrame, fTrue) ) {
+        CancelFrames();
+        return FFail("DjtgGetTdoBits failed");
+    }
+
+    if ( ! DjtgPutTmsBits(hif, fFalse, &bTmsRecapture, NULL, cbitRecapture, fTrue) ) {
+        CancelFrames();
+        return FFail("DjtgPutTmsBits failed");
+    }
+
+    cframePending++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FCompleteFrame
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call doesn't complete. The other frames are
+**      cancelled.
+**
+**  Description:
+**      Wait for the calls of the oldest frame in flight.
+*/
+BOOL
+JtgBscan::FCompleteFrame() {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+    DWORD   icall;
+
+    for ( icall = 0; icall < ccallBsFrame; icall++ ) {
+
+        if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsBsCallWait) ) {
+            CancelFrames();
+            return FFail("an overlapped call didn't complete");
+        }
+    }
+
+    cframePending--;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::CancelFrames
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Cancel the frames in flight. The state of the TAP controller is
+**      then unknown, so the model is reset and FEnd sends the reset.
+*/
+void
+JtgBscan::CancelFrames() {
+
+    if ( 0 < cframePending ) {
+
+        DmgrCancelTrans(hif);
+        cframePending = 0;
+    }
+
+    tap.Clear();
+    tap.FReset();
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FreeFrames
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the frame buffers and the tables built by FInit.
+*/
+void
+JtgBscan::FreeFrames() {
+
+    DWORD   iframe;
+
+    free(rgipinBit);
+    free(rgbWatch);
+    free(rgbLast);
+    rgipinBit = NULL;
+    rgbWatch = NULL;
+    rgbLast = NULL;
+
+    for ( iframe = 0; iframe < cbsFrameInFlight; iframe++ ) {
+
+        free(rgrgbFrame[iframe]);
+        rgrgbFrame[iframe] = NULL;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgBscan::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message. The first message is kept.
+*/
+BOOL
+JtgBscan::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    va_start(ap, szFmt);
+    vsnprintf(szError, sizeof(szError), szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SzBsReadFile
+**
+**  Parameters:
+**      szPath      - file to read
+**
+**  Return Values:
+**      contents of the file followed by a null, or NULL on failure
+**
+**  Errors:
+**
+**  Description:
+**      Read a whole text file into a buffer that the caller frees.
+*/
+static char *
+SzBsReadFile( const char * szPath ) {
+
+    FILE *  pf;
+    char *  sz;
+    long    cb;
+
+    pf = fopen(szPath, "rb");
+    if ( NULL == pf ) {
+        return NULL;
+    }
+
+    sz = NULL;
+
+    if (( 0 == fseek(pf, 0, SEEK_END) ) && ( 0 <= (cb = ftell(pf)) ) &&
+        ( 0 == fseek(pf, 0, SEEK_SET) )) {
+
+        sz = (char *)malloc(cb + 1);
+        if (( NULL != sz ) && ( (size_t)cb != fread(sz, 1, cb, pf) )) {
+            free(sz);
+            sz = NULL;
+        }
+        if ( NULL != sz ) {
+            sz[cb] = '\0';
+        }
+    }
+
+    fclose(pf);
+
+    return sz;
+}
+
+/* ------------------------------------------------------------ */
+/***    StripComments
+**
+**  Parameters:
+**      sz          - text of a BSDL file
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Blank out the VHDL comments, from "--" outside of a string to
+**      the end of the line.
+*/
+static void
+StripComments( char * sz ) {
+
+    BOOL    fString;
+
+    fString = fFalse;
+
+    for ( ; '\0' != *sz; sz++ ) {
+
+        if ( '"' == *sz ) {
+            fString = ! fString;
+        }
+        else if ( '\n' == *sz ) {
+            fString = fFalse;
+        }
+        else if (( ! fString ) && ( '-' == sz[0] ) && ( '-' == sz[1] )) {
+            for ( ; ( '\0' != *sz ) && ( '\n' != *sz ); sz++ ) {
+                *sz = ' ';
+            }
+            if ( '\0' == *sz ) {
+                break;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FIdentChar
+**
+**  Parameters:
+**      ch          - character
+**
+**  Return Values:
+**      fTrue if the character may be part of a VHDL identifier
+**
+**  Errors:
+**
+**  Description:
+**      Check for a letter, a digit or an underscore.
+*/
+static BOOL
+FIdentChar( char ch ) {
+
+    return isalnum((unsigned char)ch) || ( '_' == ch );
+}
+
+/* ------------------------------------------------------------ */
+/***    PchFindWord
+**
+**  Parameters:
+**      sz          - text to search
+**      szWord      - identifier to find
+**
+**  Return Values:
+**      first occurrence of the identifier, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Find an identifier as a whole word, without regard to case.
+*/
+static const char *
+PchFindWord( const char * sz, const char * szWord ) {
+
+    const char *    pch;
+    DWORD           cch;
+    DWORD           ich;
+
+    cch = strlen(szWord);
+
+    for ( pch = sz; '\0' != *pch; pch++ ) {
+
+        if (( pch != sz ) && FIdentChar(pch[-1]) ) {
+            continue;
+        }
+
+        for ( ich = 0; ich < cch; ich++ ) {
+            if ( tolower((unsigned char)pch[ich]) != tolower((unsigned char)szWord[ich]) ) {
+                break;
+            }
+        }
+
+        if (( cch == ich ) && ( ! FIdentChar(pch[cch]) )) {
+            return pch;
+        }
+    }
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    FFindAttr
+**
+**  Parameters:
+**      szText      - text of a BSDL file, without comments
+**      szAttr      - name of the attribute
+**      ppchVal     - receives the start of the value, after "is"
+**      ppchEnd     - receives the end of the value, at the ";"
+**
+**  Return Values:
+**      fTrue if the attribute is specified, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Find the specification "attribute NAME of ENTITY : entity is
+**      VALUE;" of an attribute. Declarations of the attribute, which
+**      have no "is", are skipped.
+*/
+static BOOL
+FFindAttr( const char * szText, const char * szAttr, const char ** ppchVal,
+           const char ** ppchEnd ) {
+
+    const char *    pch;
+    const char *    pchName;
+    const char *    pchIs;
+    const char *    pchEnd;
+
+    for ( pch = szText; NULL != (pch = PchFindWord(pch, "attribute")); ) {
+
+        pch += 9;
+        pchName = PchSkipSpace(pch);
+
+        if ( pchName != PchFindWord(pchName, szAttr) ) {
+            continue;
+        }
+
+        pchEnd = strchr(pchName, ';');
+        pchIs = PchFindWord(pchName, "is");
+
+        if (( NULL != pchEnd ) && ( NULL != pchIs ) && ( pchIs < pchEnd )) {
+
+            *ppchVal = pchIs + 2;
+            *ppchEnd = pchEnd;
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SzJoinStrings
+**
+**  Parameters:
+**      pchVal      - start of the value of an attribute
+**      pchEnd      - end of the value
+**
+**  Return Values:
+**      the string, or NULL if memory can't be allocated
+**
+**  Errors:
+**
+**  Description:
+**      Join the string literals of an attribute value, dropping the
+**      quotes, the "&" between them and the line breaks. The caller
+**      frees the result.
+*/
+static char *
+SzJoinStrings( const char * pchVal, const char * pchEnd ) {
+
+    char *          sz;
+    char *          pchDst;
+    const char *    pch;
+    BOOL            fString;
+
+    sz = (char *)malloc(pchEnd - pchVal + 1);
+    if ( NULL == sz ) {
+        return NULL;
+    }
+
+    pchDst = sz;
+    fString = fFalse;
+
+    for ( pch = pchVal; pch < pchEnd; pch++ ) {
+
+        if ( '"' == *pch ) {
+            fString = ! fString;
+        }
+        else if ( fString ) {
+            *pchDst++ = *pch;
+        }
+    }
+
+    *pchDst = '\0';
+
+    return sz;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseOpcode
+**
+**  Parameters:
+**      szOpcodes   - string of the INSTRUCTION_OPCODE attribute
+**      szInstr     - name of the instruction
+**      cbitIr      - IR length
+**      pir         - receives the opcode
+**
+**  Return Values:
+**      fTrue if the instruction has an opcode of cbitIr bits
+**
+**  Errors:
+**
+**  Description:
+**      Find the first opcode of an instruction. The entries are "NAME
+**      (opcode, opcode, ...)" with each opcode written MSB first; an X
+**      is taken as 0.
+*/
+static BOOL
+FParseOpcode( const char * szOpcodes, const char * szInstr, DWORD cbitIr, DWORD * pir ) {
+
+    const char *    pch;
+    DWORD           cch;
+    DWORD           cbit;
+    DWORD           ir;
+
+    cch = strlen(szInstr);
+
+    for ( pch = szOpcodes; '\0' != *pch; ) {
+
+        pch = PchSkipSpace(pch);
+
+        /* Compare the name up to the opening parenthesis.
+        */
+        for ( cbit = 0; cbit < cch; cbit++ ) {
+            if ( tolower((unsigned char)pch[cbit]) != tolower((unsigned char)szInstr[cbit]) ) {
+                break;
+            }
+        }
+
+        if (( cch == cbit ) && ( '(' == *PchSkipSpace(&pch[cch]) )) {
+
+            pch = PchSkipSpace(PchSkipSpace(&pch[cch]) + 1);
+            ir = 0;
+
+            for ( cbit = 0; ( '0' == *pch ) || ( '1' == *pch ) || ( 'X' == toupper((unsigned char)*pch) ); pch++, cbit++ ) {
+                ir = (ir << 1) | ( '1' == *pch );
+            }
+
+            if ( cbitIr != cbit ) {
+                return fFalse;
+            }
+
+            *pir = ir;
+            return fTrue;
+        }
+
+        /* Skip to the next entry.
+        */
+        pch = strchr(pch, ')');
+        if ( NULL == pch ) {
+            break;
+        }
+
+        pch = PchSkipSpace(pch + 1);
+        if ( ',' == *pch ) {
+            pch++;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    PchSkipSpace
+**
+**  Parameters:
+**      pch         - position in a string
+**
+**  Return Values:
+**      first character that isn't white space
+**
+**  Errors:
+**
+**  Description:
+**      Skip white space.
+*/
+static const char *
+PchSkipSpace( const char * pch ) {
+
+    while ( isspace((unsigned char)*pch) ) {
+        pch++;
+    }
+
+    return pch;
+}
+
+/* ------------------------------------------------------------ */
+/***    FEqualNoCase
+**
+**  Parameters:
+**      sz1         - first string
+**      sz2         - second string
+**
+**  Return Values:
+**      fTrue if the strings are equal without regard to case
+**
+**  Errors:
+**
+**  Description:
+**      Compare two names as VHDL does.
+*/
+static BOOL
+FEqualNoCase( const char * sz1, const char * sz2 ) {
+
+    for ( ; '\0' != *sz1; sz1++, sz2++ ) {
+        if ( tolower((unsigned char)*sz1) != tolower((unsigned char)*sz2) ) {
+            return fFalse;
+        }
+    }
+
+    return ( '\0' == *sz2 );
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,147 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgBscan.h  --    Interface Declarations for JtgBscan.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a pin    */
+/*    monitor that watches the pins of a device through its boundary    */
+/*    scan register, without any logic in the device.                   */
+/*                                                                      */
+/*    The monitor reads the SAMPLE opcode and the boundary register     */
+/*    from the device's BSDL file and names each cell that observes a   */
+/*    pin after its port. FInit loads SAMPLE once and leaves the TAP    */
+/*    controller in Shift-DR. From then on each frame is one overlapped */
+/*    DjtgGetTdoBits call that shifts the captured pins out, and one    */
+/*    DjtgPutTmsBits call that goes through Update-DR to Capture-DR and */
+/*    back to Shift-DR. Several frames are kept in flight, so the port  */
+/*    is never idle, and FPoll only reports the pins that changed since */
+/*    the previous frame. JtgTap.h must be included before this header. */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGBSCAN_INCLUDED)
+#define      JTGBSCAN_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Longest IR of the device and of the whole chain, and longest
+** boundary register.
+*/
+const DWORD cbitBsIrMax     = 32;
+const DWORD cbitBsChainIrMax    = 256;
+const DWORD cbitBsrMax      = 16384;
+
+/* Longest port name kept for a pin.
+*/
+const DWORD cchBsPinMax     = 47;
+
+/* Number of frames kept in flight, and time allowed for each
+** overlapped call to complete.
+*/
+const DWORD cbsFrameInFlight    = 4;
+const DWORD tmsBsCallWait   = 10000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Position of the device in the scan chain, given as in SVF. Its IR
+** length comes from the BSDL file.
+*/
+typedef struct {
+    DWORD   cbitHir;
+    DWORD   cbitTir;
+    DWORD   cbitHdr;
+    DWORD   cbitTdr;
+} BSCHAIN;
+
+/* A pin: the port name from the BSDL file and the boundary cell that
+** observes it. Cell 0 is the one nearest TDO.
+*/
+typedef struct {
+    char    szName[cchBsPinMax + 1];
+    DWORD   icell;
+    BOOL    fWatch;
+} BSPIN;
+
+/* A change of a pin. The time is taken when the frame that saw the
+** new value completed, in seconds of the monotonic clock.
+*/
+typedef struct {
+    DWORD   ipin;
+    BOOL    fValue;
+    DWORD   iframe;
+    double  sec;
+} BSEVT;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgBscan {
+
+private:
+    HIF         hif;
+    JtgTap      tap;
+    BSCHAIN     chn;
+    char        szEntity[cchBsPinMax + 1];
+    DWORD       cbitIr;
+    DWORD       irSample;
+    DWORD       cbitBsr;
+    BSPIN *     rgpin;
+    DWORD       cpin;
+    DWORD *     rgipinBit;      // pin of each bit of a frame
+    BYTE *      rgbWatch;       // bits of a frame that are watched
+    BYTE *      rgbLast;
+    BYTE *      rgrgbFrame[cbsFrameInFlight];
+    DWORD       cbitFrame;
+    BYTE        bTmsRecapture;  // Shift-DR to Update-DR to Shift-DR
+    DWORD       cbitRecapture;
+    DWORD       iframeNext;     // next frame to complete
+    DWORD       cframePending;
+    char        szError[256];
+
+    BOOL    FFail(const char * szFmt, ...);
+    BOOL    FParseBoundary(const char * szCells);
+    BOOL    FQueueFrame(DWORD iframe);
+    BOOL    FCompleteFrame();
+    void    CancelFrames();
+    void    FreeFrames();
+
+    JtgBscan(const JtgBscan &);
+    JtgBscan & operator=(const JtgBscan &);
+
+public:
+    JtgBscan();
+    ~JtgBscan();
+
+    BOOL    FLoadBsdl(const char * szPath);
+    BOOL    FWatch(const char * szPins);
+    BOOL    FInit(HIF hifReq, const BSCHAIN * pchnReq);
+    BOOL    FPoll(BSEVT * rgevt, DWORD * pcevt);
+    BOOL    FEnd();
+
+    DWORD           Cpin() const { return cpin; }
+    const BSPIN *   Ppin(DWORD ipin) const { return &rgpin[ipin]; }
+    DWORD           CbitIr() const { return cbitIr; }
+    DWORD           IrSample() const { return irSample; }
+    DWORD           CbitBsr() const { return cbitBsr; }
+    DWORD           Cframe() const { return iframeNext; }
+    const char *    SzEntity() const { return szEntity; }
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGBSCAN_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,729 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgCfg.cpp  --  FPGA configuration over a DJTG port                 */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a loader that configures a Xilinx FPGA from  */
+/*  a .bit or .bin file with the JTAG configuration instructions.       */
+/*                                                                      */
+/*  Everything but the configuration data is a handful of TAP moves     */
+/*  and instruction loads, which are merged into DjtgPutTmsTdiBits      */
+/*  calls by a JtgTap model. The data is shifted into CFG_IN with       */
+/*  overlapped DjtgPutTdiBits calls, one per chunk, straight from the   */
+/*  file's buffer. Up to ccallCfgInFlight calls are in flight, so the   */
+/*  next chunk is already queued when the port finishes one.            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: bitstream bytes are reversed with JbReverse             */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBits.h"
+#include "JtgTap.h"
+#include "JtgCfg.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* The fixed header at the start of a .bit file, and the synchronization
+** word that precedes the configuration packets.
+*/
+const BYTE      rgbCfgBitHeader[] = {
+    0x00, 0x09, 0x0F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0, 0x00, 0x00, 0x01
+};
+const BYTE      rgbCfgSync[] = { 0xAA, 0x99, 0x55, 0x66 };
+
+/* Number of bytes searched for the synchronization word.
+*/
+const DWORD     cbCfgSyncSearch = 1024;
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static BOOL     FBitField(BYTE * pb, DWORD cb, DWORD * pib, char chKey, const char ** psz);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgCfg::JtgCfg
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a loader that isn't attached to a port.
+*/
+JtgCfg::JtgCfg() : tap(fTrue) {
+
+    hif = hifInvalid;
+    memset(&chn, 0, sizeof(CFGCHAIN));
+    frqTck = 0;
+    cbChunk = 0;
+    ccallPending = 0;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FInit
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**      pchnReq     - position of the device in the scan chain
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the chain isn't supported or the TCK frequency can't be
+**      read.
+**
+**  Description:
+**      Attach the loader to a port and size the chunks for its TCK
+**      frequency.
+*/
+BOOL
+JtgCfg::FInit( HIF hifReq, const CFGCHAIN * pchnReq ) {
+
+    hif = hifReq;
+    chn = *pchnReq;
+    szError[0] = '\0';
+
+    if (( 2 > chn.cbitIr ) || ( 8 < chn.cbitIr ) ||
+        ( cbitCfgIrMax < chn.cbitHir + chn.cbitIr + chn.cbitTir )) {
+        return FFail("unsupported IR lengths");
+    }
+
+    if ( ! DjtgGetSpeed(hif, &frqTck) ) {
+        return FFail("DjtgGetSpeed failed");
+    }
+
+    cbChunk = CbCfgChunk(frqTck);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::SetChunk
+**
+**  Parameters:
+**      cbReq       - chunk size in bytes, 0 to choose it from the TCK
+**                    frequency
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Override the size of the chunks of configuration data. The size
+**      is kept within cbCfgChunkMin and cbCfgChunkMax.
+*/
+void
+JtgCfg::SetChunk( DWORD cbReq ) {
+
+    if ( 0 == cbReq ) {
+        cbChunk = CbCfgChunk(frqTck);
+    }
+    else if ( cbCfgChunkMin > cbReq ) {
+        cbChunk = cbCfgChunkMin;
+    }
+    else if ( cbCfgChunkMax < cbReq ) {
+        cbChunk = cbCfgChunkMax;
+    }
+    else {
+        cbChunk = cbReq;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FConfigure
+**
+**  Parameters:
+**      pbData      - configuration data, as stored in the file
+**      cbData      - number of bytes of data
+**      pcfs        - receives the times of the phases
+**
+**  Return Values:
+**      fTrue if the device is configured and DONE is high, fFalse
+**      otherwise
+**
+**  Errors:
+**      Fails if a DJTG call fails, the device doesn't clear or DONE
+**      stays low after startup.
+**
+**  Description:
+**      Configure the device. The data is bit reversed in place.
+*/
+BOOL
+JtgCfg::FConfigure( BYTE * pbData, DWORD cbData, CFGSTATS * pcfs ) {
+
+    double  secStart;
+    BYTE    bTdiLast;
+
+    memset(pcfs, 0, sizeof(CFGSTATS));
+    pcfs->cbChunk = cbChunk;
+    szError[0] = '\0';
+
+    if ( 0 == cbData ) {
+        return FFail("no configuration data");
+    }
+
+    /* Clear the configuration memory. JPROGRAM is sent with the reset
+    ** that puts the chain in a known state.
+    */
+    secStart = SecNow();
+
+    if (( ! tap.FReset() ) || ( ! tap.FMoveTo(tpsRTI) ) ||
+        ( ! FScanIr(irJprogram, NULL) ) || ( ! FWaitClear() )) {
+        return FFail("out of memory");
+    }
+
+    pcfs->secClear = SecNow() - secStart;
+
+    /* The bytes of the file are shifted MSB first.
+    */
+    secStart = SecNow();
+    CfgReverseBits(pbData, cbData);
+    pcfs->secReverse = SecNow() - secStart;
+
+    /* Shift every bit of the data but the last into CFG_IN, then the
+    ** last one and the bits that push it through the bypass registers
+    ** between TDI and the device, leaving Shift-DR on the final bit.
+    */
+    secStart = SecNow();
+
+    if (( ! FScanIr(irCfgIn, NULL) ) || ( ! tap.FMoveTo(tpsShDR) ) || ( ! FFlushTap() )) {
+        return FFail("out of memory");
+    }
+
+    if ( ! FStream(pbData, 8 * cbData - 1, &pcfs->ccall) ) {
+        return fFalse;
+    }
+
+    bTdiLast = pbData[cbData - 1] >> 7;
+
+    if (( ! tap.FShift(&bTdiLast, 1, ( 0 == chn.cbitTdr )) ) ||
+        (( 0 < chn.cbitTdr ) && ( ! tap.FShift(NULL, chn.cbitTdr, fTrue) )) ||
+        ( ! tap.FMoveTo(tpsRTI) ) || ( ! FFlushTap() )) {
+        return FFail("out of memory");
+    }
+
+    pcfs->secLoad = SecNow() - secStart;
+
+    /* Start the device, return to Test-Logic-Reset as the startup
+    ** sequence requires and read DONE from the IR capture value.
+    */
+    secStart = SecNow();
+
+    if (( ! FScanIr(irJstart, NULL) ) || ( ! tap.FHold(cclkCfgStartup) ) ||
+        ( ! tap.FReset() ) || ( ! tap.FMoveTo(tpsRTI) ) ||
+        ( ! FScanIr(irBypass, &pcfs->bCapture) )) {
+        return FFail("out of memory");
+    }
+
+    pcfs->secStart = SecNow() - secStart;
+
+    if ( bCfgCapFixed != ( pcfs->bCapture & 0x03 ) ) {
+        return FFail("invalid IR capture value 0x%02X, check the chain", pcfs->bCapture);
+    }
+
+    if ( 0 == ( pcfs->bCapture & bCfgCapDone ) ) {
+        return FFail("DONE is low after startup, IR capture 0x%02X", pcfs->bCapture);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FScanIr
+**
+**  Parameters:
+**      ir          - instruction for the device
+**      pbCapture   - receives the device's IR capture value, or NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated or a DJTG call fails.
+**
+**  Description:
+**      Load an instruction into the device and BYPASS into the others,
+**      from Run-Test/Idle back to Run-Test/Idle. When the capture value
+**      isn't needed the scan is only added to the pending TMS sequence.
+*/
+BOOL
+JtgCfg::FScanIr( BYTE ir, BYTE * pbCapture ) {
+
+    BYTE    rgbTdi[cbitCfgIrMax / 8];
+    BYTE    rgbTdo[cbitCfgIrMax / 8];
+    DWORD   cbit;
+    DWORD   ibit;
+    BYTE    bTdiLast;
+    BYTE    bTdoLast;
+
+    cbit = chn.cbitHir + chn.cbitIr + chn.cbitTir;
+
+    memset(rgbTdi, 0xFF, sizeof(rgbTdi));
+    for ( ibit = 0; ibit < chn.cbitIr; ibit++ ) {
+        if ( 0 == ( ir & (1 << ibit) ) ) {
+            rgbTdi[(chn.cbitHir + ibit) / 8] &= ~(1 << ((chn.cbitHir + ibit) % 8));
+        }
+    }
+
+    if ( ! tap.FMoveTo(tpsShIR) ) {
+        return fFalse;
+    }
+
+    if ( NULL == pbCapture ) {
+        return tap.FShift(rgbTdi, cbit, fTrue) && tap.FMoveTo(tpsRTI);
+    }
+
+    if ( ! FFlushTap() ) {
+        return fFalse;
+    }
+
+    memset(rgbTdo, 0, sizeof(rgbTdo));
+    bTdiLast = (rgbTdi[(cbit - 1) / 8] >> ((cbit - 1) % 8)) & 1;
+
+    if (( ! DjtgPutTdiBits(hif, fFalse, rgbTdi, rgbTdo, cbit - 1, fFalse) ) ||
+        ( ! DjtgPutTdiBits(hif, fTrue, &bTdiLast, &bTdoLast, 1, fFalse) )) {
+        return FFail("DjtgPutTdiBits failed");
+    }
+
+    rgbTdo[(cbit - 1) / 8] &= ~(1 << ((cbit - 1) % 8));
+    rgbTdo[(cbit - 1) / 8] |= (bTdoLast & 1) << ((cbit - 1) % 8);
+
+    tap.SetTps(tpsEx1IR);
+
+    *pbCapture = 0;
+    for ( ibit = 0; ibit < chn.cbitIr; ibit++ ) {
+        if ( rgbTdo[(chn.cbitHir + ibit) / 8] & (1 << ((chn.cbitHir + ibit) % 8)) ) {
+            *pbCapture |= 1 << ibit;
+        }
+    }
+
+    return tap.FMoveTo(tpsRTI);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FWaitClear
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the device doesn't finish clearing within
+**      tmsCfgClearMax ms.
+**
+**  Description:
+**      Poll the IR capture value until the device has finished clearing
+**      its configuration memory after JPROGRAM: INIT_COMPLETE is high
+**      and DONE is low.
+*/
+BOOL
+JtgCfg::FWaitClear() {
+
+    BYTE    bCapture;
+    double  secEnd;
+
+    secEnd = SecNow() + tmsCfgClearMax / 1000.0;
+
+    while ( fTrue ) {
+
+        if ( ! FScanIr(irBypass, &bCapture) ) {
+            return fFalse;
+        }
+
+        if ( bCfgCapFixed != ( bCapture & 0x03 ) ) {
+            return FFail("invalid IR capture value 0x%02X, check the chain", bCapture);
+        }
+
+        if (( bCapture & bCfgCapInit ) && ( 0 == ( bCapture & bCfgCapDone ) )) {
+            return fTrue;
+        }
+
+        if ( SecNow() > secEnd ) {
+            return FFail("device didn't clear, IR capture 0x%02X", bCapture);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FStream
+**
+**  Parameters:
+**      pb          - bits to shift, LSB first
+**      cbit        - number of bits
+**      pccall      - receives the number of calls made
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call fails or doesn't complete.
+**
+**  Description:
+**      Shift bits in Shift-DR without leaving it, with one overlapped
+**      DjtgPutTdiBits call per chunk. A chunk is only waited for when
+**      ccallCfgInFlight calls are in flight, and the remaining calls
+**      are waited for at the end.
+*/
+BOOL
+JtgCfg::FStream( const BYTE * pb, DWORD cbit, DWORD * pccall ) {
+
+    DWORD   cbitChunk;
+    DWORD   cbitCall;
+
+    cbitChunk = 8 * cbChunk;
+    *pccall = 0;
+
+    while ( 0 < cbit ) {
+
+        if (( ccallCfgInFlight <= ccallPending ) && ( ! FCompleteCall() )) {
+            return fFalse;
+        }
+
+        cbitCall = ( cbitChunk < cbit ) ? cbitChunk : cbit;
+
+        if ( ! DjtgPutTdiBits(hif, fFalse, (BYTE *)pb, NULL, cbitCall, fTrue) ) {
+            CancelCalls();
+            return FFail("DjtgPutTdiBits failed after %u bytes", cbChunk * *pccall);
+        }
+
+        ccallPending++;
+        (*pccall)++;
+
+        pb += cbitCall / 8;
+        cbit -= cbitCall;
+    }
+
+    while ( 0 < ccallPending ) {
+        if ( ! FCompleteCall() ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FCompleteCall
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call doesn't complete. The other calls are
+**      cancelled.
+**
+**  Description:
+**      Wait for the oldest overlapped call to complete.
+*/
+BOOL
+JtgCfg::FCompleteCall() {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+
+    if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsCfgCallWait) ) {
+        CancelCalls();
+        return FFail("an overlapped call didn't complete");
+    }
+
+    ccallPending--;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::CancelCalls
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Cancel the overlapped calls that are in flight.
+*/
+void
+JtgCfg::CancelCalls() {
+
+    if ( 0 < ccallPending ) {
+        DmgrCancelTrans(hif);
+        ccallPending = 0;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FFlushTap
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call fails.
+**
+**  Description:
+**      Send the pending TMS sequence.
+*/
+BOOL
+JtgCfg::FFlushTap() {
+
+    if ( ! tap.FFlush(hif, fFalse) ) {
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgCfg::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message. The first message is kept.
+*/
+BOOL
+JtgCfg::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    va_start(ap, szFmt);
+    vsnprintf(szError, sizeof(szError), szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCfgParseImage
+**
+**  Parameters:
+**      pb          - contents of a .bit or .bin file
+**      cb          - size of the file
+**      pimg        - receives the image found in the file
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file is a .bit file with a bad header, or if no
+**      synchronization word is found near the start of the data.
+**
+**  Description:
+**      Find the configuration data in a file. A .bit file is recognized
+**      by its header, whose fields are returned; anything else is taken
+**      to be a .bin file of raw configuration data.
+*/
+BOOL
+FCfgParseImage( BYTE * pb, DWORD cb, CFGIMG * pimg ) {
+
+    DWORD   ib;
+    DWORD   cbSearch;
+
+    memset(pimg, 0, sizeof(CFGIMG));
+
+    if (( sizeof(rgbCfgBitHeader) <= cb ) &&
+        ( 0 == memcmp(pb, rgbCfgBitHeader, sizeof(rgbCfgBitHeader)) )) {
+
+        ib = sizeof(rgbCfgBitHeader);
+
+        if (( ! FBitField(pb, cb, &ib, 'a', &pimg->szDesign) ) ||
+            ( ! FBitField(pb, cb, &ib, 'b', &pimg->szPart) ) ||
+            ( ! FBitField(pb, cb, &ib, 'c', &pimg->szDate) ) ||
+            ( ! FBitField(pb, cb, &ib, 'd', &pimg->szTime) ) ||
+            ( cb < ib + 5 ) || ( 'e' != pb[ib] )) {
+            return fFalse;
+        }
+
+        pimg->cbData = (pb[ib + 1] << 24) | (pb[ib + 2] << 16) | (pb[ib + 3] << 8) | pb[ib + 4];
+        ib += 5;
+
+        if ( cb - ib < pimg->cbData ) {
+            return fFalse;
+        }
+
+        pimg->pbData = pb + ib;
+    }
+    else {
+
+        pimg->pbData = pb;
+        pimg->cbData = cb;
+    }
+
+    cbSearch = ( cbCfgSyncSearch < pimg->cbData ) ? cbCfgSyncSearch : pimg->cbData;
+    for ( ib = 0; ib + sizeof(rgbCfgSync) <= cbSearch; ib++ ) {
+        if ( 0 == memcmp(&pimg->pbData[ib], rgbCfgSync, sizeof(rgbCfgSync)) ) {
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    CfgReverseBits
+**
+**  Parameters:
+**      pb          - bytes to reverse in place
+**      cb          - number of bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Reverse the order of the bits of each byte with JbReverse, which
+**      uses the widest byte shuffles the processor supports.
+*/
+void
+CfgReverseBits( BYTE * pb, DWORD cb ) {
+
+    JbReverse(pb, pb, cb);
+}
+
+/* ------------------------------------------------------------ */
+/***    CbCfgChunk
+**
+**  Parameters:
+**      frqTck      - TCK frequency in Hz, 0 if it isn't known
+**
+**  Return Values:
+**      chunk size in bytes
+**
+**  Errors:
+**
+**  Description:
+**      Return the power of two chunk size that keeps the port busy for
+**      at least tmsCfgChunk ms per call, within cbCfgChunkMin and
+**      cbCfgChunkMax. Fast ports get large chunks so that the cost of a
+**      call is spread over more data, slow ports small ones so that the
+**      calls in flight don't hold back the end of the load.
+*/
+DWORD
+CbCfgChunk( DWORD frqTck ) {
+
+    DWORD   cbWant;
+    DWORD   cb;
+
+    if ( 0 == frqTck ) {
+        return cbCfgChunkMax / 4;
+    }
+
+    cbWant = (DWORD)(((UINT64)frqTck * tmsCfgChunk) / (8 * 1000));
+
+    for ( cb = cbCfgChunkMin; ( cb < cbWant ) && ( cb < cbCfgChunkMax ); cb *= 2 ) {
+    }
+
+    return cb;
+}
+
+/* ------------------------------------------------------------ */
+/***    FBitField
+**
+**  Parameters:
+**      pb          - contents of the .bit file
+**      cb          - size of the file
+**      pib         - offset of the field, advanced past it
+**      chKey       - key the field must have
+**      psz         - receives the string of the field
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a string field of a .bit file header: a key byte, a big
+**      endian 16 bit length and a NUL terminated string.
+*/
+static BOOL
+FBitField( BYTE * pb, DWORD cb, DWORD * pib, char chKey, const char ** psz ) {
+
+    DWORD   ib;
+    DWORD   cch;
+
+    ib = *pib;
+
+    if (( cb < ib + 3 ) || ( chKey != (char)pb[ib] )) {
+        return fFalse;
+    }
+
+    cch = (pb[ib + 1] << 8) | pb[ib + 2];
+    ib += 3;
+
+    if (( 0 == cch ) || ( cb - ib < cch ) || ( '\0' != pb[ib + cch - 1] )) {
+        return fFalse;
+    }
+
+    *psz = (const char *)&pb[ib];
+    *pib = ib + cch;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
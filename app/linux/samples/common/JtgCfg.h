@@ -0,0 +1,174 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgCfg.h  --      Interface Declarations for JtgCfg.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a loader */
+/*    that configures a Xilinx FPGA over a DJTG port from a .bit or     */
+/*    .bin file. The loader clears the device with JPROGRAM, waits for  */
+/*    INIT_COMPLETE, shifts the configuration data into CFG_IN and      */
+/*    starts the device with JSTART. DONE is then confirmed by reading  */
+/*    back the IR capture value.                                        */
+/*                                                                      */
+/*    The configuration data is the bulk of the work, and is streamed   */
+/*    with overlapped DjtgPutTdiBits calls of one chunk each, several   */
+/*    of them in flight at once so that the port never waits for the    */
+/*    host. The chunk size is chosen from the TCK frequency so that     */
+/*    each call keeps the port busy for about tmsCfgChunk ms. The bytes */
+/*    of the file are sent MSB first, so they are bit reversed in one   */
+/*    pass, eight bytes at a time, before the first chunk is sent.      */
+/*                                                                      */
+/*    The TAP moves and the instruction loads that don't need TDO are   */
+/*    merged by a JtgTap model, so JtgTap.h must be included before     */
+/*    this header.                                                      */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGCFG_INCLUDED)
+#define      JTGCFG_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Configuration instructions. The opcodes are the same for the
+** Spartan-3, Spartan-6, 7 series and UltraScale families, whose IR is
+** six bits long for a single die.
+*/
+const BYTE  irCfgIn         = 0x05;
+const BYTE  irJprogram      = 0x0B;
+const BYTE  irJstart        = 0x0C;
+const BYTE  irBypass        = 0xFF;
+const DWORD cbitCfgIrDefault    = 6;
+
+/* Bits of the IR capture value.
+*/
+const BYTE  bCfgCapFixed    = 0x01;     // the two low bits read 01
+const BYTE  bCfgCapInit     = 0x10;     // INIT_COMPLETE
+const BYTE  bCfgCapDone     = 0x20;     // DONE
+
+/* Longest IR of the whole chain.
+*/
+const DWORD cbitCfgIrMax    = 256;
+
+/* Limits on the size of a chunk of configuration data, and the TCK
+** time a chunk is sized to take.
+*/
+const DWORD cbCfgChunkMin   = 4096;
+const DWORD cbCfgChunkMax   = 1024 * 1024;
+const DWORD tmsCfgChunk     = 20;
+
+/* Number of overlapped calls kept in flight while streaming.
+*/
+const DWORD ccallCfgInFlight    = 3;
+
+/* Time allowed for each overlapped call to complete, and for the
+** device to clear its configuration memory after JPROGRAM.
+*/
+const DWORD tmsCfgCallWait  = 10000;
+const DWORD tmsCfgClearMax  = 1000;
+
+/* TCK cycles clocked in Run-Test/Idle after JSTART for the startup
+** sequence.
+*/
+const DWORD cclkCfgStartup  = 2000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Position of the device in the scan chain, given as in SVF: the
+** header bits belong to the devices between it and TDO, the trailer
+** bits to the devices between TDI and it. The other devices are put
+** in BYPASS, so each of them adds one DR bit.
+*/
+typedef struct {
+    DWORD   cbitIr;             // IR length of the device
+    DWORD   cbitHir;
+    DWORD   cbitTir;
+    DWORD   cbitHdr;
+    DWORD   cbitTdr;
+} CFGCHAIN;
+
+/* A configuration image found in a file. The strings and the data
+** point into the file's buffer.
+*/
+typedef struct {
+    const char *    szDesign;   // NULL for a .bin file
+    const char *    szPart;
+    const char *    szDate;
+    const char *    szTime;
+    BYTE *          pbData;
+    DWORD           cbData;
+} CFGIMG;
+
+/* Times of the phases of FConfigure.
+*/
+typedef struct {
+    double  secClear;           // JPROGRAM until INIT_COMPLETE
+    double  secReverse;         // bit reversal of the data
+    double  secLoad;            // streaming the data into CFG_IN
+    double  secStart;           // JSTART and the DONE readback
+    DWORD   cbChunk;
+    DWORD   ccall;              // DjtgPutTdiBits calls for the data
+    BYTE    bCapture;           // IR capture value after startup
+} CFGSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgCfg {
+
+private:
+    HIF         hif;
+    JtgTap      tap;
+    CFGCHAIN    chn;
+    DWORD       frqTck;
+    DWORD       cbChunk;
+    DWORD       ccallPending;
+    char        szError[256];
+
+    BOOL    FFail(const char * szFmt, ...);
+    BOOL    FFlushTap();
+    BOOL    FScanIr(BYTE ir, BYTE * pbCapture);
+    BOOL    FWaitClear();
+    BOOL    FStream(const BYTE * pb, DWORD cbit, DWORD * pccall);
+    BOOL    FCompleteCall();
+    void    CancelCalls();
+
+    JtgCfg(const JtgCfg &);
+    JtgCfg & operator=(const JtgCfg &);
+
+public:
+    JtgCfg();
+
+    BOOL    FInit(HIF hifReq, const CFGCHAIN * pchnReq);
+    void    SetChunk(DWORD cbReq);
+    BOOL    FConfigure(BYTE * pbData, DWORD cbData, CFGSTATS * pcfs);
+
+    DWORD           FrqTck() const { return frqTck; }
+    DWORD           CbChunk() const { return cbChunk; }
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BOOL    FCfgParseImage(BYTE * pb, DWORD cb, CFGIMG * pimg);
+void    CfgReverseBits(BYTE * pb, DWORD cb);
+DWORD   CbCfgChunk(DWORD frqTck);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGCFG_INCLUDED
+
+/************************************************************************/
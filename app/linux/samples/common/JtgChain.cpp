@@ -0,0 +1,998 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgChain.cpp  --  Scan chain enumeration and chain cache            */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a scan chain enumerator that reads every     */
+/*  IDCODE, measures the IR lengths and counts the devices of a chain   */
+/*  in one DJTG call, and a file that keeps the chains found for each   */
+/*  device serial number.                                               */
+/*                                                                      */
+/*  The scans are appended to a JtgTap sequence of TMS/TDI pairs as     */
+/*  fixed length patterns that are long enough for the largest chain    */
+/*  supported, so that nothing has to be read back before the next      */
+/*  scan is sent. The TDO bits of all of them come back from the        */
+/*  single DjtgPutTmsTdiBits call that sends the sequence.              */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgChain.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Lengths of the scans made by FDiscover. The IDCODE scan covers a
+** full chain and the 32 ones that mark its end. The IR and bypass
+** scans shift zeros and then ones, each longer than the register.
+*/
+const DWORD     cbitJcIdScan    = 32 * cdevJcMax + 32;
+const DWORD     cbitJcIrFill    = cbitJcIrMax + 1;
+const DWORD     cbitJcBypFill   = cdevJcMax + 1;
+
+/* IDCODE read when TDO shows the ones shifted in.
+*/
+const DWORD     idJcEnd         = 0xFFFFFFFF;
+
+/* Longest line of a chain file.
+*/
+const DWORD     cchJcLineMax    = 32 + 20 * cdevJcMax;
+
+/* IR lengths of parts that can't always be told apart by their capture
+** values. The version field of the IDCODE is ignored, and the first
+** matching entry is used.
+*/
+typedef struct {
+    DWORD   idcode;
+    DWORD   msk;
+    DWORD   cbitIr;
+} JCKNOWN;
+
+const JCKNOWN   rgjck[] = {
+    { 0x0BA00477, 0x0FFFFFFF, 4 },      // ARM CoreSight JTAG-DP
+    { 0x05040093, 0x0FFF8FFF, 8 },      // Xilinx XCF01S-XCF04S
+    { 0x00000093, 0x00000FFF, 6 },      // Xilinx FPGAs
+    { 0, 0, 0 }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static void     CopyBits(BYTE * rgbDst, const BYTE * rgbSrc, DWORD ibitSrc, DWORD cbit);
+static void     FillBits(BYTE * rgb, DWORD ibit, DWORD cbit, BOOL fOne);
+static DWORD    IbitFirstOne(const BYTE * rgb, DWORD ibit, DWORD cbit);
+static BOOL     FCaptureStart(const BYTE * rgbCapture, DWORD ibit, DWORD cbit);
+static DWORD    CsolSplit(const BYTE * rgbCapture, JCHAIN * pjc, BOOL fKnown);
+static BOOL     FParseLine(char * sz, char * szSn, JCHAIN * pjc);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgChain::JtgChain
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an enumerator that isn't attached to a port.
+*/
+JtgChain::JtgChain() : tap(fTrue) {
+
+    hif = hifInvalid;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::Init
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Attach the enumerator to a port.
+*/
+void
+JtgChain::Init( HIF hifReq ) {
+
+    hif = hifReq;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FDiscover
+**
+**  Parameters:
+**      pjc         - receives the chain
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call fails, the chain is too long, the scans don't
+**      agree on the number of devices or the IR lengths can't be told
+**      apart.
+**
+**  Description:
+**      Discover the chain with one call. The chain is reset first and
+**      every device is left in BYPASS, with the TAP controller in
+**      Run-Test/Idle.
+*/
+BOOL
+JtgChain::FDiscover( JCHAIN * pjc ) {
+
+    BYTE    rgbTdi[(cbitJcIdScan + 7) / 8];
+    BYTE    rgbScan[(cbitJcIdScan + 7) / 8];
+    BYTE    rgbCapture[(cbitJcIrMax + 7) / 8];
+    BYTE *  rgbTdo;
+    DWORD   ibitId = 0;
+    DWORD   ibitIr = 0;
+    DWORD   ibitByp;
+    DWORD   ibit;
+    DWORD   cdevByp;
+    BOOL    fOk;
+
+    memset(pjc, 0, sizeof(JCHAIN));
+    szError[0] = '\0';
+
+    /* Build the three scans: ones through DR, zeros and ones through IR,
+    ** and zeros and ones through the bypass registers.
+    */
+    tap.Clear();
+    fOk = tap.FReset();
+
+    memset(rgbTdi, 0xFF, sizeof(rgbTdi));
+    fOk = fOk && FAppendScan(fFalse, rgbTdi, cbitJcIdScan, &ibitId);
+
+    FillBits(rgbTdi, 0, cbitJcIrFill, fFalse);
+    fOk = fOk && FAppendScan(fTrue, rgbTdi, 2 * cbitJcIrFill, &ibitIr);
+
+    memset(rgbTdi, 0xFF, sizeof(rgbTdi));
+    FillBits(rgbTdi, 0, cbitJcBypFill, fFalse);
+    fOk = fOk && FAppendScan(fFalse, rgbTdi, 2 * cbitJcBypFill, &ibitByp);
+
+    if (( ! fOk ) || ( ! tap.FMoveTo(tpsRTI) )) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    rgbTdo = (BYTE *)calloc((tap.CbitSeq() + 7) / 8, 1);
+    if ( NULL == rgbTdo ) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    if ( ! tap.FFlush(hif, fFalse, rgbTdo) ) {
+        free(rgbTdo);
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    /* Read the IDCODEs.
+    */
+    CopyBits(rgbScan, rgbTdo, ibitId, cbitJcIdScan);
+    fOk = FParseIdcodes(rgbScan, pjc);
+
+    /* The capture values come out of IR first and the ones shifted in
+    ** appear after the zeros, so the first one after the zeros gives
+    ** the total IR length.
+    */
+    if ( fOk ) {
+
+        CopyBits(rgbScan, rgbTdo, ibitIr, 2 * cbitJcIrFill);
+        ibit = IbitFirstOne(rgbScan, cbitJcIrFill, 2 * cbitJcIrFill);
+
+        if (( 2 * cbitJcIrFill <= ibit ) || ( cbitJcIrMax < ibit - cbitJcIrFill )) {
+            fOk = FFail("IR is longer than %u bits", cbitJcIrMax);
+        }
+        else {
+            pjc->cbitIr = ibit - cbitJcIrFill;
+            CopyBits(rgbCapture, rgbScan, 0, pjc->cbitIr);
+        }
+    }
+
+    /* Each device in BYPASS adds one bit, whose capture value is zero.
+    */
+    if ( fOk ) {
+
+        CopyBits(rgbScan, rgbTdo, ibitByp, 2 * cbitJcBypFill);
+        cdevByp = IbitFirstOne(rgbScan, 0, 2 * cbitJcBypFill) - cbitJcBypFill;
+
+        if ( cdevByp != pjc->cdev ) {
+            fOk = FFail("found %u IDCODEs but %u bypass registers", pjc->cdev, cdevByp);
+        }
+    }
+
+    free(rgbTdo);
+
+    if ( fOk && ( ! FJcSplitIr(rgbCapture, pjc) ) ) {
+        fOk = FFail("can't tell the IR lengths apart, %u bits for %u devices",
+                    pjc->cbitIr, pjc->cdev);
+    }
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FReadIdcodes
+**
+**  Parameters:
+**      pjc         - receives the devices, without their IR lengths
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call fails or the chain is too long.
+**
+**  Description:
+**      Reset the chain and read every IDCODE with one call.
+*/
+BOOL
+JtgChain::FReadIdcodes( JCHAIN * pjc ) {
+
+    BYTE    rgbTdi[(cbitJcIdScan + 7) / 8];
+    BYTE    rgbTdo[(cbitJcIdScan + 7) / 8 + 8];
+    BYTE    rgbScan[(cbitJcIdScan + 7) / 8];
+    DWORD   ibitId;
+
+    memset(pjc, 0, sizeof(JCHAIN));
+    szError[0] = '\0';
+
+    memset(rgbTdi, 0xFF, sizeof(rgbTdi));
+
+    tap.Clear();
+    if (( ! tap.FReset() ) || ( ! FAppendScan(fFalse, rgbTdi, cbitJcIdScan, &ibitId) ) ||
+        ( ! tap.FMoveTo(tpsRTI) ) || ( sizeof(rgbTdo) < (tap.CbitSeq() + 7) / 8 )) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    if ( ! tap.FFlush(hif, fFalse, rgbTdo) ) {
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    CopyBits(rgbScan, rgbTdo, ibitId, cbitJcIdScan);
+
+    return FParseIdcodes(rgbScan, pjc);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FVerify
+**
+**  Parameters:
+**      pjc         - chain expected, e.g. from the chain file
+**      pfMatch     - receives fTrue if the devices have the same
+**                    IDCODEs in the same order
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the IDCODEs can't be read.
+**
+**  Description:
+**      Check that a stored chain still describes the hardware, at the
+**      cost of one call.
+*/
+BOOL
+JtgChain::FVerify( const JCHAIN * pjc, BOOL * pfMatch ) {
+
+    JCHAIN  jcRead;
+    DWORD   idev;
+
+    *pfMatch = fFalse;
+
+    if ( ! FReadIdcodes(&jcRead) ) {
+        return fFalse;
+    }
+
+    if ( jcRead.cdev != pjc->cdev ) {
+        return fTrue;
+    }
+
+    for ( idev = 0; idev < pjc->cdev; idev++ ) {
+        if ( jcRead.rgdev[idev].idcode != pjc->rgdev[idev].idcode ) {
+            return fTrue;
+        }
+    }
+
+    *pfMatch = fTrue;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FAppendScan
+**
+**  Parameters:
+**      fIr         - fTrue to scan IR, fFalse to scan DR
+**      rgbTdi      - bits to send, LSB first
+**      cbit        - number of bits
+**      pibit       - receives the offset of the scan's TDO bits
+**
+**  Return Values:
+**      fTrue for success, fFalse if memory can't be allocated
+**
+**  Errors:
+**
+**  Description:
+**      Append a scan to the sequence, from the current state through
+**      the shift state to Exit1.
+*/
+BOOL
+JtgChain::FAppendScan( BOOL fIr, const BYTE * rgbTdi, DWORD cbit, DWORD * pibit ) {
+
+    if ( ! tap.FMoveTo(fIr ? tpsShIR : tpsShDR) ) {
+        return fFalse;
+    }
+
+    *pibit = tap.CbitSeq();
+
+    return tap.FShift(rgbTdi, cbit, fTrue);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FParseIdcodes
+**
+**  Parameters:
+**      rgbTdo      - TDO bits of the IDCODE scan
+**      pjc         - receives the devices
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the chain is empty or longer than cdevJcMax devices.
+**
+**  Description:
+**      Split the bits read from DR after a reset into devices. A device
+**      with an IDCODE shifts out 32 bits starting with a one, one that
+**      selects BYPASS a single zero. The ones shifted in mark the end.
+*/
+BOOL
+JtgChain::FParseIdcodes( const BYTE * rgbTdo, JCHAIN * pjc ) {
+
+    DWORD   ibit;
+    DWORD   ibitId;
+    DWORD   idcode;
+
+    pjc->cdev = 0;
+    ibit = 0;
+
+    while ( fTrue ) {
+
+        if ( cbitJcIdScan < ibit + 32 ) {
+            return FFail("more than %u devices in the chain", cdevJcMax);
+        }
+
+        idcode = idJcNone;
+
+        if ( 0 == ( rgbTdo[ibit / 8] & (1 << (ibit % 8)) ) ) {
+            ibit++;
+        }
+        else {
+            for ( ibitId = 0; ibitId < 32; ibitId++, ibit++ ) {
+                if ( rgbTdo[ibit / 8] & (1 << (ibit % 8)) ) {
+                    idcode |= (DWORD)1 << ibitId;
+                }
+            }
+
+            if ( idJcEnd == idcode ) {
+                break;
+            }
+        }
+
+        if ( cdevJcMax <= pjc->cdev ) {
+            return FFail("more than %u devices in the chain", cdevJcMax);
+        }
+
+        pjc->rgdev[pjc->cdev].idcode = idcode;
+        pjc->rgdev[pjc->cdev].cbitIr = 0;
+        pjc->cdev++;
+    }
+
+    if ( 0 == pjc->cdev ) {
+        return FFail("no devices found, check TDO");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgChain::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message. The first message is kept.
+*/
+BOOL
+JtgChain::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    va_start(ap, szFmt);
+    vsnprintf(szError, sizeof(szError), szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    FJcSplitIr
+**
+**  Parameters:
+**      rgbCapture  - IR capture bits of the whole chain, LSB first
+**      pjc         - chain whose devices and total IR length are set,
+**                    receives the IR length of each device
+**
+**  Return Values:
+**      fTrue if there is exactly one way to split IR, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Split the total IR length between the devices. The capture value
+**      of every IR starts with a one followed by a zero, so each device
+**      must start where the capture bits read 1 and then 0. The lengths
+**      of known parts are used first; if the chain can't be split with
+**      them, it is split from the capture bits alone.
+*/
+BOOL
+FJcSplitIr( const BYTE * rgbCapture, JCHAIN * pjc ) {
+
+    DWORD   csol;
+
+    csol = CsolSplit(rgbCapture, pjc, fTrue);
+
+    if ( 0 == csol ) {
+        csol = CsolSplit(rgbCapture, pjc, fFalse);
+    }
+
+    return ( 1 == csol );
+}
+
+/* ------------------------------------------------------------ */
+/***    CbitJcIrKnown
+**
+**  Parameters:
+**      idcode      - IDCODE of a device
+**
+**  Return Values:
+**      IR length of the part, 0 if it isn't known
+**
+**  Errors:
+**
+**  Description:
+**      Look up the IR length of a part.
+*/
+DWORD
+CbitJcIrKnown( DWORD idcode ) {
+
+    const JCKNOWN * pjck;
+
+    for ( pjck = rgjck; 0 != pjck->cbitIr; pjck++ ) {
+        if ( pjck->idcode == ( idcode & pjck->msk ) ) {
+            return pjck->cbitIr;
+        }
+    }
+
+    return 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    JcPosition
+**
+**  Parameters:
+**      pjc         - chain
+**      idev        - device
+**      pcbitHir    - receives the IR bits between the device and TDO
+**      pcbitTir    - receives the IR bits between TDI and the device
+**      pcbitHdr    - receives the bypass bits between the device and TDO
+**      pcbitTdr    - receives the bypass bits between TDI and the device
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Describe the position of a device as the SVF header and trailer
+**      lengths used to address it with the others in BYPASS.
+*/
+void
+JcPosition( const JCHAIN * pjc, DWORD idev, DWORD * pcbitHir, DWORD * pcbitTir,
+            DWORD * pcbitHdr, DWORD * pcbitTdr ) {
+
+    DWORD   idevCur;
+
+    *pcbitHir = 0;
+    for ( idevCur = 0; idevCur < idev; idevCur++ ) {
+        *pcbitHir += pjc->rgdev[idevCur].cbitIr;
+    }
+
+    *pcbitTir = pjc->cbitIr - *pcbitHir - pjc->rgdev[idev].cbitIr;
+    *pcbitHdr = idev;
+    *pcbitTdr = pjc->cdev - idev - 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FJcGetSerial
+**
+**  Parameters:
+**      hif     - open device
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the serial number that chains are stored under.
+*/
+BOOL
+FJcGetSerial( HIF hif, char * szSn ) {
+
+    DVC     dvc;
+    char    szTmp[cchDvcNameMax + 1];
+
+    if ( ! DmgrGetDvcFromHif(hif, &dvc) ) {
+        return fFalse;
+    }
+
+    if ( ! DmgrGetInfo(&dvc, dinfoSN, szTmp) ) {
+        return fFalse;
+    }
+
+    szTmp[cchSnMax] = '\0';
+    strcpy(szSn, szTmp);
+
+    return ( '\0' != szSn[0] );
+}
+
+/* ------------------------------------------------------------ */
+/***    FJcPath
+**
+**  Parameters:
+**      szPath  - receives the path of the chain file
+**      cchMax  - size of szPath
+**
+**  Return Values:
+**      fTrue for success, fFalse if the path doesn't fit
+**
+**  Errors:
+**
+**  Description:
+**      Get the path of the default chain file, in the home directory if
+**      there is one and the current directory otherwise.
+*/
+BOOL
+FJcPath( char * szPath, DWORD cchMax ) {
+
+    const char *    szHome;
+    int             cch;
+
+    szHome = getenv("HOME");
+
+    if (( NULL == szHome ) || ( '\0' == szHome[0] )) {
+        cch = snprintf(szPath, cchMax, "%s", szJcFileDefault);
+    }
+    else {
+        cch = snprintf(szPath, cchMax, "%s/%s", szHome, szJcFileDefault);
+    }
+
+    return (( 0 <= cch ) && ( (DWORD)cch < cchMax ));
+}
+
+/* ------------------------------------------------------------ */
+/***    FJcLoad
+**
+**  Parameters:
+**      szPath  - chain file
+**      szSn    - serial number of the device
+**      pjc     - receives the stored chain
+**
+**  Return Values:
+**      fTrue if a chain was found, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Look up the chain stored for a device.
+*/
+BOOL
+FJcLoad( const char * szPath, const char * szSn, JCHAIN * pjc ) {
+
+    FILE *  pfile;
+    char    szLine[cchJcLineMax];
+    char    szSnLine[cchSnMax + 1];
+    BOOL    fFound;
+
+    pfile = fopen(szPath, "r");
+    if ( NULL == pfile ) {
+        return fFalse;
+    }
+
+    fFound = fFalse;
+
+    while (( ! fFound ) && ( NULL != fgets(szLine, sizeof(szLine), pfile) )) {
+
+        if (( FParseLine(szLine, szSnLine, pjc) ) && ( 0 == strcmp(szSn, szSnLine) )) {
+            fFound = fTrue;
+        }
+    }
+
+    fclose(pfile);
+
+    return fFound;
+}
+
+/* ------------------------------------------------------------ */
+/***    FJcSave
+**
+**  Parameters:
+**      szPath  - chain file
+**      szSn    - serial number of the device
+**      pjc     - chain to store
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Store the chain of a device, replacing any stored before. The
+**      file is rewritten under a temporary name and then renamed, so
+**      it is never left half written.
+*/
+BOOL
+FJcSave( const char * szPath, const char * szSn, const JCHAIN * pjc ) {
+
+    FILE *      pfileOld;
+    FILE *      pfileNew;
+    char        szTmp[cchJcLineMax + 8];
+    char        szLine[cchJcLineMax];
+    char        szSnLine[cchSnMax + 1];
+    JCHAIN      jcLine;
+    DWORD       idev;
+    BOOL        fSuccess;
+
+    if ( sizeof(szTmp) <= (size_t)snprintf(szTmp, sizeof(szTmp), "%s.tmp", szPath) ) {
+        return fFalse;
+    }
+
+    pfileNew = fopen(szTmp, "w");
+    if ( NULL == pfileNew ) {
+        return fFalse;
+    }
+
+    fprintf(pfileNew, "# serial devices idcode:ir-length ... (nearest TDO first)\n");
+
+    /* Copy the chains of every other device.
+    */
+    pfileOld = fopen(szPath, "r");
+    if ( NULL != pfileOld ) {
+
+        while ( NULL != fgets(szLine, sizeof(szLine), pfileOld) ) {
+
+            if (( FParseLine(szLine, szSnLine, &jcLine) ) && ( 0 != strcmp(szSn, szSnLine) )) {
+                fputs(szLine, pfileNew);
+            }
+        }
+
+        fclose(pfileOld);
+    }
+
+    fprintf(pfileNew, "%s %u", szSn, pjc->cdev);
+    for ( idev = 0; idev < pjc->cdev; idev++ ) {
+        fprintf(pfileNew, " %08X:%u", pjc->rgdev[idev].idcode, pjc->rgdev[idev].cbitIr);
+    }
+    fprintf(pfileNew, "\n");
+
+    fSuccess = ( 0 == ferror(pfileNew) );
+
+    if ( 0 != fclose(pfileNew) ) {
+        fSuccess = fFalse;
+    }
+
+    if (( ! fSuccess ) || ( 0 != rename(szTmp, szPath) )) {
+
+        remove(szTmp);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseLine
+**
+**  Parameters:
+**      sz      - line of a chain file
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**      pjc     - receives the chain
+**
+**  Return Values:
+**      fTrue if the line holds a chain, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a line of a chain file. Comments and lines that don't
+**      describe a whole chain are skipped.
+*/
+static BOOL
+FParseLine( char * sz, char * szSn, JCHAIN * pjc ) {
+
+    char    szFmtSn[16];
+    int     cch;
+    DWORD   idev;
+
+    if ( '#' == sz[0] ) {
+        return fFalse;
+    }
+
+    snprintf(szFmtSn, sizeof(szFmtSn), "%%%us %%u%%n", cchSnMax);
+
+    if (( 2 > sscanf(sz, szFmtSn, szSn, &pjc->cdev, &cch) ) ||
+        ( 0 == pjc->cdev ) || ( cdevJcMax < pjc->cdev )) {
+        return fFalse;
+    }
+
+    sz += cch;
+    pjc->cbitIr = 0;
+
+    for ( idev = 0; idev < pjc->cdev; idev++ ) {
+
+        if ( 2 > sscanf(sz, " %x:%u%n", &pjc->rgdev[idev].idcode, &pjc->rgdev[idev].cbitIr, &cch) ) {
+            return fFalse;
+        }
+
+        sz += cch;
+        pjc->cbitIr += pjc->rgdev[idev].cbitIr;
+    }
+
+    return ( cbitJcIrMax >= pjc->cbitIr );
+}
+
+/* ------------------------------------------------------------ */
+/***    CsolSplit
+**
+**  Parameters:
+**      rgbCapture  - IR capture bits of the whole chain
+**      pjc         - chain, receives the IR lengths if there is a
+**                    single way to split IR
+**      fKnown      - fTrue to hold known parts to their IR length
+**
+**  Return Values:
+**      0, 1, or 2 for two or more ways to split IR
+**
+**  Errors:
+**
+**  Description:
+**      Count the ways IR can be split between the devices. The number
+**      of ways to split the bits from ibit on between the devices from
+**      idev on is computed for every idev and ibit, starting at the
+**      end of the chain, and capped at 2. A single way is then followed
+**      from the start.
+*/
+static DWORD
+CsolSplit( const BYTE * rgbCapture, JCHAIN * pjc, BOOL fKnown ) {
+
+    BYTE    rgcsol[cdevJcMax + 1][cbitJcIrMax + 1];
+    DWORD   idev;
+    DWORD   ibit;
+    DWORD   cbit;
+    DWORD   cbitKnown;
+    DWORD   csol;
+
+    memset(rgcsol, 0, sizeof(rgcsol));
+    rgcsol[pjc->cdev][pjc->cbitIr] = 1;
+
+    for ( idev = pjc->cdev; 0 < idev--; ) {
+
+        cbitKnown = fKnown ? CbitJcIrKnown(pjc->rgdev[idev].idcode) : 0;
+
+        for ( ibit = 0; ibit < pjc->cbitIr; ibit++ ) {
+
+            if ( ! FCaptureStart(rgbCapture, ibit, pjc->cbitIr) ) {
+                continue;
+            }
+
+            csol = 0;
+            for ( cbit = 2; ibit + cbit <= pjc->cbitIr; cbit++ ) {
+                if (( 0 == cbitKnown ) || ( cbit == cbitKnown )) {
+                    csol += rgcsol[idev + 1][ibit + cbit];
+                }
+            }
+
+            rgcsol[idev][ibit] = ( 2 < csol ) ? 2 : csol;
+        }
+    }
+
+    if ( 1 != rgcsol[0][0] ) {
+        return rgcsol[0][0];
+    }
+
+    ibit = 0;
+    for ( idev = 0; idev < pjc->cdev; idev++ ) {
+
+        cbitKnown = fKnown ? CbitJcIrKnown(pjc->rgdev[idev].idcode) : 0;
+
+        for ( cbit = 2; 0 == rgcsol[idev + 1][ibit + cbit] ||
+                        (( 0 != cbitKnown ) && ( cbit != cbitKnown )); cbit++ ) {
+        }
+
+        pjc->rgdev[idev].cbitIr = cbit;
+        ibit += cbit;
+    }
+
+    return 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCaptureStart
+**
+**  Parameters:
+**      rgbCapture  - IR capture bits of the whole chain
+**      ibit        - bit to check
+**      cbit        - number of capture bits
+**
+**  Return Values:
+**      fTrue if an IR can start at ibit, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check for the 1 followed by a 0 that every IR captures.
+*/
+static BOOL
+FCaptureStart( const BYTE * rgbCapture, DWORD ibit, DWORD cbit ) {
+
+    return ( ibit + 2 <= cbit ) &&
+           ( 0 != ( rgbCapture[ibit / 8] & (1 << (ibit % 8)) ) ) &&
+           ( 0 == ( rgbCapture[(ibit + 1) / 8] & (1 << ((ibit + 1) % 8)) ) );
+}
+
+/* ------------------------------------------------------------ */
+/***    CopyBits
+**
+**  Parameters:
+**      rgbDst      - receives the bits, starting at bit 0
+**      rgbSrc      - source bits
+**      ibitSrc     - first source bit
+**      cbit        - number of bits
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Copy bits to the start of a buffer. Bits past cbit in the last
+**      destination byte are cleared.
+*/
+static void
+CopyBits( BYTE * rgbDst, const BYTE * rgbSrc, DWORD ibitSrc, DWORD cbit ) {
+
+    DWORD   ibit;
+
+    memset(rgbDst, 0, (cbit + 7) / 8);
+
+    for ( ibit = 0; ibit < cbit; ibit++, ibitSrc++ ) {
+        if ( rgbSrc[ibitSrc / 8] & (1 << (ibitSrc % 8)) ) {
+            rgbDst[ibit / 8] |= 1 << (ibit % 8);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FillBits
+**
+**  Parameters:
+**      rgb         - buffer
+**      ibit        - first bit
+**      cbit        - number of bits
+**      fOne        - value of the bits
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set a range of bits to a value.
+*/
+static void
+FillBits( BYTE * rgb, DWORD ibit, DWORD cbit, BOOL fOne ) {
+
+    for ( ; 0 < cbit; cbit--, ibit++ ) {
+        if ( fOne ) {
+            rgb[ibit / 8] |= 1 << (ibit % 8);
+        }
+        else {
+            rgb[ibit / 8] &= ~(1 << (ibit % 8));
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    IbitFirstOne
+**
+**  Parameters:
+**      rgb         - bits
+**      ibit        - first bit to check
+**      cbit        - number of bits in the buffer
+**
+**  Return Values:
+**      index of the first one from ibit on, cbit if there is none
+**
+**  Errors:
+**
+**  Description:
+**      Find the first one in a range of bits.
+*/
+static DWORD
+IbitFirstOne( const BYTE * rgb, DWORD ibit, DWORD cbit ) {
+
+    while (( ibit < cbit ) && ( 0 == ( rgb[ibit / 8] & (1 << (ibit % 8)) ) )) {
+        ibit++;
+    }
+
+    return ibit;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
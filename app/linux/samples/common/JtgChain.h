@@ -0,0 +1,119 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgChain.h  --    Interface Declarations for JtgChain.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a scan   */
+/*    chain enumerator and a cache of the chains it finds.              */
+/*                                                                      */
+/*    The enumerator discovers a chain with a single DJTG call. From    */
+/*    Test-Logic-Reset it shifts enough ones through DR to read the     */
+/*    IDCODE of every device, then zeros and ones through IR to measure */
+/*    the total IR length and read the IR capture values, then zeros    */
+/*    and ones through DR again, with every device in BYPASS, to count  */
+/*    the devices. The TAP moves and the three shifts are sent as one   */
+/*    sequence of TMS/TDI pairs. The total IR length is split between   */
+/*    the devices using the capture values, which start with 01 on      */
+/*    every device, and the IR lengths of known parts.                  */
+/*                                                                      */
+/*    A chain is stored in a text file, one line per device serial      */
+/*    number, so that later sessions can skip discovery. JtgTap.h must  */
+/*    be included before this header.                                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGCHAIN_INCLUDED)
+#define      JTGCHAIN_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Largest chain that can be discovered: number of devices and total
+** IR length.
+*/
+const DWORD cdevJcMax       = 32;
+const DWORD cbitJcIrMax     = 256;
+
+/* IDCODE recorded for a device that selects BYPASS on reset.
+*/
+const DWORD idJcNone        = 0;
+
+/* Name of the chain file in the user's home directory.
+*/
+#define szJcFileDefault     ".djtgchain"
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* A device in the chain.
+*/
+typedef struct {
+    DWORD   idcode;
+    DWORD   cbitIr;
+} JCDEV;
+
+/* A scan chain. The devices are in the order their bits leave TDO, so
+** device 0 is the one nearest TDO, as in the order of SVF headers.
+*/
+typedef struct {
+    DWORD   cdev;
+    DWORD   cbitIr;             // total IR length
+    JCDEV   rgdev[cdevJcMax];
+} JCHAIN;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgChain {
+
+private:
+    HIF         hif;
+    JtgTap      tap;
+    char        szError[256];
+
+    BOOL    FFail(const char * szFmt, ...);
+    BOOL    FAppendScan(BOOL fIr, const BYTE * rgbTdi, DWORD cbit, DWORD * pibit);
+    BOOL    FParseIdcodes(const BYTE * rgbTdo, JCHAIN * pjc);
+
+    JtgChain(const JtgChain &);
+    JtgChain & operator=(const JtgChain &);
+
+public:
+    JtgChain();
+
+    void    Init(HIF hifReq);
+    BOOL    FDiscover(JCHAIN * pjc);
+    BOOL    FReadIdcodes(JCHAIN * pjc);
+    BOOL    FVerify(const JCHAIN * pjc, BOOL * pfMatch);
+
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BOOL    FJcSplitIr(const BYTE * rgbCapture, JCHAIN * pjc);
+DWORD   CbitJcIrKnown(DWORD idcode);
+void    JcPosition(const JCHAIN * pjc, DWORD idev, DWORD * pcbitHir, DWORD * pcbitTir,
+                   DWORD * pcbitHdr, DWORD * pcbitTdr);
+BOOL    FJcGetSerial(HIF hif, char * szSn);
+BOOL    FJcPath(char * szPath, DWORD cchMax);
+BOOL    FJcLoad(const char * szPath, const char * szSn, JCHAIN * pjc);
+BOOL    FJcSave(const char * szPath, const char * szSn, const JCHAIN * pjc);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGCHAIN_INCLUDED
+
+/************************************************************************/
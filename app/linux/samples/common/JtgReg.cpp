@@ -0,0 +1,639 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgReg.cpp  --  Register accesses through the JTAG USER1 bridge     */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module reads and writes the registers of fpga/jtgref.vhd. The  */
+/*  TAP controller is left in Shift-DR with USER1 loaded, where the     */
+/*  bridge takes a stream of access frames and idles on zeros, so each  */
+/*  group of accesses is one DjtgPutTdiBits call with TMS low. The      */
+/*  frames of a call are packed back to back and followed by one zero   */
+/*  for each bypass register in the chain, which carries the last of    */
+/*  them through to the bridge and its replies out to TDO.              */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgReg.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Positions in a frame. The ready bit of a read is its last pad bit
+** and the data follows it.
+*/
+const DWORD ibitJrWrite     = 1;
+const DWORD ibitJrAdr       = 2;
+const DWORD ibitJrData      = 10;
+const DWORD ibitJrReady     = ibitJrData + cbitJrPad - 1;
+const DWORD ibitJrDout      = ibitJrData + cbitJrPad;
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static DWORD    CbitPutFrame(BYTE * rgb, DWORD ibit, BOOL fWrite, BYTE bAdr, BYTE bDin);
+static void     PutBits(BYTE * rgb, DWORD ibit, DWORD dw, DWORD cbit);
+static DWORD    GetBits(const BYTE * rgb, DWORD ibit, DWORD cbit);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgReg::JtgReg
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a transport that isn't attached to a port.
+*/
+JtgReg::JtgReg() : tap(fTrue) {
+
+    hif = hifInvalid;
+    memset(&chn, 0, sizeof(JRCHAIN));
+    rgbTdi = NULL;
+    rgbTdo = NULL;
+    cbBuf = 0;
+    ccall = 0;
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::~JtgReg
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the scan buffers.
+*/
+JtgReg::~JtgReg() {
+
+    free(rgbTdi);
+    free(rgbTdo);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FInit
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**      pchnReq     - position of the FPGA in the scan chain
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the chain isn't supported, a DJTG call fails, the FPGA
+**      isn't found at the given position or the bridge doesn't answer.
+**
+**  Description:
+**      Reset the chain, load USER1 into the FPGA and BYPASS into the
+**      others, and go to Shift-DR. A read of register 0 is sent in the
+**      same call to check that the bridge is there.
+*/
+BOOL
+JtgReg::FInit( HIF hifReq, const JRCHAIN * pchnReq ) {
+
+    BYTE    rgbIr[cbitJrIrMax / 8];
+    BYTE *  rgbSeqTdo;
+    DWORD   cbitIr;
+    DWORD   cbitProbe;
+    DWORD   ibitIr;
+    DWORD   ibitProbe;
+    DWORD   bCapture;
+    DWORD   fReady;
+
+    hif = hifReq;
+    chn = *pchnReq;
+    ccall = 0;
+    szError[0] = '\0';
+
+    cbitIr = chn.cbitHir + chn.cbitIr + chn.cbitTir;
+
+    if (( 2 > chn.cbitIr ) || ( 8 < chn.cbitIr ) || ( (1UL << chn.cbitIr) <= chn.irUser ) ||
+        ( cbitJrIrMax < cbitIr )) {
+        return FFail("unsupported IR lengths");
+    }
+
+    cbitProbe = cbitJrRead + chn.cbitTdr + chn.cbitHdr;
+
+    if ( ! FAlloc(cbitProbe) ) {
+        return FFail("out of memory");
+    }
+
+    memset(rgbIr, 0xFF, sizeof(rgbIr));
+    PutBits(rgbIr, chn.cbitHir, chn.irUser, chn.cbitIr);
+
+    memset(rgbTdi, 0, (cbitProbe + 7) / 8);
+    CbitPutFrame(rgbTdi, 0, fFalse, 0, 0);
+
+    tap.Clear();
+
+    if (( ! tap.FReset() ) || ( ! tap.FMoveTo(tpsShIR) )) {
+        return FFail("out of memory");
+    }
+
+    ibitIr = tap.CbitSeq();
+
+    if (( ! tap.FShift(rgbIr, cbitIr, fTrue) ) || ( ! tap.FMoveTo(tpsShDR) )) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    ibitProbe = tap.CbitSeq();
+
+    if ( ! tap.FShift(rgbTdi, cbitProbe, fFalse) ) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    rgbSeqTdo = (BYTE *)calloc((tap.CbitSeq() + 7) / 8, 1);
+    if ( NULL == rgbSeqTdo ) {
+        tap.Clear();
+        return FFail("out of memory");
+    }
+
+    if ( ! tap.FFlush(hif, fFalse, rgbSeqTdo) ) {
+        free(rgbSeqTdo);
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    ccall++;
+
+    bCapture = GetBits(rgbSeqTdo, ibitIr + chn.cbitHir, 2);
+    fReady = GetBits(rgbSeqTdo, ibitProbe + chn.cbitTdr + chn.cbitHdr + ibitJrReady, 1);
+
+    free(rgbSeqTdo);
+
+    if ( 0x01 != bCapture ) {
+        return FFail("no IR capture value at the position given");
+    }
+
+    if ( ! fReady ) {
+        return FFail("the register bridge doesn't answer in USER1");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FEnd
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Leave Shift-DR for Run-Test/Idle, so that the port can be used
+**      for other scans.
+*/
+BOOL
+JtgReg::FEnd() {
+
+    if ( tpsShDR != tap.Tps() ) {
+        return fTrue;
+    }
+
+    if (( ! tap.FMoveTo(tpsRTI) ) || ( ! tap.FFlush(hif, fFalse) )) {
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    ccall++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FPutReg
+**
+**  Parameters:
+**      bAddr       - register address
+**      bData       - value to write
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write a register, as DeppPutReg.
+*/
+BOOL
+JtgReg::FPutReg( BYTE bAddr, BYTE bData ) {
+
+    return FRun(1, &bAddr, 0, &bData, 0, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FGetReg
+**
+**  Parameters:
+**      bAddr       - register address
+**      pbData      - receives the value read
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read a register, as DeppGetReg.
+*/
+BOOL
+JtgReg::FGetReg( BYTE bAddr, BYTE * pbData ) {
+
+    return FRun(1, &bAddr, 0, NULL, 0, pbData);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FPutRegSet
+**
+**  Parameters:
+**      pbAddrData      - address/data pairs
+**      nAddrDataPairs  - number of pairs
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write a set of registers in order, as DeppPutRegSet.
+*/
+BOOL
+JtgReg::FPutRegSet( const BYTE * pbAddrData, DWORD nAddrDataPairs ) {
+
+    return FRun(nAddrDataPairs, pbAddrData, 2, pbAddrData + 1, 2, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FGetRegSet
+**
+**  Parameters:
+**      pbAddr      - addresses of the registers
+**      pbData      - receives one value per address
+**      cbData      - number of registers
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read a set of registers in order, as DeppGetRegSet.
+*/
+BOOL
+JtgReg::FGetRegSet( const BYTE * pbAddr, BYTE * pbData, DWORD cbData ) {
+
+    return FRun(cbData, pbAddr, 1, NULL, 0, pbData);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FPutRegRepeat
+**
+**  Parameters:
+**      bAddr       - register address
+**      pbData      - values to write
+**      cbData      - number of values
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write one register repeatedly, as DeppPutRegRepeat.
+*/
+BOOL
+JtgReg::FPutRegRepeat( BYTE bAddr, const BYTE * pbData, DWORD cbData ) {
+
+    return FRun(cbData, &bAddr, 0, pbData, 1, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FGetRegRepeat
+**
+**  Parameters:
+**      bAddr       - register address
+**      pbData      - receives the values read
+**      cbData      - number of values
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read one register repeatedly, as DeppGetRegRepeat.
+*/
+BOOL
+JtgReg::FGetRegRepeat( BYTE bAddr, BYTE * pbData, DWORD cbData ) {
+
+    return FRun(cbData, &bAddr, 0, NULL, 0, pbData);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FRun
+**
+**  Parameters:
+**      cacc        - number of accesses
+**      rgbAdr      - address of the first access
+**      dbAdr       - distance between the addresses, 0 to repeat one
+**      rgbDin      - data of the first write, NULL for reads
+**      dbDin       - distance between the data bytes
+**      rgbDout     - receives the data read, NULL for writes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if FInit hasn't succeeded, a DJTG call fails or a read
+**      isn't answered in time.
+**
+**  Description:
+**      Make a series of reads or writes, cjrCallMax to a call. Writes
+**      are sent without reading TDO.
+*/
+BOOL
+JtgReg::FRun( DWORD cacc, const BYTE * rgbAdr, DWORD dbAdr,
+              const BYTE * rgbDin, DWORD dbDin, BYTE * rgbDout ) {
+
+    DWORD   caccCall;
+    DWORD   iacc;
+    DWORD   cbitFrame;
+    DWORD   cbit;
+    DWORD   ibit;
+    BOOL    fWrite;
+
+    if ( tpsShDR != tap.Tps() ) {
+        return FFail("the register bridge isn't selected");
+    }
+
+    fWrite = ( NULL != rgbDin );
+    cbitFrame = fWrite ? cbitJrWrite : cbitJrRead;
+
+    while ( 0 < cacc ) {
+
+        caccCall = ( cjrCallMax < cacc ) ? cjrCallMax : cacc;
+        cbit = caccCall * cbitFrame + chn.cbitTdr + chn.cbitHdr;
+
+        if ( ! FAlloc(cbit) ) {
+            return FFail("out of memory");
+        }
+
+        memset(rgbTdi, 0, (cbit + 7) / 8);
+
+        for ( iacc = 0, ibit = 0; iacc < caccCall; iacc++ ) {
+            ibit += CbitPutFrame(rgbTdi, ibit, fWrite, *rgbAdr, fWrite ? *rgbDin : 0);
+            rgbAdr += dbAdr;
+            rgbDin += fWrite ? dbDin : 0;
+        }
+
+        if ( ! DjtgPutTdiBits(hif, fFalse, rgbTdi, fWrite ? NULL : rgbTdo, cbit, fFalse) ) {
+            return FFail("DjtgPutTdiBits failed");
+        }
+
+        ccall++;
+
+        /* The replies come back delayed by the bypass registers on both
+        ** sides of the FPGA.
+        */
+        if ( ! fWrite ) {
+
+            ibit = chn.cbitTdr + chn.cbitHdr;
+
+            for ( iacc = 0; iacc < caccCall; iacc++, ibit += cbitJrRead ) {
+
+                if ( ! GetBits(rgbTdo, ibit + ibitJrReady, 1) ) {
+                    return FFail("a register read wasn't answered in time, lower TCK");
+                }
+
+                *rgbDout++ = (BYTE)GetBits(rgbTdo, ibit + ibitJrDout, 8);
+            }
+        }
+
+        cacc -= caccCall;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FAlloc
+**
+**  Parameters:
+**      cbit        - number of bits the buffers must hold
+**
+**  Return Values:
+**      fTrue for success, fFalse if memory can't be allocated
+**
+**  Errors:
+**
+**  Description:
+**      Grow the TDI and TDO buffers to hold a scan.
+*/
+BOOL
+JtgReg::FAlloc( DWORD cbit ) {
+
+    DWORD   cbNew;
+    BYTE *  rgbTdiNew;
+    BYTE *  rgbTdoNew;
+
+    cbNew = (cbit + 7) / 8;
+
+    if ( cbNew <= cbBuf ) {
+        return fTrue;
+    }
+
+    rgbTdiNew = (BYTE *)realloc(rgbTdi, cbNew);
+    if ( NULL == rgbTdiNew ) {
+        return fFalse;
+    }
+    rgbTdi = rgbTdiNew;
+
+    rgbTdoNew = (BYTE *)realloc(rgbTdo, cbNew);
+    if ( NULL == rgbTdoNew ) {
+        return fFalse;
+    }
+    rgbTdo = rgbTdoNew;
+
+    cbBuf = cbNew;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgReg::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**
+**  Return Values:
+**      fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message. The first message is kept.
+*/
+BOOL
+JtgReg::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    va_start(ap, szFmt);
+    vsnprintf(szError, sizeof(szError), szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    CbitPutFrame
+**
+**  Parameters:
+**      rgb         - scan buffer, cleared
+**      ibit        - position of the frame
+**      fWrite      - fTrue for a write, fFalse for a read
+**      bAdr        - register address
+**      bDin        - data of a write
+**
+**  Return Values:
+**      length of the frame in bits
+**
+**  Errors:
+**
+**  Description:
+**      Put an access frame into a scan. The pad and data bits of a read
+**      are left at zero.
+*/
+static DWORD
+CbitPutFrame( BYTE * rgb, DWORD ibit, BOOL fWrite, BYTE bAdr, BYTE bDin ) {
+
+    PutBits(rgb, ibit, 1, 1);
+    PutBits(rgb, ibit + ibitJrWrite, fWrite ? 1 : 0, 1);
+    PutBits(rgb, ibit + ibitJrAdr, bAdr, 8);
+
+    if ( ! fWrite ) {
+        return cbitJrRead;
+    }
+
+    PutBits(rgb, ibit + ibitJrData, bDin, 8);
+
+    return cbitJrWrite;
+}
+
+/* ------------------------------------------------------------ */
+/***    PutBits
+**
+**  Parameters:
+**      rgb         - buffer
+**      ibit        - first bit
+**      dw          - value, LSB first
+**      cbit        - number of bits, 32 at most
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set bits of a buffer to a value.
+*/
+static void
+PutBits( BYTE * rgb, DWORD ibit, DWORD dw, DWORD cbit ) {
+
+    for ( ; 0 < cbit; cbit--, ibit++, dw >>= 1 ) {
+        if ( dw & 1 ) {
+            rgb[ibit / 8] |= 1 << (ibit % 8);
+        }
+        else {
+            rgb[ibit / 8] &= ~(1 << (ibit % 8));
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    GetBits
+**
+**  Parameters:
+**      rgb         - buffer
+**      ibit        - first bit
+**      cbit        - number of bits, 32 at most
+**
+**  Return Values:
+**      value of the bits, LSB first
+**
+**  Errors:
+**
+**  Description:
+**      Read bits of a buffer.
+*/
+static DWORD
+GetBits( const BYTE * rgb, DWORD ibit, DWORD cbit ) {
+
+    DWORD   dw;
+    DWORD   ibitVal;
+
+    dw = 0;
+    for ( ibitVal = 0; ibitVal < cbit; ibitVal++, ibit++ ) {
+        if ( rgb[ibit / 8] & (1 << (ibit % 8)) ) {
+            dw |= (DWORD)1 << ibitVal;
+        }
+    }
+
+    return dw;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
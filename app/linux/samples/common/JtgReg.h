@@ -0,0 +1,117 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgReg.h  --    Interface Declarations for JtgReg.cpp             */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the host */
+/*    side of the JTAG register bridge in fpga/jtgref.vhd. The bridge   */
+/*    gives the registers of dpimref through the USER1 instruction of   */
+/*    the FPGA, and this module gives the same accesses as the DEPP     */
+/*    register calls: single registers, sets of address/data pairs and  */
+/*    repeated accesses to one address.                                 */
+/*                                                                      */
+/*    Each access is a frame of bits in a DR scan. FInit loads USER1    */
+/*    and leaves the TAP controller in Shift-DR, so every later call    */
+/*    is a single DjtgPutTdiBits call that holds all of its frames, up  */
+/*    to cjrCallMax of them. JtgTap.h must be included before this      */
+/*    header.                                                           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGREG_INCLUDED)
+#define      JTGREG_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* USER1 opcode and IR length of the Spartan-6 and 7 series families.
+*/
+const BYTE  irJrUser1           = 0x02;
+const DWORD cbitJrIrDefault     = 6;
+const DWORD cbitJrIrMax         = 256;
+
+/* Frame lengths. A frame is a start bit, a write bit, the address and
+** either the data written or, for a read, cbitJrPad bits during which
+** the register is read and the eight bits of data it returns. This
+** must match read_pad of jtgref, and TCK must be at most the FPGA clock
+** times (cbitJrPad - 3) / 6, which with 9 is the FPGA clock itself.
+*/
+const DWORD cbitJrPad           = 9;
+const DWORD cbitJrWrite         = 18;
+const DWORD cbitJrRead          = 18 + cbitJrPad;
+
+/* Largest number of accesses sent with one call.
+*/
+const DWORD cjrCallMax          = 4096;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Position of the FPGA in the scan chain, given as in SVF, and the
+** instruction that selects the bridge.
+*/
+typedef struct {
+    DWORD   cbitIr;             // IR length of the FPGA
+    DWORD   irUser;
+    DWORD   cbitHir;
+    DWORD   cbitTir;
+    DWORD   cbitHdr;
+    DWORD   cbitTdr;
+} JRCHAIN;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgReg {
+
+private:
+    HIF         hif;
+    JtgTap      tap;
+    JRCHAIN     chn;
+    BYTE *      rgbTdi;
+    BYTE *      rgbTdo;
+    DWORD       cbBuf;
+    DWORD       ccall;
+    char        szError[256];
+
+    BOOL    FFail(const char * szFmt, ...);
+    BOOL    FAlloc(DWORD cbit);
+    BOOL    FRun(DWORD cacc, const BYTE * rgbAdr, DWORD dbAdr,
+                 const BYTE * rgbDin, DWORD dbDin, BYTE * rgbDout);
+
+    JtgReg(const JtgReg &);
+    JtgReg & operator=(const JtgReg &);
+
+public:
+    JtgReg();
+    ~JtgReg();
+
+    BOOL    FInit(HIF hifReq, const JRCHAIN * pchnReq);
+    BOOL    FEnd();
+
+    BOOL    FPutReg(BYTE bAddr, BYTE bData);
+    BOOL    FGetReg(BYTE bAddr, BYTE * pbData);
+    BOOL    FPutRegSet(const BYTE * pbAddrData, DWORD nAddrDataPairs);
+    BOOL    FGetRegSet(const BYTE * pbAddr, BYTE * pbData, DWORD cbData);
+    BOOL    FPutRegRepeat(BYTE bAddr, const BYTE * pbData, DWORD cbData);
+    BOOL    FGetRegRepeat(BYTE bAddr, BYTE * pbData, DWORD cbData);
+
+    DWORD           Ccall() const { return ccall; }
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGREG_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,702 @@
+/************************************************************************/
+/*                                                                      */
+/*  JtgTap.cpp  --  TAP controller state tracking                       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the TAP controller model declared in         */
+/*  JtgTap.h.                                                           */
+/*                                                                      */
+/*  The shortest TMS path from every state to every other state is      */
+/*  found with a breadth first search of the state diagram, which is    */
+/*  run by the compiler. A move is then a table lookup: at most eight   */
+/*  TMS bits, which are kept both as plain bits and already spread      */
+/*  into TMS/TDI pairs.                                                 */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: shifts are spread into pairs with JbInterleave          */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBits.h"
+#include "JtgTap.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Initial size of the sequence buffer.
+*/
+const DWORD     cbSeqInitial = 64;
+
+/* Size of the buffer that holds TDI bits of a shift that don't start
+** on a byte boundary.
+*/
+const DWORD     cbShiftChunk = 256;
+
+/* Shortest path between two states. TMS is sent LSB first. In wPairs
+** each TMS bit is in the upper bit of a pair, with TDI low.
+*/
+typedef struct {
+    BYTE    bTms;
+    BYTE    cbit;
+    WORD    wPairs;
+} TAPPATH;
+
+typedef struct {
+    TAPPATH rgpath[ctpsMax][ctpsMax];
+} TAPTBL;
+
+/* Next state for TMS low and TMS high.
+*/
+constexpr BYTE  rgtpsNext[ctpsMax][2] = {
+    { tpsRTI,   tpsTLR   },     // tpsTLR
+    { tpsRTI,   tpsSelDR },     // tpsRTI
+    { tpsCapDR, tpsSelIR },     // tpsSelDR
+    { tpsShDR,  tpsEx1DR },     // tpsCapDR
+    { tpsShDR,  tpsEx1DR },     // tpsShDR
+    { tpsPauDR, tpsUpdDR },     // tpsEx1DR
+    { tpsPauDR, tpsEx2DR },     // tpsPauDR
+    { tpsShDR,  tpsUpdDR },     // tpsEx2DR
+    { tpsRTI,   tpsSelDR },     // tpsUpdDR
+    { tpsCapIR, tpsTLR   },     // tpsSelIR
+    { tpsShIR,  tpsEx1IR },     // tpsCapIR
+    { tpsShIR,  tpsEx1IR },     // tpsShIR
+    { tpsPauIR, tpsUpdIR },     // tpsEx1IR
+    { tpsPauIR, tpsEx2IR },     // tpsPauIR
+    { tpsShIR,  tpsUpdIR },     // tpsEx2IR
+    { tpsRTI,   tpsSelDR }      // tpsUpdIR
+};
+
+/* ------------------------------------------------------------ */
+/*                  Table Construction                          */
+/* ------------------------------------------------------------ */
+/***    TblTapBuild
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      table of the shortest paths
+**
+**  Errors:
+**
+**  Description:
+**      Search the state diagram breadth first from each state, then
+**      walk back from every other state to collect its TMS bits. TMS
+**      low is tried first, so of two paths of the same length the one
+**      that stays low longer is taken. Evaluated by the compiler.
+*/
+static constexpr TAPTBL
+TblTapBuild() {
+
+    TAPTBL  tbl = {};
+
+    for ( BYTE tpsFrom = 0; tpsFrom < ctpsMax; tpsFrom++ ) {
+
+        BYTE    rgtpsPrev[ctpsMax] = {};
+        BYTE    rgfTms[ctpsMax] = {};
+        BYTE    rgtpsQueue[ctpsMax] = {};
+        BOOL    rgfSeen[ctpsMax] = {};
+        int     itpsHead = 0;
+        int     ctpsQueue = 1;
+
+        rgtpsQueue[0] = tpsFrom;
+        rgfSeen[tpsFrom] = fTrue;
+
+        while ( itpsHead < ctpsQueue ) {
+
+            BYTE tpsCur = rgtpsQueue[itpsHead++];
+
+            for ( int fTms = 0; fTms < 2; fTms++ ) {
+
+                BYTE tpsNext = rgtpsNext[tpsCur][fTms];
+                if ( ! rgfSeen[tpsNext] ) {
+                    rgfSeen[tpsNext] = fTrue;
+                    rgtpsPrev[tpsNext] = tpsCur;
+                    rgfTms[tpsNext] = (BYTE)fTms;
+                    rgtpsQueue[ctpsQueue++] = tpsNext;
+                }
+            }
+        }
+
+        for ( BYTE tpsTo = 0; tpsTo < ctpsMax; tpsTo++ ) {
+
+            TAPPATH &   path = tbl.rgpath[tpsFrom][tpsTo];
+            BYTE        tpsCur = tpsTo;
+
+            while ( tpsCur != tpsFrom ) {
+                path.bTms = (BYTE)((path.bTms << 1) | rgfTms[tpsCur]);
+                path.wPairs = (WORD)((path.wPairs << 2) | (rgfTms[tpsCur] << 1));
+                path.cbit++;
+                tpsCur = rgtpsPrev[tpsCur];
+            }
+        }
+    }
+
+    return tbl;
+}
+
+/* ------------------------------------------------------------ */
+/***    FTblTapValid
+**
+**  Parameters:
+**      tbl         - table of the shortest paths
+**
+**  Return Values:
+**      fTrue if every path fits in a byte, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check the table at compile time.
+*/
+static constexpr BOOL
+FTblTapValid( const TAPTBL & tbl ) {
+
+    for ( BYTE tpsFrom = 0; tpsFrom < ctpsMax; tpsFrom++ ) {
+        for ( BYTE tpsTo = 0; tpsTo < ctpsMax; tpsTo++ ) {
+
+            if (( 8 < tbl.rgpath[tpsFrom][tpsTo].cbit ) ||
+                (( tpsFrom != tpsTo ) && ( 0 == tbl.rgpath[tpsFrom][tpsTo].cbit ))) {
+                return fFalse;
+            }
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+static constexpr TAPTBL tblTap = TblTapBuild();
+
+static_assert(FTblTapValid(tblTap), "a TAP path is longer than 8 bits");
+static_assert(( 0x01 == tblTap.rgpath[tpsRTI][tpsShDR].bTms ) &&
+              ( 3 == tblTap.rgpath[tpsRTI][tpsShDR].cbit ), "RTI->SDR");
+static_assert(( 0x03 == tblTap.rgpath[tpsShDR][tpsRTI].bTms ) &&
+              ( 3 == tblTap.rgpath[tpsShDR][tpsRTI].cbit ), "SDR->RTI");
+static_assert(( 0x0D == tblTap.rgpath[tpsRTI][tpsUpdDR].bTms ) &&
+              ( 4 == tblTap.rgpath[tpsRTI][tpsUpdDR].cbit ), "RTI->UDR");
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    JtgTap::JtgTap
+**
+**  Parameters:
+**      fPairsReq   - fTrue to keep the sequence as TMS/TDI pairs
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a model with an empty sequence. The state of the TAP
+**      controller isn't known until FReset has been called.
+*/
+JtgTap::JtgTap( BOOL fPairsReq ) {
+
+    tps = tpsTLR;
+    fPairs = fPairsReq;
+    rgbSeq = NULL;
+    cbSeqMax = 0;
+    cbitSeq = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::~JtgTap
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the sequence buffer.
+*/
+JtgTap::~JtgTap() {
+
+    free(rgbSeq);
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FReset
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append the TMS high clocks that reset the TAP controller from
+**      any state, including one that isn't known.
+*/
+BOOL
+JtgTap::FReset() {
+
+    DWORD   ibit;
+
+    for ( ibit = 0; ibit < cbitTapReset; ibit++ ) {
+        if ( fPairs ? ! FAppendPair(fTrue, fFalse) : ! FAppend(1, 1) ) {
+            return fFalse;
+        }
+    }
+
+    tps = tpsTLR;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FMoveTo
+**
+**  Parameters:
+**      tpsTo       - state to move to
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append the shortest path from the current state to tpsTo.
+**      Nothing is appended if the controller is already in tpsTo, so a
+**      caller that needs to pass through a state again moves to a
+**      state beyond it first.
+*/
+BOOL
+JtgTap::FMoveTo( BYTE tpsTo ) {
+
+    const TAPPATH * ppath = &tblTap.rgpath[tps][tpsTo];
+
+    if ( fPairs ? ! FAppend(ppath->wPairs, 2 * ppath->cbit) : ! FAppend(ppath->bTms, ppath->cbit) ) {
+        return fFalse;
+    }
+
+    tps = tpsTo;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FHold
+**
+**  Parameters:
+**      cclk        - number of TCK cycles
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append TCK cycles with TMS low. In Shift-DR or Shift-IR this
+**      passes through the shift state once per cycle, and in a stable
+**      state it keeps the controller there.
+*/
+BOOL
+JtgTap::FHold( DWORD cclk ) {
+
+    DWORD   cbit;
+
+    while ( 0 < cclk ) {
+
+        cbit = ( 16 < cclk ) ? 16 : cclk;
+        if ( ! FAppend(0, fPairs ? 2 * cbit : cbit) ) {
+            return fFalse;
+        }
+
+        cclk -= cbit;
+        while (( 0 < cbit-- ) && ( tps != rgtpsNext[tps][0] )) {
+            tps = rgtpsNext[tps][0];
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FShift
+**
+**  Parameters:
+**      rgbTdi      - bits to send LSB first, or NULL to send zeros
+**      cbit        - number of bits
+**      fExit       - fTrue to leave the shift state on the last bit
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the sequence isn't kept as pairs, the controller isn't
+**      in Shift-DR or Shift-IR, or memory can't be allocated.
+**
+**  Description:
+**      Append a shift to the sequence of pairs. The bits are copied.
+**      A few pairs are appended one at a time until the sequence ends
+**      on a byte boundary; the bits up to the last one are then spread
+**      into pairs with JbInterleave, a chunk at a time, and the last
+**      pair carries the exit. TDI bits that don't start on a byte
+**      boundary are first shifted into a local buffer. A long shift is
+**      still cheaper to send with DjtgPutTdiBits, which takes one bit
+**      per TCK cycle instead of two.
+*/
+BOOL
+JtgTap::FShift( const BYTE * rgbTdi, DWORD cbit, BOOL fExit ) {
+
+    BYTE    rgbChunk[cbShiftChunk];
+    DWORD   cbTdi;
+    DWORD   ibit;
+    DWORD   cbitChunk;
+    DWORD   ib;
+    DWORD   ibSrc;
+    DWORD   sh;
+    BOOL    fTdi;
+
+    if (( ! fPairs ) || (( tpsShDR != tps ) && ( tpsShIR != tps ))) {
+        return fFalse;
+    }
+
+    if ( 0 == cbit ) {
+        return fTrue;
+    }
+
+    cbTdi = (cbit + 7) / 8;
+
+    for ( ibit = 0; ( ibit + 1 < cbit ) && ( 0 != cbitSeq % 4 ); ibit++ ) {
+
+        fTdi = ( NULL != rgbTdi ) && ( rgbTdi[ibit / 8] & (1 << (ibit % 8)) );
+        if ( ! FAppendPair(fFalse, fTdi) ) {
+            return fFalse;
+        }
+    }
+
+    if ( ibit + 1 < cbit ) {
+
+        if ( ! FGrow((2 * (cbitSeq + cbit - 1 - ibit) + 7) / 8) ) {
+            return fFalse;
+        }
+
+        sh = ibit % 8;
+
+        while ( ibit + 1 < cbit ) {
+
+            cbitChunk = cbit - 1 - ibit;
+            if ( 8 * cbShiftChunk < cbitChunk ) {
+                cbitChunk = 8 * cbShiftChunk;
+            }
+
+            if (( NULL == rgbTdi ) || ( 0 == sh )) {
+                JbInterleave(NULL, ( NULL != rgbTdi ) ? &rgbTdi[ibit / 8] : NULL,
+                             &rgbSeq[2 * cbitSeq / 8], cbitChunk);
+            }
+            else {
+                for ( ib = 0; ib < (cbitChunk + 7) / 8; ib++ ) {
+
+                    ibSrc = ibit / 8 + ib;
+                    rgbChunk[ib] = rgbTdi[ibSrc] >> sh;
+                    if ( ibSrc + 1 < cbTdi ) {
+                        rgbChunk[ib] |= rgbTdi[ibSrc + 1] << (8 - sh);
+                    }
+                }
+                JbInterleave(NULL, rgbChunk, &rgbSeq[2 * cbitSeq / 8], cbitChunk);
+            }
+
+            cbitSeq += cbitChunk;
+            ibit += cbitChunk;
+        }
+    }
+
+    fTdi = ( NULL != rgbTdi ) && ( rgbTdi[ibit / 8] & (1 << (ibit % 8)) );
+    if ( ! FAppendPair(fExit, fTdi) ) {
+        return fFalse;
+    }
+
+    if ( fExit ) {
+        tps = rgtpsNext[tps][1];
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FFlush
+**
+**  Parameters:
+**      hif         - open handle with DJTG enabled
+**      fTdi        - TDI value for a sequence of plain TMS bits
+**      rgbTdo      - receives one TDO bit per TMS bit or pair, or NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the DJTG call fails. The sequence is cleared anyway.
+**
+**  Description:
+**      Send the sequence with one DjtgPutTmsBits or DjtgPutTmsTdiBits
+**      call and clear it. The TDO bit of a shift appended at CbitSeq()
+**      pairs is found at that offset in rgbTdo, so moves and shifts
+**      whose results are needed still cost a single call.
+*/
+BOOL
+JtgTap::FFlush( HIF hif, BOOL fTdi, BYTE * rgbTdo ) {
+
+    BOOL    fOk;
+
+    if ( 0 == cbitSeq ) {
+        return fTrue;
+    }
+
+    if ( fPairs ) {
+        fOk = DjtgPutTmsTdiBits(hif, rgbSeq, rgbTdo, cbitSeq, fFalse);
+    }
+    else {
+        fOk = DjtgPutTmsBits(hif, fTdi, rgbSeq, rgbTdo, cbitSeq, fFalse);
+    }
+
+    cbitSeq = 0;
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FAppend
+**
+**  Parameters:
+**      dwTms       - bits to append, LSB first
+**      cbit        - number of bits, at most 32, and even for pairs
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append raw bits to the sequence buffer. For a sequence of pairs
+**      every two bits count as one entry of cbitSeq.
+*/
+BOOL
+JtgTap::FAppend( DWORD dwTms, DWORD cbit ) {
+
+    DWORD   ibitBuf;
+    DWORD   ibit;
+
+    ibitBuf = fPairs ? 2 * cbitSeq : cbitSeq;
+
+    if ( ! FGrow((ibitBuf + cbit + 7) / 8) ) {
+        return fFalse;
+    }
+
+    for ( ibit = 0; ibit < cbit; ibit++, ibitBuf++ ) {
+
+        if ( 0 == ibitBuf % 8 ) {
+            rgbSeq[ibitBuf / 8] = 0;
+        }
+        rgbSeq[ibitBuf / 8] |= ((dwTms >> ibit) & 1) << (ibitBuf % 8);
+    }
+
+    cbitSeq += fPairs ? cbit / 2 : cbit;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FGrow
+**
+**  Parameters:
+**      cbNeed      - number of bytes the sequence buffer must hold
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Make the sequence buffer at least cbNeed bytes long, doubling
+**      its size so that appending stays cheap.
+*/
+BOOL
+JtgTap::FGrow( DWORD cbNeed ) {
+
+    DWORD   cb;
+    BYTE *  pb;
+
+    if ( cbNeed <= cbSeqMax ) {
+        return fTrue;
+    }
+
+    for ( cb = ( 0 != cbSeqMax ) ? cbSeqMax : cbSeqInitial; cb < cbNeed; cb *= 2 ) {
+    }
+
+    pb = (BYTE *)realloc(rgbSeq, cb);
+    if ( NULL == pb ) {
+        return fFalse;
+    }
+
+    rgbSeq = pb;
+    cbSeqMax = cb;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    JtgTap::FAppendPair
+**
+**  Parameters:
+**      fTms        - TMS value
+**      fTdi        - TDI value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append one TMS/TDI pair to a sequence of pairs.
+*/
+BOOL
+JtgTap::FAppendPair( BOOL fTms, BOOL fTdi ) {
+
+    return FAppend((fTms ? 2 : 0) | (fTdi ? 1 : 0), 2);
+}
+
+/* ------------------------------------------------------------ */
+/***    TpsTapNext
+**
+**  Parameters:
+**      tpsFrom     - current state
+**      fTms        - TMS value of the next TCK cycle
+**
+**  Return Values:
+**      state after the cycle
+**
+**  Errors:
+**
+**  Description:
+**      Return the state the TAP controller goes to on one TCK cycle.
+*/
+BYTE
+TpsTapNext( BYTE tpsFrom, BOOL fTms ) {
+
+    return rgtpsNext[tpsFrom][fTms ? 1 : 0];
+}
+
+/* ------------------------------------------------------------ */
+/***    CbitTapPath
+**
+**  Parameters:
+**      tpsFrom     - starting state
+**      tpsTo       - final state
+**
+**  Return Values:
+**      number of TMS bits in the shortest path
+**
+**  Errors:
+**
+**  Description:
+**      Return the length of the shortest path between two states.
+*/
+BYTE
+CbitTapPath( BYTE tpsFrom, BYTE tpsTo ) {
+
+    return tblTap.rgpath[tpsFrom][tpsTo].cbit;
+}
+
+/* ------------------------------------------------------------ */
+/***    BTapPath
+**
+**  Parameters:
+**      tpsFrom     - starting state
+**      tpsTo       - final state
+**
+**  Return Values:
+**      TMS bits of the shortest path, LSB first
+**
+**  Errors:
+**
+**  Description:
+**      Return the TMS bits that move the controller between two states.
+*/
+BYTE
+BTapPath( BYTE tpsFrom, BYTE tpsTo ) {
+
+    return tblTap.rgpath[tpsFrom][tpsTo].bTms;
+}
+
+/* ------------------------------------------------------------ */
+/***    WTapPathPairs
+**
+**  Parameters:
+**      tpsFrom     - starting state
+**      tpsTo       - final state
+**
+**  Return Values:
+**      TMS/TDI pairs of the shortest path, first pair in bits 0 and 1
+**
+**  Errors:
+**
+**  Description:
+**      Return the shortest path in the format taken by
+**      DjtgPutTmsTdiBits, with TDI low.
+*/
+WORD
+WTapPathPairs( BYTE tpsFrom, BYTE tpsTo ) {
+
+    return tblTap.rgpath[tpsFrom][tpsTo].wPairs;
+}
+
+/* ------------------------------------------------------------ */
+/***    FTapStable
+**
+**  Parameters:
+**      tpsCheck    - TAP state
+**
+**  Return Values:
+**      fTrue if the state is stable, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check for a state the TAP controller stays in while TMS is held:
+**      Test-Logic-Reset, Run-Test/Idle, Pause-DR and Pause-IR.
+*/
+BOOL
+FTapStable( BYTE tpsCheck ) {
+
+    return ( tpsTLR == tpsCheck ) || ( tpsRTI == tpsCheck ) ||
+           ( tpsPauDR == tpsCheck ) || ( tpsPauIR == tpsCheck );
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,113 @@
+/************************************************************************/
+/*                                                                      */
+/*    JtgTap.h  --      Interface Declarations for JtgTap.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a model  */
+/*    of the TAP controller. The model knows the state the controller   */
+/*    is in and produces the TMS bits that move it to another state     */
+/*    along the shortest path. The paths between every pair of states   */
+/*    are computed when the module is compiled.                         */
+/*                                                                      */
+/*    Moves are not sent as they are made. They are appended to a       */
+/*    sequence that is sent with a single DjtgPutTmsBits call when the  */
+/*    caller needs the TAP controller to be in its new state, so that   */
+/*    moves made one after the other cost one call. A model created     */
+/*    for TMS/TDI pairs keeps the sequence in the format taken by       */
+/*    DjtgPutTmsTdiBits instead, and a short shift can then be appended */
+/*    to it as well: the move to the shift state, the shift, and the    */
+/*    move out of it are sent together.                                 */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(JTGTAP_INCLUDED)
+#define      JTGTAP_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* TAP controller states, numbered as in the XSVF format.
+*/
+const BYTE  tpsTLR          = 0;
+const BYTE  tpsRTI          = 1;
+const BYTE  tpsSelDR        = 2;
+const BYTE  tpsCapDR        = 3;
+const BYTE  tpsShDR         = 4;
+const BYTE  tpsEx1DR        = 5;
+const BYTE  tpsPauDR        = 6;
+const BYTE  tpsEx2DR        = 7;
+const BYTE  tpsUpdDR        = 8;
+const BYTE  tpsSelIR        = 9;
+const BYTE  tpsCapIR        = 10;
+const BYTE  tpsShIR         = 11;
+const BYTE  tpsEx1IR        = 12;
+const BYTE  tpsPauIR        = 13;
+const BYTE  tpsEx2IR        = 14;
+const BYTE  tpsUpdIR        = 15;
+const BYTE  ctpsMax         = 16;
+
+/* Number of TMS high clocks that put the TAP controller in
+** Test-Logic-Reset from any state.
+*/
+const DWORD cbitTapReset    = 5;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class JtgTap {
+
+private:
+    BYTE        tps;
+    BOOL        fPairs;         // the sequence holds TMS/TDI pairs
+    BYTE *      rgbSeq;
+    DWORD       cbSeqMax;
+    DWORD       cbitSeq;        // TMS bits or pairs in the sequence
+
+    BOOL    FGrow(DWORD cbNeed);
+    BOOL    FAppend(DWORD dwTms, DWORD cbit);
+    BOOL    FAppendPair(BOOL fTms, BOOL fTdi);
+
+    JtgTap(const JtgTap &);
+    JtgTap & operator=(const JtgTap &);
+
+public:
+    JtgTap(BOOL fPairsReq = fFalse);
+    ~JtgTap();
+
+    BOOL    FReset();
+    BOOL    FMoveTo(BYTE tpsTo);
+    BOOL    FHold(DWORD cclk);
+    BOOL    FShift(const BYTE * rgbTdi, DWORD cbit, BOOL fExit);
+    BOOL    FFlush(HIF hif, BOOL fTdi, BYTE * rgbTdo = NULL);
+    void    Clear() { cbitSeq = 0; }
+
+    BYTE            Tps() const { return tps; }
+    void            SetTps(BYTE tpsNew) { tps = tpsNew; }
+    const BYTE *    RgbSeq() const { return rgbSeq; }
+    DWORD           CbitSeq() const { return cbitSeq; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BYTE    TpsTapNext(BYTE tpsFrom, BOOL fTms);
+BYTE    CbitTapPath(BYTE tpsFrom, BYTE tpsTo);
+BYTE    BTapPath(BYTE tpsFrom, BYTE tpsTo);
+WORD    WTapPathPairs(BYTE tpsFrom, BYTE tpsTo);
+BOOL    FTapStable(BYTE tpsCheck);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // JTGTAP_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,363 @@
+/************************************************************************/
+/*                                                                      */
+/*  SmbPec.cpp  --  SMBus packet error code                             */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the SMBus PEC declared in SmbPec.h.          */
+/*                                                                      */
+/*  The CRC is computed eight bytes at a time with eight tables of 256  */
+/*  entries. Table k holds the CRC of a byte followed by k zero bytes,  */
+/*  and since the CRC is linear the CRC after eight bytes is the        */
+/*  exclusive or of one lookup per byte, none of which depends on the   */
+/*  others. The tables are built by the compiler, which also checks     */
+/*  them against the bitwise CRC.                                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include "dpcdecl.h"
+#include "SmbPec.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Number of bytes taken by each step of BSmbPecUpdate.
+*/
+const DWORD     cbPecSlice = 8;
+
+typedef struct {
+    BYTE    rgb[cbPecSlice][256];
+} PECTBL;
+
+/* ------------------------------------------------------------ */
+/*                  Table Construction                          */
+/* ------------------------------------------------------------ */
+/***    BPecBits
+**
+**  Parameters:
+**      bPec        - PEC so far
+**      rgb         - bytes to add
+**      cb          - number of bytes
+**
+**  Return Values:
+**      PEC with the bytes added
+**
+**  Errors:
+**
+**  Description:
+**      Add the bytes one bit at a time, most significant bit first.
+*/
+static constexpr BYTE
+BPecBits( BYTE bPec, const BYTE * rgb, DWORD cb ) {
+
+    for ( DWORD ib = 0; ib < cb; ib++ ) {
+
+        bPec ^= rgb[ib];
+
+        for ( int ibit = 0; ibit < 8; ibit++ ) {
+            bPec = ( 0 != (bPec & 0x80) ) ? (BYTE)((bPec << 1) ^ bSmbPecPoly) : (BYTE)(bPec << 1);
+        }
+    }
+
+    return bPec;
+}
+
+/* ------------------------------------------------------------ */
+/***    TblPecBuild
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      tables of the slices
+**
+**  Errors:
+**
+**  Description:
+**      Build table 0 bitwise, then each table from the one before it:
+**      a zero byte after a byte whose CRC is x leaves the CRC of x.
+**      Evaluated by the compiler.
+*/
+static constexpr PECTBL
+TblPecBuild() {
+
+    PECTBL  tbl = {};
+
+    for ( DWORD b = 0; b < 256; b++ ) {
+
+        BYTE    bData = (BYTE)b;
+
+        tbl.rgb[0][b] = BPecBits(0, &bData, 1);
+    }
+
+    for ( DWORD itbl = 1; itbl < cbPecSlice; itbl++ ) {
+        for ( DWORD b = 0; b < 256; b++ ) {
+            tbl.rgb[itbl][b] = tbl.rgb[0][tbl.rgb[itbl - 1][b]];
+        }
+    }
+
+    return tbl;
+}
+
+/* ------------------------------------------------------------ */
+/***    BPecSlices
+**
+**  Parameters:
+**      tbl         - tables of the slices
+**      bPec        - PEC so far
+**      rgb         - bytes to add
+**      cb          - number of bytes
+**
+**  Return Values:
+**      PEC with the bytes added
+**
+**  Errors:
+**
+**  Description:
+**      Add the bytes eight at a time, then the remaining ones with
+**      table 0.
+*/
+static constexpr BYTE
+BPecSlices( const PECTBL & tbl, BYTE bPec, const BYTE * rgb, DWORD cb ) {
+
+    while ( cb >= cbPecSlice ) {
+
+        bPec = tbl.rgb[7][bPec ^ rgb[0]] ^ tbl.rgb[6][rgb[1]] ^
+               tbl.rgb[5][rgb[2]] ^ tbl.rgb[4][rgb[3]] ^
+               tbl.rgb[3][rgb[4]] ^ tbl.rgb[2][rgb[5]] ^
+               tbl.rgb[1][rgb[6]] ^ tbl.rgb[0][rgb[7]];
+
+        rgb += cbPecSlice;
+        cb -= cbPecSlice;
+    }
+
+    while ( 0 < cb ) {
+
+        bPec = tbl.rgb[0][bPec ^ *rgb++];
+        cb--;
+    }
+
+    return bPec;
+}
+
+/* ------------------------------------------------------------ */
+/***    FTblPecValid
+**
+**  Parameters:
+**      tbl         - tables of the slices
+**
+**  Return Values:
+**      fTrue if every entry matches the bitwise CRC, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check the tables at compile time. Entry b of table k must be the
+**      CRC of b followed by k zero bytes.
+*/
+static constexpr BOOL
+FTblPecValid( const PECTBL & tbl ) {
+
+    for ( DWORD itbl = 0; itbl < cbPecSlice; itbl++ ) {
+        for ( DWORD b = 0; b < 256; b++ ) {
+
+            BYTE    rgbData[cbPecSlice] = {};
+
+            rgbData[0] = (BYTE)b;
+            if ( tbl.rgb[itbl][b] != BPecBits(0, rgbData, itbl + 1) ) {
+                return fFalse;
+            }
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+static constexpr PECTBL tblPec = TblPecBuild();
+
+/* The check value of the CRC, and a length that takes both the sliced
+** and the byte at a time paths.
+*/
+static constexpr BYTE   rgbPecCheck[] = {
+    '1', '2', '3', '4', '5', '6', '7', '8', '9',
+    '1', '2', '3', '4', '5', '6', '7', '8', '9'
+};
+
+static_assert(FTblPecValid(tblPec), "a PEC table entry is wrong");
+static_assert(0xF4 == BPecBits(0, rgbPecCheck, 9), "bitwise PEC check value");
+static_assert(0xF4 == BPecSlices(tblPec, 0, rgbPecCheck, 9), "sliced PEC check value");
+static_assert(BPecBits(0, rgbPecCheck, sizeof(rgbPecCheck)) ==
+              BPecSlices(tblPec, 0, rgbPecCheck, sizeof(rgbPecCheck)), "sliced PEC");
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    BSmbPecUpdate
+**
+**  Parameters:
+**      bPec        - PEC so far, 0 at the start of a transaction
+**      rgb         - bytes to add
+**      cb          - number of bytes
+**
+**  Return Values:
+**      PEC with the bytes added
+**
+**  Errors:
+**
+**  Description:
+**      Add bytes to a PEC using the tables.
+*/
+BYTE
+BSmbPecUpdate( BYTE bPec, const BYTE * rgb, DWORD cb ) {
+
+    return BPecSlices(tblPec, bPec, rgb, cb);
+}
+
+/* ------------------------------------------------------------ */
+/***    BSmbPecUpdateBitwise
+**
+**  Parameters:
+**      bPec        - PEC so far, 0 at the start of a transaction
+**      rgb         - bytes to add
+**      cb          - number of bytes
+**
+**  Return Values:
+**      PEC with the bytes added
+**
+**  Errors:
+**
+**  Description:
+**      Add bytes to a PEC one bit at a time. This gives the same result
+**      as BSmbPecUpdate and is kept as a reference for it.
+*/
+BYTE
+BSmbPecUpdateBitwise( BYTE bPec, const BYTE * rgb, DWORD cb ) {
+
+    return BPecBits(bPec, rgb, cb);
+}
+
+/* ------------------------------------------------------------ */
+/***    BSmbPecAddress
+**
+**  Parameters:
+**      bPec        - PEC so far
+**      dadr        - 7 bit slave address
+**      fRead       - fTrue for a read address, fFalse for a write address
+**
+**  Return Values:
+**      PEC with the address byte added
+**
+**  Errors:
+**
+**  Description:
+**      Add the address byte sent after a start or repeated start.
+*/
+BYTE
+BSmbPecAddress( BYTE bPec, BYTE dadr, BOOL fRead ) {
+
+    return tblPec.rgb[0][bPec ^ (BYTE)((dadr << 1) | ( fRead ? 1 : 0 ))];
+}
+
+/* ------------------------------------------------------------ */
+/***    BSmbPecWrite
+**
+**  Parameters:
+**      dadr        - 7 bit slave address
+**      rgbSnd      - bytes written, command code first
+**      cbSnd       - number of bytes written
+**
+**  Return Values:
+**      PEC to send after the bytes
+**
+**  Errors:
+**
+**  Description:
+**      Compute the PEC of a write transaction.
+*/
+BYTE
+BSmbPecWrite( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd ) {
+
+    return BSmbPecUpdate(BSmbPecAddress(0, dadr, fFalse), rgbSnd, cbSnd);
+}
+
+/* ------------------------------------------------------------ */
+/***    BSmbPecRead
+**
+**  Parameters:
+**      dadr        - 7 bit slave address
+**      rgbSnd      - bytes written before the repeated start
+**      cbSnd       - number of bytes written, 0 for a plain read
+**      rgbRcv      - bytes read, without the PEC
+**      cbRcv       - number of bytes read
+**
+**  Return Values:
+**      PEC the slave should send after the bytes read
+**
+**  Errors:
+**
+**  Description:
+**      Compute the PEC of a read transaction. When bytes are written
+**      first, such as the command code of a Read Byte, the write
+**      address, those bytes and the read address are all covered.
+*/
+BYTE
+BSmbPecRead( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, const BYTE * rgbRcv, DWORD cbRcv ) {
+
+    BYTE    bPec;
+
+    bPec = 0;
+
+    if ( 0 != cbSnd ) {
+        bPec = BSmbPecUpdate(BSmbPecAddress(bPec, dadr, fFalse), rgbSnd, cbSnd);
+    }
+
+    return BSmbPecUpdate(BSmbPecAddress(bPec, dadr, fTrue), rgbRcv, cbRcv);
+}
+
+/* ------------------------------------------------------------ */
+/***    FSmbPecReadValid
+**
+**  Parameters:
+**      dadr        - 7 bit slave address
+**      rgbSnd      - bytes written before the repeated start
+**      cbSnd       - number of bytes written, 0 for a plain read
+**      rgbRcv      - bytes read, with the PEC last
+**      cbRcv       - number of bytes read, including the PEC
+**
+**  Return Values:
+**      fTrue if the last byte read is the right PEC, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check the PEC of a read transaction made without the port's own
+**      packet error checking.
+*/
+BOOL
+FSmbPecReadValid( BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd, const BYTE * rgbRcv, DWORD cbRcv ) {
+
+    if ( 0 == cbRcv ) {
+        return fFalse;
+    }
+
+    return rgbRcv[cbRcv - 1] == BSmbPecRead(dadr, rgbSnd, cbSnd, rgbRcv, cbRcv - 1);
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,56 @@
+/************************************************************************/
+/*                                                                      */
+/*    SmbPec.h  --    Interface Declarations for SmbPec.cpp             */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for the      */
+/*    SMBus packet error code. The PEC is a CRC-8 with the polynomial   */
+/*    x^8 + x^2 + x + 1 and an initial value of 0, computed over every  */
+/*    byte of a transaction, address bytes included, up to the PEC      */
+/*    itself.                                                           */
+/*                                                                      */
+/*    A port with the dprpTwiSmbPEC property appends and checks the     */
+/*    PEC itself once DtwiSmbPecEnable has been called. These functions */
+/*    are for the other ports, and for checking or logging a PEC on the */
+/*    host: the PEC to append to a write, and whether the last byte of  */
+/*    a read is the right PEC for it.                                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SMBPEC_INCLUDED)
+#define      SMBPEC_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Generator polynomial of the PEC, without the x^8 term.
+*/
+const BYTE  bSmbPecPoly     = 0x07;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BYTE    BSmbPecUpdate(BYTE bPec, const BYTE * rgb, DWORD cb);
+BYTE    BSmbPecUpdateBitwise(BYTE bPec, const BYTE * rgb, DWORD cb);
+BYTE    BSmbPecAddress(BYTE bPec, BYTE dadr, BOOL fRead);
+
+BYTE    BSmbPecWrite(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd);
+BYTE    BSmbPecRead(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd,
+                    const BYTE * rgbRcv, DWORD cbRcv);
+BOOL    FSmbPecReadValid(BYTE dadr, const BYTE * rgbSnd, DWORD cbSnd,
+                         const BYTE * rgbRcv, DWORD cbRcv);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SMBPEC_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,169 @@
+/************************************************************************/
+/*                                                                      */
+/*  SmpUtil.cpp  --  Helpers shared by the example projects             */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the helpers declared in SmpUtil.h. They      */
+/*  are kept in one place so that the batch recorders, the players and  */
+/*  the timing of the example projects all share a single copy.         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    FGrowArray
+**
+**  Parameters:
+**      ppv         - array to grow
+**      pcitmMax    - number of entries allocated
+**      citmNeed    - number of entries needed
+**      cbItm       - size of an entry
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated. The array is left unchanged.
+**
+**  Description:
+**      Make sure an array has room for at least citmNeed entries,
+**      doubling its size as needed.
+*/
+BOOL
+FGrowArray( void ** ppv, DWORD * pcitmMax, DWORD citmNeed, size_t cbItm ) {
+
+    DWORD   citm;
+    void *  pv;
+
+    if ( citmNeed <= *pcitmMax ) {
+        return fTrue;
+    }
+
+    for ( citm = ( 0 != *pcitmMax ) ? *pcitmMax : citmGrowInitial; citm < citmNeed; citm *= 2 ) {
+
+        if ( 0x80000000 <= citm ) {
+            return fFalse;
+        }
+    }
+
+    pv = realloc(*ppv, citm * cbItm);
+    if ( NULL == pv ) {
+        return fFalse;
+    }
+
+    *ppv = pv;
+    *pcitmMax = citm;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SecClock
+**
+**  Parameters:
+**      clk     - clock to read
+**
+**  Return Values:
+**      time of the clock in seconds
+**
+**  Errors:
+**
+**  Description:
+**      Read a clock, such as the monotonic clock or the CPU time of the
+**      process.
+*/
+double
+SecClock( clockid_t clk ) {
+
+    struct timespec ts;
+
+    clock_gettime(clk, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+/* ------------------------------------------------------------ */
+/***    SecNow
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      time of the monotonic clock in seconds
+**
+**  Errors:
+**
+**  Description:
+**      Read the monotonic clock.
+*/
+double
+SecNow() {
+
+    return SecClock(CLOCK_MONOTONIC);
+}
+
+/* ------------------------------------------------------------ */
+/***    TusNow
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      time of the monotonic clock in microseconds
+**
+**  Errors:
+**
+**  Description:
+**      Read the monotonic clock.
+*/
+UINT64
+TusNow() {
+
+    return TnsNow() / 1000;
+}
+
+/* ------------------------------------------------------------ */
+/***    TnsNow
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      time of the monotonic clock in nanoseconds
+**
+**  Errors:
+**
+**  Description:
+**      Read the monotonic clock.
+*/
+UINT64
+TnsNow() {
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (UINT64)ts.tv_sec * 1000000000ULL + (UINT64)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,49 @@
+/************************************************************************/
+/*                                                                      */
+/*    SmpUtil.h  --    Interface Declarations for SmpUtil.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for small    */
+/*    helpers used by several of the common modules and example         */
+/*    projects: growing an array allocated with malloc, and reading     */
+/*    the monotonic clock in seconds, microseconds or nanoseconds.      */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SMPUTIL_INCLUDED)
+#define      SMPUTIL_INCLUDED
+
+#include <stddef.h>
+#include <time.h>
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Number of entries FGrowArray allocates for an empty array.
+*/
+const DWORD citmGrowInitial = 64;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BOOL    FGrowArray(void ** ppv, DWORD * pcitmMax, DWORD citmNeed, size_t cbItm);
+
+double  SecClock(clockid_t clk);
+double  SecNow();
+UINT64  TusNow();
+UINT64  TnsNow();
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SMPUTIL_INCLUDED
+
+/************************************************************************/
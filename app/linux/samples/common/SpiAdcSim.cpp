@@ -0,0 +1,360 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiAdcSim.cpp  --  Serial ADC model                                 */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a model of a serial ADC. The input voltage   */
+/*  is computed from the waveform at the model's time when the part is  */
+/*  selected, scaled to the full range of the converter and clipped.    */
+/*  Amplitude, offset and noise are given in codes of the converter,    */
+/*  so that a waveform keeps its shape when the resolution is changed.  */
+/*  The noise is uniform and comes from a fixed seed, so runs repeat.   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dpcdecl.h"
+#include "SpiAdcSim.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+const double    dblPi = 3.14159265358979323846;
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::SpiAdcSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a model with the default resolution whose input is a
+**      DC level at mid scale.
+*/
+SpiAdcSim::SpiAdcSim() {
+
+    cbitRes = cbitAdcDefault;
+    wf = wfAdcDc;
+    frqWave = 0.0;
+    ampl = 0.0;
+    offs = (double)(1 << (cbitAdcDefault - 1));
+    amplNoise = 0.0;
+    dwNoise = 0x2545F491;
+    rgwTable = NULL;
+    cwTable = 0;
+    frqTable = 0;
+    fSel = fFalse;
+    wSample = 0;
+    ibyte = 0;
+    csample = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::~SpiAdcSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the sample table.
+*/
+SpiAdcSim::~SpiAdcSim() {
+
+    free(rgwTable);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::FSetResolution
+**
+**  Parameters:
+**      cbit        - number of bits of the result, 8 to 16
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the resolution of the converter.
+*/
+BOOL
+SpiAdcSim::FSetResolution( int cbit ) {
+
+    if (( cbit < 8 ) || ( 16 < cbit )) {
+        return fFalse;
+    }
+
+    cbitRes = cbit;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::FSetWaveform
+**
+**  Parameters:
+**      wfReq       - waveform, wfAdcDc to wfAdcSawtooth
+**      frq         - frequency in Hz, ignored for wfAdcDc
+**      amplReq     - peak amplitude in codes
+**      offsReq     - level of the center of the waveform in codes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the waveform at the input. A table is set with FSetTable.
+*/
+BOOL
+SpiAdcSim::FSetWaveform( int wfReq, double frq, double amplReq, double offsReq ) {
+
+    if (( wfReq < wfAdcDc ) || ( wfAdcSawtooth < wfReq ) || ( frq < 0.0 )) {
+        return fFalse;
+    }
+
+    wf = wfReq;
+    frqWave = frq;
+    ampl = amplReq;
+    offs = offsReq;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::FSetTable
+**
+**  Parameters:
+**      rgw         - samples, in codes
+**      cw          - number of samples
+**      frqSample   - rate at which the samples are played back, in Hz
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Play a table of samples at the input, repeating from the start
+**      after the last sample. Each sample is held until the next one.
+*/
+BOOL
+SpiAdcSim::FSetTable( const WORD * rgw, DWORD cw, DWORD frqSample ) {
+
+    WORD *  rgwNew;
+
+    if (( 0 == cw ) || ( 0 == frqSample )) {
+        return fFalse;
+    }
+
+    rgwNew = (WORD *)malloc(cw * sizeof(WORD));
+    if ( NULL == rgwNew ) {
+        return fFalse;
+    }
+
+    memcpy(rgwNew, rgw, cw * sizeof(WORD));
+
+    free(rgwTable);
+    rgwTable = rgwNew;
+    cwTable = cw;
+    frqTable = frqSample;
+    wf = wfAdcTable;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::SetSelect
+**
+**  Parameters:
+**      fSelNew     - new state of the select line
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Sample the input when the part is selected.
+*/
+void
+SpiAdcSim::SetSelect( BOOL fSelNew ) {
+
+    if ( fSelNew == fSel ) {
+        return;
+    }
+
+    fSel = fSelNew;
+
+    if ( fSel ) {
+
+        wSample = WConvert(VIn(TnsNow()));
+        ibyte = 0;
+        csample++;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::BShift
+**
+**  Parameters:
+**      bMosi       - byte shifted in, ignored
+**
+**  Return Values:
+**      byte shifted out
+**
+**  Errors:
+**
+**  Description:
+**      Shift out the conversion result, high byte first.
+*/
+BYTE
+SpiAdcSim::BShift( BYTE bMosi ) {
+
+    BYTE    bMiso;
+
+    (void)bMosi;
+
+    if ( ! fSel ) {
+        return 0xFF;
+    }
+
+    bMiso = 0;
+
+    if ( 0 == ibyte ) {
+        bMiso = (BYTE)(wSample >> 8);
+    }
+    else if ( 1 == ibyte ) {
+        bMiso = (BYTE)(wSample & 0xFF);
+    }
+
+    ibyte++;
+
+    return bMiso;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::VIn
+**
+**  Parameters:
+**      tns         - time in ns
+**
+**  Return Values:
+**      input level in codes, not clipped
+**
+**  Errors:
+**
+**  Description:
+**      Compute the level at the input at a point in time, including
+**      the noise.
+*/
+double
+SpiAdcSim::VIn( UINT64 tns ) {
+
+    double  sec;
+    double  phase;
+    double  v;
+
+    sec = (double)tns / 1000000000.0;
+    phase = sec * frqWave - floor(sec * frqWave);
+
+    switch ( wf ) {
+
+        case wfAdcSine:
+            v = offs + ampl * sin(2.0 * dblPi * phase);
+            break;
+
+        case wfAdcSquare:
+            v = offs + (( phase < 0.5 ) ? ampl : -ampl);
+            break;
+
+        case wfAdcTriangle:
+            v = offs + ampl * (( phase < 0.5 ) ? (4.0 * phase - 1.0) : (3.0 - 4.0 * phase));
+            break;
+
+        case wfAdcSawtooth:
+            v = offs + ampl * (2.0 * phase - 1.0);
+            break;
+
+        case wfAdcTable:
+            v = (double)rgwTable[(UINT64)(sec * frqTable) % cwTable];
+            break;
+
+        default:
+            v = offs;
+            break;
+    }
+
+    if ( 0.0 != amplNoise ) {
+
+        dwNoise = dwNoise * 1664525 + 1013904223;
+        v += amplNoise * (2.0 * ((double)(dwNoise >> 8) / 16777216.0) - 1.0);
+    }
+
+    return v;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiAdcSim::WConvert
+**
+**  Parameters:
+**      v           - input level in codes
+**
+**  Return Values:
+**      conversion result
+**
+**  Errors:
+**
+**  Description:
+**      Round a level to the nearest code and clip it to the range of
+**      the converter.
+*/
+WORD
+SpiAdcSim::WConvert( double v ) const {
+
+    double  vMax;
+
+    vMax = (double)((1 << cbitRes) - 1);
+
+    if ( v <= 0.0 ) {
+        return 0;
+    }
+
+    if ( v >= vMax ) {
+        return (WORD)vMax;
+    }
+
+    return (WORD)(v + 0.5);
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
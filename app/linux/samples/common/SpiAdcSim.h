@@ -0,0 +1,100 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiAdcSim.h  --    Interface Declarations for SpiAdcSim.cpp       */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a model  */
+/*    of a serial ADC such as the AD7476A of the PmodAD1. The input is  */
+/*    sampled when the part is selected, and the conversion result is   */
+/*    shifted out in the next 16 SCLK periods, most significant bit     */
+/*    first, with the leading bits zero. Further bytes read as zero.    */
+/*                                                                      */
+/*    The input is a waveform of the model's simulated clock: a DC      */
+/*    level, a sine, square, triangle or sawtooth wave, or a table of   */
+/*    samples played back at a fixed rate, plus optional noise. Each    */
+/*    conversion therefore returns the value at the time the host       */
+/*    actually got to it, so the effect of bus speed and call overhead  */
+/*    on the sample rate can be seen in the data.                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIADCSIM_INCLUDED)
+#define      SPIADCSIM_INCLUDED
+
+#include "SpiDev.h"
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Waveforms.
+*/
+const int   wfAdcDc         = 0;
+const int   wfAdcSine       = 1;
+const int   wfAdcSquare     = 2;
+const int   wfAdcTriangle   = 3;
+const int   wfAdcSawtooth   = 4;
+const int   wfAdcTable      = 5;
+
+/* Default resolution, that of the AD7476A.
+*/
+const int   cbitAdcDefault  = 12;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiAdcSim : public SpiDev {
+
+private:
+    int         cbitRes;
+    int         wf;
+    double      frqWave;
+    double      ampl;
+    double      offs;
+    double      amplNoise;
+    DWORD       dwNoise;
+
+    WORD *      rgwTable;
+    DWORD       cwTable;
+    DWORD       frqTable;
+
+    /* State of the conversion in progress.
+    */
+    BOOL        fSel;
+    WORD        wSample;
+    DWORD       ibyte;
+    DWORD       csample;
+
+    double  VIn(UINT64 tns);
+    WORD    WConvert(double v) const;
+
+protected:
+    virtual void    SetSelect(BOOL fSelNew);
+    virtual BYTE    BShift(BYTE bMosi);
+
+public:
+    SpiAdcSim();
+    virtual ~SpiAdcSim();
+
+    BOOL    FSetResolution(int cbit);
+    BOOL    FSetWaveform(int wfReq, double frq, double amplReq, double offsReq);
+    BOOL    FSetTable(const WORD * rgw, DWORD cw, DWORD frqSample);
+    void    SetNoise(double amplReq) { amplNoise = amplReq; }
+
+    int     CbitRes() const { return cbitRes; }
+    DWORD   Csample() const { return csample; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIADCSIM_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,727 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiBatch.cpp  --  Compiled SPI transaction batches                  */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a builder that turns a sequence of SPI       */
+/*  select, put, get, fill and delay steps into the smallest number of  */
+/*  DspiPut and DspiGet calls.                                          */
+/*                                                                      */
+/*  The data of every step is appended to a single send buffer, so a    */
+/*  segment is simply a range of that buffer and nothing is copied when */
+/*  the batch is executed. Received data lands at the same offset in a  */
+/*  receive buffer of the same size and is copied to the caller's       */
+/*  buffers after the last call has completed.                          */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dspi.h"
+#include "SpiDev.h"
+#include "SpiBatch.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiBatch::SpiBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an empty batch.
+*/
+SpiBatch::SpiBatch() {
+
+    rgbSnd = NULL;
+    rgbRcv = NULL;
+    cbDataMax = 0;
+    cbRcvMax = 0;
+    rgseg = NULL;
+    csegMax = 0;
+    rgscat = NULL;
+    cscatMax = 0;
+
+    Reset();
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::~SpiBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory used by the batch.
+*/
+SpiBatch::~SpiBatch() {
+
+    free(rgbSnd);
+    free(rgbRcv);
+    free(rgseg);
+    free(rgscat);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::Reset
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Remove every step from the batch. The memory is kept so that
+**      the batch can be rebuilt without allocating.
+*/
+void
+SpiBatch::Reset() {
+
+    cbData = 0;
+    cseg = 0;
+    cscat = 0;
+    fSel = fFalse;
+    fSelPending = fFalse;
+    fSegOpen = fFalse;
+    tusPending = 0;
+    fError = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FSelect
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the slave is already selected.
+**
+**  Description:
+**      Start a transaction. The select line is asserted at the start of
+**      the next data step.
+*/
+BOOL
+SpiBatch::FSelect() {
+
+    if ( fSel ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    /* Data recorded before the select is sent on its own.
+    */
+    fSegOpen = fFalse;
+    fSel = fTrue;
+    fSelPending = fTrue;
+
+    return ! fError;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FDeselect
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the slave isn't selected.
+**
+**  Description:
+**      End a transaction. The select line is deasserted at the end of
+**      the last data step, or on its own if there is no data step since
+**      the last delay.
+*/
+BOOL
+SpiBatch::FDeselect() {
+
+    SBSEG * pseg;
+
+    if ( ! fSel ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( fSegOpen ) {
+
+        rgseg[cseg - 1].fSelEnd = fTrue;
+    }
+    else {
+
+        pseg = PsegNew();
+        if ( NULL == pseg ) {
+            return fFalse;
+        }
+
+        pseg->fSelStart = fSelPending;
+        pseg->fSelEnd = fTrue;
+    }
+
+    fSel = fFalse;
+    fSelPending = fFalse;
+    fSegOpen = fFalse;
+
+    return ! fError;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FPut
+**
+**  Parameters:
+**      rgbSndReq   - bytes to send
+**      cb          - number of bytes to send
+**      rgbRcvReq   - receives the bytes shifted in, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add bytes to send. The bytes are copied.
+*/
+BOOL
+SpiBatch::FPut( const BYTE * rgbSndReq, DWORD cb, BYTE * rgbRcvReq ) {
+
+    return FAddData(rgbSndReq, 0, cb, rgbRcvReq);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FPutByte
+**
+**  Parameters:
+**      bSnd        - byte to send
+**      pbRcv       - receives the byte shifted in, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a single byte to send.
+*/
+BOOL
+SpiBatch::FPutByte( BYTE bSnd, BYTE * pbRcv ) {
+
+    return FAddData(&bSnd, 0, 1, pbRcv);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FGet
+**
+**  Parameters:
+**      rgbRcvReq   - receives the bytes shifted in
+**      cb          - number of bytes to receive
+**      bFill       - byte sent while receiving
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add bytes to receive.
+*/
+BOOL
+SpiBatch::FGet( BYTE * rgbRcvReq, DWORD cb, BYTE bFill ) {
+
+    if ( NULL == rgbRcvReq ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    return FAddData(NULL, bFill, cb, rgbRcvReq);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FFill
+**
+**  Parameters:
+**      bFill       - byte to send
+**      cb          - number of times to send it
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add clock cycles whose received data isn't wanted, such as the
+**      dummy bytes of a fast read command.
+*/
+BOOL
+SpiBatch::FFill( BYTE bFill, DWORD cb ) {
+
+    return FAddData(NULL, bFill, cb, NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FDelay
+**
+**  Parameters:
+**      tus         - delay in microseconds
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a delay. The delay is made by the host between two calls, so
+**      it is at least tus but may be much longer. If a transaction has
+**      been started the slave stays selected during the delay.
+*/
+BOOL
+SpiBatch::FDelay( DWORD tus ) {
+
+    SBSEG * pseg;
+
+    /* A select with no data yet must take effect before the delay.
+    */
+    if ( fSelPending ) {
+
+        pseg = PsegNew();
+        if ( NULL == pseg ) {
+            return fFalse;
+        }
+
+        pseg->fSelStart = fTrue;
+        fSelPending = fFalse;
+    }
+
+    fSegOpen = fFalse;
+    tusPending += tus;
+
+    return ! fError;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FExecute
+**
+**  Parameters:
+**      hif         - open handle with DSPI enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if any step failed to be recorded or any call fails.
+**
+**  Description:
+**      Run the batch. Segments are issued as overlapped calls with up
+**      to csegInFlightMax in flight. Calls that must not overlap with
+**      the ones before them (a delay or a change of the select line
+**      alone) wait for every call in flight to complete first. The
+**      received data is copied to the caller's buffers at the end.
+*/
+BOOL
+SpiBatch::FExecute( HIF hif ) {
+
+    SBSEG *     pseg;
+    DWORD       iseg;
+    DWORD       iscat;
+    DWORD       csegInFlight;
+    BOOL        fOk;
+
+    if ( fError ) {
+        return fFalse;
+    }
+
+    /* Received data lands at the same offset as the data sent.
+    */
+    if ( ! FGrowArray((void **)&rgbRcv, &cbRcvMax, cbData, 1) ) {
+        return fFalse;
+    }
+
+    csegInFlight = 0;
+
+    for ( iseg = 0; iseg < cseg; iseg++ ) {
+
+        pseg = &rgseg[iseg];
+
+        if (( 0 != pseg->tusBefore ) || ( 0 == pseg->cb )) {
+
+            if ( ! FWaitSegs(hif, &csegInFlight, 0) ) {
+                return fFalse;
+            }
+
+            if ( 0 != pseg->tusBefore ) {
+                usleep(pseg->tusBefore);
+            }
+        }
+        else if ( ! FWaitSegs(hif, &csegInFlight, csegInFlightMax - 1) ) {
+            return fFalse;
+        }
+
+        if ( 0 == pseg->cb ) {
+
+            fOk = fTrue;
+            if ( pseg->fSelStart ) {
+                fOk = DspiSetSelect(hif, fTrue);
+            }
+            if ( fOk && pseg->fSelEnd ) {
+                fOk = DspiSetSelect(hif, fFalse);
+            }
+        }
+        else if ( pseg->fGetOnly ) {
+
+            fOk = DspiGet(hif, pseg->fSelStart, pseg->fSelEnd, pseg->bFill,
+                          &rgbRcv[pseg->ibFirst], pseg->cb, fTrue);
+            csegInFlight += fOk ? 1 : 0;
+        }
+        else {
+
+            fOk = DspiPut(hif, pseg->fSelStart, pseg->fSelEnd, &rgbSnd[pseg->ibFirst],
+                          pseg->fRcv ? &rgbRcv[pseg->ibFirst] : NULL, pseg->cb, fTrue);
+            csegInFlight += fOk ? 1 : 0;
+        }
+
+        if ( ! fOk ) {
+
+            if ( 0 != csegInFlight ) {
+                DmgrCancelTrans(hif);
+            }
+            return fFalse;
+        }
+    }
+
+    if ( ! FWaitSegs(hif, &csegInFlight, 0) ) {
+        return fFalse;
+    }
+
+    /* A trailing delay still has to be honored.
+    */
+    if ( 0 != tusPending ) {
+        usleep(tusPending);
+    }
+
+    for ( iscat = 0; iscat < cscat; iscat++ ) {
+
+        memcpy(rgscat[iscat].pbDst, &rgbRcv[rgscat[iscat].ib], rgscat[iscat].cb);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FExecute
+**
+**  Parameters:
+**      pdev        - model of the slave
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if any step failed to be recorded.
+**
+**  Description:
+**      Run the batch against a software model instead of a device. The
+**      segments are shifted through the model one byte at a time and
+**      the delays advance the model's clock.
+*/
+BOOL
+SpiBatch::FExecute( SpiDev * pdev ) {
+
+    SBSEG *     pseg;
+    DWORD       iseg;
+    DWORD       iscat;
+    DWORD       ib;
+
+    if (( fError ) || ( ! FGrowArray((void **)&rgbRcv, &cbRcvMax, cbData, 1) )) {
+        return fFalse;
+    }
+
+    for ( iseg = 0; iseg < cseg; iseg++ ) {
+
+        pseg = &rgseg[iseg];
+
+        pdev->Wait(pseg->tusBefore);
+
+        if ( pseg->fSelStart ) {
+            pdev->Select(fTrue);
+        }
+
+        for ( ib = pseg->ibFirst; ib < pseg->ibFirst + pseg->cb; ib++ ) {
+            rgbRcv[ib] = pdev->BExchange(rgbSnd[ib]);
+        }
+
+        if ( pseg->fSelEnd ) {
+            pdev->Select(fFalse);
+        }
+    }
+
+    pdev->Wait(tusPending);
+
+    for ( iscat = 0; iscat < cscat; iscat++ ) {
+
+        memcpy(rgscat[iscat].pbDst, &rgbRcv[rgscat[iscat].ib], rgscat[iscat].cb);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FAddData
+**
+**  Parameters:
+**      pbSnd       - bytes to send, or NULL to send bFill
+**      bFill       - byte to send when pbSnd is NULL
+**      cb          - number of bytes
+**      pbDst       - receives the bytes shifted in, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a data step to the open segment, starting a new segment
+**      if there isn't one.
+*/
+BOOL
+SpiBatch::FAddData( const BYTE * pbSnd, BYTE bFill, DWORD cb, BYTE * pbDst ) {
+
+    SBSEG *     pseg;
+    SBSCAT *    pscat;
+
+    if ( fError ) {
+        return fFalse;
+    }
+
+    if ( 0 == cb ) {
+        return fTrue;
+    }
+
+    if (( cbData + cb < cbData ) ||
+        ( ! FGrowArray((void **)&rgbSnd, &cbDataMax, cbData + cb, 1) )) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( ! fSegOpen ) {
+
+        pseg = PsegNew();
+        if ( NULL == pseg ) {
+            return fFalse;
+        }
+
+        pseg->bFill = bFill;
+        pseg->fSelStart = fSelPending;
+        pseg->fGetOnly = fTrue;
+
+        fSelPending = fFalse;
+        fSegOpen = fTrue;
+    }
+
+    pseg = &rgseg[cseg - 1];
+
+    if ( NULL != pbSnd ) {
+
+        memcpy(&rgbSnd[cbData], pbSnd, cb);
+        pseg->fGetOnly = fFalse;
+    }
+    else {
+
+        memset(&rgbSnd[cbData], bFill, cb);
+        if ( bFill != pseg->bFill ) {
+            pseg->fGetOnly = fFalse;
+        }
+    }
+
+    if ( NULL != pbDst ) {
+
+        if ( ! FGrowArray((void **)&rgscat, &cscatMax, cscat + 1, sizeof(SBSCAT)) ) {
+
+            fError = fTrue;
+            return fFalse;
+        }
+
+        pscat = &rgscat[cscat++];
+        pscat->ib = cbData;
+        pscat->cb = cb;
+        pscat->pbDst = pbDst;
+
+        pseg->fRcv = fTrue;
+    }
+
+    cbData += cb;
+    pseg->cb += cb;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::PsegNew
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      pointer to the new segment, or NULL on failure
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append an empty segment that starts at the end of the data and
+**      carries any pending delay.
+*/
+SBSEG *
+SpiBatch::PsegNew() {
+
+    SBSEG * pseg;
+
+    if ( ! FGrowArray((void **)&rgseg, &csegMax, cseg + 1, sizeof(SBSEG)) ) {
+
+        fError = fTrue;
+        return NULL;
+    }
+
+    pseg = &rgseg[cseg++];
+    memset(pseg, 0, sizeof(SBSEG));
+    pseg->ibFirst = cbData;
+    pseg->tusBefore = tusPending;
+
+    tusPending = 0;
+
+    return pseg;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiBatch::FWaitSegs
+**
+**  Parameters:
+**      hif             - open handle with DSPI enabled
+**      pcsegInFlight   - number of overlapped calls in flight
+**      csegLeave       - number of calls that may remain in flight
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call doesn't complete. The remaining calls are
+**      cancelled.
+**
+**  Description:
+**      Wait for the oldest calls in flight to complete.
+*/
+BOOL
+SpiBatch::FWaitSegs( HIF hif, DWORD * pcsegInFlight, DWORD csegLeave ) {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+
+    while ( *pcsegInFlight > csegLeave ) {
+
+        if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsSegWait) ) {
+
+            DmgrCancelTrans(hif);
+            *pcsegInFlight = 0;
+            return fFalse;
+        }
+
+        (*pcsegInFlight)--;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiReadRegs
+**
+**  Parameters:
+**      hif         - open handle with DSPI enabled
+**      bCmd        - command byte that starts the read
+**      rgbRcv      - receives the register values
+**      cb          - number of registers to read
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read a block of registers from a device that increments the
+**      register address after each byte, in a single call.
+*/
+BOOL
+FSpiReadRegs( HIF hif, BYTE bCmd, BYTE * rgbRcv, DWORD cb ) {
+
+    SpiBatch    sb;
+
+    return sb.FSelect() && sb.FPutByte(bCmd, NULL) && sb.FGet(rgbRcv, cb, 0) &&
+           sb.FDeselect() && sb.FExecute(hif);
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiWriteRegs
+**
+**  Parameters:
+**      hif         - open handle with DSPI enabled
+**      bCmd        - command byte that starts the write
+**      rgbSnd      - register values to write
+**      cb          - number of registers to write
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write a block of registers to a device that increments the
+**      register address after each byte, in a single call.
+*/
+BOOL
+FSpiWriteRegs( HIF hif, BYTE bCmd, const BYTE * rgbSnd, DWORD cb ) {
+
+    SpiBatch    sb;
+
+    return sb.FSelect() && sb.FPutByte(bCmd, NULL) && sb.FPut(rgbSnd, cb, NULL) &&
+           sb.FDeselect() && sb.FExecute(hif);
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,155 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiBatch.h  --    Interface Declarations for SpiBatch.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a SPI    */
+/*    transaction builder. A batch records a sequence of select, put,   */
+/*    get, fill and delay steps and executes them with as few DspiPut   */
+/*    and DspiGet calls as possible, instead of one call per byte.      */
+/*                                                                      */
+/*    Steps are compiled as they are recorded. All data steps between a */
+/*    select and the following deselect are merged into one segment     */
+/*    that is sent with a single call, using fSelStart and fSelEnd to   */
+/*    keep the slave selected for the whole segment. Only a delay step  */
+/*    splits a transaction into more than one call. The bytes received  */
+/*    for each step are scattered back to the caller's buffers once the */
+/*    batch has been executed.                                          */
+/*                                                                      */
+/*    Segments are issued as overlapped calls so that several           */
+/*    transactions are in flight at once. A sweep of a sensor's         */
+/*    register map therefore costs one USB round trip rather than one   */
+/*    round trip per byte.                                              */
+/*                                                                      */
+/*    A batch may also be executed against a software model of the      */
+/*    slave (see SpiDev.h) instead of a device opened with DmgrOpen.    */
+/*                                                                      */
+/*    A batch may be executed any number of times. The data sent is     */
+/*    copied when a step is recorded, but the receive buffers must      */
+/*    remain valid until the batch is reset.                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIBATCH_INCLUDED)
+#define      SPIBATCH_INCLUDED
+
+class SpiDev;
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Largest number of overlapped calls that FExecute keeps in flight.
+*/
+const DWORD csegInFlightMax = 16;
+
+/* Time allowed for each overlapped call to complete.
+*/
+const DWORD tmsSegWait = 5000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* A segment is one DspiPut or DspiGet call. A segment with no data
+** only changes the state of the select line.
+*/
+typedef struct {
+    DWORD   ibFirst;        // offset of the segment in the send/receive buffers
+    DWORD   cb;             // number of bytes transferred
+    DWORD   tusBefore;      // delay before the segment is started
+    BYTE    bFill;          // fill byte when the segment only gets data
+    BOOL    fSelStart;      // assert select at the start of the segment
+    BOOL    fSelEnd;        // deassert select at the end of the segment
+    BOOL    fGetOnly;       // every byte is bFill, so DspiGet can be used
+    BOOL    fRcv;           // some of the received data is wanted
+} SBSEG;
+
+/* A scatter entry copies received bytes to a caller's buffer.
+*/
+typedef struct {
+    DWORD   ib;             // offset in the receive buffer
+    DWORD   cb;             // number of bytes
+    BYTE *  pbDst;          // destination
+} SBSCAT;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiBatch {
+
+private:
+    BYTE *      rgbSnd;
+    BYTE *      rgbRcv;
+    DWORD       cbData;
+    DWORD       cbDataMax;
+    DWORD       cbRcvMax;
+
+    SBSEG *     rgseg;
+    DWORD       cseg;
+    DWORD       csegMax;
+
+    SBSCAT *    rgscat;
+    DWORD       cscat;
+    DWORD       cscatMax;
+
+    BOOL        fSel;           // select is asserted after the last step
+    BOOL        fSelPending;    // select was asserted but no segment started yet
+    BOOL        fSegOpen;       // data steps may be added to the last segment
+    DWORD       tusPending;     // delay to apply before the next segment
+    BOOL        fError;         // a step failed to be recorded
+
+    BOOL    FAddData(const BYTE * pbSnd, BYTE bFill, DWORD cb, BYTE * pbDst);
+    SBSEG * PsegNew();
+    BOOL    FWaitSegs(HIF hif, DWORD * pcsegInFlight, DWORD csegLeave);
+
+    SpiBatch(const SpiBatch &);
+    SpiBatch & operator=(const SpiBatch &);
+
+public:
+    SpiBatch();
+    ~SpiBatch();
+
+    void    Reset();
+
+    BOOL    FSelect();
+    BOOL    FDeselect();
+    BOOL    FPut(const BYTE * rgbSndReq, DWORD cb, BYTE * rgbRcvReq);
+    BOOL    FPutByte(BYTE bSnd, BYTE * pbRcv);
+    BOOL    FGet(BYTE * rgbRcvReq, DWORD cb, BYTE bFill);
+    BOOL    FFill(BYTE bFill, DWORD cb);
+    BOOL    FDelay(DWORD tus);
+
+    BOOL    FExecute(HIF hif);
+    BOOL    FExecute(SpiDev * pdev);
+
+    DWORD   CsegCompiled() const { return cseg; }
+    DWORD   CbTransfer() const { return cbData; }
+    BOOL    FSelected() const { return fSel; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+BOOL    FSpiReadRegs(HIF hif, BYTE bCmd, BYTE * rgbRcv, DWORD cb);
+BOOL    FSpiWriteRegs(HIF hif, BYTE bCmd, const BYTE * rgbSnd, DWORD cb);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIBATCH_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,1061 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiCal.cpp  --  DSPI clock and delay calibration                    */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the calibration of a DSPI port. The clock is */
+/*  found by a binary search between the minimum and maximum clock      */
+/*  rates, using the rate actually set by DspiSetSpeed for each test    */
+/*  point. The search assumes that a clock that fails makes every       */
+/*  faster clock fail as well. Each delay is then found the same way,   */
+/*  between zero and the value the port started with.                   */
+/*                                                                      */
+/*  Each test point sends a number of transfers in one SpiBatch and     */
+/*  counts the bits received in error. Because errors near the limit    */
+/*  are intermittent, the result of each search is checked again with   */
+/*  four times as many transfers. A clock that fails the check is       */
+/*  lowered in steps of one sixteenth and a delay is raised in steps of */
+/*  a quarter until the check passes.                                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dspi.h"
+#include "SpiBatch.h"
+#include "SpiCal.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Factor by which the number of transfers is increased for the final
+** check.
+*/
+const DWORD     cConfirm = 4;
+
+/* The clock search stops when the interval left is narrower than the
+** lower bound divided by this.
+*/
+const DWORD     frqResolution = 64;
+
+/* Fill byte clocked out while a response is read.
+*/
+const BYTE      bScFill = 0x00;
+
+const DWORD     cchScLineMax = 128;
+
+/* ------------------------------------------------------------ */
+/*                  Global Variables                            */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Local Variables                             */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static DWORD    CbitDiff(const BYTE * pb1, const BYTE * pb2, DWORD cb);
+static BOOL     FParseLine(const char * sz, char * szSn, INT32 * pprt, SCRESULT * pscr);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiCal::SpiCal
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Constructor.
+*/
+SpiCal::SpiCal() {
+
+    hif = hifInvalid;
+    dprp = 0;
+    pscr = NULL;
+    rgbRef = NULL;
+    rgbRcv = NULL;
+    psb = NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::~SpiCal
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Destructor.
+*/
+SpiCal::~SpiCal() {
+
+    Free();
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::Init
+**
+**  Parameters:
+**      hifReq      - device with DSPI enabled
+**      dprpReq     - properties of the port, from DspiGetPortProperties
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Select the port to calibrate. Delays that the port doesn't
+**      support are left alone.
+*/
+void
+SpiCal::Init( HIF hifReq, DWORD dprpReq ) {
+
+    hif = hifReq;
+    dprp = dprpReq;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FRun
+**
+**  Parameters:
+**      pscpReq     - calibration parameters
+**      pscrRes     - receives the settings found
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the signature doesn't pass at the minimum clock with
+**      the delays the port started with, or if a transfer fails.
+**
+**  Description:
+**      Calibrate the port. The port is left configured with the
+**      settings found.
+*/
+BOOL
+SpiCal::FRun( const SCPARAM * pscpReq, SCRESULT * pscrRes ) {
+
+    DWORD   cb;
+    DWORD   frqSet;
+    int     ipass;
+    BOOL    fPass;
+    BOOL    fSuccess;
+
+    scp = *pscpReq;
+    pscr = pscrRes;
+    memset(pscr, 0, sizeof(SCRESULT));
+
+    if (( 0 == scp.cbSig ) || ( 0 == scp.ctrial ) || ( 0 == scp.frqMin ) ||
+        ( scp.frqMax < scp.frqMin ) || ( 100 <= scp.pctMargin )) {
+        return fFalse;
+    }
+
+    if (( sigkResponse == scp.sigk ) &&
+        (( 0 == scp.cbCmd ) || ( cbScCmdMax < scp.cbCmd ))) {
+        return fFalse;
+    }
+
+    Free();
+
+    cb = scp.ctrial * cConfirm * scp.cbSig;
+    rgbRef = (BYTE *)malloc(cb);
+    rgbRcv = (BYTE *)malloc(cb);
+    psb = new SpiBatch;
+
+    fSuccess = fFalse;
+
+    if (( NULL == rgbRef ) || ( NULL == rgbRcv )) {
+        goto lErrorExit;
+    }
+
+    /* Start from the delays the port is using now. They are assumed to
+    ** be long enough, and they are the upper bounds of the searches.
+    */
+    if ( dprp & dprpSpiDelay ) {
+        DspiGetDelay(hif, &pscr->tusDelay);
+    }
+
+    if ( dprp & dprpSpiStartEndDelay ) {
+        DspiGetStartEndDelay(hif, &pscr->tusStart, &pscr->tusEnd);
+    }
+
+    if ( ! FSetSpeed(scp.frqMin, &frqSet) ) {
+        goto lErrorExit;
+    }
+
+    pscr->frqSck = frqSet;
+
+    if ( ! FCaptureRef() ) {
+        goto lErrorExit;
+    }
+
+    if ( ! FTest(scp.ctrial, &fPass) ) {
+        goto lErrorExit;
+    }
+
+    if ( ! fPass ) {
+        goto lErrorExit;
+    }
+
+    if (( ! FSearchSpeed() ) || ( ! FConfirm() )) {
+        goto lErrorExit;
+    }
+
+    /* Errors caused by a marginal clock can make a delay look necessary.
+    ** If the final check has to lower the clock, the delays are searched
+    ** once more at the new clock.
+    */
+    for ( ipass = 0; ipass < 2; ipass++ ) {
+
+        frqSet = pscr->frqSck;
+
+        if ( ! FSearchDelays() ) {
+            goto lErrorExit;
+        }
+
+        if ( ! FConfirm() ) {
+            goto lErrorExit;
+        }
+
+        if ( frqSet == pscr->frqSck ) {
+            break;
+        }
+    }
+
+    /* Back the clock off by the margin requested, if any.
+    */
+    if ( 0 != scp.pctMargin ) {
+
+        if ( ! FSetSpeed((DWORD)(((UINT64)pscr->frqSck * (100 - scp.pctMargin)) / 100), &frqSet) ) {
+            goto lErrorExit;
+        }
+
+        pscr->frqSck = frqSet;
+    }
+
+    fSuccess = fTrue;
+
+lErrorExit:
+
+    Free();
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FSearchSpeed
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse if a transfer failed
+**
+**  Errors:
+**
+**  Description:
+**      Find the fastest clock at which the signature passes. The
+**      signature is known to pass at the minimum clock.
+*/
+BOOL
+SpiCal::FSearchSpeed() {
+
+    DWORD   frqLo;
+    DWORD   frqHi;
+    DWORD   frqMid;
+    DWORD   frqSet;
+    BOOL    fPass;
+
+    if ( ! FSetSpeed(scp.frqMax, &frqSet) ) {
+        return fFalse;
+    }
+
+    if ( frqSet != pscr->frqSck ) {
+
+        if ( ! FTest(scp.ctrial, &fPass) ) {
+            return fFalse;
+        }
+
+        if ( fPass ) {
+
+            pscr->frqSck = frqSet;
+            return fTrue;
+        }
+    }
+
+    frqLo = scp.frqMin;
+    frqHi = scp.frqMax;
+
+    while ( frqHi - frqLo > frqLo / frqResolution ) {
+
+        frqMid = frqLo + (frqHi - frqLo) / 2;
+
+        if ( ! FSetSpeed(frqMid, &frqSet) ) {
+            return fFalse;
+        }
+
+        /* The port may only support a few clock rates. There is no need
+        ** to test a rate that has already passed.
+        */
+        fPass = ( frqSet == pscr->frqSck );
+
+        if (( ! fPass ) && ( ! FTest(scp.ctrial, &fPass) )) {
+            return fFalse;
+        }
+
+        if ( fPass ) {
+
+            frqLo = frqMid;
+            pscr->frqSck = frqSet;
+        }
+        else {
+            frqHi = frqMid;
+        }
+    }
+
+    return FSetSpeed(pscr->frqSck, &frqSet);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FSearchDelays
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse if a transfer failed
+**
+**  Errors:
+**
+**  Description:
+**      Search each of the delays supported by the port in turn.
+*/
+BOOL
+SpiCal::FSearchDelays() {
+
+    if (( dprp & dprpSpiDelay ) && ( ! FSearchDelay(&pscr->tusDelay) )) {
+        return fFalse;
+    }
+
+    if ( dprp & dprpSpiStartEndDelay ) {
+
+        if (( ! FSearchDelay(&pscr->tusStart) ) || ( ! FSearchDelay(&pscr->tusEnd) )) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FSearchDelay
+**
+**  Parameters:
+**      ptus    - delay to search, one of the delays in the results
+**
+**  Return Values:
+**      fTrue for success, fFalse if a transfer failed
+**
+**  Errors:
+**
+**  Description:
+**      Find the smallest value of a delay at which the signature
+**      passes. The current value of the delay is known to pass, and is
+**      the largest value tried.
+*/
+BOOL
+SpiCal::FSearchDelay( DWORD * ptus ) {
+
+    DWORD   tusLo;
+    DWORD   tusHi;
+    DWORD   tusMax;
+    BOOL    fPass;
+
+    tusMax = *ptus;
+    if ( 0 == tusMax ) {
+        return fTrue;
+    }
+
+    /* A delay of tusLo fails and a delay of tusHi passes.
+    */
+    tusLo = 0;
+    tusHi = tusMax;
+
+    *ptus = 0;
+    if (( ! FSetDelays() ) || ( ! FTest(scp.ctrial, &fPass) )) {
+        return fFalse;
+    }
+
+    if ( fPass ) {
+        tusHi = 0;
+    }
+
+    while ( 1 < tusHi - tusLo ) {
+
+        *ptus = tusLo + (tusHi - tusLo) / 2;
+
+        if (( ! FSetDelays() ) || ( ! FTest(scp.ctrial, &fPass) )) {
+            return fFalse;
+        }
+
+        if ( fPass ) {
+            tusHi = *ptus;
+        }
+        else {
+            tusLo = *ptus;
+        }
+    }
+
+    /* A delay that passed by chance is caught by a longer run. Raise
+    ** it a quarter at a time until it passes again.
+    */
+    *ptus = tusHi;
+
+    while ( fTrue ) {
+
+        if (( ! FSetDelays() ) || ( ! FTest(scp.ctrial * cConfirm, &fPass) )) {
+            return fFalse;
+        }
+
+        if (( fPass ) || ( tusMax == *ptus )) {
+            return fTrue;
+        }
+
+        *ptus += *ptus / 4 + 1;
+        if ( tusMax < *ptus ) {
+            *ptus = tusMax;
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FConfirm
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no clock above the minimum passes the check.
+**
+**  Description:
+**      Check the settings found with a longer run, lowering the clock
+**      until the check passes.
+*/
+BOOL
+SpiCal::FConfirm() {
+
+    DWORD   frqSet;
+    BOOL    fPass;
+
+    while ( fTrue ) {
+
+        if ( ! FTest(scp.ctrial * cConfirm, &fPass) ) {
+            return fFalse;
+        }
+
+        if ( fPass ) {
+            return fTrue;
+        }
+
+        if ( pscr->frqSck <= scp.frqMin ) {
+            return fFalse;
+        }
+
+        if ( ! FSetSpeed(pscr->frqSck - pscr->frqSck / 16, &frqSet) ) {
+            return fFalse;
+        }
+
+        /* Stop if the port can't go any slower than the rate that
+        ** just failed.
+        */
+        if ( frqSet >= pscr->frqSck ) {
+            return fFalse;
+        }
+
+        pscr->frqSck = frqSet;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FCaptureRef
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails for a response signature if the slave doesn't drive MISO.
+**
+**  Description:
+**      Fill in the data expected from each transfer. For a loopback it
+**      is the data sent, a pseudo-random sequence that starts each
+**      transfer with alternating bits. For a response it is the data
+**      received at the current clock by the first transfer.
+*/
+BOOL
+SpiCal::FCaptureRef() {
+
+    DWORD   ib;
+    DWORD   cb;
+    DWORD   dwSeed;
+    BYTE    bFirst;
+
+    cb = scp.ctrial * cConfirm * scp.cbSig;
+
+    if ( sigkLoopback == scp.sigk ) {
+
+        dwSeed = 0x2F6B1C35;
+        for ( ib = 0; ib < cb; ib++ ) {
+
+            if (( ib % scp.cbSig ) < 2 ) {
+                rgbRef[ib] = ( 0 == ib % 2 ) ? 0x55 : 0xAA;
+            }
+            else {
+                dwSeed = dwSeed * 1103515245 + 12345;
+                rgbRef[ib] = (BYTE)(dwSeed >> 16);
+            }
+        }
+
+        return fTrue;
+    }
+
+    if ( ! FTransfer(1) ) {
+        return fFalse;
+    }
+
+    /* A response that is all zeros or all ones means that nothing is
+    ** driving MISO, and would pass at any clock.
+    */
+    bFirst = rgbRcv[0];
+    for ( ib = 1; ib < scp.cbSig; ib++ ) {
+
+        if ( bFirst != rgbRcv[ib] ) {
+            break;
+        }
+    }
+
+    if (( ib == scp.cbSig ) && (( 0x00 == bFirst ) || ( 0xFF == bFirst ))) {
+        return fFalse;
+    }
+
+    for ( ib = 0; ib < cb; ib += scp.cbSig ) {
+        memcpy(&rgbRef[ib], rgbRcv, scp.cbSig);
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FTest
+**
+**  Parameters:
+**      ctrial  - number of transfers
+**      pfPass  - receives fTrue if the errors are within the budget
+**
+**  Return Values:
+**      fTrue for success, fFalse if a transfer failed
+**
+**  Errors:
+**
+**  Description:
+**      Run a test point with the current settings.
+*/
+BOOL
+SpiCal::FTest( DWORD ctrial, BOOL * pfPass ) {
+
+    if ( ! FTransfer(ctrial) ) {
+        return fFalse;
+    }
+
+    pscr->ctest++;
+    pscr->cbitErr = CbitDiff(rgbRef, rgbRcv, ctrial * scp.cbSig);
+
+    *pfPass = ( pscr->cbitErr <= scp.cbitErrMax );
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FTransfer
+**
+**  Parameters:
+**      ctrial  - number of transfers
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Send the transfers of a test point in one batch. The data
+**      received by each transfer is placed in rgbRcv.
+*/
+BOOL
+SpiCal::FTransfer( DWORD ctrial ) {
+
+    DWORD   itrial;
+    DWORD   ib;
+
+    psb->Reset();
+
+    for ( itrial = 0; itrial < ctrial; itrial++ ) {
+
+        ib = itrial * scp.cbSig;
+
+        psb->FSelect();
+
+        if ( sigkLoopback == scp.sigk ) {
+            psb->FPut(&rgbRef[ib], scp.cbSig, &rgbRcv[ib]);
+        }
+        else {
+            psb->FPut(scp.rgbCmd, scp.cbCmd, NULL);
+            psb->FGet(&rgbRcv[ib], scp.cbSig, bScFill);
+        }
+
+        psb->FDeselect();
+    }
+
+    return psb->FExecute(hif);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FSetSpeed
+**
+**  Parameters:
+**      frqReq      - clock frequency wanted
+**      pfrqSet     - receives the frequency set
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the clock frequency. A port with a fixed clock reports the
+**      clock it has, so the search ends after the first test point.
+*/
+BOOL
+SpiCal::FSetSpeed( DWORD frqReq, DWORD * pfrqSet ) {
+
+    if ( ! ( dprp & dprpSpiSetSpeed ) ) {
+        return DspiGetSpeed(hif, pfrqSet);
+    }
+
+    return DspiSetSpeed(hif, frqReq, pfrqSet);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::FSetDelays
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Set the delays held in the results.
+*/
+BOOL
+SpiCal::FSetDelays() {
+
+    if (( dprp & dprpSpiDelay ) && ( ! DspiSetDelay(hif, pscr->tusDelay) )) {
+        return fFalse;
+    }
+
+    if (( dprp & dprpSpiStartEndDelay ) &&
+        ( ! DspiSetStartEndDelay(hif, pscr->tusStart, pscr->tusEnd) )) {
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCal::Free
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Free the buffers used while calibrating.
+*/
+void
+SpiCal::Free() {
+
+    free(rgbRef);
+    free(rgbRcv);
+    delete psb;
+
+    rgbRef = NULL;
+    rgbRcv = NULL;
+    psb = NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiCalDefaults
+**
+**  Parameters:
+**      pscp    - receives the default parameters
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Fill in parameters for a loopback calibration with no errors
+**      allowed. The response command defaults to the JEDEC read ID
+**      command of serial flash parts.
+*/
+void
+SpiCalDefaults( SCPARAM * pscp ) {
+
+    memset(pscp, 0, sizeof(SCPARAM));
+
+    pscp->sigk = sigkLoopback;
+    pscp->rgbCmd[0] = 0x9F;
+    pscp->cbCmd = 1;
+    pscp->cbSig = 256;
+    pscp->ctrial = 16;
+    pscp->cbitErrMax = 0;
+    pscp->frqMin = 100000;
+    pscp->frqMax = 50000000;
+    pscp->pctMargin = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiCalApply
+**
+**  Parameters:
+**      hif     - device with DSPI enabled
+**      dprp    - properties of the port
+**      pscr    - settings to apply
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Configure a port with calibrated settings.
+*/
+BOOL
+FSpiCalApply( HIF hif, DWORD dprp, const SCRESULT * pscr ) {
+
+    DWORD   frqSet;
+
+    if (( dprp & dprpSpiSetSpeed ) && ( ! DspiSetSpeed(hif, pscr->frqSck, &frqSet) )) {
+        return fFalse;
+    }
+
+    if (( dprp & dprpSpiDelay ) && ( ! DspiSetDelay(hif, pscr->tusDelay) )) {
+        return fFalse;
+    }
+
+    if (( dprp & dprpSpiStartEndDelay ) &&
+        ( ! DspiSetStartEndDelay(hif, pscr->tusStart, pscr->tusEnd) )) {
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiCalGetSerial
+**
+**  Parameters:
+**      hif     - open device
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the serial number that calibration results are stored under.
+*/
+BOOL
+FSpiCalGetSerial( HIF hif, char * szSn ) {
+
+    DVC     dvc;
+    char    szTmp[cchDvcNameMax + 1];
+
+    if ( ! DmgrGetDvcFromHif(hif, &dvc) ) {
+        return fFalse;
+    }
+
+    if ( ! DmgrGetInfo(&dvc, dinfoSN, szTmp) ) {
+        return fFalse;
+    }
+
+    szTmp[cchSnMax] = '\0';
+    strcpy(szSn, szTmp);
+
+    return ( '\0' != szSn[0] );
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiCalPath
+**
+**  Parameters:
+**      szPath  - receives the path of the calibration file
+**      cchMax  - size of szPath
+**
+**  Return Values:
+**      fTrue for success, fFalse if the path doesn't fit
+**
+**  Errors:
+**
+**  Description:
+**      Get the path of the default calibration file, in the home
+**      directory if there is one and the current directory otherwise.
+*/
+BOOL
+FSpiCalPath( char * szPath, DWORD cchMax ) {
+
+    const char *    szHome;
+    int             cch;
+
+    szHome = getenv("HOME");
+
+    if (( NULL == szHome ) || ( '\0' == szHome[0] )) {
+        cch = snprintf(szPath, cchMax, "%s", szScFileDefault);
+    }
+    else {
+        cch = snprintf(szPath, cchMax, "%s/%s", szHome, szScFileDefault);
+    }
+
+    return (( 0 <= cch ) && ( (DWORD)cch < cchMax ));
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiCalLoad
+**
+**  Parameters:
+**      szPath  - calibration file
+**      szSn    - serial number of the device
+**      prt     - DSPI port
+**      pscr    - receives the stored settings
+**
+**  Return Values:
+**      fTrue if settings were found, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Look up the settings stored for a port.
+*/
+BOOL
+FSpiCalLoad( const char * szPath, const char * szSn, INT32 prt, SCRESULT * pscr ) {
+
+    FILE *  pfile;
+    char    szLine[cchScLineMax];
+    char    szSnLine[cchSnMax + 1];
+    INT32   prtLine;
+    BOOL    fFound;
+
+    pfile = fopen(szPath, "r");
+    if ( NULL == pfile ) {
+        return fFalse;
+    }
+
+    fFound = fFalse;
+
+    while (( ! fFound ) && ( NULL != fgets(szLine, sizeof(szLine), pfile) )) {
+
+        if (( FParseLine(szLine, szSnLine, &prtLine, pscr) ) &&
+            ( 0 == strcmp(szSn, szSnLine) ) && ( prt == prtLine )) {
+            fFound = fTrue;
+        }
+    }
+
+    fclose(pfile);
+
+    return fFound;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSpiCalSave
+**
+**  Parameters:
+**      szPath  - calibration file
+**      szSn    - serial number of the device
+**      prt     - DSPI port
+**      pscr    - settings to store
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Store the settings for a port, replacing any stored before. The
+**      file is rewritten under a temporary name and then renamed, so
+**      it is never left half written.
+*/
+BOOL
+FSpiCalSave( const char * szPath, const char * szSn, INT32 prt, const SCRESULT * pscr ) {
+
+    FILE *      pfileOld;
+    FILE *      pfileNew;
+    char        szTmp[cchScLineMax + 8];
+    char        szLine[cchScLineMax];
+    char        szSnLine[cchSnMax + 1];
+    INT32       prtLine;
+    SCRESULT    scrLine;
+    BOOL        fSuccess;
+
+    if ( sizeof(szTmp) <= (size_t)snprintf(szTmp, sizeof(szTmp), "%s.tmp", szPath) ) {
+        return fFalse;
+    }
+
+    pfileNew = fopen(szTmp, "w");
+    if ( NULL == pfileNew ) {
+        return fFalse;
+    }
+
+    fprintf(pfileNew, "# serial port frequency delay start-delay end-delay\n");
+
+    /* Copy the settings of every other port.
+    */
+    pfileOld = fopen(szPath, "r");
+    if ( NULL != pfileOld ) {
+
+        while ( NULL != fgets(szLine, sizeof(szLine), pfileOld) ) {
+
+            if (( FParseLine(szLine, szSnLine, &prtLine, &scrLine) ) &&
+                (( 0 != strcmp(szSn, szSnLine) ) || ( prt != prtLine ))) {
+                fputs(szLine, pfileNew);
+            }
+        }
+
+        fclose(pfileOld);
+    }
+
+    fprintf(pfileNew, "%s %d %u %u %u %u\n", szSn, prt,
+            pscr->frqSck, pscr->tusDelay, pscr->tusStart, pscr->tusEnd);
+
+    fSuccess = ( 0 == ferror(pfileNew) );
+
+    if ( 0 != fclose(pfileNew) ) {
+        fSuccess = fFalse;
+    }
+
+    if (( ! fSuccess ) || ( 0 != rename(szTmp, szPath) )) {
+
+        remove(szTmp);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseLine
+**
+**  Parameters:
+**      sz      - line of a calibration file
+**      szSn    - receives the serial number, cchSnMax+1 characters
+**      pprt    - receives the port
+**      pscr    - receives the settings
+**
+**  Return Values:
+**      fTrue if the line holds settings, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a line of a calibration file. Blank lines and lines that
+**      start with '#' are ignored.
+*/
+static BOOL
+FParseLine( const char * sz, char * szSn, INT32 * pprt, SCRESULT * pscr ) {
+
+    memset(pscr, 0, sizeof(SCRESULT));
+
+    if ( '#' == sz[0] ) {
+        return fFalse;
+    }
+
+    return ( 6 == sscanf(sz, "%15s %d %u %u %u %u", szSn, pprt,
+                         &pscr->frqSck, &pscr->tusDelay, &pscr->tusStart, &pscr->tusEnd) );
+}
+
+/* ------------------------------------------------------------ */
+/***    CbitDiff
+**
+**  Parameters:
+**      pb1     - first buffer
+**      pb2     - second buffer
+**      cb      - number of bytes to compare
+**
+**  Return Values:
+**      number of bits that differ
+**
+**  Errors:
+**
+**  Description:
+**      Count the bits that differ between two buffers.
+*/
+static DWORD
+CbitDiff( const BYTE * pb1, const BYTE * pb2, DWORD cb ) {
+
+    DWORD   cbit;
+    DWORD   ib;
+
+    cbit = 0;
+    for ( ib = 0; ib < cb; ib++ ) {
+        cbit += __builtin_popcount((unsigned)(pb1[ib] ^ pb2[ib]));
+    }
+
+    return cbit;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
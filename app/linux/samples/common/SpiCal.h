@@ -0,0 +1,135 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiCal.h  --    Interface Declarations for SpiCal.cpp             */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a DSPI   */
+/*    port calibration routine. The routine finds the fastest SPI clock */
+/*    at which a test signature is still received within an error       */
+/*    budget, then finds the smallest inter-byte, start and end delays  */
+/*    that still pass at that clock.                                    */
+/*                                                                      */
+/*    Two kinds of signature are supported:                             */
+/*        loopback - MOSI is wired to MISO and every byte sent must be  */
+/*                   received unchanged.                                */
+/*        response - a command is sent to the slave and the bytes that  */
+/*                   follow must match those returned by the same       */
+/*                   command at the slowest clock, e.g. a JEDEC ID.     */
+/*                                                                      */
+/*    The results are stored in a text file, one line per device serial */
+/*    number and port, so that applications can apply them when they    */
+/*    open the device.                                                  */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPICAL_INCLUDED)
+#define      SPICAL_INCLUDED
+
+class SpiBatch;
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Signature kinds.
+*/
+const int   sigkLoopback    = 0;
+const int   sigkResponse    = 1;
+
+/* Longest command that can be sent for a response signature.
+*/
+const DWORD cbScCmdMax      = 16;
+
+/* Name of the calibration file in the user's home directory.
+*/
+#define szScFileDefault     ".dspical"
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Calibration parameters.
+*/
+typedef struct {
+    int     sigk;                   // kind of signature
+    BYTE    rgbCmd[cbScCmdMax];     // command sent for a response signature
+    DWORD   cbCmd;
+    DWORD   cbSig;                  // bytes compared in each transfer
+    DWORD   ctrial;                 // transfers at each test point
+    DWORD   cbitErrMax;             // bit errors allowed at each test point
+    DWORD   frqMin;                 // clock range searched
+    DWORD   frqMax;
+    DWORD   pctMargin;              // clock reduction applied to the result
+} SCPARAM;
+
+/* Calibration results.
+*/
+typedef struct {
+    DWORD   frqSck;                 // clock frequency set
+    DWORD   tusDelay;               // inter-byte delay
+    DWORD   tusStart;               // select to first clock
+    DWORD   tusEnd;                 // last clock to deselect
+    DWORD   ctest;                  // test points run
+    DWORD   cbitErr;                // bit errors at the final test point
+} SCRESULT;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiCal {
+
+private:
+    HIF         hif;
+    DWORD       dprp;
+    SCPARAM     scp;
+    SCRESULT *  pscr;
+    BYTE *      rgbRef;         // expected data of each transfer
+    BYTE *      rgbRcv;         // data received by each transfer
+    SpiBatch *  psb;
+
+    BOOL    FSetSpeed(DWORD frqReq, DWORD * pfrqSet);
+    BOOL    FSetDelays();
+    BOOL    FTransfer(DWORD ctrial);
+    BOOL    FCaptureRef();
+    BOOL    FTest(DWORD ctrial, BOOL * pfPass);
+    BOOL    FSearchSpeed();
+    BOOL    FSearchDelays();
+    BOOL    FSearchDelay(DWORD * ptus);
+    BOOL    FConfirm();
+    void    Free();
+
+    SpiCal(const SpiCal &);
+    SpiCal & operator=(const SpiCal &);
+
+public:
+    SpiCal();
+    ~SpiCal();
+
+    void    Init(HIF hifReq, DWORD dprpReq);
+    BOOL    FRun(const SCPARAM * pscpReq, SCRESULT * pscrRes);
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+void    SpiCalDefaults(SCPARAM * pscp);
+BOOL    FSpiCalApply(HIF hif, DWORD dprp, const SCRESULT * pscr);
+BOOL    FSpiCalGetSerial(HIF hif, char * szSn);
+BOOL    FSpiCalPath(char * szPath, DWORD cchMax);
+BOOL    FSpiCalLoad(const char * szPath, const char * szSn, INT32 prt, SCRESULT * pscr);
+BOOL    FSpiCalSave(const char * szPath, const char * szSn, INT32 prt, const SCRESULT * pscr);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPICAL_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,98 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiDev.h  --    Simulated SPI slave interface                     */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the base class for software models of   */
+/*    SPI slaves. A model is driven one byte at a time, exactly as the  */
+/*    slave would be driven by the bus, so host code that talks to a    */
+/*    device can be tested without a board.                             */
+/*                                                                      */
+/*    Each model keeps a simulated clock. Every byte exchanged advances */
+/*    it by eight periods of the configured SCK frequency, and Wait     */
+/*    advances it by the delays that the host would spend sleeping.     */
+/*    Models use the clock for anything that takes time on the real     */
+/*    device, such as the busy time of a flash program or erase.        */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added SpiLoopback                                       */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIDEV_INCLUDED)
+#define      SPIDEV_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* SCK frequency assumed until SetSpeed is called.
+*/
+const DWORD frqSckDefault = 1000000;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiDev {
+
+private:
+    DWORD   frqSck;
+    UINT64  tnsNow;
+
+    SpiDev(const SpiDev &);
+    SpiDev & operator=(const SpiDev &);
+
+protected:
+    /* Called by the public functions below. A model must implement
+    ** these to respond to the select line and to the data shifted in.
+    */
+    virtual void    SetSelect(BOOL fSel) = 0;
+    virtual BYTE    BShift(BYTE bMosi) = 0;
+
+public:
+    SpiDev() : frqSck(frqSckDefault), tnsNow(0) { }
+    virtual ~SpiDev() { }
+
+    /* Change the state of the select line.
+    */
+    void Select(BOOL fSel) { SetSelect(fSel); }
+
+    /* Shift one byte out on MOSI and return the byte shifted in on
+    ** MISO.
+    */
+    BYTE BExchange(BYTE bMosi) {
+
+        tnsNow += (8ULL * 1000000000ULL) / frqSck;
+        return BShift(bMosi);
+    }
+
+    /* Let time pass without any bus activity.
+    */
+    void Wait(DWORD tus) { tnsNow += (UINT64)tus * 1000; }
+
+    void    SetSpeed(DWORD frq) { frqSck = ( 0 != frq ) ? frq : frqSckDefault; }
+    DWORD   FrqSpeed() const { return frqSck; }
+    UINT64  TnsNow() const { return tnsNow; }
+};
+
+/* A slave with MISO connected to MOSI, returning each byte as it is
+** shifted in whether or not it is selected.
+*/
+class SpiLoopback : public SpiDev {
+
+protected:
+    virtual void    SetSelect(BOOL) { }
+    virtual BYTE    BShift(BYTE bMosi) { return bMosi; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIDEV_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,408 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiEepromSim.cpp  --  Serial EEPROM model                           */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a model of a 25xx series serial EEPROM. The  */
+/*  command is taken from the first byte of each transaction. Reads     */
+/*  return data as soon as the address has been shifted in and wrap     */
+/*  around at the end of the array. Writes collect their data in a page */
+/*  buffer and are carried out when the slave is deselected.            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "SpiEepromSim.h"
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::SpiEepromSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a model with no memory. FInit must be called before
+**      the model is used.
+*/
+SpiEepromSim::SpiEepromSim() {
+
+    rgbMem = NULL;
+    cbMem = 0;
+    cbPage = 0;
+    cbAddr = 0;
+    fSel = fFalse;
+    fIgnore = fFalse;
+    bCmd = 0;
+    ibyte = 0;
+    ibAddr = 0;
+    rgbPage = NULL;
+    rgfPage = NULL;
+    bStatusNew = 0;
+    fWel = fFalse;
+    bBp = 0;
+    tnsBusyEnd = 0;
+    memset(&sess, 0, sizeof(sess));
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::~SpiEepromSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory array and page buffer.
+*/
+SpiEepromSim::~SpiEepromSim() {
+
+    free(rgbMem);
+    free(rgbPage);
+    free(rgfPage);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::FInit
+**
+**  Parameters:
+**      cbMemReq    - size of the array, a power of two
+**      cbPageReq   - size of a page, a power of two
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails for sizes that aren't powers of two, arrays of less than
+**      1 KB or more than 128 KB, pages larger than the array or if
+**      memory can't be allocated.
+**
+**  Description:
+**      Allocate an erased memory array with every bit set and clear
+**      the status register.
+*/
+BOOL
+SpiEepromSim::FInit( DWORD cbMemReq, DWORD cbPageReq ) {
+
+    if (( cbMemReq < 1024 ) || ( 128 * 1024 < cbMemReq ) ||
+        ( 0 != ( cbMemReq & (cbMemReq - 1) ) )) {
+        return fFalse;
+    }
+
+    if (( 0 == cbPageReq ) || ( cbMemReq < cbPageReq ) ||
+        ( 0 != ( cbPageReq & (cbPageReq - 1) ) )) {
+        return fFalse;
+    }
+
+    free(rgbMem);
+    free(rgbPage);
+    free(rgfPage);
+
+    cbMem = cbMemReq;
+    cbPage = cbPageReq;
+    cbAddr = ( 65536 < cbMem ) ? 3 : 2;
+
+    rgbMem = (BYTE *)malloc(cbMem);
+    rgbPage = (BYTE *)malloc(cbPage);
+    rgfPage = (BOOL *)malloc(cbPage * sizeof(BOOL));
+
+    if (( NULL == rgbMem ) || ( NULL == rgbPage ) || ( NULL == rgfPage )) {
+
+        free(rgbMem);
+        free(rgbPage);
+        free(rgfPage);
+        rgbMem = NULL;
+        rgbPage = NULL;
+        rgfPage = NULL;
+        cbMem = 0;
+        return fFalse;
+    }
+
+    memset(rgbMem, 0xFF, cbMem);
+
+    fWel = fFalse;
+    bBp = 0;
+    tnsBusyEnd = 0;
+    memset(&sess, 0, sizeof(sess));
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::SetSelect
+**
+**  Parameters:
+**      fSelNew     - new state of the select line
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Start a transaction on select, and carry out a write command on
+**      deselect.
+*/
+void
+SpiEepromSim::SetSelect( BOOL fSelNew ) {
+
+    if ( fSelNew == fSel ) {
+        return;
+    }
+
+    fSel = fSelNew;
+
+    if ( fSel ) {
+
+        fIgnore = fFalse;
+        bCmd = 0;
+        ibyte = 0;
+        ibAddr = 0;
+        memset(rgfPage, 0, cbPage * sizeof(BOOL));
+    }
+    else if (( ! fIgnore ) && ( 0 != ibyte )) {
+
+        Commit();
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::BShift
+**
+**  Parameters:
+**      bMosi       - byte shifted in
+**
+**  Return Values:
+**      byte shifted out
+**
+**  Errors:
+**
+**  Description:
+**      Handle one byte of a transaction. The byte shifted out is the
+**      one the part drives while bMosi is being shifted in.
+*/
+BYTE
+SpiEepromSim::BShift( BYTE bMosi ) {
+
+    BYTE    bMiso;
+
+    if ( ! fSel ) {
+        return 0xFF;
+    }
+
+    bMiso = 0xFF;
+
+    if ( 0 == ibyte ) {
+
+        /* Only read status is accepted during a write cycle.
+        */
+        bCmd = bMosi;
+        if (( FBusy() ) && ( cmdseReadStatus != bCmd )) {
+
+            fIgnore = fTrue;
+            sess.cignored++;
+        }
+    }
+    else if ( fIgnore ) {
+
+        /* The part doesn't drive MISO.
+        */
+    }
+    else if ( cmdseReadStatus == bCmd ) {
+
+        bMiso = BStatus();
+    }
+    else if ( cmdseWriteStatus == bCmd ) {
+
+        if ( 1 == ibyte ) {
+            bStatusNew = bMosi;
+        }
+    }
+    else if ( ibyte <= cbAddr ) {
+
+        ibAddr = (ibAddr << 8) | bMosi;
+    }
+    else if ( cmdseRead == bCmd ) {
+
+        bMiso = rgbMem[ibAddr++ & (cbMem - 1)];
+    }
+    else if ( cmdseWrite == bCmd ) {
+
+        /* Data wraps around within the page. Only the last byte sent to
+        ** each address is kept.
+        */
+        rgbPage[(ibAddr + ibyte - cbAddr - 1) & (cbPage - 1)] = bMosi;
+        rgfPage[(ibAddr + ibyte - cbAddr - 1) & (cbPage - 1)] = fTrue;
+    }
+
+    ibyte++;
+
+    return bMiso;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::BStatus
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      status register
+**
+**  Errors:
+**
+**  Description:
+**      Return the status register as of the model's current time.
+*/
+BYTE
+SpiEepromSim::BStatus() const {
+
+    return (FBusy() ? bseWip : 0) | (fWel ? bseWel : 0) | bBp;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::FProtected
+**
+**  Parameters:
+**      ib          - address
+**
+**  Return Values:
+**      fTrue if the block protect bits keep the address from being
+**      written, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Check an address against the protected region.
+*/
+BOOL
+SpiEepromSim::FProtected( DWORD ib ) const {
+
+    switch ( bBp ) {
+
+        case bseBp0:
+            return ib >= cbMem - cbMem / 4;
+
+        case bseBp1:
+            return ib >= cbMem / 2;
+
+        case bseBp0 | bseBp1:
+            return fTrue;
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiEepromSim::Commit
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      Writes without the write enable latch set, with an incomplete
+**      address or to a protected page are counted and ignored.
+**
+**  Description:
+**      Carry out the command of the transaction that just ended.
+*/
+void
+SpiEepromSim::Commit() {
+
+    DWORD   ib;
+    DWORD   ibPage;
+
+    switch ( bCmd ) {
+
+        case cmdseWriteEnable:
+            fWel = fTrue;
+            return;
+
+        case cmdseWriteDisable:
+            fWel = fFalse;
+            return;
+
+        case cmdseWrite:
+        case cmdseWriteStatus:
+            break;
+
+        default:
+            return;
+    }
+
+    if ( ! fWel ) {
+
+        sess.crejected++;
+        return;
+    }
+
+    if ( cmdseWriteStatus == bCmd ) {
+
+        if ( ibyte < 2 ) {
+            return;
+        }
+
+        bBp = bStatusNew & (bseBp0 | bseBp1);
+    }
+    else {
+
+        if ( ibyte <= cbAddr ) {
+            return;
+        }
+
+        ibAddr &= cbMem - 1;
+        ibPage = ibAddr & ~(cbPage - 1);
+
+        /* The whole page is rejected if it is protected, and no write
+        ** cycle is started.
+        */
+        if ( FProtected(ibPage) ) {
+
+            sess.cprotected++;
+            fWel = fFalse;
+            return;
+        }
+
+        for ( ib = 0; ib < cbPage; ib++ ) {
+
+            if ( rgfPage[ib] ) {
+                rgbMem[ibPage + ib] = rgbPage[ib];
+            }
+        }
+    }
+
+    sess.cwrite++;
+    tnsBusyEnd = TnsNow() + (UINT64)tusSesWrite * 1000;
+    fWel = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
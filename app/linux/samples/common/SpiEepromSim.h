@@ -0,0 +1,123 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiEepromSim.h  --    Interface Declarations for SpiEepromSim.cpp */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a model  */
+/*    of a 25xx series serial EEPROM: read, write, write enable/disable */
+/*    and read/write status. Parts of up to 64 KB take two address      */
+/*    bytes and larger parts take three.                                */
+/*                                                                      */
+/*    As on the real part, a write needs the write enable latch, can    */
+/*    change any bit, wraps around within its page, takes effect when   */
+/*    the part is deselected and then keeps the part busy for the write */
+/*    cycle time. The block protect bits of the status register keep    */
+/*    the upper quarter, the upper half or all of the array from being  */
+/*    written.                                                          */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIEEPROMSIM_INCLUDED)
+#define      SPIEEPROMSIM_INCLUDED
+
+#include "SpiDev.h"
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* 25xx series EEPROM commands.
+*/
+const BYTE  cmdseRead           = 0x03;
+const BYTE  cmdseWrite          = 0x02;
+const BYTE  cmdseWriteDisable   = 0x04;
+const BYTE  cmdseWriteEnable    = 0x06;
+const BYTE  cmdseReadStatus     = 0x05;
+const BYTE  cmdseWriteStatus    = 0x01;
+
+/* Status register bits.
+*/
+const BYTE  bseWip              = 0x01;
+const BYTE  bseWel              = 0x02;
+const BYTE  bseBp0              = 0x04;
+const BYTE  bseBp1              = 0x08;
+
+/* Default size, page size and write cycle time, those of a 25LC256.
+*/
+const DWORD cbSesDefault        = 32768;
+const DWORD cbSesPageDefault    = 64;
+const DWORD tusSesWrite         = 5000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Counts of the operations performed by the model.
+*/
+typedef struct {
+    DWORD   cwrite;         // page and status writes
+    DWORD   cignored;       // commands ignored because the part was busy
+    DWORD   crejected;      // writes without write enable
+    DWORD   cprotected;     // writes to a protected address
+} SESSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiEepromSim : public SpiDev {
+
+private:
+    BYTE *      rgbMem;
+    DWORD       cbMem;
+    DWORD       cbPage;
+    DWORD       cbAddr;
+
+    /* State of the transaction in progress.
+    */
+    BOOL        fSel;
+    BOOL        fIgnore;
+    BYTE        bCmd;
+    DWORD       ibyte;
+    DWORD       ibAddr;
+    BYTE *      rgbPage;
+    BOOL *      rgfPage;
+    BYTE        bStatusNew;
+
+    BOOL        fWel;
+    BYTE        bBp;
+    UINT64      tnsBusyEnd;
+    SESSTATS    sess;
+
+    BOOL    FBusy() const { return TnsNow() < tnsBusyEnd; }
+    BYTE    BStatus() const;
+    BOOL    FProtected(DWORD ib) const;
+    void    Commit();
+
+protected:
+    virtual void    SetSelect(BOOL fSelNew);
+    virtual BYTE    BShift(BYTE bMosi);
+
+public:
+    SpiEepromSim();
+    virtual ~SpiEepromSim();
+
+    BOOL    FInit(DWORD cbMemReq, DWORD cbPageReq);
+
+    BYTE *  PbMem() { return rgbMem; }
+    DWORD   CbMem() const { return cbMem; }
+    void    GetStats(SESSTATS * psess) const { *psess = sess; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIEEPROMSIM_INCLUDED
+
+/************************************************************************/
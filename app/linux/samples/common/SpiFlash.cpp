@@ -0,0 +1,1136 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiFlash.cpp  --  Serial NOR flash programming engine               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a programming engine for serial NOR flash    */
+/*  parts attached to a DSPI port.                                      */
+/*                                                                      */
+/*  Page programs are pipelined. Each batch sent to the device holds a  */
+/*  continuous read of the status register, which polls the page that   */
+/*  was programmed by the previous batch, followed by the write enable  */
+/*  and program of the next page. The length of the status read adapts  */
+/*  to the observed page program time. If the last status byte shows    */
+/*  the part still busy, the part ignored the next program and it is    */
+/*  sent again once the part is ready. Programming a page twice with    */
+/*  the same data is harmless because programming can only clear bits.  */
+/*                                                                      */
+/*  Pages are compared with SSE2 or AVX2 when the processor supports    */
+/*  them. The comparison classifies each page as matching, programmable */
+/*  without an erase or needing an erase in a single pass.              */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SF_X86
+#include <immintrin.h>
+#endif
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "SpiDev.h"
+#include "SpiBatch.h"
+#include "SpiFlash.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Size of each fast read transaction and of the batches they are
+** grouped into.
+*/
+const DWORD     cbReadXfer = 65536;
+const DWORD     cbReadBatch = 1024 * 1024;
+
+/* Bounds of the status read that follows each page program.
+*/
+const DWORD     cbPollMin = 4;
+const DWORD     cbPollInit = 64;
+const DWORD     cbPollMax = 4096;
+
+/* Poll intervals while waiting for an erase or for the part to finish
+** a program, and the longest time to wait.
+*/
+const DWORD     tusPollErase = 2000;
+const DWORD     tusPollProgram = 100;
+const double    secReadyMax = 120.0;
+
+typedef struct {
+    BYTE            idMfg;
+    const char *    szMfg;
+} SFMFG;
+
+static const SFMFG  rgsfmfg[] = {
+    { 0x01, "Spansion" },
+    { 0x1F, "Adesto" },
+    { 0x20, "Micron" },
+    { 0x9D, "ISSI" },
+    { 0xBF, "SST" },
+    { 0xC2, "Macronix" },
+    { 0xC8, "GigaDevice" },
+    { 0xEF, "Winbond" },
+};
+
+typedef void (* PFNSFACC)(const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+                          UINT64 * pdwDiff, UINT64 * pdwSet);
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static PFNSFACC PfnSfAccBest();
+static void     SfAccScalar(const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+                            UINT64 * pdwDiff, UINT64 * pdwSet);
+
+#if defined(SF_X86)
+static void     SfAccSse2(const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+                          UINT64 * pdwDiff, UINT64 * pdwSet);
+static void     SfAccAvx2(const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+                          UINT64 * pdwDiff, UINT64 * pdwSet);
+#endif
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiFlash::SpiFlash
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an engine that isn't attached to a device.
+*/
+SpiFlash::SpiFlash() {
+
+    hif = hifInvalid;
+    pdev = NULL;
+    cbFlash = 0;
+    cbPoll = cbPollInit;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::Init
+**
+**  Parameters:
+**      hifReq      - open handle with DSPI enabled
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Attach the engine to a device. FDetect must be called before
+**      the part can be read or programmed.
+*/
+void
+SpiFlash::Init( HIF hifReq ) {
+
+    hif = hifReq;
+    pdev = NULL;
+    cbFlash = 0;
+    cbPoll = cbPollInit;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::Init
+**
+**  Parameters:
+**      pdevReq     - model of the part
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Attach the engine to a model of the part. All times reported by
+**      the engine are then taken from the model's clock.
+*/
+void
+SpiFlash::Init( SpiDev * pdevReq ) {
+
+    hif = hifInvalid;
+    pdev = pdevReq;
+    cbFlash = 0;
+    cbPoll = cbPollInit;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FDetect
+**
+**  Parameters:
+**      psfi        - receives the part information
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no part responds or the capacity code is unknown.
+**
+**  Description:
+**      Read the JEDEC ID and determine the size of the part. Parts
+**      larger than 16 MB are limited to the first 16 MB, which is all
+**      that three byte addresses can reach.
+*/
+BOOL
+SpiFlash::FDetect( SFINFO * psfi ) {
+
+    SpiBatch    sb;
+    BYTE        rgbId[3];
+    DWORD       imfg;
+
+    sb.FSelect();
+    sb.FPutByte(cmdsfReadId, NULL);
+    sb.FGet(rgbId, sizeof(rgbId), 0xFF);
+    sb.FDeselect();
+
+    if ( ! FExec(&sb) ) {
+        return fFalse;
+    }
+
+    memset(psfi, 0, sizeof(SFINFO));
+    psfi->idMfg = rgbId[0];
+    psfi->idType = rgbId[1];
+    psfi->idCap = rgbId[2];
+    psfi->szMfg = "unknown";
+
+    for ( imfg = 0; imfg < sizeof(rgsfmfg) / sizeof(rgsfmfg[0]); imfg++ ) {
+
+        if ( rgsfmfg[imfg].idMfg == rgbId[0] ) {
+            psfi->szMfg = rgsfmfg[imfg].szMfg;
+        }
+    }
+
+    if ((( 0x00 == rgbId[0] ) && ( 0x00 == rgbId[1] )) ||
+        (( 0xFF == rgbId[0] ) && ( 0xFF == rgbId[1] )) ||
+        ( rgbId[2] < 0x10 ) || ( 0x1F < rgbId[2] )) {
+
+        return fFalse;
+    }
+
+    cbFlash = ( rgbId[2] <= 0x18 ) ? (1UL << rgbId[2]) : cbsfMax;
+    psfi->cbFlash = cbFlash;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FRead
+**
+**  Parameters:
+**      ib          - address to read from
+**      pb          - receives the data
+**      cb          - number of bytes to read
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the region isn't inside the part.
+**
+**  Description:
+**      Read with the fast read command. Each batch holds several read
+**      transactions, which are overlapped by SpiBatch.
+*/
+BOOL
+SpiFlash::FRead( DWORD ib, BYTE * pb, DWORD cb ) {
+
+    SpiBatch    sb;
+    DWORD       cbXfer;
+    DWORD       cbBatch;
+
+    if (( ib > cbFlash ) || ( cb > cbFlash - ib )) {
+        return fFalse;
+    }
+
+    while ( 0 < cb ) {
+
+        sb.Reset();
+
+        for ( cbBatch = 0; ( 0 < cb ) && ( cbBatch < cbReadBatch ); cbBatch += cbXfer ) {
+
+            cbXfer = ( cb < cbReadXfer ) ? cb : cbReadXfer;
+
+            sb.FSelect();
+            AddAddress(&sb, cmdsfFastRead, ib);
+            sb.FFill(0xFF, 1);
+            sb.FGet(pb, cbXfer, 0xFF);
+            sb.FDeselect();
+
+            ib += cbXfer;
+            pb += cbXfer;
+            cb -= cbXfer;
+        }
+
+        if ( ! FExec(&sb) ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FErase
+**
+**  Parameters:
+**      ib          - start of the region
+**      cb          - size of the region
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the region isn't inside the part.
+**
+**  Description:
+**      Erase every sector that overlaps the region, using block erases
+**      for whole aligned blocks.
+*/
+BOOL
+SpiFlash::FErase( DWORD ib, DWORD cb ) {
+
+    DWORD   ibEnd;
+
+    if (( ib > cbFlash ) || ( cb > cbFlash - ib )) {
+        return fFalse;
+    }
+
+    ibEnd = (ib + cb + cbsfSector - 1) & ~(cbsfSector - 1);
+    ib &= ~(cbsfSector - 1);
+
+    while ( ib < ibEnd ) {
+
+        if (( 0 == (ib & (cbsfBlock - 1)) ) && ( cbsfBlock <= ibEnd - ib )) {
+
+            if ( ! FEraseUnit(cmdsfBlockErase, ib, tusPollErase) ) {
+                return fFalse;
+            }
+            ib += cbsfBlock;
+        }
+        else {
+
+            if ( ! FEraseUnit(cmdsfSectorErase, ib, tusPollErase) ) {
+                return fFalse;
+            }
+            ib += cbsfSector;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FProgram
+**
+**  Parameters:
+**      ib          - address to program
+**      pb          - image to program
+**      cb          - size of the image
+**      psfs        - receives counts and times
+**
+**  Return Values:
+**      fTrue if the region verifies, fFalse otherwise
+**
+**  Errors:
+**      Fails if the region isn't inside the part, memory can't be
+**      allocated or a transfer fails.
+**
+**  Description:
+**      Program an image. The sectors that the image overlaps are read
+**      first, so data in them outside of the image is preserved.
+*/
+BOOL
+SpiFlash::FProgram( DWORD ib, const BYTE * pb, DWORD cb, SFSTATS * psfs ) {
+
+    BYTE *  rgbCur;
+    BYTE *  rgbImg;
+    BYTE *  rgfErase;
+    BYTE *  rgfProgram;
+    DWORD   ibBase;
+    DWORD   cbRgn;
+    DWORD   cpage;
+    DWORD   csector;
+    DWORD   ipage;
+    DWORD   isector;
+    DWORD   cpageSector;
+    DWORD   csectorBlock;
+    double  secStart;
+    BOOL    fSuccess;
+
+    memset(psfs, 0, sizeof(SFSTATS));
+
+    if (( ib > cbFlash ) || ( cb > cbFlash - ib ) || ( 0 == cb )) {
+        return fFalse;
+    }
+
+    ibBase = ib & ~(cbsfSector - 1);
+    cbRgn = ((ib + cb + cbsfSector - 1) & ~(cbsfSector - 1)) - ibBase;
+    cpage = cbRgn / cbsfPage;
+    csector = cbRgn / cbsfSector;
+    cpageSector = cbsfSector / cbsfPage;
+    csectorBlock = cbsfBlock / cbsfSector;
+
+    fSuccess = fFalse;
+    rgbCur = (BYTE *)malloc(cbRgn);
+    rgbImg = (BYTE *)malloc(cbRgn);
+    rgfErase = (BYTE *)calloc(csector, 1);
+    rgfProgram = (BYTE *)calloc(cpage, 1);
+
+    if (( NULL == rgbCur ) || ( NULL == rgbImg ) ||
+        ( NULL == rgfErase ) || ( NULL == rgfProgram )) {
+
+        goto lErrorExit;
+    }
+
+    /* Phase 1: read the region and decide what has to be done to each
+    ** page and sector.
+    */
+    secStart = SecClock();
+
+    if ( ! FRead(ibBase, rgbCur, cbRgn) ) {
+        goto lErrorExit;
+    }
+
+    memcpy(rgbImg, rgbCur, cbRgn);
+    memcpy(&rgbImg[ib - ibBase], pb, cb);
+
+    for ( ipage = 0; ipage < cpage; ipage++ ) {
+
+        switch ( PgcmpCompare(&rgbCur[ipage * cbsfPage], &rgbImg[ipage * cbsfPage], cbsfPage) ) {
+
+            case pgcmpErase:
+                rgfErase[ipage / cpageSector] = fTrue;
+                break;
+
+            case pgcmpProgram:
+                rgfProgram[ipage] = fTrue;
+                break;
+        }
+    }
+
+    /* Every page of an erased sector has to be programmed unless it is
+    ** supposed to be blank.
+    */
+    for ( isector = 0; isector < csector; isector++ ) {
+
+        if ( rgfErase[isector] ) {
+
+            for ( ipage = isector * cpageSector; ipage < (isector + 1) * cpageSector; ipage++ ) {
+                rgfProgram[ipage] = ! FSfBlank(&rgbImg[ipage * cbsfPage], cbsfPage);
+            }
+        }
+    }
+
+    psfs->cpageTotal = cpage;
+    for ( ipage = 0; ipage < cpage; ipage++ ) {
+
+        if (( ! rgfProgram[ipage] ) && ( ! rgfErase[ipage / cpageSector] )) {
+            psfs->cpageSkipped++;
+        }
+    }
+
+    psfs->secCompare = SecClock() - secStart;
+
+    /* Phase 2: erase. Runs of sectors covering a whole block are erased
+    ** with one block erase.
+    */
+    secStart = SecClock();
+
+    for ( isector = 0; isector < csector; ) {
+
+        if ( ! rgfErase[isector] ) {
+
+            isector++;
+            continue;
+        }
+
+        if (( 0 == ((ibBase + isector * cbsfSector) & (cbsfBlock - 1)) ) &&
+            ( isector + csectorBlock <= csector ) &&
+            ( NULL == memchr(&rgfErase[isector], 0, csectorBlock) )) {
+
+            if ( ! FEraseUnit(cmdsfBlockErase, ibBase + isector * cbsfSector, tusPollErase) ) {
+                goto lErrorExit;
+            }
+
+            psfs->cblockErased++;
+            isector += csectorBlock;
+        }
+        else {
+
+            if ( ! FEraseUnit(cmdsfSectorErase, ibBase + isector * cbsfSector, tusPollErase) ) {
+                goto lErrorExit;
+            }
+
+            psfs->csectorErased++;
+            isector++;
+        }
+    }
+
+    psfs->secErase = SecClock() - secStart;
+
+    /* Phase 3: program.
+    */
+    secStart = SecClock();
+
+    if ( ! FProgramPages(rgbImg, ibBase, rgfProgram, cpage, psfs) ) {
+        goto lErrorExit;
+    }
+
+    psfs->secProgram = SecClock() - secStart;
+
+    /* Phase 4: verify the whole region.
+    */
+    secStart = SecClock();
+
+    if ( ! FVerify(ibBase, rgbImg, cbRgn, &psfs->cpageBad) ) {
+        goto lErrorExit;
+    }
+
+    psfs->secVerify = SecClock() - secStart;
+
+    fSuccess = ( 0 == psfs->cpageBad );
+
+lErrorExit:
+
+    free(rgbCur);
+    free(rgbImg);
+    free(rgfErase);
+    free(rgfProgram);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FVerify
+**
+**  Parameters:
+**      ib          - address of the region
+**      pb          - data the region should hold
+**      cb          - size of the region
+**      pcpageBad   - receives the number of pages that differ
+**
+**  Return Values:
+**      fTrue if the region could be read, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read a region back and count the pages that differ from pb.
+*/
+BOOL
+SpiFlash::FVerify( DWORD ib, const BYTE * pb, DWORD cb, DWORD * pcpageBad ) {
+
+    BYTE *  rgbRead;
+    DWORD   ibPage;
+    DWORD   cbPage;
+
+    *pcpageBad = 0;
+
+    rgbRead = (BYTE *)malloc(( 0 != cb ) ? cb : 1);
+    if ( NULL == rgbRead ) {
+        return fFalse;
+    }
+
+    if ( ! FRead(ib, rgbRead, cb) ) {
+
+        free(rgbRead);
+        return fFalse;
+    }
+
+    for ( ibPage = 0; ibPage < cb; ibPage += cbPage ) {
+
+        cbPage = ( cb - ibPage < cbsfPage ) ? cb - ibPage : cbsfPage;
+        if ( pgcmpMatch != PgcmpCompare(&rgbRead[ibPage], &pb[ibPage], cbPage) ) {
+            (*pcpageBad)++;
+        }
+    }
+
+    free(rgbRead);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FProgramPages
+**
+**  Parameters:
+**      pbImg       - image of the region
+**      ibBase      - address of the region
+**      rgfProgram  - flag for each page that needs to be programmed
+**      cpage       - number of pages in the region
+**      psfs        - receives the counts
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Program the flagged pages. Each batch polls the page programmed
+**      by the previous batch and then programs the next page.
+*/
+BOOL
+SpiFlash::FProgramPages( const BYTE * pbImg, DWORD ibBase, const BYTE * rgfProgram,
+                         DWORD cpage, SFSTATS * psfs ) {
+
+    SpiBatch    sb;
+    BYTE *      rgbStat;
+    DWORD       ipage;
+    DWORD       ibReady;
+    BOOL        fPoll;
+
+    rgbStat = (BYTE *)malloc(cbPollMax);
+    if ( NULL == rgbStat ) {
+        return fFalse;
+    }
+
+    fPoll = fFalse;
+    ipage = 0;
+
+    while ( fTrue ) {
+
+        while (( ipage < cpage ) && ( ! rgfProgram[ipage] )) {
+            ipage++;
+        }
+
+        if (( cpage <= ipage ) && ( ! fPoll )) {
+            break;
+        }
+
+        sb.Reset();
+
+        if ( fPoll ) {
+
+            sb.FSelect();
+            sb.FPutByte(cmdsfReadStatus, NULL);
+            sb.FGet(rgbStat, cbPoll, 0xFF);
+            sb.FDeselect();
+        }
+
+        if ( ipage < cpage ) {
+
+            AddWriteEnable(&sb);
+            sb.FSelect();
+            AddAddress(&sb, cmdsfPageProgram, ibBase + ipage * cbsfPage);
+            sb.FPut(&pbImg[ipage * cbsfPage], cbsfPage, NULL);
+            sb.FDeselect();
+        }
+
+        if ( ! FExec(&sb) ) {
+
+            free(rgbStat);
+            return fFalse;
+        }
+
+        if (( fPoll ) && ( 0 != (rgbStat[cbPoll - 1] & bsfWip) )) {
+
+            /* The previous page was still being programmed, so this
+            ** page was ignored. Poll for longer from now on.
+            */
+            if ( ! FWaitReady(tusPollProgram) ) {
+
+                free(rgbStat);
+                return fFalse;
+            }
+
+            cbPoll = ( 2 * cbPoll < cbPollMax ) ? 2 * cbPoll : cbPollMax;
+            fPoll = fFalse;
+
+            if ( ipage < cpage ) {
+                psfs->cpageRetried++;
+            }
+            continue;
+        }
+
+        if ( fPoll ) {
+
+            /* Trim the poll to a little more than the time the program
+            ** actually took.
+            */
+            for ( ibReady = 0; 0 != (rgbStat[ibReady] & bsfWip); ibReady++ ) {
+            }
+
+            cbPoll = ibReady + ibReady / 4 + cbPollMin;
+            if ( cbPollMax < cbPoll ) {
+                cbPoll = cbPollMax;
+            }
+        }
+
+        if ( cpage <= ipage ) {
+            break;
+        }
+
+        psfs->cpageProgrammed++;
+        fPoll = fTrue;
+        ipage++;
+    }
+
+    free(rgbStat);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FEraseUnit
+**
+**  Parameters:
+**      cmd         - erase command
+**      ib          - address in the sector or block
+**      tusPoll     - time between status polls
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Erase one sector or block and wait for the erase to finish.
+*/
+BOOL
+SpiFlash::FEraseUnit( BYTE cmd, DWORD ib, DWORD tusPoll ) {
+
+    SpiBatch    sb;
+
+    AddWriteEnable(&sb);
+    sb.FSelect();
+    AddAddress(&sb, cmd, ib);
+    sb.FDeselect();
+
+    return FExec(&sb) && FWaitReady(tusPoll);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FWaitReady
+**
+**  Parameters:
+**      tusPoll     - time between status polls
+**
+**  Return Values:
+**      fTrue once the part is ready, fFalse on failure or timeout
+**
+**  Errors:
+**
+**  Description:
+**      Poll the status register until the busy bit is clear.
+*/
+BOOL
+SpiFlash::FWaitReady( DWORD tusPoll ) {
+
+    SpiBatch    sb;
+    BYTE        bStat;
+    double      secStart;
+
+    secStart = SecClock();
+
+    sb.FSelect();
+    sb.FPutByte(cmdsfReadStatus, NULL);
+    sb.FGet(&bStat, 1, 0xFF);
+    sb.FDeselect();
+    sb.FDelay(tusPoll);
+
+    do {
+
+        if ( ! FExec(&sb) ) {
+            return fFalse;
+        }
+
+        if ( 0 == (bStat & bsfWip) ) {
+            return fTrue;
+        }
+
+    } while ( SecClock() - secStart < secReadyMax );
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::AddWriteEnable
+**
+**  Parameters:
+**      psb         - batch to add to
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Add a write enable transaction.
+*/
+void
+SpiFlash::AddWriteEnable( SpiBatch * psb ) {
+
+    psb->FSelect();
+    psb->FPutByte(cmdsfWriteEnable, NULL);
+    psb->FDeselect();
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::AddAddress
+**
+**  Parameters:
+**      psb         - batch to add to
+**      cmd         - command
+**      ib          - address
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Add a command followed by a three byte address.
+*/
+void
+SpiFlash::AddAddress( SpiBatch * psb, BYTE cmd, DWORD ib ) {
+
+    BYTE    rgb[4];
+
+    rgb[0] = cmd;
+    rgb[1] = (BYTE)(ib >> 16);
+    rgb[2] = (BYTE)(ib >> 8);
+    rgb[3] = (BYTE)ib;
+
+    psb->FPut(rgb, sizeof(rgb), NULL);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::FExec
+**
+**  Parameters:
+**      psb         - batch to run
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Run a batch on the device or model the engine is attached to.
+*/
+BOOL
+SpiFlash::FExec( SpiBatch * psb ) {
+
+    if ( NULL != pdev ) {
+        return psb->FExecute(pdev);
+    }
+
+    return psb->FExecute(hif);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlash::SecClock
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      current time in seconds
+**
+**  Errors:
+**
+**  Description:
+**      Return the time of the model if there is one, or else of the
+**      monotonic clock.
+*/
+double
+SpiFlash::SecClock() const {
+
+    if ( NULL != pdev ) {
+        return (double)pdev->TnsNow() / 1000000000.0;
+    }
+
+    return SecNow();
+}
+
+/* ------------------------------------------------------------ */
+/***    PgcmpCompare
+**
+**  Parameters:
+**      pbCur       - current contents of the flash
+**      pbNew       - data wanted in the flash
+**      cb          - number of bytes to compare
+**
+**  Return Values:
+**      pgcmpMatch, pgcmpProgram or pgcmpErase
+**
+**  Errors:
+**
+**  Description:
+**      Classify a page. A page can be programmed without an erase if
+**      no bit needs to change from 0 to 1.
+*/
+int
+PgcmpCompare( const BYTE * pbCur, const BYTE * pbNew, DWORD cb ) {
+
+    static PFNSFACC pfnAcc = NULL;
+    UINT64          dwDiff;
+    UINT64          dwSet;
+
+    if ( NULL == pfnAcc ) {
+        pfnAcc = PfnSfAccBest();
+    }
+
+    dwDiff = 0;
+    dwSet = 0;
+    pfnAcc(pbCur, pbNew, cb, &dwDiff, &dwSet);
+
+    if ( 0 != dwSet ) {
+        return pgcmpErase;
+    }
+
+    return ( 0 != dwDiff ) ? pgcmpProgram : pgcmpMatch;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSfBlank
+**
+**  Parameters:
+**      pb          - data
+**      cb          - number of bytes
+**
+**  Return Values:
+**      fTrue if every byte is 0xFF
+**
+**  Errors:
+**
+**  Description:
+**      Test whether data is the same as erased flash. This is the same
+**      as testing whether erased flash already matches the data.
+*/
+BOOL
+FSfBlank( const BYTE * pb, DWORD cb ) {
+
+    static BYTE rgbErased[cbsfPage];
+    static BOOL fInit = fFalse;
+    DWORD       ib;
+    DWORD       cbCmp;
+
+    if ( ! fInit ) {
+
+        memset(rgbErased, 0xFF, sizeof(rgbErased));
+        fInit = fTrue;
+    }
+
+    for ( ib = 0; ib < cb; ib += cbCmp ) {
+
+        cbCmp = ( cb - ib < cbsfPage ) ? cb - ib : cbsfPage;
+        if ( pgcmpMatch != PgcmpCompare(rgbErased, &pb[ib], cbCmp) ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    PfnSfAccBest
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fastest comparison kernel the processor supports
+**
+**  Errors:
+**
+**  Description:
+**      Select the comparison kernel.
+*/
+static PFNSFACC
+PfnSfAccBest() {
+
+#if defined(SF_X86)
+
+    if ( __builtin_cpu_supports("avx2") ) {
+        return SfAccAvx2;
+    }
+
+    if ( __builtin_cpu_supports("sse2") ) {
+        return SfAccSse2;
+    }
+
+#endif
+
+    return SfAccScalar;
+}
+
+/* ------------------------------------------------------------ */
+/***    SfAccScalar
+**
+**  Parameters:
+**      pbCur       - current contents of the flash
+**      pbNew       - data wanted in the flash
+**      cb          - number of bytes
+**      pdwDiff     - accumulates the bits that differ
+**      pdwSet      - accumulates the bits that must change from 0 to 1
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Comparison kernel for processors without SIMD support. The
+**      SIMD kernels call it for the bytes left over at the end.
+*/
+static void
+SfAccScalar( const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+             UINT64 * pdwDiff, UINT64 * pdwSet ) {
+
+    UINT64  dwCur;
+    UINT64  dwNew;
+    UINT64  dwDiff;
+    UINT64  dwSet;
+    DWORD   ib;
+
+    dwDiff = 0;
+    dwSet = 0;
+
+    for ( ib = 0; ib + 8 <= cb; ib += 8 ) {
+
+        memcpy(&dwCur, &pbCur[ib], 8);
+        memcpy(&dwNew, &pbNew[ib], 8);
+
+        dwDiff |= dwCur ^ dwNew;
+        dwSet |= ~dwCur & dwNew;
+    }
+
+    for ( ; ib < cb; ib++ ) {
+
+        dwDiff |= (BYTE)(pbCur[ib] ^ pbNew[ib]);
+        dwSet |= (BYTE)(~pbCur[ib] & pbNew[ib]);
+    }
+
+    *pdwDiff |= dwDiff;
+    *pdwSet |= dwSet;
+}
+
+#if defined(SF_X86)
+
+/* ------------------------------------------------------------ */
+/***    SfAccSse2
+**
+**  Parameters:
+**      see SfAccScalar
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Comparison kernel using SSE2, 16 bytes at a time.
+*/
+__attribute__((target("sse2")))
+static void
+SfAccSse2( const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+           UINT64 * pdwDiff, UINT64 * pdwSet ) {
+
+    __m128i xmmCur;
+    __m128i xmmNew;
+    __m128i xmmDiff;
+    __m128i xmmSet;
+    __m128i xmmZero;
+    DWORD   ib;
+
+    xmmDiff = _mm_setzero_si128();
+    xmmSet = _mm_setzero_si128();
+    xmmZero = _mm_setzero_si128();
+
+    for ( ib = 0; ib + 16 <= cb; ib += 16 ) {
+
+        xmmCur = _mm_loadu_si128((const __m128i *)&pbCur[ib]);
+        xmmNew = _mm_loadu_si128((const __m128i *)&pbNew[ib]);
+
+        xmmDiff = _mm_or_si128(xmmDiff, _mm_xor_si128(xmmCur, xmmNew));
+        xmmSet = _mm_or_si128(xmmSet, _mm_andnot_si128(xmmCur, xmmNew));
+    }
+
+    if ( 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(xmmDiff, xmmZero)) ) {
+        *pdwDiff |= 1;
+    }
+
+    if ( 0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(xmmSet, xmmZero)) ) {
+        *pdwSet |= 1;
+    }
+
+    SfAccScalar(&pbCur[ib], &pbNew[ib], cb - ib, pdwDiff, pdwSet);
+}
+
+/* ------------------------------------------------------------ */
+/***    SfAccAvx2
+**
+**  Parameters:
+**      see SfAccScalar
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Comparison kernel using AVX2, 32 bytes at a time.
+*/
+__attribute__((target("avx2")))
+static void
+SfAccAvx2( const BYTE * pbCur, const BYTE * pbNew, DWORD cb,
+           UINT64 * pdwDiff, UINT64 * pdwSet ) {
+
+    __m256i ymmCur;
+    __m256i ymmNew;
+    __m256i ymmDiff;
+    __m256i ymmSet;
+    DWORD   ib;
+
+    ymmDiff = _mm256_setzero_si256();
+    ymmSet = _mm256_setzero_si256();
+
+    for ( ib = 0; ib + 32 <= cb; ib += 32 ) {
+
+        ymmCur = _mm256_loadu_si256((const __m256i *)&pbCur[ib]);
+        ymmNew = _mm256_loadu_si256((const __m256i *)&pbNew[ib]);
+
+        ymmDiff = _mm256_or_si256(ymmDiff, _mm256_xor_si256(ymmCur, ymmNew));
+        ymmSet = _mm256_or_si256(ymmSet, _mm256_andnot_si256(ymmCur, ymmNew));
+    }
+
+    if ( ! _mm256_testz_si256(ymmDiff, ymmDiff) ) {
+        *pdwDiff |= 1;
+    }
+
+    if ( ! _mm256_testz_si256(ymmSet, ymmSet) ) {
+        *pdwSet |= 1;
+    }
+
+    SfAccScalar(&pbCur[ib], &pbNew[ib], cb - ib, pdwDiff, pdwSet);
+}
+
+#endif
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,158 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiFlash.h  --    Interface Declarations for SpiFlash.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a serial */
+/*    NOR flash programming engine built on DspiPut and DspiGet. The    */
+/*    engine detects the part from its JEDEC ID and programs an image   */
+/*    in four phases:                                                   */
+/*        1. Read the region being programmed and compare it with the   */
+/*           image. Pages that already match are skipped and sectors    */
+/*           whose pages only need bits cleared aren't erased.          */
+/*        2. Erase the sectors that need it, using 64 KB block erases   */
+/*           wherever a whole block has to be erased.                   */
+/*        3. Program the pages back to back. The status poll for each   */
+/*           page is sent in the same batch as the next page program.   */
+/*        4. Read the region back with fast read and verify it.         */
+/*                                                                      */
+/*    All transfers go through SpiBatch, so the engine can be run       */
+/*    against a real device or against a model such as SpiFlashSim.     */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIFLASH_INCLUDED)
+#define      SPIFLASH_INCLUDED
+
+class SpiBatch;
+class SpiDev;
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* JEDEC serial flash commands.
+*/
+const BYTE  cmdsfWriteEnable    = 0x06;
+const BYTE  cmdsfWriteDisable   = 0x04;
+const BYTE  cmdsfReadStatus     = 0x05;
+const BYTE  cmdsfRead           = 0x03;
+const BYTE  cmdsfFastRead       = 0x0B;
+const BYTE  cmdsfPageProgram    = 0x02;
+const BYTE  cmdsfSectorErase    = 0x20;
+const BYTE  cmdsfBlockErase32   = 0x52;
+const BYTE  cmdsfBlockErase     = 0xD8;
+const BYTE  cmdsfChipErase      = 0xC7;
+const BYTE  cmdsfChipErase2     = 0x60;
+const BYTE  cmdsfReadId         = 0x9F;
+
+/* Status register bits.
+*/
+const BYTE  bsfWip              = 0x01;
+const BYTE  bsfWel              = 0x02;
+
+/* Program and erase granularity.
+*/
+const DWORD cbsfPage            = 256;
+const DWORD cbsfSector          = 4096;
+const DWORD cbsfBlock32         = 32768;
+const DWORD cbsfBlock           = 65536;
+
+/* Largest part that can be addressed with three address bytes.
+*/
+const DWORD cbsfMax             = 16 * 1024 * 1024;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Part information returned by FDetect.
+*/
+typedef struct {
+    BYTE            idMfg;
+    BYTE            idType;
+    BYTE            idCap;
+    DWORD           cbFlash;
+    const char *    szMfg;
+} SFINFO;
+
+/* Counts and times of the work done by FProgram.
+*/
+typedef struct {
+    DWORD   cpageTotal;         // pages in the region programmed
+    DWORD   cpageSkipped;       // pages that already matched
+    DWORD   cpageProgrammed;    // page programs issued
+    DWORD   cpageRetried;       // programs sent while the part was still busy
+    DWORD   csectorErased;      // 4 KB sector erases
+    DWORD   cblockErased;       // 64 KB block erases
+    DWORD   cpageBad;           // pages that failed verification
+    double  secCompare;
+    double  secErase;
+    double  secProgram;
+    double  secVerify;
+} SFSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiFlash {
+
+private:
+    HIF         hif;
+    SpiDev *    pdev;
+    DWORD       cbFlash;
+    DWORD       cbPoll;         // status bytes read after each page program
+
+    BOOL    FExec(SpiBatch * psb);
+    double  SecClock() const;
+    void    AddWriteEnable(SpiBatch * psb);
+    void    AddAddress(SpiBatch * psb, BYTE cmd, DWORD ib);
+    BOOL    FWaitReady(DWORD tusPoll);
+    BOOL    FEraseUnit(BYTE cmd, DWORD ib, DWORD tusPoll);
+    BOOL    FProgramPages(const BYTE * pbImg, DWORD ibBase, const BYTE * rgfProgram,
+                          DWORD cpage, SFSTATS * psfs);
+
+    SpiFlash(const SpiFlash &);
+    SpiFlash & operator=(const SpiFlash &);
+
+public:
+    SpiFlash();
+
+    void    Init(HIF hifReq);
+    void    Init(SpiDev * pdevReq);
+
+    BOOL    FDetect(SFINFO * psfi);
+    BOOL    FRead(DWORD ib, BYTE * pb, DWORD cb);
+    BOOL    FErase(DWORD ib, DWORD cb);
+    BOOL    FProgram(DWORD ib, const BYTE * pb, DWORD cb, SFSTATS * psfs);
+    BOOL    FVerify(DWORD ib, const BYTE * pb, DWORD cb, DWORD * pcpageBad);
+
+    DWORD   CbFlash() const { return cbFlash; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+/* Results of comparing a page of flash with the data wanted in it.
+*/
+const int   pgcmpMatch      = 0;    // already holds the data
+const int   pgcmpProgram    = 1;    // can be programmed without an erase
+const int   pgcmpErase      = 2;    // has to be erased first
+
+int     PgcmpCompare(const BYTE * pbCur, const BYTE * pbNew, DWORD cb);
+BOOL    FSfBlank(const BYTE * pb, DWORD cb);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIFLASH_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,415 @@
+/************************************************************************/
+/*                                                                      */
+/*  SpiFlashSim.cpp  --  Serial NOR flash model                         */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a model of a serial NOR flash that can be    */
+/*  driven by SpiBatch in place of a real device. The command is taken  */
+/*  from the first byte of each transaction. Reads return data as soon  */
+/*  as the address (and dummy byte) has been shifted in. Programs and   */
+/*  erases take effect when the slave is deselected, as on the real     */
+/*  part, and then keep the part busy for a fixed time on the model's   */
+/*  clock.                                                              */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "SpiFlash.h"
+#include "SpiFlashSim.h"
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::SpiFlashSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a model with no memory. FInit must be called before
+**      the model is used.
+*/
+SpiFlashSim::SpiFlashSim() {
+
+    rgbMem = NULL;
+    cbMem = 0;
+    memset(rgbId, 0, sizeof(rgbId));
+    fSel = fFalse;
+    fIgnore = fFalse;
+    bCmd = 0;
+    ibyte = 0;
+    ibAddr = 0;
+    cbPage = 0;
+    fWel = fFalse;
+    tnsBusyEnd = 0;
+    memset(&sfss, 0, sizeof(sfss));
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::~SpiFlashSim
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory array.
+*/
+SpiFlashSim::~SpiFlashSim() {
+
+    free(rgbMem);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::FInit
+**
+**  Parameters:
+**      idMfg       - manufacturer ID
+**      idType      - memory type
+**      idCap       - capacity code, the log2 of the size in bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails for capacities that can't be addressed with three address
+**      bytes or if memory can't be allocated.
+**
+**  Description:
+**      Allocate an erased memory array of the size given by the
+**      capacity code.
+*/
+BOOL
+SpiFlashSim::FInit( BYTE idMfg, BYTE idType, BYTE idCap ) {
+
+    if (( idCap < 0x10 ) || ( 0x18 < idCap )) {
+        return fFalse;
+    }
+
+    free(rgbMem);
+
+    cbMem = 1UL << idCap;
+    rgbMem = (BYTE *)malloc(cbMem);
+    if ( NULL == rgbMem ) {
+
+        cbMem = 0;
+        return fFalse;
+    }
+
+    memset(rgbMem, 0xFF, cbMem);
+
+    rgbId[0] = idMfg;
+    rgbId[1] = idType;
+    rgbId[2] = idCap;
+
+    fWel = fFalse;
+    tnsBusyEnd = 0;
+    memset(&sfss, 0, sizeof(sfss));
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::SetSelect
+**
+**  Parameters:
+**      fSelNew     - new state of the select line
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Start a transaction on select, and carry out a program or erase
+**      command on deselect.
+*/
+void
+SpiFlashSim::SetSelect( BOOL fSelNew ) {
+
+    if ( fSelNew == fSel ) {
+        return;
+    }
+
+    fSel = fSelNew;
+
+    if ( fSel ) {
+
+        fIgnore = fFalse;
+        bCmd = 0;
+        ibyte = 0;
+        ibAddr = 0;
+        cbPage = 0;
+    }
+    else if (( ! fIgnore ) && ( 0 != ibyte )) {
+
+        Commit();
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::BShift
+**
+**  Parameters:
+**      bMosi       - byte shifted in
+**
+**  Return Values:
+**      byte shifted out
+**
+**  Errors:
+**
+**  Description:
+**      Handle one byte of a transaction. The byte shifted out is the
+**      one the part drives while bMosi is being shifted in.
+*/
+BYTE
+SpiFlashSim::BShift( BYTE bMosi ) {
+
+    BYTE    bMiso;
+
+    if ( ! fSel ) {
+        return 0xFF;
+    }
+
+    bMiso = 0xFF;
+
+    if ( 0 == ibyte ) {
+
+        /* Only read status is accepted while the part is busy.
+        */
+        bCmd = bMosi;
+        if (( FBusy() ) && ( cmdsfReadStatus != bCmd )) {
+
+            fIgnore = fTrue;
+            sfss.cignored++;
+        }
+    }
+    else if ( fIgnore ) {
+
+        /* The part doesn't drive MISO.
+        */
+    }
+    else if ( ibyte <= 3 ) {
+
+        /* Address bytes and the bytes of the fixed length responses.
+        */
+        ibAddr = (ibAddr << 8) | bMosi;
+
+        if ( cmdsfReadId == bCmd ) {
+            bMiso = rgbId[ibyte - 1];
+        }
+        else if ( cmdsfReadStatus == bCmd ) {
+            bMiso = BStatus();
+        }
+    }
+    else {
+
+        switch ( bCmd ) {
+
+            case cmdsfRead:
+                bMiso = rgbMem[ibAddr++ & (cbMem - 1)];
+                break;
+
+            case cmdsfFastRead:
+                /* The first byte after the address is a dummy byte.
+                */
+                if ( 4 < ibyte ) {
+                    bMiso = rgbMem[ibAddr++ & (cbMem - 1)];
+                }
+                break;
+
+            case cmdsfReadStatus:
+                bMiso = BStatus();
+                break;
+
+            case cmdsfPageProgram:
+                /* Data wraps around within the page. Only the last 256
+                ** bytes sent are kept.
+                */
+                rgbPage[(ibAddr + ibyte - 4) & (cbsfPage - 1)] = bMosi;
+                if ( cbPage < cbsfPage ) {
+                    cbPage++;
+                }
+                break;
+        }
+    }
+
+    ibyte++;
+
+    return bMiso;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::BStatus
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      status register
+**
+**  Errors:
+**
+**  Description:
+**      Return the status register as of the model's current time.
+*/
+BYTE
+SpiFlashSim::BStatus() const {
+
+    return (FBusy() ? bsfWip : 0) | (fWel ? bsfWel : 0);
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::Commit
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**      Programs and erases without the write enable latch set, or with
+**      an incomplete address, are counted and ignored.
+**
+**  Description:
+**      Carry out the command of the transaction that just ended.
+*/
+void
+SpiFlashSim::Commit() {
+
+    DWORD   ib;
+    DWORD   ibPage;
+
+    switch ( bCmd ) {
+
+        case cmdsfWriteEnable:
+            fWel = fTrue;
+            return;
+
+        case cmdsfWriteDisable:
+            fWel = fFalse;
+            return;
+
+        case cmdsfPageProgram:
+        case cmdsfSectorErase:
+        case cmdsfBlockErase32:
+        case cmdsfBlockErase:
+        case cmdsfChipErase:
+        case cmdsfChipErase2:
+            break;
+
+        default:
+            return;
+    }
+
+    if ( ! fWel ) {
+
+        sfss.crejected++;
+        return;
+    }
+
+    ibAddr &= cbMem - 1;
+
+    switch ( bCmd ) {
+
+        case cmdsfPageProgram:
+            if ( ibyte < 4 ) {
+                return;
+            }
+
+            /* Programming can only clear bits.
+            */
+            ibPage = ibAddr & ~(cbsfPage - 1);
+            for ( ib = 0; ib < cbsfPage; ib++ ) {
+
+                if (( cbsfPage == cbPage ) ||
+                    (((ib - (ibAddr & (cbsfPage - 1))) & (cbsfPage - 1)) < cbPage )) {
+
+                    rgbMem[ibPage + ib] &= rgbPage[ib];
+                }
+            }
+
+            sfss.cprogram++;
+            tnsBusyEnd = TnsNow() + (UINT64)tusSfsPageProgram * 1000;
+            break;
+
+        case cmdsfSectorErase:
+            if ( 4 == ibyte ) {
+                Erase(ibAddr & ~(cbsfSector - 1), cbsfSector, tusSfsSectorErase);
+            }
+            break;
+
+        case cmdsfBlockErase32:
+            if ( 4 == ibyte ) {
+                Erase(ibAddr & ~(cbsfBlock32 - 1), cbsfBlock32, tusSfsBlockErase);
+            }
+            break;
+
+        case cmdsfBlockErase:
+            if ( 4 == ibyte ) {
+                Erase(ibAddr & ~(cbsfBlock - 1), cbsfBlock, tusSfsBlockErase);
+            }
+            break;
+
+        default:
+            if ( 1 == ibyte ) {
+                Erase(0, cbMem, tusSfsChipErase);
+            }
+            break;
+    }
+
+    fWel = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SpiFlashSim::Erase
+**
+**  Parameters:
+**      ib          - start of the region
+**      cb          - size of the region
+**      tus         - time the erase takes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Erase a region and mark the part busy.
+*/
+void
+SpiFlashSim::Erase( DWORD ib, DWORD cb, DWORD tus ) {
+
+    memset(&rgbMem[ib], 0xFF, cb);
+
+    sfss.cerase++;
+    tnsBusyEnd = TnsNow() + (UINT64)tus * 1000;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,108 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpiFlashSim.h  --    Interface Declarations for SpiFlashSim.cpp   */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a model  */
+/*    of a serial NOR flash with the common JEDEC command set: read ID, */
+/*    read, fast read, write enable/disable, read status, page program, */
+/*    4 KB sector erase, 32 KB and 64 KB block erase and chip erase.    */
+/*                                                                      */
+/*    The model behaves like the real part in the ways that matter to   */
+/*    host software: programs and erases need the write enable latch,   */
+/*    take time during which the busy bit is set and every command      */
+/*    except read status is ignored, programming can only clear bits,   */
+/*    and a page program wraps around within its 256 byte page.         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPIFLASHSIM_INCLUDED)
+#define      SPIFLASHSIM_INCLUDED
+
+#include "SpiDev.h"
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Default JEDEC ID and busy times, those of a typical 128 Mbit part.
+*/
+const BYTE  idSfsMfgDefault         = 0xEF;
+const BYTE  idSfsTypeDefault        = 0x40;
+const BYTE  idSfsCapDefault         = 0x18;
+
+const DWORD tusSfsPageProgram       = 700;
+const DWORD tusSfsSectorErase       = 45000;
+const DWORD tusSfsBlockErase        = 150000;
+const DWORD tusSfsChipErase         = 40000000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Counts of the operations performed by the model.
+*/
+typedef struct {
+    DWORD   cprogram;       // page programs
+    DWORD   cerase;         // sector, block and chip erases
+    DWORD   cignored;       // commands ignored because the part was busy
+    DWORD   crejected;      // programs and erases without write enable
+} SFSSTATS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SpiFlashSim : public SpiDev {
+
+private:
+    BYTE *      rgbMem;
+    DWORD       cbMem;
+    BYTE        rgbId[3];
+
+    /* State of the transaction in progress.
+    */
+    BOOL        fSel;
+    BOOL        fIgnore;
+    BYTE        bCmd;
+    DWORD       ibyte;
+    DWORD       ibAddr;
+    BYTE        rgbPage[256];
+    DWORD       cbPage;
+
+    BOOL        fWel;
+    UINT64      tnsBusyEnd;
+    SFSSTATS    sfss;
+
+    BOOL    FBusy() const { return TnsNow() < tnsBusyEnd; }
+    BYTE    BStatus() const;
+    void    Commit();
+    void    Erase(DWORD ib, DWORD cb, DWORD tus);
+
+protected:
+    virtual void    SetSelect(BOOL fSelNew);
+    virtual BYTE    BShift(BYTE bMosi);
+
+public:
+    SpiFlashSim();
+    virtual ~SpiFlashSim();
+
+    BOOL    FInit(BYTE idMfg, BYTE idType, BYTE idCap);
+
+    BYTE *  PbMem() { return rgbMem; }
+    DWORD   CbMem() const { return cbMem; }
+    void    GetStats(SFSSTATS * psfss) const { *psfss = sfss; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPIFLASHSIM_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,165 @@
+/************************************************************************/
+/*                                                                      */
+/*    SpscQueue.h  --    Single producer, single consumer queue         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains a bounded lock-free queue for passing   */
+/*    items from exactly one producer thread to exactly one consumer    */
+/*    thread. It is used to hand filled transfer buffers from the       */
+/*    thread that talks to the device to the thread that stores or      */
+/*    processes the data, so that neither thread ever blocks the other. */
+/*                                                                      */
+/*    The producer only writes the tail index and the consumer only     */
+/*    writes the head index. Each side keeps a cached copy of the other */
+/*    side's index so that the shared cache line is only read when the  */
+/*    queue looks full or empty.                                        */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SPSCQUEUE_INCLUDED)
+#define      SPSCQUEUE_INCLUDED
+
+#include <stddef.h>
+
+#include <atomic>
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Size of a cache line. The producer and consumer indices are kept on
+** separate lines so that the two threads don't invalidate each other's
+** caches on every operation.
+*/
+const DWORD cbCacheLine = 64;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+template <class T>
+class SpscQueue {
+
+private:
+    T *                     rgitm;
+    DWORD                   citmMask;
+
+    /* Consumer side.
+    */
+    alignas(cbCacheLine) std::atomic<DWORD> iitmHead;
+    DWORD                   iitmTailCache;
+
+    /* Producer side.
+    */
+    alignas(cbCacheLine) std::atomic<DWORD> iitmTail;
+    DWORD                   iitmHeadCache;
+
+    SpscQueue(const SpscQueue &);
+    SpscQueue & operator=(const SpscQueue &);
+
+public:
+    SpscQueue() : rgitm(NULL), citmMask(0), iitmHead(0), iitmTailCache(0),
+                  iitmTail(0), iitmHeadCache(0) { }
+    ~SpscQueue() { Term(); }
+
+    /* Allocate room for at least citmReq items. The capacity is rounded
+    ** up to a power of two.
+    */
+    BOOL FInit(DWORD citmReq) {
+
+        DWORD   citm;
+
+        Term();
+
+        if (( 0 == citmReq ) || ( 0x80000000 < citmReq )) {
+            return fFalse;
+        }
+
+        for ( citm = 1; citm < citmReq; citm <<= 1 ) {
+        }
+
+        rgitm = new T[citm];
+        citmMask = citm - 1;
+        iitmHead.store(0);
+        iitmTail.store(0);
+        iitmTailCache = 0;
+        iitmHeadCache = 0;
+
+        return fTrue;
+    }
+
+    void Term() {
+
+        delete [] rgitm;
+        rgitm = NULL;
+        citmMask = 0;
+    }
+
+    DWORD CitmCapacity() const { return ( NULL != rgitm ) ? citmMask + 1 : 0; }
+
+    /* Producer: add an item. Returns fFalse if the queue is full.
+    */
+    BOOL FPush(const T & itm) {
+
+        DWORD   iitm;
+
+        iitm = iitmTail.load(std::memory_order_relaxed);
+
+        if ( iitm - iitmHeadCache > citmMask ) {
+
+            iitmHeadCache = iitmHead.load(std::memory_order_acquire);
+            if ( iitm - iitmHeadCache > citmMask ) {
+                return fFalse;
+            }
+        }
+
+        rgitm[iitm & citmMask] = itm;
+        iitmTail.store(iitm + 1, std::memory_order_release);
+
+        return fTrue;
+    }
+
+    /* Consumer: remove an item. Returns fFalse if the queue is empty.
+    */
+    BOOL FPop(T * pitm) {
+
+        DWORD   iitm;
+
+        iitm = iitmHead.load(std::memory_order_relaxed);
+
+        if ( iitm == iitmTailCache ) {
+
+            iitmTailCache = iitmTail.load(std::memory_order_acquire);
+            if ( iitm == iitmTailCache ) {
+                return fFalse;
+            }
+        }
+
+        *pitm = rgitm[iitm & citmMask];
+        iitmHead.store(iitm + 1, std::memory_order_release);
+
+        return fTrue;
+    }
+
+    /* Number of items in the queue. The value may already be out of date
+    ** when it is returned if the other thread is active.
+    */
+    DWORD CitmCur() const {
+
+        return iitmTail.load(std::memory_order_acquire) -
+               iitmHead.load(std::memory_order_acquire);
+    }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SPSCQUEUE_INCLUDED
+
+/************************************************************************/
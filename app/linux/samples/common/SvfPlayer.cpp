@@ -0,0 +1,1942 @@
+/************************************************************************/
+/*                                                                      */
+/*  SvfPlayer.cpp  --  SVF and XSVF player for DJTG ports               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a player that executes SVF and XSVF files    */
+/*  on a DJTG port.                                                     */
+/*                                                                      */
+/*  The TAP controller state is tracked by a JtgTap model. Moves are    */
+/*  collected until another call has to be made, and are then sent      */
+/*  with one DjtgPutTmsTdiBits call, together with any short scans      */
+/*  made between them. Long scans are shifted from the host buffers     */
+/*  without splitting them into bytes or words, and waits are made by   */
+/*  clocking TCK in the run state. None of these calls has to wait for  */
+/*  the device while transaction buffering is enabled.                  */
+/*                                                                      */
+/*  Only the scans that compare TDO need their results. These are       */
+/*  issued as overlapped calls with copies of their bits, and are       */
+/*  compared together when the buffer is next synchronized. The DJTG    */
+/*  library executes buffered and overlapped calls in the order they    */
+/*  are made, so the results are those of the scans as written.         */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: TDO is checked with FJbMaskedEqual                      */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBits.h"
+#include "JtgTap.h"
+#include "SvfPlayer.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Largest number of tokens in an SVF statement.
+*/
+const int       ctokSvfMax  = 32;
+
+/* SVF names of the TAP states.
+*/
+const char *    rgszSvfState[ctpsMax] = {
+    "RESET",    "IDLE",     "DRSELECT", "DRCAPTURE",
+    "DRSHIFT",  "DREXIT1",  "DRPAUSE",  "DREXIT2",
+    "DRUPDATE", "IRSELECT", "IRCAPTURE", "IRSHIFT",
+    "IREXIT1",  "IRPAUSE",  "IREXIT2",  "IRUPDATE"
+};
+
+/* XSVF commands.
+*/
+const BYTE      xcmdComplete    = 0x00;
+const BYTE      xcmdTdoMask     = 0x01;
+const BYTE      xcmdSir         = 0x02;
+const BYTE      xcmdSdr         = 0x03;
+const BYTE      xcmdRunTest     = 0x04;
+const BYTE      xcmdRepeat      = 0x07;
+const BYTE      xcmdSdrSize     = 0x08;
+const BYTE      xcmdSdrTdo      = 0x09;
+const BYTE      xcmdSetSdrMasks = 0x0A;
+const BYTE      xcmdSdrInc      = 0x0B;
+const BYTE      xcmdSdrB        = 0x0C;
+const BYTE      xcmdSdrC        = 0x0D;
+const BYTE      xcmdSdrE        = 0x0E;
+const BYTE      xcmdSdrTdoB     = 0x0F;
+const BYTE      xcmdSdrTdoC     = 0x10;
+const BYTE      xcmdSdrTdoE     = 0x11;
+const BYTE      xcmdState       = 0x12;
+const BYTE      xcmdEndIr       = 0x13;
+const BYTE      xcmdEndDr       = 0x14;
+const BYTE      xcmdSir2        = 0x15;
+const BYTE      xcmdComment     = 0x16;
+const BYTE      xcmdWait        = 0x17;
+
+/* Number of times an XSVF scan is retried when XREPEAT isn't given.
+*/
+const DWORD     crepeatXsvfDefault = 32;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static BYTE *   PbReadFile(const char * szFile, DWORD * pcb);
+static BOOL     FSvfTps(const char * szTok, BYTE * ptps);
+static BOOL     FHexToBits(const char * szTok, BYTE * rgb, DWORD cbit);
+static void     CopyBits(BYTE * rgbDst, DWORD ibitDst, const BYTE * rgbSrc, DWORD cbit);
+static void     ClearTail(BYTE * rgb, DWORD cbit);
+static BOOL     FXsvfRead(const BYTE * rgbFile, DWORD cbFile, DWORD * pib, BYTE * rgbDst, DWORD cbit);
+static BOOL     FXsvfValue(const BYTE * rgbFile, DWORD cbFile, DWORD * pib, DWORD cb, DWORD * pdw);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::SvfPlayer
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a player that isn't attached to a port.
+*/
+SvfPlayer::SvfPlayer() : tap(fTrue) {
+
+    hif = hifInvalid;
+    fBuffered = fFalse;
+    frqTck = 0;
+
+    memset(&vecHdr, 0, sizeof(SVVEC));
+    memset(&vecHir, 0, sizeof(SVVEC));
+    memset(&vecTdr, 0, sizeof(SVVEC));
+    memset(&vecTir, 0, sizeof(SVVEC));
+    memset(&vecSdr, 0, sizeof(SVVEC));
+    memset(&vecSir, 0, sizeof(SVVEC));
+    tpsEndDr = tpsRTI;
+    tpsEndIr = tpsRTI;
+    tpsRun = tpsRTI;
+    tpsRunEnd = tpsRTI;
+    rgbAsm = NULL;
+    cbAsmMax = 0;
+
+    ccmp = 0;
+    cbPending = 0;
+    ccallPending = 0;
+    fLastMatch = fTrue;
+
+    memset(rgstat, 0, sizeof(rgstat));
+    cclkTotal = 0;
+    secSync = 0.0;
+    cerrCompare = 0;
+    iline = 0;
+    szWhere = "line";
+    szError[0] = '\0';
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::~SvfPlayer
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory used by the player. Overlapped calls that
+**      are still in flight are cancelled first, as their buffers are
+**      about to be freed.
+*/
+SvfPlayer::~SvfPlayer() {
+
+    DWORD   icmp;
+
+    if ( 0 != ccallPending ) {
+        DmgrCancelTrans(hif);
+    }
+
+    for ( icmp = 0; icmp < ccmp; icmp++ ) {
+        free(rgcmp[icmp].rgbTdi);
+    }
+
+    FreeVec(&vecHdr);
+    FreeVec(&vecHir);
+    FreeVec(&vecTdr);
+    FreeVec(&vecTir);
+    FreeVec(&vecSdr);
+    FreeVec(&vecSir);
+    free(rgbAsm);
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FInit
+**
+**  Parameters:
+**      hifReq      - open handle with DJTG enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the TAP controller can't be reset.
+**
+**  Description:
+**      Attach the player to a port, enable transaction buffering and
+**      put the TAP controller in Test-Logic-Reset. A port that can't
+**      buffer transactions is still used, one call at a time.
+*/
+BOOL
+SvfPlayer::FInit( HIF hifReq ) {
+
+    hif = hifReq;
+    szError[0] = '\0';
+
+    if ( ! DjtgGetSpeed(hif, &frqTck) ) {
+        frqTck = 0;
+    }
+
+    fBuffered = DjtgEnableTransBuffering(hif, fTrue);
+
+    return FMoveTo(tpsTLR) && FFlushTap();
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FFinish
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a pending compare fails or the buffer can't be sent.
+**
+**  Description:
+**      Send the pending TMS sequence, resolve the pending compares,
+**      wait for the buffered calls to complete and disable transaction
+**      buffering.
+*/
+BOOL
+SvfPlayer::FFinish() {
+
+    BOOL    fOk;
+
+    fOk = FFlushTap() && FSync();
+
+    if ( fBuffered ) {
+
+        if ( ! DjtgSyncBuffer(hif) ) {
+            fOk = FFail("DjtgSyncBuffer failed");
+        }
+
+        DjtgEnableTransBuffering(hif, fFalse);
+        fBuffered = fFalse;
+    }
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FPlaySvf
+**
+**  Parameters:
+**      szFile      - path of the SVF file
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file can't be read, a statement is malformed or
+**      unsupported, a DJTG call fails or TDO doesn't match.
+**
+**  Description:
+**      Execute every statement of an SVF file. Comments are removed and
+**      each statement is copied to a buffer of its own, with spaces
+**      around the parentheses so that FSvfStatement can tokenize it in
+**      place.
+*/
+BOOL
+SvfPlayer::FPlaySvf( const char * szFile ) {
+
+    char *  rgchFile;
+    char *  rgchStmt;
+    DWORD   cbFile;
+    DWORD   cchStmt;
+    DWORD   cchStmtMax;
+    DWORD   ich;
+    DWORD   ilineCur;
+    DWORD   ilineStmt;
+    char    ch;
+    BOOL    fOk;
+
+    szWhere = "line";
+    szError[0] = '\0';
+
+    rgchFile = (char *)PbReadFile(szFile, &cbFile);
+    if ( NULL == rgchFile ) {
+        return FFail("unable to read %s", szFile);
+    }
+
+    rgchStmt = NULL;
+    cchStmt = 0;
+    cchStmtMax = 0;
+    ilineCur = 1;
+    ilineStmt = 1;
+    fOk = fTrue;
+
+    for ( ich = 0; ( ich < cbFile ) && fOk; ich++ ) {
+
+        ch = rgchFile[ich];
+
+        if (( '!' == ch ) || (( '/' == ch ) && ( '/' == rgchFile[ich + 1] ))) {
+            while (( ich + 1 < cbFile ) && ( '\n' != rgchFile[ich + 1] )) {
+                ich++;
+            }
+            continue;
+        }
+
+        if ( '\n' == ch ) {
+            ilineCur++;
+        }
+
+        if ( ';' == ch ) {
+
+            if ( 0 == cchStmt ) {
+                continue;
+            }
+
+            rgchStmt[cchStmt] = '\0';
+            iline = ilineStmt;
+            fOk = FSvfStatement(rgchStmt);
+            cchStmt = 0;
+            continue;
+        }
+
+        if ( isspace((unsigned char)ch) ) {
+
+            if ( 0 == cchStmt ) {
+                continue;
+            }
+            ch = ' ';
+        }
+
+        if ( ! FGrowArray((void **)&rgchStmt, &cchStmtMax, cchStmt + 4, 1) ) {
+            fOk = FFail("out of memory");
+            break;
+        }
+
+        if ( 0 == cchStmt ) {
+            ilineStmt = ilineCur;
+        }
+
+        if ( '(' == ch ) {
+            rgchStmt[cchStmt++] = ' ';
+            rgchStmt[cchStmt++] = '(';
+        }
+        else if ( ')' == ch ) {
+            rgchStmt[cchStmt++] = ')';
+            rgchStmt[cchStmt++] = ' ';
+        }
+        else {
+            rgchStmt[cchStmt++] = ch;
+        }
+    }
+
+    if ( fOk && ( 0 != cchStmt ) ) {
+        iline = ilineStmt;
+        fOk = FFail("statement not terminated by ;");
+    }
+
+    free(rgchStmt);
+    free(rgchFile);
+
+    return fOk && FSync();
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FPlayXsvf
+**
+**  Parameters:
+**      szFile      - path of the XSVF file
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file can't be read, a command is truncated or
+**      unsupported, a DJTG call fails or TDO doesn't match after the
+**      allowed number of retries.
+**
+**  Description:
+**      Execute every command of an XSVF file up to XCOMPLETE.
+**
+**      A scan compared while XREPEAT is zero has its compare deferred
+**      like an SVF scan. Otherwise the result is needed to decide
+**      whether to retry, so the scan is left in Exit1-DR and the
+**      buffer is synchronized right away. A retry goes through
+**      Pause-DR and Exit2-DR back to Shift-DR, which is the path
+**      FMoveTo takes from Exit1-DR.
+*/
+BOOL
+SvfPlayer::FPlayXsvf( const char * szFile ) {
+
+    BYTE *  rgbFile;
+    BYTE *  rgbTdi;
+    BYTE *  rgbExp;
+    BYTE *  rgbMask;
+    BYTE *  rgbVec;
+    DWORD   cbVecMax;
+    DWORD   cbFile;
+    DWORD   ib;
+    DWORD   cbitSdr;
+    DWORD   cbitSir;
+    DWORD   cb;
+    DWORD   tusRun;
+    DWORD   tusWait;
+    DWORD   crepeat;
+    DWORD   irepeat;
+    DWORD   dw;
+    BYTE    xcmd;
+    BYTE    tpsWait;
+    BYTE    tpsEnd;
+    BOOL    fMask;
+    BOOL    fCompare;
+    BOOL    fOk;
+    BOOL    fDone;
+    int     isvc;
+    double  secStart;
+    double  secSyncStart;
+    UINT64  cclkStart;
+
+    szWhere = "offset";
+    szError[0] = '\0';
+
+    rgbFile = PbReadFile(szFile, &cbFile);
+    if ( NULL == rgbFile ) {
+        return FFail("unable to read %s", szFile);
+    }
+
+    /* rgbVec holds the TDI, expected TDO and mask vectors of the
+    ** current XSDRSIZE, one after the other.
+    */
+    rgbVec = NULL;
+    cbVecMax = 0;
+    rgbTdi = NULL;
+    rgbExp = NULL;
+    rgbMask = NULL;
+    cbitSdr = 0;
+    tusRun = 0;
+    crepeat = crepeatXsvfDefault;
+    fMask = fFalse;
+    tpsEndIr = tpsRTI;
+    tpsEndDr = tpsRTI;
+
+    ib = 0;
+    fOk = fTrue;
+    fDone = fFalse;
+
+    while ( fOk && ! fDone ) {
+
+        if ( ib >= cbFile ) {
+            fOk = FFail("XCOMPLETE missing");
+            break;
+        }
+
+        iline = ib;
+        xcmd = rgbFile[ib++];
+        secStart = SecNow();
+        secSyncStart = secSync;
+        cclkStart = cclkTotal;
+        isvc = svcOther;
+        cb = (cbitSdr + 7) / 8;
+
+        switch ( xcmd ) {
+
+            case xcmdComplete:
+                fDone = fTrue;
+                break;
+
+            case xcmdTdoMask:
+                fOk = FXsvfRead(rgbFile, cbFile, &ib, rgbMask, cbitSdr) ||
+                      FFail("XTDOMASK truncated");
+                fMask = fFalse;
+                for ( dw = 0; fOk && ( dw < cb ); dw++ ) {
+                    fMask = fMask || ( 0 != rgbMask[dw] );
+                }
+                break;
+
+            case xcmdSir:
+            case xcmdSir2:
+                isvc = svcSir;
+                if ( ! FXsvfValue(rgbFile, cbFile, &ib, ( xcmdSir == xcmd ) ? 1 : 2, &cbitSir) ) {
+                    fOk = FFail("XSIR truncated");
+                    break;
+                }
+
+                if ( ! FGrowArray((void **)&rgbAsm, &cbAsmMax, (cbitSir + 7) / 8 + 1, 1) ) {
+                    fOk = FFail("out of memory");
+                    break;
+                }
+
+                if ( ! FXsvfRead(rgbFile, cbFile, &ib, rgbAsm, cbitSir) ) {
+                    fOk = FFail("XSIR truncated");
+                    break;
+                }
+
+                tpsEnd = ( 0 != tusRun ) ? tpsRTI : tpsEndIr;
+                fOk = FShift(fTrue, rgbAsm, cbitSir, NULL, NULL, fTrue, tpsEnd, fFalse) &&
+                      (( 0 == tusRun ) || FWaitIn(tpsRTI, 0, tusRun / 1000000.0, tpsRTI));
+                break;
+
+            case xcmdSdr:
+            case xcmdSdrTdo:
+                isvc = svcSdr;
+                fOk = FXsvfRead(rgbFile, cbFile, &ib, rgbTdi, cbitSdr) &&
+                      (( xcmdSdr == xcmd ) || FXsvfRead(rgbFile, cbFile, &ib, rgbExp, cbitSdr));
+                if ( ! fOk ) {
+                    FFail("XSDR truncated");
+                    break;
+                }
+
+                fCompare = fMask;
+                tpsEnd = ( 0 != tusRun ) ? tpsRTI : tpsEndDr;
+
+                if ( ! fCompare || ( 0 == crepeat ) ) {
+                    fOk = FShift(fFalse, rgbTdi, cbitSdr, fCompare ? rgbExp : NULL, rgbMask,
+                                 fTrue, tpsEnd, fFalse);
+                }
+                else {
+
+                    for ( irepeat = 0; ; irepeat++ ) {
+
+                        fLastMatch = fTrue;
+                        fOk = FShift(fFalse, rgbTdi, cbitSdr, rgbExp, rgbMask, fTrue,
+                                     tpsEx1DR, fTrue) && FSync();
+                        if ( ! fOk || fLastMatch ) {
+                            break;
+                        }
+
+                        if ( irepeat >= crepeat ) {
+                            cerrCompare++;
+                            fOk = FFail("TDO mismatch after %u retries", crepeat);
+                            break;
+                        }
+                    }
+
+                    fOk = fOk && FMoveTo(tpsEnd);
+                }
+
+                fOk = fOk && (( 0 == tusRun ) || FWaitIn(tpsRTI, 0, tusRun / 1000000.0, tpsRTI));
+                break;
+
+            case xcmdRunTest:
+                fOk = FXsvfValue(rgbFile, cbFile, &ib, 4, &tusRun) ||
+                      FFail("XRUNTEST truncated");
+                break;
+
+            case xcmdRepeat:
+                fOk = FXsvfValue(rgbFile, cbFile, &ib, 1, &crepeat) ||
+                      FFail("XREPEAT truncated");
+                break;
+
+            case xcmdSdrSize:
+                if ( ! FXsvfValue(rgbFile, cbFile, &ib, 4, &cbitSdr) ) {
+                    fOk = FFail("XSDRSIZE truncated");
+                    break;
+                }
+
+                cb = (cbitSdr + 7) / 8;
+                if (( cb > 0x20000000 ) || ! FGrowArray((void **)&rgbVec, &cbVecMax, 3 * cb + 3, 1) ) {
+                    fOk = FFail("out of memory");
+                    break;
+                }
+
+                rgbTdi = rgbVec;
+                rgbExp = rgbTdi + cb + 1;
+                rgbMask = rgbExp + cb + 1;
+                memset(rgbVec, 0, 3 * cb + 3);
+                fMask = fFalse;
+                break;
+
+            case xcmdSdrB:
+            case xcmdSdrC:
+            case xcmdSdrE:
+            case xcmdSdrTdoB:
+            case xcmdSdrTdoC:
+            case xcmdSdrTdoE:
+                isvc = svcSdr;
+                fCompare = ( xcmdSdrTdoB <= xcmd ) && fMask;
+                fOk = FXsvfRead(rgbFile, cbFile, &ib, rgbTdi, cbitSdr) &&
+                      (( xcmdSdrTdoB > xcmd ) || FXsvfRead(rgbFile, cbFile, &ib, rgbExp, cbitSdr));
+                if ( ! fOk ) {
+                    FFail("XSDR truncated");
+                    break;
+                }
+
+                fOk = FShift(fFalse, rgbTdi, cbitSdr, fCompare ? rgbExp : NULL, rgbMask,
+                             ( xcmdSdrE == xcmd ) || ( xcmdSdrTdoE == xcmd ), tpsEndDr, fFalse);
+                break;
+
+            case xcmdState:
+                isvc = svcState;
+                if (( ib >= cbFile ) || ( rgbFile[ib] >= ctpsMax )) {
+                    fOk = FFail("XSTATE invalid");
+                    break;
+                }
+
+                fOk = FMoveTo(rgbFile[ib++]);
+                break;
+
+            case xcmdEndIr:
+            case xcmdEndDr:
+                if (( ib >= cbFile ) || ( 1 < rgbFile[ib] )) {
+                    fOk = FFail("XENDIR/XENDDR invalid");
+                    break;
+                }
+
+                if ( xcmdEndIr == xcmd ) {
+                    tpsEndIr = ( 0 != rgbFile[ib] ) ? tpsPauIR : tpsRTI;
+                }
+                else {
+                    tpsEndDr = ( 0 != rgbFile[ib] ) ? tpsPauDR : tpsRTI;
+                }
+                ib++;
+                break;
+
+            case xcmdComment:
+                while (( ib < cbFile ) && ( '\0' != rgbFile[ib] )) {
+                    ib++;
+                }
+                ib++;
+                break;
+
+            case xcmdWait:
+                isvc = svcRunTest;
+                if (( ib + 2 > cbFile ) ||
+                    ( rgbFile[ib] >= ctpsMax ) || ( rgbFile[ib + 1] >= ctpsMax )) {
+                    fOk = FFail("XWAIT invalid");
+                    break;
+                }
+
+                tpsWait = rgbFile[ib++];
+                tpsEnd = rgbFile[ib++];
+                if ( ! FXsvfValue(rgbFile, cbFile, &ib, 4, &tusWait) ) {
+                    fOk = FFail("XWAIT truncated");
+                    break;
+                }
+
+                fOk = FWaitIn(tpsWait, 0, tusWait / 1000000.0, tpsEnd);
+                break;
+
+            case xcmdSetSdrMasks:
+            case xcmdSdrInc:
+                fOk = FFail("XSETSDRMASKS and XSDRINC aren't supported");
+                break;
+
+            default:
+                fOk = FFail("unknown command 0x%02X", xcmd);
+                break;
+        }
+
+        Account(isvc, secStart, cclkStart, secSyncStart);
+    }
+
+    free(rgbVec);
+    free(rgbFile);
+
+    return fOk && FSync();
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FSvfStatement
+**
+**  Parameters:
+**      szStmt      - statement without its ';', with spaces around
+**                    every parenthesis
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the statement is malformed or unsupported, or if it
+**      can't be executed.
+**
+**  Description:
+**      Split a statement into tokens and execute it. The tokens are
+**      upper cased in place. A parenthesized value becomes one token
+**      that starts with '(' and has its white space removed.
+*/
+BOOL
+SvfPlayer::FSvfStatement( char * szStmt ) {
+
+    char *  rgszTok[ctokSvfMax];
+    char *  pch;
+    char *  pchDst;
+    int     ctok;
+    int     itok;
+    int     isvc;
+    BYTE    tpsTok;
+    DWORD   frqSet;
+    double  frq;
+    double  secStart;
+    double  secSyncStart;
+    UINT64  cclkStart;
+    BOOL    fOk;
+
+    ctok = 0;
+    pch = szStmt;
+
+    while ( '\0' != *pch ) {
+
+        if ( ' ' == *pch ) {
+            pch++;
+            continue;
+        }
+
+        if ( ctok >= ctokSvfMax ) {
+            return FFail("too many tokens");
+        }
+
+        rgszTok[ctok++] = pch;
+
+        if ( '(' == *pch ) {
+
+            pchDst = ++pch;
+            while (( '\0' != *pch ) && ( ')' != *pch )) {
+                if ( ! isspace((unsigned char)*pch) ) {
+                    *pchDst++ = toupper((unsigned char)*pch);
+                }
+                pch++;
+            }
+
+            if ( '\0' == *pch ) {
+                return FFail("missing )");
+            }
+            *pchDst = '\0';
+            pch++;
+        }
+        else {
+
+            while (( '\0' != *pch ) && ( ' ' != *pch )) {
+                *pch = toupper((unsigned char)*pch);
+                pch++;
+            }
+
+            if ( '\0' != *pch ) {
+                *pch++ = '\0';
+            }
+        }
+    }
+
+    if ( 0 == ctok ) {
+        return fTrue;
+    }
+
+    secStart = SecNow();
+    secSyncStart = secSync;
+    cclkStart = cclkTotal;
+    isvc = svcOther;
+    fOk = fTrue;
+
+    if (( 0 == strcmp(rgszTok[0], "ENDDR") ) || ( 0 == strcmp(rgszTok[0], "ENDIR") )) {
+
+        if (( 2 != ctok ) || ! FSvfTps(rgszTok[1], &tpsTok) || ! FTapStable(tpsTok) ) {
+            return FFail("%s needs a stable state", rgszTok[0]);
+        }
+
+        if ( 'D' == rgszTok[0][3] ) {
+            tpsEndDr = tpsTok;
+        }
+        else {
+            tpsEndIr = tpsTok;
+        }
+    }
+    else if ( 0 == strcmp(rgszTok[0], "STATE") ) {
+
+        isvc = svcState;
+        for ( itok = 1; fOk && ( itok < ctok ); itok++ ) {
+
+            if ( ! FSvfTps(rgszTok[itok], &tpsTok) ) {
+                return FFail("unknown state %s", rgszTok[itok]);
+            }
+            fOk = FMoveTo(tpsTok);
+        }
+    }
+    else if ( 0 == strcmp(rgszTok[0], "FREQUENCY") ) {
+
+        /* The port was set to the fastest TCK the user allows, so the
+        ** file may only lower it.
+        */
+        if ( 1 < ctok ) {
+
+            frq = atof(rgszTok[1]);
+            if (( 0 < frq ) && (( 0 == frqTck ) || ( frq < frqTck ))) {
+
+                if ( ! DjtgSetSpeed(hif, (DWORD)frq, &frqSet) ) {
+                    return FFail("DjtgSetSpeed failed");
+                }
+                frqTck = frqSet;
+            }
+        }
+    }
+    else if ( 0 == strcmp(rgszTok[0], "HDR") ) {
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecHdr);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "HIR") ) {
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecHir);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "TDR") ) {
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecTdr);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "TIR") ) {
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecTir);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "SDR") ) {
+        isvc = svcSdr;
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecSdr) && FSvfScan(fFalse);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "SIR") ) {
+        isvc = svcSir;
+        fOk = FSvfVector(&rgszTok[1], ctok - 1, &vecSir) && FSvfScan(fTrue);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "RUNTEST") ) {
+        isvc = svcRunTest;
+        fOk = FSvfRunTest(&rgszTok[1], ctok - 1);
+    }
+    else if ( 0 == strcmp(rgszTok[0], "TRST") ) {
+
+        /* The port has no TRST pin. Asserting it is emulated by a TMS
+        ** reset, and the other values have nothing to drive.
+        */
+        isvc = svcState;
+        if (( 2 == ctok ) && ( 0 == strcmp(rgszTok[1], "ON") )) {
+            fOk = FMoveTo(tpsTLR);
+        }
+    }
+    else if (( 0 == strcmp(rgszTok[0], "PIO") ) || ( 0 == strcmp(rgszTok[0], "PIOMAP") )) {
+        return FFail("%s isn't supported", rgszTok[0]);
+    }
+    else {
+        return FFail("unknown statement %s", rgszTok[0]);
+    }
+
+    Account(isvc, secStart, cclkStart, secSyncStart);
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FSvfVector
+**
+**  Parameters:
+**      rgszTok     - tokens after the command name
+**      ctok        - number of tokens
+**      pvec        - vector to update
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the length is missing, a value is malformed, or TDI
+**      isn't given for a new length.
+**
+**  Description:
+**      Parse the length and the TDI, TDO, MASK and SMASK values of a
+**      scan command. When the length changes the old values are
+**      discarded and MASK becomes all ones. TDO only applies to the
+**      command that gives it. SMASK has no effect on a DJTG port, as
+**      every TDI bit is driven, so it is only checked.
+**
+**      The three values share one allocation, with room for the
+**      SMASK value after them.
+*/
+BOOL
+SvfPlayer::FSvfVector( char ** rgszTok, int ctok, SVVEC * pvec ) {
+
+    DWORD   cbit;
+    DWORD   cb;
+    char *  pchEnd;
+    BYTE *  rgb;
+    BOOL    fTdi;
+    int     itok;
+
+    if (( 0 == ctok ) || ! isdigit((unsigned char)rgszTok[0][0]) ) {
+        return FFail("length missing");
+    }
+
+    cbit = strtoul(rgszTok[0], &pchEnd, 10);
+    if ( '\0' != *pchEnd ) {
+        return FFail("invalid length %s", rgszTok[0]);
+    }
+
+    cb = (cbit + 7) / 8;
+    fTdi = fFalse;
+
+    if (( cbit != pvec->cbit ) || ( NULL == pvec->rgbTdi )) {
+
+        FreeVec(pvec);
+
+        if (( cb > 0x20000000 ) || ( NULL == (rgb = (BYTE *)calloc(4 * cb + 4, 1)) )) {
+            return FFail("out of memory");
+        }
+
+        pvec->cbit = cbit;
+        pvec->rgbTdi = rgb;
+        pvec->rgbTdo = rgb + cb + 1;
+        pvec->rgbMask = pvec->rgbTdo + cb + 1;
+        memset(pvec->rgbMask, 0xFF, cb);
+        ClearTail(pvec->rgbMask, cbit);
+        fTdi = ( 0 == cbit );
+    }
+    else {
+        fTdi = fTrue;
+    }
+
+    pvec->fTdo = fFalse;
+
+    for ( itok = 1; itok < ctok; itok += 2 ) {
+
+        if (( itok + 1 >= ctok ) || ( '(' != rgszTok[itok + 1][0] )) {
+            return FFail("value missing after %s", rgszTok[itok]);
+        }
+
+        if ( 0 == strcmp(rgszTok[itok], "TDI") ) {
+            rgb = pvec->rgbTdi;
+            fTdi = fTrue;
+        }
+        else if ( 0 == strcmp(rgszTok[itok], "TDO") ) {
+            rgb = pvec->rgbTdo;
+            pvec->fTdo = fTrue;
+        }
+        else if ( 0 == strcmp(rgszTok[itok], "MASK") ) {
+            rgb = pvec->rgbMask;
+        }
+        else if ( 0 == strcmp(rgszTok[itok], "SMASK") ) {
+            rgb = pvec->rgbMask + cb + 1;
+        }
+        else {
+            return FFail("unknown keyword %s", rgszTok[itok]);
+        }
+
+        if ( ! FHexToBits(rgszTok[itok + 1], rgb, cbit) ) {
+            return FFail("invalid %s value", rgszTok[itok]);
+        }
+    }
+
+    if ( ! fTdi ) {
+        return FFail("TDI missing for a new length");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FSvfScan
+**
+**  Parameters:
+**      fIr         - fTrue for SIR, fFalse for SDR
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated or the scan fails.
+**
+**  Description:
+**      Shift the header, data and trailer of a scan, in that order from
+**      bit 0. When there is no header or trailer, which is the common
+**      case, the data vector is shifted as it is. TDO is compared for
+**      the parts that gave it, and ignored for the others.
+*/
+BOOL
+SvfPlayer::FSvfScan( BOOL fIr ) {
+
+    SVVEC * rgpvec[3];
+    SVVEC * pvec;
+    BYTE *  rgbTdi;
+    BYTE *  rgbExp;
+    BYTE *  rgbMask;
+    DWORD   cbit;
+    DWORD   cb;
+    DWORD   ibit;
+    int     ivec;
+    BOOL    fCompare;
+
+    rgpvec[0] = fIr ? &vecHir : &vecHdr;
+    rgpvec[1] = fIr ? &vecSir : &vecSdr;
+    rgpvec[2] = fIr ? &vecTir : &vecTdr;
+
+    cbit = rgpvec[0]->cbit + rgpvec[1]->cbit + rgpvec[2]->cbit;
+    fCompare = rgpvec[0]->fTdo || rgpvec[1]->fTdo || rgpvec[2]->fTdo;
+
+    if ( 0 == cbit ) {
+        return fTrue;
+    }
+
+    if ( cbit == rgpvec[1]->cbit ) {
+
+        pvec = rgpvec[1];
+        return FShift(fIr, pvec->rgbTdi, cbit, fCompare ? pvec->rgbTdo : NULL,
+                      pvec->rgbMask, fTrue, fIr ? tpsEndIr : tpsEndDr, fFalse);
+    }
+
+    cb = (cbit + 7) / 8;
+    if ( ! FGrowArray((void **)&rgbAsm, &cbAsmMax, 3 * cb, 1) ) {
+        return FFail("out of memory");
+    }
+
+    rgbTdi = rgbAsm;
+    rgbExp = rgbTdi + cb;
+    rgbMask = rgbExp + cb;
+    memset(rgbAsm, 0, 3 * cb);
+
+    ibit = 0;
+    for ( ivec = 0; ivec < 3; ivec++ ) {
+
+        pvec = rgpvec[ivec];
+        if ( 0 == pvec->cbit ) {
+            continue;
+        }
+
+        CopyBits(rgbTdi, ibit, pvec->rgbTdi, pvec->cbit);
+        if ( pvec->fTdo ) {
+            CopyBits(rgbExp, ibit, pvec->rgbTdo, pvec->cbit);
+            CopyBits(rgbMask, ibit, pvec->rgbMask, pvec->cbit);
+        }
+        ibit += pvec->cbit;
+    }
+
+    return FShift(fIr, rgbTdi, cbit, fCompare ? rgbExp : NULL, rgbMask, fTrue,
+                  fIr ? tpsEndIr : tpsEndDr, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FSvfRunTest
+**
+**  Parameters:
+**      rgszTok     - tokens after RUNTEST
+**      ctok        - number of tokens
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the statement is malformed or the wait fails.
+**
+**  Description:
+**      Execute RUNTEST [run_state] [run_count run_clk] [min_time SEC
+**      [MAXIMUM max_time SEC]] [ENDSTATE end_state]. A run state also
+**      becomes the end state unless ENDSTATE is given, and both are
+**      kept for later RUNTEST statements. The maximum time is met by
+**      any wait that produces the minimum, so it is ignored. SCK is
+**      taken to be TCK.
+*/
+BOOL
+SvfPlayer::FSvfRunTest( char ** rgszTok, int ctok ) {
+
+    BYTE    tpsTok;
+    double  cclk;
+    double  secMin;
+    double  val;
+    char *  pchEnd;
+    int     itok;
+
+    itok = 0;
+    cclk = 0;
+    secMin = 0;
+
+    if (( itok < ctok ) && FSvfTps(rgszTok[itok], &tpsTok) ) {
+
+        if ( ! FTapStable(tpsTok) ) {
+            return FFail("RUNTEST needs a stable state");
+        }
+        tpsRun = tpsTok;
+        tpsRunEnd = tpsTok;
+        itok++;
+    }
+
+    while ( itok < ctok ) {
+
+        if ( 0 == strcmp(rgszTok[itok], "MAXIMUM") ) {
+            itok += 3;
+            continue;
+        }
+
+        if ( 0 == strcmp(rgszTok[itok], "ENDSTATE") ) {
+
+            if (( itok + 1 >= ctok ) || ! FSvfTps(rgszTok[itok + 1], &tpsTok) ||
+                ! FTapStable(tpsTok) ) {
+                return FFail("ENDSTATE needs a stable state");
+            }
+            tpsRunEnd = tpsTok;
+            itok += 2;
+            continue;
+        }
+
+        val = strtod(rgszTok[itok], &pchEnd);
+        if (( '\0' != *pchEnd ) || ( itok + 1 >= ctok ) || ( 0 > val )) {
+            return FFail("invalid RUNTEST value %s", rgszTok[itok]);
+        }
+
+        if (( 0 == strcmp(rgszTok[itok + 1], "TCK") ) || ( 0 == strcmp(rgszTok[itok + 1], "SCK") )) {
+            cclk = val;
+        }
+        else if ( 0 == strcmp(rgszTok[itok + 1], "SEC") ) {
+            secMin = val;
+        }
+        else {
+            return FFail("unknown RUNTEST unit %s", rgszTok[itok + 1]);
+        }
+        itok += 2;
+    }
+
+    if ( 4294967295.0 < cclk ) {
+        return FFail("RUNTEST count too large");
+    }
+
+    return FWaitIn(tpsRun, (DWORD)cclk, secMin, tpsRunEnd);
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FMoveTo
+**
+**  Parameters:
+**      tpsTo       - state to move the TAP controller to
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the TMS bits can't be sent.
+**
+**  Description:
+**      Move the TAP controller along the shortest path to a state.
+**      Test-Logic-Reset is always entered with five TMS high clocks, so
+**      that it also resets a controller whose state isn't known. The
+**      move is only added to the pending TMS sequence.
+*/
+BOOL
+SvfPlayer::FMoveTo( BYTE tpsTo ) {
+
+    DWORD   cbitStart;
+
+    cbitStart = tap.CbitSeq();
+
+    if ( ! (( tpsTLR == tpsTo ) ? tap.FReset() : tap.FMoveTo(tpsTo)) ) {
+        return FFail("out of memory");
+    }
+
+    cclkTotal += tap.CbitSeq() - cbitStart;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FFlushTap
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call fails.
+**
+**  Description:
+**      Send the pending TMS sequence. This is called before any other
+**      DJTG call, so that every move made since the last one, and any
+**      short scans between them, cost a single DjtgPutTmsTdiBits call.
+*/
+BOOL
+SvfPlayer::FFlushTap() {
+
+    if ( ! tap.FFlush(hif, fFalse) ) {
+        return FFail("DjtgPutTmsTdiBits failed");
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FShift
+**
+**  Parameters:
+**      fIr         - fTrue to shift IR, fFalse to shift DR
+**      rgbTdi      - bits to send, LSB first
+**      cbit        - number of bits
+**      rgbExp      - expected TDO bits, or NULL not to compare
+**      rgbMask     - bits of rgbExp that are compared, or NULL for all
+**      fExit       - fTrue to leave the shift state on the last bit
+**      tpsEnd      - state to move to after leaving the shift state
+**      fTentative  - fTrue if a mismatch only clears fLastMatch
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated, a call fails, or a pending
+**      compare fails when the buffer is synchronized to make room.
+**
+**  Description:
+**      Shift a scan. Without a compare the calls are buffered and the
+**      caller's bits may be reused at once; a scan of up to
+**      cbitSvfInline bits is added to the pending TMS sequence instead.
+**      With a compare the bits are copied, the calls are overlapped and
+**      the compare is queued for FSync. A scan without bits does
+**      nothing.
+*/
+BOOL
+SvfPlayer::FShift( BOOL fIr, const BYTE * rgbTdi, DWORD cbit, const BYTE * rgbExp,
+                   const BYTE * rgbMask, BOOL fExit, BYTE tpsEnd, BOOL fTentative ) {
+
+    SVCMP * pcmp;
+    BYTE *  rgbSnd;
+    BYTE *  rgbRcv;
+    BYTE *  pbRcvLast;
+    BYTE    bTdiLast;
+    DWORD   cb;
+    DWORD   cbitBody;
+    DWORD   cbitCall;
+    DWORD   ibit;
+    BOOL    fOverlap;
+
+    if ( 0 == cbit ) {
+        return fTrue;
+    }
+
+    if ( ! FMoveTo(fIr ? tpsShIR : tpsShDR) ) {
+        return fFalse;
+    }
+
+    cb = (cbit + 7) / 8;
+    pcmp = NULL;
+    fOverlap = ( NULL != rgbExp );
+    rgbSnd = (BYTE *)rgbTdi;
+    rgbRcv = NULL;
+    pbRcvLast = NULL;
+
+    if ( fOverlap ) {
+
+        if (( ccmp >= ccmpSvfPendingMax ) || ( cbPending + 4 * cb > cbSvfPendingMax )) {
+            if ( ! FSync() ) {
+                return fFalse;
+            }
+        }
+
+        pcmp = &rgcmp[ccmp];
+        if ( NULL == (pcmp->rgbTdi = (BYTE *)malloc(4 * cb)) ) {
+            return FFail("out of memory");
+        }
+
+        pcmp->cbit = cbit;
+        pcmp->rgbTdo = pcmp->rgbTdi + cb;
+        pcmp->rgbExp = pcmp->rgbTdo + cb;
+        pcmp->rgbMask = pcmp->rgbExp + cb;
+        pcmp->bTdiLast = 0;
+        pcmp->bTdoLast = 0;
+        pcmp->fExit = fExit;
+        pcmp->iline = iline;
+        pcmp->fTentative = fTentative;
+
+        memcpy(pcmp->rgbTdi, rgbTdi, cb);
+        memset(pcmp->rgbTdo, 0, cb);
+        memcpy(pcmp->rgbExp, rgbExp, cb);
+        if ( NULL != rgbMask ) {
+            memcpy(pcmp->rgbMask, rgbMask, cb);
+        }
+        else {
+            memset(pcmp->rgbMask, 0xFF, cb);
+        }
+        ClearTail(pcmp->rgbMask, cbit);
+
+        ccmp++;
+        cbPending += 4 * cb;
+
+        rgbSnd = pcmp->rgbTdi;
+        rgbRcv = pcmp->rgbTdo;
+        pbRcvLast = &pcmp->bTdoLast;
+    }
+    else if ( cbit <= cbitSvfInline ) {
+
+        /* A short scan whose TDO isn't needed is sent with the moves into
+        ** and out of the shift state.
+        */
+        if ( ! tap.FShift(rgbTdi, cbit, fExit) ) {
+            return FFail("out of memory");
+        }
+
+        cclkTotal += cbit;
+        return ( ! fExit ) || FMoveTo(tpsEnd);
+    }
+
+    if ( ! FFlushTap() ) {
+        return fFalse;
+    }
+
+    /* Send every bit but the last in as few calls as possible. Each
+    ** chunk is a multiple of 8 bits, so the next one starts on a byte.
+    */
+    cbitBody = fExit ? cbit - 1 : cbit;
+
+    for ( ibit = 0; ibit < cbitBody; ibit += cbitCall ) {
+
+        cbitCall = ( cbitBody - ibit < cbitSvfChunk ) ? cbitBody - ibit : cbitSvfChunk;
+
+        if ( ! DjtgPutTdiBits(hif, fFalse, &rgbSnd[ibit / 8],
+                              ( NULL != rgbRcv ) ? &rgbRcv[ibit / 8] : NULL, cbitCall, fOverlap) ) {
+            return FFail("DjtgPutTdiBits failed");
+        }
+
+        if ( fOverlap ) {
+            ccallPending++;
+        }
+    }
+
+    if ( fExit ) {
+
+        bTdiLast = (rgbTdi[(cbit - 1) / 8] >> ((cbit - 1) % 8)) & 1;
+
+        if ( NULL == pcmp ) {
+
+            /* The last bit is sent with the moves that follow it.
+            */
+            if ( ! tap.FShift(&bTdiLast, 1, fTrue) ) {
+                return FFail("out of memory");
+            }
+        }
+        else {
+
+            pcmp->bTdiLast = bTdiLast;
+            if ( ! DjtgPutTdiBits(hif, fTrue, &pcmp->bTdiLast, pbRcvLast, 1, fTrue) ) {
+                return FFail("DjtgPutTdiBits failed");
+            }
+
+            ccallPending++;
+            tap.SetTps(fIr ? tpsEx1IR : tpsEx1DR);
+        }
+    }
+
+    cclkTotal += cbit;
+
+    return ( ! fExit ) || FMoveTo(tpsEnd);
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FClock
+**
+**  Parameters:
+**      cclk        - number of TCK cycles
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the call fails.
+**
+**  Description:
+**      Clock TCK in the current state, which must be a stable one. TMS
+**      is held high in Test-Logic-Reset and low elsewhere.
+*/
+BOOL
+SvfPlayer::FClock( DWORD cclk ) {
+
+    if ( 0 == cclk ) {
+        return fTrue;
+    }
+
+    if ( ! FFlushTap() ) {
+        return fFalse;
+    }
+
+    if ( ! DjtgClockTck(hif, tpsTLR == tap.Tps(), fFalse, cclk, fFalse) ) {
+        return FFail("DjtgClockTck failed");
+    }
+
+    cclkTotal += cclk;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FWaitIn
+**
+**  Parameters:
+**      tpsWait     - stable state to wait in
+**      cclk        - minimum number of TCK cycles
+**      secMin      - minimum time in seconds
+**      tpsEnd      - state to move to after the wait
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call fails.
+**
+**  Description:
+**      Wait in a state for at least cclk TCK cycles and secMin seconds.
+**      The time is converted to cycles at the current TCK frequency, so
+**      the wait is queued with the scans instead of stalling the host.
+**      DjtgWait is only used when the frequency isn't known.
+*/
+BOOL
+SvfPlayer::FWaitIn( BYTE tpsWait, DWORD cclk, double secMin, BYTE tpsEnd ) {
+
+    double  cclkWait;
+    DWORD   cclkCall;
+    DWORD   tusWaited;
+
+    if ( ! FMoveTo(tpsWait) ) {
+        return fFalse;
+    }
+
+    cclkWait = cclk;
+
+    if ( 0 < secMin ) {
+
+        if ( 0 != frqTck ) {
+            cclkWait = ceil(secMin * frqTck);
+            if ( cclkWait < cclk ) {
+                cclkWait = cclk;
+            }
+        }
+        else {
+
+            if ( ! FClock(cclk) || ! FFlushTap() ) {
+                return fFalse;
+            }
+            cclkWait = 0;
+
+            if ( ! DjtgWait(hif, (DWORD)ceil(secMin * 1000000.0), &tusWaited) ) {
+
+                if ( fBuffered && ! DjtgSyncBuffer(hif) ) {
+                    return FFail("DjtgSyncBuffer failed");
+                }
+                usleep((useconds_t)ceil(secMin * 1000000.0));
+            }
+        }
+    }
+
+    while ( 0 < cclkWait ) {
+
+        cclkCall = ( cclkWait < 0x80000000 ) ? (DWORD)cclkWait : 0x80000000;
+        if ( ! FClock(cclkCall) ) {
+            return fFalse;
+        }
+        cclkWait -= cclkCall;
+    }
+
+    return FMoveTo(tpsEnd);
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FSync
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if an overlapped call doesn't complete, or if TDO doesn't
+**      match for a scan that isn't tentative.
+**
+**  Description:
+**      Wait for the overlapped calls to complete and make the pending
+**      compares. The last bit of a scan that exits the shift state was
+**      received on its own and is merged into the TDO bits first.
+**      fLastMatch is cleared if a tentative scan doesn't match.
+*/
+BOOL
+SvfPlayer::FSync() {
+
+    SVCMP * pcmp;
+    DWORD   icmp;
+    DWORD   ibitLast;
+    DWORD   cbOut;
+    DWORD   cbIn;
+    BOOL    fOk;
+    double  secStart;
+
+    if (( 0 == ccallPending ) && ( 0 == ccmp )) {
+        return fTrue;
+    }
+
+    secStart = SecNow();
+    fOk = fTrue;
+
+    if ( fBuffered && ! DjtgSyncBuffer(hif) ) {
+        fOk = FFail("DjtgSyncBuffer failed");
+    }
+
+    while ( fOk && ( 0 < ccallPending ) ) {
+
+        if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsSvfCallWait) ) {
+            fOk = FFail("an overlapped call didn't complete");
+            break;
+        }
+        ccallPending--;
+    }
+
+    if ( 0 != ccallPending ) {
+        DmgrCancelTrans(hif);
+        ccallPending = 0;
+    }
+
+    for ( icmp = 0; icmp < ccmp; icmp++ ) {
+
+        pcmp = &rgcmp[icmp];
+
+        if ( fOk ) {
+
+            if ( pcmp->fExit ) {
+                ibitLast = pcmp->cbit - 1;
+                pcmp->rgbTdo[ibitLast / 8] &= ~(1 << (ibitLast % 8));
+                pcmp->rgbTdo[ibitLast / 8] |= (pcmp->bTdoLast & 1) << (ibitLast % 8);
+            }
+
+            if ( ! FJbMaskedEqual(pcmp->rgbTdo, pcmp->rgbExp, pcmp->rgbMask, pcmp->cbit) ) {
+
+                if ( pcmp->fTentative ) {
+                    fLastMatch = fFalse;
+                }
+                else {
+                    cerrCompare++;
+                    iline = pcmp->iline;
+                    fOk = FFail("TDO mismatch");
+                }
+            }
+        }
+
+        free(pcmp->rgbTdi);
+    }
+
+    ccmp = 0;
+    cbPending = 0;
+
+    secStart = SecNow() - secStart;
+    secSync += secStart;
+    rgstat[svcVerify].cinstr++;
+    rgstat[svcVerify].sec += secStart;
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FFail
+**
+**  Parameters:
+**      szFmt       - printf style format of the message
+**      ...         - values for the format
+**
+**  Return Values:
+**      always fFalse
+**
+**  Errors:
+**
+**  Description:
+**      Record an error message with the line or offset of the current
+**      command. Only the first error is kept, as the later ones are
+**      usually caused by it.
+*/
+BOOL
+SvfPlayer::FFail( const char * szFmt, ... ) {
+
+    va_list ap;
+    int     cch;
+
+    if ( '\0' != szError[0] ) {
+        return fFalse;
+    }
+
+    cch = snprintf(szError, sizeof(szError), "%s %u: ", szWhere, iline);
+
+    va_start(ap, szFmt);
+    vsnprintf(&szError[cch], sizeof(szError) - cch, szFmt, ap);
+    va_end(ap);
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::FreeVec
+**
+**  Parameters:
+**      pvec        - vector to free
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the values of a vector and set its length to zero.
+*/
+void
+SvfPlayer::FreeVec( SVVEC * pvec ) {
+
+    free(pvec->rgbTdi);
+    memset(pvec, 0, sizeof(SVVEC));
+}
+
+/* ------------------------------------------------------------ */
+/***    SvfPlayer::Account
+**
+**  Parameters:
+**      isvc            - instruction class
+**      secStart        - time the instruction started
+**      cclkStart       - value of cclkTotal when it started
+**      secSyncStart    - value of secSync when it started
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Add an instruction to the statistics of its class. Time spent
+**      synchronizing is already charged to svcVerify, so it is taken
+**      out of the instruction's time.
+*/
+void
+SvfPlayer::Account( int isvc, double secStart, UINT64 cclkStart, double secSyncStart ) {
+
+    rgstat[isvc].cinstr++;
+    rgstat[isvc].cclk += cclkTotal - cclkStart;
+    rgstat[isvc].sec += (SecNow() - secStart) - (secSync - secSyncStart);
+}
+
+/* ------------------------------------------------------------ */
+/***    SzSvfClass
+**
+**  Parameters:
+**      isvc        - instruction class
+**
+**  Return Values:
+**      name of the class
+**
+**  Errors:
+**
+**  Description:
+**      Return the name of an instruction class for reports.
+*/
+const char *
+SzSvfClass( int isvc ) {
+
+    switch ( isvc ) {
+        case svcSir:        return "SIR";
+        case svcSdr:        return "SDR";
+        case svcRunTest:    return "RUNTEST";
+        case svcState:      return "STATE";
+        case svcVerify:     return "verify";
+        default:            return "other";
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    PbReadFile
+**
+**  Parameters:
+**      szFile      - path of the file
+**      pcb         - receives the size of the file
+**
+**  Return Values:
+**      contents of the file followed by a NUL, or NULL on failure
+**
+**  Errors:
+**      Fails if the file can't be opened or read, or memory can't be
+**      allocated.
+**
+**  Description:
+**      Read a whole file into memory. The caller frees the buffer.
+*/
+static BYTE *
+PbReadFile( const char * szFile, DWORD * pcb ) {
+
+    FILE *  pfile;
+    BYTE *  pb;
+    long    cb;
+
+    pfile = fopen(szFile, "rb");
+    if ( NULL == pfile ) {
+        return NULL;
+    }
+
+    pb = NULL;
+
+    if (( 0 != fseek(pfile, 0, SEEK_END) ) || ( 0 > (cb = ftell(pfile)) ) ||
+        ( 0 != fseek(pfile, 0, SEEK_SET) )) {
+        goto lErrorExit;
+    }
+
+    pb = (BYTE *)malloc(cb + 1);
+    if (( NULL == pb ) || ( (size_t)cb != fread(pb, 1, cb, pfile) )) {
+        goto lErrorExit;
+    }
+
+    fclose(pfile);
+    pb[cb] = '\0';
+    *pcb = (DWORD)cb;
+
+    return pb;
+
+lErrorExit:
+    free(pb);
+    fclose(pfile);
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSvfTps
+**
+**  Parameters:
+**      szTok       - upper cased SVF state name
+**      ptps        - receives the TAP state
+**
+**  Return Values:
+**      fTrue for a known name, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Look up the TAP state of an SVF state name.
+*/
+static BOOL
+FSvfTps( const char * szTok, BYTE * ptps ) {
+
+    BYTE    tpsName;
+
+    for ( tpsName = 0; tpsName < ctpsMax; tpsName++ ) {
+
+        if ( 0 == strcmp(szTok, rgszSvfState[tpsName]) ) {
+            *ptps = tpsName;
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHexToBits
+**
+**  Parameters:
+**      szTok       - value token: '(' followed by upper case hex digits
+**      rgb         - receives the bits, LSB first
+**      cbit        - number of bits
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a character isn't a hex digit.
+**
+**  Description:
+**      Convert an SVF value. The last digit holds bits 0 to 3. Missing
+**      digits are zero and digits beyond the length are dropped.
+*/
+static BOOL
+FHexToBits( const char * szTok, BYTE * rgb, DWORD cbit ) {
+
+    const char *    pch;
+    DWORD           cb;
+    DWORD           ibit;
+    BYTE            bNib;
+
+    cb = (cbit + 7) / 8;
+    memset(rgb, 0, cb);
+
+    pch = szTok + strlen(szTok);
+    ibit = 0;
+
+    while ( --pch > szTok ) {
+
+        if (( '0' <= *pch ) && ( '9' >= *pch )) {
+            bNib = *pch - '0';
+        }
+        else if (( 'A' <= *pch ) && ( 'F' >= *pch )) {
+            bNib = *pch - 'A' + 10;
+        }
+        else {
+            return fFalse;
+        }
+
+        if ( ibit < cbit ) {
+            rgb[ibit / 8] |= bNib << (ibit % 8);
+        }
+        ibit += 4;
+    }
+
+    ClearTail(rgb, cbit);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    CopyBits
+**
+**  Parameters:
+**      rgbDst      - destination, zero from ibitDst on
+**      ibitDst     - first bit of the destination
+**      rgbSrc      - source bits, LSB first, zero past cbit
+**      cbit        - number of bits
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Append a bit string to a buffer. The source is copied a byte at
+**      a time when the destination starts on a byte boundary.
+*/
+static void
+CopyBits( BYTE * rgbDst, DWORD ibitDst, const BYTE * rgbSrc, DWORD cbit ) {
+
+    DWORD   ibit;
+
+    if ( 0 == ibitDst % 8 ) {
+        memcpy(&rgbDst[ibitDst / 8], rgbSrc, (cbit + 7) / 8);
+        return;
+    }
+
+    for ( ibit = 0; ibit < cbit; ibit++ ) {
+        if ( rgbSrc[ibit / 8] & (1 << (ibit % 8)) ) {
+            rgbDst[(ibitDst + ibit) / 8] |= 1 << ((ibitDst + ibit) % 8);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    ClearTail
+**
+**  Parameters:
+**      rgb         - bits, LSB first
+**      cbit        - number of bits
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Clear the bits of the last byte that are past the length.
+*/
+static void
+ClearTail( BYTE * rgb, DWORD cbit ) {
+
+    if ( 0 != cbit % 8 ) {
+        rgb[cbit / 8] &= (1 << (cbit % 8)) - 1;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FXsvfRead
+**
+**  Parameters:
+**      rgbFile     - contents of the XSVF file
+**      cbFile      - size of the file
+**      pib         - offset of the vector, advanced past it
+**      rgbDst      - receives the bits, LSB first
+**      cbit        - number of bits
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file ends within the vector.
+**
+**  Description:
+**      Read an XSVF vector. Vectors are stored with the most
+**      significant byte first, so the bytes are reversed.
+*/
+static BOOL
+FXsvfRead( const BYTE * rgbFile, DWORD cbFile, DWORD * pib, BYTE * rgbDst, DWORD cbit ) {
+
+    DWORD   cb;
+    DWORD   ib;
+
+    cb = (cbit + 7) / 8;
+    if ( cb > cbFile - *pib ) {
+        return fFalse;
+    }
+
+    for ( ib = 0; ib < cb; ib++ ) {
+        rgbDst[ib] = rgbFile[*pib + cb - 1 - ib];
+    }
+
+    ClearTail(rgbDst, cbit);
+    *pib += cb;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FXsvfValue
+**
+**  Parameters:
+**      rgbFile     - contents of the XSVF file
+**      cbFile      - size of the file
+**      pib         - offset of the value, advanced past it
+**      cb          - size of the value, 1 to 4 bytes
+**      pdw         - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the file ends within the value.
+**
+**  Description:
+**      Read a big endian XSVF value.
+*/
+static BOOL
+FXsvfValue( const BYTE * rgbFile, DWORD cbFile, DWORD * pib, DWORD cb, DWORD * pdw ) {
+
+    DWORD   ib;
+
+    if ( cb > cbFile - *pib ) {
+        return fFalse;
+    }
+
+    *pdw = 0;
+    for ( ib = 0; ib < cb; ib++ ) {
+        *pdw = (*pdw << 8) | rgbFile[(*pib)++];
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,208 @@
+/************************************************************************/
+/*                                                                      */
+/*    SvfPlayer.h  --   Interface Declarations for SvfPlayer.cpp        */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for a        */
+/*    player of SVF and XSVF files on a DJTG port.                      */
+/*                                                                      */
+/*    The player enables transaction buffering on the port, so scans    */
+/*    whose TDO is not checked are queued by the DJTG library and sent  */
+/*    in large transfers. TAP state moves are kept in a JtgTap model    */
+/*    and sent as TMS/TDI pairs with one DjtgPutTmsTdiBits call when    */
+/*    another call has to be made; a scan of up to cbitSvfInline bits   */
+/*    that is not compared goes into the same call. A longer scan is    */
+/*    shifted with one DjtgPutTdiBits call per cbitSvfChunk bits before */
+/*    its last bit, which leaves the shift state. Waits are made by     */
+/*    clocking TCK in the run state, so they stay in the buffer too.    */
+/*    JtgTap.h must be included before this header.                     */
+/*                                                                      */
+/*    Scans that have a TDO compare are issued as overlapped calls and  */
+/*    their compares are deferred. The buffer is only synchronized when */
+/*    compares are pending and one of them must be resolved: when too   */
+/*    many are pending, when an XSVF retry depends on the result, or at */
+/*    the end of the file. A compare is made a 64 bit word at a time    */
+/*    with the mask applied. A mismatch is reported with the line of    */
+/*    the SVF statement, or the offset of the XSVF command, that made   */
+/*    the scan.                                                         */
+/*                                                                      */
+/*    The time the host spends on each class of instruction, and the    */
+/*    number of TCK cycles it produced, are kept so that a slow file    */
+/*    can be traced to its cause.                                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(SVFPLAYER_INCLUDED)
+#define      SVFPLAYER_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Instruction classes that time is accounted to.
+*/
+const int   svcSir          = 0;    // SIR, XSIR, XSIR2
+const int   svcSdr          = 1;    // SDR and the XSDR commands
+const int   svcRunTest      = 2;    // RUNTEST, XWAIT
+const int   svcState        = 3;    // STATE, TRST, XSTATE
+const int   svcVerify       = 4;    // synchronizing and comparing TDO
+const int   svcOther        = 5;    // everything else
+const int   csvcMax         = 6;
+
+/* Largest number of bits shifted by one DjtgPutTdiBits call.
+*/
+const DWORD cbitSvfChunk    = 8 * 65536;
+
+/* Longest scan without a compare that is sent in the TMS sequence, as
+** TMS/TDI pairs, instead of with DjtgPutTdiBits.
+*/
+const DWORD cbitSvfInline   = 256;
+
+/* Limits on the scans with a compare that may be pending before the
+** buffer is synchronized.
+*/
+const DWORD ccmpSvfPendingMax   = 32;
+const DWORD cbSvfPendingMax     = 16 * 1024 * 1024;
+
+/* Time allowed for each overlapped call to complete.
+*/
+const DWORD tmsSvfCallWait  = 10000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Time and TCK cycles spent on a class of instructions.
+*/
+typedef struct {
+    DWORD   cinstr;         // number of instructions
+    UINT64  cclk;           // TCK cycles produced
+    double  sec;            // host time spent
+} SVSTAT;
+
+/* A vector of an SVF scan command. The TDI, MASK and SMASK values
+** carry over to the next command of the same kind when its length is
+** the same.
+*/
+typedef struct {
+    DWORD   cbit;
+    BYTE *  rgbTdi;
+    BYTE *  rgbTdo;
+    BYTE *  rgbMask;
+    BOOL    fTdo;           // TDO was given for the current command
+} SVVEC;
+
+/* A scan whose TDO has yet to be compared. The buffers must stay valid
+** until the overlapped calls of the scan have completed.
+*/
+typedef struct {
+    DWORD   cbit;
+    BYTE *  rgbTdi;         // bits sent
+    BYTE *  rgbTdo;         // bits received
+    BYTE *  rgbExp;         // bits expected
+    BYTE *  rgbMask;        // bits that are compared
+    BYTE    bTdiLast;       // last bit sent, with TMS high
+    BYTE    bTdoLast;       // last bit received
+    BOOL    fExit;          // the last bit was shifted on its own
+    DWORD   iline;          // SVF line or XSVF offset of the command
+    BOOL    fTentative;     // a mismatch isn't an error (XSVF retry)
+} SVCMP;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class SvfPlayer {
+
+private:
+    HIF         hif;
+    BOOL        fBuffered;
+    DWORD       frqTck;
+    JtgTap      tap;
+
+    /* SVF state.
+    */
+    SVVEC       vecHdr;
+    SVVEC       vecHir;
+    SVVEC       vecTdr;
+    SVVEC       vecTir;
+    SVVEC       vecSdr;
+    SVVEC       vecSir;
+    BYTE        tpsEndDr;
+    BYTE        tpsEndIr;
+    BYTE        tpsRun;
+    BYTE        tpsRunEnd;
+    BYTE *      rgbAsm;         // scan assembled from header, data and trailer
+    DWORD       cbAsmMax;
+
+    /* Scans with a pending compare.
+    */
+    SVCMP       rgcmp[ccmpSvfPendingMax];
+    DWORD       ccmp;
+    DWORD       cbPending;
+    DWORD       ccallPending;
+    BOOL        fLastMatch;
+
+    /* Statistics and errors.
+    */
+    SVSTAT      rgstat[csvcMax];
+    UINT64      cclkTotal;
+    double      secSync;
+    DWORD       cerrCompare;
+    DWORD       iline;          // line or offset of the current command
+    const char * szWhere;       // "line" or "offset"
+    char        szError[256];
+
+    BOOL    FMoveTo(BYTE tpsTo);
+    BOOL    FFlushTap();
+    BOOL    FShift(BOOL fIr, const BYTE * rgbTdi, DWORD cbit, const BYTE * rgbExp,
+                   const BYTE * rgbMask, BOOL fExit, BYTE tpsEnd, BOOL fTentative);
+    BOOL    FClock(DWORD cclk);
+    BOOL    FWaitIn(BYTE tpsWait, DWORD cclk, double secMin, BYTE tpsEnd);
+    BOOL    FSync();
+    BOOL    FFail(const char * szFmt, ...);
+    void    FreeVec(SVVEC * pvec);
+    void    Account(int isvc, double secStart, UINT64 cclkStart, double secSyncStart);
+
+    BOOL    FSvfStatement(char * szStmt);
+    BOOL    FSvfVector(char ** rgszTok, int ctok, SVVEC * pvec);
+    BOOL    FSvfScan(BOOL fIr);
+    BOOL    FSvfRunTest(char ** rgszTok, int ctok);
+
+    SvfPlayer(const SvfPlayer &);
+    SvfPlayer & operator=(const SvfPlayer &);
+
+public:
+    SvfPlayer();
+    ~SvfPlayer();
+
+    BOOL    FInit(HIF hifReq);
+    BOOL    FPlaySvf(const char * szFile);
+    BOOL    FPlayXsvf(const char * szFile);
+    BOOL    FFinish();
+
+    DWORD           FrqTck() const { return frqTck; }
+    DWORD           CerrCompare() const { return cerrCompare; }
+    UINT64          CclkTotal() const { return cclkTotal; }
+    const SVSTAT *  PstatClass(int isvc) const { return &rgstat[isvc]; }
+    const char *    SzError() const { return szError; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+const char *    SzSvfClass(int isvc);
+
+/* ------------------------------------------------------------ */
+
+#endif                    // SVFPLAYER_INCLUDED
+
+/************************************************************************/
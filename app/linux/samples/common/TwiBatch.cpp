@@ -0,0 +1,1092 @@
+/************************************************************************/
+/*                                                                      */
+/*  TwiBatch.cpp  --  Compiled I2C programs for DtwiMasterBatch         */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a builder that serializes a sequence of I2C  */
+/*  steps into DtwiMasterBatch command buffers.                         */
+/*                                                                      */
+/*  Every command is appended to a single send buffer as it is          */
+/*  recorded, and the operations are contiguous in it, so executing     */
+/*  the program only has to pass ranges of that buffer to               */
+/*  DtwiMasterBatch. The bytes read by all the calls land in a single   */
+/*  receive buffer, and are copied from there to the caller's buffers   */
+/*  after the last call has completed.                                  */
+/*                                                                      */
+/*  While a transaction is recorded its form is tracked, so that a port */
+/*  without batch support can still make the transactions that map to   */
+/*  one DtwiMasterPut, DtwiMasterGet or DtwiMasterPutGet call.          */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dtwi.h"
+#include "TwiBatch.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Steps of the transaction being recorded, used to find its form.
+*/
+const DWORD     tbphStartW  = 0;        // start for write
+const DWORD     tbphPut     = 1;        // one put after the start
+const DWORD     tbphWait    = 2;        // one wait after the put
+const DWORD     tbphRepR    = 3;        // repeated start for read to the same slave
+const DWORD     tbphStartR  = 4;        // start for read
+const DWORD     tbphGet     = 5;        // one get after the start for read
+const DWORD     tbphOther   = 6;        // anything else
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static BOOL     FTwiBusErc(ERC erc);
+static void     HostWait(DWORD tus);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    TwiBatch::TwiBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct an empty program.
+*/
+TwiBatch::TwiBatch() {
+
+    rgbSnd = NULL;
+    rgbRcv = NULL;
+    cbSndMax = 0;
+    cbRcvMax = 0;
+    rgop = NULL;
+    copMax = 0;
+    rgscat = NULL;
+    cscatMax = 0;
+
+    icallOldest = 0;
+    ccallInFlight = 0;
+
+    hifProps = hifInvalid;
+    prtProps = 0;
+    fBatch = fFalse;
+
+    Reset();
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::~TwiBatch
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the memory used by the program.
+*/
+TwiBatch::~TwiBatch() {
+
+    free(rgbSnd);
+    free(rgbRcv);
+    free(rgop);
+    free(rgscat);
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::Reset
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Remove every step from the program. The memory is kept so that
+**      the program can be rebuilt without allocating.
+*/
+void
+TwiBatch::Reset() {
+
+    cbSnd = 0;
+    cbRcv = 0;
+    cop = 0;
+    cscat = 0;
+    fOpen = fFalse;
+    fRead = fFalse;
+    tbph = tbphOther;
+    fError = fFalse;
+    ccallLast = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FStart
+**
+**  Parameters:
+**      dadr        - 7 bit address of the slave
+**      fReadReq    - fTrue to read from the slave, fFalse to write
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a start condition and the address packet. Within a
+**      transaction this is a repeated start, which may address another
+**      slave; otherwise it begins a new transaction.
+*/
+BOOL
+TwiBatch::FStart( BYTE dadr, BOOL fReadReq ) {
+
+    TBOP *  pop;
+    BYTE *  pb;
+
+    if ( 0x7F < dadr ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( ! fOpen ) {
+
+        pop = PopNew(fTrue);
+        pb = PbCmdNew(fReadReq ? tcbStartSlar : tcbStartSlaw, 0);
+        if (( NULL == pop ) || ( NULL == pb )) {
+            return fFalse;
+        }
+
+        *pb = dadr;
+        pop->dadr = dadr;
+        fOpen = fTrue;
+        tbph = fReadReq ? tbphStartR : tbphStartW;
+    }
+    else {
+
+        pop = &rgop[cop - 1];
+        pb = PbCmdNew(fReadReq ? tcbRepStartSlar : tcbRepStartSlaw, 0);
+        if ( NULL == pb ) {
+            return fFalse;
+        }
+
+        *pb = dadr;
+
+        if (( fReadReq ) && ( dadr == pop->dadr ) &&
+            (( tbphStartW == tbph ) || ( tbphPut == tbph ) || ( tbphWait == tbph ))) {
+
+            tbph = tbphRepR;
+        }
+        else {
+            tbph = tbphOther;
+        }
+    }
+
+    fRead = fReadReq;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FPut
+**
+**  Parameters:
+**      rgbSndReq   - bytes to write
+**      cb          - number of bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no transaction for write is started.
+**
+**  Description:
+**      Add bytes written to the slave addressed by the last start.
+*/
+BOOL
+TwiBatch::FPut( const BYTE * rgbSndReq, DWORD cb ) {
+
+    TBOP *  pop;
+    DWORD   ibPut;
+
+    if (( ! fOpen ) || ( fRead ) || (( 0 != cb ) && ( NULL == rgbSndReq ))) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( 0 == cb ) {
+        return ! fError;
+    }
+
+    /* The data of the first command starts after its count.
+    */
+    ibPut = cbSnd + (tcbPut & 0x0F);
+
+    if ( ! FAddWord(tcbPut, cb, rgbSndReq) ) {
+        return fFalse;
+    }
+
+    pop = &rgop[cop - 1];
+
+    if (( tbphStartW == tbph ) && ( cbTbCmdMax >= cb )) {
+
+        pop->ibPut = ibPut;
+        pop->cbPut = cb;
+        tbph = tbphPut;
+    }
+    else {
+        tbph = tbphOther;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FGet
+**
+**  Parameters:
+**      rgbRcvReq   - receives the bytes read
+**      cb          - number of bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no transaction for read is started.
+**
+**  Description:
+**      Add bytes read from the slave addressed by the last start. The
+**      master NAKs the last byte of each get.
+*/
+BOOL
+TwiBatch::FGet( BYTE * rgbRcvReq, DWORD cb ) {
+
+    TBSCAT *    pscat;
+    DWORD       ibRcv;
+
+    if (( ! fOpen ) || ( ! fRead ) || (( 0 != cb ) && ( NULL == rgbRcvReq ))) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( 0 == cb ) {
+        return ! fError;
+    }
+
+    ibRcv = cbRcv;
+
+    if ( ! FAddWord(tcbGet, cb, NULL) ) {
+        return fFalse;
+    }
+
+    if ( ! FGrowArray((void **)&rgscat, &cscatMax, cscat + 1, sizeof(TBSCAT)) ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    pscat = &rgscat[cscat++];
+    pscat->ib = ibRcv;
+    pscat->cb = cb;
+    pscat->pbDst = rgbRcvReq;
+    pscat->iop = cop - 1;
+
+    if ((( tbphStartR == tbph ) || ( tbphRepR == tbph )) && ( cbTbCmdMax >= cb )) {
+        tbph = tbphGet;
+    }
+    else {
+        tbph = tbphOther;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FStop
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if no transaction is started.
+**
+**  Description:
+**      Add a stop condition, which ends the transaction.
+*/
+BOOL
+TwiBatch::FStop() {
+
+    TBOP *  pop;
+
+    if ( ! fOpen ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( NULL == PbCmdNew(tcbStop, 0) ) {
+        return fFalse;
+    }
+
+    pop = &rgop[cop - 1];
+
+    if (( tbphStartW == tbph ) || ( tbphPut == tbph )) {
+        pop->tbfm = tbfmPut;
+    }
+    else if (( tbphGet == tbph ) && ( 0 == pop->cbPut ) && ( 0 == pop->tusWait ) &&
+             ( tcbStartSlar == rgbSnd[pop->ibSnd] )) {
+
+        pop->tbfm = tbfmGet;
+    }
+    else if ( tbphGet == tbph ) {
+        pop->tbfm = tbfmPutGet;
+    }
+
+    fOpen = fFalse;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FWait
+**
+**  Parameters:
+**      tus         - time to wait in microseconds
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a wait. Within a transaction the wait holds the bus; between
+**      transactions it is an operation of its own.
+*/
+BOOL
+TwiBatch::FWait( DWORD tus ) {
+
+    TBOP *  pop;
+
+    if ( 0 == tus ) {
+        return ! fError;
+    }
+
+    if ( ! fOpen ) {
+
+        if ( NULL == PopNew(fFalse) ) {
+            return fFalse;
+        }
+    }
+
+    if ( ! FAddWord(tcbWait, tus, NULL) ) {
+        return fFalse;
+    }
+
+    pop = &rgop[cop - 1];
+
+    if ( ! fOpen ) {
+        pop->tusWait = tus;
+    }
+    else if (( tbphPut == tbph ) && ( cbTbCmdMax >= tus )) {
+
+        pop->tusWait = tus;
+        tbph = tbphWait;
+    }
+    else {
+        tbph = tbphOther;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FSplit
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a transaction is started and not stopped.
+**
+**  Description:
+**      End the call after the last operation, so that the operations
+**      recorded before and after it have separate results. The calls
+**      are still overlapped, so this costs little time.
+*/
+BOOL
+TwiBatch::FSplit() {
+
+    if ( fOpen ) {
+
+        fError = fTrue;
+        return fFalse;
+    }
+
+    if ( 0 != cop ) {
+        rgop[cop - 1].fSplit = fTrue;
+    }
+
+    return ! fError;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FWrite
+**
+**  Parameters:
+**      dadr        - 7 bit address of the slave
+**      rgbSndReq   - bytes to write
+**      cb          - number of bytes, 0 only sends the address
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a complete write transaction, as DtwiMasterPut.
+*/
+BOOL
+TwiBatch::FWrite( BYTE dadr, const BYTE * rgbSndReq, DWORD cb ) {
+
+    return FStart(dadr, fFalse) && FPut(rgbSndReq, cb) && FStop();
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FRead
+**
+**  Parameters:
+**      dadr        - 7 bit address of the slave
+**      rgbRcvReq   - receives the bytes read
+**      cb          - number of bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a complete read transaction, as DtwiMasterGet.
+*/
+BOOL
+TwiBatch::FRead( BYTE dadr, BYTE * rgbRcvReq, DWORD cb ) {
+
+    return FStart(dadr, fTrue) && FGet(rgbRcvReq, cb) && FStop();
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FWriteRead
+**
+**  Parameters:
+**      dadr        - 7 bit address of the slave
+**      rgbSndReq   - bytes to write, usually a register address
+**      cbSndReq    - number of bytes to write
+**      tusWait     - time to wait before the repeated start
+**      rgbRcvReq   - receives the bytes read
+**      cbRcvReq    - number of bytes to read
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Add a write followed by a repeated start and a read of the same
+**      slave, as DtwiMasterPutGet. This is how most sensors read their
+**      registers.
+*/
+BOOL
+TwiBatch::FWriteRead( BYTE dadr, const BYTE * rgbSndReq, DWORD cbSndReq,
+                      DWORD tusWait, BYTE * rgbRcvReq, DWORD cbRcvReq ) {
+
+    return FStart(dadr, fFalse) && FPut(rgbSndReq, cbSndReq) && FWait(tusWait) &&
+           FStart(dadr, fTrue) && FGet(rgbRcvReq, cbRcvReq) && FStop();
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FExecute
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled
+**      prt         - DTWI port that was enabled
+**
+**  Return Values:
+**      fTrue if every operation succeeded, fFalse otherwise
+**
+**  Errors:
+**      Fails if a step failed to be recorded, a transaction isn't
+**      stopped or an operation fails. ErcOp gives the result of each
+**      operation; operations that weren't made report
+**      ercTransferCancelled.
+**
+**  Description:
+**      Run the program. Consecutive operations are packed into
+**      DtwiMasterBatch calls of up to cbTbSndMax and cbTbRcvMax bytes,
+**      ending a call early after an operation marked by FSplit, and the
+**      calls are issued overlapped with up to ccallTbInFlightMax in
+**      flight. A NAK or other bus error only fails the operations of
+**      its call; the execution is abandoned if a call doesn't complete.
+**      The bytes read are copied to the caller's buffers at the end.
+*/
+BOOL
+TwiBatch::FExecute( HIF hif, INT32 prt ) {
+
+    TBOP *      pop;
+    TBSCAT *    pscat;
+    DWORD       iop;
+    DWORD       iopFirst;
+    DWORD       iscat;
+    DWORD       cbSndCall;
+    DWORD       cbRcvCall;
+    BOOL        fOk;
+
+    ccallLast = 0;
+    icallOldest = 0;
+    ccallInFlight = 0;
+
+    SetErc(0, cop, ercTransferCancelled);
+
+    if (( fError ) || ( fOpen ) || ( ! FGetProps(hif, prt) )) {
+        return fFalse;
+    }
+
+    if ( ! FGrowArray((void **)&rgbRcv, &cbRcvMax, ( 0 != cbRcv ) ? cbRcv : 1, 1) ) {
+        return fFalse;
+    }
+
+    iopFirst = 0;
+    cbSndCall = 0;
+    cbRcvCall = 0;
+
+    for ( iop = 0; iop < cop; iop++ ) {
+
+        pop = &rgop[iop];
+
+        if ( ! fBatch ) {
+
+            if ( ! FIssue(hif, iop, iop + 1) ) {
+                return fFalse;
+            }
+
+            continue;
+        }
+
+        /* Start a new call when this operation doesn't fit.
+        */
+        if (( iopFirst < iop ) &&
+            (( cbTbSndMax < cbSndCall + pop->cbSnd ) || ( cbTbRcvMax < cbRcvCall + pop->cbRcv ))) {
+
+            if ( ! FIssue(hif, iopFirst, iop) ) {
+                return fFalse;
+            }
+
+            iopFirst = iop;
+            cbSndCall = 0;
+            cbRcvCall = 0;
+        }
+
+        cbSndCall += pop->cbSnd;
+        cbRcvCall += pop->cbRcv;
+
+        if ( pop->fSplit ) {
+
+            if ( ! FIssue(hif, iopFirst, iop + 1) ) {
+                return fFalse;
+            }
+
+            iopFirst = iop + 1;
+            cbSndCall = 0;
+            cbRcvCall = 0;
+        }
+    }
+
+    if (( fBatch ) && ( ! FIssue(hif, iopFirst, cop) )) {
+        return fFalse;
+    }
+
+    if ( ! FWaitCalls(hif, 0) ) {
+        return fFalse;
+    }
+
+    for ( iscat = 0; iscat < cscat; iscat++ ) {
+
+        pscat = &rgscat[iscat];
+
+        if ( ercNoErc == rgop[pscat->iop].erc ) {
+            memcpy(pscat->pbDst, &rgbRcv[pscat->ib], pscat->cb);
+        }
+    }
+
+    fOk = fTrue;
+    for ( iop = 0; iop < cop; iop++ ) {
+        if ( ercNoErc != rgop[iop].erc ) {
+            fOk = fFalse;
+        }
+    }
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::PopNew
+**
+**  Parameters:
+**      fTrn        - the operation is a transaction
+**
+**  Return Values:
+**      pointer to the new operation, or NULL on failure
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Begin an operation at the end of the send and receive buffers.
+*/
+TBOP *
+TwiBatch::PopNew( BOOL fTrn ) {
+
+    TBOP *  pop;
+
+    if ( fError ) {
+        return NULL;
+    }
+
+    if ( ! FGrowArray((void **)&rgop, &copMax, cop + 1, sizeof(TBOP)) ) {
+
+        fError = fTrue;
+        return NULL;
+    }
+
+    pop = &rgop[cop++];
+    pop->ibSnd = cbSnd;
+    pop->cbSnd = 0;
+    pop->ibRcv = cbRcv;
+    pop->cbRcv = 0;
+    pop->fTrn = fTrn;
+    pop->fSplit = fFalse;
+    pop->tbfm = tbfmNone;
+    pop->dadr = 0;
+    pop->ibPut = 0;
+    pop->cbPut = 0;
+    pop->tusWait = 0;
+    pop->erc = ercNoErc;
+
+    return pop;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::PbCmdNew
+**
+**  Parameters:
+**      tcb         - command code
+**      cbData      - bytes of data that follow the parameters
+**
+**  Return Values:
+**      pointer to the parameters of the new command, or NULL on failure
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a command to the last operation. The low nibble of each
+**      tcb code in dtwi.h is the size of the command without its data,
+**      so the caller only has to fill in the parameters and the data.
+*/
+BYTE *
+TwiBatch::PbCmdNew( BYTE tcb, DWORD cbData ) {
+
+    DWORD   cbCmd;
+    BYTE *  pb;
+
+    if (( fError ) || ( 0 == cop )) {
+
+        fError = fTrue;
+        return NULL;
+    }
+
+    cbCmd = (tcb & 0x0F) + cbData;
+
+    if ( ! FGrowArray((void **)&rgbSnd, &cbSndMax, cbSnd + cbCmd, 1) ) {
+
+        fError = fTrue;
+        return NULL;
+    }
+
+    pb = &rgbSnd[cbSnd];
+    *pb = tcb;
+
+    cbSnd += cbCmd;
+    rgop[cop - 1].cbSnd += cbCmd;
+
+    return pb + 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FAddWord
+**
+**  Parameters:
+**      tcb         - tcbPut, tcbGet or tcbWait
+**      cw          - byte count or microseconds
+**      rgbData     - bytes to write for tcbPut, NULL otherwise
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if memory can't be allocated.
+**
+**  Description:
+**      Append a command with a WORD count, or several commands of up
+**      to cbTbCmdMax each if the count is larger than that.
+*/
+BOOL
+TwiBatch::FAddWord( BYTE tcb, DWORD cw, const BYTE * rgbData ) {
+
+    BYTE *  pb;
+    DWORD   iw;
+    DWORD   cwCmd;
+
+    for ( iw = 0; iw < cw; iw += cwCmd ) {
+
+        cwCmd = cw - iw;
+        if ( cbTbCmdMax < cwCmd ) {
+            cwCmd = cbTbCmdMax;
+        }
+
+        pb = PbCmdNew(tcb, ( NULL != rgbData ) ? cwCmd : 0);
+        if ( NULL == pb ) {
+            return fFalse;
+        }
+
+        pb[0] = (BYTE)(cwCmd & 0xFF);
+        pb[1] = (BYTE)((cwCmd >> 8) & 0xFF);
+
+        if ( NULL != rgbData ) {
+            memcpy(&pb[2], &rgbData[iw], cwCmd);
+        }
+
+        if ( tcbGet == tcb ) {
+
+            cbRcv += cwCmd;
+            rgop[cop - 1].cbRcv += cwCmd;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FGetProps
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled
+**      prt         - DTWI port that was enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Find out whether the port supports DtwiMasterBatch. The answer
+**      is kept for the next execution on the same port.
+*/
+BOOL
+TwiBatch::FGetProps( HIF hif, INT32 prt ) {
+
+    DWORD   dprp;
+
+    if (( hif == hifProps ) && ( prt == prtProps )) {
+        return fTrue;
+    }
+
+    hifProps = hifInvalid;
+
+    if ( ! DtwiGetPortProperties(hif, prt, &dprp) ) {
+        return fFalse;
+    }
+
+    fBatch = ( 0 != (dprp & dprpTwiBatch) );
+
+    hifProps = hif;
+    prtProps = prt;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FIssue
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled
+**      iopFirst    - first operation to send
+**      iopLim      - operation after the last one to send
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call can't be started or a call in flight doesn't
+**      complete. The calls in flight are cancelled.
+**
+**  Description:
+**      Start an overlapped call for a range of operations. The range is
+**      sent with DtwiMasterBatch when the port supports it. Otherwise it
+**      is a single operation: a transaction sent with the DTWI master
+**      call of its form, or a wait made by the host once the calls in
+**      flight have completed.
+*/
+BOOL
+TwiBatch::FIssue( HIF hif, DWORD iopFirst, DWORD iopLim ) {
+
+    TBOP *  popFirst;
+    TBOP *  popLast;
+    BYTE *  pbRcv;
+    DWORD   cbSndCall;
+    DWORD   cbRcvCall;
+    DWORD   icall;
+    BOOL    fOk;
+
+    if ( iopFirst >= iopLim ) {
+        return fTrue;
+    }
+
+    if ( ! FWaitCalls(hif, ccallTbInFlightMax - 1) ) {
+        return fFalse;
+    }
+
+    popFirst = &rgop[iopFirst];
+    popLast = &rgop[iopLim - 1];
+    pbRcv = ( 0 != popFirst->cbRcv ) ? &rgbRcv[popFirst->ibRcv] : NULL;
+
+    if ( fBatch ) {
+
+        cbSndCall = popLast->ibSnd + popLast->cbSnd - popFirst->ibSnd;
+        cbRcvCall = popLast->ibRcv + popLast->cbRcv - popFirst->ibRcv;
+
+        fOk = DtwiMasterBatch(hif, cbSndCall, &rgbSnd[popFirst->ibSnd], cbRcvCall,
+                              ( 0 != cbRcvCall ) ? &rgbRcv[popFirst->ibRcv] : NULL, fTrue);
+    }
+    else if ( ! popFirst->fTrn ) {
+
+        if ( ! FWaitCalls(hif, 0) ) {
+            return fFalse;
+        }
+
+        HostWait(popFirst->tusWait);
+        popFirst->erc = ercNoErc;
+        return fTrue;
+    }
+    else {
+
+        switch ( popFirst->tbfm ) {
+
+            case tbfmPut:
+                fOk = DtwiMasterPut(hif, popFirst->dadr, popFirst->cbPut,
+                                    &rgbSnd[popFirst->ibPut], fTrue);
+                break;
+
+            case tbfmGet:
+                fOk = DtwiMasterGet(hif, popFirst->dadr, popFirst->cbRcv, pbRcv, fTrue);
+                break;
+
+            case tbfmPutGet:
+                fOk = DtwiMasterPutGet(hif, popFirst->dadr, popFirst->cbPut,
+                                       &rgbSnd[popFirst->ibPut], popFirst->tusWait,
+                                       popFirst->cbRcv, pbRcv, fTrue);
+                break;
+
+            default:
+                popFirst->erc = ercNotSupported;
+                return fTrue;
+        }
+    }
+
+    if ( ! fOk ) {
+
+        SetErc(iopFirst, iopLim, DmgrGetLastError());
+
+        if ( 0 != ccallInFlight ) {
+            DmgrCancelTrans(hif);
+            ccallInFlight = 0;
+        }
+        return fFalse;
+    }
+
+    icall = (icallOldest + ccallInFlight) % ccallTbInFlightMax;
+    rgiopCallFirst[icall] = iopFirst;
+    rgiopCallLim[icall] = iopLim;
+    ccallInFlight++;
+    ccallLast++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::FWaitCalls
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled
+**      ccallLeave  - number of calls that may remain in flight
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a call doesn't complete. The remaining calls are
+**      cancelled.
+**
+**  Description:
+**      Wait for the oldest calls in flight to complete and record their
+**      results. A call that failed on the bus only fails its own
+**      operations; any other failure cancels the calls in flight.
+*/
+BOOL
+TwiBatch::FWaitCalls( HIF hif, DWORD ccallLeave ) {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+    DWORD   iopFirst;
+    DWORD   iopLim;
+    ERC     erc;
+
+    while ( ccallInFlight > ccallLeave ) {
+
+        iopFirst = rgiopCallFirst[icallOldest];
+        iopLim = rgiopCallLim[icallOldest];
+        icallOldest = (icallOldest + 1) % ccallTbInFlightMax;
+        ccallInFlight--;
+
+        if ( DmgrGetTransResult(hif, &cbOut, &cbIn, tmsTbCallWait) ) {
+
+            SetErc(iopFirst, iopLim, ercNoErc);
+            continue;
+        }
+
+        erc = DmgrGetLastError();
+        SetErc(iopFirst, iopLim, erc);
+
+        if ( ! FTwiBusErc(erc) ) {
+
+            DmgrCancelTrans(hif);
+            ccallInFlight = 0;
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiBatch::SetErc
+**
+**  Parameters:
+**      iopFirst    - first operation
+**      iopLim      - operation after the last one
+**      erc         - result
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set the result of a range of operations.
+*/
+void
+TwiBatch::SetErc( DWORD iopFirst, DWORD iopLim, ERC erc ) {
+
+    DWORD   iop;
+
+    for ( iop = iopFirst; iop < iopLim; iop++ ) {
+        rgop[iop].erc = erc;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FTwiBusErc
+**
+**  Parameters:
+**      erc         - error code of a failed call
+**
+**  Return Values:
+**      fTrue if the error happened on the bus, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      The TWI error codes of dpcdecl.h are reported by the port for
+**      one call, which leaves the port ready for the next one.
+*/
+static BOOL
+FTwiBusErc( ERC erc ) {
+
+    return ( ercTwiBadBatchCmd <= erc ) && ( ercTwiSmbPecError >= erc );
+}
+
+/* ------------------------------------------------------------ */
+/***    HostWait
+**
+**  Parameters:
+**      tus         - time to wait in microseconds
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Make a wait between transactions on a port that can't run
+**      batches.
+*/
+static void
+HostWait( DWORD tus ) {
+
+    struct timespec ts;
+
+    ts.tv_sec = tus / 1000000;
+    ts.tv_nsec = (tus % 1000000) * 1000;
+
+    while ( 0 != nanosleep(&ts, &ts) ) {
+    }
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
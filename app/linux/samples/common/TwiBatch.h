@@ -0,0 +1,205 @@
+/************************************************************************/
+/*                                                                      */
+/*    TwiBatch.h  --    Interface Declarations for TwiBatch.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for an I2C   */
+/*    program builder. A batch records starts, repeated starts, puts,   */
+/*    gets, stops and waits addressed to any number of slaves, and      */
+/*    executes them with as few DtwiMasterBatch calls as possible       */
+/*    instead of one DtwiMasterPut, DtwiMasterGet or DtwiMasterPutGet   */
+/*    call per register access.                                         */
+/*                                                                      */
+/*    Steps are serialized into the DtwiMasterBatch command buffer, in  */
+/*    the tcb format of dtwi.h, as they are recorded. The program is    */
+/*    divided into operations: a transaction, from a start to its stop, */
+/*    or a wait between two transactions. Operations are numbered in    */
+/*    the order they are recorded, so the number of an operation is the */
+/*    value Cop returns just before it is started.                      */
+/*                                                                      */
+/*    Whole operations are packed into each call, up to the limits      */
+/*    below, and the calls are issued overlapped. The port stops a call */
+/*    at the first NAK, so every operation of that call reports the     */
+/*    error and those of the other calls are unaffected. FSplit ends a  */
+/*    call early, which gives an operation a result of its own. The     */
+/*    bytes read by each get are copied to the caller's buffers once    */
+/*    the program has been executed, for the operations that succeeded. */
+/*                                                                      */
+/*    If the port doesn't support DtwiMasterBatch, each transaction is  */
+/*    issued as an overlapped DtwiMasterPut, DtwiMasterGet or           */
+/*    DtwiMasterPutGet call, and the waits between transactions are     */
+/*    made by the host. Transactions that don't have one of those three */
+/*    forms fail with ercNotSupported on such a port.                   */
+/*                                                                      */
+/*    A batch may be executed any number of times. The data sent is     */
+/*    copied when a step is recorded, but the receive buffers must      */
+/*    remain valid until the batch is reset.                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(TWIBATCH_INCLUDED)
+#define      TWIBATCH_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Largest send and receive buffers passed to a single DtwiMasterBatch
+** call. An operation that is larger than this is sent in a call of its
+** own.
+*/
+const DWORD cbTbSndMax = 4096;
+const DWORD cbTbRcvMax = 4096;
+
+/* Largest count of a tcbPut, tcbGet or tcbWait command. Longer steps
+** are recorded as several commands.
+*/
+const DWORD cbTbCmdMax = 0xFFFF;
+
+/* Largest number of overlapped calls that FExecute keeps in flight,
+** and the time allowed for each one to complete.
+*/
+const DWORD ccallTbInFlightMax = 8;
+const DWORD tmsTbCallWait = 5000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Forms of a transaction that can be made with a single DTWI master
+** call, for ports that don't support DtwiMasterBatch.
+*/
+const DWORD tbfmNone        = 0;
+const DWORD tbfmPut         = 1;
+const DWORD tbfmGet         = 2;
+const DWORD tbfmPutGet      = 3;
+
+/* An operation is a transaction or a wait between two transactions.
+** The fields from tbfm to tusWait describe the transaction as a single
+** DTWI master call.
+*/
+typedef struct {
+    DWORD   ibSnd;          // offset of the commands in the send buffer
+    DWORD   cbSnd;          // size of the commands
+    DWORD   ibRcv;          // offset of the data read in the receive buffer
+    DWORD   cbRcv;          // number of bytes read
+    BOOL    fTrn;           // the operation is a transaction
+    BOOL    fSplit;         // a new call starts after the operation
+    DWORD   tbfm;           // form of the transaction, tbfmNone if it needs a batch
+    BYTE    dadr;           // slave address of the transaction
+    DWORD   ibPut;          // offset of the data written in the send buffer
+    DWORD   cbPut;          // number of bytes written
+    DWORD   tusWait;        // wait of the operation
+    ERC     erc;            // result of the last execution
+} TBOP;
+
+/* A scatter entry copies bytes read to a caller's buffer.
+*/
+typedef struct {
+    DWORD   ib;             // offset in the receive buffer
+    DWORD   cb;             // number of bytes
+    BYTE *  pbDst;          // destination
+    DWORD   iop;            // operation that read the bytes
+} TBSCAT;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class TwiBatch {
+
+private:
+    BYTE *      rgbSnd;
+    BYTE *      rgbRcv;
+    DWORD       cbSnd;
+    DWORD       cbSndMax;
+    DWORD       cbRcv;
+    DWORD       cbRcvMax;
+
+    TBOP *      rgop;
+    DWORD       cop;
+    DWORD       copMax;
+
+    TBSCAT *    rgscat;
+    DWORD       cscat;
+    DWORD       cscatMax;
+
+    BOOL        fOpen;          // a transaction is started and not stopped
+    BOOL        fRead;          // the last start of the transaction is a read
+    DWORD       tbph;           // form of the transaction so far
+    BOOL        fError;         // a step failed to be recorded
+    DWORD       ccallLast;      // calls made by the last FExecute
+
+    /* Operations of the calls in flight, oldest first.
+    */
+    DWORD       rgiopCallFirst[ccallTbInFlightMax];
+    DWORD       rgiopCallLim[ccallTbInFlightMax];
+    DWORD       icallOldest;
+    DWORD       ccallInFlight;
+
+    /* Capabilities of the port the last batch was executed on.
+    */
+    HIF         hifProps;
+    INT32       prtProps;
+    BOOL        fBatch;
+
+    BYTE *  PbCmdNew(BYTE tcb, DWORD cbData);
+    TBOP *  PopNew(BOOL fTrn);
+    BOOL    FAddWord(BYTE tcb, DWORD cw, const BYTE * rgbData);
+    BOOL    FGetProps(HIF hif, INT32 prt);
+    BOOL    FIssue(HIF hif, DWORD iopFirst, DWORD iopLim);
+    BOOL    FWaitCalls(HIF hif, DWORD ccallLeave);
+    void    SetErc(DWORD iopFirst, DWORD iopLim, ERC erc);
+
+    TwiBatch(const TwiBatch &);
+    TwiBatch & operator=(const TwiBatch &);
+
+public:
+    TwiBatch();
+    ~TwiBatch();
+
+    void    Reset();
+
+    BOOL    FStart(BYTE dadr, BOOL fReadReq);
+    BOOL    FPut(const BYTE * rgbSndReq, DWORD cb);
+    BOOL    FGet(BYTE * rgbRcvReq, DWORD cb);
+    BOOL    FStop();
+    BOOL    FWait(DWORD tus);
+    BOOL    FSplit();
+
+    BOOL    FWrite(BYTE dadr, const BYTE * rgbSndReq, DWORD cb);
+    BOOL    FRead(BYTE dadr, BYTE * rgbRcvReq, DWORD cb);
+    BOOL    FWriteRead(BYTE dadr, const BYTE * rgbSndReq, DWORD cbSndReq,
+                       DWORD tusWait, BYTE * rgbRcvReq, DWORD cbRcvReq);
+
+    BOOL    FExecute(HIF hif, INT32 prt = 0);
+
+    DWORD   Cop() const { return cop; }
+    ERC     ErcOp(DWORD iop) const { return rgop[iop].erc; }
+    DWORD   CbSend() const { return cbSnd; }
+    DWORD   CbReceive() const { return cbRcv; }
+    DWORD   CcallLast() const { return ccallLast; }
+};
+
+/* ------------------------------------------------------------ */
+/*                  Variable Declarations                       */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Declarations                      */
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+
+#endif                    // TWIBATCH_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,475 @@
+/************************************************************************/
+/*                                                                      */
+/*  TwiScan.cpp  --  Batched I2C bus scanner                            */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements the bus scanner declared in TwiScan.h.       */
+/*                                                                      */
+/*  The probes of all the addresses of a bus are recorded in one        */
+/*  TwiBatch and executed at once. Since each probe ends its call, the  */
+/*  result of an address is the result of its operation: no error if    */
+/*  the slave acknowledged, ercTwiAdrNak if it didn't. The slaves found */
+/*  are then read for the PEC check with a second batch.                */
+/*                                                                      */
+/*  Each bus is scanned by a thread of its own with a TwiBatch of its   */
+/*  own, since a batch keeps the bytes read in its own buffer. Only one */
+/*  thread uses each handle.                                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dtwi.h"
+#include "SmbPec.h"
+#include "TwiBatch.h"
+#include "TwiScan.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+/* Scan of one bus by a thread.
+*/
+typedef struct {
+    TwiScanner *    pscan;
+    TSBUS *         pbus;
+    BOOL            fOk;
+} TSJOB;
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static BOOL     FTwiBusErc(ERC erc);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    TwiScanner::TwiScanner
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Constructor. The probes are chosen automatically and the PEC
+**      isn't checked.
+*/
+TwiScanner::TwiScanner() {
+
+    memset(rgbus, 0, sizeof(rgbus));
+    cbus = 0;
+    tsp = tspAuto;
+    fPec = fFalse;
+    bPecCmd = 0;
+    cbPec = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FAddBus
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled on the port
+**      prt         - DTWI port that was enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if cbusTsMax buses have been added, or if the handle has
+**      already been added, since the overlapped calls of two threads
+**      on one handle would be mixed up.
+**
+**  Description:
+**      Add a bus to scan.
+*/
+BOOL
+TwiScanner::FAddBus( HIF hif, INT32 prt ) {
+
+    DWORD   ibus;
+
+    if ( cbusTsMax <= cbus ) {
+        return fFalse;
+    }
+
+    for ( ibus = 0; ibus < cbus; ibus++ ) {
+        if ( hif == rgbus[ibus].hif ) {
+            return fFalse;
+        }
+    }
+
+    memset(&rgbus[cbus], 0, sizeof(TSBUS));
+    rgbus[cbus].hif = hif;
+    rgbus[cbus].prt = prt;
+    cbus++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::SetProbe
+**
+**  Parameters:
+**      tspReq      - tspAuto, tspQuick or tspRead
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Choose how the addresses are probed.
+*/
+void
+TwiScanner::SetProbe( DWORD tspReq ) {
+
+    tsp = tspReq;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FSetPecCheck
+**
+**  Parameters:
+**      bCmd        - command code written to each slave found
+**      cb          - number of bytes read before the PEC, 0 for no check
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if cb is larger than cbTsPecMax.
+**
+**  Description:
+**      Check the PEC of the slaves found. The PEC checking of the port
+**      should be left disabled, so that the PEC is passed to the host.
+*/
+BOOL
+TwiScanner::FSetPecCheck( BYTE bCmd, DWORD cb ) {
+
+    if ( cbTsPecMax < cb ) {
+        return fFalse;
+    }
+
+    fPec = ( 0 != cb );
+    bPecCmd = bCmd;
+    cbPec = cb;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FScan
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue if every bus was scanned, fFalse otherwise
+**
+**  Errors:
+**      Fails if the scan of a bus fails; ercScan of that bus gives the
+**      reason. The other buses are still scanned.
+**
+**  Description:
+**      Scan every bus, each one in a thread of its own. A bus for which
+**      no thread can be started is scanned by the calling thread.
+*/
+BOOL
+TwiScanner::FScan() {
+
+    TSJOB       rgjob[cbusTsMax];
+    pthread_t   rgthr[cbusTsMax];
+    BOOL        rgfThr[cbusTsMax];
+    DWORD       ibus;
+    BOOL        fOk;
+
+    for ( ibus = 0; ibus < cbus; ibus++ ) {
+
+        rgjob[ibus].pscan = this;
+        rgjob[ibus].pbus = &rgbus[ibus];
+        rgjob[ibus].fOk = fFalse;
+
+        rgfThr[ibus] = ( 1 < cbus ) &&
+                       ( 0 == pthread_create(&rgthr[ibus], NULL, ScanThread, &rgjob[ibus]) );
+
+        if ( ! rgfThr[ibus] ) {
+            rgjob[ibus].fOk = FScanBus(&rgbus[ibus]);
+        }
+    }
+
+    fOk = fTrue;
+
+    for ( ibus = 0; ibus < cbus; ibus++ ) {
+
+        if ( rgfThr[ibus] ) {
+            pthread_join(rgthr[ibus], NULL);
+        }
+
+        if ( ! rgjob[ibus].fOk ) {
+            fOk = fFalse;
+        }
+    }
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::ScanThread
+**
+**  Parameters:
+**      pv          - scan of the bus
+**
+**  Return Values:
+**      NULL
+**
+**  Errors:
+**
+**  Description:
+**      Thread that scans one bus.
+*/
+void *
+TwiScanner::ScanThread( void * pv ) {
+
+    TSJOB * pjob = (TSJOB *)pv;
+
+    pjob->fOk = pjob->pscan->FScanBus(pjob->pbus);
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FScanBus
+**
+**  Parameters:
+**      pbus        - bus to scan
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the probes can't be recorded or a call doesn't complete.
+**
+**  Description:
+**      Probe every address of the bus with one batch, each probe in a
+**      call of its own, then check the PEC of the slaves found.
+*/
+BOOL
+TwiScanner::FScanBus( TSBUS * pbus ) {
+
+    TwiBatch    tb;
+    BYTE        rgbProbe[cdadrTs];
+    DWORD       rgiop[cdadrTs];
+    double      secStart;
+    DWORD       dadr;
+    BOOL        fOk;
+    ERC         erc;
+
+    secStart = SecNow();
+
+    memset(pbus->rgtsr, tsrNone, sizeof(pbus->rgtsr));
+    memset(pbus->rgtsc, tscNone, sizeof(pbus->rgtsc));
+    memset(pbus->rgerc, 0, sizeof(pbus->rgerc));
+    pbus->cpresent = 0;
+    pbus->ccall = 0;
+    pbus->ercScan = ercNoErc;
+
+    for ( dadr = dadrTsFirst; dadr <= dadrTsLast; dadr++ ) {
+
+        rgiop[dadr] = tb.Cop();
+
+        if ( FProbeRead((BYTE)dadr) ) {
+            fOk = tb.FRead((BYTE)dadr, &rgbProbe[dadr], 1);
+        }
+        else {
+            fOk = tb.FWrite((BYTE)dadr, NULL, 0);
+        }
+
+        if (( ! fOk ) || ( ! tb.FSplit() )) {
+
+            pbus->ercScan = ercInsufficientResources;
+            return fFalse;
+        }
+    }
+
+    /* FExecute fails whenever an address isn't acknowledged, so the
+    ** result of each probe is looked at instead.
+    */
+    tb.FExecute(pbus->hif, pbus->prt);
+    pbus->ccall = tb.CcallLast();
+
+    for ( dadr = dadrTsFirst; dadr <= dadrTsLast; dadr++ ) {
+
+        erc = tb.ErcOp(rgiop[dadr]);
+
+        if ( ercNoErc == erc ) {
+
+            pbus->rgtsr[dadr] = tsrPresent;
+            pbus->cpresent++;
+        }
+        else if ( ercTwiAdrNak == erc ) {
+            pbus->rgtsr[dadr] = tsrAbsent;
+        }
+        else {
+
+            pbus->rgtsr[dadr] = tsrError;
+            pbus->rgerc[dadr] = erc;
+
+            if (( ! FTwiBusErc(erc) ) && ( ercNoErc == pbus->ercScan )) {
+                pbus->ercScan = erc;
+            }
+        }
+    }
+
+    if (( ercNoErc == pbus->ercScan ) && ( fPec ) && ( 0 != pbus->cpresent )) {
+        FCheckPec(pbus);
+    }
+
+    pbus->secScan = SecNow() - secStart;
+
+    return ercNoErc == pbus->ercScan;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FCheckPec
+**
+**  Parameters:
+**      pbus        - bus that has been probed
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the reads can't be recorded or a call doesn't complete.
+**
+**  Description:
+**      Write the command code to each slave found and read cbPec bytes
+**      and the PEC after a repeated start, all with one batch, then
+**      check each PEC on the host.
+*/
+BOOL
+TwiScanner::FCheckPec( TSBUS * pbus ) {
+
+    TwiBatch    tb;
+    BYTE        rgbRcv[cdadrTs][cbTsPecMax + 1];
+    DWORD       rgiop[cdadrTs];
+    DWORD       dadr;
+    ERC         erc;
+
+    for ( dadr = dadrTsFirst; dadr <= dadrTsLast; dadr++ ) {
+
+        if ( tsrPresent != pbus->rgtsr[dadr] ) {
+            continue;
+        }
+
+        rgiop[dadr] = tb.Cop();
+
+        if (( ! tb.FWriteRead((BYTE)dadr, &bPecCmd, 1, 0, rgbRcv[dadr], cbPec + 1) ) ||
+            ( ! tb.FSplit() )) {
+
+            pbus->ercScan = ercInsufficientResources;
+            return fFalse;
+        }
+    }
+
+    tb.FExecute(pbus->hif, pbus->prt);
+    pbus->ccall += tb.CcallLast();
+
+    for ( dadr = dadrTsFirst; dadr <= dadrTsLast; dadr++ ) {
+
+        if ( tsrPresent != pbus->rgtsr[dadr] ) {
+            continue;
+        }
+
+        erc = tb.ErcOp(rgiop[dadr]);
+
+        if ( ercNoErc != erc ) {
+
+            pbus->rgtsc[dadr] = tscError;
+            pbus->rgerc[dadr] = erc;
+
+            if (( ! FTwiBusErc(erc) ) && ( ercNoErc == pbus->ercScan )) {
+                pbus->ercScan = erc;
+            }
+        }
+        else if ( FSmbPecReadValid((BYTE)dadr, &bPecCmd, 1, rgbRcv[dadr], cbPec + 1) ) {
+            pbus->rgtsc[dadr] = tscGood;
+        }
+        else {
+            pbus->rgtsc[dadr] = tscBad;
+        }
+    }
+
+    return ercNoErc == pbus->ercScan;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiScanner::FProbeRead
+**
+**  Parameters:
+**      dadr        - address to probe
+**
+**  Return Values:
+**      fTrue to probe with a read, fFalse to probe with a quick write
+**
+**  Errors:
+**
+**  Description:
+**      With tspAuto, 0x30 to 0x37 and 0x50 to 0x5F are read, as
+**      i2cdetect does: a quick write can lock the write protection of
+**      some EEPROMs.
+*/
+BOOL
+TwiScanner::FProbeRead( BYTE dadr ) const {
+
+    if ( tspAuto != tsp ) {
+        return tspRead == tsp;
+    }
+
+    return (( 0x30 <= dadr ) && ( 0x37 >= dadr )) ||
+           (( 0x50 <= dadr ) && ( 0x5F >= dadr ));
+}
+
+/* ------------------------------------------------------------ */
+/***    FTwiBusErc
+**
+**  Parameters:
+**      erc         - error code of a failed operation
+**
+**  Return Values:
+**      fTrue if the error happened on the bus, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      An error on the bus only fails the probe of one address. Any
+**      other error means the scan of the bus didn't complete.
+*/
+static BOOL
+FTwiBusErc( ERC erc ) {
+
+    return ( ercTwiBadBatchCmd <= erc ) && ( ercTwiSmbPecError >= erc );
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,137 @@
+/************************************************************************/
+/*                                                                      */
+/*    TwiScan.h  --    Interface Declarations for TwiScan.cpp           */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for an I2C   */
+/*    bus scanner. Every address from 0x08 to 0x77 is probed, and the   */
+/*    probes of a bus are recorded in one TwiBatch, so that they are    */
+/*    sent as overlapped DtwiMasterBatch calls instead of one blocking  */
+/*    DtwiMasterPut call per address. Each bus is scanned by a thread   */
+/*    of its own, so the scan of several devices takes about as long as */
+/*    the scan of one.                                                  */
+/*                                                                      */
+/*    The port stops a batch call at the first NAK, so each probe is    */
+/*    made a call of its own with TwiBatch::FSplit. The calls are still */
+/*    issued overlapped, several at a time.                             */
+/*                                                                      */
+/*    A probe is a quick write, a start and a stop with no data, or a   */
+/*    read of one byte. Like i2cdetect, the automatic choice reads the  */
+/*    addresses of EEPROMs and of some write only devices, which a      */
+/*    quick write may upset, and writes the others.                     */
+/*                                                                      */
+/*    The slaves that answer can then be checked for SMBus packet error */
+/*    checking. A command code is written and bytes are read back after */
+/*    a repeated start, one more than asked for, and the last one is    */
+/*    checked as the PEC with the SmbPec module.                        */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(TWISCAN_INCLUDED)
+#define      TWISCAN_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Range of addresses probed. The others are reserved by the I2C
+** specification.
+*/
+const BYTE  dadrTsFirst     = 0x08;
+const BYTE  dadrTsLast      = 0x77;
+const DWORD cdadrTs         = 128;
+
+/* Largest number of buses scanned at once, and largest number of
+** bytes read before the PEC, which is the longest SMBus block.
+*/
+const DWORD cbusTsMax       = 32;
+const DWORD cbTsPecMax      = 32;
+
+/* Kinds of probe.
+*/
+const DWORD tspAuto         = 0;
+const DWORD tspQuick        = 1;
+const DWORD tspRead         = 2;
+
+/* Result of the probe of an address.
+*/
+const BYTE  tsrNone         = 0;    // not probed
+const BYTE  tsrAbsent       = 1;    // address not acknowledged
+const BYTE  tsrPresent      = 2;    // address acknowledged
+const BYTE  tsrError        = 3;    // the probe failed, see rgerc
+
+/* Result of the PEC check of a slave that is present.
+*/
+const BYTE  tscNone         = 0;    // not checked
+const BYTE  tscGood         = 1;    // the PEC matches
+const BYTE  tscBad          = 2;    // the PEC doesn't match
+const BYTE  tscError        = 3;    // the read failed, see rgerc
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* A bus to scan and its results. ercScan is set when the scan couldn't
+** be completed, such as when a call didn't complete; the results of
+** the addresses that weren't reached are then tsrError.
+*/
+typedef struct {
+    HIF     hif;
+    INT32   prt;
+    BYTE    rgtsr[cdadrTs];
+    BYTE    rgtsc[cdadrTs];
+    ERC     rgerc[cdadrTs];
+    DWORD   cpresent;
+    DWORD   ccall;          // batch or master calls made
+    double  secScan;        // time taken, PEC checks included
+    ERC     ercScan;
+} TSBUS;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class TwiScanner {
+
+private:
+    TSBUS   rgbus[cbusTsMax];
+    DWORD   cbus;
+    DWORD   tsp;
+    BOOL    fPec;
+    BYTE    bPecCmd;
+    DWORD   cbPec;
+
+    BOOL    FScanBus(TSBUS * pbus);
+    BOOL    FCheckPec(TSBUS * pbus);
+    BOOL    FProbeRead(BYTE dadr) const;
+
+    static void *   ScanThread(void * pv);
+
+    TwiScanner(const TwiScanner &);
+    TwiScanner & operator=(const TwiScanner &);
+
+public:
+    TwiScanner();
+
+    BOOL    FAddBus(HIF hif, INT32 prt);
+    void    SetProbe(DWORD tspReq);
+    BOOL    FSetPecCheck(BYTE bCmd, DWORD cb);
+
+    BOOL    FScan();
+
+    DWORD           Cbus() const { return cbus; }
+    const TSBUS *   Pbus(DWORD ibus) const { return &rgbus[ibus]; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // TWISCAN_INCLUDED
+
+/************************************************************************/
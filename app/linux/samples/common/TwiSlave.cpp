@@ -0,0 +1,799 @@
+/************************************************************************/
+/*                                                                      */
+/*  TwiSlave.cpp  --  I2C slave emulation with the DTWI slave API       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements a service that emulates register based I2C   */
+/*  slaves on DTWI ports, using the slave buffers of the ports, and the */
+/*  register map that models each one.                                  */
+/*                                                                      */
+/*  A poll of a target costs two calls: DtwiSlaveRxRead, which returns  */
+/*  no bytes when nothing was written, and DtwiSlaveTxQuery, which      */
+/*  tells how much of the posted window masters have read. Bytes are    */
+/*  only posted when the window needs to be topped up or replaced, so   */
+/*  a quiet target costs nothing more than its polls, and the pacing    */
+/*  keeps those to a few hundred per second.                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dtwi.h"
+#include "TwiSlave.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static void     SleepUs(DWORD tus);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::TwiRegMap
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a map of read only registers that hold 0.
+*/
+TwiRegMap::TwiRegMap() {
+
+    memset(rgbReg, 0, sizeof(rgbReg));
+    memset(rgbWrMask, 0, sizeof(rgbWrMask));
+    fDirty = fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::BRead
+**
+**  Parameters:
+**      ireg        - register
+**
+**  Return Values:
+**      value returned to a master
+**
+**  Errors:
+**
+**  Description:
+**      Return the value of a register.
+*/
+BYTE
+TwiRegMap::BRead( BYTE ireg ) {
+
+    return rgbReg[ireg];
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::Write
+**
+**  Parameters:
+**      ireg        - register
+**      b           - value written by a master
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Change the writable bits of a register. The others keep their
+**      value.
+*/
+void
+TwiRegMap::Write( BYTE ireg, BYTE b ) {
+
+    rgbReg[ireg] = (rgbReg[ireg] & ~rgbWrMask[ireg]) | (b & rgbWrMask[ireg]);
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::SetReg
+**
+**  Parameters:
+**      ireg        - register
+**      b           - new value
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set a register from the host side, whatever its writable bits.
+*/
+void
+TwiRegMap::SetReg( BYTE ireg, BYTE b ) {
+
+    if ( b != rgbReg[ireg] ) {
+
+        rgbReg[ireg] = b;
+        fDirty = fTrue;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::SetWritable
+**
+**  Parameters:
+**      iregFirst   - first register
+**      creg        - number of registers
+**      bMask       - bits that masters may write
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set the bits of a range of registers that masters may write.
+**      The range wraps after the last register.
+*/
+void
+TwiRegMap::SetWritable( BYTE iregFirst, DWORD creg, BYTE bMask ) {
+
+    DWORD   ireg;
+
+    for ( ireg = 0; ireg < creg && ireg < cregTwsMap; ireg++ ) {
+        rgbWrMask[(iregFirst + ireg) % cregTwsMap] = bMask;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiRegMap::FTakeDirty
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue if SetReg changed a register since the last call
+**
+**  Errors:
+**
+**  Description:
+**      Find out whether the values posted for masters may be stale.
+*/
+BOOL
+TwiRegMap::FTakeDirty() {
+
+    BOOL    f;
+
+    f = fDirty;
+    fDirty = fFalse;
+
+    return f;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::TwiSlaveSvc
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a service without targets and with the default pacing.
+*/
+TwiSlaveSvc::TwiSlaveSvc() {
+
+    ctgt = 0;
+    itgtError = 0;
+    fRunning = fFalse;
+    fActive = fFalse;
+
+    cbWindowReq = cbTwsTxWindow;
+    tusSpin = tusTwsSpin;
+    tusIdleMin = tusTwsIdleMin;
+    tusIdleMax = tusTwsIdleMax;
+    tusIdle = tusIdleMin;
+    tusActiveLast = 0;
+
+    cpoll = 0;
+    csleep = 0;
+    tusSlept = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::~TwiSlaveSvc
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Stop the service if it is running.
+*/
+TwiSlaveSvc::~TwiSlaveSvc() {
+
+    if ( fRunning ) {
+        FStop();
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FAddTarget
+**
+**  Parameters:
+**      hif         - open handle with DTWI enabled on a slave port
+**      dadr        - 7 bit address the target answers to
+**      pmap        - registers of the target
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the service is running, ctgtTwsMax targets were added or
+**      the handle is already used by a target.
+**
+**  Description:
+**      Add a target to emulate. The register map must remain valid
+**      until the service is stopped.
+*/
+BOOL
+TwiSlaveSvc::FAddTarget( HIF hif, BYTE dadr, TwiRegMap * pmap ) {
+
+    TWSTGT *    ptgt;
+    DWORD       itgt;
+
+    if (( fRunning ) || ( ctgtTwsMax <= ctgt ) || ( 0x7F < dadr ) || ( NULL == pmap )) {
+        return fFalse;
+    }
+
+    for ( itgt = 0; itgt < ctgt; itgt++ ) {
+        if ( hif == rgtgt[itgt].hif ) {
+            return fFalse;
+        }
+    }
+
+    ptgt = &rgtgt[ctgt++];
+    memset(ptgt, 0, sizeof(TWSTGT));
+    ptgt->hif = hif;
+    ptgt->dadr = dadr;
+    ptgt->pmap = pmap;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::SetTxWindow
+**
+**  Parameters:
+**      cb          - number of registers to keep posted
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set how many registers ahead of the pointer are kept in the TX
+**      buffer. A larger window serves longer reads without the host,
+**      but costs more to replace after a write. It takes effect when
+**      the service is started.
+*/
+void
+TwiSlaveSvc::SetTxWindow( DWORD cb ) {
+
+    if ( 0 == cb ) {
+        cb = 1;
+    }
+
+    cbWindowReq = ( cregTwsMap < cb ) ? cregTwsMap : cb;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::SetPacing
+**
+**  Parameters:
+**      tusSpinReq      - time to poll without sleeping after activity
+**      tusIdleMinReq   - first sleep once the bus is quiet
+**      tusIdleMaxReq   - longest sleep
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Set the pacing of the polls. The longest sleep bounds the time
+**      a master waits for a target that has been idle.
+*/
+void
+TwiSlaveSvc::SetPacing( DWORD tusSpinReq, DWORD tusIdleMinReq, DWORD tusIdleMaxReq ) {
+
+    tusSpin = tusSpinReq;
+    tusIdleMin = ( 0 != tusIdleMinReq ) ? tusIdleMinReq : 1;
+    tusIdleMax = ( tusIdleMin < tusIdleMaxReq ) ? tusIdleMaxReq : tusIdleMin;
+    tusIdle = tusIdleMin;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FStart
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a port can't be enabled as a slave. ItgtError gives the
+**      target and the ports already enabled are disabled.
+**
+**  Description:
+**      Post the registers from 0 on for each target and enable its port
+**      as a slave. Posting first means that a read arriving as soon as
+**      the port is enabled is answered.
+*/
+BOOL
+TwiSlaveSvc::FStart() {
+
+    TWSTGT *    ptgt;
+    DWORD       itgt;
+    DWORD       cbTx;
+    DWORD       cbRx;
+    UINT64      tusNow;
+
+    if (( fRunning ) || ( 0 == ctgt )) {
+        return fFalse;
+    }
+
+    tusNow = TusNow();
+
+    for ( itgt = 0; itgt < ctgt; itgt++ ) {
+
+        ptgt = &rgtgt[itgt];
+        itgtError = itgt;
+
+        if ( ! DtwiSlaveQueryBuffer(ptgt->hif, &cbTx, &cbRx) ) {
+            goto lErrorExit;
+        }
+
+        ptgt->cbWindow = (( 0 != cbTx ) && ( cbTx < cbWindowReq )) ? cbTx : cbWindowReq;
+        ptgt->iregTx = 0;
+        ptgt->cbPosted = 0;
+        ptgt->tusPollLast = tusNow;
+        memset(&ptgt->stat, 0, sizeof(TWSSTAT));
+        ptgt->pmap->FTakeDirty();
+
+        if ( ! FPost(ptgt) ) {
+            goto lErrorExit;
+        }
+
+        /* The port acknowledges its address, as the target it emulates
+        ** does, and ignores the general call address.
+        */
+        if ( ! DtwiSlaveEnable(ptgt->hif, ptgt->dadr, fFalse, fTrue) ) {
+            goto lErrorExit;
+        }
+    }
+
+    fRunning = fTrue;
+    fActive = fFalse;
+    tusIdle = tusIdleMin;
+    tusActiveLast = tusNow;
+    cpoll = 0;
+    csleep = 0;
+    tusSlept = 0;
+
+    return fTrue;
+
+lErrorExit:
+
+    while ( 0 < itgt ) {
+        DtwiSlaveDisable(rgtgt[--itgt].hif);
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FPoll
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a DTWI call fails. ItgtError gives the target.
+**
+**  Description:
+**      Poll every target once: apply the writes received, account for
+**      the bytes read and bring the posted windows up to date.
+*/
+BOOL
+TwiSlaveSvc::FPoll() {
+
+    DWORD   itgt;
+
+    if ( ! fRunning ) {
+        return fFalse;
+    }
+
+    fActive = fFalse;
+    cpoll++;
+
+    for ( itgt = 0; itgt < ctgt; itgt++ ) {
+
+        if ( ! FPollTarget(itgt) ) {
+
+            itgtError = itgt;
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::Pace
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Wait before the next poll. There is no wait while the last
+**      activity is more recent than the spin time. After that the
+**      sleep doubles on each call, up to the longest sleep, and drops
+**      back to the first sleep when activity is seen again.
+*/
+void
+TwiSlaveSvc::Pace() {
+
+    UINT64  tusNow;
+
+    tusNow = TusNow();
+
+    if ( fActive ) {
+
+        tusActiveLast = tusNow;
+        tusIdle = tusIdleMin;
+        return;
+    }
+
+    if ( tusNow - tusActiveLast < tusSpin ) {
+        return;
+    }
+
+    SleepUs(tusIdle);
+    csleep++;
+    tusSlept += TusNow() - tusNow;
+
+    tusIdle = ( tusIdleMax / 2 < tusIdle ) ? tusIdleMax : 2 * tusIdle;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FRun
+**
+**  Parameters:
+**      tms         - time to serve the targets in milliseconds
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a poll fails.
+**
+**  Description:
+**      Poll and pace for the given time. Calling this in a loop that
+**      checks for a request to stop is the usual way to run the service.
+*/
+BOOL
+TwiSlaveSvc::FRun( DWORD tms ) {
+
+    UINT64  tusEnd;
+
+    tusEnd = TusNow() + (UINT64)tms * 1000;
+
+    do {
+
+        if ( ! FPoll() ) {
+            return fFalse;
+        }
+
+        Pace();
+
+    } while ( TusNow() < tusEnd );
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FStop
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a port can't be disabled. The others are still
+**      disabled.
+**
+**  Description:
+**      Stop answering on every port. The bytes left in the slave
+**      buffers are discarded by the ports.
+*/
+BOOL
+TwiSlaveSvc::FStop() {
+
+    DWORD   itgt;
+    BOOL    fOk;
+
+    if ( ! fRunning ) {
+        return fFalse;
+    }
+
+    fOk = fTrue;
+
+    for ( itgt = 0; itgt < ctgt; itgt++ ) {
+
+        if (( ! DtwiSlaveDisable(rgtgt[itgt].hif) ) && ( fOk )) {
+
+            itgtError = itgt;
+            fOk = fFalse;
+        }
+    }
+
+    fRunning = fFalse;
+
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FPollTarget
+**
+**  Parameters:
+**      itgt        - target to poll
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if a DTWI call fails.
+**
+**  Description:
+**      Read what masters wrote and find out how much of the window they
+**      read. The bytes read move the start of the window forward. A
+**      write, or a register changed by the host, replaces the window;
+**      otherwise it is topped up.
+*/
+BOOL
+TwiSlaveSvc::FPollTarget( DWORD itgt ) {
+
+    TWSTGT *    ptgt;
+    BYTE        rgbRx[cbTwsRxMax];
+    DWORD       cbRx;
+    DWORD       cbLeft;
+    DWORD       ib;
+    BYTE        ireg;
+    BOOL        fDirty;
+    UINT64      tusPoll;
+    DWORD       tusResp;
+    DWORD       tusGap;
+
+    ptgt = &rgtgt[itgt];
+    tusPoll = TusNow();
+
+    if ( ! DtwiSlaveRxRead(ptgt->hif, cbTwsRxMax, rgbRx, &cbRx, fFalse) ) {
+        return fFalse;
+    }
+
+    if ( ! DtwiSlaveTxQuery(ptgt->hif, &cbLeft) ) {
+        return fFalse;
+    }
+
+    if ( cbLeft > ptgt->cbPosted ) {
+        cbLeft = ptgt->cbPosted;
+    }
+
+    if ( cbLeft < ptgt->cbPosted ) {
+
+        ptgt->stat.cbRead += ptgt->cbPosted - cbLeft;
+        ptgt->iregTx = (BYTE)(ptgt->iregTx + ptgt->cbPosted - cbLeft);
+        ptgt->cbPosted = cbLeft;
+        fActive = fTrue;
+    }
+
+    fDirty = ptgt->pmap->FTakeDirty();
+
+    if ( 0 != cbRx ) {
+
+        /* The first byte is the register pointer, the others are
+        ** written from there on.
+        */
+        ireg = rgbRx[0];
+        for ( ib = 1; ib < cbRx; ib++ ) {
+            ptgt->pmap->WriteBus(ireg++, rgbRx[ib]);
+        }
+
+        ptgt->stat.cwrite++;
+        ptgt->stat.cbWrite += cbRx;
+        fActive = fTrue;
+
+        if (( 0 != ptgt->cbPosted ) && ( ! FFlush(ptgt) )) {
+            return fFalse;
+        }
+
+        ptgt->iregTx = ireg;
+    }
+    else if (( fDirty ) && ( 0 != ptgt->cbPosted )) {
+
+        if ( ! FFlush(ptgt) ) {
+            return fFalse;
+        }
+    }
+
+    if ( ! FPost(ptgt) ) {
+        return fFalse;
+    }
+
+    if ( 0 != cbRx ) {
+
+        tusResp = (DWORD)(TusNow() - tusPoll);
+        tusGap = (DWORD)(TusNow() - ptgt->tusPollLast);
+
+        if (( 0 == ptgt->stat.cresp ) || ( tusResp < ptgt->stat.tusRespMin )) {
+            ptgt->stat.tusRespMin = tusResp;
+        }
+        if ( tusResp > ptgt->stat.tusRespMax ) {
+            ptgt->stat.tusRespMax = tusResp;
+        }
+        if ( tusGap > ptgt->stat.tusGapMax ) {
+            ptgt->stat.tusGapMax = tusGap;
+        }
+
+        ptgt->stat.tusRespSum += tusResp;
+        ptgt->stat.cresp++;
+    }
+
+    ptgt->tusPollLast = tusPoll;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FPost
+**
+**  Parameters:
+**      ptgt        - target
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if DtwiSlaveTxPost fails.
+**
+**  Description:
+**      Fill the TX buffer up to the window with the registers that
+**      follow the ones already posted.
+*/
+BOOL
+TwiSlaveSvc::FPost( TWSTGT * ptgt ) {
+
+    BYTE    rgbTx[cregTwsMap];
+    DWORD   cb;
+    DWORD   ib;
+    BYTE    ireg;
+
+    if ( ptgt->cbPosted >= ptgt->cbWindow ) {
+        return fTrue;
+    }
+
+    cb = ptgt->cbWindow - ptgt->cbPosted;
+    ireg = (BYTE)(ptgt->iregTx + ptgt->cbPosted);
+
+    for ( ib = 0; ib < cb; ib++ ) {
+        rgbTx[ib] = ptgt->pmap->BReadBus(ireg++);
+    }
+
+    if ( ! DtwiSlaveTxPost(ptgt->hif, cb, rgbTx, fFalse) ) {
+        return fFalse;
+    }
+
+    ptgt->cbPosted += cb;
+    ptgt->stat.cpost++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    TwiSlaveSvc::FFlush
+**
+**  Parameters:
+**      ptgt        - target
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the port can't be disabled or enabled again.
+**
+**  Description:
+**      Discard the posted window. The port is enabled again the way
+**      FStart enables it, acknowledging its address. It doesn't answer
+**      to its address for the time of the two calls, so a master
+**      addressing it then gets a NAK and must try again.
+*/
+BOOL
+TwiSlaveSvc::FFlush( TWSTGT * ptgt ) {
+
+    if ( ! DtwiSlaveDisable(ptgt->hif) ) {
+        return fFalse;
+    }
+
+    if ( ! DtwiSlaveEnable(ptgt->hif, ptgt->dadr, fFalse, fTrue) ) {
+        return fFalse;
+    }
+
+    ptgt->cbPosted = 0;
+    ptgt->stat.cflush++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    SleepUs
+**
+**  Parameters:
+**      tus         - time to sleep in microseconds
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Sleep for at least the given time.
+*/
+static void
+SleepUs( DWORD tus ) {
+
+    struct timespec ts;
+
+    ts.tv_sec = tus / 1000000;
+    ts.tv_nsec = (tus % 1000000) * 1000;
+
+    while ( 0 != nanosleep(&ts, &ts) ) {
+    }
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,208 @@
+/************************************************************************/
+/*                                                                      */
+/*    TwiSlave.h  --    Interface Declarations for TwiSlave.cpp         */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for an I2C   */
+/*    slave emulation service. Each emulated target is a DTWI port      */
+/*    enabled as a slave with DtwiSlaveEnable, since a port answers to  */
+/*    a single address, and its registers are modelled by a TwiRegMap.  */
+/*                                                                      */
+/*    Targets follow the usual register convention: the first byte of a */
+/*    write sets the register pointer and the following bytes are       */
+/*    written from there, and a read returns the registers from the     */
+/*    pointer on. Both increment the pointer, which wraps after 0xFF.   */
+/*                                                                      */
+/*    The slave buffers of the port do all the bus work. The service    */
+/*    keeps a window of the registers that the next read would return   */
+/*    posted in the TX buffer with DtwiSlaveTxPost, so a read is        */
+/*    answered by the port without waiting for the host, and tops the   */
+/*    window up as masters consume it. A write that moves the pointer   */
+/*    makes the window stale: the port is disabled and enabled again,   */
+/*    which is the only way to empty its TX buffer, and the window is   */
+/*    posted again from the new pointer. A master that writes the       */
+/*    pointer and then reads must leave the service time to do this,    */
+/*    the response latency reported below.                              */
+/*                                                                      */
+/*    The RX buffer doesn't mark where a write ends, so the bytes       */
+/*    returned by one DtwiSlaveRxRead call are taken as one write.      */
+/*                                                                      */
+/*    Polling is adaptive. After any activity the targets are polled    */
+/*    back to back for a short spin time, so the next transaction of a  */
+/*    burst is seen at once. Once the bus has been quiet for that long  */
+/*    the service sleeps between polls, doubling the sleep up to a      */
+/*    limit, so idle targets cost almost no CPU time.                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(TWISLAVE_INCLUDED)
+#define      TWISLAVE_INCLUDED
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Number of registers of a target, and largest number of targets
+** served at once.
+*/
+const DWORD cregTwsMap      = 256;
+const DWORD ctgtTwsMax      = 8;
+
+/* Largest write read from the RX buffer in one call, and number of
+** registers kept posted in the TX buffer unless SetTxWindow is called.
+** The window is also limited to the size of the port's TX buffer.
+*/
+const DWORD cbTwsRxMax      = 256;
+const DWORD cbTwsTxWindow   = 16;
+
+/* Pacing used unless SetPacing is called: the time spent polling
+** without sleeping after activity, and the first and longest sleep
+** once the bus is quiet.
+*/
+const DWORD tusTwsSpin      = 2000;
+const DWORD tusTwsIdleMin   = 100;
+const DWORD tusTwsIdleMax   = 10000;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Activity and response times of one target. A response is the window
+** posted again after a write moved the register pointer. Its latency
+** is measured from the poll that found the write; the gap adds the
+** time since the poll before, when the write hadn't arrived, so it
+** bounds the time the master has to wait for the response.
+*/
+typedef struct {
+    DWORD   cwrite;         // writes received
+    DWORD   cbWrite;        // bytes written by masters
+    DWORD   cbRead;         // bytes read by masters
+    DWORD   cpost;          // DtwiSlaveTxPost calls
+    DWORD   cflush;         // windows discarded
+    DWORD   cresp;          // responses to writes
+    UINT64  tusRespSum;
+    DWORD   tusRespMin;
+    DWORD   tusRespMax;
+    DWORD   tusGapMax;
+} TWSSTAT;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Register map of an emulated target. Registers are read only unless
+** SetWritable makes bits of them writable by masters. A model with
+** registers that do more than hold a value, such as a status register
+** cleared by reading it, derives from this class and overrides BRead
+** or Write.
+*/
+class TwiRegMap {
+
+private:
+    BYTE    rgbReg[cregTwsMap];
+    BYTE    rgbWrMask[cregTwsMap];
+    BOOL    fDirty;
+
+    TwiRegMap(const TwiRegMap &);
+    TwiRegMap & operator=(const TwiRegMap &);
+
+protected:
+    /* Called by the service for each byte posted for masters to read,
+    ** which happens before the master reads it, and for each byte a
+    ** master wrote.
+    */
+    virtual BYTE    BRead(BYTE ireg);
+    virtual void    Write(BYTE ireg, BYTE b);
+
+public:
+    TwiRegMap();
+    virtual ~TwiRegMap() { }
+
+    BYTE    BReadBus(BYTE ireg) { return BRead(ireg); }
+    void    WriteBus(BYTE ireg, BYTE b) { Write(ireg, b); }
+
+    /* Change registers from the host side, such as a new measurement
+    ** of an emulated sensor. The posted window is replaced on the
+    ** next poll.
+    */
+    void    SetReg(BYTE ireg, BYTE b);
+    void    SetWritable(BYTE iregFirst, DWORD creg, BYTE bMask);
+    BYTE    BReg(BYTE ireg) const { return rgbReg[ireg]; }
+
+    BOOL    FTakeDirty();
+};
+
+/* State of a target kept by the service.
+*/
+typedef struct {
+    HIF         hif;
+    BYTE        dadr;
+    TwiRegMap * pmap;
+    BYTE        iregTx;         // register of the first byte in the TX buffer
+    DWORD       cbPosted;       // bytes in the TX buffer
+    DWORD       cbWindow;
+    UINT64      tusPollLast;
+    TWSSTAT     stat;
+} TWSTGT;
+
+class TwiSlaveSvc {
+
+private:
+    TWSTGT      rgtgt[ctgtTwsMax];
+    DWORD       ctgt;
+    DWORD       itgtError;
+    BOOL        fRunning;
+    BOOL        fActive;        // the last poll found activity
+
+    DWORD       cbWindowReq;
+    DWORD       tusSpin;
+    DWORD       tusIdleMin;
+    DWORD       tusIdleMax;
+    DWORD       tusIdle;        // next sleep
+    UINT64      tusActiveLast;
+
+    DWORD       cpoll;
+    DWORD       csleep;
+    UINT64      tusSlept;
+
+    BOOL    FPollTarget(DWORD itgt);
+    BOOL    FPost(TWSTGT * ptgt);
+    BOOL    FFlush(TWSTGT * ptgt);
+
+    TwiSlaveSvc(const TwiSlaveSvc &);
+    TwiSlaveSvc & operator=(const TwiSlaveSvc &);
+
+public:
+    TwiSlaveSvc();
+    ~TwiSlaveSvc();
+
+    BOOL    FAddTarget(HIF hif, BYTE dadr, TwiRegMap * pmap);
+    void    SetTxWindow(DWORD cb);
+    void    SetPacing(DWORD tusSpinReq, DWORD tusIdleMinReq, DWORD tusIdleMaxReq);
+
+    BOOL    FStart();
+    BOOL    FPoll();
+    void    Pace();
+    BOOL    FRun(DWORD tms);
+    BOOL    FStop();
+
+    DWORD           Ctgt() const { return ctgt; }
+    const TWSTGT *  Ptgt(DWORD itgt) const { return &rgtgt[itgt]; }
+    DWORD           ItgtError() const { return itgtError; }
+    DWORD           Cpoll() const { return cpoll; }
+    DWORD           Csleep() const { return csleep; }
+    UINT64          TusSlept() const { return tusSlept; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // TWISLAVE_INCLUDED
+
+/************************************************************************/
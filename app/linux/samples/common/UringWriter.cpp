@@ -0,0 +1,549 @@
+/************************************************************************/
+/*                                                                      */
+/*  UringWriter.cpp  --  Asynchronous file writer using io_uring        */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  This module implements an asynchronous file writer on top of the    */
+/*  raw io_uring system calls. The submission queue, completion queue   */
+/*  and submission queue entries are mapped into the process and        */
+/*  accessed with the acquire/release ordering required by the kernel.  */
+/*                                                                      */
+/*  The number of writes in flight never exceeds the submission queue   */
+/*  size, and the completion queue is twice that size, so completions   */
+/*  can never be lost to a completion queue overflow.                   */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+/* ------------------------------------------------------------ */
+/*                  Include File Definitions                    */
+/* ------------------------------------------------------------ */
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dpcdecl.h"
+#include "UringWriter.h"
+
+/* ------------------------------------------------------------ */
+/*                  Local Type Definitions                      */
+/* ------------------------------------------------------------ */
+
+#define PvOffset(pv, ib)    ((void *)((BYTE *)(pv) + (ib)))
+
+/* ------------------------------------------------------------ */
+/*                  Forward Declarations                        */
+/* ------------------------------------------------------------ */
+
+static int  IoUringSetup(unsigned cent, struct io_uring_params * pprm);
+static int  IoUringEnter(int fd, unsigned csub, unsigned cmin, unsigned flags);
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    UringWriter::UringWriter
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Construct a writer. FInit must be called before it can be used.
+*/
+UringWriter::UringWriter() {
+
+    fdRing = -1;
+    fUring = fFalse;
+    ciouDepth = 0;
+    ciouInFlight = 0;
+    ciouToSubmit = 0;
+
+    pvSqRing = MAP_FAILED;
+    cbSqRing = 0;
+    pvCqRing = MAP_FAILED;
+    cbCqRing = 0;
+    pvSqes = MAP_FAILED;
+    cbSqes = 0;
+
+    rgiocSync = NULL;
+    iiocSyncHead = 0;
+    ciocSync = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::~UringWriter
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Release the ring.
+*/
+UringWriter::~UringWriter() {
+
+    Term();
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::FInit
+**
+**  Parameters:
+**      ciou        - maximum number of writes in flight (1 - ciouMax)
+**      fAllowUring - use io_uring if the kernel supports it
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails only if ciou is out of range. Failure to set up io_uring
+**      selects the synchronous fallback, which FUsingUring reports.
+**
+**  Description:
+**      Prepare the writer for use.
+*/
+BOOL
+UringWriter::FInit( DWORD ciou, BOOL fAllowUring ) {
+
+    if (( 0 == ciou ) || ( ciouMax < ciou )) {
+        return fFalse;
+    }
+
+    Term();
+
+    if ( fAllowUring && FSetupRing(ciou) ) {
+
+        fUring = fTrue;
+    }
+    else {
+
+        ciouDepth = ciou;
+        rgiocSync = new IOCMP[ciou];
+        iiocSyncHead = 0;
+        ciocSync = 0;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::FSetupRing
+**
+**  Parameters:
+**      ciou    - number of submission queue entries
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if io_uring isn't available or the rings can't be mapped.
+**
+**  Description:
+**      Create the ring and map its queues.
+*/
+BOOL
+UringWriter::FSetupRing( DWORD ciou ) {
+
+    struct io_uring_params  prm;
+
+    memset(&prm, 0, sizeof(prm));
+
+    fdRing = IoUringSetup(ciou, &prm);
+    if ( 0 > fdRing ) {
+        return fFalse;
+    }
+
+    /* IORING_OP_WRITE was added together with IORING_FEAT_RW_CUR_POS.
+    ** Older kernels can't do plain writes, so use the fallback there.
+    */
+    if ( 0 == (prm.features & IORING_FEAT_RW_CUR_POS) ) {
+        goto lErrorExit;
+    }
+
+    cbSqRing = prm.sq_off.array + prm.sq_entries * sizeof(unsigned);
+    cbCqRing = prm.cq_off.cqes + prm.cq_entries * sizeof(struct io_uring_cqe);
+
+    /* Newer kernels map both rings with one mmap call.
+    */
+    if ( prm.features & IORING_FEAT_SINGLE_MMAP ) {
+
+        if ( cbCqRing > cbSqRing ) {
+            cbSqRing = cbCqRing;
+        }
+        cbCqRing = cbSqRing;
+    }
+
+    pvSqRing = mmap(NULL, cbSqRing, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_SQ_RING);
+    if ( MAP_FAILED == pvSqRing ) {
+        goto lErrorExit;
+    }
+
+    if ( prm.features & IORING_FEAT_SINGLE_MMAP ) {
+
+        pvCqRing = pvSqRing;
+    }
+    else {
+
+        pvCqRing = mmap(NULL, cbCqRing, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_CQ_RING);
+        if ( MAP_FAILED == pvCqRing ) {
+            goto lErrorExit;
+        }
+    }
+
+    cbSqes = prm.sq_entries * sizeof(struct io_uring_sqe);
+    pvSqes = mmap(NULL, cbSqes, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_SQES);
+    if ( MAP_FAILED == pvSqes ) {
+        goto lErrorExit;
+    }
+
+    pSqTail = (unsigned *)PvOffset(pvSqRing, prm.sq_off.tail);
+    pSqMask = (unsigned *)PvOffset(pvSqRing, prm.sq_off.ring_mask);
+    rgSqArray = (unsigned *)PvOffset(pvSqRing, prm.sq_off.array);
+    pCqHead = (unsigned *)PvOffset(pvCqRing, prm.cq_off.head);
+    pCqTail = (unsigned *)PvOffset(pvCqRing, prm.cq_off.tail);
+    pCqMask = (unsigned *)PvOffset(pvCqRing, prm.cq_off.ring_mask);
+    rgCqes = PvOffset(pvCqRing, prm.cq_off.cqes);
+
+    /* The kernel may round the queue size up. Never keep more writes in
+    ** flight than were asked for.
+    */
+    ciouDepth = ( ciou < prm.sq_entries ) ? ciou : prm.sq_entries;
+
+    return fTrue;
+
+lErrorExit:
+
+    Term();
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::Term
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Unmap and close the ring. Writes that are still in flight are
+**      completed by the kernel but their results are lost, so callers
+**      should reap everything before calling this.
+*/
+void
+UringWriter::Term() {
+
+    if ( MAP_FAILED != pvSqes ) {
+        munmap(pvSqes, cbSqes);
+    }
+
+    if (( MAP_FAILED != pvCqRing ) && ( pvCqRing != pvSqRing )) {
+        munmap(pvCqRing, cbCqRing);
+    }
+
+    if ( MAP_FAILED != pvSqRing ) {
+        munmap(pvSqRing, cbSqRing);
+    }
+
+    if ( 0 <= fdRing ) {
+        close(fdRing);
+    }
+
+    delete [] rgiocSync;
+
+    fdRing = -1;
+    fUring = fFalse;
+    ciouDepth = 0;
+    ciouInFlight = 0;
+    ciouToSubmit = 0;
+    pvSqRing = MAP_FAILED;
+    cbSqRing = 0;
+    pvCqRing = MAP_FAILED;
+    cbCqRing = 0;
+    pvSqes = MAP_FAILED;
+    cbSqes = 0;
+    rgiocSync = NULL;
+    iiocSyncHead = 0;
+    ciocSync = 0;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::FQueueWrite
+**
+**  Parameters:
+**      fd      - file to write to
+**      pb      - data to write, must stay valid until the write is reaped
+**      cb      - number of bytes to write
+**      ibFile  - file offset to write at
+**      pvUser  - value returned with the completion
+**
+**  Return Values:
+**      fTrue if the write was queued, fFalse if the queue is full
+**
+**  Errors:
+**
+**  Description:
+**      Queue a write. Queued writes are started by FSubmit. When the
+**      synchronous fallback is in use the write is performed right away
+**      and its completion is held until it is reaped.
+*/
+BOOL
+UringWriter::FQueueWrite( int fd, const BYTE * pb, DWORD cb, UINT64 ibFile, void * pvUser ) {
+
+    struct io_uring_sqe *   psqe;
+    unsigned                isqTail;
+    unsigned                isqe;
+    ssize_t                 cbWritten;
+
+    if ( ciouInFlight >= ciouDepth ) {
+        return fFalse;
+    }
+
+    if ( ! fUring ) {
+
+        cbWritten = pwrite(fd, pb, cb, (off_t)ibFile);
+
+        rgiocSync[(iiocSyncHead + ciocSync) % ciouDepth].pvUser = pvUser;
+        rgiocSync[(iiocSyncHead + ciocSync) % ciouDepth].res =
+            ( 0 <= cbWritten ) ? (INT32)cbWritten : -errno;
+        ciocSync++;
+        ciouInFlight++;
+
+        return fTrue;
+    }
+
+    /* Only this thread writes the tail, so it can be read plainly.
+    */
+    isqTail = *pSqTail;
+    isqe = isqTail & *pSqMask;
+
+    psqe = &((struct io_uring_sqe *)pvSqes)[isqe];
+    memset(psqe, 0, sizeof(*psqe));
+    psqe->opcode = IORING_OP_WRITE;
+    psqe->fd = fd;
+    psqe->addr = (unsigned long)pb;
+    psqe->len = cb;
+    psqe->off = ibFile;
+    psqe->user_data = (unsigned long)pvUser;
+
+    rgSqArray[isqe] = isqe;
+
+    /* Publish the entry before the new tail.
+    */
+    __atomic_store_n(pSqTail, isqTail + 1, __ATOMIC_RELEASE);
+
+    ciouToSubmit++;
+    ciouInFlight++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::FSubmit
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**      Fails if the kernel rejects the submission, or takes none of the
+**      writes while none of the earlier ones are in flight.
+**
+**  Description:
+**      Start all of the writes queued since the last call. The kernel
+**      may take only some of them, or none while its completion queue
+**      is full. The rest stay queued and are submitted by a later call,
+**      which FReap makes, once completions have been reaped; asking
+**      again at once would only spin.
+*/
+BOOL
+UringWriter::FSubmit() {
+
+    int     csub;
+
+    while ( fUring && ( 0 < ciouToSubmit )) {
+
+        csub = IoUringEnter(fdRing, ciouToSubmit, 0, 0);
+        if ( 0 < csub ) {
+            ciouToSubmit -= csub;
+            continue;
+        }
+
+        if ( 0 > csub ) {
+
+            if ( EINTR == errno ) {
+                continue;
+            }
+
+            if (( EAGAIN != errno ) && ( EBUSY != errno )) {
+                return fFalse;
+            }
+        }
+
+        /* Nothing was taken. Reaping frees room only if some writes
+        ** are already in flight.
+        */
+        if ( ciouInFlight == ciouToSubmit ) {
+            errno = EAGAIN;
+            return fFalse;
+        }
+
+        break;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    UringWriter::FReap
+**
+**  Parameters:
+**      pioc    - receives the completion
+**      fWait   - wait for a write to complete if none has
+**
+**  Return Values:
+**      fTrue if a completion was returned, fFalse otherwise
+**
+**  Errors:
+**      Returns fFalse when nothing is in flight, when fWait is fFalse
+**      and no write has completed, or if waiting fails.
+**
+**  Description:
+**      Collect the result of a completed write. Completions are returned
+**      in the order the writes complete, which need not be the order in
+**      which they were queued.
+*/
+BOOL
+UringWriter::FReap( IOCMP * pioc, BOOL fWait ) {
+
+    struct io_uring_cqe *   pcqe;
+    unsigned                icqHead;
+
+    if ( 0 == ciouInFlight ) {
+        return fFalse;
+    }
+
+    if ( ! fUring ) {
+
+        *pioc = rgiocSync[iiocSyncHead];
+        iiocSyncHead = (iiocSyncHead + 1) % ciouDepth;
+        ciocSync--;
+        ciouInFlight--;
+
+        return fTrue;
+    }
+
+    if ( ! FSubmit() ) {
+        return fFalse;
+    }
+
+    icqHead = *pCqHead;
+    while ( icqHead == __atomic_load_n(pCqTail, __ATOMIC_ACQUIRE) ) {
+
+        if ( ! fWait ) {
+            return fFalse;
+        }
+
+        if (( 0 > IoUringEnter(fdRing, 0, 1, IORING_ENTER_GETEVENTS) ) &&
+            ( EINTR != errno )) {
+            return fFalse;
+        }
+    }
+
+    pcqe = &((struct io_uring_cqe *)rgCqes)[icqHead & *pCqMask];
+    pioc->pvUser = (void *)(unsigned long)pcqe->user_data;
+    pioc->res = pcqe->res;
+
+    /* Hand the entry back to the kernel.
+    */
+    __atomic_store_n(pCqHead, icqHead + 1, __ATOMIC_RELEASE);
+
+    ciouInFlight--;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    IoUringSetup
+**
+**  Parameters:
+**      cent    - number of submission queue entries
+**      pprm    - ring parameters
+**
+**  Return Values:
+**      ring file descriptor, or -1 on failure
+**
+**  Errors:
+**
+**  Description:
+**      io_uring_setup system call.
+*/
+static int
+IoUringSetup( unsigned cent, struct io_uring_params * pprm ) {
+
+#if defined(__NR_io_uring_setup)
+    return (int)syscall(__NR_io_uring_setup, cent, pprm);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/* ------------------------------------------------------------ */
+/***    IoUringEnter
+**
+**  Parameters:
+**      fd      - ring file descriptor
+**      csub    - number of entries to submit
+**      cmin    - number of completions to wait for
+**      flags   - IORING_ENTER_* flags
+**
+**  Return Values:
+**      number of entries submitted, or -1 on failure
+**
+**  Errors:
+**
+**  Description:
+**      io_uring_enter system call.
+*/
+static int
+IoUringEnter( int fd, unsigned csub, unsigned cmin, unsigned flags ) {
+
+#if defined(__NR_io_uring_enter)
+    return (int)syscall(__NR_io_uring_enter, fd, csub, cmin, flags, NULL, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,111 @@
+/************************************************************************/
+/*                                                                      */
+/*    UringWriter.h  --    Interface Declarations for UringWriter.cpp   */
+/*                                                                      */
+/************************************************************************/
+/*  File Description:                                                   */
+/*                                                                      */
+/*    This header file contains the interface declarations for an       */
+/*    asynchronous file writer built on the Linux io_uring interface.   */
+/*    Writes are queued with FQueueWrite, handed to the kernel with     */
+/*    FSubmit and their results collected with FReap. Any number of     */
+/*    writes may be outstanding up to the queue depth given to FInit.   */
+/*                                                                      */
+/*    The io_uring system calls are used directly so that liburing     */
+/*    isn't required. If the kernel doesn't provide io_uring (or it has */
+/*    been disabled) the writer falls back to synchronous pwrite calls  */
+/*    behind the same interface.                                        */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#if !defined(URINGWRITER_INCLUDED)
+#define      URINGWRITER_INCLUDED
+
+#include <stddef.h>
+
+/* ------------------------------------------------------------ */
+/*                  Miscellaneous Declarations                  */
+/* ------------------------------------------------------------ */
+
+/* Largest queue depth accepted by FInit.
+*/
+const DWORD ciouMax = 4096;
+
+/* ------------------------------------------------------------ */
+/*                  General Type Declarations                   */
+/* ------------------------------------------------------------ */
+
+/* Completion of a queued write.
+*/
+typedef struct {
+    void *  pvUser;         // value passed to FQueueWrite
+    INT32   res;            // bytes written, or a negative errno value
+} IOCMP;
+
+/* ------------------------------------------------------------ */
+/*                  Object Class Declarations                   */
+/* ------------------------------------------------------------ */
+
+class UringWriter {
+
+private:
+    int         fdRing;
+    BOOL        fUring;
+    DWORD       ciouDepth;
+    DWORD       ciouInFlight;
+    DWORD       ciouToSubmit;
+
+    /* Shared ring mappings.
+    */
+    void *      pvSqRing;
+    size_t      cbSqRing;
+    void *      pvCqRing;
+    size_t      cbCqRing;
+    void *      pvSqes;
+    size_t      cbSqes;
+
+    unsigned *  pSqTail;
+    unsigned *  pSqMask;
+    unsigned *  rgSqArray;
+    unsigned *  pCqHead;
+    unsigned *  pCqTail;
+    unsigned *  pCqMask;
+    void *      rgCqes;
+
+    /* Completions of the synchronous fallback.
+    */
+    IOCMP *     rgiocSync;
+    DWORD       iiocSyncHead;
+    DWORD       ciocSync;
+
+    BOOL    FSetupRing(DWORD ciou);
+
+    UringWriter(const UringWriter &);
+    UringWriter & operator=(const UringWriter &);
+
+public:
+    UringWriter();
+    ~UringWriter();
+
+    BOOL    FInit(DWORD ciou, BOOL fAllowUring);
+    void    Term();
+
+    BOOL    FQueueWrite(int fd, const BYTE * pb, DWORD cb, UINT64 ibFile, void * pvUser);
+    BOOL    FSubmit();
+    BOOL    FReap(IOCMP * pioc, BOOL fWait);
+
+    DWORD   CiouInFlight() const { return ciouInFlight; }
+    DWORD   CiouDepth() const { return ciouDepth; }
+    BOOL    FUsingUring() const { return fUring; }
+};
+
+/* ------------------------------------------------------------ */
+
+#endif                    // URINGWRITER_INCLUDED
+
+/************************************************************************/
@@ -0,0 +1,501 @@
+/************************************************************************/
+/*                                                                      */
+/*  DeppI2cDemo.cpp  --  DeppI2cDemo main program                       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DeppI2cDemo reads the registers of an I2C slave through the     */
+/*  FIFO-fed I2C master of fpga/spi_top.vhd. Each read writes the       */
+/*  register number and reads the registers back after a repeated       */
+/*  start, as one transaction that the FPGA runs on its own: the        */
+/*  register number and both commands are written with one              */
+/*  DeppPutRegSet call and the bytes read are taken from the RX FIFO    */
+/*  with one DeppGetRegRepeat call. The bytes of the last read, the     */
+/*  time per read and the number of status reads needed per read are    */
+/*  reported.                                                           */
+/*                                                                      */
+/*  With -tune, the fastest SCL rate the slave tolerates is found first */
+/*  by DeppI2c::FFindFastest, and the outcome of each rate tried is     */
+/*  printed.                                                            */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent FPGA board with the spi_top design loaded, and an I2C    */
+/*  slave on pins 3 (SCL) and 4 (SDA) of JC, such as a PmodTMP2.        */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the -f and -tune options                          */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "depp.h"
+#include "DeppI2c.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-s           ", "7 bit address of the I2C slave (default 0x4B)"},
+    {"-p           ", "first register to read (default 0)"},
+    {"-n           ", "bytes per read (default 2)"},
+    {"-r           ", "number of reads (default 100)"},
+    {"-f           ", "SCL frequency in Hz (default 100000)"},
+    {"-tune        ", "find the fastest SCL rate the slave tolerates"},
+    {"-a           ", "address of the I2C registers (default 0x60)"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+BOOL    fTune;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+DWORD   dadr;
+DWORD   iregFirst;
+DWORD   cbRead;
+DWORD   cread;
+DWORD   frqReq;
+DWORD   regBase;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FRunTest(HIF hif);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DeppEnable(hif) ) {
+
+        printf("ERROR: unable to enable DEPP, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    fSuccess = FRunTest(hif);
+
+    DeppDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FRunTest
+**
+**  Parameters:
+**      hif     - device with DEPP enabled
+**
+**  Return Values:
+**      fTrue if every read succeeded, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the registers of the slave and report the time taken.
+*/
+BOOL
+FRunTest( HIF hif ) {
+
+    DeppI2c di2c;
+    DIRATE  rgrate[crateDi];
+    BYTE    rgbRcv[cbDiFifo];
+    BYTE    bReg;
+    DWORD   irate;
+    DWORD   iread;
+    DWORD   ib;
+    DWORD   cpoll;
+    DWORD   frqSet;
+    double  secStart;
+    double  secTotal;
+
+    di2c.Init(hif, (BYTE)regBase);
+
+    if ( ! di2c.FSetFrequency(frqReq, &frqSet) ) {
+
+        printf("ERROR: unable to set the SCL frequency, erc = %d\n", DmgrGetLastError());
+        return fFalse;
+    }
+
+    bReg = (BYTE)iregFirst;
+
+    if ( fTune ) {
+
+        if ( ! di2c.FFindFastest((BYTE)dadr, &bReg, 1, cbRead, 10, &frqSet, rgrate) ) {
+
+            printf("ERROR: unable to read slave 0x%02X at the slowest rate, status = 0x%02X\n",
+                   dadr, di2c.BStatLast());
+            return fFalse;
+        }
+
+        for ( irate = 0; irate < crateDi; irate++ ) {
+            printf("%8d Hz  %-4s  %d periods stretched\n", rgrate[irate].frq,
+                   rgrate[irate].fPass ? "pass" : "fail", rgrate[irate].cstretch);
+        }
+    }
+
+    printf("%d reads of %d bytes from register 0x%02X of slave 0x%02X at %d Hz\n",
+           cread, cbRead, iregFirst, dadr, frqSet);
+
+    cpoll = 0;
+
+    secStart = SecNow();
+
+    for ( iread = 0; iread < cread; iread++ ) {
+
+        if ( ! di2c.FWriteRead((BYTE)dadr, &bReg, 1, rgbRcv, cbRead) ) {
+
+            if ( 0 != ( di2c.BStatLast() & bDiNak )) {
+                printf("ERROR: slave 0x%02X didn't acknowledge\n", dadr);
+            }
+            else {
+                printf("ERROR: read %d failed, status = 0x%02X, erc = %d\n",
+                       iread, di2c.BStatLast(), DmgrGetLastError());
+            }
+            return fFalse;
+        }
+
+        cpoll += di2c.CpollLast();
+    }
+
+    secTotal = SecNow() - secStart;
+
+    printf("Registers:");
+    for ( ib = 0; ib < cbRead; ib++ ) {
+        printf(" %02X", rgbRcv[ib]);
+    }
+    printf("\n");
+
+    printf("%.3f s, %.3f ms per read, %.1f status reads per read\n", secTotal,
+           (1000.0 * secTotal) / (double)cread, (double)cpoll / (double)cread);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    fTune = fFalse;
+    dadr = 0x4B;
+    iregFirst = 0;
+    cbRead = 2;
+    cread = 100;
+    frqReq = 100000;
+    regBase = regDiBaseDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-s") ) {
+
+            if ( ! FParseNumber(szVal, "slave address", &dadr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-p") ) {
+
+            if ( ! FParseNumber(szVal, "register", &iregFirst) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-n") ) {
+
+            if ( ! FParseNumber(szVal, "byte count", &cbRead) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-r") ) {
+
+            if ( ! FParseNumber(szVal, "read count", &cread) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tune") ) {
+
+            fTune = fTrue;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-a") ) {
+
+            if ( ! FParseNumber(szVal, "address", &regBase) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    if (( 0x7F < dadr ) || ( 0xFF < iregFirst ) || ( 0 == cbRead ) ||
+        ( cbDiFifo < cbRead ) || ( 0 == cread ) || ( 0 == frqReq ) || ( 0xF4 < regBase )) {
+
+        printf("ERROR: invalid option value specified\n");
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
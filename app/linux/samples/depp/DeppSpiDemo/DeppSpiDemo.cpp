@@ -0,0 +1,553 @@
+/************************************************************************/
+/*                                                                      */
+/*  DeppSpiDemo.cpp  --  DeppSpiDemo main program                       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DeppSpiDemo sends frames through the FIFO-fed SPI master of     */
+/*  fpga/spi_top.vhd and checks the bytes received against the bytes    */
+/*  sent, with MOSI looped back to MISO. Each frame is written to the   */
+/*  TX FIFO with one DeppPutRegRepeat call and read back from the RX    */
+/*  FIFO with one DeppGetRegRepeat call. The throughput and the number  */
+/*  of status reads needed per frame are reported.                      */
+/*                                                                      */
+/*  When several slaves are given, each frame is started on every slave */
+/*  before the program waits for any of them, so that the SPI masters   */
+/*  of the slaves shift at the same time.                               */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent FPGA board with the spi_top design loaded, and a wire    */
+/*  between MOSI and MISO of each slave tested (pins 2 and 3 of the     */
+/*  Pmod row of the slave).                                             */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: added the -c and -f options                             */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "depp.h"
+#include "DeppSpi.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+/* Most slaves that fit in the register address space above 0x20.
+*/
+const   DWORD   cslaveMax = 14;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-m           ", "SPI mode, 0 to 3 (default 0)"},
+    {"-s           ", "speed setting, 0 to 7 (default 7)"},
+    {"-f           ", "SCLK frequency in Hz, instead of -s"},
+    {"-c           ", "number of slaves sent to at once (default 1)"},
+    {"-n           ", "bytes per transfer (default 512)"},
+    {"-r           ", "number of transfers (default 100)"},
+    {"-a           ", "address of the SPI registers (default 0x20)"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+DWORD   idMode;
+DWORD   ispeed;
+DWORD   frqReq;
+DWORD   cslave;
+DWORD   cbXfer;
+DWORD   cxfer;
+DWORD   regBase;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FRunTest(HIF hif);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DeppEnable(hif) ) {
+
+        printf("ERROR: unable to enable DEPP, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    fSuccess = FRunTest(hif);
+
+    DeppDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FRunTest
+**
+**  Parameters:
+**      hif     - device with DEPP enabled
+**
+**  Return Values:
+**      fTrue if every byte was received correctly, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Send the transfers and check the bytes looped back.
+*/
+BOOL
+FRunTest( HIF hif ) {
+
+    DeppSpi rgdspi[cslaveMax];
+    BYTE *  rgbSnd;
+    BYTE *  rgbRcv;
+    DWORD   islave;
+    DWORD   ixfer;
+    DWORD   ib;
+    DWORD   cb;
+    DWORD   cbBad;
+    DWORD   cpoll;
+    DWORD   cframe;
+    DWORD   frqSet;
+    DWORD   dwSeed;
+    double  secStart;
+    double  secTotal;
+    BOOL    fSuccess;
+
+    rgbSnd = (BYTE *)malloc(cbXfer);
+    rgbRcv = (BYTE *)malloc(cbXfer * cslave);
+    fSuccess = fFalse;
+
+    if (( NULL == rgbSnd ) || ( NULL == rgbRcv )) {
+
+        printf("ERROR: unable to allocate memory\n");
+        goto lErrorExit;
+    }
+
+    frqSet = FrqDsSpeed(ispeed);
+
+    for ( islave = 0; islave < cslave; islave++ ) {
+
+        rgdspi[islave].Init(hif, (BYTE)(regBase + islave * cregDsSlave));
+
+        if ( ! rgdspi[islave].FConfigure(idMode, ispeed) ) {
+
+            printf("ERROR: unable to configure the SPI master, erc = %d\n", DmgrGetLastError());
+            goto lErrorExit;
+        }
+
+        if (( 0 != frqReq ) && ! rgdspi[islave].FSetFrequency(frqReq, &frqSet) ) {
+
+            printf("ERROR: unable to set the SCLK frequency, erc = %d\n", DmgrGetLastError());
+            goto lErrorExit;
+        }
+    }
+
+    printf("SPI mode %d, %d Hz, %d transfers of %d bytes to %d slaves\n",
+           idMode, frqSet, cxfer, cbXfer, cslave);
+
+    dwSeed = 0x3A5C96E1;
+    cbBad = 0;
+    cpoll = 0;
+    cframe = 0;
+    secTotal = 0.0;
+
+    for ( ixfer = 0; ixfer < cxfer; ixfer++ ) {
+
+        for ( ib = 0; ib < cbXfer; ib++ ) {
+
+            dwSeed = dwSeed * 1103515245 + 12345;
+            rgbSnd[ib] = (BYTE)(dwSeed >> 16);
+        }
+
+        memset(rgbRcv, 0, cbXfer * cslave);
+
+        secStart = SecNow();
+
+        /* Start each frame on every slave before waiting for any of them.
+        */
+        for ( ib = 0; ib < cbXfer; ib += cb ) {
+
+            cb = ( cbDsFifo < cbXfer - ib ) ? cbDsFifo : cbXfer - ib;
+
+            for ( islave = 0; islave < cslave; islave++ ) {
+
+                if ( ! rgdspi[islave].FStartFrame(rgbSnd + ib, cb, fTrue) ) {
+
+                    printf("ERROR: transfer %d failed, erc = %d\n", ixfer, DmgrGetLastError());
+                    goto lErrorExit;
+                }
+            }
+
+            for ( islave = 0; islave < cslave; islave++ ) {
+
+                if ( ! rgdspi[islave].FEndFrame(rgbRcv + islave * cbXfer + ib) ) {
+
+                    printf("ERROR: transfer %d failed, erc = %d\n", ixfer, DmgrGetLastError());
+                    goto lErrorExit;
+                }
+
+                cpoll += rgdspi[islave].CpollLast();
+                cframe++;
+            }
+        }
+
+        secTotal += SecNow() - secStart;
+
+        for ( islave = 0; islave < cslave; islave++ ) {
+            for ( ib = 0; ib < cbXfer; ib++ ) {
+
+                if ( rgbSnd[ib] != rgbRcv[islave * cbXfer + ib] ) {
+                    cbBad++;
+                }
+            }
+        }
+    }
+
+    printf("%d bytes differ\n", cbBad);
+    printf("%.3f s, %.1f KB/s, %.1f status reads per frame\n", secTotal,
+           ((double)cxfer * cbXfer * cslave) / (1024.0 * secTotal),
+           (double)cpoll / (double)cframe);
+
+    fSuccess = ( 0 == cbBad );
+
+lErrorExit:
+
+    free(rgbSnd);
+    free(rgbRcv);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    idMode = 0;
+    ispeed = ispeedDsMax;
+    frqReq = 0;
+    cslave = 1;
+    cbXfer = cbDsFifo;
+    cxfer = 100;
+    regBase = regDsBaseDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-m") ) {
+
+            if ( ! FParseNumber(szVal, "mode", &idMode) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-s") ) {
+
+            if ( ! FParseNumber(szVal, "speed", &ispeed) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-c") ) {
+
+            if ( ! FParseNumber(szVal, "slave count", &cslave) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-n") ) {
+
+            if ( ! FParseNumber(szVal, "byte count", &cbXfer) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-r") ) {
+
+            if ( ! FParseNumber(szVal, "transfer count", &cxfer) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-a") ) {
+
+            if ( ! FParseNumber(szVal, "address", &regBase) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    if (( 3 < idMode ) || ( (DWORD)ispeedDsMax < ispeed ) || ( 0 == cbXfer ) ||
+        ( 0 == cxfer ) || ( 0 == cslave ) || ( cslaveMax < cslave ) ||
+        ( 0xF7 < regBase + (cslave - 1) * cregDsSlave )) {
+
+        printf("ERROR: invalid option value specified\n");
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,614 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgBitsBench.cpp  --  DjtgBitsBench main program                   */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgBitsBench measures the bit vector kernels of the JtgBits        */
+/*  module that prepare and check JTAG scans: building TMS/TDI pairs,   */
+/*  splitting them, reversing the bits of bitstream bytes and           */
+/*  comparing TDO under a mask. Every implementation the processor      */
+/*  supports is first checked against the scalar one on vectors of      */
+/*  many lengths and then timed on a long vector. No device is used.    */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  None.                                                               */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "JtgBits.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* Kernels that are measured.
+*/
+const   DWORD   jbkInterleave = 0;
+const   DWORD   jbkDeinterleave = 1;
+const   DWORD   jbkReverse = 2;
+const   DWORD   jbkCompare = 3;
+const   DWORD   jbkMax = 4;
+
+/* Default length of the timed vectors and number of passes over them,
+** and the longest vector used by the checks.
+*/
+const   DWORD   cbitBenchDefault = 64 * 1024 * 1024;
+const   DWORD   cpassBenchDefault = 8;
+const   DWORD   cbitCheckMax = 4096;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-cbit        ", "length of the timed vectors in bits"},
+    {"-cpass       ", "number of timed passes"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fShowHelp;
+
+char*   pszCmd;
+DWORD   cbitBench;
+DWORD   cpassBench;
+
+/* Names of the kernels.
+*/
+const char *    rgszJbk[jbkMax] = {
+    "interleave", "deinterleave", "reverse", "compare"
+};
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FCheck(DWORD jbimpl);
+BOOL    FBench();
+void    RunKernel(DWORD jbk, DWORD jbimpl, BYTE * rgbA, BYTE * rgbB,
+                  BYTE * rgbC, BYTE * rgbPairs, DWORD cbit);
+void    FillRandom(BYTE * rgb, DWORD cb);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    DWORD   jbimpl;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    if (( 0 == cbitBench ) || ( 0 == cpassBench )) {
+
+        printf("ERROR: the vector length and pass count must not be 0\n");
+        return 1;
+    }
+
+    printf("best implementation: %s\n\n", SzJbImpl(JbimplBest()));
+
+    for ( jbimpl = jbimplScalar; jbimpl < jbimplMax; jbimpl++ ) {
+
+        if ( FJbImplSupported(jbimpl) && ( ! FCheck(jbimpl) ) ) {
+            return 1;
+        }
+    }
+
+    return FBench() ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCheck
+**
+**  Parameters:
+**      jbimpl  - implementation to check
+**
+**  Return Values:
+**      fTrue if the implementation gives the expected results
+**
+**  Errors:
+**
+**  Description:
+**      Run the kernels of an implementation on random vectors of every
+**      length up to cbitCheckMax bits, with and without a TMS vector,
+**      and compare the results with ones built a bit at a time. The
+**      byte after each output is checked to be left alone.
+*/
+BOOL
+FCheck( DWORD jbimpl ) {
+
+    static BYTE rgbTms[cbitCheckMax / 8 + 1];
+    static BYTE rgbTdi[cbitCheckMax / 8 + 1];
+    static BYTE rgbMask[cbitCheckMax / 8 + 1];
+    static BYTE rgbExp[cbitCheckMax / 4 + 1];
+    static BYTE rgbOut[cbitCheckMax / 4 + 1];
+    static BYTE rgbOut2[cbitCheckMax / 8 + 1];
+    DWORD       cbit;
+    DWORD       cb;
+    DWORD       cbPairs;
+    DWORD       ibit;
+    DWORD       ib;
+    BOOL        fTms;
+    BOOL        fOk;
+
+    for ( cbit = 0; cbit <= cbitCheckMax; cbit++ ) {
+
+        cb = (cbit + 7) / 8;
+        cbPairs = (2 * cbit + 7) / 8;
+        fTms = ( 0 != cbit % 3 );
+
+        FillRandom(rgbTms, cb);
+        FillRandom(rgbTdi, cb);
+        FillRandom(rgbMask, cb);
+
+        memset(rgbExp, 0, sizeof(rgbExp));
+        for ( ibit = 0; ibit < cbit; ibit++ ) {
+
+            rgbExp[ibit / 4] |= ((rgbTdi[ibit / 8] >> (ibit % 8)) & 1) << (2 * (ibit % 4));
+            if ( fTms ) {
+                rgbExp[ibit / 4] |= ((rgbTms[ibit / 8] >> (ibit % 8)) & 1) << (2 * (ibit % 4) + 1);
+            }
+        }
+
+        /* Interleave.
+        */
+        memset(rgbOut, 0xA5, sizeof(rgbOut));
+        JbInterleaveImpl(jbimpl, fTms ? rgbTms : NULL, rgbTdi, rgbOut, cbit);
+        fOk = ( 0 == memcmp(rgbOut, rgbExp, cbPairs) ) && ( 0xA5 == rgbOut[cbPairs] );
+
+        /* Deinterleave, TDI only, and check the bits past the end.
+        */
+        memset(rgbOut2, 0xA5, sizeof(rgbOut2));
+        JbDeinterleaveImpl(jbimpl, rgbExp, NULL, rgbOut2, cbit);
+        fOk = fOk && ( 0xA5 == rgbOut2[cb] );
+        if (( 0 != cbit % 8 ) && ( 0 != (rgbOut2[cbit / 8] >> (cbit % 8)) )) {
+            fOk = fFalse;
+        }
+        fOk = fOk && FJbMaskedEqualImpl(jbimplScalar, rgbOut2, rgbTdi, NULL, cbit);
+
+        /* Reverse, then reverse again.
+        */
+        memset(rgbOut2, 0xA5, sizeof(rgbOut2));
+        JbReverseImpl(jbimpl, rgbOut2, rgbTms, cb);
+        for ( ib = 0; ib < cb; ib++ ) {
+            for ( ibit = 0; ibit < 8; ibit++ ) {
+                if ((( rgbOut2[ib] >> ibit ) & 1 ) != (( rgbTms[ib] >> (7 - ibit) ) & 1 )) {
+                    fOk = fFalse;
+                }
+            }
+        }
+        fOk = fOk && ( 0xA5 == rgbOut2[cb] );
+
+        /* Compare equal vectors, then vectors that differ in one bit.
+        */
+        memcpy(rgbOut2, rgbTdi, cb);
+        fOk = fOk && FJbMaskedEqualImpl(jbimpl, rgbOut2, rgbTdi, rgbMask, cbit);
+
+        if ( 0 < cbit ) {
+
+            ibit = rand() % cbit;
+            rgbOut2[ibit / 8] ^= 1 << (ibit % 8);
+
+            if ( FJbMaskedEqualImpl(jbimpl, rgbOut2, rgbTdi, rgbMask, cbit) !=
+                 ( 0 == (rgbMask[ibit / 8] & (1 << (ibit % 8))) ) ) {
+                fOk = fFalse;
+            }
+            if ( FJbMaskedEqualImpl(jbimpl, rgbOut2, rgbTdi, NULL, cbit) ) {
+                fOk = fFalse;
+            }
+        }
+
+        if ( ! fOk ) {
+
+            printf("ERROR: %s kernels failed with %u bit vectors\n", SzJbImpl(jbimpl), cbit);
+            return fFalse;
+        }
+    }
+
+    printf("%-8s checked up to %u bits\n", SzJbImpl(jbimpl), cbitCheckMax);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FBench
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Time each kernel of each implementation the processor supports
+**      on vectors of cbitBench bits. The rate is in bits of the longest
+**      vector a kernel reads or writes: pairs for interleave and
+**      deinterleave, and the vector itself for reverse and compare.
+*/
+BOOL
+FBench() {
+
+    BYTE *  rgbA;
+    BYTE *  rgbB;
+    BYTE *  rgbC;
+    BYTE *  rgbPairs;
+    DWORD   cb;
+    DWORD   jbk;
+    DWORD   jbimpl;
+    DWORD   ipass;
+    double  cbitRate;
+    double  secStart;
+    double  secTotal;
+    BOOL    fSuccess;
+
+    fSuccess = fFalse;
+    cb = (cbitBench + 7) / 8;
+
+    rgbA = (BYTE *)malloc(cb);
+    rgbB = (BYTE *)malloc(cb);
+    rgbC = (BYTE *)malloc(cb);
+    rgbPairs = (BYTE *)malloc(2 * cb);
+
+    if (( NULL == rgbA ) || ( NULL == rgbB ) || ( NULL == rgbC ) || ( NULL == rgbPairs )) {
+
+        printf("ERROR: unable to allocate benchmark buffers\n");
+        goto lExit;
+    }
+
+    FillRandom(rgbA, cb);
+    FillRandom(rgbB, cb);
+    memset(rgbC, 0xFF, cb);
+    JbInterleaveImpl(jbimplScalar, rgbA, rgbB, rgbPairs, cbitBench);
+
+    printf("\n%u bit vectors, %u passes\n\n", cbitBench, cpassBench);
+
+    for ( jbk = 0; jbk < jbkMax; jbk++ ) {
+
+        cbitRate = ( jbk <= jbkDeinterleave ) ? 2.0 * cbitBench : cbitBench;
+
+        for ( jbimpl = jbimplScalar; jbimpl < jbimplMax; jbimpl++ ) {
+
+            if ( ! FJbImplSupported(jbimpl) ) {
+
+                printf("%-12s %-8s not supported by this processor\n", rgszJbk[jbk], SzJbImpl(jbimpl));
+                continue;
+            }
+
+            /* One untimed pass to fault the pages in and warm the caches.
+            */
+            RunKernel(jbk, jbimpl, rgbA, rgbB, rgbC, rgbPairs, cbitBench);
+
+            secStart = SecNow();
+            for ( ipass = 0; ipass < cpassBench; ipass++ ) {
+                RunKernel(jbk, jbimpl, rgbA, rgbB, rgbC, rgbPairs, cbitBench);
+            }
+            secTotal = SecNow() - secStart;
+
+            printf("%-12s %-8s %8.2f Gbit/s\n", rgszJbk[jbk], SzJbImpl(jbimpl),
+                   (cbitRate * cpassBench) / (secTotal * 1000000000.0));
+        }
+    }
+
+    fSuccess = fTrue;
+
+lExit:
+
+    free(rgbA);
+    free(rgbB);
+    free(rgbC);
+    free(rgbPairs);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    RunKernel
+**
+**  Parameters:
+**      jbk         - kernel to run
+**      jbimpl      - implementation to use
+**      rgbA        - TMS, or the first vector to compare
+**      rgbB        - TDI, or the second vector to compare
+**      rgbC        - output of deinterleave and reverse, compare mask
+**      rgbPairs    - TMS/TDI pairs
+**      cbit        - length of the vectors in bits
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Run one pass of a kernel. The pairs are left as built from rgbA
+**      and rgbB so that every pass does the same work, and a compare
+**      of equal vectors reads them to the end.
+*/
+void
+RunKernel( DWORD jbk, DWORD jbimpl, BYTE * rgbA, BYTE * rgbB, BYTE * rgbC,
+           BYTE * rgbPairs, DWORD cbit ) {
+
+    switch ( jbk ) {
+        case jbkInterleave:
+            JbInterleaveImpl(jbimpl, rgbA, rgbB, rgbPairs, cbit);
+            break;
+
+        case jbkDeinterleave:
+            JbDeinterleaveImpl(jbimpl, rgbPairs, rgbC, rgbC, cbit);
+            break;
+
+        case jbkReverse:
+            JbReverseImpl(jbimpl, rgbC, rgbA, (cbit + 7) / 8);
+            break;
+
+        default:
+            if ( ! FJbMaskedEqualImpl(jbimpl, rgbA, rgbA, rgbB, cbit) ) {
+                printf("ERROR: equal vectors compared as different\n");
+            }
+            break;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FillRandom
+**
+**  Parameters:
+**      rgb     - buffer to fill
+**      cb      - size of the buffer
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Fill a buffer with pseudo random bytes.
+*/
+void
+FillRandom( BYTE * rgb, DWORD cb ) {
+
+    DWORD   ib;
+
+    for ( ib = 0; ib < cb; ib++ ) {
+        rgb[ib] = (BYTE)(rand() >> 7);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fShowHelp = fFalse;
+    cbitBench = cbitBenchDefault;
+    cpassBench = cpassBenchDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-cbit") ) {
+
+            if ( ! FParseNumber(szVal, "vector length", &cbitBench) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-cpass") ) {
+
+            if ( ! FParseNumber(szVal, "pass count", &cpassBench) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,527 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgBscan.cpp  --  DjtgBscan main program                           */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgBscan watches the pins of a device on the JTAG port of a        */
+/*  Digilent device through the device's boundary scan register, using  */
+/*  the SAMPLE instruction, so nothing needs to be loaded into the      */
+/*  device. The pins are named from the device's BSDL file. It prints   */
+/*  the value of every watched pin at the start and then a line each    */
+/*  time a pin changes, and ends with the number of frames read.        */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a JTAG port connected to a scan chain that   */
+/*  holds a device with a BSDL file.                                    */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgBits.h"
+#include "JtgTap.h"
+#include "JtgBscan.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 260;
+const   DWORD   cchPinListMax = 1024;
+
+/* Time to watch the pins when "-t" isn't given, and the frequency
+** asked for when "-f" isn't given, which gets the fastest TCK the
+** device supports.
+*/
+const   DWORD   csecWatchDefault = 10;
+const   DWORD   frqFastest = 0xFFFFFFFF;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-bsdl        ", "BSDL file of the device to watch"},
+    {"-pins        ", "pins to watch, separated by commas (default all)"},
+    {"-t           ", "seconds to watch the pins (default 10)"},
+    {"-f           ", "TCK frequency in Hz (default the fastest)"},
+    {"-hir, -tir   ", "IR bits after and before the device"},
+    {"-hdr, -tdr   ", "bypass bits after and before the device"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szBsdl[cchFileMax + 1];
+char    szPins[cchPinListMax + 1];
+DWORD   csecWatch;
+DWORD   frqReq;
+BSCHAIN chnReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FWatch(JtgBscan * pbs);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF         hif;
+    JtgBscan    bs;
+    DWORD       frqSet;
+    BOOL        fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string
+    ** and a BSDL file.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( '\0' == szBsdl[0] ) {
+
+        printf("ERROR: you must specify a BSDL file using the \"-bsdl\" option\n");
+        return 1;
+    }
+
+    /* Read the BSDL file before opening the device, so that a mistake in
+    ** the file or the pin list is reported without touching the chain.
+    */
+    if (( ! bs.FLoadBsdl(szBsdl) ) || ( ! bs.FWatch(szPins) )) {
+
+        printf("ERROR: %s\n", bs.SzError());
+        return 1;
+    }
+
+    printf("%s: IR %u bits, SAMPLE 0x%X, boundary register %u bits, %u pins\n",
+           bs.SzEntity(), bs.CbitIr(), bs.IrSample(), bs.CbitBsr(), bs.Cpin());
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( ! DjtgSetSpeed(hif, frqReq, &frqSet) ) {
+
+        printf("ERROR: DjtgSetSpeed failed, erc = %d\n", DmgrGetLastError());
+        goto lDisableExit;
+    }
+
+    printf("TCK %u Hz\n", frqSet);
+
+    if ( ! bs.FInit(hif, &chnReq) ) {
+
+        printf("ERROR: %s\n", bs.SzError());
+        goto lDisableExit;
+    }
+
+    fSuccess = FWatch(&bs);
+
+    if ( ! bs.FEnd() ) {
+
+        if ( fSuccess ) {
+            printf("ERROR: %s\n", bs.SzError());
+        }
+        fSuccess = fFalse;
+    }
+
+lDisableExit:
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FWatch
+**
+**  Parameters:
+**      pbs     - started pin monitor
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Poll the monitor for the time given with "-t", printing each
+**      change as the time since the first frame, the pin and its new
+**      value, then print the number of frames and the frame rate.
+*/
+BOOL
+FWatch( JtgBscan * pbs ) {
+
+    BSEVT *     rgevt;
+    DWORD       cevt;
+    DWORD       ievt;
+    double      secStart;
+    double      secNow;
+    BOOL        fSuccess;
+
+    rgevt = (BSEVT *)malloc(pbs->Cpin() * sizeof(BSEVT));
+    if ( NULL == rgevt ) {
+
+        printf("ERROR: out of memory\n");
+        return fFalse;
+    }
+
+    fSuccess = fTrue;
+    secStart = SecNow();
+    secNow = secStart;
+
+    do {
+
+        if ( ! pbs->FPoll(rgevt, &cevt) ) {
+
+            printf("ERROR: %s\n", pbs->SzError());
+            fSuccess = fFalse;
+            break;
+        }
+
+        for ( ievt = 0; ievt < cevt; ievt++ ) {
+
+            printf("%12.6f  %-24s %u\n", rgevt[ievt].sec - secStart,
+                   pbs->Ppin(rgevt[ievt].ipin)->szName, rgevt[ievt].fValue);
+        }
+
+        secNow = SecNow();
+
+    } while ( secNow - secStart < (double)csecWatch );
+
+    free(rgevt);
+
+    printf("%u frames in %.3f s, %.0f frames/s\n", pbs->Cframe(),
+           secNow - secStart, (double)pbs->Cframe() / (secNow - secStart));
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    szBsdl[0] = '\0';
+    szPins[0] = '\0';
+    csecWatch = csecWatchDefault;
+    frqReq = frqFastest;
+    memset(&chnReq, 0, sizeof(BSCHAIN));
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-bsdl") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szBsdl, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-pins") ) {
+
+            if (( NULL == szVal ) || ( cchPinListMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid pin list specified\n");
+                return fFalse;
+            }
+
+            strcpy(szPins, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-t") ) {
+
+            if ( ! FParseNumber(szVal, "time", &csecWatch) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hir") ) {
+
+            if ( ! FParseNumber(szVal, "header IR length", &chnReq.cbitHir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tir") ) {
+
+            if ( ! FParseNumber(szVal, "trailer IR length", &chnReq.cbitTir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hdr") ) {
+
+            if ( ! FParseNumber(szVal, "header DR length", &chnReq.cbitHdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tdr") ) {
+
+            if ( ! FParseNumber(szVal, "trailer DR length", &chnReq.cbitTdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> -bsdl <file> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,566 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgCfg.cpp  --  DjtgCfg main program                               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgCfg configures a Xilinx FPGA on the JTAG port of a Digilent     */
+/*  device from a .bit or .bin file. It prints the time spent clearing  */
+/*  the device, reversing the data, loading it and starting the device, */
+/*  and compares the load rate with the TCK frequency. The device must  */
+/*  report DONE through its IR capture value for the load to succeed.   */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a JTAG port connected to a scan chain that   */
+/*  holds a Xilinx FPGA.                                                */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgCfg.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 260;
+
+/* Largest file that is loaded.
+*/
+const   DWORD   cbFileMax = 256 * 1024 * 1024;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-bit         ", ".bit or .bin file to load"},
+    {"-f           ", "TCK frequency in Hz"},
+    {"-irlen       ", "IR length of the FPGA (default 6)"},
+    {"-hir, -tir   ", "IR bits after and before the FPGA"},
+    {"-hdr, -tdr   ", "bypass bits after and before the FPGA"},
+    {"-chunk       ", "bytes per DjtgPutTdiBits call"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+DWORD   frqReq;
+DWORD   cbChunkReq;
+CFGCHAIN    chnReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FLoad(HIF hif);
+BYTE *  PbReadFile(DWORD * pcb);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    DWORD   frqSet;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string
+    ** and a file to load.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( '\0' == szFile[0] ) {
+
+        printf("ERROR: you must specify a file using the \"-bit\" option\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( 0 != frqReq ) {
+
+        if ( ! DjtgSetSpeed(hif, frqReq, &frqSet) ) {
+
+            printf("ERROR: DjtgSetSpeed failed, erc = %d\n", DmgrGetLastError());
+            goto lDisableExit;
+        }
+    }
+
+    fSuccess = FLoad(hif);
+
+lDisableExit:
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FLoad
+**
+**  Parameters:
+**      hif     - device with DJTG enabled
+**
+**  Return Values:
+**      fTrue if the FPGA was configured, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the file, configure the FPGA and print the time spent on
+**      each phase.
+*/
+BOOL
+FLoad( HIF hif ) {
+
+    JtgCfg      cfg;
+    CFGIMG      img;
+    CFGSTATS    cfs;
+    BYTE *      pb;
+    DWORD       cb;
+    double      secTotal;
+    BOOL        fSuccess;
+
+    pb = PbReadFile(&cb);
+    if ( NULL == pb ) {
+        return fFalse;
+    }
+
+    fSuccess = fFalse;
+
+    if ( ! FCfgParseImage(pb, cb, &img) ) {
+
+        printf("ERROR: \"%s\" isn't a valid .bit or .bin file\n", szFile);
+        goto lExit;
+    }
+
+    if ( NULL != img.szDesign ) {
+        printf("design %s\npart %s, built %s %s\n", img.szDesign, img.szPart, img.szDate, img.szTime);
+    }
+
+    if ( ! cfg.FInit(hif, &chnReq) ) {
+
+        printf("ERROR: %s\n", cfg.SzError());
+        goto lExit;
+    }
+
+    cfg.SetChunk(cbChunkReq);
+
+    printf("loading %u bytes at %u Hz in %u byte chunks\n", img.cbData, cfg.FrqTck(), cfg.CbChunk());
+
+    fSuccess = cfg.FConfigure(img.pbData, img.cbData, &cfs);
+
+    printf("\n  %-8s  %10.3f s\n", "clear", cfs.secClear);
+    printf("  %-8s  %10.3f s\n", "reverse", cfs.secReverse);
+    printf("  %-8s  %10.3f s  %u calls", "load", cfs.secLoad, cfs.ccall);
+
+    if ( 0 < cfs.secLoad ) {
+
+        printf(", %.2f MB/s", img.cbData / (1000000.0 * cfs.secLoad));
+        if ( 0 != cfg.FrqTck() ) {
+            printf(", %.1f%% of TCK", (800.0 * img.cbData) / (cfs.secLoad * cfg.FrqTck()));
+        }
+    }
+
+    printf("\n  %-8s  %10.3f s\n", "start", cfs.secStart);
+
+    secTotal = cfs.secClear + cfs.secReverse + cfs.secLoad + cfs.secStart;
+    printf("\nconfiguration time %.3f s\n", secTotal);
+
+    if ( ! fSuccess ) {
+
+        printf("ERROR: %s\n", cfg.SzError());
+        goto lExit;
+    }
+
+    printf("DONE is high, IR capture 0x%02X\n", cfs.bCapture);
+
+lExit:
+
+    free(pb);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    PbReadFile
+**
+**  Parameters:
+**      pcb     - receives the size of the file
+**
+**  Return Values:
+**      contents of the file, to be freed by the caller, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Read the file given with "-bit".
+*/
+BYTE *
+PbReadFile( DWORD * pcb ) {
+
+    FILE *  pfile;
+    BYTE *  pb;
+    long    cb;
+
+    pfile = fopen(szFile, "rb");
+    if ( NULL == pfile ) {
+
+        printf("ERROR: unable to open \"%s\"\n", szFile);
+        return NULL;
+    }
+
+    fseek(pfile, 0, SEEK_END);
+    cb = ftell(pfile);
+    fseek(pfile, 0, SEEK_SET);
+
+    if (( 0 >= cb ) || ( (long)cbFileMax < cb )) {
+
+        printf("ERROR: \"%s\" is empty or too large\n", szFile);
+        fclose(pfile);
+        return NULL;
+    }
+
+    pb = (BYTE *)malloc(cb);
+    if (( NULL == pb ) || ( (size_t)cb != fread(pb, 1, cb, pfile) )) {
+
+        printf("ERROR: unable to read \"%s\"\n", szFile);
+        free(pb);
+        fclose(pfile);
+        return NULL;
+    }
+
+    fclose(pfile);
+    *pcb = (DWORD)cb;
+
+    return pb;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    szFile[0] = '\0';
+    frqReq = 0;
+    cbChunkReq = 0;
+    memset(&chnReq, 0, sizeof(CFGCHAIN));
+    chnReq.cbitIr = cbitCfgIrDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-bit") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-irlen") ) {
+
+            if ( ! FParseNumber(szVal, "IR length", &chnReq.cbitIr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hir") ) {
+
+            if ( ! FParseNumber(szVal, "header IR length", &chnReq.cbitHir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tir") ) {
+
+            if ( ! FParseNumber(szVal, "trailer IR length", &chnReq.cbitTir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hdr") ) {
+
+            if ( ! FParseNumber(szVal, "header DR length", &chnReq.cbitHdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tdr") ) {
+
+            if ( ! FParseNumber(szVal, "trailer DR length", &chnReq.cbitTdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-chunk") ) {
+
+            if ( ! FParseNumber(szVal, "chunk size", &cbChunkReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> -bit <file> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
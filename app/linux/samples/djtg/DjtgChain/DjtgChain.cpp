@@ -0,0 +1,453 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgChain.cpp  --  DjtgChain main program                           */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgChain lists the devices in the scan chain on the JTAG port of   */
+/*  a Digilent device, with their IDCODEs, IR lengths and the header    */
+/*  and trailer lengths that address each of them. The chain is         */
+/*  discovered with a single DJTG call and stored in a chain file under */
+/*  the serial number of the device, so that later runs can use the     */
+/*  stored chain instead of scanning it again.                          */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a JTAG port connected to a scan chain.       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgChain.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 260;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-rescan      ", "discover the chain even if it is stored"},
+    {"-verify      ", "check the IDCODEs of a stored chain"},
+    {"-file        ", "chain file (default ~/.djtgchain)"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+BOOL    fRescan;
+BOOL    fVerify;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FGetChain(HIF hif);
+void    ShowChain(const JCHAIN * pjc);
+
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if (( '\0' == szFile[0] ) && ( ! FJcPath(szFile, sizeof(szFile)) )) {
+
+        printf("ERROR: unable to build the path of the chain file\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    fSuccess = FGetChain(hif);
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FGetChain
+**
+**  Parameters:
+**      hif     - device with DJTG enabled
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Get the chain from the chain file, or discover it and store it
+**      if it isn't there, then print it. With "-verify" the IDCODEs of
+**      a stored chain are read back first, and the chain is discovered
+**      again if they have changed.
+*/
+BOOL
+FGetChain( HIF hif ) {
+
+    JtgChain    jtc;
+    JCHAIN      jc;
+    char        szSn[cchSnMax + 1];
+    BOOL        fSn;
+    BOOL        fDiscover;
+    BOOL        fMatch;
+    double      secStart;
+
+    jtc.Init(hif);
+
+    fSn = FJcGetSerial(hif, szSn);
+    if ( ! fSn ) {
+        printf("WARNING: unable to read the serial number, the chain won't be stored\n");
+    }
+
+    fDiscover = fTrue;
+    secStart = SecNow();
+
+    if (( fSn ) && ( ! fRescan ) && ( FJcLoad(szFile, szSn, &jc) )) {
+
+        fDiscover = fFalse;
+        printf("chain of %s read from %s\n", szSn, szFile);
+
+        if ( fVerify ) {
+
+            if ( ! jtc.FVerify(&jc, &fMatch) ) {
+
+                printf("ERROR: %s\n", jtc.SzError());
+                return fFalse;
+            }
+
+            if ( ! fMatch ) {
+
+                printf("the IDCODEs have changed, discovering the chain again\n");
+                fDiscover = fTrue;
+            }
+        }
+    }
+
+    if ( fDiscover ) {
+
+        if ( ! jtc.FDiscover(&jc) ) {
+
+            printf("ERROR: %s\n", jtc.SzError());
+            return fFalse;
+        }
+
+        printf("chain discovered\n");
+
+        if ( fSn ) {
+
+            if ( FJcSave(szFile, szSn, &jc) ) {
+                printf("chain of %s stored in %s\n", szSn, szFile);
+            }
+            else {
+                printf("WARNING: unable to write %s\n", szFile);
+            }
+        }
+    }
+
+    printf("%.3f ms\n\n", 1000.0 * (SecNow() - secStart));
+
+    ShowChain(&jc);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    ShowChain
+**
+**  Parameters:
+**      pjc     - chain
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Print the devices, starting with the one nearest TDO. The HIR,
+**      TIR, HDR and TDR columns are the values to give DjtgCfg or an
+**      SVF file to address each device.
+*/
+void
+ShowChain( const JCHAIN * pjc ) {
+
+    DWORD   idev;
+    DWORD   cbitHir;
+    DWORD   cbitTir;
+    DWORD   cbitHdr;
+    DWORD   cbitTdr;
+
+    printf("  dev  IDCODE      IR   HIR  TIR  HDR  TDR\n");
+
+    for ( idev = 0; idev < pjc->cdev; idev++ ) {
+
+        JcPosition(pjc, idev, &cbitHir, &cbitTir, &cbitHdr, &cbitTdr);
+
+        if ( idJcNone == pjc->rgdev[idev].idcode ) {
+            printf("  %3u  (bypass)  ", idev);
+        }
+        else {
+            printf("  %3u  0x%08X", idev, pjc->rgdev[idev].idcode);
+        }
+
+        printf("  %3u  %3u  %3u  %3u  %3u\n", pjc->rgdev[idev].cbitIr,
+               cbitHir, cbitTir, cbitHdr, cbitTdr);
+    }
+
+    printf("\n%u devices, %u IR bits\n", pjc->cdev, pjc->cbitIr);
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    fRescan = fFalse;
+    fVerify = fFalse;
+    szFile[0] = '\0';
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-file") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-rescan") ) {
+            fRescan = fTrue;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-verify") ) {
+            fVerify = fTrue;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
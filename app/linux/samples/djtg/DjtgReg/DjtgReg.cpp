@@ -0,0 +1,556 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgReg.cpp  --  DjtgReg main program                               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgReg reads and writes the registers of fpga/spi_top.vhd through  */
+/*  the JTAG register bridge, fpga/jtgref.vhd, instead of DEPP. It can  */
+/*  read or write one register, and can test the data registers by      */
+/*  writing them all with one call and reading them back with another,  */
+/*  printing the time each call took.                                   */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a JTAG port connected to a Spartan-6 FPGA    */
+/*  configured with spi_top built with jtag_regs set to true.           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgReg.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+/* Data registers of dpimref, written and read back by "-test".
+*/
+const   DWORD   cregTest = 17;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-a           ", "register address"},
+    {"-w           ", "value to write, the register is read if omitted"},
+    {"-test        ", "write and read back the data registers"},
+    {"-irlen       ", "IR length of the FPGA (default 6)"},
+    {"-user        ", "USER1 opcode (default 0x02)"},
+    {"-hir, -tir   ", "IR bits after and before the FPGA"},
+    {"-hdr, -tdr   ", "bypass bits after and before the FPGA"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShowHelp;
+BOOL    fAddr;
+BOOL    fWrite;
+BOOL    fTest;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+DWORD   regReq;
+DWORD   bWriteReq;
+JRCHAIN chnReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FAccess(JtgReg * pjr);
+BOOL    FTest(JtgReg * pjr);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    JtgReg  jr;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string
+    ** and something to do.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if (( ! fAddr ) && ( ! fTest )) {
+
+        printf("ERROR: you must specify an address with \"-a\" or \"-test\"\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( ! jr.FInit(hif, &chnReq) ) {
+
+        printf("ERROR: %s\n", jr.SzError());
+        goto lDisableExit;
+    }
+
+    fSuccess = fTest ? FTest(&jr) : FAccess(&jr);
+
+    if ( ! jr.FEnd() ) {
+        fSuccess = fFalse;
+    }
+
+lDisableExit:
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FAccess
+**
+**  Parameters:
+**      pjr     - bridge transport
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write the register given with "-a" if "-w" was given, otherwise
+**      read it.
+*/
+BOOL
+FAccess( JtgReg * pjr ) {
+
+    BYTE    bData;
+
+    if ( fWrite ) {
+
+        if ( ! pjr->FPutReg((BYTE)regReq, (BYTE)bWriteReq) ) {
+
+            printf("ERROR: %s\n", pjr->SzError());
+            return fFalse;
+        }
+
+        printf("wrote 0x%02X to register 0x%02X\n", bWriteReq, regReq);
+        return fTrue;
+    }
+
+    if ( ! pjr->FGetReg((BYTE)regReq, &bData) ) {
+
+        printf("ERROR: %s\n", pjr->SzError());
+        return fFalse;
+    }
+
+    printf("register 0x%02X = 0x%02X\n", regReq, bData);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FTest
+**
+**  Parameters:
+**      pjr     - bridge transport
+**
+**  Return Values:
+**      fTrue if every register read back as written, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Write a pattern to the data registers with one FPutRegSet call,
+**      read them back with one FGetRegSet call and compare.
+*/
+BOOL
+FTest( JtgReg * pjr ) {
+
+    BYTE    rgbAddrData[2 * cregTest];
+    BYTE    rgbAddr[cregTest];
+    BYTE    rgbData[cregTest];
+    DWORD   ireg;
+    DWORD   cerr;
+    double  secPut;
+    double  secGet;
+
+    for ( ireg = 0; ireg < cregTest; ireg++ ) {
+        rgbAddr[ireg] = (BYTE)ireg;
+        rgbAddrData[2 * ireg] = (BYTE)ireg;
+        rgbAddrData[2 * ireg + 1] = (BYTE)(0xA5 ^ (ireg * 0x1D));
+    }
+
+    secPut = SecNow();
+    if ( ! pjr->FPutRegSet(rgbAddrData, cregTest) ) {
+
+        printf("ERROR: %s\n", pjr->SzError());
+        return fFalse;
+    }
+
+    secGet = SecNow();
+    secPut = secGet - secPut;
+
+    if ( ! pjr->FGetRegSet(rgbAddr, rgbData, cregTest) ) {
+
+        printf("ERROR: %s\n", pjr->SzError());
+        return fFalse;
+    }
+
+    secGet = SecNow() - secGet;
+
+    cerr = 0;
+    for ( ireg = 0; ireg < cregTest; ireg++ ) {
+        if ( rgbData[ireg] != rgbAddrData[2 * ireg + 1] ) {
+
+            printf("register 0x%02X: wrote 0x%02X, read 0x%02X\n",
+                   ireg, rgbAddrData[2 * ireg + 1], rgbData[ireg]);
+            cerr++;
+        }
+    }
+
+    printf("%u registers written in %.3f ms, read in %.3f ms, %u calls in all\n",
+           cregTest, 1000.0 * secPut, 1000.0 * secGet, pjr->Ccall());
+    printf("%u errors\n", cerr);
+
+    return ( 0 == cerr );
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fShowHelp = fFalse;
+    fAddr = fFalse;
+    fWrite = fFalse;
+    fTest = fFalse;
+    memset(&chnReq, 0, sizeof(JRCHAIN));
+    chnReq.cbitIr = cbitJrIrDefault;
+    chnReq.irUser = irJrUser1;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-a") ) {
+
+            if ( ! FParseNumber(szVal, "address", &regReq) ) {
+                return fFalse;
+            }
+
+            if ( 0xFF < regReq ) {
+
+                printf("ERROR: invalid address specified: %s\n", szVal);
+                return fFalse;
+            }
+
+            fAddr = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-w") ) {
+
+            if ( ! FParseNumber(szVal, "value", &bWriteReq) ) {
+                return fFalse;
+            }
+
+            if ( 0xFF < bWriteReq ) {
+
+                printf("ERROR: invalid value specified: %s\n", szVal);
+                return fFalse;
+            }
+
+            fWrite = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-test") ) {
+            fTest = fTrue;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-irlen") ) {
+
+            if ( ! FParseNumber(szVal, "IR length", &chnReq.cbitIr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-user") ) {
+
+            if ( ! FParseNumber(szVal, "USER1 opcode", &chnReq.irUser) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hir") ) {
+
+            if ( ! FParseNumber(szVal, "header IR length", &chnReq.cbitHir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tir") ) {
+
+            if ( ! FParseNumber(szVal, "trailer IR length", &chnReq.cbitTir) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-hdr") ) {
+
+            if ( ! FParseNumber(szVal, "header DR length", &chnReq.cbitHdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-tdr") ) {
+
+            if ( ! FParseNumber(szVal, "trailer DR length", &chnReq.cbitTdr) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> (-a <address> [-w <value>] | -test) [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
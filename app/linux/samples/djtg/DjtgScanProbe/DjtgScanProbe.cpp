@@ -0,0 +1,716 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgScanProbe.cpp  --  DjtgScanProbe main program                   */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgScanProbe finds the fastest reliable two-wire setup for an IEEE */
+/*  1149.7-2009 target. Every scan format of the advanced protocol that */
+/*  the DJTG port supports is tried with every RDY bit count and DLY    */
+/*  bit count the port can set. A setup passes when all of its commands */
+/*  and check packets succeed, the IDCODEs read with it match the ones  */
+/*  read in four-wire mode, and a pattern shifted through the chain     */
+/*  comes back unchanged. The passing setup with the highest scan rate  */
+/*  is stored in a scan format file under the serial number of the      */
+/*  device, where DjtgTwoWireDemo finds it.                             */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device that supports DjtgEscape, DjtgCheckPacket and at  */
+/*  least one advanced scan format, connected to an IEEE 1149.7-2009    */
+/*  target, as for DjtgTwoWireDemo.                                     */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "JtgBatch.h"
+#include "Jtg7Cfg.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 260;
+
+/* Default and largest length of the test pattern, and the default
+** number of scans timed for each setup.
+*/
+const   DWORD   cbitPatDefault = 8192;
+const   DWORD   cbitPatMax = 1 << 20;
+const   DWORD   crepDefault = 8;
+
+/* Zeros shifted after the pattern so that it leaves the longest chain
+** of devices with IDCODEs.
+*/
+const   DWORD   cbitPatTail = 32 * cidT7Max;
+
+/* Scan formats tried, in order. The first one measured wins a tie.
+*/
+const   BYTE    rgjtgsfProbe[] = {
+    jtgsfOScan0, jtgsfOScan1, jtgsfOScan2, jtgsfOScan3,
+    jtgsfOScan4, jtgsfOScan5, jtgsfOScan6, jtgsfOScan7,
+    jtgsfMScan
+};
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-f           ", "device TCK frequency in Hz"},
+    {"-cbit        ", "length of the test pattern in bits"},
+    {"-crep        ", "number of scans timed for each setup"},
+    {"-file        ", "scan format file (default ~/.djtgscan)"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fFreq;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+DWORD   freqReq;
+DWORD   cbitPat;
+DWORD   crep;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FProbe(HIF hif);
+BOOL    FFindEcho(const BYTE * rgbTdi, const BYTE * rgbTdo, DWORD * pcbitChain);
+BOOL    FEcho(const BYTE * rgbTdi, const BYTE * rgbTdo, DWORD cbitChain);
+BOOL    FBit(const BYTE * rgb, DWORD ibit);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    DWORD   freqSet;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if (( '\0' == szFile[0] ) && ( ! FT7Path(szFile, sizeof(szFile)) )) {
+
+        printf("ERROR: unable to build the path of the scan format file\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    /* The setup found is only the fastest at the TCK frequency it was
+    ** probed with, so the demo should be run at the same one.
+    */
+    if ( fFreq ) {
+
+        if ( ! DjtgSetSpeed(hif, freqReq, &freqSet) ) {
+
+            printf("ERROR: DjtgSetSpeed failed, erc = %d\n", DmgrGetLastError());
+            goto lDisableExit;
+        }
+
+        printf("JTAG TCK Frequency set to: %d Hz\n", freqSet);
+    }
+
+    fSuccess = FProbe(hif);
+
+lDisableExit:
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FProbe
+**
+**  Parameters:
+**      hif     - device with DJTG enabled
+**
+**  Return Values:
+**      fTrue if a setup passed, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read the IDCODEs and the length of the chain in four-wire mode,
+**      then try every setup and print a line for each. The fastest one
+**      that passes is stored in the scan format file. The target and
+**      the port are returned to four-wire mode at the end.
+*/
+BOOL
+FProbe( HIF hif ) {
+
+    Jtg7Cfg     t7;
+    T7CFG       cfg;
+    T7CFG       cfgBest;
+    DWORD       rgidRef[cidT7Max];
+    DWORD       rgid[cidT7Max];
+    DWORD       cidRef;
+    DWORD       cid;
+    DWORD       cbitChain;
+    DWORD       cbitScan;
+    DWORD       cbitRdyMax;
+    DWORD       cbitDlyMax;
+    DWORD       ijtgsf;
+    DWORD       irep;
+    DWORD       ibit;
+    DWORD       dwSeed;
+    BYTE *      rgbTdi;
+    BYTE *      rgbTdo;
+    char        szSn[cchSnMax + 1];
+    double      secStart;
+    double      sec;
+    const char * szFail;
+    BOOL        fSuccess;
+
+    fSuccess = fFalse;
+    cfgBest.bps = 0;
+
+    cbitScan = cbitPat + cbitPatTail;
+    rgbTdi = (BYTE *)calloc(1, (cbitScan + 7) / 8);
+    rgbTdo = (BYTE *)calloc(1, (cbitScan + 7) / 8);
+
+    if (( NULL == rgbTdi ) || ( NULL == rgbTdo )) {
+
+        printf("ERROR: unable to allocate the test pattern\n");
+        goto lExit;
+    }
+
+    /* The pattern is a pseudo-random sequence, so that neither stuck
+    ** bits nor a shift of the data can give it back unchanged.
+    */
+    dwSeed = 0x2545F491;
+    for ( ibit = 0; ibit < cbitPat; ibit++ ) {
+
+        dwSeed = dwSeed * 1103515245 + 12345;
+        if ( dwSeed & 0x00010000 ) {
+            rgbTdi[ibit / 8] |= (BYTE)(1 << (ibit % 8));
+        }
+    }
+
+    if (( ! t7.FInit(hif) ) || ( ! t7.FReset() ) ||
+        ( ! t7.FReadIdcodes(rgidRef, &cidRef) ) ||
+        ( ! t7.FScanDr(rgbTdi, cbitScan, rgbTdo) )) {
+
+        printf("ERROR: %s\n", t7.SzError());
+        goto lExit;
+    }
+
+    if ( 0 == cidRef ) {
+
+        printf("ERROR: 0 devices detected in scan chain\n");
+        goto lExit;
+    }
+
+    if ( ! FFindEcho(rgbTdi, rgbTdo, &cbitChain) ) {
+
+        printf("ERROR: the test pattern doesn't come back in four-wire mode\n");
+        goto lExit;
+    }
+
+    printf("%u devices, %u DR bits in four-wire mode\n\n", cidRef, cbitChain);
+    printf("  format  rdy  dly  result\n");
+
+    cbitRdyMax = t7.FReadyCnt() ? cbitT7RdyMax : cbitT7RdyMin;
+    cbitDlyMax = t7.FDelayCnt() ? cbitT7DlyMax : 0;
+
+    for ( ijtgsf = 0; ijtgsf < sizeof(rgjtgsfProbe); ijtgsf++ ) {
+
+        cfg.jtgsf = rgjtgsfProbe[ijtgsf];
+        if ( ! t7.FFormatSupported(cfg.jtgsf) ) {
+            continue;
+        }
+
+        for ( cfg.cbitRdy = cbitT7RdyMin; cfg.cbitRdy <= cbitRdyMax; cfg.cbitRdy++ ) {
+
+            for ( cfg.cbitDly = 0; cfg.cbitDly <= cbitDlyMax; cfg.cbitDly++ ) {
+
+                printf("  %-6s  %3u  %3u  ", SzT7Format(cfg.jtgsf), cfg.cbitRdy, cfg.cbitDly);
+                fflush(stdout);
+
+                cfg.bps = 0;
+                szFail = NULL;
+
+                if ( ! t7.FConfigure(&cfg) ) {
+                    szFail = t7.SzError();
+                }
+                else if ( ! t7.FReadIdcodes(rgid, &cid) ) {
+                    szFail = t7.SzError();
+                }
+                else if (( cid != cidRef ) || ( 0 != memcmp(rgid, rgidRef, cid * sizeof(DWORD)) )) {
+                    szFail = "IDCODEs don't match";
+                }
+
+                /* Each timed scan is checked, so a setup that only fails
+                ** now and then is still rejected.
+                */
+                secStart = SecNow();
+                for ( irep = 0; ( NULL == szFail ) && ( irep < crep ); irep++ ) {
+
+                    if ( ! t7.FScanDr(rgbTdi, cbitScan, rgbTdo) ) {
+                        szFail = t7.SzError();
+                    }
+                    else if ( ! FEcho(rgbTdi, rgbTdo, cbitChain) ) {
+                        szFail = "test pattern doesn't match";
+                    }
+                }
+                sec = SecNow() - secStart;
+
+                if ( NULL != szFail ) {
+
+                    printf("failed: %s\n", szFail);
+                    continue;
+                }
+
+                cfg.bps = ( 0 < sec ) ? (DWORD)((double)crep * cbitScan / sec) : 0xFFFFFFFF;
+                printf("%.1f kbit/s\n", cfg.bps / 1000.0);
+
+                if ( cfgBest.bps < cfg.bps ) {
+                    cfgBest = cfg;
+                }
+            }
+        }
+    }
+
+    /* Leave the target in four-wire mode, as it was found.
+    */
+    if ( ! t7.FReset() ) {
+        printf("WARNING: %s\n", t7.SzError());
+    }
+
+    if ( 0 == cfgBest.bps ) {
+
+        printf("\nERROR: no setup passed\n");
+        goto lExit;
+    }
+
+    printf("\nfastest: %s, %u RDY bits, %u DLY bits, %.1f kbit/s\n",
+           SzT7Format(cfgBest.jtgsf), cfgBest.cbitRdy, cfgBest.cbitDly, cfgBest.bps / 1000.0);
+
+    if ( ! FT7GetSerial(hif, szSn) ) {
+        printf("WARNING: unable to read the serial number, the setup won't be stored\n");
+    }
+    else if ( FT7Save(szFile, szSn, &cfgBest) ) {
+        printf("setup of %s stored in %s\n", szSn, szFile);
+    }
+    else {
+        printf("WARNING: unable to write %s\n", szFile);
+    }
+
+    fSuccess = fTrue;
+
+lExit:
+
+    free(rgbTdi);
+    free(rgbTdo);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FFindEcho
+**
+**  Parameters:
+**      rgbTdi      - test pattern and the zeros after it
+**      rgbTdo      - TDO bits of the scan
+**      pcbitChain  - receives the length of the chain
+**
+**  Return Values:
+**      fTrue if the pattern came back, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Find the number of DR bits the pattern passed through before it
+**      reached TDO. This also covers devices in BYPASS, which have no
+**      IDCODE to count.
+*/
+BOOL
+FFindEcho( const BYTE * rgbTdi, const BYTE * rgbTdo, DWORD * pcbitChain ) {
+
+    DWORD   cbitChain;
+
+    for ( cbitChain = 1; cbitChain <= cbitPatTail; cbitChain++ ) {
+
+        if ( FEcho(rgbTdi, rgbTdo, cbitChain) ) {
+
+            *pcbitChain = cbitChain;
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+/* ------------------------------------------------------------ */
+/***    FEcho
+**
+**  Parameters:
+**      rgbTdi      - test pattern and the zeros after it
+**      rgbTdo      - TDO bits of the scan
+**      cbitChain   - length of the chain
+**
+**  Return Values:
+**      fTrue if the pattern came back unchanged, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare the pattern with the TDO bits that follow the chain.
+*/
+BOOL
+FEcho( const BYTE * rgbTdi, const BYTE * rgbTdo, DWORD cbitChain ) {
+
+    DWORD   ibit;
+
+    for ( ibit = 0; ibit < cbitPat; ibit++ ) {
+
+        if ( FBit(rgbTdi, ibit) != FBit(rgbTdo, ibit + cbitChain) ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FBit
+**
+**  Parameters:
+**      rgb         - bits, LSB first
+**      ibit        - bit to read
+**
+**  Return Values:
+**      fTrue if the bit is set, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read one bit of a buffer.
+*/
+BOOL
+FBit( const BYTE * rgb, DWORD ibit ) {
+
+    return ( 0 != (rgb[ibit / 8] & (1 << (ibit % 8))) );
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fFreq = fFalse;
+    fShowHelp = fFalse;
+    szFile[0] = '\0';
+    freqReq = 0;
+    cbitPat = cbitPatDefault;
+    crep = crepDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &freqReq) ) {
+                return fFalse;
+            }
+
+            fFreq = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-cbit") ) {
+
+            if ( ! FParseNumber(szVal, "pattern length", &cbitPat) ) {
+                return fFalse;
+            }
+
+            if (( 32 > cbitPat ) || ( cbitPatMax < cbitPat )) {
+
+                printf("ERROR: the pattern length must be between 32 and %u bits\n", cbitPatMax);
+                return fFalse;
+            }
+
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-crep") ) {
+
+            if ( ! FParseNumber(szVal, "scan count", &crep) ) {
+                return fFalse;
+            }
+
+            if ( 0 == crep ) {
+
+                printf("ERROR: the scan count must be at least 1\n");
+                return fFalse;
+            }
+
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-file") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid scan format file specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,444 @@
+/************************************************************************/
+/*                                                                      */
+/*  DjtgSvf.cpp  --  DjtgSvf main program                               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DjtgSvf plays an SVF or XSVF file on the JTAG port of a Digilent    */
+/*  device and reports where the time went. For each class of           */
+/*  instruction it prints the number of instructions, the TCK cycles    */
+/*  they produced and the host time spent on them, and it compares the  */
+/*  overall rate with the TCK frequency. A file that plays much slower  */
+/*  than its TCK cycles allow is limited by the host or the USB link    */
+/*  rather than by the port.                                            */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a JTAG port connected to the scan chain the  */
+/*  file was written for.                                               */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "djtg.h"
+#include "JtgTap.h"
+#include "SvfPlayer.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 260;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-svf         ", "SVF file to play"},
+    {"-xsvf        ", "XSVF file to play"},
+    {"-f           ", "TCK frequency in Hz"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fXsvf;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+DWORD   frqReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FPlay(HIF hif);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    DWORD   frqSet;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string
+    ** and a file to play.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( '\0' == szFile[0] ) {
+
+        printf("ERROR: you must specify a file using the \"-svf\" or \"-xsvf\" option\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DjtgEnable(hif) ) {
+
+        printf("ERROR: unable to enable DJTG, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( 0 != frqReq ) {
+
+        if ( ! DjtgSetSpeed(hif, frqReq, &frqSet) ) {
+
+            printf("ERROR: DjtgSetSpeed failed, erc = %d\n", DmgrGetLastError());
+            goto lDisableExit;
+        }
+    }
+
+    fSuccess = FPlay(hif);
+
+lDisableExit:
+
+    DjtgDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FPlay
+**
+**  Parameters:
+**      hif     - device with DJTG enabled
+**
+**  Return Values:
+**      fTrue if the file played without error, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Play the file and print the time spent on each class of
+**      instruction.
+*/
+BOOL
+FPlay( HIF hif ) {
+
+    SvfPlayer       svfp;
+    const SVSTAT *  pstat;
+    double          secStart;
+    double          secTotal;
+    BOOL            fSuccess;
+    int             isvc;
+
+    if ( ! svfp.FInit(hif) ) {
+
+        printf("ERROR: unable to reset the TAP controller, erc = %d\n", DmgrGetLastError());
+        return fFalse;
+    }
+
+    printf("playing %s at %d Hz\n", szFile, svfp.FrqTck());
+
+    secStart = SecNow();
+
+    fSuccess = fXsvf ? svfp.FPlayXsvf(szFile) : svfp.FPlaySvf(szFile);
+    fSuccess = svfp.FFinish() && fSuccess;
+
+    secTotal = SecNow() - secStart;
+
+    if ( ! fSuccess ) {
+        printf("ERROR: %s\n", svfp.SzError());
+    }
+
+    printf("\n  %-8s  %10s  %14s  %10s\n", "class", "count", "TCK cycles", "seconds");
+
+    for ( isvc = 0; isvc < csvcMax; isvc++ ) {
+
+        pstat = svfp.PstatClass(isvc);
+        printf("  %-8s  %10u  %14llu  %10.3f\n", SzSvfClass(isvc), pstat->cinstr,
+               (unsigned long long)pstat->cclk, pstat->sec);
+    }
+
+    printf("\n%llu TCK cycles in %.3f s, %.1f kHz effective",
+           (unsigned long long)svfp.CclkTotal(), secTotal,
+           (double)svfp.CclkTotal() / (1000.0 * secTotal));
+
+    if ( 0 != svfp.FrqTck() ) {
+        printf(", %.1f%% of TCK", (100.0 * svfp.CclkTotal()) / (secTotal * svfp.FrqTck()));
+    }
+
+    printf("\n%d TDO mismatches\n", svfp.CerrCompare());
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fDevName = fFalse;
+    fXsvf = fFalse;
+    fShowHelp = fFalse;
+    szFile[0] = '\0';
+    frqReq = 0;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if (( 0 == strcmp(rgszArg[iszArg], "-svf") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-xsvf") )) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            fXsvf = ( 'x' == rgszArg[iszArg][1] );
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> -svf <file> | -xsvf <file> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -56,10 +56,27 @@
 /*  does NOT perform scan chain discovery and will not work correctly   */
 /*  in Star 4 or Star 2 scan chains that contain more than one device.  */
 /*                                                                      */
+/*  The TMS sequences and IDCODE reads are recorded with the JtgBatch   */
+/*  module in the "common" directory, so each step above is a single    */
+/*  DjtgBatch transaction instead of one DJTG call per TAP move. Only   */
+/*  the check packets and the changes to the port configuration are     */
+/*  made with calls of their own. The TMS moves are produced by the     */
+/*  JtgTap module, which tracks the TAP state and moves along the       */
+/*  shortest path, instead of by hard-coded TMS sequences.              */
+/*                                                                      */
+/*  When none of "-sfmt", "-rdyc" and "-dlyc" is given, the setup that  */
+/*  DjtgScanProbe stored for the device in ~/.djtgscan is used, so that */
+/*  the link runs in the fastest setup that passed on it. OScan1 with   */
+/*  the default counts is used for a device that hasn't been probed.    */
+/*                                                                      */
 /************************************************************************/
 /*  Revision History:                                                   */
 /*                                                                      */
 /*  07/17/2012(MTA): Created                                            */
+/*  10/19/2026: the TAP moves, commands and IDCODE reads are recorded   */
+/*              with JtgBatch and sent with DjtgBatch                   */
+/*  10/19/2026: the TMS moves are made with the JtgTap TAP model        */
+/*  10/19/2026: the setup stored by DjtgScanProbe is used by default    */
 /*                                                                      */
 /************************************************************************/
 
@@ -91,6 +108,9 @@
 #include "dpcdecl.h" 
 #include "djtg.h"
 #include "dmgr.h"
+#include "JtgBatch.h"
+#include "JtgTap.h"
+#include "Jtg7Cfg.h"
 
 /* ------------------------------------------------------------ */
 /*				Local Type Definitions          				*/
@@ -100,6 +120,11 @@ const   DWORD   cchDescriptionMax = 64;
 const   DWORD   cchOptionMax = 64;
 const   DWORD   cchJtgsfMax = 16;
 
+/* Number of IDCODEs read with each transaction. A chain with fewer
+** devices than this is listed with a single transaction.
+*/
+const   DWORD   cjidBatch = 8;
+
 typedef struct {
     char    szOption[cchOptionMax + 1];
     char    szDescription[cchDescriptionMax + 1];
@@ -109,36 +134,15 @@ typedef struct {
 /*				Global Variables								*/
 /* ------------------------------------------------------------ */
 
-/* Define TMS bit sequences for navigation between common tap states.
-*/
-BYTE    rgbTLR[]        = {0x1F}; // shift 5 times
-BYTE    rgbTLRRTI[]     = {0x1F}; // shift 6 times
-BYTE    rgbTLRSDR[]     = {0x5F, 0x00}; // shift 9 times
-BYTE    rgbSDRRTI[]     = {0x03}; // shift 3 times
-BYTE    rgbRTISDR[]     = {0x01}; // shift 3 times
-BYTE    rgbE1DRSDR[]    = {0x02}; // shift 3 times
-BYTE    rgbE1DRRTI[]    = {0x06}; // shift 4 times
-
-BYTE    rgbpTLR[]       = {0xAA, 0x02}; // shift 5 times
-BYTE    rgbpTLRRTI[]    = {0xAA, 0x02}; // shift 6 times
-BYTE    rgbpTLRSDR[]    = {0xAA, 0x22, 0x00}; // shift 9 times
-BYTE    rgbpSDRRTI[]    = {0x0A}; // shift 3 times
-BYTE    rgbpRTISDR[]    = {0x02}; // shift 3 times
-BYTE    rgbpE1DRSDR[]   = {0x08}; // shift 3 times
-BYTE    rgbpE1DRRTI[]   = {0x28}; // shift 4 times
-
-const DWORD   cbitTLR     = 5;
-const DWORD   cbitTLRRTI  = 6;
-const DWORD   cbitTLRSDR  = 9;
-const DWORD   cbitSDRRTI  = 3;
-const DWORD   cbitRTISDR  = 3;
-const DWORD   cbitE1DRSDR = 3;
-const DWORD   cbitE1DRRTI = 4;
-
 /* Declare variables used to keep track of the JTAG configuration state.
 */
 BOOL    fAdvancedProto;
 
+/* Declare the model of the TAP controller that produces the TMS moves.
+** Moves are collected in it and added to the batch with FPutTapMoves.
+*/
+JtgTap  tap;
+
 /* Define an array of supported command line options and descriptions.
 */
 OPTN   rgoptn[] = {
@@ -174,9 +178,12 @@ BYTE    cbitRdyReq;
 /*				Forward Declarations							*/
 /* ------------------------------------------------------------ */
 
-BOOL    FSendZBS( HIF hif, BYTE czbs );
-BOOL    FLockZBS( HIF hif );
-BOOL    FSendTwoPartCmd( HIF hif, BYTE cmd, BYTE op );
+BOOL    FPutTapMoves( JtgBatch * pjb );
+BOOL    FListIdcodes( HIF hif, JtgBatch * pjb, DWORD * pcjid );
+BOOL    FSendZBS( BYTE czbs );
+BOOL    FLockZBS();
+BOOL    FSendTwoPartCmd( HIF hif, JtgBatch * pjb, BYTE cmd, BYTE op );
+BOOL    FCmdPart( BYTE csdr );
 
 BOOL    FParseArguments( int cszArg, char* rgszArg[] );
 BOOL    FHelp();
@@ -205,12 +212,14 @@ main( int cszArg, char* rgszArg[] ) {
     DWORD   freqSet;
     DPRP    dprpJtag;
     BYTE    jtgsfReq;
-    DWORD   jid;
     DWORD   cjid;
-    BYTE    rgbTdo[4];
     BYTE    b;
     DWORD   cretOutSet;
     DWORD   cbitDlySet;
+    JtgBatch jb;
+    T7CFG   cfg;
+    char    szSn[cchSnMax + 1];
+    char    szFile[FILENAME_MAX];
     
     fAdvancedProto = fFalse;
     
@@ -263,23 +272,11 @@ main( int cszArg, char* rgszArg[] ) {
         /* Map the user specified scan format to a scan format that we can
         ** pass to DjtgSetScanFormat.
         */
-        if ( 0 == strcmp(szJtgsf, "MScan") ) {
-            
-            jtgsfReq = jtgsfMScan;
-        }
-        else if ( 0 == strcmp(szJtgsf, "OScan0") ) {
-            
-            jtgsfReq = jtgsfOScan0;
-        }
-        else if ( 0 == strcmp(szJtgsf, "OScan1") ) {
-            
-            jtgsfReq = jtgsfOScan1;
-        }
-        else {
+        if ( ! FT7ParseFormat(szJtgsf, &jtgsfReq) ) {
             
             printf("ERROR: unsupported scan format specified: \"%s\"\n", szJtgsf);
             printf("The following scan formats are supported: ");
-            printf("\"MScan\", \"OScan0\", and \"OScan1\"\n");
+            printf("\"MScan\" and \"OScan0\" through \"OScan7\"\n");
             goto lErrorExit;
         }
     }
@@ -297,6 +294,22 @@ main( int cszArg, char* rgszArg[] ) {
         goto lErrorExit;
     }
     
+    /* If no part of the setup was given, use the one DjtgScanProbe found
+    ** to be the fastest reliable setup for this device.
+    */
+    if (( ! fJtgsf ) && ( 0 == cbitRdyReq ) && ( 0 == cbitDlyReq ) &&
+        ( FT7GetSerial(hif, szSn) ) && ( FT7Path(szFile, sizeof(szFile)) ) &&
+        ( FT7Load(szFile, szSn, &cfg) )) {
+        
+        jtgsfReq = cfg.jtgsf;
+        cbitRdyReq = (BYTE)cfg.cbitRdy;
+        cbitDlyReq = cfg.cbitDly;
+        strcpy(szJtgsf, SzT7Format(cfg.jtgsf));
+        
+        printf("Using the setup probed for %s: %s, %d RDY bits, %d DLY bits\n",
+               szSn, szJtgsf, cbitRdyReq, cbitDlyReq);
+    }
+    
     /* Get the the properties associated with JTAG port 0. These will be
     ** used later to determine whether or not the device supports certain
     ** features required for communication with IEEE 1149.7-2009 targets.
@@ -352,39 +365,17 @@ main( int cszArg, char* rgszArg[] ) {
     ** through Test-Logic-Reset. This will ensure that the current control
     ** level is exited, that any 1149.1-2001 TAPC's behind the TAP.7 are
     ** connected in bypass mode, and that the IDCODE instruction has been
-    ** placed in the instruction register.
+    ** placed in the instruction register. The move is sent in the same
+    ** transaction as the first IDCODE reads.
     */
-    if ( ! DjtgPutTmsBits(hif, fFalse, rgbTLRSDR, NULL, cbitTLRSDR, fFalse) ) {
-        
-        printf("ERROR: DjtgPutTmsBits to shift pattern for TLR->SDR, erc = %d\n", DmgrGetLastError());
-        goto lErrorExit;
-    }
+    tap.FReset();
+    tap.FMoveTo(tpsShDR);
     
     printf("Listing device ID codes acquired in four-wire mode...\n");
     
-    cjid = 0;
-    do {
-        
-        /* Attempt to shift out the ID code of a device in the scan chain.
-        ** By shifting in 0's for TDI we can tell when we've reached the
-        ** end of the scan chain because we will read back an ID code of
-        ** all zeros. ID codes consisting entirely of 1's should also be
-        ** considered invalid and terminate the loop.
-        */
-        if ( ! DjtgGetTdoBits(hif, fFalse, fFalse, rgbTdo, 32, fFalse) ) {
-            
-            printf("ERROR: failed to get TDO bits from device, erc = %d\n", DmgrGetLastError());
-            goto lErrorExit;
-        }
-        
-        jid = (rgbTdo[3]<<24) + (rgbTdo[2]<<16) + (rgbTdo[1]<<8) + rgbTdo[0];
-        
-        if (( 0 != jid ) && ( 0xFFFFFFFF != jid )) {
-            
-            printf("    Found Device ID: %08X\n", jid);
-            cjid++;
-        }
-    } while (( 0 != jid ) && ( 0xFFFFFFFF != jid ));
+    if ( ! FListIdcodes(hif, &jb, &cjid) ) {
+        goto lErrorExit;
+    }
     
     if ( 0 == cjid ) {
         
@@ -393,19 +384,16 @@ main( int cszArg, char* rgszArg[] ) {
     }
     
     /* Navigate from the SDR state to the RTI state without passing through
-    ** TLR.
+    ** TLR. The move is sent with the commands that follow.
     */
-    if ( ! DjtgPutTmsBits(hif, fFalse, rgbSDRRTI, NULL, cbitSDRRTI, fFalse) ) {
-        
-        printf("ERROR: DjtgPutTmsBits to shift pattern for SDR->RTI, erc = %d\n", DmgrGetLastError());
-        goto lErrorExit;
-    }
+    jb.Reset();
+    tap.FMoveTo(tpsRTI);
     
     /* The TAP.7's confinguration registers can only be written while
     ** operating in control level 2. Attempt to enter control level 2 by
     ** setting the Zero-Bit-Scan count to 2 and locking the count.
     */
-    if ( ! FSendZBS(hif, 2) ) {
+    if ( ! FSendZBS(2) ) {
         
         printf("ERROR: failed to set a ZBS count of 2\n");
         goto lErrorExit;
@@ -413,7 +401,7 @@ main( int cszArg, char* rgszArg[] ) {
 
     /* Lock the ZBS count at 2. This sets control level 2.
     */
-    if ( ! FLockZBS(hif) ) {
+    if ( ! FLockZBS() ) {
         
         printf("ERROR: failed to lock ZBS count at 2\n");
         goto lErrorExit;
@@ -424,7 +412,7 @@ main( int cszArg, char* rgszArg[] ) {
     ** by sending the Store Miscellaneous Control command (opcode 0) with
     ** operand 7.
     */
-    if ( ! FSendTwoPartCmd(hif, 0, 7) ) {
+    if ( ! FSendTwoPartCmd(hif, &jb, 0, 7) ) {
         
         printf("ERROR: FSendTwoPartCmd(STMC, CGM=1) failed\n");
         goto lErrorExit;
@@ -451,7 +439,7 @@ main( int cszArg, char* rgszArg[] ) {
         */
         b = 0x08;
         b |= (cbitRdyReq -1);
-        if ( ! FSendTwoPartCmd(hif, 0, b) ) {
+        if ( ! FSendTwoPartCmd(hif, &jb, 0, b) ) {
             
             printf("ERROR: FSendTwoPartCmd(STMC, RdyCtl) failed\n");
             goto lErrorExit;
@@ -503,7 +491,7 @@ main( int cszArg, char* rgszArg[] ) {
             b |= 0x03;
         }
         
-        if ( ! FSendTwoPartCmd(hif, 0, b) ) {
+        if ( ! FSendTwoPartCmd(hif, &jb, 0, b) ) {
             
             printf("ERROR: FSendTwoPartCmd(STMC, DlyCtl) failed\n");
             goto lErrorExit;
@@ -527,23 +515,11 @@ main( int cszArg, char* rgszArg[] ) {
     /* Determine the OP code required to configure the target for the
     ** specified scan format.
     */
-    switch ( jtgsfReq ) {
+    b = OpT7Format(jtgsfReq);
+    if ( 0x1F < b ) {
         
-        case jtgsfMScan:
-            b = 16;
-            break;
-            
-        case jtgsfOScan0:
-            b = 8;
-            break;
-            
-        case jtgsfOScan1:
-            b = 9;
-            break;
-            
-        default:
-            printf("ERROR: unsupported scan format specified %d\n", jtgsfReq);
-            goto lErrorExit;
+        printf("ERROR: unsupported scan format specified %d\n", jtgsfReq);
+        goto lErrorExit;
     }
     
     /* Attempt to set the scan format to the specified format. The scan\
@@ -552,7 +528,7 @@ main( int cszArg, char* rgszArg[] ) {
     ** of operands can be found in Table 23-2 of the IEEE 1149.7-2009
     ** specification.
     */
-    if ( ! FSendTwoPartCmd(hif, 3, b) ) {
+    if ( ! FSendTwoPartCmd(hif, &jb, 3, b) ) {
         
         printf("ERROR: FSendTwoPartCmd(STFMT, %d) failed\n", b);
         goto lErrorExit;
@@ -580,7 +556,7 @@ main( int cszArg, char* rgszArg[] ) {
     ** Miscellaneous Control (STMC, opcode = 0) command with an operand of
     ** 1.
     */
-    if ( ! FSendTwoPartCmd(hif, 0, 1) ) {
+    if ( ! FSendTwoPartCmd(hif, &jb, 0, 1) ) {
         
         printf("ERROR: failed to send ECL command\n");
         goto lErrorExit;
@@ -590,37 +566,13 @@ main( int cszArg, char* rgszArg[] ) {
     ** IDCODE corresponding to each device should be reloaded into the data
     ** register when we enter SDR.
     */
-    if ( ! DjtgPutTmsBits(hif, fFalse, rgbRTISDR, NULL, cbitRTISDR, fFalse) ) {
-        
-        printf("ERROR: DjtgPutTmsBits to shift pattern for RTI->SDR, erc = %d\n", DmgrGetLastError());
-        goto lErrorExit;
-    }
+    tap.FMoveTo(tpsShDR);
     
     printf("Listing device ID codes acquired in two-wire mode...\n");
     
-    cjid = 0;
-    do {
-        
-        /* Attempt to shift out the ID code of a device in the scan chain.
-        ** By shifting in 0's for TDI we can tell when we've reached the
-        ** end of the scan chain because we will read back an ID code of
-        ** all zeros. ID codes consisting entirely of 1's should also be
-        ** considered invalid and terminate the loop.
-        */
-        if ( ! DjtgGetTdoBits(hif, fFalse, fFalse, rgbTdo, 32, fFalse) ) {
-            
-            printf("ERROR: failed to get TDO bits from device, erc = %d\n", DmgrGetLastError());
-            goto lErrorExit;
-        }
-        
-        jid = (rgbTdo[3]<<24) + (rgbTdo[2]<<16) + (rgbTdo[1]<<8) + rgbTdo[0];
-        
-        if (( 0 != jid ) && ( 0xFFFFFFFF != jid )) {
-            
-            printf("    Found Device ID: %08X\n", jid);
-            cjid++;
-        }
-    } while (( 0 != jid ) && ( 0xFFFFFFFF != jid ));
+    if ( ! FListIdcodes(hif, &jb, &cjid) ) {
+        goto lErrorExit;
+    }
     
     if ( 0 == cjid ) {
         
@@ -660,10 +612,108 @@ lErrorExit:
 }
 
 /* ------------------------------------------------------------ */
-/***    FSendZBS
+/***    FPutTapMoves
+**
+**  Parameters:
+**      pjb     - batch the TMS moves are added to
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      This function adds the TMS moves pending in the TAP model to a
+**      batch as a single TMS sequence and clears them from the model.
+*/
+BOOL
+FPutTapMoves( JtgBatch * pjb ) {
+    
+    BOOL    fOk;
+    
+    if ( 0 == tap.CbitSeq() ) {
+        
+        return fTrue;
+    }
+    
+    fOk = pjb->FPutTms(tap.RgbSeq(), tap.CbitSeq(), fFalse, NULL);
+    tap.Clear();
+    
+    return fOk;
+}
+
+/* ------------------------------------------------------------ */
+/***    FListIdcodes
 **
 **  Parameters:
 **      hif     - open handle for the device
+**      pjb     - batch holding the move into the Shift-DR state
+**      pcjid   - receives the number of devices found
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      This function lists the IDCODEs of the devices in the scan chain.
+**      The IDCODEs are shifted out cjidBatch at a time, the first group
+**      in the same transaction as the TMS moves already in the batch and
+**      the ones pending in the TAP model.
+**      Another group is only read if no terminating IDCODE was found in
+**      the previous one. The batch is reset on return.
+**
+**  Notes:
+**      This function assumes that the TAP controller will be in the SDR
+**      state once the pending moves have been made, and leaves it there.
+*/
+BOOL    
+FListIdcodes( HIF hif, JtgBatch * pjb, DWORD * pcjid ) {
+    
+    BYTE    rgbTdo[4 * cjidBatch];
+    DWORD   ijid;
+    DWORD   jid;
+    
+    *pcjid = 0;
+    
+    while ( fTrue ) {
+        
+        /* Attempt to shift out the ID codes of the devices in the scan
+        ** chain. By shifting in 0's for TDI we can tell when we've reached
+        ** the end of the scan chain because we will read back an ID code
+        ** of all zeros. ID codes consisting entirely of 1's should also be
+        ** considered invalid and terminate the list.
+        */
+        if (( ! FPutTapMoves(pjb) ) ||
+            ( ! pjb->FShift(NULL, 32 * cjidBatch, fFalse, rgbTdo) ) ||
+            ( ! pjb->FExecute(hif) )) {
+            
+            printf("ERROR: failed to get TDO bits from device, erc = %d\n", DmgrGetLastError());
+            pjb->Reset();
+            return fFalse;
+        }
+        
+        pjb->Reset();
+        
+        for ( ijid = 0; ijid < cjidBatch; ijid++ ) {
+            
+            jid = (rgbTdo[4*ijid+3]<<24) + (rgbTdo[4*ijid+2]<<16) + (rgbTdo[4*ijid+1]<<8) + rgbTdo[4*ijid];
+            
+            if (( 0 == jid ) || ( 0xFFFFFFFF == jid )) {
+                
+                return fTrue;
+            }
+            
+            printf("    Found Device ID: %08X\n", jid);
+            (*pcjid)++;
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FSendZBS
+**
+**  Parameters:
 **      czbs    - number of zero bit scans to perform
 **
 **  Return Values:
@@ -672,60 +722,47 @@ lErrorExit:
 **  Errors:
 **
 **  Description:
-**      This function uses DjtgPutTmsBits to perform one or more zero bit
-**      scans. Please see the IEEE 1149.7-2009 specification for more
-**      information about zero bit scans.
+**      This function adds the TMS moves that perform one or more zero bit
+**      scans to the TAP model. Please see the IEEE 1149.7-2009
+**      specification for more information about zero bit scans.
 **
 **  Notes:
 **      This function assumes that the TAP controller is currently in the
-**      RTI state.
+**      RTI state, and leaves it there.
 */
 BOOL    
-FSendZBS( HIF hif, BYTE czbs ) {
-    
-    BYTE    b;
+FSendZBS( BYTE czbs ) {
     
     if ( 0 == czbs ) {
         
         return fFalse;
     }
     
-    czbs--;
-    
-    /* By assigning 0x0D and shifting out 4 bits we can make one of the 
-    ** following state transitions:  RTI->SELDR->CDR->E1DR->UDR or
-    ** UDR->SELDR->CDR->E1DR->UDR. By shifting out 5 TMS bits we can make
-    ** the following transition: UDR->SELDR->CDR->E1DR->UDR->RTI.
+    /* A zero bit scan passes through Capture-DR and Update-DR without
+    ** entering Shift-DR: RTI->SELDR->CDR->E1DR->UDR for the first scan
+    ** and UDR->SELDR->CDR->E1DR->UDR for the ones after it.
     */
-    b = 0x0D;
-    
     while ( 0 < czbs ) {
         
-        if ( ! DjtgPutTmsBits(hif, fFalse, &b, NULL, 4, fFalse) ) {
+        if (( ! tap.FMoveTo(tpsCapDR) ) || ( ! tap.FMoveTo(tpsUpdDR) )) {
             
-            printf("ERROR: FSendZBS->DjtgPutTmsBits failed to shift 4 bits, erc = %d\n", DmgrGetLastError());
+            printf("ERROR: FSendZBS->FMoveTo failed\n");
             return fFalse;
         }
         
         czbs--;
     }
     
-    /* Perform the last ZBS and enter RTI.
+    /* Enter RTI after the last ZBS.
     */
-    if ( ! DjtgPutTmsBits(hif, fFalse, &b, NULL, 5, fFalse) ) {
-        
-        printf("ERROR: FSendZBS->DjtgPutTmsBits failed to shift 5 bits, erc = %d\n", DmgrGetLastError());
-        return fFalse;
-    }
-    
-    return fTrue;
+    return tap.FMoveTo(tpsRTI);
 }
 
 /* ------------------------------------------------------------ */
 /***    FLockZBS
 **
 **  Parameters:
-**      hif     - open handle for the device
+**      none
 **
 **  Return Values:
 **      fTrue for success, fFalse otherwise
@@ -733,28 +770,24 @@ FSendZBS( HIF hif, BYTE czbs ) {
 **  Errors:
 **
 **  Description:
-**      This function uses DjtgPutTmsBits to shift out the TMS bit pattern
-**      required to lock the ZBS count. Please see the IEEE 1149.7-2009
-**      specification for more informaiton on zero bit scans (ZBS).
+**      This function adds the TMS moves required to lock the ZBS count
+**      to the TAP model. Please see the IEEE 1149.7-2009 specification
+**      for more informaiton on zero bit scans (ZBS).
 **
 **  Notes:
 **      This function assumes that the TAP controller is currently in the
 **      RTI state.
 */
 BOOL    
-FLockZBS( HIF hif ) {
-    
-    BYTE    b;
+FLockZBS() {
     
-    /* By assigning 0x19 and shifting 6 TMS bits we make the following
-    ** state transitions, which should lock the ZBS count and leave us in
-    ** RTI: RTI->SELDR->CDR->SDR->E1DR->UDR->RTI.
+    /* Entering Shift-DR and returning to RTI makes the following state
+    ** transitions, which should lock the ZBS count and leave us in RTI:
+    ** RTI->SELDR->CDR->SDR->E1DR->UDR->RTI.
     */
-    b = 0x19;
-    
-    if ( ! DjtgPutTmsBits(hif, fFalse, &b, NULL, 6, fFalse) ) {
+    if (( ! tap.FMoveTo(tpsShDR) ) || ( ! tap.FMoveTo(tpsRTI) )) {
         
-        printf("error: FLockZBS->DjtgPutTmsBits failed to shift 6 bits, erc = %d\n", DmgrGetLastError());
+        printf("error: FLockZBS->FMoveTo failed\n");
         return fFalse;
     }
     
@@ -766,6 +799,7 @@ FLockZBS( HIF hif ) {
 **
 **  Parameters:
 **      hif     - open handle for the device
+**      pjb     - batch holding the TMS moves that precede the command
 **      cmd     - command part 1 (operator)
 **      op      - command part 2 (operand)
 **
@@ -775,8 +809,11 @@ FLockZBS( HIF hif ) {
 **  Errors:
 **
 **  Description:
-**      This function uses DjtgPutTmsBits to sends a two part command to an
-**      1149.7 target that has been configured for control level 2.
+**      This function sends a two part command to an 1149.7 target that
+**      has been configured for control level 2. The TMS moves of both
+**      parts are added to the TAP model, and then to the batch as one
+**      sequence with the moves pending before them. The batch is sent
+**      with a single DjtgBatch transaction and reset.
 **
 **  Notes:
 **      This function assumes that the TAP controller is currently in the
@@ -792,7 +829,7 @@ FLockZBS( HIF hif ) {
 **      (JScan0-JScan3).
 */
 BOOL    
-FSendTwoPartCmd( HIF hif, BYTE cmd, BYTE op ) {
+FSendTwoPartCmd( HIF hif, JtgBatch * pjb, BYTE cmd, BYTE op ) {
     
     BYTE    rgbTms[4];
     DWORD   cbitDlySet;
@@ -813,104 +850,35 @@ FSendTwoPartCmd( HIF hif, BYTE cmd, BYTE op ) {
         return fFalse;
     }
     
-    /* Send the first part of the command (op code). The bit sequence to
-    ** send the command depends on both the current tap state (assumed to
-    ** be RTI) and the number of times (0-31) that we must pass through the
-    ** SDR state.
+    /* Add the TMS moves of both parts of the command to the TAP model.
+    ** The moves needed for each part depend on both the current tap
+    ** state (assumed to be RTI) and the number of times (0-31) that we
+    ** must pass through the SDR state.
     */
-    if ( 0 < cmd ) {
-        
-        /* Assume we are in the RTI state, pass through SELDR, CDR, and
-        ** park in SDR.
-        */
+    if ( ! FCmdPart(cmd) ) {
         
-        rgbTms[0] = 0x01; // RTI->SELDR->CDR->SDR (3-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 3, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP1 bit 0 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
-        
-        /* Re-enter Shift-DR (SDR) cmd - 1 times.
-        */
-        memset(rgbTms, 0, 4*sizeof(BYTE));
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, cmd - 1, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP1 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
-        
-        /* Now exit Shift-DR and park in the RTI state.
-        */
-        rgbTms[0] = 0x03; // SDR->E1DR->UDR->RTI (3-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 3, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP1 UDR failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
+        printf("ERROR: TMS moves for CP1 failed\n");
+        return fFalse;
     }
-    else {
-        
-        /* Assume we are in the RTI state, pass through SELDR, CDR, E1DR,
-        ** UDR, and park in RTI.
-        */
+    
+    if ( ! FCmdPart(op) ) {
         
-        rgbTms[0] = 0x0D; // RTI->SELDR->CDR->E1DR->UDR->RTI (5-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 5, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP1 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
+        printf("ERROR: TMS moves for CP2 failed\n");
+        return fFalse;
     }
     
-    /* Send the second part of the command. The bit sequence required to
-    ** send the operand depends on both the current tap state (RTI) and 
-    ** the number of times (0-31) that we must pass through the SDR state.
+    /* Send both parts of the command, and any TMS moves that the caller
+    ** recorded before them, in one transaction.
     */
-    if ( 0 < op ) {
+    if (( ! FPutTapMoves(pjb) ) || ( ! pjb->FExecute(hif) )) {
         
-        /* Since we are in the RTI state and the operand is greater than 0
-        ** we need to enter the SDR state.
-        */
-        rgbTms[0] = 0x01; // RTI->SELDR->CDR->SDR (3-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 3, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP2 bit 0 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
-        
-        /* Re-enter Shift-DR (SDR) op - 1 times.
-        */
-        memset(rgbTms, 0, 4*sizeof(BYTE));
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, op - 1, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP2 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
-        
-        /* Now exit Shift-DR and park in the RTI state.
-        */
-        rgbTms[0] = 0x03; // SDR->E1DR->UDR->RTI (3-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 3, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP2 RTI failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
-    }
-    else {
-        
-        /* Since we are in the RTI state and the operand is 0 we need to
-        ** make the following state progression:
-        ** RTI->SELDR->CDR->E1DR->UDR->RTI.
-        */
-        rgbTms[0] = 0x0D; // RTI->SELDR->CDR->E1DR->UDR->RTI (5-bits)
-        if ( ! DjtgPutTmsBits(hif, fFalse, rgbTms, NULL, 5, fFalse) ) {
-            
-            printf("ERROR: DjtgPutTmsBits for CP2 failed, erc = %d\n", DmgrGetLastError());
-            return fFalse;
-        }
+        printf("ERROR: DjtgBatch for the two part command failed, erc = %d\n", DmgrGetLastError());
+        pjb->Reset();
+        return fFalse;
     }
     
+    pjb->Reset();
+    
     /* When the target has been or is being configured for the advanced
     ** protocol a check packet specifying the CP_END directive must be
     ** sent following command part 2. The CP_END directive consists of four
@@ -990,6 +958,38 @@ FSendTwoPartCmd( HIF hif, BYTE cmd, BYTE op ) {
     return fTrue;
 }
 
+/* ------------------------------------------------------------ */
+/***    FCmdPart
+**
+**  Parameters:
+**      csdr    - number of times (0-31) to pass through the SDR state
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      This function adds the TMS moves of one part of a two part
+**      command to the TAP model. A part with a count of 0 makes the
+**      progression RTI->SELDR->CDR->E1DR->UDR->RTI. Otherwise SDR is
+**      entered, re-entered csdr - 1 times, and left for RTI.
+**
+**  Notes:
+**      This function assumes that the TAP controller is currently in the
+**      RTI state, and leaves it there.
+*/
+BOOL
+FCmdPart( BYTE csdr ) {
+    
+    if ( 0 == csdr ) {
+        
+        return tap.FMoveTo(tpsUpdDR) && tap.FMoveTo(tpsRTI);
+    }
+    
+    return tap.FMoveTo(tpsShDR) && tap.FHold(csdr - 1) && tap.FMoveTo(tpsRTI);
+}
+
 /* ------------------------------------------------------------ */
 /***    FParseArguments
 **
@@ -0,0 +1,622 @@
+/************************************************************************/
+/*                                                                      */
+/*  DspiCal.cpp  --  DspiCal main program                               */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DspiCal is a tool that finds the fastest reliable SPI clock of  */
+/*  a DSPI port and the smallest delays that still work at that clock.  */
+/*  The results are stored under the serial number of the device, and   */
+/*  applications such as DspiFlash apply them when they open it.        */
+/*                                                                      */
+/*  The calibration is done by the SpiCal module in the "common"        */
+/*  directory.                                                          */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a DSPI port, either with MOSI connected to   */
+/*  MISO or connected to a slave that returns a fixed response to a     */
+/*  command.                                                            */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dspi.h"
+#include "SpiCal.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 256;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-p           ", "DSPI port (default 0)"},
+    {"-resp        ", "use the response to command <hex> as signature"},
+    {"-n           ", "bytes compared per transfer"},
+    {"-t           ", "transfers per test point"},
+    {"-budget      ", "bit errors allowed per test point (default 0)"},
+    {"-min         ", "lowest SPI clock in Hz"},
+    {"-max         ", "highest SPI clock in Hz"},
+    {"-margin      ", "percent taken off the clock found"},
+    {"-f           ", "calibration file (default ~/" szScFileDefault ")"},
+    {"-show        ", "show the stored settings"},
+    {"-nosave      ", "don't store the settings found"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fShow;
+BOOL    fNoSave;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+INT32   prtReq;
+SCPARAM scp;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FCalibrate(HIF hif, DWORD dprp, const char * szSn);
+void    ShowResult(const SCRESULT * pscr, DWORD dprp);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseHex( const char * sz, BYTE * rgb, DWORD cbMax, DWORD * pcb );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF         hif;
+    INT32       cprt;
+    DWORD       dprp;
+    SCRESULT    scr;
+    char        szSn[cchSnMax + 1];
+    BOOL        fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if (( '\0' == szFile[0] ) && ( ! FSpiCalPath(szFile, sizeof(szFile)) )) {
+
+        printf("ERROR: unable to determine the calibration file\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! FSpiCalGetSerial(hif, szSn) ) {
+
+        printf("ERROR: unable to get the serial number, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if (( ! DspiGetPortCount(hif, &cprt) ) || ( prtReq >= cprt )) {
+
+        printf("ERROR: device doesn't have DSPI port %d\n", prtReq);
+        goto lErrorExit;
+    }
+
+    if ( ! DspiGetPortProperties(hif, prtReq, &dprp) ) {
+
+        printf("ERROR: unable to get the port properties, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( fShow ) {
+
+        if ( ! FSpiCalLoad(szFile, szSn, prtReq, &scr) ) {
+
+            printf("No settings stored for %s port %d in \"%s\"\n", szSn, prtReq, szFile);
+            goto lErrorExit;
+        }
+
+        printf("Settings stored for %s port %d:\n", szSn, prtReq);
+        ShowResult(&scr, dprp);
+        fSuccess = fTrue;
+        goto lErrorExit;
+    }
+
+    if ( ! DspiEnableEx(hif, prtReq) ) {
+
+        printf("ERROR: unable to enable DSPI, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    DspiSetSpiMode(hif, 0, fFalse);
+
+    fSuccess = FCalibrate(hif, dprp, szSn);
+
+    DspiDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCalibrate
+**
+**  Parameters:
+**      hif     - device with DSPI enabled
+**      dprp    - properties of the port
+**      szSn    - serial number of the device
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Calibrate the port, report the results and store them.
+*/
+BOOL
+FCalibrate( HIF hif, DWORD dprp, const char * szSn ) {
+
+    SpiCal      sc;
+    SCRESULT    scr;
+
+    if ( ! ( dprp & dprpSpiSetSpeed ) ) {
+        printf("Port %d has a fixed clock, only the delays are calibrated\n", prtReq);
+    }
+
+    printf("Calibrating %s port %d, %s signature, %d x %d bytes per test point\n",
+           szSn, prtReq, ( sigkLoopback == scp.sigk ) ? "loopback" : "response",
+           scp.ctrial, scp.cbSig);
+
+    sc.Init(hif, dprp);
+
+    if ( ! sc.FRun(&scp, &scr) ) {
+
+        printf("ERROR: calibration failed after %d test points\n", scr.ctest);
+        printf("       check the signature passes at %d Hz\n", scp.frqMin);
+        return fFalse;
+    }
+
+    printf("Calibration done after %d test points, %d bit errors at the last\n",
+           scr.ctest, scr.cbitErr);
+    ShowResult(&scr, dprp);
+
+    if ( fNoSave ) {
+        return fTrue;
+    }
+
+    if ( ! FSpiCalSave(szFile, szSn, prtReq, &scr) ) {
+
+        printf("ERROR: unable to write \"%s\"\n", szFile);
+        return fFalse;
+    }
+
+    printf("Settings stored in \"%s\"\n", szFile);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    ShowResult
+**
+**  Parameters:
+**      pscr    - settings
+**      dprp    - properties of the port
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Print calibrated settings.
+*/
+void
+ShowResult( const SCRESULT * pscr, DWORD dprp ) {
+
+    printf("  Clock:          %d Hz\n", pscr->frqSck);
+
+    if ( dprp & dprpSpiDelay ) {
+        printf("  Byte delay:     %d us\n", pscr->tusDelay);
+    }
+
+    if ( dprp & dprpSpiStartEndDelay ) {
+        printf("  Start delay:    %d us\n", pscr->tusStart);
+        printf("  End delay:      %d us\n", pscr->tusEnd);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseHex
+**
+**  Parameters:
+**      sz      - string of hexadecimal digit pairs, may be NULL
+**      rgb     - receives the bytes
+**      cbMax   - size of rgb
+**      pcb     - receives the number of bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a command given as hexadecimal digits, e.g. "9F".
+*/
+BOOL
+FParseHex( const char * sz, BYTE * rgb, DWORD cbMax, DWORD * pcb ) {
+
+    char    szByte[3];
+    char *  pchEnd;
+    DWORD   cch;
+
+    if (( NULL == sz ) || ( 0 == (cch = strlen(sz)) ) || ( 0 != cch % 2 ) ||
+        ( cbMax < cch / 2 )) {
+
+        printf("ERROR: invalid command specified\n");
+        return fFalse;
+    }
+
+    szByte[2] = '\0';
+    for ( *pcb = 0; *pcb < cch / 2; (*pcb)++ ) {
+
+        szByte[0] = sz[2 * *pcb];
+        szByte[1] = sz[2 * *pcb + 1];
+        rgb[*pcb] = (BYTE)strtoul(szByte, &pchEnd, 16);
+
+        if ( '\0' != *pchEnd ) {
+
+            printf("ERROR: invalid command specified: %s\n", sz);
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+    BOOL    fSig;
+
+    fDevName = fFalse;
+    fShow = fFalse;
+    fNoSave = fFalse;
+    fShowHelp = fFalse;
+    fSig = fFalse;
+    szFile[0] = '\0';
+    prtReq = 0;
+    SpiCalDefaults(&scp);
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-p") ) {
+
+            if ( ! FParseNumber(szVal, "port", (DWORD *)&prtReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-resp") ) {
+
+            if ( ! FParseHex(szVal, scp.rgbCmd, cbScCmdMax, &scp.cbCmd) ) {
+                return fFalse;
+            }
+            scp.sigk = sigkResponse;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-n") ) {
+
+            if ( ! FParseNumber(szVal, "byte count", &scp.cbSig) ) {
+                return fFalse;
+            }
+            fSig = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-t") ) {
+
+            if ( ! FParseNumber(szVal, "transfer count", &scp.ctrial) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-budget") ) {
+
+            if ( ! FParseNumber(szVal, "error budget", &scp.cbitErrMax) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-min") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &scp.frqMin) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-max") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &scp.frqMax) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-margin") ) {
+
+            if ( ! FParseNumber(szVal, "margin", &scp.pctMargin) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-show") ) {
+            fShow = fTrue;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-nosave") ) {
+            fNoSave = fTrue;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    /* A fixed response such as an ID is usually short, and the bytes
+    ** after it are often undefined.
+    */
+    if (( sigkResponse == scp.sigk ) && ( ! fSig )) {
+        scp.cbSig = 3;
+    }
+
+    if (( 0 == scp.cbSig ) || ( 0 == scp.ctrial ) || ( 0 == scp.frqMin ) ||
+        ( scp.frqMax < scp.frqMin ) || ( 100 <= scp.pctMargin )) {
+
+        printf("ERROR: invalid calibration parameters specified\n");
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -d <device> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
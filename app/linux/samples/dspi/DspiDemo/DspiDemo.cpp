@@ -14,6 +14,7 @@
 /*  Revision History:													*/
 /*																		*/
 /*	03/16/2010(AaronO): created											*/
+/*	10/19/2026: added the register sweep action using SpiBatch			*/
 /*																		*/
 /************************************************************************/
 
@@ -43,6 +44,7 @@
 #include "dpcdecl.h"
 #include "dmgr.h"
 #include "dspi.h"
+#include "SpiBatch.h"
 
 /* ------------------------------------------------------------ */
 /*				Local Type and Constant Definitions				*/
@@ -70,6 +72,7 @@ char szCount[cchSzLen];
 BOOL fPutByte;
 BOOL fPut;
 BOOL fGet;
+BOOL fSweep;
 
 BOOL fDvc;
 BOOL fString;
@@ -85,6 +88,7 @@ void ShowUsage(char* szProgName);
 void DoPutByte();
 void DoPut();
 void DoGet();
+void DoSweep();
 void ErrorExit();
 
 void StrcpyS( char* szDst, size_t cchDst, const char* szSrc );
@@ -134,6 +138,9 @@ int main(int cszArg, char* rgszArg[]) {
 	else if( fGet ) {
 		DoGet();
 	}
+	else if( fSweep ) {
+		DoSweep();
+	}
 	else {
 		printf("Error: No action specified\n");
 		ShowUsage(rgszArg[0]);
@@ -289,6 +296,86 @@ void DoGet() {
 	free(rgbRcv);
 }
 
+/* ------------------------------------------------------------ */
+/***	DoSweep
+**
+**	Synopsis
+**		void DoSweep()
+**
+**	Input:
+**		none
+**
+**	Output:
+**		none
+**
+**	Errors:
+**		none
+**
+**	Description:
+**		Reads a range of registers the way a driver would sweep the
+**		register map of a sensor: one transaction per register, each
+**		made up of a command byte followed by one data byte. The
+**		transactions are recorded in a SpiBatch, which sends each one
+**		with a single call and keeps the calls overlapped, instead of
+**		calling DspiPutByte for every byte. Expects MOSI and MISO to be
+**		shorted, so the command bytes are echoed back and every register
+**		reads as the fill byte.
+*/
+void DoSweep() {
+
+	SpiBatch	sb;
+	BYTE		bFill;
+	BYTE*		rgbCmd;
+	BYTE*		rgbVal;
+	int			creg;
+	bool		fFail = false;
+
+	bFill = atoi(szByte);
+	creg = atoi(szCount);
+
+	if( creg <= 0 ) {
+		printf("Error: Register count must be greater than 0\n");
+		ErrorExit();
+	}
+
+	rgbCmd = (BYTE*) malloc(creg);
+	rgbVal = (BYTE*) malloc(creg);
+
+	for(int ireg=0; ireg<creg; ireg++) {
+		sb.FSelect();
+		sb.FPutByte(0x80 | (ireg & 0x7F), &rgbCmd[ireg]);
+		sb.FGet(&rgbVal[ireg], 1, bFill);
+		sb.FDeselect();
+	}
+
+	printf("Compiled %d transactions into %d calls (%d calls to DspiPutByte)\n",
+			creg, (int)sb.CsegCompiled(), 2*creg);
+
+	// DSPI API Calls: DspiPut, DspiGet
+	if(!sb.FExecute(hif)) {
+		printf("Error: SpiBatch execution failed\n");
+		free(rgbCmd);
+		free(rgbVal);
+		ErrorExit();
+	}
+
+	for(int ireg=0; ireg<creg; ireg++) {
+		if(rgbCmd[ireg] != (0x80 | (ireg & 0x7F)) || rgbVal[ireg] != bFill) {
+			fFail = true;
+		}
+	}
+
+	if( fFail ) {
+		printf("Warning: Recieved data did not match sent data. Ensure MOSI and MISO are shorted.\n");
+	}
+	else {
+		printf("Success: Recieved data matched sent data.\n");
+	}
+
+	free(rgbCmd);
+	free(rgbVal);
+}
+
 /* ------------------------------------------------------------ */
 /***	FParseParam
 **
@@ -316,6 +403,7 @@ FParseParam(int cszArg, char* rgszArg[]) {
 	fPutByte	= fFalse;
 	fPut		= fFalse;
 	fGet		= fFalse;
+	fSweep		= fFalse;
 	fCount		= fFalse;
 
 	// Ensure sufficient paramaters. Need at least program name, action flag, device flag,
@@ -337,6 +425,9 @@ FParseParam(int cszArg, char* rgszArg[]) {
 	else if( strcmp(rgszArg[1], "-g") == 0) {
 		fGet = fTrue;
 	}
+	else if( strcmp(rgszArg[1], "-s") == 0) {
+		fSweep = fTrue;
+	}
 	else { // unrecognized action
 		return fFalse;
 	}
@@ -416,7 +507,7 @@ FParseParam(int cszArg, char* rgszArg[]) {
 		printf("Error: No string specified\n");
 		return fFalse;
 	}
-	if( fGet && ( !fCount || !fByte )  ) {
+	if( ( fGet || fSweep ) && ( !fCount || !fByte )  ) {
 		printf("Error: Count or byte was unspecified\n");
 		return fFalse;
 	}
@@ -450,6 +541,7 @@ void ShowUsage(char* szProgName) {
 	printf("\t-pb	Put Byte\tRequires -b <byte>\n");
 	printf("\t-p	Put     \tRequires -str <string>\n");
 	printf("\t-g	Get     \tRequires -c <# bytes> and -b <fill byte>\n");
+	printf("\t-s	Sweep   \tRequires -c <# registers> and -b <fill byte>\n");
 }
 
 
@@ -0,0 +1,904 @@
+/************************************************************************/
+/*                                                                      */
+/*  DspiFlash.cpp  --  DspiFlash main program                           */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DspiFlash is a tool for reading, erasing and programming serial */
+/*  NOR flash parts attached to a DSPI port. The work is done by the    */
+/*  SpiFlash engine in the "common" directory.                          */
+/*                                                                      */
+/*  When "-sim" is specified the tool runs against the SpiFlashSim      */
+/*  model instead of a device. The times reported are then taken from   */
+/*  the model's clock and reflect the SPI clock rate and the busy times */
+/*  of the part, but not the USB overhead of a real device.             */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent device with a DSPI port connected to a serial flash, or  */
+/*  none when "-sim" is used.                                           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*  10/19/2026: apply the settings stored by DspiCal                    */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dspi.h"
+#include "SpiBatch.h"
+#include "SpiCal.h"
+#include "SpiFlash.h"
+#include "SpiFlashSim.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchFileMax = 256;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* Actions.
+*/
+const   int     actNone = 0;
+const   int     actId = 1;
+const   int     actRead = 2;
+const   int     actWrite = 3;
+const   int     actVerify = 4;
+const   int     actErase = 5;
+const   int     actBench = 6;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-sim         ", "use a simulated flash instead of a device"},
+    {"-id          ", "read the JEDEC ID of the part"},
+    {"-read        ", "read <n> bytes at the address into file <f>"},
+    {"-write       ", "program file <f> at the address and verify it"},
+    {"-verify      ", "compare the part with file <f>"},
+    {"-erase       ", "erase the sectors covering <n> bytes"},
+    {"-bench       ", "program <n> MB of random data twice"},
+    {"-a           ", "flash address (default 0)"},
+    {"-n           ", "number of bytes"},
+    {"-f           ", "file name"},
+    {"-speed       ", "SPI clock frequency in Hz, instead of DspiCal's"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fSim;
+BOOL    fShowHelp;
+int     act;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szFile[cchFileMax + 1];
+DWORD   ibFlash;
+DWORD   cbReq;
+DWORD   frqReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static SpiFlash     sf;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FRunAction();
+BOOL    FDoRead();
+BOOL    FDoWrite();
+BOOL    FDoVerify();
+BOOL    FDoBench();
+BOOL    FProgramImage(const BYTE * pb, DWORD cb);
+void    ApplyCalibration(HIF hif);
+BYTE *  PbReadFile(DWORD * pcb);
+void    ShowStats(const SFSTATS * psfs, DWORD cb);
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF             hif;
+    SpiFlashSim     sfs;
+    SFSSTATS        sfss;
+    DWORD           frqSet;
+    BOOL            fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    if ( actNone == act ) {
+
+        printf("ERROR: no action specified\n");
+        return 1;
+    }
+
+    if ( fSim ) {
+
+        if ( ! sfs.FInit(idSfsMfgDefault, idSfsTypeDefault, idSfsCapDefault) ) {
+
+            printf("ERROR: unable to create the simulated flash\n");
+            return 1;
+        }
+
+        sfs.SetSpeed(frqReq);
+        printf("Using a simulated flash with a %d Hz SPI clock\n", sfs.FrqSpeed());
+
+        sf.Init(&sfs);
+        fSuccess = FRunAction();
+
+        sfs.GetStats(&sfss);
+        printf("Simulated part: %d programs, %d erases, %d commands ignored while busy\n",
+               sfss.cprogram, sfss.cerase, sfss.cignored);
+
+        return fSuccess ? 0 : 1;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        return 1;
+    }
+
+    if ( ! DspiEnable(hif) ) {
+
+        printf("ERROR: unable to enable DSPI, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( 0 != frqReq ) {
+
+        if ( DspiSetSpeed(hif, frqReq, &frqSet) ) {
+            printf("SPI clock set to %d Hz\n", frqSet);
+        }
+    }
+    else {
+        ApplyCalibration(hif);
+    }
+
+    /* Flash parts sample on the rising edge and shift out most
+    ** significant bit first.
+    */
+    DspiSetSpiMode(hif, 0, fFalse);
+
+    sf.Init(hif);
+    fSuccess = FRunAction();
+
+    DspiDisable(hif);
+
+lErrorExit:
+
+    DmgrClose(hif);
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    ApplyCalibration
+**
+**  Parameters:
+**      hif     - device with DSPI enabled on port 0
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Apply the clock and delays stored for the device by DspiCal, if
+**      it has been calibrated.
+*/
+void
+ApplyCalibration( HIF hif ) {
+
+    SCRESULT    scr;
+    DWORD       dprp;
+    char        szSn[cchSnMax + 1];
+    char        szPath[cchFileMax + 1];
+
+    if (( ! FSpiCalGetSerial(hif, szSn) ) ||
+        ( ! FSpiCalPath(szPath, sizeof(szPath)) ) ||
+        ( ! FSpiCalLoad(szPath, szSn, 0, &scr) )) {
+        return;
+    }
+
+    if (( DspiGetPortProperties(hif, 0, &dprp) ) && ( FSpiCalApply(hif, dprp, &scr) )) {
+        printf("SPI clock set to %d Hz from the calibration of %s\n", scr.frqSck, szSn);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FRunAction
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Detect the part and perform the requested action.
+*/
+BOOL
+FRunAction() {
+
+    SFINFO  sfi;
+
+    if ( ! sf.FDetect(&sfi) ) {
+
+        printf("ERROR: no flash detected, JEDEC ID %02X %02X %02X\n",
+               sfi.idMfg, sfi.idType, sfi.idCap);
+        return fFalse;
+    }
+
+    printf("Found %s flash, JEDEC ID %02X %02X %02X, %d KB\n",
+           sfi.szMfg, sfi.idMfg, sfi.idType, sfi.idCap, sfi.cbFlash / 1024);
+
+    switch ( act ) {
+
+        case actRead:
+            return FDoRead();
+
+        case actWrite:
+            return FDoWrite();
+
+        case actVerify:
+            return FDoVerify();
+
+        case actErase:
+            if ( ! sf.FErase(ibFlash, cbReq) ) {
+
+                printf("ERROR: erase failed\n");
+                return fFalse;
+            }
+
+            printf("Erased %d bytes at 0x%06X\n", cbReq, ibFlash);
+            return fTrue;
+
+        case actBench:
+            return FDoBench();
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDoRead
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read a region of the part into a file.
+*/
+BOOL
+FDoRead() {
+
+    BYTE *  pb;
+    FILE *  pfile;
+    BOOL    fSuccess;
+
+    pb = (BYTE *)malloc(( 0 != cbReq ) ? cbReq : 1);
+    if ( NULL == pb ) {
+
+        printf("ERROR: unable to allocate memory\n");
+        return fFalse;
+    }
+
+    fSuccess = fFalse;
+
+    if ( ! sf.FRead(ibFlash, pb, cbReq) ) {
+
+        printf("ERROR: read failed\n");
+        goto lErrorExit;
+    }
+
+    pfile = fopen(szFile, "wb");
+    if (( NULL == pfile ) || ( cbReq != fwrite(pb, 1, cbReq, pfile) )) {
+
+        printf("ERROR: unable to write \"%s\"\n", szFile);
+        if ( NULL != pfile ) {
+            fclose(pfile);
+        }
+        goto lErrorExit;
+    }
+
+    fclose(pfile);
+    printf("Read %d bytes at 0x%06X into \"%s\"\n", cbReq, ibFlash, szFile);
+    fSuccess = fTrue;
+
+lErrorExit:
+
+    free(pb);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDoWrite
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Program a file into the part.
+*/
+BOOL
+FDoWrite() {
+
+    BYTE *  pb;
+    DWORD   cb;
+    BOOL    fSuccess;
+
+    pb = PbReadFile(&cb);
+    if ( NULL == pb ) {
+        return fFalse;
+    }
+
+    fSuccess = FProgramImage(pb, cb);
+
+    free(pb);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDoVerify
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue if the part matches the file, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Compare the part with a file.
+*/
+BOOL
+FDoVerify() {
+
+    BYTE *  pb;
+    DWORD   cb;
+    DWORD   cpageBad;
+    BOOL    fSuccess;
+
+    pb = PbReadFile(&cb);
+    if ( NULL == pb ) {
+        return fFalse;
+    }
+
+    fSuccess = sf.FVerify(ibFlash, pb, cb, &cpageBad);
+    free(pb);
+
+    if ( ! fSuccess ) {
+
+        printf("ERROR: read failed\n");
+        return fFalse;
+    }
+
+    if ( 0 != cpageBad ) {
+
+        printf("Verify failed: %d pages differ\n", cpageBad);
+        return fFalse;
+    }
+
+    printf("Verify passed\n");
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FDoBench
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Program a random image, then program the same image again to
+**      show the cost of a programming run that has nothing to do.
+*/
+BOOL
+FDoBench() {
+
+    BYTE *  pb;
+    DWORD   cb;
+    DWORD   ib;
+    DWORD   dwSeed;
+    BOOL    fSuccess;
+
+    cb = cbReq * 1024 * 1024;
+    if (( 0 == cb ) || ( sf.CbFlash() < cb ) || ( sf.CbFlash() - cb < ibFlash )) {
+
+        printf("ERROR: benchmark doesn't fit in the part\n");
+        return fFalse;
+    }
+
+    pb = (BYTE *)malloc(cb);
+    if ( NULL == pb ) {
+
+        printf("ERROR: unable to allocate memory\n");
+        return fFalse;
+    }
+
+    dwSeed = 0x12345678;
+    for ( ib = 0; ib < cb; ib++ ) {
+
+        dwSeed = dwSeed * 1103515245 + 12345;
+        pb[ib] = (BYTE)(dwSeed >> 16);
+    }
+
+    printf("\nFirst pass:\n");
+    fSuccess = FProgramImage(pb, cb);
+
+    if ( fSuccess ) {
+
+        printf("\nSecond pass with the same image:\n");
+        fSuccess = FProgramImage(pb, cb);
+    }
+
+    free(pb);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FProgramImage
+**
+**  Parameters:
+**      pb      - image
+**      cb      - size of the image
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Program an image at ibFlash and report the statistics.
+*/
+BOOL
+FProgramImage( const BYTE * pb, DWORD cb ) {
+
+    SFSTATS sfs;
+    BOOL    fSuccess;
+
+    fSuccess = sf.FProgram(ibFlash, pb, cb, &sfs);
+    ShowStats(&sfs, cb);
+
+    if ( ! fSuccess ) {
+
+        if ( 0 != sfs.cpageBad ) {
+            printf("ERROR: %d pages failed to verify\n", sfs.cpageBad);
+        }
+        else {
+            printf("ERROR: programming failed\n");
+        }
+    }
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    ShowStats
+**
+**  Parameters:
+**      psfs    - statistics of a programming run
+**      cb      - size of the image
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Print the work done and the time taken per megabyte.
+*/
+void
+ShowStats( const SFSTATS * psfs, DWORD cb ) {
+
+    double  secTotal;
+    double  cmb;
+
+    secTotal = psfs->secCompare + psfs->secErase + psfs->secProgram + psfs->secVerify;
+    cmb = (double)cb / (1024.0 * 1024.0);
+
+    printf("  Pages:    %d total, %d skipped, %d programmed, %d retried\n",
+           psfs->cpageTotal, psfs->cpageSkipped, psfs->cpageProgrammed, psfs->cpageRetried);
+    printf("  Erases:   %d sectors, %d blocks\n", psfs->csectorErased, psfs->cblockErased);
+    printf("  Compare:  %8.3f s\n", psfs->secCompare);
+    printf("  Erase:    %8.3f s\n", psfs->secErase);
+    printf("  Program:  %8.3f s\n", psfs->secProgram);
+    printf("  Verify:   %8.3f s\n", psfs->secVerify);
+    printf("  Total:    %8.3f s for %.2f MB, %.3f s/MB\n", secTotal, cmb, secTotal / cmb);
+}
+
+/* ------------------------------------------------------------ */
+/***    PbReadFile
+**
+**  Parameters:
+**      pcb     - receives the size of the file
+**
+**  Return Values:
+**      contents of the file, to be freed by the caller, or NULL
+**
+**  Errors:
+**
+**  Description:
+**      Read the file given with "-f".
+*/
+BYTE *
+PbReadFile( DWORD * pcb ) {
+
+    FILE *  pfile;
+    BYTE *  pb;
+    long    cb;
+
+    pfile = fopen(szFile, "rb");
+    if ( NULL == pfile ) {
+
+        printf("ERROR: unable to open \"%s\"\n", szFile);
+        return NULL;
+    }
+
+    fseek(pfile, 0, SEEK_END);
+    cb = ftell(pfile);
+    fseek(pfile, 0, SEEK_SET);
+
+    if (( 0 >= cb ) || ( (long)cbsfMax < cb )) {
+
+        printf("ERROR: \"%s\" is empty or too large\n", szFile);
+        fclose(pfile);
+        return NULL;
+    }
+
+    pb = (BYTE *)malloc(cb);
+    if (( NULL == pb ) || ( (size_t)cb != fread(pb, 1, cb, pfile) )) {
+
+        printf("ERROR: unable to read \"%s\"\n", szFile);
+        free(pb);
+        fclose(pfile);
+        return NULL;
+    }
+
+    fclose(pfile);
+    *pcb = (DWORD)cb;
+
+    return pb;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+    BOOL    fFile;
+
+    fDevName = fFalse;
+    fSim = fFalse;
+    fShowHelp = fFalse;
+    fFile = fFalse;
+    act = actNone;
+    ibFlash = 0;
+    cbReq = 0;
+    frqReq = 0;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if (( NULL == szVal ) || ( cchFileMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid file name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szFile, szVal);
+            fFile = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-a") ) {
+
+            if ( ! FParseNumber(szVal, "address", &ibFlash) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-n") ) {
+
+            if ( ! FParseNumber(szVal, "byte count", &cbReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-speed") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-bench") ) {
+
+            if ( ! FParseNumber(szVal, "size", &cbReq) ) {
+                return fFalse;
+            }
+            act = actBench;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-sim") ) {
+            fSim = fTrue;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-id") ) {
+            act = actId;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-read") ) {
+            act = actRead;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-write") ) {
+            act = actWrite;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-verify") ) {
+            act = actVerify;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-erase") ) {
+            act = actErase;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    if ((( actRead == act ) || ( actWrite == act ) || ( actVerify == act )) && ( ! fFile )) {
+
+        printf("ERROR: you must specify a file using the \"-f\" option\n");
+        return fFalse;
+    }
+
+    if ((( actRead == act ) || ( actErase == act )) && ( 0 == cbReq )) {
+
+        printf("ERROR: you must specify a byte count using the \"-n\" option\n");
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] <action> [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
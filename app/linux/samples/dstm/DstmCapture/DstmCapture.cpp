@@ -0,0 +1,928 @@
+/************************************************************************/
+/*                                                                      */
+/*  DstmCapture.cpp  --  DstmCapture main program                       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DstmCapture is a tool for capturing a continuous stream of data */
+/*  from a device to disk. The data is read with DstmIO, or with        */
+/*  DeppGetRegRepeat from a single EPP register when the "-epp" option  */
+/*  is given.                                                           */
+/*                                                                      */
+/*  Reading from the device and writing to disk are done by separate    */
+/*  threads so that a slow disk never stalls the USB transfers:         */
+/*      1. The transfer thread takes a buffer from a BufPool, fills it  */
+/*         from the device and pushes it onto a lock-free single        */
+/*         producer, single consumer queue.                             */
+/*      2. The writer thread pops buffers from the queue and writes     */
+/*         them to disk through io_uring, keeping many writes in        */
+/*         flight. Files are opened with O_DIRECT, so the data goes     */
+/*         straight from the pool's page aligned buffers to the disk.   */
+/*         Each buffer is returned to the pool when its write is done.  */
+/*                                                                      */
+/*  If the writer falls so far behind that the pool runs empty, the     */
+/*  transfer thread keeps reading from the device into a scratch buffer */
+/*  so that the device never overflows, and counts the data as dropped. */
+/*  Drops, queue depth and pool usage are reported once per second.     */
+/*                                                                      */
+/*  The output is split into files named <prefix>_NNNNN.bin, starting a */
+/*  new file when the current one reaches a size limit or age limit.    */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent FPGA board that supports DSTM (or DEPP when "-epp" is    */
+/*  used), configured with a design that supplies the data to capture.  */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <pthread.h>
+	#include <signal.h>
+	#include <time.h>
+	#include <unistd.h>
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <atomic>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dstm.h"
+#include "depp.h"
+#include "BufPool.h"
+#include "SpscQueue.h"
+#include "UringWriter.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+const   DWORD   cchPrefixMax = 240;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* Defaults for the command line options.
+*/
+const   DWORD   cbufDefault = 256;
+const   DWORD   cmbRotateDefault = 1024;
+
+/* Number of writes the writer thread keeps in flight.
+*/
+const   DWORD   ciouWriter = 32;
+
+/* Time the writer thread sleeps when it has nothing to do.
+*/
+const   DWORD   usWriterIdle = 200;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-o           ", "output file prefix (default \"capture\")"},
+    {"-epp         ", "read EPP register <n> instead of using DSTM"},
+    {"-t           ", "capture time in seconds (default until Ctrl-C)"},
+    {"-rsize       ", "start a new file every <n> MB (default 1024)"},
+    {"-rtime       ", "start a new file every <n> seconds"},
+    {"-cb          ", "bytes per transfer (default suits the transport)"},
+    {"-nbuf        ", "number of transfer buffers (default 256)"},
+    {"-nouring     ", "write with pwrite instead of io_uring"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fEpp;
+BOOL    fNoUring;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+char    szPrefix[cchPrefixMax + 1];
+BYTE    regEpp;
+DWORD   secRun;
+DWORD   cmbRotate;
+DWORD   secRotate;
+DWORD   cbXferReq;
+DWORD   cbufReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+/* State shared between the transfer thread and the writer thread.
+*/
+static BufPool                  bpool;
+static SpscQueue<BYTE *>        queFull;
+static DWORD                    cbXfer;
+
+static std::atomic<BOOL>        fXferDone;
+static std::atomic<BOOL>        fWriteError;
+static std::atomic<UINT64>      cbWritten;
+static std::atomic<DWORD>       cfileWritten;
+
+/* Writer thread results, valid after the thread has been joined.
+*/
+static BOOL                     fDirectIO;
+static BOOL                     fUringIO;
+static int                      errWrite;
+
+static volatile sig_atomic_t    fStop;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FCapture( HIF hif );
+BOOL    FXfer( HIF hif, BYTE * pb );
+void *  WriterThread( void * pv );
+int     FdOpenNext( DWORD ifile );
+BOOL    FCompleteWrite( const IOCMP * pioc );
+void    StopHandler( int sig );
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF     hif;
+    BOOL    fEnabled;
+    BOOL    fSuccess;
+
+    hif = hifInvalid;
+    fEnabled = fFalse;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    /* Attempt to open the device and enable the port used for capture.
+    */
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        goto lErrorExit;
+    }
+
+    if ( ! (fEpp ? DeppEnable(hif) : DstmEnable(hif)) ) {
+
+        printf("ERROR: unable to enable %s, erc = %d\n", fEpp ? "DEPP" : "DSTM", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    fEnabled = fTrue;
+
+    /* Transfers must be a multiple of the buffer alignment for O_DIRECT.
+    */
+    cbXfer = ( 0 != cbXferReq ) ? cbXferReq : CbBestTransfer(hif);
+    cbXfer = (cbXfer + cbBufAlign - 1) & ~(cbBufAlign - 1);
+
+    fSuccess = FCapture(hif);
+
+lErrorExit:
+
+    if ( fEnabled ) {
+
+        if ( fEpp ) {
+            DeppDisable(hif);
+        }
+        else {
+            DstmDisable(hif);
+        }
+    }
+
+    if ( hifInvalid != hif ) {
+        DmgrClose(hif);
+    }
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCapture
+**
+**  Parameters:
+**      hif     - open handle with DSTM or DEPP enabled
+**
+**  Return Values:
+**      fTrue if the capture ran to completion without errors or drops
+**
+**  Errors:
+**
+**  Description:
+**      Start the writer thread and run the transfer loop until the
+**      capture time expires, the user presses Ctrl-C, or an error
+**      occurs.
+*/
+BOOL
+FCapture( HIF hif ) {
+
+    pthread_t   thrWriter;
+    BPSTATS     bps;
+    BYTE *      pb;
+    BYTE *      pbScratch;
+    UINT64      cbXferTotal;
+    UINT64      cbDropped;
+    DWORD       cdrop;
+    DWORD       citmQueueMax;
+    double      secStart;
+    double      secReport;
+    double      secNow;
+    BOOL        fXferError;
+
+    if ( ! bpool.FInit(cbXfer, cbufReq, fbpDefault) ) {
+
+        printf("ERROR: unable to allocate %d buffers of %d bytes\n", cbufReq, cbXfer);
+        return fFalse;
+    }
+
+    bpool.GetStats(&bps);
+    if ( ! bps.fLocked ) {
+        printf("Warning: transfer buffers couldn't be locked into memory\n");
+    }
+
+    /* The queue can hold every buffer in the pool, so a push can only
+    ** fail if something is badly wrong.
+    */
+    if (( ! queFull.FInit(cbufReq) ) ||
+        ( 0 != posix_memalign((void **)&pbScratch, cbBufAlign, cbXfer) )) {
+
+        printf("ERROR: unable to allocate memory\n");
+        return fFalse;
+    }
+
+    fXferDone = fFalse;
+    fWriteError = fFalse;
+    cbWritten = 0;
+    cfileWritten = 0;
+
+    if ( 0 != pthread_create(&thrWriter, NULL, WriterThread, NULL) ) {
+
+        printf("ERROR: unable to start the writer thread\n");
+        free(pbScratch);
+        return fFalse;
+    }
+
+    signal(SIGINT, StopHandler);
+    signal(SIGTERM, StopHandler);
+
+    printf("Capturing %d byte transfers to \"%s_NNNNN.bin\", press Ctrl-C to stop\n",
+           cbXfer, szPrefix);
+
+    cbXferTotal = 0;
+    cbDropped = 0;
+    cdrop = 0;
+    citmQueueMax = 0;
+    fXferError = fFalse;
+    secStart = SecNow();
+    secReport = secStart;
+
+    while ( ! fStop && ! fWriteError ) {
+
+        secNow = SecNow();
+        if (( 0 != secRun ) && ( secNow - secStart >= secRun )) {
+            break;
+        }
+
+        /* Keep reading from the device even when no buffer is free so
+        ** that the device doesn't overflow. That data is dropped.
+        */
+        pb = bpool.PbAlloc();
+
+        if ( ! FXfer(hif, ( NULL != pb ) ? pb : pbScratch) ) {
+
+            printf("\nERROR: transfer failed, erc = %d\n", DmgrGetLastError());
+            bpool.FreeBuf(pb);
+            fXferError = fTrue;
+            break;
+        }
+
+        cbXferTotal += cbXfer;
+
+        if (( NULL == pb ) || ( ! queFull.FPush(pb) )) {
+
+            bpool.FreeBuf(pb);
+            cbDropped += cbXfer;
+            cdrop++;
+        }
+
+        if ( queFull.CitmCur() > citmQueueMax ) {
+            citmQueueMax = queFull.CitmCur();
+        }
+
+        /* Report progress once per second.
+        */
+        if ( secNow - secReport >= 1.0 ) {
+
+            bpool.GetStats(&bps);
+            printf("\r%8.1f s  %10.1f MB  %7.2f MB/s  written %10.1f MB  "
+                   "dropped %llu B (%u)  queue max %u  free min %u  ",
+                   secNow - secStart, cbXferTotal / 1000000.0,
+                   cbXferTotal / ((secNow - secStart) * 1000000.0),
+                   cbWritten.load() / 1000000.0,
+                   (unsigned long long)cbDropped, cdrop,
+                   citmQueueMax, bps.cbufFreeMin);
+            fflush(stdout);
+            secReport = secNow;
+        }
+    }
+
+    /* Let the writer finish what is queued and wait for it.
+    */
+    fXferDone = fTrue;
+    pthread_join(thrWriter, NULL);
+
+    secNow = SecNow();
+    bpool.GetStats(&bps);
+
+    printf("\n");
+    printf("Captured:   %llu bytes in %.1f s (%.2f MB/s)\n",
+           (unsigned long long)cbXferTotal, secNow - secStart,
+           cbXferTotal / ((secNow - secStart) * 1000000.0));
+    printf("Written:    %llu bytes to %u file(s) using %s%s\n",
+           (unsigned long long)cbWritten.load(), cfileWritten.load(),
+           fUringIO ? "io_uring" : "pwrite", fDirectIO ? " and O_DIRECT" : "");
+    printf("Dropped:    %llu bytes in %u transfers\n",
+           (unsigned long long)cbDropped, cdrop);
+    printf("Queue:      %u of %u entries used at most\n",
+           citmQueueMax, queFull.CitmCapacity());
+    printf("Buffers:    %u of %u free at low water mark\n",
+           bps.cbufFreeMin, bps.cbufTotal);
+
+    if ( fWriteError ) {
+        printf("ERROR: write failed: %s\n", strerror(errWrite));
+    }
+
+    free(pbScratch);
+
+    return ! fXferError && ! fWriteError && ( 0 == cdrop );
+}
+
+/* ------------------------------------------------------------ */
+/***    FXfer
+**
+**  Parameters:
+**      hif     - open handle with DSTM or DEPP enabled
+**      pb      - buffer of cbXfer bytes
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Read one transfer from the device.
+*/
+BOOL
+FXfer( HIF hif, BYTE * pb ) {
+
+    if ( fEpp ) {
+        return DeppGetRegRepeat(hif, regEpp, pb, cbXfer, fFalse);
+    }
+
+    return DstmIO(hif, NULL, 0, pb, cbXfer, fFalse);
+}
+
+/* ------------------------------------------------------------ */
+/***    WriterThread
+**
+**  Parameters:
+**      pv      - not used
+**
+**  Return Values:
+**      NULL
+**
+**  Errors:
+**      Write errors set fWriteError, which stops the transfer thread.
+**
+**  Description:
+**      Move buffers from the queue to disk. Writes are queued as long
+**      as there are buffers and free slots, then submitted together.
+**      Before a new file is started every write to the current file is
+**      waited for, so each file is complete when it is closed.
+*/
+void *
+WriterThread( void * pv ) {
+
+    UringWriter uw;
+    IOCMP       ioc;
+    BYTE *      pb;
+    int         fd;
+    DWORD       ifile;
+    UINT64      ibFile;
+    UINT64      cbRotate;
+    double      secFile;
+    BOOL        fProgress;
+
+    (void)pv;
+
+    uw.FInit(ciouWriter, ! fNoUring);
+    fUringIO = uw.FUsingUring();
+
+    cbRotate = (UINT64)cmbRotate * 1024 * 1024;
+    ifile = 0;
+    ibFile = 0;
+    secFile = SecNow();
+
+    fd = FdOpenNext(ifile);
+    if ( 0 > fd ) {
+        goto lErrorExit;
+    }
+
+    while ( ! fWriteError ) {
+
+        fProgress = fFalse;
+
+        while (( uw.CiouInFlight() < uw.CiouDepth() ) && queFull.FPop(&pb) ) {
+
+            /* Start a new file once the current one is big enough or old
+            ** enough.
+            */
+            if (( 0 != ibFile ) &&
+                ((( 0 != cbRotate ) && ( ibFile + cbXfer > cbRotate )) ||
+                 (( 0 != secRotate ) && ( SecNow() - secFile >= secRotate )))) {
+
+                while ( uw.FReap(&ioc, fTrue) ) {
+                    FCompleteWrite(&ioc);
+                }
+
+                close(fd);
+                cfileWritten++;
+
+                ifile++;
+                ibFile = 0;
+                secFile = SecNow();
+
+                fd = FdOpenNext(ifile);
+                if ( 0 > fd ) {
+                    bpool.FreeBuf(pb);
+                    goto lErrorExit;
+                }
+            }
+
+            uw.FQueueWrite(fd, pb, cbXfer, ibFile, pb);
+            ibFile += cbXfer;
+            fProgress = fTrue;
+        }
+
+        if ( ! uw.FSubmit() ) {
+
+            errWrite = errno;
+            fWriteError = fTrue;
+            break;
+        }
+
+        while ( uw.FReap(&ioc, fFalse) ) {
+
+            FCompleteWrite(&ioc);
+            fProgress = fTrue;
+        }
+
+        if ( ! fProgress ) {
+
+            if ( 0 < uw.CiouInFlight() ) {
+
+                if ( uw.FReap(&ioc, fTrue) ) {
+                    FCompleteWrite(&ioc);
+                }
+            }
+            else if ( fXferDone && ( 0 == queFull.CitmCur() )) {
+                break;
+            }
+            else {
+                usleep(usWriterIdle);
+            }
+        }
+    }
+
+    /* Wait for the writes that are still in flight before closing.
+    */
+    while ( uw.FReap(&ioc, fTrue) ) {
+        FCompleteWrite(&ioc);
+    }
+
+    close(fd);
+    cfileWritten++;
+
+lErrorExit:
+
+    /* Return anything left in the queue after an error.
+    */
+    while ( queFull.FPop(&pb) ) {
+        bpool.FreeBuf(pb);
+    }
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------ */
+/***    FdOpenNext
+**
+**  Parameters:
+**      ifile   - index of the file in the capture
+**
+**  Return Values:
+**      file descriptor, or -1 on failure
+**
+**  Errors:
+**      Sets fWriteError and errWrite on failure.
+**
+**  Description:
+**      Create the next output file. O_DIRECT is used unless the file
+**      system doesn't support it.
+*/
+int
+FdOpenNext( DWORD ifile ) {
+
+    char    szFile[cchPrefixMax + 16];
+    int     fd;
+
+    snprintf(szFile, sizeof(szFile), "%s_%05u.bin", szPrefix, ifile);
+
+    fd = open(szFile, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    fDirectIO = ( 0 <= fd );
+
+    if (( 0 > fd ) && ( EINVAL == errno )) {
+        fd = open(szFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if ( 0 > fd ) {
+
+        errWrite = errno;
+        fWriteError = fTrue;
+    }
+
+    return fd;
+}
+
+/* ------------------------------------------------------------ */
+/***    FCompleteWrite
+**
+**  Parameters:
+**      pioc    - completion of a write
+**
+**  Return Values:
+**      fTrue if the whole buffer was written
+**
+**  Errors:
+**      Sets fWriteError and errWrite if the write failed or was short.
+**
+**  Description:
+**      Account for a completed write and return its buffer to the pool.
+*/
+BOOL
+FCompleteWrite( const IOCMP * pioc ) {
+
+    bpool.FreeBuf((BYTE *)pioc->pvUser);
+
+    if ( pioc->res != (INT32)cbXfer ) {
+
+        errWrite = ( 0 > pioc->res ) ? -pioc->res : EIO;
+        fWriteError = fTrue;
+        return fFalse;
+    }
+
+    cbWritten += cbXfer;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    StopHandler
+**
+**  Parameters:
+**      sig     - signal number
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Ask the transfer loop to stop.
+*/
+void
+StopHandler( int sig ) {
+
+    (void)sig;
+    fStop = 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal number from the command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    DWORD   ich;
+
+    if ( NULL == sz ) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    /* Make sure that the string consists entirely of digits 0-9.
+    */
+    for ( ich = 0; '\0' != sz[ich]; ich++ ) {
+
+        if ( 0 == isdigit(sz[ich]) ) {
+
+            printf("ERROR: invalid character detected in %s string: %c\n", szName, sz[ich]);
+            return fFalse;
+        }
+    }
+
+    if ( 0 == ich ) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, NULL, 10);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+    DWORD   dw;
+
+    fDevName = fFalse;
+    fEpp = fFalse;
+    fNoUring = fFalse;
+    fShowHelp = fFalse;
+    strcpy(szPrefix, "capture");
+    regEpp = 0;
+    secRun = 0;
+    cmbRotate = cmbRotateDefault;
+    secRotate = 0;
+    cbXferReq = 0;
+    cbufReq = cbufDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, szVal);
+            fDevName = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-o") ) {
+
+            if (( NULL == szVal ) || ( cchPrefixMax < strlen(szVal) )) {
+
+                printf("ERROR: invalid output file prefix specified\n");
+                return fFalse;
+            }
+
+            strcpy(szPrefix, szVal);
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-epp") ) {
+
+            if ( ! FParseNumber(szVal, "register", &dw) ) {
+                return fFalse;
+            }
+
+            if ( 255 < dw ) {
+
+                printf("ERROR: EPP register must be between 0 and 255\n");
+                return fFalse;
+            }
+
+            regEpp = (BYTE)dw;
+            fEpp = fTrue;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-t") ) {
+
+            if ( ! FParseNumber(szVal, "capture time", &secRun) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-rsize") ) {
+
+            if ( ! FParseNumber(szVal, "file size", &cmbRotate) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-rtime") ) {
+
+            if ( ! FParseNumber(szVal, "file time", &secRotate) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-cb") ) {
+
+            if ( ! FParseNumber(szVal, "transfer size", &cbXferReq) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-nbuf") ) {
+
+            if (( ! FParseNumber(szVal, "buffer count", &cbufReq) ) || ( 0 == cbufReq )) {
+
+                printf("ERROR: at least one buffer is required\n");
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-nouring") ) {
+
+            fNoUring = fTrue;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -15,6 +15,8 @@
 /*  Revision History:													*/
 /*																		*/
 /*	07/21/2010(AaronO): created											*/
+/*	10/19/2026: commit short upload packets immediately					*/
+/*	10/19/2026: transfer a whole bank of the ping-pong memory			*/
 /*																		*/
 /************************************************************************/
 
@@ -44,6 +46,7 @@
 #include "dpcdecl.h"
 #include "dmgr.h"
 #include "dstm.h"
+#include "DstmPkt.h"
 
 /* ------------------------------------------------------------ */
 /*					Local Type and Constant Definitions			*/
@@ -56,7 +59,9 @@ char szDvc[128] = "Nexys2";   // Device name
 /*					Global Variables							*/
 /* ------------------------------------------------------------ */
 
-const int cbTx = 8;
+// The StreamIO memory only returns data from banks that have been filled
+// completely, so the demo transfers exactly one 4096 byte bank.
+const int cbTx = 4096;
 
 /* ------------------------------------------------------------ */
 /*					Local Variables								*/
@@ -64,7 +69,7 @@ const int cbTx = 8;
 HIF hif;
 
 
-BYTE rgbOut[cbTx] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+BYTE rgbOut[cbTx];
 BYTE rgbIn[cbTx];
 BOOL fFail = fFalse;
 
@@ -93,12 +98,23 @@ void ErrorExit();
 int main(void) {
 	int ibTx;
 
+	for(ibTx=0; ibTx<cbTx; ibTx++) {
+		rgbOut[ibTx] = (BYTE)(ibTx + (ibTx >> 8));
+	}
+
 	// DMGR API Call: DmgrOpen
 	if(!DmgrOpen(&hif, szDvc)) {
 		printf("Error: Could not open device %s\n", szDvc);
 		ErrorExit();
 	}
 
+	// Commit short upload packets immediately so that the end of a
+	// transfer isn't held back waiting for a full USB packet. This must be
+	// done before DSTM is enabled.
+	if(!FDstmSetPktPolicy(hif, pktmodeImmediate, 0, 0)) {
+		printf("Warning: could not set the DSTM packet commit policy\n");
+	}
+
 	// DSTM API Call: DstmEnable
 	if(!DstmEnable(hif)) {
 		printf("Error: DstmEnable failed\n");
@@ -132,7 +148,9 @@ int main(void) {
 	if(fFail) {
 		printf("Error: Recieved data did not match transmitted data\n");
 		for(ibTx=0; ibTx<cbTx; ibTx++) {
-			printf("rgbOut[%d]: %d      rgbIn[%d]: %d\n", ibTx, rgbOut[ibTx], ibTx, rgbIn[ibTx]);
+			if(rgbIn[ibTx] != rgbOut[ibTx]) {
+				printf("rgbOut[%d]: %d      rgbIn[%d]: %d\n", ibTx, rgbOut[ibTx], ibTx, rgbIn[ibTx]);
+			}
 		}
 	}
 	else {
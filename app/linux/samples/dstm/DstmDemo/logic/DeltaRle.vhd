@@ -0,0 +1,129 @@
+--------------------------------------------------------------------------------
+-- Module Name:   DeltaRle - Behavioral
+-- Project Name:  StreamIO
+-- Description:
+--    Delta plus run-length encoder for the upload path. The module sits
+--    between the upload port of the data source (Memory) and the upload port
+--    of StmCtrl and uses the same BSY/RD/ACK handshake on both sides.
+--
+--    Each input byte x(i) is replaced by the delta d(i) = x(i) - x(i-1)
+--    (modulo 256, x(-1) = 0). Non-zero deltas are sent as a single byte. A
+--    run of k zero deltas (1 <= k <= 256) is sent as the two byte sequence
+--    0x00, k-1. A zero byte in the encoded stream therefore always starts a
+--    run. Slowly changing inputs compress by up to 128:1; the worst case
+--    (isolated single repeats) expands by 2:1.
+--
+--    The host side decoder is CbDrDecode in samples/common/DeltaRle.cpp.
+--
+--    Throughput is one input byte per IFCLK cycle. The next input byte is
+--    fetched in the same cycle that the last pending output byte is taken,
+--    so literal deltas are passed on without bubbles.
+--------------------------------------------------------------------------------
+-- Revision History:
+--  10/19/2026: created
+--------------------------------------------------------------------------------
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.STD_LOGIC_ARITH.ALL;
+use IEEE.STD_LOGIC_UNSIGNED.ALL;
+
+entity DeltaRle is
+   Port (
+      IFCLK    : in  std_logic;
+
+      RST      : in  std_logic;
+
+      -- upload port of the data source
+      SRCBSY   : in  std_logic;
+      SRCRD    : out std_logic;
+      SRCACK   : in  std_logic;
+      SRCDATA  : in  std_logic_vector(7 downto 0);
+
+      -- encoded upload port towards StmCtrl
+      UPBSY    : out std_logic;
+      UPRD     : in  std_logic;
+      UPACK    : out std_logic;
+      UPDATA   : out std_logic_vector(7 downto 0));
+end DeltaRle;
+
+architecture Behavioral of DeltaRle is
+
+-- Output queue. At most three bytes are produced per input byte (end of a
+-- run followed by a literal delta).
+signal q0, q1, q2 : std_logic_vector(7 downto 0);
+signal cq : integer range 0 to 3;
+
+-- Previous input byte and number of zero deltas that haven't been sent yet.
+signal bPrev : std_logic_vector(7 downto 0);
+signal cRun : integer range 0 to 255;
+
+signal fPop, fFetch, fTake : std_logic;
+signal bDelta : std_logic_vector(7 downto 0);
+
+begin
+
+   -- The encoder never stops the StmCtrl burst; it pauses it with UPACK while
+   -- no encoded byte is available.
+   UPBSY  <= '0';
+   UPACK  <= '1' when cq /= 0 else '0';
+   UPDATA <= q0;
+
+   fPop <= '1' when UPRD = '1' and cq /= 0 else '0';
+
+   -- Fetch a new input byte when StmCtrl is reading and the queue is empty
+   -- or is being emptied in this cycle. Nothing is fetched while StmCtrl
+   -- isn't reading so the encoder doesn't run ahead of the data source.
+   fFetch <= '1' when SRCBSY = '0' and UPRD = '1' and
+                      (cq = 0 or (cq = 1 and fPop = '1'))
+             else '0';
+   SRCRD  <= fFetch;
+   fTake  <= fFetch and SRCACK;
+
+   bDelta <= SRCDATA - bPrev;
+
+   process (IFCLK)
+   begin
+      if rising_edge(IFCLK) then
+         if RST = '0' then
+            cq    <= 0;
+            cRun  <= 0;
+            bPrev <= (others => '0');
+         elsif fTake = '1' then
+
+            -- The queue is empty after this cycle, so the new input byte
+            -- determines its complete contents.
+            bPrev <= SRCDATA;
+            cq    <= 0;
+
+            if bDelta = x"00" then
+               if cRun = 255 then
+                  -- 256 zero deltas, the longest run that can be encoded
+                  q0   <= x"00";
+                  q1   <= x"FF";
+                  cq   <= 2;
+                  cRun <= 0;
+               else
+                  cRun <= cRun + 1;
+               end if;
+            elsif cRun /= 0 then
+               -- close the pending run and send the delta after it
+               q0   <= x"00";
+               q1   <= conv_std_logic_vector(cRun - 1, 8);
+               q2   <= bDelta;
+               cq   <= 3;
+               cRun <= 0;
+            else
+               q0   <= bDelta;
+               cq   <= 1;
+            end if;
+
+         elsif fPop = '1' then
+            q0 <= q1;
+            q1 <= q2;
+            cq <= cq - 1;
+         end if;
+      end if;
+   end process;
+
+end Behavioral;
@@ -8,6 +8,23 @@
 -- Description:   
 --    Implements dualport synchronous memory with separate read and write ports. 
 --    
+--    The memory is split into two banks that are used as a ping-pong buffer.
+--    The write (download) port fills one bank while the read (upload) port
+--    drains the other one. A bank becomes ready when its last byte has been
+--    written and is free again when its last byte has been read. The write
+--    port is paused with DOWNACK and its burst stopped with DOWNBSY while the
+--    bank being filled is still ready, and the read port is paused and
+--    stopped the same way while the bank being drained isn't ready. Both
+--    ports move on to the other bank at the end of each bank, so the data
+--    comes out in the order it went in.
+--
+--    In this reference design the banks are filled by the host through the
+--    download port. An acquisition design connects its data source to the
+--    DOWNWR/DOWNDATA inputs instead and uses DOWNBSY as its overrun flag.
+--    The BANKRDY outputs show which banks hold data that hasn't been read.
+--------------------------------------------------------------------------------
+-- Revision History:
+--  10/19/2026: split the memory into two ping-pong banks with ready flags
 --------------------------------------------------------------------------------
 
 library IEEE;
@@ -30,56 +47,95 @@ entity Memory is
       UPBSY    : out std_logic;
       UPRD     : in  std_logic;
       UPACK    : out std_logic;
-      UPDATA   : out std_logic_vector(7 downto 0));
+      UPDATA   : out std_logic_vector(7 downto 0);
+
+      BANKRDY  : out std_logic_vector(1 downto 0));
 end Memory;
 
 architecture Behavioral of Memory is
 
-constant MEMSIZE  : integer := 8192;
+-- Each bank holds 2**BANKBITS bytes. The bank number is the most significant
+-- address bit.
+constant BANKBITS : integer := 12;
+constant MEMSIZE  : integer := 2 * 2**BANKBITS;
 
 type MEMType is array (0 to MEMSIZE - 1) of std_logic_vector(7 downto 0);
 signal MEMData : MEMType;
 
-signal adrDownload, adrUpload, adrUpload2 : integer range 0 to MEMSIZE - 1;
+signal adrDownload, adrUpload, adrUpload2 : std_logic_vector(BANKBITS downto 0);
+
+-- Bank ready flags, indexed by bank number.
+signal rgfRdy : std_logic_vector(1 downto 0);
+signal bankDown, bankUp : integer range 0 to 1;
+
+-- The bank being written is free / the bank being read is ready.
+signal fDownFree, fUpRdy : std_logic;
+-- A byte is written / read in this clock cycle.
+signal fDownWr, fUpRd : std_logic;
 
 begin
 
-   -- The Busy and Acknowledge signals are not used by this module.
-   DOWNBSY <= '0';
-   UPBSY <= '0';
-   DOWNACK <= '1';
-   UPACK <= '1';
+   bankDown <= conv_integer(adrDownload(BANKBITS));
+   bankUp   <= conv_integer(adrUpload(BANKBITS));
+
+   fDownFree <= not rgfRdy(bankDown);
+   fUpRdy    <= rgfRdy(bankUp);
+
+   DOWNBSY <= not fDownFree;
+   DOWNACK <= fDownFree;
+   UPBSY   <= not fUpRdy;
+   UPACK   <= fUpRdy;
+   BANKRDY <= rgfRdy;
+
+   fDownWr <= DOWNWR and fDownFree;
+   fUpRd   <= UPRD and fUpRdy;
    
-   -- The read port of the synchronous memory is advanced when the read 
-   -- signal is active. This way on the next clock cycle will output the 
-   -- data from the next address.
-   adrUpload2 <= adrUpload + 1 when UPRD = '1' else adrUpload;
+   -- The read port of the synchronous memory is advanced when a byte is 
+   -- read. This way on the next clock cycle will output the data from the 
+   -- next address.
+   adrUpload2 <= adrUpload + 1 when fUpRd = '1' else adrUpload;
 
    process (IFCLK)
    begin
       if rising_edge(IFCLK) then
 
-         -- Download address counter incremented while write signal is active.
-         if RST = '0' then
-            adrDownload <= 0;
-         elsif DOWNWR = '1' then
-            adrDownload <= adrDownload + 1;
-         end if;
-         
-         -- Upload address counter incremented while read signal is active.
          if RST = '0' then
-            adrUpload <= 0;
-         elsif UPRD = '1' then
-            adrUpload <= adrUpload + 1;
+            adrDownload <= (others => '0');
+            adrUpload   <= (others => '0');
+            rgfRdy      <= "00";
+         else
+
+            -- Download address counter incremented when a byte is written.
+            -- Writing the last byte of a bank makes the bank ready.
+            if fDownWr = '1' then
+               adrDownload <= adrDownload + 1;
+               if adrDownload(BANKBITS - 1 downto 0) = 
+                  conv_std_logic_vector(2**BANKBITS - 1, BANKBITS) then
+                  rgfRdy(bankDown) <= '1';
+               end if;
+            end if;
+
+            -- Upload address counter incremented when a byte is read.
+            -- Reading the last byte of a bank frees the bank. A bank can't
+            -- be made ready and freed in the same cycle because the write
+            -- port only uses free banks and the read port ready ones.
+            if fUpRd = '1' then
+               adrUpload <= adrUpload + 1;
+               if adrUpload(BANKBITS - 1 downto 0) = 
+                  conv_std_logic_vector(2**BANKBITS - 1, BANKBITS) then
+                  rgfRdy(bankUp) <= '0';
+               end if;
+            end if;
+
          end if;
          
-         -- When write signal is active write the input data to the download 
+         -- When a byte is written store the input data at the download 
          -- address.
-         if DOWNWR = '1' then
-            MEMData(adrDownload) <= DOWNDATA;
+         if fDownWr = '1' then
+            MEMData(conv_integer(adrDownload)) <= DOWNDATA;
          end if;
 
-         UPDATA <= MEMData(adrUpload2);
+         UPDATA <= MEMData(conv_integer(adrUpload2));
 
       end if;
    end process;
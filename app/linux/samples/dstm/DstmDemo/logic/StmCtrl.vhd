@@ -14,6 +14,17 @@
 --    The acknowledge signal activation enables the transfer of the current data 
 --    byte, or pauses the transfer. While the acknowledge signal is not activated 
 --    the download write or upload read signals will be held active. 
+--    The PKTMODE input selects when a partially filled upload packet is
+--    committed to the host with PKTEND:
+--       "00" - never, packets are sent only when they are full (512 bytes)
+--       "01" - immediately, as soon as the upload source stops supplying data
+--       "10" - after PKTCNT bytes have been written to the packet
+--       "11" - after PKTIDLE clock cycles without an upload byte
+--    PKTMODE, PKTCNT and PKTIDLE are sampled while STMEN is inactive, so they
+--    may come from another clock domain.
+--------------------------------------------------------------------------------
+-- Revision History:
+--  10/19/2026: added the PKTEND packet commit policy
 --------------------------------------------------------------------------------
 
 library IEEE;
@@ -48,7 +59,12 @@ entity StmCtrl is
       UPRD     : out std_logic;
       -- pause the upload transfer
       UPACK    : in  std_logic;
-      UPDATA   : in  std_logic_vector(7 downto 0));
+      UPDATA   : in  std_logic_vector(7 downto 0);
+
+      -- upload packet commit policy
+      PKTMODE  : in  std_logic_vector(1 downto 0);
+      PKTCNT   : in  std_logic_vector(8 downto 0);
+      PKTIDLE  : in  std_logic_vector(15 downto 0));
 end StmCtrl;
 
 architecture Behavioral of StmCtrl is
@@ -60,6 +76,19 @@ signal stCur, stNext : stateType := stIdle;
 -- Active low FIFO cotnrol signals
 signal nSLRD, nSLWR : std_logic;
 
+-- Packet commit policy sampled while stream mode is disabled.
+signal pktModeCur : std_logic_vector(1 downto 0) := "00";
+signal cbPktCommit : std_logic_vector(8 downto 0) := (others => '0');
+signal cclkIdleMax : std_logic_vector(15 downto 0) := (others => '0');
+
+-- Bytes written to the current upload packet. The FX2 commits a packet by
+-- itself when it holds 512 bytes, which is where this counter wraps.
+signal cbPkt : std_logic_vector(8 downto 0) := (others => '0');
+-- Clock cycles since the last upload byte was written.
+signal cclkIdle : std_logic_vector(15 downto 0) := (others => '0');
+-- The current packet should be committed with PKTEND.
+signal fCommit : std_logic;
+
 begin
    
    
@@ -70,7 +99,8 @@ begin
 
    SLWR  <= 'Z' when STMEN = '0' else nSLWR;
    
-   PKTEND <= 'Z' when STMEN = '0' else '1';
+   PKTEND <= 'Z' when STMEN = '0' else
+             '0' when stCur = stPktEnd else '1';
 
    SLOE  <= 'Z' when STMEN = '0' else nSLRD;
 
@@ -97,8 +127,58 @@ begin
       end if;
    end process;
 
+   -- Packet commit policy registers. The configuration is captured while
+   -- stream mode is disabled and held while it is enabled.
+   PacketPolicy: process(IFCLK)
+   begin
+      if rising_edge(IFCLK) then
+         if STMEN = '0' then
+            pktModeCur  <= PKTMODE;
+            cbPktCommit <= PKTCNT;
+            cclkIdleMax <= PKTIDLE;
+            cbPkt       <= (others => '0');
+            cclkIdle    <= (others => '0');
+         elsif stCur = stPktEnd then
+            cbPkt       <= (others => '0');
+            cclkIdle    <= (others => '0');
+         elsif nSLWR = '0' then
+            cbPkt       <= cbPkt + 1;
+            cclkIdle    <= (others => '0');
+         elsif cclkIdle /= x"FFFF" then
+            cclkIdle    <= cclkIdle + 1;
+         end if;
+      end if;
+   end process;
+
+   -- A packet is only committed from the Idle or Upload states, where the
+   -- upload FIFO is addressed, and only if it holds at least one byte.
+   -- Committing an empty packet would send a zero length packet.
+   CommitDecode: process(stCur, pktModeCur, cbPkt, cbPktCommit, cclkIdle,
+                         cclkIdleMax, FLAGB, UPACK, UPBSY)
+   begin
+      fCommit <= '0';
+      if cbPkt /= 0 and (stCur = stIdle or stCur = stUpload) then
+         case pktModeCur is
+            when "01" =>
+               if stCur = stIdle or FLAGB = '1' or UPBSY = '1' or
+                  UPACK = '0' then
+                  fCommit <= '1';
+               end if;
+            when "10" =>
+               if cbPkt >= cbPktCommit and cbPktCommit /= 0 then
+                  fCommit <= '1';
+               end if;
+            when "11" =>
+               if cclkIdle >= cclkIdleMax then
+                  fCommit <= '1';
+               end if;
+            when others =>
+         end case;
+      end if;
+   end process;
+
    -- Decoding the outputs of state machine accoring the state and flags.
-   OutputDecode: process(stCur, FLAGA, FLAGB, DOWNACK, UPACK)
+   OutputDecode: process(stCur, FLAGA, FLAGB, DOWNACK, UPACK, fCommit)
    begin
       
       -- Default states of the control signals.
@@ -125,8 +205,10 @@ begin
          -- is not full and the transfer counter is not expired.
          -- When the UPRD signals is acknowledged with UPACK signal the nSLWR 
          -- signal is activated to write data to the USB FIFO.
+         -- No data is written in the cycle that decides to commit the
+         -- packet, so the packet holds exactly the bytes counted.
          when stUpload  =>
-            if FLAGB = '0' then
+            if FLAGB = '0' and fCommit = '0' then
                UPRD   <= '1';
                if UPACK = '1' then
                   nSLWR   <= '0';
@@ -139,7 +221,8 @@ begin
    end process;
 
    -- Decide the next state accring the current state and the input signals.
-   NEXT_STATE_DECODE: process(stCur, STMEN, FLAGA, FLAGB, DOWNBSY, UPBSY)
+   NEXT_STATE_DECODE: process(stCur, STMEN, FLAGA, FLAGB, DOWNBSY, UPBSY,
+                              fCommit)
    begin
       
       -- Stay in current state if not given otherwise in the following.
@@ -150,9 +233,12 @@ begin
          -- From Idle state go to download when the download FIFO is not empty 
          -- and the DOWNBSY signal is not active or to upload state when the 
          -- upload FIFO is not full, the UPBSY signal is not active and the 
-         -- transfer counter is not expired.
+         -- transfer counter is not expired. A pending packet commit takes
+         -- precedence over both.
          when stIdle  =>
-            if FLAGA = '0' and DOWNBSY = '0' then
+            if fCommit = '1' then
+               stNext <= stPktEnd;
+            elsif FLAGA = '0' and DOWNBSY = '0' then
                stNext <= stDownload;
             elsif FLAGB = '0' and UPBSY = '0' then
                stNext <= stUpload;
@@ -165,14 +251,21 @@ begin
                stNext <= stIdle;
             end if;
          
-         -- From upload state go to the PKTEND state when the transfer counter 
-         -- expires or go back to the Idle state when the upload FIFO
+         -- From upload state go to the PKTEND state when the packet commit
+         -- policy says so or go back to the Idle state when the upload FIFO
          -- becomes full or the UPBSY signal is activated.
          when stUpload   =>
-            if FLAGB = '1' or UPBSY = '1' then
+            if fCommit = '1' then
+               stNext <= stPktEnd;
+            elsif FLAGB = '1' or UPBSY = '1' then
                stNext <= stIdle;
             end if;
 
+         -- PKTEND is active for a single clock cycle, then go back to the
+         -- Idle state.
+         when stPktEnd   =>
+            stNext <= stIdle;
+
          when others  => 
             stNext <= stIdle;
 
@@ -6,18 +6,37 @@
 -- Design Name: StreamIO
 -- Module Name: StreamIOvhd - Behavioral 
 -- Description: Top level design for StreamIO project.
---		Instantiates StmCtrl and Memory modules.
+--		Instantiates StmCtrl and Memory modules. When the COMPRESS generic
+--		is true a DeltaRle encoder is placed in the upload path between
+--		Memory and StmCtrl.
+--		The upload packet commit policy of StmCtrl is configured through
+--		EPP registers implemented by dpimref (fpga/dpimref.vhd):
+--			0 - PKTMODE, bits 1:0 (0 full packets, 1 immediate, 2 after
+--			    PKTCNT bytes, 3 after PKTIDLE idle IFCLK cycles)
+--			1 - PKTCNT, bits 7:0
+--			2 - PKTCNT, bit 8
+--			3 - PKTIDLE, bits 7:0
+--			4 - PKTIDLE, bits 15:8
+--		The EPP port is only active while stream mode is disabled. The
+--		registers must be written before stream mode is enabled.
+--		Memory is a two bank ping-pong buffer. The bank ready flags are
+--		brought out on BankRdy, e.g. to drive two LEDs.
 -----------------------------------------------------------------------------
 -- Revision History:
 --  08/19/2010(AaronO): created
 --	 01/30/2012(SamB)  : Changed signal names to conform with General UCFs 
 --	 08/03/2012(JoshS) : Signals in UCFs updated, applied changes
+--	 10/19/2026        : Added optional DeltaRle upload encoder
+--	 10/19/2026        : Added EPP registers for the PKTEND policy
+--	 10/19/2026        : Added BankRdy outputs of the ping-pong Memory
 -----------------------------------------------------------------------------
 library IEEE;
 use IEEE.STD_LOGIC_1164.ALL;
+use work.reg_spec.all;
 
 
 entity StreamIOvhd is
+    Generic ( COMPRESS : boolean := false );
     Port ( DstmIFCLK  : in  STD_LOGIC;
            DstmSLCS   : in  STD_LOGIC;
            DstmFLAGA  : in  STD_LOGIC;
@@ -27,7 +46,13 @@ entity StreamIOvhd is
            DstmSLOE   : out  STD_LOGIC;
            DstmPKTEND : out  STD_LOGIC;
            DstmADR    : out  STD_LOGIC_VECTOR (1 downto 0);
-           DB         : inout  STD_LOGIC_VECTOR (7 downto 0));
+           DB         : inout  STD_LOGIC_VECTOR (7 downto 0);
+           mclk       : in  STD_LOGIC;
+           EppAstb    : in  STD_LOGIC;
+           EppDstb    : in  STD_LOGIC;
+           EppWr      : in  STD_LOGIC;
+           EppWait    : out  STD_LOGIC;
+           BankRdy    : out  STD_LOGIC_VECTOR (1 downto 0));
 end StreamIOvhd;
 
 architecture Behavioral of StreamIOvhd is
@@ -52,7 +77,26 @@ architecture Behavioral of StreamIOvhd is
 		PKTEND : OUT std_logic;
 		DOWNWR : OUT std_logic;
 		DOWNDATA : OUT std_logic_vector(7 downto 0);
-		UPRD : OUT std_logic
+		UPRD : OUT std_logic;
+		PKTMODE : IN std_logic_vector(1 downto 0);
+		PKTCNT : IN std_logic_vector(8 downto 0);
+		PKTIDLE : IN std_logic_vector(15 downto 0)
+		);
+	END COMPONENT;
+
+	COMPONENT dpimref
+	GENERIC(
+		addr_width : integer;
+		addr : integer
+		);
+	PORT(
+		mclk : IN std_logic;
+		pdb : INOUT std_logic_vector(7 downto 0);
+		astb : IN std_logic;
+		dstb : IN std_logic;
+		pwr : IN std_logic;
+		pwait : OUT std_logic;
+		data_regs : INOUT data_regs_array(0 to 16)
 		);
 	END COMPONENT;
 
@@ -67,6 +111,22 @@ architecture Behavioral of StreamIOvhd is
 		DOWNACK : OUT std_logic;
 		UPBSY : OUT std_logic;
 		UPACK : OUT std_logic;
+		UPDATA : OUT std_logic_vector(7 downto 0);
+		BANKRDY : OUT std_logic_vector(1 downto 0)
+		);
+	END COMPONENT;
+
+	COMPONENT DeltaRle
+	PORT(
+		IFCLK : IN std_logic;
+		RST : IN std_logic;
+		SRCBSY : IN std_logic;
+		SRCACK : IN std_logic;
+		SRCDATA : IN std_logic_vector(7 downto 0);
+		UPRD : IN std_logic;
+		SRCRD : OUT std_logic;
+		UPBSY : OUT std_logic;
+		UPACK : OUT std_logic;
 		UPDATA : OUT std_logic_vector(7 downto 0)
 		);
 	END COMPONENT;
@@ -81,6 +141,17 @@ architecture Behavioral of StreamIOvhd is
 	signal upack : std_logic;
 	signal updata : std_logic_vector(7 downto 0);
 
+	-- Upload port of Memory. This is connected to StmCtrl directly or
+	-- through the DeltaRle encoder.
+	signal memupbsy : std_logic;
+	signal memuprd : std_logic;
+	signal memupack : std_logic;
+	signal memupdata : std_logic_vector(7 downto 0);
+
+	-- EPP registers and the EPP strobes gated with the stream mode select.
+	signal regs : data_regs_array(0 to 16);
+	signal astb, dstb, pwr : std_logic;
+
 begin
 
 	-- Component instantiation
@@ -102,7 +173,31 @@ begin
 		UPBSY => upbsy,
 		UPRD => uprd,
 		UPACK => upack,
-		UPDATA => updata
+		UPDATA => updata,
+		PKTMODE => regs(0).data(1 downto 0),
+		PKTCNT => regs(2).data(0) & regs(1).data,
+		PKTIDLE => regs(4).data & regs(3).data
+	);
+
+	-- The EPP and stream interfaces share the data bus. Hold the EPP
+	-- strobes inactive while stream mode is selected so that dpimref
+	-- never drives the bus at the same time as StmCtrl.
+	astb <= EppAstb or DstmSLCS;
+	dstb <= EppDstb or DstmSLCS;
+	pwr  <= EppWr or DstmSLCS;
+
+	DpimrefInst: dpimref GENERIC MAP(
+		addr_width => 8,
+		addr => 16
+	)
+	PORT MAP(
+		mclk => mclk,
+		pdb => DB,
+		astb => astb,
+		dstb => dstb,
+		pwr => pwr,
+		pwait => EppWait,
+		data_regs => regs
 	);
 
 	MemoryInst: Memory PORT MAP(
@@ -112,11 +207,36 @@ begin
 		DOWNWR => downwr,
 		DOWNACK => downack,
 		DOWNDATA => downdata,
-		UPBSY => upbsy,
-		UPRD => uprd,
-		UPACK => upack,
-		UPDATA => updata
+		UPBSY => memupbsy,
+		UPRD => memuprd,
+		UPACK => memupack,
+		UPDATA => memupdata,
+		BANKRDY => BankRdy
 	);
 
+	-- Upload path without compression.
+	RawGen: if not COMPRESS generate
+		upbsy <= memupbsy;
+		memuprd <= uprd;
+		upack <= memupack;
+		updata <= memupdata;
+	end generate;
+
+	-- Upload path through the delta/run-length encoder.
+	CompressGen: if COMPRESS generate
+		DeltaRleInst: DeltaRle PORT MAP(
+			IFCLK => DstmIFCLK,
+			RST => DstmSLCS,
+			SRCBSY => memupbsy,
+			SRCRD => memuprd,
+			SRCACK => memupack,
+			SRCDATA => memupdata,
+			UPBSY => upbsy,
+			UPRD => uprd,
+			UPACK => upack,
+			UPDATA => updata
+		);
+	end generate;
+
 end Behavioral;
 
@@ -0,0 +1,676 @@
+/************************************************************************/
+/*                                                                      */
+/*  DstmPingPong.cpp  --  DstmPingPong main program                     */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DstmPingPong demonstrates continuous streaming through the two  */
+/*  bank ping-pong memory of the StreamIO reference design. The host    */
+/*  reads one bank at a time with DstmIO while the other bank is being  */
+/*  filled, alternating between the banks for as long as the stream    */
+/*  runs. The application functions as follows:                        */
+/*      1. Fill bank 0 by downloading the first block of a test stream. */
+/*      2. For each following block, issue one overlapped DstmIO call   */
+/*         that downloads the next block into the free bank and uploads */
+/*         the current block from the ready bank. Two calls are kept in */
+/*         flight so that the link never waits for the host.            */
+/*      3. As each call completes, check that the uploaded block is the */
+/*         next one in the stream and came from the expected bank.      */
+/*                                                                      */
+/*  When the "-extfill" option is specified the banks are assumed to be */
+/*  filled by acquisition logic in the FPGA. Nothing is downloaded and  */
+/*  the uploaded data is counted but not checked.                       */
+/*                                                                      */
+/*  All transfer buffers come from a BufPool.                           */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent FPGA board that supports DSTM, configured with the       */
+/*  StreamIO design from dstm/DstmDemo/logic.                           */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+	#include <time.h>
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dstm.h"
+#include "BufPool.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* Size of one bank of the StreamIO memory and the number of banks.
+*/
+const   DWORD   cbBank = 4096;
+const   DWORD   cbankMem = 2;
+
+/* Number of overlapped DstmIO calls kept in flight.
+*/
+const   DWORD   cxferInFlight = 2;
+
+/* Time to wait for an overlapped call to complete.
+*/
+const   DWORD   tmsXferWait = 5000;
+
+/* Default number of blocks transferred.
+*/
+const   DWORD   cblkDefault = 4096;
+
+/* State of one overlapped DstmIO call.
+*/
+typedef struct {
+    BYTE *  pbOut;          // block downloaded by the call, or NULL
+    BYTE *  pbIn;           // block uploaded by the call
+    DWORD   iblkIn;         // stream position of the uploaded block
+} XFER;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-n           ", "number of banks to transfer"},
+    {"-extfill     ", "banks are filled by the FPGA, don't download"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fExtFill;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+DWORD   cblkReq;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static DWORD    rgcblkBank[cbankMem];
+static DWORD    cblkBad;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FStream( HIF hif, BufPool * pbpool );
+BOOL    FSubmit( HIF hif, XFER * pxfer, DWORD iblk );
+BOOL    FComplete( HIF hif, BufPool * pbpool, XFER * pxfer );
+void    FillBlock( BYTE * pb, DWORD iblk );
+BOOL    FCheckBlock( const BYTE * pb, DWORD iblk );
+
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    HIF         hif;
+    BufPool     bpool;
+    BPSTATS     bps;
+    double      secStart;
+    double      secTotal;
+    BOOL        fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    /* Each call in flight holds an upload buffer and possibly a download
+    ** buffer. One more download buffer holds the block that primes the
+    ** first bank.
+    */
+    if ( ! bpool.FInit(cbBank, 2 * cxferInFlight + 1, fbpDefault) ) {
+
+        printf("ERROR: unable to allocate transfer buffers\n");
+        return 1;
+    }
+
+    /* Attempt to open the device and enable stream mode.
+    */
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        goto lErrorExit;
+    }
+
+    if ( ! DstmEnable(hif) ) {
+
+        printf("ERROR: DstmEnable failed, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    secStart = SecNow();
+
+    if ( ! FStream(hif, &bpool) ) {
+        goto lErrorExit;
+    }
+
+    secTotal = SecNow() - secStart;
+
+    bpool.GetStats(&bps);
+
+    printf("Transferred %d banks (%d from bank 0, %d from bank 1) in %.3f s\n",
+           cblkReq, rgcblkBank[0], rgcblkBank[1], secTotal);
+    printf("Upload rate: %.2f MB/s\n",
+           ((double)cblkReq * cbBank) / (secTotal * 1000000.0));
+    printf("Buffers: %d total, %d free at low water mark\n",
+           bps.cbufTotal, bps.cbufFreeMin);
+
+    if ( 0 != cblkBad ) {
+
+        printf("ERROR: %d banks held unexpected data\n", cblkBad);
+        goto lErrorExit;
+    }
+
+    if ( ! fExtFill ) {
+        printf("Success: all banks arrived in order with the expected data\n");
+    }
+
+    fSuccess = fTrue;
+
+lErrorExit:
+
+    if ( hifInvalid != hif ) {
+
+        DstmDisable(hif);
+        DmgrClose(hif);
+    }
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FStream
+**
+**  Parameters:
+**      hif     - open handle with DSTM enabled
+**      pbpool  - pool that supplies the transfer buffers
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Run the stream. Calls are issued in block order and complete in
+**      the same order, so the ring of XFER structures is both the issue
+**      queue and the completion queue.
+*/
+BOOL
+FStream( HIF hif, BufPool * pbpool ) {
+
+    XFER    rgxfer[cxferInFlight];
+    BYTE *  pbPrime;
+    DWORD   iblk;
+    DWORD   ixfer;
+    DWORD   cxfer;
+
+    /* Fill the first bank before anything can be uploaded.
+    */
+    if ( ! fExtFill ) {
+
+        pbPrime = pbpool->PbAlloc();
+        FillBlock(pbPrime, 0);
+
+        if ( ! DstmIO(hif, pbPrime, cbBank, NULL, 0, fFalse) ) {
+
+            printf("ERROR: DstmIO failed, erc = %d\n", DmgrGetLastError());
+            return fFalse;
+        }
+
+        pbpool->FreeBuf(pbPrime);
+    }
+
+    ixfer = 0;
+    cxfer = 0;
+    for ( iblk = 0; iblk < cblkReq; iblk++ ) {
+
+        /* Wait for the oldest call when all of the slots are in use.
+        */
+        if ( cxferInFlight == cxfer ) {
+
+            if ( ! FComplete(hif, pbpool, &rgxfer[ixfer]) ) {
+                return fFalse;
+            }
+            cxfer--;
+        }
+
+        rgxfer[ixfer].pbIn = pbpool->PbAlloc();
+        rgxfer[ixfer].pbOut = NULL;
+        rgxfer[ixfer].iblkIn = iblk;
+
+        /* Refill the bank that this call empties on the next call.
+        */
+        if (( ! fExtFill ) && ( iblk + 1 < cblkReq )) {
+
+            rgxfer[ixfer].pbOut = pbpool->PbAlloc();
+            FillBlock(rgxfer[ixfer].pbOut, iblk + 1);
+        }
+
+        if ( ! FSubmit(hif, &rgxfer[ixfer], iblk) ) {
+            return fFalse;
+        }
+
+        cxfer++;
+        ixfer = (ixfer + 1) % cxferInFlight;
+    }
+
+    /* Drain the calls that are still in flight, oldest first.
+    */
+    ixfer = (ixfer + cxferInFlight - cxfer) % cxferInFlight;
+    while ( 0 < cxfer ) {
+
+        if ( ! FComplete(hif, pbpool, &rgxfer[ixfer]) ) {
+            return fFalse;
+        }
+
+        cxfer--;
+        ixfer = (ixfer + 1) % cxferInFlight;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FSubmit
+**
+**  Parameters:
+**      hif     - open handle with DSTM enabled
+**      pxfer   - call to issue
+**      iblk    - stream position of the block being uploaded
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Issue one overlapped DstmIO call. The download, if any, fills the
+**      bank that the previous call emptied, and the upload empties the
+**      bank that the previous call filled.
+*/
+BOOL
+FSubmit( HIF hif, XFER * pxfer, DWORD iblk ) {
+
+    if ( ! DstmIO(hif, pxfer->pbOut, ( NULL != pxfer->pbOut ) ? cbBank : 0,
+                  pxfer->pbIn, cbBank, fTrue) ) {
+
+        printf("ERROR: DstmIO failed for bank %d, erc = %d\n", iblk, DmgrGetLastError());
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FComplete
+**
+**  Parameters:
+**      hif     - open handle with DSTM enabled
+**      pbpool  - pool that supplied the transfer buffers
+**      pxfer   - oldest call in flight
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Wait for the oldest overlapped call to complete, consume the
+**      uploaded bank and return the buffers to the pool.
+*/
+BOOL
+FComplete( HIF hif, BufPool * pbpool, XFER * pxfer ) {
+
+    DWORD   cbOut;
+    DWORD   cbIn;
+    DWORD   ibank;
+
+    if ( ! DmgrGetTransResult(hif, &cbOut, &cbIn, tmsXferWait) ) {
+
+        printf("ERROR: bank %d transfer failed, erc = %d\n", pxfer->iblkIn, DmgrGetLastError());
+        return fFalse;
+    }
+
+    if ( cbBank != cbIn ) {
+
+        printf("ERROR: bank %d transfer returned %d bytes\n", pxfer->iblkIn, cbIn);
+        return fFalse;
+    }
+
+    /* The memory hands out the banks alternately, starting with bank 0.
+    */
+    ibank = pxfer->iblkIn % cbankMem;
+    rgcblkBank[ibank]++;
+
+    if (( ! fExtFill ) && ( ! FCheckBlock(pxfer->pbIn, pxfer->iblkIn) )) {
+
+        if ( 0 == cblkBad ) {
+            printf("ERROR: bank %d (memory bank %d) held unexpected data\n", pxfer->iblkIn, ibank);
+        }
+
+        cblkBad++;
+    }
+
+    pbpool->FreeBuf(pxfer->pbIn);
+    pbpool->FreeBuf(pxfer->pbOut);
+
+    pxfer->pbIn = NULL;
+    pxfer->pbOut = NULL;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FillBlock
+**
+**  Parameters:
+**      pb      - buffer of cbBank bytes
+**      iblk    - stream position of the block
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Generate a block of the test stream. The first four bytes hold
+**      the stream position and the rest is a pattern that depends on
+**      it, so both lost and reordered blocks are detected.
+*/
+void
+FillBlock( BYTE * pb, DWORD iblk ) {
+
+    DWORD   ib;
+
+    pb[0] = (BYTE)(iblk & 0xFF);
+    pb[1] = (BYTE)((iblk >> 8) & 0xFF);
+    pb[2] = (BYTE)((iblk >> 16) & 0xFF);
+    pb[3] = (BYTE)((iblk >> 24) & 0xFF);
+
+    for ( ib = 4; ib < cbBank; ib++ ) {
+        pb[ib] = (BYTE)(ib + iblk * 7);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FCheckBlock
+**
+**  Parameters:
+**      pb      - uploaded block
+**      iblk    - expected stream position
+**
+**  Return Values:
+**      fTrue if the block holds the expected data
+**
+**  Errors:
+**
+**  Description:
+**      Check an uploaded block against the test stream.
+*/
+BOOL
+FCheckBlock( const BYTE * pb, DWORD iblk ) {
+
+    DWORD   ib;
+    DWORD   iblkRcv;
+
+    iblkRcv = pb[0] | (pb[1] << 8) | (pb[2] << 16) | ((DWORD)pb[3] << 24);
+    if ( iblkRcv != iblk ) {
+        return fFalse;
+    }
+
+    for ( ib = 4; ib < cbBank; ib++ ) {
+
+        if ( pb[ib] != (BYTE)(ib + iblk * 7) ) {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    DWORD   ich;
+
+    fDevName = fFalse;
+    fExtFill = fFalse;
+    fShowHelp = fFalse;
+    cblkReq = cblkDefault;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        /* Check for the -d option. This specifies the device name.
+        */
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            iszArg++;
+
+            if (( iszArg >= cszArg ) || ( NULL == rgszArg[iszArg] ) ||
+                ( cchDvcNameMax < strlen(rgszArg[iszArg]) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, rgszArg[iszArg]);
+            fDevName = fTrue;
+        }
+
+        /* Check for the -n option. This specifies the number of banks
+        ** to transfer.
+        */
+        else if ( 0 == strcmp(rgszArg[iszArg], "-n") ) {
+
+            iszArg++;
+
+            if (( iszArg >= cszArg ) || ( NULL == rgszArg[iszArg] )) {
+
+                printf("ERROR: no bank count specified\n");
+                return fFalse;
+            }
+
+            /* Make sure that the string consists entirely of digits 0-9.
+            */
+            ich = 0;
+            while ( '\0' != rgszArg[iszArg][ich] ) {
+
+                if ( 0 == isdigit(rgszArg[iszArg][ich]) ) {
+
+                    printf("ERROR: invalid character detected in bank count string: %c\n", rgszArg[iszArg][ich]);
+                    return fFalse;
+                }
+
+                ich++;
+            }
+
+            cblkReq = strtoul(rgszArg[iszArg], NULL, 10);
+            if ( 0 == cblkReq ) {
+
+                printf("ERROR: bank count must be at least 1\n");
+                return fFalse;
+            }
+        }
+
+        /* Check for the -extfill option.
+        */
+        else if ( 0 == strcmp(rgszArg[iszArg], "-extfill") ) {
+
+            fExtFill = fTrue;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -0,0 +1,557 @@
+/************************************************************************/
+/*                                                                      */
+/*  DstmRleDemo.cpp  --  DstmRleDemo main program                       */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  The DstmRleDemo demonstrates how to read data that has been         */
+/*  compressed by the DeltaRle upload stage of the StreamIO reference   */
+/*  design and how to decode it on the host. The application functions */
+/*  as follows:                                                         */
+/*      1. Generate a slowly changing test pattern the size of the      */
+/*         StreamIO block ram and encode it on the host to find the     */
+/*         expected compressed data.                                    */
+/*      2. Download the pattern into the block ram using DstmIO.        */
+/*      3. Upload exactly as many bytes as the compressed pattern takes */
+/*         and compare them against the expected compressed data.       */
+/*      4. Decode the uploaded data and compare it against the pattern. */
+/*                                                                      */
+/*  When the "-bench" option is specified no device is used. Instead   */
+/*  a large test pattern is encoded and the decode throughput of each   */
+/*  decoder implementation supported by the processor is measured.      */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  A Digilent FPGA board that supports DSTM, configured with the       */
+/*  StreamIO design from dstm/DstmDemo/logic built with the COMPRESS    */
+/*  generic of StreamIOvhd set to true.                                 */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+	#include <time.h>
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dstm.h"
+#include "BufPool.h"
+#include "DeltaRle.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* Size of the StreamIO block ram. The whole memory is downloaded and
+** compressed on the way back up.
+*/
+const   DWORD   cbMem = 8192;
+
+/* Size of the test pattern and the number of passes used by the
+** decoder benchmark.
+*/
+const   DWORD   cbBench = 16 * 1024 * 1024;
+const   DWORD   cpassBench = 8;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device user name or alias"},
+    {"-bench       ", "measure decoder throughput without a device"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fDevName;
+BOOL    fBench;
+BOOL    fShowHelp;
+
+char*   pszCmd;
+char    szDevName[cchDvcNameMax + 1];
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FLoopback();
+BOOL    FBench();
+void    GenPattern( BYTE * rgb, DWORD cb );
+
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    if ( fBench ) {
+
+        return FBench() ? 0 : 1;
+    }
+
+    /* Check to see if the user specified a device name/connection string.
+    */
+    if ( ! fDevName ) {
+
+        printf("ERROR: you must specify a device using the \"-d\" option\n");
+        return 1;
+    }
+
+    return FLoopback() ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FLoopback
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Send a test pattern to the StreamIO design and read it back
+**      through the DeltaRle encoder. The encoder holds back a run of
+**      zero deltas until the run ends, so the pattern always ends with
+**      a non-zero delta. This way the number of compressed bytes that
+**      the FPGA sends for the pattern is known in advance.
+*/
+BOOL
+FLoopback() {
+
+    HIF         hif;
+    BufPool     bpool;
+    BYTE *      rgbPattern;
+    BYTE *      rgbEncExp;
+    BYTE *      rgbEnc;
+    BYTE *      rgbDec;
+    DRENCSTATE  dres;
+    DRSTATE     drs;
+    DWORD       cbEnc;
+    DWORD       cbDec;
+    DWORD       cbInUsed;
+    DWORD       ib;
+    BOOL        fSuccess;
+
+    hif = hifInvalid;
+    fSuccess = fFalse;
+
+    if ( ! bpool.FInit(CbDrEncodeMax(cbMem), 4, fbpDefault) ) {
+
+        printf("ERROR: unable to allocate transfer buffers\n");
+        return fFalse;
+    }
+
+    rgbPattern = bpool.PbAlloc();
+    rgbEncExp = bpool.PbAlloc();
+    rgbEnc = bpool.PbAlloc();
+    rgbDec = bpool.PbAlloc();
+
+    GenPattern(rgbPattern, cbMem);
+
+    DrEncInit(&dres);
+    cbEnc = CbDrEncode(&dres, rgbPattern, cbMem, rgbEncExp);
+
+    /* Attempt to open the device and enable stream mode.
+    */
+    if ( ! DmgrOpen(&hif, szDevName) ) {
+
+        printf("ERROR: unable to open device \"%s\"\n", szDevName);
+        goto lErrorExit;
+    }
+
+    if ( ! DstmEnable(hif) ) {
+
+        printf("ERROR: DstmEnable failed, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    /* Fill the block ram with the pattern, then read the compressed
+    ** pattern back.
+    */
+    if ( ! DstmIO(hif, rgbPattern, cbMem, NULL, 0, fFalse) ) {
+
+        printf("ERROR: DstmIO download failed, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    if ( ! DstmIO(hif, NULL, 0, rgbEnc, cbEnc, fFalse) ) {
+
+        printf("ERROR: DstmIO upload failed, erc = %d\n", DmgrGetLastError());
+        goto lErrorExit;
+    }
+
+    printf("Downloaded %d bytes, uploaded %d compressed bytes (%.1f:1)\n",
+           cbMem, cbEnc, (double)cbMem / cbEnc);
+
+    for ( ib = 0; ib < cbEnc; ib++ ) {
+
+        if ( rgbEnc[ib] != rgbEncExp[ib] ) {
+
+            printf("ERROR: compressed data mismatch at byte %d: ", ib);
+            printf("expected 0x%02X, received 0x%02X\n", rgbEncExp[ib], rgbEnc[ib]);
+            goto lErrorExit;
+        }
+    }
+
+    /* Decode the uploaded data and check it against the pattern.
+    */
+    DrInit(&drs);
+    cbDec = CbDrDecode(&drs, rgbEnc, cbEnc, rgbDec, cbMem, &cbInUsed);
+
+    if (( cbMem != cbDec ) || ( cbEnc != cbInUsed ) ||
+        ( 0 != memcmp(rgbDec, rgbPattern, cbMem) )) {
+
+        printf("ERROR: decoded data did not match transmitted data\n");
+        goto lErrorExit;
+    }
+
+    printf("Success: decoded data matched transmitted data (%s decoder)\n",
+           SzDrImpl(DrimplBest()));
+
+    fSuccess = fTrue;
+
+lErrorExit:
+
+    if ( hifInvalid != hif ) {
+
+        DstmDisable(hif);
+        DmgrClose(hif);
+    }
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    FBench
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Measure the throughput of each decoder implementation that the
+**      processor supports. The throughput is given in decoded bytes per
+**      second, which is the capture bandwidth the decoder can keep up
+**      with.
+*/
+BOOL
+FBench() {
+
+    BufPool     bpool;
+    BYTE *      rgbPattern;
+    BYTE *      rgbEnc;
+    BYTE *      rgbDec;
+    DRENCSTATE  dres;
+    DRSTATE     drs;
+    DWORD       cbEnc;
+    DWORD       cbDec;
+    DWORD       cbInUsed;
+    DWORD       drimpl;
+    DWORD       ipass;
+    double      secStart;
+    double      secTotal;
+
+    if ( ! bpool.FInit(CbDrEncodeMax(cbBench), 3, fbpDefault) ) {
+
+        printf("ERROR: unable to allocate benchmark buffers\n");
+        return fFalse;
+    }
+
+    rgbPattern = bpool.PbAlloc();
+    rgbEnc = bpool.PbAlloc();
+    rgbDec = bpool.PbAlloc();
+
+    GenPattern(rgbPattern, cbBench);
+
+    DrEncInit(&dres);
+    cbEnc = CbDrEncode(&dres, rgbPattern, cbBench, rgbEnc);
+    cbEnc += CbDrEncodeFlush(&dres, &rgbEnc[cbEnc]);
+
+    printf("Pattern: %d bytes, compressed: %d bytes (%.1f:1)\n",
+           cbBench, cbEnc, (double)cbBench / cbEnc);
+
+    for ( drimpl = drimplScalar; drimpl <= drimplAvx2; drimpl++ ) {
+
+        if ( ! FDrImplSupported(drimpl) ) {
+
+            printf("%-8s not supported by this processor\n", SzDrImpl(drimpl));
+            continue;
+        }
+
+        memset(rgbDec, 0, cbBench);
+
+        secStart = SecNow();
+        for ( ipass = 0; ipass < cpassBench; ipass++ ) {
+
+            DrInit(&drs);
+            cbDec = CbDrDecodeImpl(drimpl, &drs, rgbEnc, cbEnc, rgbDec, cbBench, &cbInUsed);
+        }
+        secTotal = SecNow() - secStart;
+
+        if (( cbBench != cbDec ) || ( cbEnc != cbInUsed ) ||
+            ( 0 != memcmp(rgbDec, rgbPattern, cbBench) )) {
+
+            printf("ERROR: %s decoder produced incorrect data\n", SzDrImpl(drimpl));
+            return fFalse;
+        }
+
+        printf("%-8s %8.1f MB/s decoded\n", SzDrImpl(drimpl),
+               ((double)cbBench * cpassBench) / (secTotal * 1000000.0));
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    GenPattern
+**
+**  Parameters:
+**      rgb     - buffer that receives the pattern
+**      cb      - size of the pattern in bytes
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Generate a pattern that resembles a slowly changing sampled
+**      input: a ramp with occasional one count steps of noise. The last
+**      sample always differs from the one before it.
+*/
+void
+GenPattern( BYTE * rgb, DWORD cb ) {
+
+    DWORD   ib;
+    DWORD   rnd;
+    BYTE    b;
+
+    rnd = 0x12345678;
+    b = 0x80;
+
+    for ( ib = 0; ib < cb; ib++ ) {
+
+        rnd = rnd * 1103515245 + 12345;
+
+        if ( 0 == (ib % 24) ) {
+            b++;
+        }
+
+        if ( 0 == ((rnd >> 16) & 0x3F) ) {
+            b += ( rnd & 0x80000000 ) ? 1 : -1;
+        }
+
+        rgb[ib] = b;
+    }
+
+    if (( 1 < cb ) && ( rgb[cb - 1] == rgb[cb - 2] )) {
+        rgb[cb - 1]++;
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+
+    fDevName = fFalse;
+    fBench = fFalse;
+    fShowHelp = fFalse;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        /* Check for the -d option. This specifies the device name.
+        */
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            iszArg++;
+
+            if (( iszArg >= cszArg ) || ( NULL == rgszArg[iszArg] ) ||
+                ( cchDvcNameMax < strlen(rgszArg[iszArg]) )) {
+
+                printf("ERROR: invalid device name specified\n");
+                return fFalse;
+            }
+
+            strcpy(szDevName, rgszArg[iszArg]);
+            fDevName = fTrue;
+        }
+
+        /* Check for the -bench option.
+        */
+        else if ( 0 == strcmp(rgszArg[iszArg], "-bench") ) {
+
+            fBench = fTrue;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -15,6 +15,7 @@
 /*  Revision History:													*/
 /*																		*/
 /*	07/21/2010(AaronO): created											*/
+/*	10/19/2026: sends both writes with one TwiBatch						*/
 /*																		*/
 /************************************************************************/
 
@@ -45,6 +46,7 @@
 #include "dpcdecl.h" 
 #include "dmgr.h"
 #include "dtwi.h"
+#include "TwiBatch.h"
 
 /* ------------------------------------------------------------ */
 /*					Local Type and Constant Definitions			*/
@@ -91,6 +93,8 @@ void ErrorExit();
 */
 int main(void) {
 
+	TwiBatch	tb;
+
 	/* Open Device */
 	// DMGR API Call: DmgrOpen
 	if(!DmgrOpen(&hif, (char*) szDvc)) {
@@ -105,20 +109,25 @@ int main(void) {
 		ErrorExit();
 	}
 
-	/* Send escape sequence to PmodCLS via TWI */
-	// DTWI API Call: DtwiMasterPut
-	if(!DtwiMasterPut(hif, addrCls, strlen(szClearScreen), (BYTE*) szClearScreen, fFalse)) {
-		printf("Error: DtwiMasterPut failed\n");
+	/* Record the escape sequence and the text for the PmodCLS as two
+	** transactions of one batch. A port that supports TWI batches sends
+	** both with one DtwiMasterBatch call, otherwise each one is sent with
+	** an overlapped DtwiMasterPut call.
+	*/
+	if(!tb.FWrite(addrCls, (BYTE*) szClearScreen, strlen(szClearScreen)) ||
+	   !tb.FWrite(addrCls, (BYTE*) szMsg, strlen(szMsg))) {
+		printf("Error: could not record the TWI batch\n");
 		ErrorExit();
 	}
 
-	/* Send text to PmodCLS via TWI */
-	// DTWI API Call: DtwiMasterPut
-	if(!DtwiMasterPut(hif, addrCls, strlen(szMsg), (BYTE*) szMsg, fFalse)) {
-		printf("Error: DtwiMasterPut failed\n");
+	// DTWI API Call: DtwiMasterBatch or DtwiMasterPut
+	if(!tb.FExecute(hif)) {
+		printf("Error: TwiBatch execution failed, ERC %d\n", tb.ErcOp(0) != ercNoErc ? tb.ErcOp(0) : tb.ErcOp(1));
 		ErrorExit();
 	}
 
+	printf("Sent the PmodCLS text with %d TWI call(s)\n", (int) tb.CcallLast());
+
 	/* Disable TWI */
 	// DTWI API Call: DtwiDisable
 	if(!DtwiDisable(hif)) {
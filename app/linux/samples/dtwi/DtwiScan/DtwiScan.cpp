@@ -0,0 +1,717 @@
+/************************************************************************/
+/*                                                                      */
+/*  DtwiScan.cpp  --  DtwiScan main program                             */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DtwiScan lists the I2C slaves on the TWI ports of any number of     */
+/*  Digilent devices, such as every board of a rack. The probes of all  */
+/*  the addresses of a bus are sent with overlapped DtwiMasterBatch     */
+/*  calls, and the buses are scanned at the same time, one thread each. */
+/*  The slaves found can be checked for SMBus packet error checking.    */
+/*  An i2cdetect style map of each bus and the time taken are printed.  */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  One or more Digilent devices with a TWI port, connected to the I2C  */
+/*  buses to scan.                                                      */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dtwi.h"
+#include "TwiScan.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* A device whose bus is scanned.
+*/
+typedef struct {
+    char    szDevName[cchDvcNameMax + 1];
+    HIF     hif;
+} SCDVC;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-d           ", "device to scan, repeatable (default all devices)"},
+    {"-p           ", "TWI port to scan (default 0)"},
+    {"-f           ", "SCL frequency in Hz (default the port's)"},
+    {"-probe       ", "auto, quick or read (default auto)"},
+    {"-pec         ", "check the PEC as <command>,<bytes>"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fShowHelp;
+
+char*   pszCmd;
+SCDVC   rgdvc[cbusTsMax];
+DWORD   cdvc;
+BOOL    fAllDevices;
+DWORD   prtScan;
+DWORD   frqScan;
+DWORD   tspScan;
+DWORD   bPecCmd;
+DWORD   cbPec;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FOpenDevice( SCDVC * pdvc, const char * szSel, BOOL fQuiet );
+BOOL    FOpenAllDevices();
+void    CloseDevices();
+void    PrintBus( const SCDVC * pdvc, const TSBUS * pbus );
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParsePec( const char * sz );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    TwiScanner  scan;
+    DWORD       idvc;
+    DWORD       cpresent;
+    double      secStart;
+    double      secScan;
+    BOOL        fSuccess;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    secStart = SecNow();
+
+    if ( fAllDevices ) {
+
+        if ( ! FOpenAllDevices() ) {
+
+            CloseDevices();
+            return 1;
+        }
+    }
+    else {
+
+        for ( idvc = 0; idvc < cdvc; idvc++ ) {
+
+            if ( ! FOpenDevice(&rgdvc[idvc], rgdvc[idvc].szDevName, fFalse) ) {
+
+                CloseDevices();
+                return 1;
+            }
+        }
+    }
+
+    if ( 0 == cdvc ) {
+
+        printf("ERROR: no device with TWI port %u was found\n", prtScan);
+        return 1;
+    }
+
+    printf("Opened %u device(s) in %.2f s\n", cdvc, SecNow() - secStart);
+
+    for ( idvc = 0; idvc < cdvc; idvc++ ) {
+        scan.FAddBus(rgdvc[idvc].hif, (INT32)prtScan);
+    }
+
+    scan.SetProbe(tspScan);
+    scan.FSetPecCheck((BYTE)bPecCmd, cbPec);
+
+    secStart = SecNow();
+    fSuccess = scan.FScan();
+    secScan = SecNow() - secStart;
+
+    cpresent = 0;
+
+    for ( idvc = 0; idvc < cdvc; idvc++ ) {
+
+        PrintBus(&rgdvc[idvc], scan.Pbus(idvc));
+        cpresent += scan.Pbus(idvc)->cpresent;
+    }
+
+    printf("\nFound %u slave(s) on %u bus(es) in %.1f ms\n", cpresent, cdvc, secScan * 1000.0);
+
+    CloseDevices();
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FOpenDevice
+**
+**  Parameters:
+**      pdvc    - device to open, szDevName is the name printed
+**      szSel   - name, alias or connection string to open
+**      fQuiet  - fTrue to skip a device that can't be opened or
+**                doesn't have the TWI port without reporting it
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Open a device, enable its TWI port and set the SCL frequency
+**      given with "-f".
+*/
+BOOL
+FOpenDevice( SCDVC * pdvc, const char * szSel, BOOL fQuiet ) {
+
+    INT32   cprt;
+    DWORD   frqSet;
+
+    if ( ! DmgrOpen(&pdvc->hif, (char *)szSel) ) {
+
+        if ( ! fQuiet ) {
+            printf("ERROR: unable to open device \"%s\"\n", pdvc->szDevName);
+        }
+
+        pdvc->hif = hifInvalid;
+        return fFalse;
+    }
+
+    if (( ! DtwiGetPortCount(pdvc->hif, &cprt) ) || ( (INT32)prtScan >= cprt )) {
+
+        if ( ! fQuiet ) {
+            printf("ERROR: device \"%s\" doesn't have TWI port %u\n", pdvc->szDevName, prtScan);
+        }
+
+        DmgrClose(pdvc->hif);
+        pdvc->hif = hifInvalid;
+        return fFalse;
+    }
+
+    if ( ! DtwiEnableEx(pdvc->hif, (INT32)prtScan) ) {
+
+        printf("ERROR: unable to enable DTWI on \"%s\", erc = %d\n",
+               pdvc->szDevName, DmgrGetLastError());
+        DmgrClose(pdvc->hif);
+        pdvc->hif = hifInvalid;
+        return fFalse;
+    }
+
+    if (( 0 != frqScan ) && ( ! DtwiSetSpeed(pdvc->hif, frqScan, &frqSet) )) {
+
+        printf("ERROR: unable to set the SCL frequency of \"%s\", erc = %d\n",
+               pdvc->szDevName, DmgrGetLastError());
+        DtwiDisable(pdvc->hif);
+        DmgrClose(pdvc->hif);
+        pdvc->hif = hifInvalid;
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FOpenAllDevices
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Open every device found by enumeration that has the TWI port.
+**      Devices without it, or that can't be opened, are skipped.
+*/
+BOOL
+FOpenAllDevices() {
+
+    DVC     dvc;
+    int     cdvcEnum;
+    int     idvcEnum;
+    SCDVC * pdvc;
+
+    if ( ! DmgrEnumDevices(&cdvcEnum) ) {
+
+        printf("ERROR: unable to enumerate devices, erc = %d\n", DmgrGetLastError());
+        return fFalse;
+    }
+
+    for ( idvcEnum = 0; idvcEnum < cdvcEnum; idvcEnum++ ) {
+
+        if ( cbusTsMax <= cdvc ) {
+
+            printf("WARNING: only the first %u devices are scanned\n", cbusTsMax);
+            break;
+        }
+
+        if ( ! DmgrGetDvc(idvcEnum, &dvc) ) {
+            continue;
+        }
+
+        pdvc = &rgdvc[cdvc];
+
+        strncpy(pdvc->szDevName, dvc.szName, cchDvcNameMax);
+        pdvc->szDevName[cchDvcNameMax] = '\0';
+
+        if ( FOpenDevice(pdvc, dvc.szConn, fTrue) ) {
+            cdvc++;
+        }
+    }
+
+    DmgrFreeDvcEnum();
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    CloseDevices
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Disable DTWI and close the devices that were opened.
+*/
+void
+CloseDevices() {
+
+    DWORD   idvc;
+
+    for ( idvc = 0; idvc < cdvc; idvc++ ) {
+
+        if ( hifInvalid != rgdvc[idvc].hif ) {
+
+            DtwiDisable(rgdvc[idvc].hif);
+            DmgrClose(rgdvc[idvc].hif);
+            rgdvc[idvc].hif = hifInvalid;
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    PrintBus
+**
+**  Parameters:
+**      pdvc    - device of the bus
+**      pbus    - results of the scan
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Print the map of the bus as i2cdetect does: the address of each
+**      slave found, "--" where there is none and "EE" where the probe
+**      failed. Then print the result of the PEC check of each slave.
+*/
+void
+PrintBus( const SCDVC * pdvc, const TSBUS * pbus ) {
+
+    DWORD   dadr;
+
+    printf("\n%s: %u slave(s), %u call(s), %.1f ms\n", pdvc->szDevName,
+           pbus->cpresent, pbus->ccall, pbus->secScan * 1000.0);
+
+    if ( ercNoErc != pbus->ercScan ) {
+        printf("ERROR: the scan didn't complete, erc = %d\n", pbus->ercScan);
+    }
+
+    printf("     0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f");
+
+    for ( dadr = 0; dadr < cdadrTs; dadr++ ) {
+
+        if ( 0 == (dadr % 16) ) {
+            printf("\n%02x:", dadr);
+        }
+
+        switch ( pbus->rgtsr[dadr] ) {
+
+            case tsrAbsent:
+                printf(" --");
+                break;
+
+            case tsrPresent:
+                printf(" %02x", dadr);
+                break;
+
+            case tsrError:
+                printf(" EE");
+                break;
+
+            default:
+                printf("   ");
+                break;
+        }
+    }
+
+    printf("\n");
+
+    for ( dadr = 0; dadr < cdadrTs; dadr++ ) {
+
+        if ( tsrError == pbus->rgtsr[dadr] ) {
+            printf("  0x%02X: probe failed, erc = %d\n", dadr, pbus->rgerc[dadr]);
+        }
+
+        switch ( pbus->rgtsc[dadr] ) {
+
+            case tscGood:
+                printf("  0x%02X: PEC good\n", dadr);
+                break;
+
+            case tscBad:
+                printf("  0x%02X: PEC bad\n", dadr);
+                break;
+
+            case tscError:
+                printf("  0x%02X: PEC read failed, erc = %d\n", dadr, pbus->rgerc[dadr]);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParsePec
+**
+**  Parameters:
+**      sz      - value of a "-pec" option, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse "<command>,<bytes>" into the PEC check.
+*/
+BOOL
+FParsePec( const char * sz ) {
+
+    const char *    pchCount;
+    char            szCmd[16];
+    DWORD           cch;
+
+    pchCount = ( NULL != sz ) ? strchr(sz, ',') : NULL;
+    if (( NULL == pchCount ) || ( pchCount == sz ) ||
+        ( sizeof(szCmd) <= (cch = (DWORD)(pchCount - sz)) )) {
+
+        printf("ERROR: invalid PEC check specified, expected <command>,<bytes>\n");
+        return fFalse;
+    }
+
+    memcpy(szCmd, sz, cch);
+    szCmd[cch] = '\0';
+
+    if (( ! FParseNumber(szCmd, "PEC command", &bPecCmd) ) ||
+        ( ! FParseNumber(pchCount + 1, "PEC byte count", &cbPec) )) {
+        return fFalse;
+    }
+
+    if ( 0xFF < bPecCmd ) {
+
+        printf("ERROR: PEC command must be 0x00 to 0xFF: %s\n", szCmd);
+        return fFalse;
+    }
+
+    if (( 0 == cbPec ) || ( cbTsPecMax < cbPec )) {
+
+        printf("ERROR: PEC byte count must be 1 to %u: %s\n", cbTsPecMax, pchCount + 1);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fShowHelp = fFalse;
+    cdvc = 0;
+    prtScan = 0;
+    frqScan = 0;
+    tspScan = tspAuto;
+    bPecCmd = 0;
+    cbPec = 0;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-d") ) {
+
+            if (( NULL == szVal ) || ( cchDvcNameMax < strlen(szVal) )) {
+
+                printf("ERROR: no valid device name specified\n");
+                return fFalse;
+            }
+
+            if ( cbusTsMax <= cdvc ) {
+
+                printf("ERROR: at most %u devices may be specified\n", cbusTsMax);
+                return fFalse;
+            }
+
+            strcpy(rgdvc[cdvc].szDevName, szVal);
+            rgdvc[cdvc].hif = hifInvalid;
+            cdvc++;
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-p") ) {
+
+            if ( ! FParseNumber(szVal, "port", &prtScan) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-f") ) {
+
+            if ( ! FParseNumber(szVal, "frequency", &frqScan) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-probe") ) {
+
+            if (( NULL != szVal ) && ( 0 == strcmp(szVal, "auto") )) {
+                tspScan = tspAuto;
+            }
+            else if (( NULL != szVal ) && ( 0 == strcmp(szVal, "quick") )) {
+                tspScan = tspQuick;
+            }
+            else if (( NULL != szVal ) && ( 0 == strcmp(szVal, "read") )) {
+                tspScan = tspRead;
+            }
+            else {
+
+                printf("ERROR: probe must be auto, quick or read\n");
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-pec") ) {
+
+            if ( ! FParsePec(szVal) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    fAllDevices = ( 0 == cdvc );
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] [-d <device>]... [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
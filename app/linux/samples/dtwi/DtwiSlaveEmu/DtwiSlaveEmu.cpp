@@ -0,0 +1,759 @@
+/************************************************************************/
+/*                                                                      */
+/*  DtwiSlaveEmu.cpp  --  DtwiSlaveEmu main program                     */
+/*                                                                      */
+/************************************************************************/
+/*  Module Description:                                                 */
+/*                                                                      */
+/*  DtwiSlaveEmu emulates register based I2C slaves on the TWI ports of */
+/*  Digilent devices, one slave per port, so that firmware or an FPGA   */
+/*  design that masters the bus can be tested against targets that      */
+/*  aren't on the board. Each slave is a bank of RAM registers or a     */
+/*  temperature sensor whose reading changes over time. At the end the  */
+/*  activity of each slave, its response latency and the CPU time used  */
+/*  are printed.                                                        */
+/*                                                                      */
+/*                                                                      */
+/*  Required Hardware:                                                  */
+/*                                                                      */
+/*  One or more Digilent devices with a TWI port that supports slave    */
+/*  operation, connected to the I2C bus to serve.                       */
+/*                                                                      */
+/************************************************************************/
+/*  Revision History:                                                   */
+/*                                                                      */
+/*  10/19/2026: created                                                 */
+/*                                                                      */
+/************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+
+/* ------------------------------------------------------------ */
+/*					Include File Definitions					*/
+/* ------------------------------------------------------------ */
+
+#if defined(WIN32)
+
+	/* Include Windows specific headers here.
+	*/
+	#include <windows.h>
+
+#else
+
+	/* Include Unix specific headers here.
+	*/
+	#include <signal.h>
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpcdecl.h"
+#include "dmgr.h"
+#include "dtwi.h"
+#include "TwiSlave.h"
+#include "SmpUtil.h"
+
+/* ------------------------------------------------------------ */
+/*				Local Type Definitions          				*/
+/* ------------------------------------------------------------ */
+
+const   DWORD   cchDescriptionMax = 64;
+const   DWORD   cchOptionMax = 64;
+
+/* The service is run in slices of this length, between which the
+** sensors are updated and a request to stop is checked.
+*/
+const   DWORD   tmsSlice = 100;
+
+/* Registers of the temperature sensor, laid out as an LM75: the
+** reading in degrees and in halves of a degree, a writable
+** configuration register, and an identification register.
+*/
+const   BYTE    iregTempMsb = 0x00;
+const   BYTE    iregTempLsb = 0x01;
+const   BYTE    iregTempCfg = 0x02;
+const   BYTE    iregTempId  = 0xFF;
+const   BYTE    bTempId     = 0xA1;
+
+typedef struct {
+    char    szOption[cchOptionMax + 1];
+    char    szDescription[cchDescriptionMax + 1];
+} OPTN ;
+
+/* A slave given with "-s".
+*/
+typedef struct {
+    char        szDevName[cchDvcNameMax + 1];
+    BYTE        dadr;
+    BOOL        fTemp;
+    HIF         hif;
+    TwiRegMap   map;
+} SLV;
+
+/* ------------------------------------------------------------ */
+/*				Global Variables								*/
+/* ------------------------------------------------------------ */
+
+/* Define an array of supported command line options and descriptions.
+*/
+OPTN   rgoptn[] = {
+    {"-s           ", "slave as <device>,<address>[,ram|temp], repeatable"},
+    {"-t           ", "seconds to run, 0 until Ctrl-C (default 0)"},
+    {"-w           ", "registers kept posted ahead (default 16)"},
+    {"-spin        ", "microseconds to poll after activity (default 2000)"},
+    {"-idle        ", "longest sleep in microseconds (default 10000)"},
+    {"-?, -help    ", "print usage, supported arguments, and options"},
+    {"", ""}
+};
+
+/* Delcare variables used to keep track of command line arguments.
+*/
+BOOL    fShowHelp;
+
+char*   pszCmd;
+SLV     rgslv[ctgtTwsMax];
+DWORD   cslv;
+DWORD   csecRun;
+DWORD   cbWindow;
+DWORD   tusSpin;
+DWORD   tusIdleMax;
+
+/* ------------------------------------------------------------ */
+/*				Local Variables									*/
+/* ------------------------------------------------------------ */
+
+static volatile sig_atomic_t    fStop;
+
+/* ------------------------------------------------------------ */
+/*				Forward Declarations							*/
+/* ------------------------------------------------------------ */
+
+BOOL    FOpenSlaves();
+void    CloseSlaves();
+BOOL    FServe( TwiSlaveSvc * psvc );
+void    UpdateSensors( DWORD islice );
+void    PrintStats( TwiSlaveSvc * psvc, double secRun, double secCpu );
+void    StopHandler( int sig );
+
+BOOL    FParseNumber( const char * sz, const char * szName, DWORD * pdw );
+BOOL    FParseSlave( const char * sz );
+BOOL    FParseArguments( int cszArg, char* rgszArg[] );
+BOOL    FHelp();
+
+/* ------------------------------------------------------------ */
+/*                  Procedure Definitions                       */
+/* ------------------------------------------------------------ */
+/***    main
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      0 for success, 1 otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Application entry point.
+*/
+int
+main( int cszArg, char* rgszArg[] ) {
+
+    TwiSlaveSvc svc;
+    DWORD       islv;
+    BOOL        fSuccess;
+
+    /* Parse the command and command options from the command line
+    ** arguments.
+    */
+    if ( ! FParseArguments(cszArg, rgszArg) ) {
+
+        /* If we failed to parse the command line arguments then an error
+        ** message has already been output to the user.
+        */
+        return 1;
+    }
+
+    /* If the help option was specified then we should display the
+    ** available options and exit.
+    */
+    if ( fShowHelp ) {
+
+        FHelp();
+        return 0;
+    }
+
+    if ( 0 == cslv ) {
+
+        printf("ERROR: you must specify a slave using the \"-s\" option\n");
+        return 1;
+    }
+
+    if ( ! FOpenSlaves() ) {
+
+        CloseSlaves();
+        return 1;
+    }
+
+    for ( islv = 0; islv < cslv; islv++ ) {
+        svc.FAddTarget(rgslv[islv].hif, rgslv[islv].dadr, &rgslv[islv].map);
+    }
+
+    svc.SetTxWindow(cbWindow);
+    svc.SetPacing(tusSpin, tusTwsIdleMin, tusIdleMax);
+
+    fSuccess = FServe(&svc);
+
+    CloseSlaves();
+
+    return fSuccess ? 0 : 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FOpenSlaves
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Open the device of each slave, check that its TWI port supports
+**      slave operation, enable the port and set up the registers.
+*/
+BOOL
+FOpenSlaves() {
+
+    SLV *   pslv;
+    DWORD   islv;
+    DWORD   dprp;
+
+    for ( islv = 0; islv < cslv; islv++ ) {
+
+        pslv = &rgslv[islv];
+
+        if ( ! DmgrOpen(&pslv->hif, pslv->szDevName) ) {
+
+            printf("ERROR: unable to open device \"%s\"\n", pslv->szDevName);
+            pslv->hif = hifInvalid;
+            return fFalse;
+        }
+
+        if (( ! DtwiGetPortProperties(pslv->hif, 0, &dprp) ) ||
+            ( 0 == (dprp & dprpTwiSlave) )) {
+
+            printf("ERROR: the TWI port of \"%s\" doesn't support slave operation\n",
+                   pslv->szDevName);
+            return fFalse;
+        }
+
+        if ( ! DtwiEnable(pslv->hif) ) {
+
+            printf("ERROR: unable to enable DTWI on \"%s\", erc = %d\n",
+                   pslv->szDevName, DmgrGetLastError());
+            DmgrClose(pslv->hif);
+            pslv->hif = hifInvalid;
+            return fFalse;
+        }
+
+        if ( pslv->fTemp ) {
+
+            pslv->map.SetReg(iregTempId, bTempId);
+            pslv->map.SetWritable(iregTempCfg, 1, 0xFF);
+        }
+        else {
+            pslv->map.SetWritable(0, cregTwsMap, 0xFF);
+        }
+    }
+
+    UpdateSensors(0);
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    CloseSlaves
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Disable DTWI and close the devices that were opened.
+*/
+void
+CloseSlaves() {
+
+    DWORD   islv;
+
+    for ( islv = 0; islv < cslv; islv++ ) {
+
+        if ( hifInvalid != rgslv[islv].hif ) {
+
+            DtwiDisable(rgslv[islv].hif);
+            DmgrClose(rgslv[islv].hif);
+            rgslv[islv].hif = hifInvalid;
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    FServe
+**
+**  Parameters:
+**      psvc    - service with the slaves added
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Run the service until the time given with "-t" has passed or
+**      Ctrl-C is pressed, updating the sensors between slices, then
+**      print the statistics.
+*/
+BOOL
+FServe( TwiSlaveSvc * psvc ) {
+
+    double  secStart;
+    double  secCpuStart;
+    DWORD   islice;
+    BOOL    fSuccess;
+
+    if ( ! psvc->FStart() ) {
+
+        printf("ERROR: unable to start slave \"%s\", erc = %d\n",
+               rgslv[psvc->ItgtError()].szDevName, DmgrGetLastError());
+        return fFalse;
+    }
+
+    signal(SIGINT, StopHandler);
+    signal(SIGTERM, StopHandler);
+
+    printf("Serving %u slave(s), press Ctrl-C to stop\n", cslv);
+
+    fSuccess = fTrue;
+    secStart = SecClock(CLOCK_MONOTONIC);
+    secCpuStart = SecClock(CLOCK_PROCESS_CPUTIME_ID);
+
+    for ( islice = 1; ! fStop; islice++ ) {
+
+        if ( ! psvc->FRun(tmsSlice) ) {
+
+            printf("ERROR: slave \"%s\" failed, erc = %d\n",
+                   rgslv[psvc->ItgtError()].szDevName, DmgrGetLastError());
+            fSuccess = fFalse;
+            break;
+        }
+
+        UpdateSensors(islice);
+
+        if (( 0 != csecRun ) && ( SecClock(CLOCK_MONOTONIC) - secStart >= (double)csecRun )) {
+            break;
+        }
+    }
+
+    if (( ! psvc->FStop() ) && ( fSuccess )) {
+
+        printf("ERROR: unable to stop slave \"%s\", erc = %d\n",
+               rgslv[psvc->ItgtError()].szDevName, DmgrGetLastError());
+        fSuccess = fFalse;
+    }
+
+    PrintStats(psvc, SecClock(CLOCK_MONOTONIC) - secStart,
+               SecClock(CLOCK_PROCESS_CPUTIME_ID) - secCpuStart);
+
+    return fSuccess;
+}
+
+/* ------------------------------------------------------------ */
+/***    UpdateSensors
+**
+**  Parameters:
+**      islice  - number of slices run so far
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Move the reading of every temperature sensor along a triangle
+**      wave between 20 and 30 degrees, half a degree per second.
+*/
+void
+UpdateSensors( DWORD islice ) {
+
+    DWORD   islv;
+    DWORD   chdeg;      // halves of a degree above 20
+
+    chdeg = (islice * tmsSlice / 1000) % 40;
+    if ( 20 < chdeg ) {
+        chdeg = 40 - chdeg;
+    }
+
+    for ( islv = 0; islv < cslv; islv++ ) {
+
+        if ( rgslv[islv].fTemp ) {
+
+            rgslv[islv].map.SetReg(iregTempMsb, (BYTE)(20 + chdeg / 2));
+            rgslv[islv].map.SetReg(iregTempLsb, ( 0 != (chdeg & 1) ) ? 0x80 : 0x00);
+        }
+    }
+}
+
+/* ------------------------------------------------------------ */
+/***    PrintStats
+**
+**  Parameters:
+**      psvc    - stopped service
+**      secRun  - time the service ran
+**      secCpu  - CPU time used meanwhile
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Print the activity of each slave, the time from a write to the
+**      response being posted, with the worst case including the time
+**      the write may have waited for a poll, and the cost of polling.
+*/
+void
+PrintStats( TwiSlaveSvc * psvc, double secRun, double secCpu ) {
+
+    const TWSSTAT * pstat;
+    DWORD           itgt;
+
+    printf("\n%-20s %4s %8s %10s %10s %8s %8s %22s %10s\n", "device", "addr",
+           "writes", "bytes in", "bytes out", "posts", "flushes",
+           "response min/avg/max", "worst");
+
+    for ( itgt = 0; itgt < psvc->Ctgt(); itgt++ ) {
+
+        pstat = &psvc->Ptgt(itgt)->stat;
+
+        printf("%-20s 0x%02X %8u %10u %10u %8u %8u", rgslv[itgt].szDevName,
+               rgslv[itgt].dadr, pstat->cwrite, pstat->cbWrite, pstat->cbRead,
+               pstat->cpost, pstat->cflush);
+
+        if ( 0 != pstat->cresp ) {
+
+            printf(" %6u/%6.0f/%6u us %7u us\n", pstat->tusRespMin,
+                   (double)pstat->tusRespSum / pstat->cresp, pstat->tusRespMax,
+                   pstat->tusGapMax);
+        }
+        else {
+            printf(" %22s %10s\n", "-", "-");
+        }
+    }
+
+    printf("\n%u polls and %u sleeps in %.1f s, %.1f%% of the time asleep\n",
+           psvc->Cpoll(), psvc->Csleep(), secRun,
+           100.0 * (double)psvc->TusSlept() / 1000000.0 / secRun);
+    printf("CPU time %.3f s, %.2f%% of one core\n", secCpu, 100.0 * secCpu / secRun);
+}
+
+/* ------------------------------------------------------------ */
+/***    StopHandler
+**
+**  Parameters:
+**      sig     - signal number
+**
+**  Return Values:
+**      none
+**
+**  Errors:
+**
+**  Description:
+**      Ask the service loop to stop.
+*/
+void
+StopHandler( int sig ) {
+
+    (void)sig;
+    fStop = 1;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseNumber
+**
+**  Parameters:
+**      sz      - string to parse, may be NULL
+**      szName  - name of the value for error messages
+**      pdw     - receives the value
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse a decimal or "0x" prefixed hexadecimal number from the
+**      command line.
+*/
+BOOL
+FParseNumber( const char * sz, const char * szName, DWORD * pdw ) {
+
+    char *  pchEnd;
+
+    if (( NULL == sz ) || ( '\0' == sz[0] )) {
+
+        printf("ERROR: no %s specified\n", szName);
+        return fFalse;
+    }
+
+    *pdw = strtoul(sz, &pchEnd, 0);
+
+    if ( '\0' != *pchEnd ) {
+
+        printf("ERROR: invalid %s specified: %s\n", szName, sz);
+        return fFalse;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseSlave
+**
+**  Parameters:
+**      sz      - value of a "-s" option, may be NULL
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse "<device>,<address>[,ram|temp]" into the next slave.
+*/
+BOOL
+FParseSlave( const char * sz ) {
+
+    SLV *           pslv;
+    const char *    pchAdr;
+    const char *    pchModel;
+    char            szAdr[16];
+    DWORD           cch;
+    DWORD           dadr;
+    DWORD           islv;
+
+    if ( ctgtTwsMax <= cslv ) {
+
+        printf("ERROR: at most %u slaves may be specified\n", ctgtTwsMax);
+        return fFalse;
+    }
+
+    pchAdr = ( NULL != sz ) ? strchr(sz, ',') : NULL;
+    if (( NULL == pchAdr ) || ( cchDvcNameMax < (DWORD)(pchAdr - sz) ) || ( pchAdr == sz )) {
+
+        printf("ERROR: invalid slave specified, expected <device>,<address>\n");
+        return fFalse;
+    }
+
+    pchAdr++;
+    pchModel = strchr(pchAdr, ',');
+    cch = ( NULL != pchModel ) ? (DWORD)(pchModel - pchAdr) : strlen(pchAdr);
+
+    if ( sizeof(szAdr) <= cch ) {
+
+        printf("ERROR: invalid slave address specified: %s\n", pchAdr);
+        return fFalse;
+    }
+
+    memcpy(szAdr, pchAdr, cch);
+    szAdr[cch] = '\0';
+
+    if ( ! FParseNumber(szAdr, "slave address", &dadr) ) {
+        return fFalse;
+    }
+
+    if (( 0 == dadr ) || ( 0x7F < dadr )) {
+
+        printf("ERROR: slave address must be 0x01 to 0x7F: %s\n", szAdr);
+        return fFalse;
+    }
+
+    pslv = &rgslv[cslv];
+
+    memcpy(pslv->szDevName, sz, pchAdr - 1 - sz);
+    pslv->szDevName[pchAdr - 1 - sz] = '\0';
+    pslv->dadr = (BYTE)dadr;
+    pslv->fTemp = fFalse;
+    pslv->hif = hifInvalid;
+
+    if ( NULL != pchModel ) {
+
+        if ( 0 == strcmp(pchModel + 1, "temp") ) {
+            pslv->fTemp = fTrue;
+        }
+        else if ( 0 != strcmp(pchModel + 1, "ram") ) {
+
+            printf("ERROR: invalid slave model specified: %s\n", pchModel + 1);
+            return fFalse;
+        }
+    }
+
+    for ( islv = 0; islv < cslv; islv++ ) {
+
+        if ( 0 == strcmp(rgslv[islv].szDevName, pslv->szDevName) ) {
+
+            printf("ERROR: device \"%s\" is given for two slaves\n", pslv->szDevName);
+            return fFalse;
+        }
+    }
+
+    cslv++;
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FParseArguments
+**
+**  Parameters:
+**      cszArg  - number of command line arguments
+**      rgszArg - array of command line argument strings
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Parse the command line arguments.
+*/
+BOOL
+FParseArguments( int cszArg, char* rgszArg[] ) {
+
+    int     iszArg;
+    char *  szVal;
+
+    fShowHelp = fFalse;
+    cslv = 0;
+    csecRun = 0;
+    cbWindow = cbTwsTxWindow;
+    tusSpin = tusTwsSpin;
+    tusIdleMax = tusTwsIdleMax;
+
+    pszCmd = rgszArg[0];
+
+    iszArg = 1;
+    while ( iszArg < cszArg ) {
+
+        szVal = ( iszArg + 1 < cszArg ) ? rgszArg[iszArg + 1] : NULL;
+
+        if ( 0 == strcmp(rgszArg[iszArg], "-s") ) {
+
+            if ( ! FParseSlave(szVal) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-t") ) {
+
+            if ( ! FParseNumber(szVal, "time", &csecRun) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-w") ) {
+
+            if ( ! FParseNumber(szVal, "window", &cbWindow) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-spin") ) {
+
+            if ( ! FParseNumber(szVal, "spin time", &tusSpin) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+        else if ( 0 == strcmp(rgszArg[iszArg], "-idle") ) {
+
+            if ( ! FParseNumber(szVal, "idle time", &tusIdleMax) ) {
+                return fFalse;
+            }
+            iszArg++;
+        }
+
+        /* Check for the -? and --help options. These specify whether
+        ** or not the user wants the help command to be executed.
+        */
+        else if (( 0 == strcmp(rgszArg[iszArg], "-?") ) ||
+                 ( 0 == strcmp(rgszArg[iszArg], "-help") )) {
+
+            fShowHelp = fTrue;
+            return fTrue;
+        }
+
+        /* Unknown command line option specified.
+        */
+        else {
+
+            printf("ERROR: invalid option specified: %s\n", rgszArg[iszArg]);
+            return fFalse;
+        }
+
+        iszArg++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+/***    FHelp
+**
+**  Parameters:
+**      none
+**
+**  Return Values:
+**      fTrue for success, fFalse otherwise
+**
+**  Errors:
+**
+**  Description:
+**      Display usage and other information that the user may find
+**      helpful.
+*/
+BOOL
+FHelp() {
+
+    DWORD   ioptn;
+
+    printf("Usage: %s [-help] -s <device>,<address>[,ram|temp] [options]\n", pszCmd);
+
+    printf("\n");
+
+    printf("  Options:\n");
+
+    ioptn = 0;
+    while ( 0 < strlen(rgoptn[ioptn].szOption) ) {
+
+        printf("    %-20s    %s\n", rgoptn[ioptn].szOption, rgoptn[ioptn].szDescription);
+        ioptn++;
+    }
+
+    return fTrue;
+}
+
+/* ------------------------------------------------------------ */
+
+/************************************************************************/
@@ -39,11 +39,25 @@
 --		pwr			- data direction (described in reference manual as WRITE)
 --		pwait		- transfer synchronization (described in reference manual as WAIT)
 --		
+--	Addresses from ext_base up are not held in data_regs. They are passed to
+--	the logic outside this module through the ext_* signals, so that it can
+--	implement registers with side effects such as FIFO data registers:
+--		ext_adr		- current address register
+--		ext_din		- data being written
+--		ext_wr		- high for one clock when ext_din is written
+--		ext_rd		- high for one clock after ext_dout has been read
+--		ext_dout	- data returned for reads
+--	The ext_* ports may be left open by designs that don't use them, such
+--	as StreamIO, which reads 0 from those addresses.
+--	Each transfer of a DeppPutRegRepeat or DeppGetRegRepeat call to one of
+--	these addresses gives one ext_wr or ext_rd pulse.
+--		
 ----------------------------------------------------------------------------
 -- Revision History:
 --  06/09/2004(GeneA): created
 --	08/10/2004(GeneA): initial public release
 --	04/25/2006(JoshP): comment addition  
+--	10/19/2026: added the ext_* signals for registers outside data_regs
 ----------------------------------------------------------------------------
 
 library IEEE;
@@ -61,7 +75,8 @@ use work.reg_spec.all;
 entity dpimref is
     Generic (
     	addr_width : integer := 8;
-    	addr : integer :=16);
+    	addr : integer :=16;
+    	ext_base : integer := 32);
     Port (
 	mclk 	: in std_logic;
         pdb		: inout std_logic_vector(7 downto 0);
@@ -69,7 +84,12 @@ entity dpimref is
         dstb 	: in std_logic;
         pwr 	: in std_logic;
         pwait 	: out std_logic;
-		  data_regs : inout data_regs_array(0 to addr));
+		  data_regs : inout data_regs_array(0 to addr);
+		  ext_adr	: out std_logic_vector(7 downto 0);
+		  ext_din	: out std_logic_vector(7 downto 0);
+		  ext_wr	: out std_logic;
+		  ext_rd	: out std_logic;
+		  ext_dout	: in std_logic_vector(7 downto 0) := (others => '0'));
 end dpimref;
 
 architecture Behavioral of dpimref is
@@ -108,6 +128,7 @@ architecture Behavioral of dpimref is
 
 	-- State machine current state register
 	signal	stEppCur	: std_logic_vector(7 downto 0) := stEppReady;
+	signal	stEppPrev	: std_logic_vector(7 downto 0) := stEppReady;
 
 	signal	stEppNext	: std_logic_vector(7 downto 0);
 
@@ -127,6 +148,9 @@ architecture Behavioral of dpimref is
 
 	-- Registers
 	signal	regEppAdr	: std_logic_vector(7 downto 0) := (others => '0');
+
+	-- The address register selects a register outside data_regs
+	signal	fEppExt		: std_logic;
 	
 ------------------------------------------------------------------------
 -- Module Implementation
@@ -157,7 +181,19 @@ begin
 	busEppOut <= "00000000" or regEppAdr when ctlEppAstb = '0' else busEppData;
 
 	-- Decode the address register and select the appropriate data register
-	busEppData <=	data_regs(conv_integer(regEppAdr)).data;
+	fEppExt <= '1' when conv_integer(regEppAdr) >= ext_base else '0';
+
+	busEppData <=	ext_dout when fEppExt = '1' else
+					data_regs(conv_integer(regEppAdr)).data when conv_integer(regEppAdr) <= addr else
+					"00000000";
+
+	-- Registers outside data_regs. A write strobe is given in the first
+	-- state of a data write cycle and a read strobe in the clock after a data
+	-- read cycle has ended, when the host has taken the data.
+	ext_adr <= regEppAdr;
+	ext_din <= busEppIn;
+	ext_wr  <= ctlEppDwr and fEppExt;
+	ext_rd  <= fEppExt when stEppPrev = stEppDrdB and stEppCur = stEppReady else '0';
 
     ------------------------------------------------------------------------
 	-- EPP Interface Control State Machine
@@ -174,6 +210,7 @@ begin
 	process (clkMain)
 		begin
 			if clkMain = '1' and clkMain'Event then
+				stEppPrev <= stEppCur;
 				stEppCur <= stEppNext;
 			end if;
 		end process;
@@ -284,7 +321,7 @@ begin
 	process (clkMain, regEppAdr, ctlEppDwr, busEppIn)
 		begin
 			if clkMain = '1' and clkMain'Event then
-				if ctlEppDwr = '1' then
+				if ctlEppDwr = '1' and conv_integer(regEppAdr) <= addr then
 					
 					data_regs(conv_integer(regEppAdr)).data <= busEppIn;
 				end if;
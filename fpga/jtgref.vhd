@@ -0,0 +1,278 @@
+----------------------------------------------------------------------------
+--	JTGREF.VHD -- JTAG USER register bridge for the dpimref register file
+----------------------------------------------------------------------------
+--	This module gives the host the same registers as dpimref, data_regs
+--	and the ext_* registers above ext_base, through the USER1 instruction
+--	of the FPGA TAP instead of the EPP port. It is meant for boards where
+--	only the JTAG path is available. The two modules have the same
+--	register side ports, so that either can drive the logic behind them.
+--
+--	While USER1 is loaded, Shift-DR carries a stream of register access
+--	frames, sent LSB first. Outside a frame TDI is 0; a frame starts with
+--	a 1:
+--
+--		write	1, 1, addr(0..7), data(0..7)		18 bits
+--		read	1, 0, addr(0..7), read_pad bits, 8 bits	18 + read_pad bits
+--
+--	During the last pad bit of a read TDO is 1 if the register was read
+--	in time, and during the following 8 bits TDO gives the data, LSB
+--	first. TDO is 0 everywhere else. The frame position is cleared in
+--	Capture-DR, so the host can stay in Shift-DR and send any number of
+--	frames, split over any number of scans. The host side of this bridge
+--	is JtgReg in app/linux/samples/common.
+--
+--	The accesses are made in the mclk domain. Each frame is passed over
+--	with a toggle handshake that takes up to six mclk cycles, and the
+--	answer of a read takes two more TCK cycles to be seen. A read has
+--	read_pad - 1 TCK cycles for both, so TCK must be at most
+--	mclk * (read_pad - 3) / 6: mclk itself with the default read_pad of
+--	9, and half of it with 6. A read of an ext_* register gives one
+--	ext_rd pulse and a write one ext_wr pulse, as with dpimref.
+--
+--	The BSCAN_SPARTAN6 primitive is used; other families need their own
+--	BSCAN primitive, with the same outputs.
+--
+--	Interface signals used in top level entity port:
+--		mclk		- master clock, generally 50Mhz osc on system board
+--		data_regs	- data registers, see dpimref.vhd
+--		ext_*		- registers outside data_regs, see dpimref.vhd
+----------------------------------------------------------------------------
+-- Revision History:
+--	10/19/2026: created
+--	10/19/2026: read_pad raised to 9, so that TCK may equal mclk
+----------------------------------------------------------------------------
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.STD_LOGIC_ARITH.ALL;
+use IEEE.STD_LOGIC_UNSIGNED.ALL;
+
+use work.reg_spec.all;
+
+library UNISIM;
+use UNISIM.VComponents.all;
+
+entity jtgref is
+    Generic (
+    	addr_width : integer := 8;
+    	addr : integer :=16;
+    	ext_base : integer := 32;
+    	read_pad : integer := 9);
+    Port (
+	mclk 	: in std_logic;
+		  data_regs : inout data_regs_array(0 to addr);
+		  ext_adr	: out std_logic_vector(7 downto 0);
+		  ext_din	: out std_logic_vector(7 downto 0);
+		  ext_wr	: out std_logic;
+		  ext_rd	: out std_logic;
+		  ext_dout	: in std_logic_vector(7 downto 0));
+end jtgref;
+
+architecture Behavioral of jtgref is
+
+------------------------------------------------------------------------
+--  Constant Declarations
+------------------------------------------------------------------------
+
+	-- Frame positions, counted in bits received. Position 0 waits for the
+	-- start bit. A read loads TDO when the second to last pad bit has
+	-- been received and ends after its eight data bits.
+	constant	ibitAdrFirst	: integer := 2;
+	constant	ibitAdrLast		: integer := 9;
+	constant	ibitDinLast		: integer := 17;
+	constant	ibitRdLoad		: integer := ibitAdrLast + read_pad - 1;
+	constant	ibitRdLast		: integer := ibitAdrLast + read_pad + 8;
+
+------------------------------------------------------------------------
+-- Signal Declarations
+------------------------------------------------------------------------
+
+	-- BSCAN outputs
+	signal	jtTck		: std_logic;
+	signal	jtTdi		: std_logic;
+	signal	jtTdo		: std_logic;
+	signal	jtSel		: std_logic;
+	signal	jtShift		: std_logic;
+	signal	jtCapture	: std_logic;
+	signal	jtReset		: std_logic;
+
+	-- TCK domain: frame position, fields received and the TDO shifter
+	signal	jtIbit		: integer range 0 to ibitRdLast := 0;
+	signal	jtWr		: std_logic := '0';
+	signal	jtAdr		: std_logic_vector(7 downto 0) := (others => '0');
+	signal	jtDin		: std_logic_vector(7 downto 0) := (others => '0');
+	signal	jtOut		: std_logic_vector(8 downto 0) := (others => '0');
+
+	-- Request passed to the mclk domain. The fields are held until the
+	-- next request, and the toggle changes once they are set.
+	signal	jtReq		: std_logic := '0';
+	signal	jtReqWr		: std_logic := '0';
+	signal	jtReqAdr	: std_logic_vector(7 downto 0) := (others => '0');
+	signal	jtReqDin	: std_logic_vector(7 downto 0) := (others => '0');
+	signal	jtAckSync	: std_logic_vector(1 downto 0) := "00";
+
+	-- mclk domain
+	signal	mcReqSync	: std_logic_vector(2 downto 0) := "000";
+	signal	mcStep		: std_logic_vector(1 downto 0) := "00";
+	signal	mcWr		: std_logic := '0';
+	signal	mcAdr		: std_logic_vector(7 downto 0) := (others => '0');
+	signal	mcDin		: std_logic_vector(7 downto 0) := (others => '0');
+	signal	mcDout		: std_logic_vector(7 downto 0) := (others => '0');
+	signal	mcAck		: std_logic := '0';
+	signal	mcExtWr		: std_logic := '0';
+	signal	mcExtRd		: std_logic := '0';
+	signal	fExt		: std_logic;
+	signal	busData		: std_logic_vector(7 downto 0);
+
+------------------------------------------------------------------------
+-- Module Implementation
+------------------------------------------------------------------------
+
+begin
+
+    ------------------------------------------------------------------------
+	-- USER1 data register
+    ------------------------------------------------------------------------
+
+	bscan: BSCAN_SPARTAN6
+		generic map (JTAG_CHAIN => 1)
+		port map (
+			CAPTURE => jtCapture,
+			DRCK => open,
+			RESET => jtReset,
+			RUNTEST => open,
+			SEL => jtSel,
+			SHIFT => jtShift,
+			TCK => jtTck,
+			TDI => jtTdi,
+			TMS => open,
+			UPDATE => open,
+			TDO => jtTdo);
+
+	jtTdo <= jtOut(0);
+
+	-- This process takes in the frames a bit at a time and passes each
+	-- access to the mclk domain once its last field has been received.
+	process (jtTck)
+		begin
+			if jtTck = '1' and jtTck'Event then
+				jtAckSync <= jtAckSync(0) & mcAck;
+
+				if jtReset = '1' or (jtSel = '1' and jtCapture = '1') then
+					jtIbit <= 0;
+					jtOut <= (others => '0');
+
+				elsif jtSel = '1' and jtShift = '1' then
+					jtOut <= '0' & jtOut(8 downto 1);
+
+					if jtIbit = 0 then
+						if jtTdi = '1' then
+							jtIbit <= 1;
+						end if;
+
+					elsif jtIbit = 1 then
+						jtWr <= jtTdi;
+						jtIbit <= 2;
+
+					elsif jtIbit <= ibitAdrLast then
+						jtAdr <= jtTdi & jtAdr(7 downto 1);
+						jtIbit <= jtIbit + 1;
+
+						-- A read is started as soon as its address is known.
+						if jtIbit = ibitAdrLast and jtWr = '0' then
+							jtReqWr <= '0';
+							jtReqAdr <= jtTdi & jtAdr(7 downto 1);
+							jtReq <= not jtReq;
+						end if;
+
+					elsif jtWr = '1' then
+						jtDin <= jtTdi & jtDin(7 downto 1);
+
+						if jtIbit = ibitDinLast then
+							jtReqWr <= '1';
+							jtReqAdr <= jtAdr;
+							jtReqDin <= jtTdi & jtDin(7 downto 1);
+							jtReq <= not jtReq;
+							jtIbit <= 0;
+						else
+							jtIbit <= jtIbit + 1;
+						end if;
+
+					else
+						-- The data read goes out after a bit that says
+						-- whether the mclk domain answered in time.
+						if jtIbit = ibitRdLoad then
+							if jtAckSync(1) = jtReq then
+								jtOut <= mcDout & '1';
+							else
+								jtOut <= (others => '0');
+							end if;
+						end if;
+
+						if jtIbit = ibitRdLast then
+							jtIbit <= 0;
+						else
+							jtIbit <= jtIbit + 1;
+						end if;
+					end if;
+				end if;
+			end if;
+		end process;
+
+    ------------------------------------------------------------------------
+	-- Register accesses
+    ------------------------------------------------------------------------
+
+	fExt <= '1' when conv_integer(mcAdr) >= ext_base else '0';
+
+	busData <=	ext_dout when fExt = '1' else
+				data_regs(conv_integer(mcAdr)).data when conv_integer(mcAdr) <= addr else
+				"00000000";
+
+	ext_adr <= mcAdr;
+	ext_din <= mcDin;
+	ext_wr  <= mcExtWr;
+	ext_rd  <= mcExtRd;
+
+	-- This process takes the fields of a request once its toggle has been
+	-- seen, makes the access in the next clock and then acknowledges it.
+	-- The strobes of the ext_* registers last one clock.
+	process (mclk)
+		begin
+			if mclk = '1' and mclk'Event then
+				mcReqSync <= mcReqSync(1 downto 0) & jtReq;
+				mcExtWr <= '0';
+				mcExtRd <= '0';
+
+				case mcStep is
+					when "00" =>
+						if mcReqSync(2) /= mcReqSync(1) then
+							mcWr <= jtReqWr;
+							mcAdr <= (others => '0');
+							mcAdr(addr_width - 1 downto 0) <= jtReqAdr(addr_width - 1 downto 0);
+							mcDin <= jtReqDin;
+							mcStep <= "01";
+						end if;
+
+					when "01" =>
+						if mcWr = '1' then
+							if conv_integer(mcAdr) <= addr then
+								data_regs(conv_integer(mcAdr)).data <= mcDin;
+							end if;
+							mcExtWr <= fExt;
+						else
+							mcDout <= busData;
+							mcExtRd <= fExt;
+						end if;
+						mcStep <= "10";
+
+					when others =>
+						mcAck <= not mcAck;
+						mcStep <= "00";
+				end case;
+			end if;
+		end process;
+
+----------------------------------------------------------------------------
+
+end Behavioral;
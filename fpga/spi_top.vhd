@@ -0,0 +1,394 @@
+----------------------------------------------------------------------------
+--	SPI_TOP.VHD -- DEPP register file with FIFO-fed SPI and I2C masters
+----------------------------------------------------------------------------
+--	This module connects n_slaves instances of spi_interface (modules/spi)
+--	to the registers of dpimref. Each instance has its own spi_master,
+--	FIFOs and bus pins, so that every slave can be run at its own clock
+--	and frames to different slaves are sent at the same time. The SPI
+--	registers are placed above the data registers, in the range that
+--	dpimref passes out through its ext_* signals. Slave n has a block of
+--	16 registers at 0x20 + 16 * n, laid out as follows:
+--
+--		+0x0	SPI_CFG		r/w	cfg_reg of spi_interface
+--		+0x1	SPI_STAT	r	status of spi_interface
+--						w	any write empties both FIFOs
+--		+0x2	SPI_DATA	w	write a byte to the TX FIFO
+--						r	read a byte from the RX FIFO
+--		+0x3	SPI_TXLVL	r	bytes in the TX FIFO, bits 7..0
+--		+0x4	SPI_TXLVH	r	bytes in the TX FIFO, bits 15..8
+--		+0x5	SPI_RXLVL	r	bytes in the RX FIFO, bits 7..0
+--		+0x6	SPI_RXLVH	r	bytes in the RX FIFO, bits 15..8
+--		+0x7	SPI_DIVL	r/w	clock divider, bits 7..0
+--		+0x8	SPI_DIVH	r/w	clock divider, bits 15..8
+--
+--	Both FIFOs hold 512 bytes. A frame is sent by setting the hold bit of
+--	SPI_CFG, writing the frame to SPI_DATA with DeppPutRegRepeat and
+--	clearing hold. The reply is read from SPI_DATA with DeppGetRegRepeat
+--	once the busy bit of SPI_STAT is clear. When the clock divider is not
+--	zero, SCLK runs at 50MHz / (2 * divider) and the speed setting of
+--	SPI_CFG is ignored. The host side of this interface is DeppSpi in
+--	app/linux/samples/common.
+--
+--	The block after the last slave, at 0x20 + 16 * n_slaves, holds the
+--	registers of an I2C master with command and data FIFOs, i2c_interface
+--	(modules/i2c). It is only reachable when n_slaves is 13 or less:
+--
+--		+0x0	I2C_CFG		r/w	cfg_reg of i2c_interface
+--		+0x1	I2C_STAT	r	status of i2c_interface
+--						w	any write empties the FIFOs
+--		+0x2	I2C_DATA	w	write a byte to the TX FIFO
+--						r	read a byte from the RX FIFO
+--		+0x3	I2C_TXLVL	r	bytes in the TX FIFO, bits 7..0
+--		+0x4	I2C_TXLVH	r	bytes in the TX FIFO, bits 15..8
+--		+0x5	I2C_RXLVL	r	bytes in the RX FIFO, bits 7..0
+--		+0x6	I2C_RXLVH	r	bytes in the RX FIFO, bits 15..8
+--		+0x7	I2C_DIVL	r/w	clock divider, bits 7..0
+--		+0x8	I2C_DIVH	r/w	clock divider, bits 15..8
+--		+0x9	I2C_CMD		w	write a byte of a command
+--						r	commands in the command FIFO
+--		+0xA	I2C_STRL	r	SCL periods stretched, bits 7..0
+--		+0xB	I2C_STRH	r	SCL periods stretched, bits 15..8
+--
+--	A command is three bytes: the address and r/w bit as sent on the bus,
+--	then a 15 bit byte count, low byte first, with the chain bit in bit 7
+--	of the high byte. The data and commands of a whole transaction, such
+--	as a register pointer write chained to a read, are written with one
+--	DeppPutRegSet that sets the hold bit of I2C_CFG first and clears it
+--	last. The bytes read are taken from I2C_DATA with DeppGetRegRepeat
+--	once the busy bit of I2C_STAT is clear. SCL runs at i2c_bus_clk while
+--	the clock divider is zero, and at 50MHz / (4 * divider) otherwise,
+--	which may be changed between transactions. I2C_STRL/H count the SCL
+--	periods that slaves stretched since the FIFOs were last emptied. The
+--	host side of this interface is DeppI2c in app/linux/samples/common.
+--
+--	When jtag_regs is true the registers are reached through the USER1
+--	instruction of the JTAG port, by jtgref, instead of through EPP. The
+--	EPP pins are then left floating.
+--
+--	Interface signals used in top level entity port:
+--		mclk, pdb, astb, dstb, pwr, pwait	- see dpimref.vhd
+--		miso, sclk, ss_n, mosi				- SPI bus of each slave
+--		sda, scl							- I2C bus
+----------------------------------------------------------------------------
+-- Revision History:
+--	10/19/2026: created
+--	10/19/2026: one register block, spi_interface and bus per slave, and
+--				the 16 bit clock divider registers
+--	10/19/2026: added jtag_regs to reach the registers through jtgref
+--	10/19/2026: added the I2C register block and i2c_interface
+--	10/19/2026: added the I2C clock divider and stretch count registers
+----------------------------------------------------------------------------
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.STD_LOGIC_ARITH.ALL;
+use IEEE.STD_LOGIC_UNSIGNED.ALL;
+
+use work.reg_spec.all;
+
+entity spi_top is
+    Generic (
+	n_slaves : integer := 4;
+	jtag_regs : boolean := false;
+	i2c_bus_clk : integer := 100_000);
+    Port (
+	mclk 	: in std_logic;
+        pdb		: inout std_logic_vector(7 downto 0);
+        astb 	: in std_logic;
+        dstb 	: in std_logic;
+        pwr 	: in std_logic;
+        pwait 	: out std_logic;
+        miso	: in std_logic_vector(n_slaves-1 downto 0);
+        sclk	: inout std_logic_vector(n_slaves-1 downto 0);
+        ss_n	: inout std_logic_vector(n_slaves-1 downto 0);
+        mosi	: out std_logic_vector(n_slaves-1 downto 0);
+        sda		: inout std_logic;
+        scl		: inout std_logic);
+end spi_top;
+
+architecture Behavioral of spi_top is
+
+------------------------------------------------------------------------
+-- Component Declarations
+------------------------------------------------------------------------
+
+	component dpimref is
+		Generic (
+			addr_width : integer := 8;
+			addr : integer :=16;
+			ext_base : integer := 32);
+		Port (
+			mclk 	: in std_logic;
+			pdb		: inout std_logic_vector(7 downto 0);
+			astb 	: in std_logic;
+			dstb 	: in std_logic;
+			pwr 	: in std_logic;
+			pwait 	: out std_logic;
+			data_regs : inout data_regs_array(0 to addr);
+			ext_adr	: out std_logic_vector(7 downto 0);
+			ext_din	: out std_logic_vector(7 downto 0);
+			ext_wr	: out std_logic;
+			ext_rd	: out std_logic;
+			ext_dout	: in std_logic_vector(7 downto 0) := (others => '0'));
+	end component;
+
+	component jtgref is
+		Generic (
+			addr_width : integer := 8;
+			addr : integer :=16;
+			ext_base : integer := 32;
+			read_pad : integer := 9);
+		Port (
+			mclk 	: in std_logic;
+			data_regs : inout data_regs_array(0 to addr);
+			ext_adr	: out std_logic_vector(7 downto 0);
+			ext_din	: out std_logic_vector(7 downto 0);
+			ext_wr	: out std_logic;
+			ext_rd	: out std_logic;
+			ext_dout	: in std_logic_vector(7 downto 0));
+	end component;
+
+	component spi_interface is
+		GENERIC(
+			fifo_width : INTEGER := 9);
+		PORT(
+			clock    : IN     STD_LOGIC;
+			cfg_reg  : IN     STD_LOGIC_VECTOR(7 downto 0);
+			div_reg  : IN     STD_LOGIC_VECTOR(15 downto 0);
+			tx_wr    : IN     STD_LOGIC;
+			tx_data  : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);
+			rx_rd    : IN     STD_LOGIC;
+			rx_data  : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0);
+			flush    : IN     STD_LOGIC;
+			status   : OUT    STD_LOGIC_VECTOR(7 downto 0);
+			tx_level : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);
+			rx_level : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);
+			miso     : IN     STD_LOGIC;
+			sclk     : INOUT  STD_LOGIC;
+			ss_n     : INOUT  STD_LOGIC;
+			mosi     : OUT    STD_LOGIC);
+	end component;
+
+	component i2c_interface is
+		GENERIC(
+			input_clk  : INTEGER := 50_000_000;
+			bus_clk    : INTEGER := 100_000;
+			fifo_width : INTEGER := 9);
+		PORT(
+			clock     : IN     STD_LOGIC;
+			cfg_reg   : IN     STD_LOGIC_VECTOR(7 downto 0);
+			div_reg   : IN     STD_LOGIC_VECTOR(15 downto 0);
+			cmd_wr    : IN     STD_LOGIC;
+			cmd_data  : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);
+			tx_wr     : IN     STD_LOGIC;
+			tx_data   : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);
+			rx_rd     : IN     STD_LOGIC;
+			rx_data   : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0);
+			flush     : IN     STD_LOGIC;
+			status    : OUT    STD_LOGIC_VECTOR(7 downto 0);
+			cmd_level : OUT    STD_LOGIC_VECTOR(4 DOWNTO 0);
+			tx_level  : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);
+			rx_level  : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);
+			stretch_count : OUT STD_LOGIC_VECTOR(15 DOWNTO 0);
+			sda       : INOUT  STD_LOGIC;
+			scl       : INOUT  STD_LOGIC);
+	end component;
+
+------------------------------------------------------------------------
+--  Constant Declarations
+------------------------------------------------------------------------
+
+	-- Block of the first slave, in bits 7..4 of the address, and the
+	-- registers of a block, in bits 3..0.
+	constant	blkSpiFirst	: integer := 2;
+
+	constant	regSpiCfg	: std_logic_vector(3 downto 0) := x"0";
+	constant	regSpiStat	: std_logic_vector(3 downto 0) := x"1";
+	constant	regSpiData	: std_logic_vector(3 downto 0) := x"2";
+	constant	regSpiTxLvL	: std_logic_vector(3 downto 0) := x"3";
+	constant	regSpiTxLvH	: std_logic_vector(3 downto 0) := x"4";
+	constant	regSpiRxLvL	: std_logic_vector(3 downto 0) := x"5";
+	constant	regSpiRxLvH	: std_logic_vector(3 downto 0) := x"6";
+	constant	regSpiDivL	: std_logic_vector(3 downto 0) := x"7";
+	constant	regSpiDivH	: std_logic_vector(3 downto 0) := x"8";
+
+	-- The I2C block follows the last slave. Its registers share the
+	-- offsets of the SPI registers where they do the same thing.
+	constant	blkI2c		: integer := blkSpiFirst + n_slaves;
+
+	constant	regI2cCmd	: std_logic_vector(3 downto 0) := x"9";
+	constant	regI2cStrL	: std_logic_vector(3 downto 0) := x"A";
+	constant	regI2cStrH	: std_logic_vector(3 downto 0) := x"B";
+
+------------------------------------------------------------------------
+-- Type Declarations
+------------------------------------------------------------------------
+
+	type	slave_bytes is array (0 to n_slaves-1) of std_logic_vector(7 downto 0);
+	type	slave_words is array (0 to n_slaves-1) of std_logic_vector(15 downto 0);
+	type	slave_levels is array (0 to n_slaves-1) of std_logic_vector(9 downto 0);
+
+------------------------------------------------------------------------
+-- Signal Declarations
+------------------------------------------------------------------------
+
+	signal	data_regs	: data_regs_array(0 to 16);
+
+	signal	extAdr		: std_logic_vector(7 downto 0);
+	signal	extDin		: std_logic_vector(7 downto 0);
+	signal	extWr		: std_logic;
+	signal	extRd		: std_logic;
+	signal	extDout		: std_logic_vector(7 downto 0);
+	signal	extReg		: std_logic_vector(3 downto 0);
+
+	signal	slvSel		: std_logic_vector(n_slaves-1 downto 0);
+	signal	slvDout		: slave_bytes;
+
+	signal	regSpiCfgs	: slave_bytes := (others => (others => '0'));
+	signal	regSpiDivs	: slave_words := (others => (others => '0'));
+	signal	spiStat		: slave_bytes;
+	signal	spiRxData	: slave_bytes;
+	signal	spiTxLevel	: slave_levels;
+	signal	spiRxLevel	: slave_levels;
+	signal	spiTxWr		: std_logic_vector(n_slaves-1 downto 0);
+	signal	spiRxRd		: std_logic_vector(n_slaves-1 downto 0);
+	signal	spiFlush	: std_logic_vector(n_slaves-1 downto 0);
+
+	signal	i2cSel		: std_logic;
+	signal	i2cDout		: std_logic_vector(7 downto 0);
+	signal	regI2cCfg	: std_logic_vector(7 downto 0) := (others => '0');
+	signal	regI2cDiv	: std_logic_vector(15 downto 0) := (others => '0');
+	signal	i2cStretch	: std_logic_vector(15 downto 0);
+	signal	i2cStat		: std_logic_vector(7 downto 0);
+	signal	i2cRxData	: std_logic_vector(7 downto 0);
+	signal	i2cCmdLevel	: std_logic_vector(4 downto 0);
+	signal	i2cTxLevel	: std_logic_vector(9 downto 0);
+	signal	i2cRxLevel	: std_logic_vector(9 downto 0);
+	signal	i2cCmdWr	: std_logic;
+	signal	i2cTxWr		: std_logic;
+	signal	i2cRxRd		: std_logic;
+	signal	i2cFlush	: std_logic;
+
+------------------------------------------------------------------------
+-- Module Implementation
+------------------------------------------------------------------------
+
+begin
+
+	epp: if not jtag_regs generate
+		dpim: dpimref port map (mclk, pdb, astb, dstb, pwr, pwait, data_regs,
+								extAdr, extDin, extWr, extRd, extDout);
+	end generate;
+
+	jtag: if jtag_regs generate
+		jreg: jtgref port map (mclk, data_regs, extAdr, extDin, extWr, extRd, extDout);
+
+		pdb   <= "ZZZZZZZZ";
+		pwait <= '0';
+	end generate;
+
+	extReg <= extAdr(3 downto 0);
+
+	slaves: for i in 0 to n_slaves-1 generate
+
+		slvSel(i) <= '1' when conv_integer(extAdr(7 downto 4)) = blkSpiFirst + i else '0';
+
+		spi: spi_interface port map (mclk, regSpiCfgs(i), regSpiDivs(i),
+									 spiTxWr(i), extDin, spiRxRd(i), spiRxData(i),
+									 spiFlush(i), spiStat(i), spiTxLevel(i), spiRxLevel(i),
+									 miso(i), sclk(i), ss_n(i), mosi(i));
+
+		-- Writes to the data register and to the status register act on the
+		-- FIFOs, reads of the data register take a byte from the RX FIFO.
+		spiTxWr(i)  <= extWr when slvSel(i) = '1' and extReg = regSpiData else '0';
+		spiFlush(i) <= extWr when slvSel(i) = '1' and extReg = regSpiStat else '0';
+		spiRxRd(i)  <= extRd when slvSel(i) = '1' and extReg = regSpiData else '0';
+
+		process (mclk)
+			begin
+				if mclk = '1' and mclk'Event then
+					if extWr = '1' and slvSel(i) = '1' then
+						if extReg = regSpiCfg then
+							regSpiCfgs(i) <= extDin;
+						elsif extReg = regSpiDivL then
+							regSpiDivs(i)(7 downto 0) <= extDin;
+						elsif extReg = regSpiDivH then
+							regSpiDivs(i)(15 downto 8) <= extDin;
+						end if;
+					end if;
+				end if;
+			end process;
+
+		with extReg select
+			slvDout(i) <=	regSpiCfgs(i)						when regSpiCfg,
+							spiStat(i)							when regSpiStat,
+							spiRxData(i)						when regSpiData,
+							spiTxLevel(i)(7 downto 0)			when regSpiTxLvL,
+							"000000" & spiTxLevel(i)(9 downto 8)	when regSpiTxLvH,
+							spiRxLevel(i)(7 downto 0)			when regSpiRxLvL,
+							"000000" & spiRxLevel(i)(9 downto 8)	when regSpiRxLvH,
+							regSpiDivs(i)(7 downto 0)			when regSpiDivL,
+							regSpiDivs(i)(15 downto 8)			when regSpiDivH,
+							"00000000"							when others;
+
+	end generate;
+
+	i2cSel <= '1' when conv_integer(extAdr(7 downto 4)) = blkI2c else '0';
+
+	i2c: i2c_interface generic map (50_000_000, i2c_bus_clk, 9)
+					   port map (mclk, regI2cCfg, regI2cDiv, i2cCmdWr, extDin,
+								 i2cTxWr, extDin, i2cRxRd, i2cRxData,
+								 i2cFlush, i2cStat, i2cCmdLevel, i2cTxLevel, i2cRxLevel,
+								 i2cStretch, sda, scl);
+
+	i2cCmdWr <= extWr when i2cSel = '1' and extReg = regI2cCmd else '0';
+	i2cTxWr  <= extWr when i2cSel = '1' and extReg = regSpiData else '0';
+	i2cFlush <= extWr when i2cSel = '1' and extReg = regSpiStat else '0';
+	i2cRxRd  <= extRd when i2cSel = '1' and extReg = regSpiData else '0';
+
+	process (mclk)
+		begin
+			if mclk = '1' and mclk'Event then
+				if extWr = '1' and i2cSel = '1' then
+					if extReg = regSpiCfg then
+						regI2cCfg <= extDin;
+					elsif extReg = regSpiDivL then
+						regI2cDiv(7 downto 0) <= extDin;
+					elsif extReg = regSpiDivH then
+						regI2cDiv(15 downto 8) <= extDin;
+					end if;
+				end if;
+			end if;
+		end process;
+
+	with extReg select
+		i2cDout <=	regI2cCfg							when regSpiCfg,
+					i2cStat								when regSpiStat,
+					i2cRxData							when regSpiData,
+					i2cTxLevel(7 downto 0)				when regSpiTxLvL,
+					"000000" & i2cTxLevel(9 downto 8)	when regSpiTxLvH,
+					i2cRxLevel(7 downto 0)				when regSpiRxLvL,
+					"000000" & i2cRxLevel(9 downto 8)	when regSpiRxLvH,
+					regI2cDiv(7 downto 0)				when regSpiDivL,
+					regI2cDiv(15 downto 8)				when regSpiDivH,
+					"000" & i2cCmdLevel					when regI2cCmd,
+					i2cStretch(7 downto 0)				when regI2cStrL,
+					i2cStretch(15 downto 8)				when regI2cStrH,
+					"00000000"							when others;
+
+	-- Registers outside the blocks of the slaves and the I2C block read as
+	-- zero.
+	process (slvSel, slvDout, i2cSel, i2cDout)
+		begin
+			extDout <= "00000000";
+			for i in 0 to n_slaves-1 loop
+				if slvSel(i) = '1' then
+					extDout <= slvDout(i);
+				end if;
+			end loop;
+			if i2cSel = '1' then
+				extDout <= i2cDout;
+			end if;
+		end process;
+
+end Behavioral;
@@ -0,0 +1,100 @@
+--------------------------------------------------------------------------------
+-- Synchronous FIFO for streaming data through the virtual-io register file
+--
+-- The FIFO is first word fall through: dout always holds the oldest byte
+-- while empty = '0', and rd removes it. The storage is read synchronously so
+-- that it can be built from block RAM. The read address is the one the head
+-- will have after the current clock, and a byte written to an empty FIFO is
+-- passed straight to dout, so dout is valid in the clock after a write.
+--
+-- Writes to a full FIFO and reads from an empty one are ignored. flush
+-- empties the FIFO and takes priority over wr and rd.
+--
+-- Date: oct/2026
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.std_logic_arith.all;
+USE ieee.std_logic_unsigned.all;
+
+ENTITY fifo IS
+  GENERIC(
+    d_width : INTEGER := 8;                                 --data width
+    a_width : INTEGER := 9);                                --depth is 2**a_width
+  PORT(
+    clock   : IN     STD_LOGIC;                             --system clock
+    flush   : IN     STD_LOGIC;                             --empty the fifo
+    wr      : IN     STD_LOGIC;                             --write din
+    din     : IN     STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --data to write
+    rd      : IN     STD_LOGIC;                             --remove dout
+    dout    : OUT    STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --oldest data
+    full    : OUT    STD_LOGIC;                             --no room for a write
+    empty   : OUT    STD_LOGIC;                             --nothing to read
+    level   : OUT    STD_LOGIC_VECTOR(a_width DOWNTO 0));   --number of entries
+END fifo;
+
+ARCHITECTURE BEHAVIORAL of fifo is
+
+--signals needed
+  type mem_type is array (0 to 2**a_width - 1) of std_logic_vector(d_width-1 downto 0);
+  signal mem        : mem_type;
+  signal wr_ptr     : std_logic_vector(a_width-1 downto 0) := (others => '0');
+  signal rd_ptr     : std_logic_vector(a_width-1 downto 0) := (others => '0');
+  signal rd_next    : std_logic_vector(a_width-1 downto 0);
+  signal count      : std_logic_vector(a_width downto 0) := (others => '0');
+  signal head       : std_logic_vector(d_width-1 downto 0);
+  signal fifo_full  : std_logic;
+  signal fifo_empty : std_logic;
+  signal wr_ok      : std_logic;
+  signal rd_ok      : std_logic;
+
+  begin
+    fifo_full  <= count(a_width);
+    fifo_empty <= '1' when count = 0 else '0';
+
+    wr_ok <= wr and not fifo_full;
+    rd_ok <= rd and not fifo_empty;
+
+    --position of the head after this clock
+    rd_next <= (others => '0') when flush = '1' else
+               rd_ptr + 1 when rd_ok = '1' else
+               rd_ptr;
+
+    process (clock) is
+    begin
+      if (clock'event and clock = '1') then
+        if (flush = '1') then
+          wr_ptr <= (others => '0');
+          rd_ptr <= (others => '0');
+          count <= (others => '0');
+        else
+          if (wr_ok = '1') then
+            mem(conv_integer(wr_ptr)) <= din;
+            wr_ptr <= wr_ptr + 1;
+          end if;
+
+          if (rd_ok = '1') then
+            rd_ptr <= rd_ptr + 1;
+          end if;
+
+          if (wr_ok = '1' and rd_ok = '0') then
+            count <= count + 1;
+          elsif (wr_ok = '0' and rd_ok = '1') then
+            count <= count - 1;
+          end if;
+        end if;
+
+        --read the new head, or take it from din if it's being written now
+        if (flush = '0' and wr_ok = '1' and wr_ptr = rd_next) then
+          head <= din;
+        else
+          head <= mem(conv_integer(rd_next));
+        end if;
+      end if;
+    end process;
+
+    dout  <= head;
+    full  <= fifo_full;
+    empty <= fifo_empty;
+    level <= count;
+end architecture;
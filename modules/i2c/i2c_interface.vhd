@@ -0,0 +1,347 @@
+--------------------------------------------------------------------------------
+-- I2C module adapter for implementing with virtual-io
+--
+-- A command FIFO and two data FIFOs are placed in front of i2c_master, so that
+-- whole transactions run without the host watching busy for every byte. A
+-- command is written to cmd_data as three bytes, with cmd_wr high for each:
+-- byte	|7		|6	|5	|4	|3	|2	|1	|0		|
+-- 0	|address, bits 6..0									|rw		|
+-- 1	|count, bits 7..0											|
+-- 2	|chain	|count, bits 14..8								|
+-- The third byte puts the command in the command FIFO. A command moves count
+-- bytes to or from the slave at address: a write takes its bytes from the TX
+-- FIFO, which is written with tx_wr, and a read puts the bytes received in
+-- the RX FIFO, which is read with rx_rd. The last byte of a read is NAK'd.
+--
+-- When chain is set, the next command follows with a repeated start instead
+-- of a stop, which is how a register is read: a write of the register
+-- pointer chained to a read. i2c_master decides on the stop when it takes
+-- the last byte of a command, so the next command must be in the FIFO by
+-- then or a stop is sent anyway. Commands that are chained should therefore
+-- be written while hold is set. A chained command to the same address and
+-- direction continues the transfer without a repeated start.
+--
+-- A write command isn't started until the TX FIFO holds all of its bytes, so
+-- the bytes of a write may be written before or after its command but the
+-- master never runs out of them in the middle of a transfer. Write counts
+-- must be 1 to 2**fifo_width and read counts 1 to 32767; other commands are
+-- dropped and set cmd_err, as is a command written with the command FIFO
+-- full. The command FIFO holds 16 commands.
+--
+-- configuration register cfg_reg description
+-- bit		|7	|6		|5	|4	|3	|2	|1	|0	|
+-- function	| 	|hold	| 	| 	| 	| 	| 	| 	|
+-- No command is started while hold is set. A command already started runs to
+-- the end of its chain.
+--
+-- status register description
+-- bit		|7			|6		|5		|4			|3			|2			|1			|0		|
+-- function	|cmd_err	|nak	|rx_ovf	|rx_empty	|rx_full	|tx_empty	|tx_full	|busy	|
+-- busy is set while a command is running, or is waiting in the command FIFO
+-- with hold clear. Commands written while hold is set don't set busy until
+-- hold is cleared. nak is set when a slave didn't acknowledge its address or a byte
+-- written to it, rx_ovf when a byte was received with the RX FIFO full and
+-- cmd_err when a command was dropped. They are cleared with the FIFOs by
+-- flush, which must not be used while busy is set. A NAK doesn't stop the
+-- command: a read from an address that wasn't acknowledged still puts count
+-- bytes of 0xFF in the RX FIFO, and the bytes received after an overflow are
+-- lost, so the data must not be used when nak or rx_ovf is set.
+--
+-- SCL runs at bus_clk while div_reg is zero. Otherwise div_reg is the number
+-- of system clocks in a quarter of the SCL period, at least 2: with a 50MHz
+-- clock, 13 gives 962kHz (Fast-mode Plus), 32 gives 391kHz and 125 gives
+-- 100kHz. A new value takes effect from the next transaction. A slave may
+-- stretch the clock at any rate: i2c_master waits for SCL to be released
+-- before it times the high half of the period. stretch_count counts the SCL
+-- periods that were stretched, up to 0xFFFF, and is cleared by flush, so a
+-- slave that stretches a lot at a high rate can be told from one that keeps
+-- up.
+--
+-- Date: oct/2026
+--------------------------------------------------------------------------------
+-- Revision History:
+--  10/19/2026: created
+--  10/19/2026: added the clock divider input div_reg and stretch_count
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.std_logic_arith.all;
+USE ieee.std_logic_unsigned.all;
+
+ENTITY i2c_interface IS
+  GENERIC(
+    input_clk  : INTEGER := 50_000_000;                     --system clock in Hz
+    bus_clk    : INTEGER := 100_000;                        --scl frequency in Hz
+    fifo_width : INTEGER := 9);                             --data fifo depth is 2**fifo_width bytes
+  PORT(
+    clock     : IN     STD_LOGIC;                           --system clock
+    cfg_reg   : IN     STD_LOGIC_VECTOR(7 downto 0);
+    div_reg   : IN     STD_LOGIC_VECTOR(15 downto 0);       --clocks per 1/4 of SCL, 0 to use bus_clk
+    cmd_wr    : IN     STD_LOGIC;                           --write a command byte
+    cmd_data  : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);        --command byte
+    tx_wr     : IN     STD_LOGIC;                           --write tx_data to the TX FIFO
+    tx_data   : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);        --data to transmit
+    rx_rd     : IN     STD_LOGIC;                           --remove rx_data from the RX FIFO
+    rx_data   : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0);        --data received
+    flush     : IN     STD_LOGIC;                           --empty all FIFOs
+    status    : OUT    STD_LOGIC_VECTOR(7 downto 0);
+    cmd_level : OUT    STD_LOGIC_VECTOR(4 DOWNTO 0);        --commands waiting to be run
+    tx_level  : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);  --bytes waiting to be sent
+    rx_level  : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);  --bytes waiting to be read
+    stretch_count : OUT STD_LOGIC_VECTOR(15 DOWNTO 0);      --SCL periods stretched by slaves
+    sda       : INOUT  STD_LOGIC;                           --serial data
+    scl       : INOUT  STD_LOGIC);                          --serial clock
+END i2c_interface;
+
+ARCHITECTURE BEHAVIORAL of i2c_interface is
+
+--signals needed
+  type ctl_state is (idle, run, pop, advance, finish);
+  signal state        : ctl_state := idle;
+  signal ena_i2c      : std_logic := '0';
+  signal busy_i2c     : std_logic;
+  signal busy_prev    : std_logic := '1';
+  signal ack_err_i2c  : std_logic;
+  signal rcv_i2c      : std_logic_vector(7 downto 0);  --last byte received
+  signal data_i2c     : std_logic_vector(7 downto 0);  --next byte to send
+
+  signal cur_adr_rw   : std_logic_vector(7 downto 0) := (others => '0');
+  signal cur_left     : std_logic_vector(14 downto 0) := (others => '0');  --bytes of the command not yet taken
+  signal cur_chain    : std_logic := '0';
+  signal last_rw      : std_logic := '0';  --direction of the byte taken last
+
+  signal cmd_adr_rw   : std_logic_vector(7 downto 0) := (others => '0');
+  signal cmd_cnt_l    : std_logic_vector(7 downto 0) := (others => '0');
+  signal cmd_index    : integer range 0 to 2 := 0;
+  signal cmd_push     : std_logic := '0';
+  signal cmd_in       : std_logic_vector(23 downto 0) := (others => '0');
+  signal cmd_head     : std_logic_vector(23 downto 0);
+  signal cmd_rd       : std_logic := '0';
+  signal cmd_full     : std_logic;
+  signal cmd_empty    : std_logic;
+  signal cmd_count    : std_logic_vector(4 downto 0);
+  signal cmd_err      : std_logic := '0';
+
+  signal head_adr_rw  : std_logic_vector(7 downto 0);
+  signal head_count   : std_logic_vector(14 downto 0);
+  signal head_chain   : std_logic;
+  signal head_bad     : std_logic;  --the command at the head can never run
+  signal head_ready   : std_logic;  --the command at the head can be started
+
+  signal tx_rd        : std_logic := '0';
+  signal tx_full      : std_logic;
+  signal tx_empty     : std_logic;
+  signal tx_count     : std_logic_vector(fifo_width downto 0);
+  signal rx_wr        : std_logic := '0';
+  signal rx_full      : std_logic;
+  signal rx_empty     : std_logic;
+  signal rx_ovf       : std_logic := '0';
+  signal nak          : std_logic := '0';
+  signal go           : std_logic;
+  signal stretch_i2c  : std_logic;
+  signal stretch_prev : std_logic := '0';
+  signal stretches    : std_logic_vector(15 downto 0) := (others => '0');
+
+--components needed
+  component i2c_master is
+    GENERIC(
+      input_clk : INTEGER := 50_000_000;                   --input clock speed from user logic in Hz
+      bus_clk   : INTEGER := 400_000);                     --speed the i2c bus (scl) will run at in Hz
+    PORT(
+      clk       : IN     STD_LOGIC;                        --system clock
+      reset_n   : IN     STD_LOGIC;                        --active low reset
+      div       : IN     STD_LOGIC_VECTOR(15 DOWNTO 0);    --clocks in 1/4 cycle of scl, or 0 for bus_clk
+      ena       : IN     STD_LOGIC;                        --latch in command
+      addr      : IN     STD_LOGIC_VECTOR(6 DOWNTO 0);     --address of target slave
+      rw        : IN     STD_LOGIC;                        --'0' is write, '1' is read
+      data_wr   : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);     --data to write to slave
+      busy      : OUT    STD_LOGIC;                        --indicates transaction in progress
+      data_rd   : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0);     --data read from slave
+      ack_error : BUFFER STD_LOGIC;                        --flag if improper acknowledge from slave
+      sda       : INOUT  STD_LOGIC;                        --serial data output of i2c bus
+      scl       : INOUT  STD_LOGIC;                        --serial clock output of i2c bus
+      stretching : OUT   STD_LOGIC);                       --slave is holding scl low
+  END component;
+
+  component fifo is
+    GENERIC(
+      d_width : INTEGER := 8;                                 --data width
+      a_width : INTEGER := 9);                                --depth is 2**a_width
+    PORT(
+      clock   : IN     STD_LOGIC;                             --system clock
+      flush   : IN     STD_LOGIC;                             --empty the fifo
+      wr      : IN     STD_LOGIC;                             --write din
+      din     : IN     STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --data to write
+      rd      : IN     STD_LOGIC;                             --remove dout
+      dout    : OUT    STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --oldest data
+      full    : OUT    STD_LOGIC;                             --no room for a write
+      empty   : OUT    STD_LOGIC;                             --nothing to read
+      level   : OUT    STD_LOGIC_VECTOR(a_width DOWNTO 0));   --number of entries
+  END component;
+
+  begin
+    --Gather the three bytes of a command. The command is written to the FIFO
+    --in the clock after its third byte arrives.
+    process (clock) is
+    begin
+      if (clock'event and clock = '1') then
+        cmd_push <= '0';
+        if (flush = '1') then
+          cmd_index <= 0;
+        elsif (cmd_wr = '1') then
+          case cmd_index is
+            when 0 =>
+              cmd_adr_rw <= cmd_data;
+              cmd_index <= 1;
+            when 1 =>
+              cmd_cnt_l <= cmd_data;
+              cmd_index <= 2;
+            when others =>
+              cmd_in <= cmd_adr_rw & cmd_data & cmd_cnt_l;
+              cmd_push <= '1';
+              cmd_index <= 0;
+          end case;
+        end if;
+      end if;
+    end process;
+
+    head_adr_rw <= cmd_head(23 downto 16);
+    head_chain  <= cmd_head(15);
+    head_count  <= cmd_head(14 downto 8) & cmd_head(7 downto 0);
+
+    head_bad <= '1' when head_count = 0 or
+                         (head_adr_rw(0) = '0' and head_count > 2**fifo_width) else '0';
+    head_ready <= '1' when cmd_empty = '0' and cmd_rd = '0' and head_bad = '0' and
+                           (head_adr_rw(0) = '1' or tx_count >= head_count) else '0';
+
+    --a command may be started when not held
+    go <= '1' when cfg_reg(6) = '0' and cmd_empty = '0' else '0';
+
+    --Drive i2c_master from the command FIFO. i2c_master takes ena, addr, rw
+    --and data_wr when a transaction starts and again at the acknowledge bit
+    --of each byte, and raises busy once it has taken them. From then until
+    --that acknowledge bit the next byte, or ena low to stop, may be set up.
+    --busy goes low for each byte that ends, after the acknowledge of a
+    --write and with data_rd valid after a read. The TX FIFO is popped one
+    --clock after busy rises and the next byte is set up one clock later,
+    --once the FIFO levels have settled.
+    process (clock) is
+    begin
+      if (clock'event and clock = '1') then
+        busy_prev <= busy_i2c;
+        cmd_rd <= '0';
+        tx_rd <= '0';
+        rx_wr <= '0';
+
+        --a byte has ended
+        if (busy_prev = '1' and busy_i2c = '0') then
+          if (last_rw = '1') then
+            if (rx_full = '1') then
+              rx_ovf <= '1';
+            else
+              rx_wr <= '1';
+            end if;
+          end if;
+          if (ack_err_i2c = '1') then
+            nak <= '1';
+          end if;
+        end if;
+
+        if (cmd_push = '1' and cmd_full = '1') then
+          cmd_err <= '1';
+        end if;
+
+        case state is
+          when idle =>
+            ena_i2c <= '0';
+            if (cfg_reg(6) = '0' and busy_i2c = '0' and flush = '0') then
+              if (cmd_empty = '0' and cmd_rd = '0' and head_bad = '1') then
+                cmd_rd <= '1';
+                cmd_err <= '1';
+              elsif (head_ready = '1') then
+                cmd_rd <= '1';
+                cur_adr_rw <= head_adr_rw;
+                cur_left <= head_count;
+                cur_chain <= head_chain;
+                ena_i2c <= '1';
+                state <= run;
+              end if;
+            end if;
+
+          when run =>
+            --i2c_master has taken the byte set up
+            if (busy_prev = '0' and busy_i2c = '1') then
+              last_rw <= cur_adr_rw(0);
+              if (cur_adr_rw(0) = '0') then
+                tx_rd <= '1';
+              end if;
+              state <= pop;
+            end if;
+
+          when pop =>
+            state <= advance;
+
+          when advance =>
+            if (cur_left > 1) then
+              cur_left <= cur_left - 1;
+              state <= run;
+            elsif (cur_chain = '1' and head_ready = '1') then
+              cmd_rd <= '1';
+              cur_adr_rw <= head_adr_rw;
+              cur_left <= head_count;
+              cur_chain <= head_chain;
+              state <= run;
+            else
+              ena_i2c <= '0';
+              state <= finish;
+            end if;
+
+          when finish =>
+            --wait for the last byte to end, the stop follows
+            if (busy_prev = '1' and busy_i2c = '0') then
+              state <= idle;
+            end if;
+        end case;
+
+        --count the periods in which a slave held SCL low
+        stretch_prev <= stretch_i2c;
+        if (stretch_prev = '0' and stretch_i2c = '1' and stretches /= x"FFFF") then
+          stretches <= stretches + 1;
+        end if;
+
+        if (flush = '1') then
+          stretches <= (others => '0');
+          rx_ovf <= '0';
+          nak <= '0';
+          cmd_err <= '0';
+        end if;
+      end if;
+    end process;
+
+    status(0) <= '0' when state = idle and go = '0' else '1';
+    status(1) <= tx_full;
+    status(2) <= tx_empty;
+    status(3) <= rx_full;
+    status(4) <= rx_empty;
+    status(5) <= rx_ovf;
+    status(6) <= nak;
+    status(7) <= cmd_err;
+    tx_level <= tx_count;
+    cmd_level <= cmd_count;
+    stretch_count <= stretches;
+
+    --instantiation, port map and others
+    cmd_fifo: fifo generic map (24, 4)
+                   port map (clock, flush, cmd_push, cmd_in, cmd_rd, cmd_head,
+                             cmd_full, cmd_empty, cmd_count);
+    tx_fifo: fifo generic map (8, fifo_width)
+                  port map (clock, flush, tx_wr, tx_data, tx_rd, data_i2c,
+                            tx_full, tx_empty, tx_count);
+    rx_fifo: fifo generic map (8, fifo_width)
+                  port map (clock, flush, rx_wr, rcv_i2c, rx_rd, rx_data,
+                            rx_full, rx_empty, rx_level);
+    i2c_instance: i2c_master generic map (input_clk, bus_clk)
+                             port map (clock, '1', div_reg, ena_i2c, cur_adr_rw(7 downto 1), cur_adr_rw(0),
+                                       data_i2c, busy_i2c, rcv_i2c, ack_err_i2c, sda, scl,
+                                       stretch_i2c);
+end architecture;
@@ -26,6 +26,11 @@
 --     Adjusted timing of SCL during start and stop conditions
 --   Version 2.2 02/05/2015 Scott Larson
 --     Corrected small SDA glitch introduced in version 2.1
+--   10/19/2026 virtual-io
+--     Added the div input to set the scl period at run time, taken while
+--     the state machine is ready, and the stretching output
+--     Stretching is looked for only once scl_clk has released scl, so the
+--     clock that still drives scl low no longer reads as a stretch
 -- 
 --------------------------------------------------------------------------------
 
@@ -40,6 +45,7 @@ ENTITY i2c_master IS
   PORT(
     clk       : IN     STD_LOGIC;                    --system clock
     reset_n   : IN     STD_LOGIC;                    --active low reset
+    div       : IN     STD_LOGIC_VECTOR(15 DOWNTO 0); --clocks in 1/4 cycle of scl, at least 2, or 0 for bus_clk
     ena       : IN     STD_LOGIC;                    --latch in command
     addr      : IN     STD_LOGIC_VECTOR(6 DOWNTO 0); --address of target slave
     rw        : IN     STD_LOGIC;                    --'0' is write, '1' is read
@@ -48,7 +54,8 @@ ENTITY i2c_master IS
     data_rd   : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0); --data read from slave
     ack_error : BUFFER STD_LOGIC;                    --flag if improper acknowledge from slave
     sda       : INOUT  STD_LOGIC;                    --serial data output of i2c bus
-    scl       : INOUT  STD_LOGIC);                   --serial clock output of i2c bus
+    scl       : INOUT  STD_LOGIC;                    --serial clock output of i2c bus
+    stretching : OUT   STD_LOGIC);                   --slave is holding scl low
 END i2c_master;
 
 ARCHITECTURE logic OF i2c_master IS
@@ -66,41 +73,64 @@ ARCHITECTURE logic OF i2c_master IS
   SIGNAL data_rx       : STD_LOGIC_VECTOR(7 DOWNTO 0);   --data received from slave
   SIGNAL bit_cnt       : INTEGER RANGE 0 TO 7 := 7;      --tracks bit number in transaction
   SIGNAL stretch       : STD_LOGIC := '0';               --identifies if slave is stretching scl
+  SIGNAL quarter       : INTEGER RANGE 0 TO 65535 := divider;    --clocks in 1/4 cycle of scl in use
+  SIGNAL half          : INTEGER RANGE 0 TO 131070 := divider*2;
+  SIGNAL three_qtr     : INTEGER RANGE 0 TO 196605 := divider*3;
+  SIGNAL period        : INTEGER RANGE 0 TO 262140 := divider*4;
 BEGIN
 
+  --take a new scl period only between transactions
+  PROCESS(clk)
+  BEGIN
+    IF(clk'EVENT AND clk = '1') THEN
+      IF(state = ready) THEN
+        IF(div = 0) THEN
+          quarter <= divider;
+          half <= divider*2;
+          three_qtr <= divider*3;
+          period <= divider*4;
+        ELSE
+          quarter <= conv_integer(div);
+          half <= conv_integer(div)*2;
+          three_qtr <= conv_integer(div)*3;
+          period <= conv_integer(div)*4;
+        END IF;
+      END IF;
+    END IF;
+  END PROCESS;
+
   --generate the timing for the bus clock (scl_clk) and the data clock (data_clk)
   PROCESS(clk, reset_n)
-    VARIABLE count  :  INTEGER RANGE 0 TO divider*4;  --timing for clock generation
+    VARIABLE count  :  INTEGER RANGE 0 TO 262140;     --timing for clock generation
   BEGIN
     IF(reset_n = '0') THEN                --reset asserted
       stretch <= '0';
       count := 0;
     ELSIF(clk'EVENT AND clk = '1') THEN
       data_clk_prev <= data_clk;          --store previous value of data clock
-      IF(count = divider*4-1) THEN        --end of timing cycle
+      IF(count >= period-1) THEN          --end of timing cycle, or past it after a new period
         count := 0;                       --reset timer
       ELSIF(stretch = '0') THEN           --clock stretching from slave not detected
         count := count + 1;               --continue clock generation timing
       END IF;
-      CASE count IS
-        WHEN 0 TO divider-1 =>            --first 1/4 cycle of clocking
-          scl_clk <= '0';
-          data_clk <= '0';
-        WHEN divider TO divider*2-1 =>    --second 1/4 cycle of clocking
-          scl_clk <= '0';
-          data_clk <= '1';
-        WHEN divider*2 TO divider*3-1 =>  --third 1/4 cycle of clocking
-          scl_clk <= '1';                 --release scl
-          IF(scl = '0') THEN              --detect if slave is stretching clock
-            stretch <= '1';
-          ELSE
-            stretch <= '0';
-          END IF;
-          data_clk <= '1';
-        WHEN OTHERS =>                    --last 1/4 cycle of clocking
-          scl_clk <= '1';
-          data_clk <= '0';
-      END CASE;
+      IF(count < quarter) THEN            --first 1/4 cycle of clocking
+        scl_clk <= '0';
+        data_clk <= '0';
+      ELSIF(count < half) THEN            --second 1/4 cycle of clocking
+        scl_clk <= '0';
+        data_clk <= '1';
+      ELSIF(count < three_qtr) THEN       --third 1/4 cycle of clocking
+        scl_clk <= '1';                   --release scl
+        IF(scl_clk = '1' AND scl = '0') THEN --detect if slave is stretching clock, once scl is released
+          stretch <= '1';
+        ELSE
+          stretch <= '0';
+        END IF;
+        data_clk <= '1';
+      ELSE                                --last 1/4 cycle of clocking
+        scl_clk <= '1';
+        data_clk <= '0';
+      END IF;
     END IF;
   END PROCESS;
 
@@ -242,6 +272,7 @@ BEGIN
       
   --set scl and sda outputs
   scl <= '0' WHEN (scl_ena = '1' AND scl_clk = '0') ELSE 'Z';
+  stretching <= stretch AND scl_ena;
   sda <= '0' WHEN sda_ena_n = '0' ELSE 'Z';
   
 END logic;
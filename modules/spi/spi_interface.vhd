@@ -1,44 +1,95 @@
 --------------------------------------------------------------------------------
 -- SPI module adapter for implementing with virtual-io
 -- SPI configuration register cfg_reg description
--- bit		|7|6|		5	4	3	|	2		|1				|0					|
--- function	| | |speed_setting|enable	|clk_phase	|clk_polarity	|
+-- bit		|7		|6		|		5	4	3	|	2		|1				|0					|
+-- function	|rx_off	|hold	|speed_setting|enable	|clk_phase	|clk_polarity	|
 -- Speed setting is acheived by setting the 3bits in the corresponding format
 --	|	000	|	001	|	010	|	011	|	100	|	101	|	110	|	111	|
 --	|			|			|			|			|			|			|			|			|
 --	Note: the speed settings are calculated for values matching a 50MHz
 --		quartz connected to the fpga.
+-- When div_reg is not zero it is used as the clock divider instead of the
+-- speed setting: sclk runs at 50MHz / (2 * div_reg), from 25MHz down to
+-- about 381Hz.
+--
+-- Bytes to send are written into a TX FIFO with tx_wr and the bytes received
+-- are read from an RX FIFO with rx_rd, so that the host can send a whole
+-- frame with one DeppPutRegRepeat and read the reply with one
+-- DeppGetRegRepeat. While enable is set and hold is clear, the bytes in the
+-- TX FIFO are sent using the continuous mode of spi_master: ss_n stays low
+-- and the bytes follow each other without gaps until the TX FIFO runs empty.
+-- To keep ss_n low for a whole frame, set hold, write the frame and then
+-- clear hold. When rx_off is set the bytes received are discarded.
+--
+-- status register description
+-- bit		|7	|6	|5		|4			|3			|2			|1			|0		|
+-- function	| 	| 	|rx_ovf	|rx_empty	|rx_full	|tx_empty	|tx_full	|busy	|
+-- busy is set while a frame is being sent, or is about to be: bytes are in
+-- the TX FIFO with enable set and hold clear. Bytes written while enable is
+-- clear or hold is set don't set busy until they can be sent; tx_empty shows
+-- them. rx_ovf is set when a byte was received with the RX FIFO full, and is
+-- cleared with the FIFOs by flush. flush must not be used while busy is set,
+-- and drops any bytes left in the TX FIFO.
 --
 -- Author: Vadim Radu
 -- Date: apr/2015
 --------------------------------------------------------------------------------
+-- Revision History:
+--  10/19/2026: added the TX and RX FIFOs, continuous mode and status outputs
+--  10/19/2026: added the 16 bit clock divider input div_reg
+--------------------------------------------------------------------------------
 LIBRARY ieee;
 USE ieee.std_logic_1164.all;
 USE ieee.std_logic_arith.all;
 USE ieee.std_logic_unsigned.all;
 
 ENTITY spi_interface IS
+  GENERIC(
+    fifo_width : INTEGER := 9);                             --fifo depth is 2**fifo_width bytes
   PORT(
-    clock   : IN     STD_LOGIC;                             --system clock
-    tx_data : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);          --data to transmit
-    rx_data : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0); 			--data received
-    cfg_reg : IN     STD_LOGIC_VECTOR(7 downto 0);
-    miso    : IN     STD_LOGIC;                             --master in, slave out
-    sclk    : INOUT  STD_LOGIC;                             --spi clock
-    ss_n    : INOUT  STD_LOGIC;                             --slave select
-    mosi    : OUT    STD_LOGIC);                             --master out, slave in
+    clock    : IN     STD_LOGIC;                            --system clock
+    cfg_reg  : IN     STD_LOGIC_VECTOR(7 downto 0);
+    div_reg  : IN     STD_LOGIC_VECTOR(15 downto 0);        --clock divider, 0 to use the speed setting
+    tx_wr    : IN     STD_LOGIC;                            --write tx_data to the TX FIFO
+    tx_data  : IN     STD_LOGIC_VECTOR(7 DOWNTO 0);         --data to transmit
+    rx_rd    : IN     STD_LOGIC;                            --remove rx_data from the RX FIFO
+    rx_data  : OUT    STD_LOGIC_VECTOR(7 DOWNTO 0); 			--data received
+    flush    : IN     STD_LOGIC;                            --empty both FIFOs
+    status   : OUT    STD_LOGIC_VECTOR(7 downto 0);
+    tx_level : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);  --bytes waiting to be sent
+    rx_level : OUT    STD_LOGIC_VECTOR(fifo_width DOWNTO 0);  --bytes waiting to be read
+    miso     : IN     STD_LOGIC;                            --master in, slave out
+    sclk     : INOUT  STD_LOGIC;                            --spi clock
+    ss_n     : INOUT  STD_LOGIC;                            --slave select
+    mosi     : OUT    STD_LOGIC);                            --master out, slave in
 END spi_interface;
 
 ARCHITECTURE BEHAVIORAL of spi_interface is
 
 --signals needed
-  signal enable_spi   : std_logic;
-  signal busy_spi     : std_logic; --should be linked to a global reg for status flags.
+  type ctl_state is (idle, start, run);
+  signal state        : ctl_state := idle;
+  signal enable_spi   : std_logic := '0';
+  signal busy_spi     : std_logic;
+  signal busy_prev    : std_logic := '1';
   signal cpol_spi     : std_logic;
   signal cpha_spi     : std_logic;
-  signal cont_spi     : std_logic :='0';
+  signal cont_spi     : std_logic := '0';
   signal clk_div      : integer;
-  
+  signal data_spi     : std_logic_vector(7 downto 0);  --next byte to send
+  signal rcv_spi      : std_logic_vector(7 downto 0);  --last byte received
+
+  signal tx_rd        : std_logic := '0';
+  signal tx_full      : std_logic;
+  signal tx_empty     : std_logic;
+  signal tx_count     : std_logic_vector(fifo_width downto 0);
+  signal rx_wr        : std_logic := '0';
+  signal rx_full      : std_logic;
+  signal rx_empty     : std_logic;
+  signal rx_ovf       : std_logic := '0';
+  signal go           : std_logic;
+  signal tx_more      : std_logic;  --the TX FIFO holds a byte after the one being sent
+
 --components needed
   component spi_master is
     GENERIC(
@@ -58,30 +109,125 @@ ARCHITECTURE BEHAVIORAL of spi_interface is
       busy    : OUT    STD_LOGIC;                             --busy / data ready signal
       rx_data : OUT    STD_LOGIC_VECTOR(d_width-1 DOWNTO 0)); --data received
   END component;
-  
+
+  component fifo is
+    GENERIC(
+      d_width : INTEGER := 8;                                 --data width
+      a_width : INTEGER := 9);                                --depth is 2**a_width
+    PORT(
+      clock   : IN     STD_LOGIC;                             --system clock
+      flush   : IN     STD_LOGIC;                             --empty the fifo
+      wr      : IN     STD_LOGIC;                             --write din
+      din     : IN     STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --data to write
+      rd      : IN     STD_LOGIC;                             --remove dout
+      dout    : OUT    STD_LOGIC_VECTOR(d_width-1 DOWNTO 0);  --oldest data
+      full    : OUT    STD_LOGIC;                             --no room for a write
+      empty   : OUT    STD_LOGIC;                             --nothing to read
+      level   : OUT    STD_LOGIC_VECTOR(a_width DOWNTO 0));   --number of entries
+  END component;
+
   begin
     --link spi_config with proper register
     cpol_spi <= cfg_reg(0);
     cpha_spi <= cfg_reg(1);
-    enable_spi <= cfg_reg(2);
-    
-    process (cfg_reg) is
+
+    process (cfg_reg, div_reg) is
     begin
-      case cfg_reg(5 downto 3) is
-        when "000"		=> clk_div	<= 25000;
-        when "001"		=> clk_div	<= 2500;
-        when "010"		=> clk_div	<= 500;
-        when "011"		=> clk_div	<= 250;
-        when "100"		=> clk_div	<= 50;
-        when "101"		=> clk_div	<= 25;
-        when "110"		=> clk_div	<= 12;
-        when "111"		=> clk_div	<= 6;
-        when others		=> clk_div	<= 0;
-      end case;
+      if (div_reg /= x"0000") then
+        clk_div <= conv_integer(div_reg);
+      else
+        case cfg_reg(5 downto 3) is
+          when "000"		=> clk_div	<= 25000;
+          when "001"		=> clk_div	<= 2500;
+          when "010"		=> clk_div	<= 500;
+          when "011"		=> clk_div	<= 250;
+          when "100"		=> clk_div	<= 50;
+          when "101"		=> clk_div	<= 25;
+          when "110"		=> clk_div	<= 12;
+          when "111"		=> clk_div	<= 6;
+          when others		=> clk_div	<= 0;
+        end case;
+      end if;
     end process;
+
+    --a frame may be started when enabled and not held
+    go <= '1' when cfg_reg(2) = '1' and cfg_reg(6) = '0' and tx_empty = '0' else '0';
+    tx_more <= '1' when tx_count > 1 else '0';
+
+    --Feed spi_master from the TX FIFO. spi_master takes the byte on tx_data
+    --when a transaction starts and, in continuous mode, when the last bit of
+    --each byte is received. Each byte then ends with busy going low for at
+    --least one clock. The value of cont used for the next byte has already
+    --been sampled by then, so cont is only changed when a byte ends: a byte
+    --that is still going reloads from the FIFO if cont was set, and the
+    --transaction ends otherwise.
+    process (clock) is
+    begin
+      if (clock'event and clock = '1') then
+        busy_prev <= busy_spi;
+        tx_rd <= '0';
+        rx_wr <= '0';
+
+        case state is
+          when idle =>
+            cont_spi <= '0';
+            if (go = '1' and busy_spi = '0' and flush = '0') then
+              enable_spi <= '1';
+              state <= start;
+            end if;
+
+          when start =>
+            --spi_master has taken the first byte
+            if (busy_spi = '1') then
+              enable_spi <= '0';
+              tx_rd <= '1';
+              cont_spi <= tx_more;
+              state <= run;
+            end if;
+
+          when run =>
+            if (busy_prev = '1' and busy_spi = '0') then
+              if (cfg_reg(7) = '0') then
+                if (rx_full = '1') then
+                  rx_ovf <= '1';
+                else
+                  rx_wr <= '1';
+                end if;
+              end if;
+
+              if (cont_spi = '1' and flush = '0') then
+                --spi_master has reloaded from the FIFO
+                tx_rd <= '1';
+                cont_spi <= tx_more;
+              else
+                cont_spi <= '0';
+                state <= idle;
+              end if;
+            end if;
+        end case;
+
+        if (flush = '1') then
+          rx_ovf <= '0';
+        end if;
+      end if;
+    end process;
+
+    status(0) <= '0' when state = idle and go = '0' else '1';
+    status(1) <= tx_full;
+    status(2) <= tx_empty;
+    status(3) <= rx_full;
+    status(4) <= rx_empty;
+    status(5) <= rx_ovf;
+    status(7 downto 6) <= "00";
+    tx_level <= tx_count;
+
     --instantiation, port map and others
+    tx_fifo: fifo generic map (8, fifo_width)
+                  port map (clock, flush, tx_wr, tx_data, tx_rd, data_spi,
+                            tx_full, tx_empty, tx_count);
+    rx_fifo: fifo generic map (8, fifo_width)
+                  port map (clock, flush, rx_wr, rcv_spi, rx_rd, rx_data,
+                            rx_full, rx_empty, rx_level);
     spi_instance: spi_master port map (clock, enable_spi, cpol_spi, cpha_spi, cont_spi, clk_div,
-                                      tx_data, miso, sclk, ss_n, mosi, busy_spi, rx_data);
+                                      data_spi, miso, sclk, ss_n, mosi, busy_spi, rcv_spi);
 end architecture;
-  
-  